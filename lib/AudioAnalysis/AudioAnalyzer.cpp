@@ -0,0 +1,82 @@
+#include "AudioAnalyzer.h"
+#include <math.h>
+#include <stdlib.h>
+
+AudioAnalyzerConfig slidingWindowConfig(const AudioAnalyzerConfig& base, size_t windowSamples, size_t hopSamples) {
+    AudioAnalyzerConfig config = base;
+    if (hopSamples == 0 || hopSamples >= windowSamples) {
+        return config;
+    }
+    float ratio = (float)windowSamples / hopSamples;
+    float hangover = base.vadHangoverFrames * ratio + 0.5f;
+    config.vadHangoverFrames = hangover > 255 ? 255 : (uint8_t)hangover;
+    config.noiseFloorRise = base.noiseFloorRise / ratio;
+    return config;
+}
+
+AudioAnalyzer::AudioAnalyzer(const AudioAnalyzerConfig& config)
+    : _config(config), _noiseFloor(0), _hangover(0), _primed(false) {}
+
+void AudioAnalyzer::reset() {
+    _noiseFloor = 0;
+    _hangover = 0;
+    _primed = false;
+}
+
+AudioFrameStats AudioAnalyzer::process(const int32_t* interleaved, size_t frames, float selfNoiseGain) {
+    AudioFrameStats stats = {};
+
+    int32_t leftPeak = 0;
+    int32_t rightPeak = 0;
+    int64_t energy = 0;
+
+    // I2S立体声数据格式：左, 右, 左, 右...
+    for (size_t i = 0; i < frames; i++) {
+        int32_t left = interleaved[i * 2] >> 16;   // 取高16位
+        int32_t right = interleaved[i * 2 + 1] >> 16;
+
+        int32_t absLeft = abs(left);
+        int32_t absRight = abs(right);
+        if (absLeft > leftPeak) leftPeak = absLeft;
+        if (absRight > rightPeak) rightPeak = absRight;
+
+        int32_t mono = (left + right) / 2;
+        energy += (int64_t)mono * mono;
+    }
+
+    stats.leftPeak = leftPeak * selfNoiseGain;
+    stats.rightPeak = rightPeak * selfNoiseGain;
+    stats.volume = stats.leftPeak > stats.rightPeak ? stats.leftPeak : stats.rightPeak;
+    stats.triggered = stats.volume > _config.triggerThreshold;
+
+    // 方向：音量差异比例 -> 角度
+    float totalVolume = stats.leftPeak + stats.rightPeak;
+    if (totalVolume >= _config.directionMinVolume) {
+        stats.direction = (stats.rightPeak - stats.leftPeak) / totalVolume * 90.0f;
+    }
+
+    // VAD：自适应噪声底（下降立即跟随，上升缓慢），超过倍数即为语音
+    // 自噪声帧（gain < 1）不更新噪声底
+    stats.rms = frames > 0 ? sqrtf((float)energy / frames) * selfNoiseGain : 0;
+    if (selfNoiseGain >= 1.0f) {
+        if (!_primed) {
+            _noiseFloor = stats.rms;
+            _primed = true;
+        } else if (stats.rms < _noiseFloor) {
+            _noiseFloor = stats.rms;
+        } else {
+            _noiseFloor += (stats.rms - _noiseFloor) * _config.noiseFloorRise;
+        }
+    }
+    stats.noiseFloor = _noiseFloor;
+
+    bool speech = stats.rms > _config.vadMinRms && stats.rms > _noiseFloor * _config.vadRatio;
+    if (speech) {
+        _hangover = _config.vadHangoverFrames;
+    } else if (_hangover > 0) {
+        _hangover--;
+    }
+    stats.voiceActive = speech || _hangover > 0;
+
+    return stats;
+}
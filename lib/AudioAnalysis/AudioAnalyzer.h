@@ -0,0 +1,74 @@
+#ifndef AUDIO_ANALYZER_H
+#define AUDIO_ANALYZER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * AudioAnalyzer - 每帧音量 / 方向 / 语音活动检测
+ *
+ * 从综合测试中的 getVolume() / getSoundDirection() 提取而来，
+ * 算法保持一致，以便主机端仿真的调参结果可以直接用在设备上：
+ * - 音量：左右声道 |sample >> 16| 的峰值
+ * - 方向：(右峰值 - 左峰值) / (左 + 右) × 90°，总音量过小时为0
+ * - VAD：帧能量（RMS）高于自适应噪声底一定倍数，带挂起（hangover）
+ * - 自噪声：运动中由 SelfNoiseGate 给出增益，缩放峰值 / RMS 后再判定
+ *
+ * 纯计算，不分配内存，可在设备和主机上运行。
+ */
+
+struct AudioAnalyzerConfig {
+    float triggerThreshold;     // 触发阈值（对应 TRIGGER_THRESHOLD）
+    float directionMinVolume;   // 左右峰值之和低于此值时不计算方向
+    float vadRatio;             // RMS 超过噪声底的倍数才算语音
+    float vadMinRms;            // 语音的最小 RMS（避免静音环境下误判）
+    float noiseFloorRise;       // 噪声底每帧上升系数（下降立即跟随）
+    uint8_t vadHangoverFrames;  // 语音结束后保持的帧数
+
+    AudioAnalyzerConfig()
+        : triggerThreshold(100), directionMinVolume(100), vadRatio(3.0f),
+          vadMinRms(30.0f), noiseFloorRise(0.02f), vadHangoverFrames(8) {}
+};
+
+/**
+ * 滑动窗口分析（每 hopSamples 个新采样分析最近 windowSamples 个采样）时的配置：
+ * base 中按帧计的时间常数（VAD 拖尾帧数、噪声底每帧上升系数）是按不重叠分帧定的，
+ * 按 windowSamples / hopSamples 换算，使拖尾和噪声底跟随的时长保持不变。
+ * 固件和主机端仿真都用它得到分析器配置。
+ */
+AudioAnalyzerConfig slidingWindowConfig(const AudioAnalyzerConfig& base, size_t windowSamples, size_t hopSamples);
+
+struct AudioFrameStats {
+    float leftPeak;
+    float rightPeak;
+    float volume;       // max(leftPeak, rightPeak)，与 getVolume() 相同
+    float direction;    // -90（左）~ +90（右）
+    float rms;          // 左右平均后的 RMS
+    float noiseFloor;
+    bool triggered;     // volume > triggerThreshold
+    bool voiceActive;
+};
+
+class AudioAnalyzer {
+public:
+    explicit AudioAnalyzer(const AudioAnalyzerConfig& config = AudioAnalyzerConfig());
+
+    /**
+     * 处理一帧立体声交织采样（格式见 AudioSource.h）
+     * @param selfNoiseGain SelfNoiseGate 给出的幅度增益（0~1），1 表示无自噪声；
+     *                      小于1时噪声底保持不变，避免舵机声被学进噪声底
+     */
+    AudioFrameStats process(const int32_t* interleaved, size_t frames, float selfNoiseGain = 1.0f);
+
+    void setConfig(const AudioAnalyzerConfig& config) { _config = config; }
+    const AudioAnalyzerConfig& config() const { return _config; }
+    void reset();
+
+private:
+    AudioAnalyzerConfig _config;
+    float _noiseFloor;
+    uint8_t _hangover;
+    bool _primed;
+};
+
+#endif // AUDIO_ANALYZER_H
@@ -0,0 +1,51 @@
+#include "AudioLevels.h"
+#include <math.h>
+
+AudioLevelMeter::AudioLevelMeter(uint32_t sampleRate, const AudioLevelMeterConfig& config)
+    : _sampleRate(sampleRate), _lowState(0) {
+    setConfig(config);
+}
+
+void AudioLevelMeter::setConfig(const AudioLevelMeterConfig& config) {
+    _config = config;
+    _lowAlpha = 1.0f - expf(-2.0f * (float)M_PI * _config.splitHz / _sampleRate);
+}
+
+uint8_t AudioLevelMeter::rmsToLevel(float rms) const {
+    if (rms <= 0) {
+        return 0;
+    }
+    float db = 20.0f * log10f(rms / 32768.0f);
+    float x = (db - _config.floorDb) / (_config.ceilDb - _config.floorDb);
+    if (x <= 0) return 0;
+    if (x >= 1) return 255;
+    return (uint8_t)(x * 255.0f + 0.5f);
+}
+
+AudioLevelFrame AudioLevelMeter::measure(const int32_t* interleaved, size_t frames, uint32_t timeMs, float gain) {
+    AudioLevelFrame out = {};
+    out.timeMs = timeMs;
+    if (frames == 0) {
+        return out;
+    }
+
+    float total = 0;
+    float low = 0;
+    float lp = _lowState;
+    for (size_t i = 0; i < frames; i++) {
+        // 与 AudioAnalyzer 相同：取高16位，左右平均
+        float mono = (float)(((interleaved[i * 2] >> 16) + (interleaved[i * 2 + 1] >> 16)) / 2);
+        lp += _lowAlpha * (mono - lp);
+        total += mono * mono;
+        low += lp * lp;
+    }
+    _lowState = lp;
+
+    // 高频能量 = 总能量 - 低频能量（一阶滤波器的近似分割，足够用于灯效）
+    float high = total > low ? total - low : 0;
+    float g = gain * gain;
+    out.level = rmsToLevel(sqrtf(total * g / frames));
+    out.bands[AUDIO_LEVEL_LOW] = rmsToLevel(sqrtf(low * g / frames));
+    out.bands[AUDIO_LEVEL_HIGH] = rmsToLevel(sqrtf(high * g / frames));
+    return out;
+}
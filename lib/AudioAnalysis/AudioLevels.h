@@ -0,0 +1,60 @@
+#ifndef AUDIO_LEVELS_H
+#define AUDIO_LEVELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * AudioLevels - 采集帧电平（供灯效等消费者使用）
+ *
+ * 每次采集只对新读到的采样计算一次（不重新读 I2S），结果打上时间戳发布：
+ * - level：左右平均后的 RMS，按 dBFS 线性映射到 0~255（floorDb -> 0，ceilDb -> 255）
+ * - bands：一阶低通分成低频 / 高频两个频带，分别映射（低频：嗓音基频/敲击，高频：辅音/齿音）
+ *
+ * 映射按 dB 做，轻声和大声都能看出变化；自噪声门控的增益直接乘在 RMS 上。
+ * 纯计算，不分配内存。
+ */
+
+#define AUDIO_LEVEL_BANDS 2
+#define AUDIO_LEVEL_LOW   0
+#define AUDIO_LEVEL_HIGH  1
+
+struct AudioLevelFrame {
+    uint32_t timeMs;                    // 该段采样最后一个采样的时刻
+    uint8_t level;                      // 全频带电平（0~255）
+    uint8_t bands[AUDIO_LEVEL_BANDS];   // 低频 / 高频电平（0~255）
+};
+
+struct AudioLevelMeterConfig {
+    float floorDb;   // 映射为 0 的电平（dBFS，满量程 = 16位 32768）
+    float ceilDb;    // 映射为 255 的电平
+    float splitHz;   // 低频 / 高频分界
+
+    AudioLevelMeterConfig() : floorDb(-60.0f), ceilDb(-20.0f), splitHz(500.0f) {}
+};
+
+class AudioLevelMeter {
+public:
+    explicit AudioLevelMeter(uint32_t sampleRate, const AudioLevelMeterConfig& config = AudioLevelMeterConfig());
+
+    /**
+     * 计算一段立体声交织采样（格式见 AudioSource.h）的电平
+     * @param gain SelfNoiseGate 给出的幅度增益，1 表示无自噪声
+     */
+    AudioLevelFrame measure(const int32_t* interleaved, size_t frames, uint32_t timeMs, float gain = 1.0f);
+
+    void setConfig(const AudioLevelMeterConfig& config);
+    const AudioLevelMeterConfig& config() const { return _config; }
+    void reset() { _lowState = 0; }
+
+    // RMS（16位满量程）-> 0~255
+    uint8_t rmsToLevel(float rms) const;
+
+private:
+    AudioLevelMeterConfig _config;
+    uint32_t _sampleRate;
+    float _lowAlpha;    // 一阶低通系数
+    float _lowState;
+};
+
+#endif // AUDIO_LEVELS_H
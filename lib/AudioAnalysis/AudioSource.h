@@ -0,0 +1,68 @@
+#ifndef AUDIO_SOURCE_H
+#define AUDIO_SOURCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <driver/i2s.h>
+#include "Trace.h"
+#endif
+
+/**
+ * AudioSource - 采集帧来源接口
+ *
+ * 帧格式与 I2S 麦克风采集完全一致：
+ * - 立体声交织 int32：左, 右, 左, 右...
+ * - 有效数据左对齐（16位样本位于高16位，处理时 >> 16）
+ *
+ * 设备端用 I2sAudioSource 读麦克风；主机端用 WavAudioSource（lib/AudioSim）
+ * 读 WAV 文件，两者可以互换地喂给 AudioAnalyzer。
+ */
+
+#define CAPTURE_CHANNELS      2
+#define CAPTURE_FRAME_SAMPLES 512   // 每帧立体声采样数（32ms @ 16kHz），也是分析窗口长度
+#define CAPTURE_HOP_SAMPLES   256   // 固件每次读取的采样数（16ms，一个 DMA 缓冲），分析窗口每次滑动这么多
+
+class AudioSource {
+public:
+    virtual ~AudioSource() {}
+
+    /**
+     * 读取最多 maxFrames 个立体声采样到 interleaved（容量 maxFrames * 2）
+     * @return 实际读取的立体声采样数，0 表示无数据/结束
+     */
+    virtual size_t readFrame(int32_t* interleaved, size_t maxFrames) = 0;
+
+    virtual uint32_t sampleRate() const = 0;
+};
+
+#ifdef ARDUINO
+// I2S 麦克风（SPH0645，驱动已由 setupMicrophone 安装）
+class I2sAudioSource : public AudioSource {
+public:
+    I2sAudioSource(i2s_port_t port, uint32_t sampleRate, TickType_t timeout)
+        : _port(port), _sampleRate(sampleRate), _timeout(timeout) {}
+
+    size_t readFrame(int32_t* interleaved, size_t maxFrames) override {
+        TRACE_SCOPE("i2s_read");   // 含等待 DMA 的阻塞时间
+        size_t bytesRead = 0;
+        esp_err_t ret = i2s_read(_port, interleaved, maxFrames * CAPTURE_CHANNELS * sizeof(int32_t),
+                                 &bytesRead, _timeout);
+        if (ret != ESP_OK) {
+            return 0;
+        }
+        return bytesRead / (CAPTURE_CHANNELS * sizeof(int32_t));
+    }
+
+    uint32_t sampleRate() const override { return _sampleRate; }
+
+private:
+    i2s_port_t _port;
+    uint32_t _sampleRate;
+    TickType_t _timeout;
+};
+#endif
+
+#endif // AUDIO_SOURCE_H
@@ -0,0 +1,203 @@
+#ifndef REAL_FFT_H
+#define REAL_FFT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * RealFft<N> - 固定点数实数 FFT（N = 256 / 512）
+ *
+ * - 汉宁窗、旋转因子、位反转表全部在编译期（constexpr）生成，存放在闪存
+ * - N 点实数序列按 N/2 点复数 FFT + 拆分后处理计算，原地完成
+ * - 不分配堆内存；运算次数只与 N 有关，与数据无关（周期数确定）
+ *
+ * 打包格式（与 CMSIS-DSP arm_rfft_fast 相同）：
+ *   buf[0] = Re X[0]，buf[1] = Re X[N/2]（两者虚部均为0）
+ *   buf[2k] = Re X[k]，buf[2k+1] = Im X[k]，k = 1 .. N/2-1
+ *
+ * 需要 C++17（constexpr 循环、inline 静态成员）。
+ */
+
+namespace fft_detail {
+
+constexpr double PI = 3.14159265358979323846;
+
+// 编译期正弦：先归约到 [-π, π]，再用泰勒级数（误差 < 1e-12）
+constexpr double sinCx(double x) {
+    while (x > PI) x -= 2 * PI;
+    while (x < -PI) x += 2 * PI;
+
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 20; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cosCx(double x) {
+    return sinCx(x + PI / 2);
+}
+
+template <size_t N>
+struct Tables {
+    static constexpr size_t M = N / 2;  // 复数 FFT 点数
+
+    float window[N];        // 汉宁窗
+    float twCos[M / 2];     // 复数 FFT 旋转因子 e^{-2πik/M}
+    float twSin[M / 2];
+    float splitCos[M / 2 + 1];  // 拆分旋转因子 e^{-2πik/N}
+    float splitSin[M / 2 + 1];
+    uint16_t bitrev[M];
+
+    constexpr Tables() : window(), twCos(), twSin(), splitCos(), splitSin(), bitrev() {
+        for (size_t i = 0; i < N; i++) {
+            window[i] = (float)(0.5 - 0.5 * cosCx(2 * PI * i / N));
+        }
+        for (size_t k = 0; k < M / 2; k++) {
+            twCos[k] = (float)cosCx(2 * PI * k / M);
+            twSin[k] = (float)-sinCx(2 * PI * k / M);
+        }
+        for (size_t k = 0; k <= M / 2; k++) {
+            splitCos[k] = (float)cosCx(2 * PI * k / N);
+            splitSin[k] = (float)-sinCx(2 * PI * k / N);
+        }
+
+        size_t bits = 0;
+        while (((size_t)1 << bits) < M) bits++;
+        for (size_t i = 0; i < M; i++) {
+            size_t r = 0;
+            for (size_t b = 0; b < bits; b++) {
+                if (i & ((size_t)1 << b)) r |= (size_t)1 << (bits - 1 - b);
+            }
+            bitrev[i] = (uint16_t)r;
+        }
+    }
+};
+
+} // namespace fft_detail
+
+template <size_t N>
+class RealFft {
+    static_assert(N >= 16 && N <= 2048 && (N & (N - 1)) == 0, "RealFft: N 必须是2的幂（16~2048）");
+
+public:
+    static constexpr size_t SIZE = N;
+    static constexpr size_t BINS = N / 2 + 1;
+
+    /**
+     * 原地加窗 + 变换
+     * @param buf N 个实数输入，输出为打包频谱（见文件头）
+     */
+    static void forward(float* buf) {
+        applyWindow(buf);
+        transform(buf);
+    }
+
+    // 不加窗的原地变换
+    static void transform(float* buf) {
+        complexFft(buf);
+        splitReal(buf);
+    }
+
+    static void applyWindow(float* buf) {
+        for (size_t i = 0; i < N; i++) {
+            buf[i] *= TABLES.window[i];
+        }
+    }
+
+    /**
+     * 原地把采集帧（立体声交织、左对齐 int32，见 AudioSource.h）转换成加窗的单声道 float：
+     * 第 i 个输出写在 buf[i]，只读取 [2i, 2i+1]，所以可以直接复用采集缓冲区。
+     * @param interleaved 至少 N 个立体声采样；处理后前 N 个 float 为输出
+     * @return 指向同一块内存的 float 指针
+     */
+    static float* loadCaptureFrame(int32_t* interleaved) {
+        float* out = (float*)interleaved;
+        for (size_t i = 0; i < N; i++) {
+            int32_t left = interleaved[i * 2] >> 16;
+            int32_t right = interleaved[i * 2 + 1] >> 16;
+            out[i] = (float)(left + right) * 0.5f * TABLES.window[i];
+        }
+        return out;
+    }
+
+    static float windowAt(size_t i) { return TABLES.window[i]; }
+
+private:
+    static constexpr size_t M = N / 2;
+    static constexpr fft_detail::Tables<N> TABLES{};
+
+    // N/2 点复数 FFT（基2 DIT），buf 视为 M 个交织复数
+    static void complexFft(float* buf) {
+        for (size_t i = 0; i < M; i++) {
+            size_t j = TABLES.bitrev[i];
+            if (j > i) {
+                float re = buf[2 * i];
+                float im = buf[2 * i + 1];
+                buf[2 * i] = buf[2 * j];
+                buf[2 * i + 1] = buf[2 * j + 1];
+                buf[2 * j] = re;
+                buf[2 * j + 1] = im;
+            }
+        }
+
+        for (size_t len = 2; len <= M; len <<= 1) {
+            size_t half = len >> 1;
+            size_t step = M / len;
+            for (size_t base = 0; base < M; base += len) {
+                for (size_t k = 0; k < half; k++) {
+                    float wr = TABLES.twCos[k * step];
+                    float wi = TABLES.twSin[k * step];
+
+                    float* a = buf + 2 * (base + k);
+                    float* b = buf + 2 * (base + k + half);
+                    float tr = b[0] * wr - b[1] * wi;
+                    float ti = b[0] * wi + b[1] * wr;
+
+                    b[0] = a[0] - tr;
+                    b[1] = a[1] - ti;
+                    a[0] += tr;
+                    a[1] += ti;
+                }
+            }
+        }
+    }
+
+    // 由 M 点复数 FFT 结果得到 N 点实数 FFT（成对处理 k 与 M-k）
+    static void splitReal(float* buf) {
+        float z0r = buf[0];
+        float z0i = buf[1];
+        buf[0] = z0r + z0i;   // X[0]
+        buf[1] = z0r - z0i;   // X[N/2]
+
+        for (size_t k = 1; k <= M / 2; k++) {
+            size_t mk = M - k;
+            float ar = buf[2 * k], ai = buf[2 * k + 1];
+            float cr = buf[2 * mk], ci = buf[2 * mk + 1];
+
+            // E = (Z[k] + conj(Z[M-k])) / 2，O = (Z[k] - conj(Z[M-k])) / 2i
+            float er = 0.5f * (ar + cr);
+            float ei = 0.5f * (ai - ci);
+            float or_ = 0.5f * (ai + ci);
+            float oi = -0.5f * (ar - cr);
+
+            // T = W^k × O
+            float wr = TABLES.splitCos[k];
+            float wi = TABLES.splitSin[k];
+            float tr = or_ * wr - oi * wi;
+            float ti = or_ * wi + oi * wr;
+
+            // X[k] = E + T，X[M-k] = conj(E - T)
+            buf[2 * k] = er + tr;
+            buf[2 * k + 1] = ei + ti;
+            if (mk != k) {
+                buf[2 * mk] = er - tr;
+                buf[2 * mk + 1] = -(ei - ti);
+            }
+        }
+    }
+};
+
+#endif // REAL_FFT_H
@@ -0,0 +1,169 @@
+#include "SelfNoiseGate.h"
+#include <math.h>
+#include <string.h>
+#include "RealFft.h"
+#include "SpectralFeatures.h"
+
+static const size_t BINS_PER_BAND = (SELF_NOISE_FFT_SIZE / 2) / SELF_NOISE_BANDS;
+
+SelfNoiseGate::SelfNoiseGate(const SelfNoiseGateConfig& config) : _config(config) {
+    reset();
+}
+
+void SelfNoiseGate::reset() {
+    memset(_profile, 0, sizeof(_profile));
+    memset(_learnFrames, 0, sizeof(_learnFrames));
+}
+
+uint8_t SelfNoiseGate::velocityClass(float velocityDps) const {
+    float v = fabsf(velocityDps);
+    uint8_t c = 0;
+    while (c < SELF_NOISE_CLASSES - 1 && v >= _config.velocityEdges[c]) {
+        c++;
+    }
+    return c;
+}
+
+bool SelfNoiseGate::hasProfile(uint8_t velocityClass) const {
+    return velocityClass < SELF_NOISE_CLASSES && _learnFrames[velocityClass] >= _config.minLearnFrames;
+}
+
+// 优先使用本档噪声谱，否则用最近的已学习档位；都没有返回 -1
+int SelfNoiseGate::findProfile(uint8_t velocityClass) const {
+    for (int d = 0; d < (int)SELF_NOISE_CLASSES; d++) {
+        int lo = (int)velocityClass - d;
+        int hi = (int)velocityClass + d;
+        if (lo >= 0 && hasProfile((uint8_t)lo)) return lo;
+        if (hi < (int)SELF_NOISE_CLASSES && hasProfile((uint8_t)hi)) return hi;
+    }
+    return -1;
+}
+
+// 单声道下混 -> 加窗 FFT -> 16 个频带能量（跳过直流）
+void SelfNoiseGate::analyzeBands(const int32_t* interleaved, size_t frames) {
+    if (frames > SELF_NOISE_FFT_SIZE) frames = SELF_NOISE_FFT_SIZE;
+
+    for (size_t i = 0; i < frames; i++) {
+        int32_t left = interleaved[i * 2] >> 16;
+        int32_t right = interleaved[i * 2 + 1] >> 16;
+        _work[i] = (float)(left + right) * 0.5f;
+    }
+    for (size_t i = frames; i < SELF_NOISE_FFT_SIZE; i++) {
+        _work[i] = 0;
+    }
+
+    RealFft<SELF_NOISE_FFT_SIZE>::forward(_work);
+    spectrumPower(_work, SELF_NOISE_FFT_SIZE, _power);
+
+    for (size_t b = 0; b < SELF_NOISE_BANDS; b++) {
+        float sum = 0;
+        for (size_t k = b * BINS_PER_BAND; k < (b + 1) * BINS_PER_BAND; k++) {
+            sum += _power[k];
+        }
+        _bands[b] = sum;
+    }
+    _bands[0] -= _power[0];
+}
+
+/**
+ * 噪声电平跟踪：舵机负载 / 磨损不同，实际噪声可能比校准时响。
+ * 噪声谱形状不变时各频带"实测 / 噪声谱"比值相同；语音只抬高部分频带，
+ * 所以取比值的第二小值（忽略噪声谱中几乎没有能量的频带）作为电平倍数。
+ */
+float SelfNoiseGate::noiseScale(const float* noise) const {
+    float peak = 0;
+    for (size_t b = 0; b < SELF_NOISE_BANDS; b++) {
+        if (noise[b] > peak) peak = noise[b];
+    }
+
+    float lowest = _config.maxNoiseScale;
+    float second = _config.maxNoiseScale;
+    for (size_t b = 0; b < SELF_NOISE_BANDS; b++) {
+        if (noise[b] < peak * 0.01f) continue;
+        float ratio = _bands[b] / noise[b];
+        if (ratio < lowest) {
+            second = lowest;
+            lowest = ratio;
+        } else if (ratio < second) {
+            second = ratio;
+        }
+    }
+
+    return second < 1.0f ? 1.0f : second;
+}
+
+void SelfNoiseGate::learn(const int32_t* interleaved, size_t frames, float velocityDps) {
+    uint8_t c = velocityClass(velocityDps);
+    analyzeBands(interleaved, frames);
+
+    if (_learnFrames[c] < UINT16_MAX) {
+        _learnFrames[c]++;
+    }
+    float weight = 1.0f / _learnFrames[c];
+    for (size_t b = 0; b < SELF_NOISE_BANDS; b++) {
+        _profile[c][b] += (_bands[b] - _profile[c][b]) * weight;
+    }
+}
+
+SelfNoiseResult SelfNoiseGate::process(const int32_t* interleaved, size_t frames,
+                                       const MotionState& motion) {
+    SelfNoiseResult result = {};
+    result.gain = 1.0f;
+    result.moving = motion.moving;
+    result.velocityClass = velocityClass(motion.velocityDps);
+
+    if (!motion.moving) {
+        return result;
+    }
+
+    int p = findProfile(result.velocityClass);
+    if (p < 0) {
+        if (_config.gateUnprofiled) {
+            result.gain = 0;
+            result.gated = true;
+        }
+        return result;
+    }
+    result.profiled = true;
+
+    analyzeBands(interleaved, frames);
+
+    const float* noise = _profile[p];
+    float scale = noiseScale(noise);
+    result.noiseScale = scale;
+
+    float total = 0;
+    float residual = 0;
+    float noiseTotal = 0;
+    bool pureNoise = true;
+
+    // 噪声谱取相邻频带最大值：负载下实际转速偏离指令速度时，谐波会漂到相邻频带
+    for (size_t b = 0; b < SELF_NOISE_BANDS; b++) {
+        float nb = noise[b];
+        if (b > 0 && noise[b - 1] > nb) nb = noise[b - 1];
+        if (b + 1 < SELF_NOISE_BANDS && noise[b + 1] > nb) nb = noise[b + 1];
+        float n = nb * scale * _config.overSubtraction;
+        float r = _bands[b] - n;
+        if (r > 0) residual += r;
+        total += _bands[b];
+        noiseTotal += n;
+        if (_bands[b] > noise[b] * scale * _config.adaptMaxRatio) pureNoise = false;
+    }
+
+    result.residualSnr = noiseTotal > 0 ? residual / noiseTotal : 0;
+    if (result.residualSnr < _config.gateSnr || total <= 0) {
+        result.gain = 0;
+        result.gated = true;
+    } else {
+        result.gain = sqrtf(residual / total);
+    }
+
+    // 在线自适应：只用本档噪声谱、且判定为纯自噪声的帧
+    if (pureNoise && _config.adaptRate > 0 && p == result.velocityClass) {
+        for (size_t b = 0; b < SELF_NOISE_BANDS; b++) {
+            _profile[p][b] += (_bands[b] - _profile[p][b]) * _config.adaptRate;
+        }
+    }
+
+    return result;
+}
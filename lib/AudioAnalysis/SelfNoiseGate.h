@@ -0,0 +1,99 @@
+#ifndef SELF_NOISE_GATE_H
+#define SELF_NOISE_GATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "AudioSource.h"
+#include "MotionState.h"
+
+/**
+ * SelfNoiseGate - 舵机自噪声抑制 / 门控
+ *
+ * smoothMove() 期间舵机齿轮声会进入麦克风，导致反复触发 STATE_ACTIVE、
+ * 并把 getSoundDirection() 拉向舵机一侧。本模块按指令速度分档，
+ * 为每档学习一个频带噪声谱（512点 FFT，16个 500Hz 频带），运动中的每一帧：
+ *
+ *   电平倍数 s = 各频带 P_b / N_b(v) 的第二小值，限制在 [1, maxNoiseScale]
+ *   残留能量 R_b = max(P_b - α × s × N'_b(v), 0)，N'_b 为相邻三个频带噪声谱的最大值
+ *   SNR = ΣR / (α × s × ΣN')
+ *   SNR < gateSnr       -> gain = 0（整帧门控：不触发、不计算方向）
+ *   否则                -> gain = sqrt(ΣR / ΣP)（按残留能量缩放峰值 / RMS）
+ *
+ * gain 交给 AudioAnalyzer::process()。静止时直接返回 gain = 1，不做 FFT。
+ *
+ * 噪声谱来源：
+ * - learn()：开机校准，在安静环境中按各档速度转动舵机并采集
+ * - 在线自适应：运动中每个频带都不超过 adaptMaxRatio × s × 噪声谱的帧视为纯自噪声，
+ *   以 adaptRate 缓慢更新（舵机老化后噪声谱跟着变）
+ *
+ * 纯计算，不分配堆内存（工作缓冲区约 3KB 在对象内）。
+ */
+
+static const size_t SELF_NOISE_FFT_SIZE = 512;
+static const size_t SELF_NOISE_BANDS = 16;
+static const size_t SELF_NOISE_CLASSES = 4;
+
+struct SelfNoiseGateConfig {
+    float velocityEdges[SELF_NOISE_CLASSES - 1];  // 速度分档边界（°/s，递增）
+    float overSubtraction;    // α：噪声谱放大倍数
+    float maxNoiseScale;      // 电平跟踪上限（相对校准时的功率倍数）
+    float gateSnr;            // 残留 SNR 低于此值整帧门控
+    float adaptRate;          // 在线自适应速率（0 关闭）
+    float adaptMaxRatio;      // 每个频带 ≤ 此倍数 × 噪声谱才视为纯自噪声
+    uint16_t minLearnFrames;  // 某档至少学习多少帧才算有噪声谱
+    bool gateUnprofiled;      // 没有任何噪声谱时，运动中整帧门控
+
+    // 默认分档对应综合测试中的 smoothMove 延时：20ms=50°/s, 10ms=100°/s, 5ms=200°/s
+    SelfNoiseGateConfig()
+        : velocityEdges{ 40.0f, 80.0f, 160.0f }, overSubtraction(2.0f), maxNoiseScale(4.0f), gateSnr(0.5f),
+          adaptRate(0.05f), adaptMaxRatio(1.5f), minLearnFrames(8), gateUnprofiled(true) {}
+};
+
+struct SelfNoiseResult {
+    float gain;             // 0~1，传给 AudioAnalyzer::process()
+    float residualSnr;      // 残留能量 / 噪声估计（静止时为0）
+    float noiseScale;       // 本帧噪声电平倍数（相对噪声谱）
+    uint8_t velocityClass;
+    bool moving;
+    bool gated;             // gain == 0
+    bool profiled;          // 使用了学习到的噪声谱
+};
+
+class SelfNoiseGate {
+public:
+    explicit SelfNoiseGate(const SelfNoiseGateConfig& config = SelfNoiseGateConfig());
+
+    /**
+     * 处理一帧（格式见 AudioSource.h），不修改输入
+     * @param motion 来自 MotionTracker::state()
+     */
+    SelfNoiseResult process(const int32_t* interleaved, size_t frames, const MotionState& motion);
+
+    /**
+     * 校准：把一帧纯自噪声累加进对应速度档的噪声谱（累积平均）
+     */
+    void learn(const int32_t* interleaved, size_t frames, float velocityDps);
+
+    uint8_t velocityClass(float velocityDps) const;
+    bool hasProfile(uint8_t velocityClass) const;
+    const float* profile(uint8_t velocityClass) const { return _profile[velocityClass]; }
+
+    void setConfig(const SelfNoiseGateConfig& config) { _config = config; }
+    const SelfNoiseGateConfig& config() const { return _config; }
+    void reset();
+
+private:
+    void analyzeBands(const int32_t* interleaved, size_t frames);
+    int findProfile(uint8_t velocityClass) const;
+    float noiseScale(const float* noise) const;
+
+    SelfNoiseGateConfig _config;
+    float _profile[SELF_NOISE_CLASSES][SELF_NOISE_BANDS];
+    uint16_t _learnFrames[SELF_NOISE_CLASSES];
+
+    float _work[SELF_NOISE_FFT_SIZE];
+    float _power[SELF_NOISE_FFT_SIZE / 2 + 1];
+    float _bands[SELF_NOISE_BANDS];
+};
+
+#endif // SELF_NOISE_GATE_H
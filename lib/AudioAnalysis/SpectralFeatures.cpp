@@ -0,0 +1,55 @@
+#include "SpectralFeatures.h"
+#include <math.h>
+
+void spectrumPower(const float* packed, size_t fftSize, float* power) {
+    const size_t half = fftSize / 2;
+
+    power[0] = packed[0] * packed[0];
+    power[half] = packed[1] * packed[1];
+    for (size_t k = 1; k < half; k++) {
+        float re = packed[2 * k];
+        float im = packed[2 * k + 1];
+        power[k] = re * re + im * im;
+    }
+}
+
+void spectrumMagnitude(const float* packed, size_t fftSize, float* magnitude) {
+    spectrumPower(packed, fftSize, magnitude);
+    for (size_t k = 0; k <= fftSize / 2; k++) {
+        magnitude[k] = sqrtf(magnitude[k]);
+    }
+}
+
+size_t frequencyToBin(float hz, size_t fftSize, uint32_t sampleRate) {
+    if (hz <= 0) {
+        return 0;
+    }
+    size_t bin = (size_t)(hz * fftSize / sampleRate);
+    return bin > fftSize / 2 ? fftSize / 2 : bin;
+}
+
+void bandEnergies(const float* power, size_t fftSize, uint32_t sampleRate,
+                  const float* edgesHz, size_t bandCount, float* energies) {
+    for (size_t b = 0; b < bandCount; b++) {
+        size_t lo = frequencyToBin(edgesHz[b], fftSize, sampleRate);
+        size_t hi = frequencyToBin(edgesHz[b + 1], fftSize, sampleRate);
+
+        float sum = 0;
+        for (size_t k = lo; k < hi; k++) {
+            sum += power[k];
+        }
+        energies[b] = sum;
+    }
+}
+
+float spectralFlux(const float* magnitude, float* previous, size_t bins) {
+    float flux = 0;
+    for (size_t k = 0; k < bins; k++) {
+        float diff = magnitude[k] - previous[k];
+        if (diff > 0) {
+            flux += diff;
+        }
+        previous[k] = magnitude[k];
+    }
+    return flux;
+}
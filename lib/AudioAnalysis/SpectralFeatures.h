@@ -0,0 +1,37 @@
+#ifndef SPECTRAL_FEATURES_H
+#define SPECTRAL_FEATURES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * SpectralFeatures - 基于 RealFft 打包频谱的特征计算
+ *
+ * 输入均为 RealFft<N> 输出的打包频谱（fftSize = N），
+ * 输出幅度谱有 N/2 + 1 个频点。全部为纯计算，不分配内存。
+ */
+
+// 打包频谱 -> 幅度谱（bins = fftSize/2 + 1）
+void spectrumMagnitude(const float* packed, size_t fftSize, float* magnitude);
+
+// 打包频谱 -> 功率谱（幅度平方，省去开方）
+void spectrumPower(const float* packed, size_t fftSize, float* power);
+
+// 频率（Hz）对应的频点编号（向下取整，限制在 [0, fftSize/2]）
+size_t frequencyToBin(float hz, size_t fftSize, uint32_t sampleRate);
+
+/**
+ * 频带能量：把功率谱按频带边界求和
+ * @param edgesHz  bandCount + 1 个边界频率（递增）
+ * @param energies 输出 bandCount 个能量值
+ */
+void bandEnergies(const float* power, size_t fftSize, uint32_t sampleRate,
+                  const float* edgesHz, size_t bandCount, float* energies);
+
+/**
+ * 频谱通量：当前幅度谱相对上一帧的正向增量之和（用于起音检测）
+ * 计算后 previous 被更新为 current
+ */
+float spectralFlux(const float* magnitude, float* previous, size_t bins);
+
+#endif // SPECTRAL_FEATURES_H
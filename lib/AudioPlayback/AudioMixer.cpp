@@ -0,0 +1,261 @@
+#include "AudioMixer.h"
+#include <string.h>
+
+// ========== IMA ADPCM ==========
+
+static const int16_t IMA_STEP_TABLE[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+    157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+    724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+    3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t IMA_INDEX_TABLE[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+int16_t imaAdpcmDecodeNibble(ImaAdpcmState& state, uint8_t nibble) {
+    int32_t step = IMA_STEP_TABLE[state.stepIndex];
+
+    int32_t diff = step >> 3;
+    if (nibble & 4) diff += step;
+    if (nibble & 2) diff += step >> 1;
+    if (nibble & 1) diff += step >> 2;
+
+    int32_t predictor = state.predictor + ((nibble & 8) ? -diff : diff);
+    if (predictor > 32767) predictor = 32767;
+    if (predictor < -32768) predictor = -32768;
+    state.predictor = predictor;
+
+    int32_t index = state.stepIndex + IMA_INDEX_TABLE[nibble & 0x0F];
+    if (index < 0) index = 0;
+    if (index > 88) index = 88;
+    state.stepIndex = (int8_t)index;
+
+    return (int16_t)predictor;
+}
+
+uint8_t imaAdpcmEncodeSample(ImaAdpcmState& state, int16_t sample) {
+    int32_t step = IMA_STEP_TABLE[state.stepIndex];
+    int32_t diff = (int32_t)sample - state.predictor;
+
+    uint8_t nibble = 0;
+    if (diff < 0) {
+        nibble = 8;
+        diff = -diff;
+    }
+    if (diff >= step) { nibble |= 4; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { nibble |= 2; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { nibble |= 1; }
+
+    // 用解码器更新状态，保证编码端与解码端预测值一致
+    imaAdpcmDecodeNibble(state, nibble);
+    return nibble;
+}
+
+// ========== AudioMixer ==========
+
+// 每次在栈上累加的块大小（int32 × 64 = 256 字节）
+static const size_t MIX_CHUNK = 64;
+
+static inline int32_t applyGain(int32_t sample, uint16_t gainQ15) {
+    // 增益为1时直接透传，保证单声部输出与源数据逐位一致
+    return gainQ15 == AUDIO_GAIN_UNITY ? sample : (sample * gainQ15) >> 15;
+}
+
+// 主音量作用在累加和上：4 个满幅声部之和约 ±131072，乘 Q15 增益会超出 int32，用 int64 相乘
+static inline int32_t applyMasterGain(int32_t sum, uint16_t gainQ15) {
+    return gainQ15 == AUDIO_GAIN_UNITY ? sum : (int32_t)(((int64_t)sum * gainQ15) >> 15);
+}
+
+AudioMixer::AudioMixer(uint16_t outputRate)
+    : _outputRate(outputRate), _masterGain(AUDIO_GAIN_UNITY),
+      _startCounter(0), _clippedSamples(0) {
+    memset(_voices, 0, sizeof(_voices));
+}
+
+int AudioMixer::allocVoice() {
+    int oldest = 0;
+    for (int i = 0; i < MAX_VOICES; i++) {
+        if (!_voices[i].active) {
+            return i;
+        }
+        if (_voices[i].startOrder < _voices[oldest].startOrder) {
+            oldest = i;
+        }
+    }
+    return oldest;  // 声部已满，抢占最早开始的声部
+}
+
+void AudioMixer::rewind(Voice& v) {
+    v.position = 0;
+    v.predictor = 0;
+    v.stepIndex = 0;
+}
+
+int AudioMixer::play(const SoundClip& clip, uint16_t gainQ15, bool loop) {
+    if (clip.data == nullptr || clip.sampleCount == 0 || clip.sampleRate != _outputRate) {
+        return -1;
+    }
+
+    int index = allocVoice();
+    Voice& v = _voices[index];
+    v.clip = clip;
+    v.gain = gainQ15;
+    v.loop = loop;
+    v.startOrder = _startCounter++;
+    rewind(v);
+    v.active = true;
+    return index;
+}
+
+void AudioMixer::stop(int voice) {
+    if (voice >= 0 && voice < MAX_VOICES) {
+        _voices[voice].active = false;
+    }
+}
+
+void AudioMixer::stopAll() {
+    for (int i = 0; i < MAX_VOICES; i++) {
+        _voices[i].active = false;
+    }
+}
+
+void AudioMixer::setVoiceGain(int voice, uint16_t gainQ15) {
+    if (voice >= 0 && voice < MAX_VOICES) {
+        _voices[voice].gain = gainQ15;
+    }
+}
+
+uint8_t AudioMixer::activeVoices() const {
+    uint8_t count = 0;
+    for (int i = 0; i < MAX_VOICES; i++) {
+        if (_voices[i].active) count++;
+    }
+    return count;
+}
+
+int16_t AudioMixer::nextSample(Voice& v) {
+    uint8_t byte = v.clip.data[v.position >> 1];
+    uint8_t nibble = (v.position & 1) ? (byte >> 4) : (byte & 0x0F);
+
+    ImaAdpcmState state = { v.predictor, v.stepIndex };
+    int16_t sample = imaAdpcmDecodeNibble(state, nibble);
+    v.predictor = state.predictor;
+    v.stepIndex = state.stepIndex;
+    return sample;
+}
+
+size_t AudioMixer::mixVoice(Voice& v, int32_t* acc, size_t frames) {
+    size_t mixed = 0;
+
+    while (mixed < frames && v.active) {
+        size_t remaining = v.clip.sampleCount - v.position;
+        size_t n = frames - mixed;
+        if (n > remaining) n = remaining;
+
+        if (v.clip.format == CLIP_PCM16) {
+            const int16_t* src = (const int16_t*)v.clip.data + v.position;
+            for (size_t i = 0; i < n; i++) {
+                acc[mixed + i] += applyGain(src[i], v.gain);
+            }
+            v.position += n;
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                acc[mixed + i] += applyGain(nextSample(v), v.gain);
+                v.position++;
+            }
+        }
+        mixed += n;
+
+        if (v.position >= v.clip.sampleCount) {
+            if (v.loop) {
+                rewind(v);
+            } else {
+                v.active = false;
+            }
+        }
+    }
+
+    return mixed;
+}
+
+size_t AudioMixer::render(int16_t* out, size_t frames) {
+    int32_t acc[MIX_CHUNK];
+    size_t audible = 0;
+
+    for (size_t done = 0; done < frames; done += MIX_CHUNK) {
+        size_t n = frames - done;
+        if (n > MIX_CHUNK) n = MIX_CHUNK;
+
+        memset(acc, 0, n * sizeof(int32_t));
+
+        size_t chunkAudible = 0;
+        for (int i = 0; i < MAX_VOICES; i++) {
+            if (_voices[i].active) {
+                size_t m = mixVoice(_voices[i], acc, n);
+                if (m > chunkAudible) chunkAudible = m;
+            }
+        }
+        audible += chunkAudible;
+
+        for (size_t i = 0; i < n; i++) {
+            int32_t s = applyMasterGain(acc[i], _masterGain);
+            if (s > 32767) {
+                s = 32767;
+                _clippedSamples++;
+            } else if (s < -32768) {
+                s = -32768;
+                _clippedSamples++;
+            }
+            out[done + i] = (int16_t)s;
+        }
+    }
+
+    return audible;
+}
+
+size_t AudioMixer::directSpan(const int16_t** samples, size_t maxFrames) const {
+    if (_masterGain != AUDIO_GAIN_UNITY) {
+        return 0;
+    }
+
+    const Voice* only = nullptr;
+    for (int i = 0; i < MAX_VOICES; i++) {
+        if (_voices[i].active) {
+            if (only != nullptr) return 0;  // 多个声部必须混音
+            only = &_voices[i];
+        }
+    }
+
+    if (only == nullptr || only->clip.format != CLIP_PCM16 || only->gain != AUDIO_GAIN_UNITY) {
+        return 0;
+    }
+
+    size_t n = only->clip.sampleCount - only->position;
+    if (n > maxFrames) n = maxFrames;
+    *samples = (const int16_t*)only->clip.data + only->position;
+    return n;
+}
+
+void AudioMixer::advance(size_t frames) {
+    for (int i = 0; i < MAX_VOICES; i++) {
+        Voice& v = _voices[i];
+        if (!v.active) continue;
+
+        v.position += frames;
+        if (v.position >= v.clip.sampleCount) {
+            if (v.loop) {
+                rewind(v);
+            } else {
+                v.active = false;
+            }
+        }
+        return;  // directSpan 只在单声部时有效
+    }
+}
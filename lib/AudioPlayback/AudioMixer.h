@@ -0,0 +1,95 @@
+#ifndef AUDIO_MIXER_H
+#define AUDIO_MIXER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "SoundBank.h"
+
+/**
+ * AudioMixer - 定点多声部混音器
+ *
+ * - 最多 MAX_VOICES 个声部同时播放，声部满时抢占最早开始的声部
+ * - 增益为 Q15（32767 ≈ 1.0），累加用 int32，输出饱和到 int16
+ * - PCM 声部直接从映射区读取；ADPCM 声部逐采样解码后直接累加，无中间缓冲
+ * - 不分配堆内存，render() 耗时只与帧数和活跃声部数相关
+ *
+ * 线程模型：所有方法须在同一个任务中调用（通常是音频输出任务），
+ * 其他任务通过 AudioPlayback 的命令队列间接控制。
+ */
+
+#define AUDIO_GAIN_UNITY 32767
+
+class AudioMixer {
+public:
+    static const uint8_t MAX_VOICES = 4;
+
+    explicit AudioMixer(uint16_t outputRate = 16000);
+
+    /**
+     * 开始播放一段音频
+     * @param gainQ15 声部增益（Q15）
+     * @param loop    是否循环
+     * @return 声部编号；采样率不匹配或音频为空时返回 -1
+     */
+    int play(const SoundClip& clip, uint16_t gainQ15 = AUDIO_GAIN_UNITY, bool loop = false);
+
+    void stop(int voice);
+    void stopAll();
+    void setVoiceGain(int voice, uint16_t gainQ15);
+    void setMasterGain(uint16_t gainQ15) { _masterGain = gainQ15; }
+
+    /**
+     * 混音 frames 个单声道采样到 out（无声部时输出静音）
+     * @return 本次有声部参与的采样数
+     */
+    size_t render(int16_t* out, size_t frames);
+
+    /**
+     * 零拷贝快速路径：只有一个 PCM 声部且增益均为1时，
+     * 返回该声部在映射区中的连续采样，调用方直接送给 I2S，再调用 advance()。
+     * @return 可直接输出的采样数；不满足条件时返回 0
+     */
+    size_t directSpan(const int16_t** samples, size_t maxFrames) const;
+    void advance(size_t frames);
+
+    uint8_t activeVoices() const;
+    bool isActive() const { return activeVoices() > 0; }
+    uint16_t outputRate() const { return _outputRate; }
+    uint32_t clippedSamples() const { return _clippedSamples; }
+
+private:
+    struct Voice {
+        SoundClip clip;
+        uint32_t position;     // 已播放采样数
+        uint32_t startOrder;   // 用于抢占最早的声部
+        uint16_t gain;
+        bool active;
+        bool loop;
+        // IMA ADPCM 解码状态
+        int32_t predictor;
+        int8_t stepIndex;
+    };
+
+    int allocVoice();
+    void rewind(Voice& v);
+    int16_t nextSample(Voice& v);
+    size_t mixVoice(Voice& v, int32_t* acc, size_t frames);
+
+    Voice _voices[MAX_VOICES];
+    uint16_t _outputRate;
+    uint16_t _masterGain;
+    uint32_t _startCounter;
+    uint32_t _clippedSamples;
+};
+
+// ========== IMA ADPCM 编解码（也供工具和测试使用） ==========
+
+struct ImaAdpcmState {
+    int32_t predictor;
+    int8_t stepIndex;
+};
+
+int16_t imaAdpcmDecodeNibble(ImaAdpcmState& state, uint8_t nibble);
+uint8_t imaAdpcmEncodeSample(ImaAdpcmState& state, int16_t sample);
+
+#endif // AUDIO_MIXER_H
@@ -0,0 +1,170 @@
+#include "AudioPlayback.h"
+
+AudioPlayback::AudioPlayback(const SoundBank& bank, uint16_t sampleRate)
+    :
+#ifdef ARDUINO
+      _port(I2S_NUM_1), _task(nullptr), _events(nullptr),
+#endif
+      _bank(bank), _mixer(sampleRate), _submitted(0), _processed(0),
+      _voicesActive(false), _underruns(0), _droppedCommands(0) {}
+
+// ========== 命令提交（调用方任务） ==========
+
+bool AudioPlayback::submit(const Command& cmd) {
+    if (!_commands.push(cmd)) {
+        _droppedCommands++;
+        return false;
+    }
+    _submitted.fetch_add(1, std::memory_order_release);
+
+#ifdef ARDUINO
+    if (_task != nullptr) {
+        xTaskNotifyGive(_task);  // 唤醒空闲中的输出任务
+    }
+#endif
+    return true;
+}
+
+bool AudioPlayback::play(int clipIndex, uint16_t gainQ15, bool loop) {
+    if (clipIndex < 0 || clipIndex >= _bank.clipCount()) {
+        return false;
+    }
+    Command cmd = { CMD_PLAY, loop, gainQ15, (int16_t)clipIndex };
+    return submit(cmd);
+}
+
+bool AudioPlayback::play(const char* clipName, uint16_t gainQ15, bool loop) {
+    return play(_bank.findClip(clipName), gainQ15, loop);
+}
+
+void AudioPlayback::stopAll() {
+    Command cmd = { CMD_STOP_ALL, false, 0, -1 };
+    submit(cmd);
+}
+
+void AudioPlayback::setMasterGain(uint16_t gainQ15) {
+    Command cmd = { CMD_MASTER_GAIN, false, gainQ15, -1 };
+    submit(cmd);
+}
+
+bool AudioPlayback::isPlaying() const {
+    if (_submitted.load(std::memory_order_acquire) != _processed.load(std::memory_order_acquire)) {
+        return true;
+    }
+    return _voicesActive.load(std::memory_order_acquire);
+}
+
+// ========== 输出任务 ==========
+
+void AudioPlayback::processCommands() {
+    Command cmd;
+    while (_commands.pop(cmd)) {
+        switch (cmd.type) {
+            case CMD_PLAY: {
+                SoundClip clip;
+                if (_bank.getClip(cmd.clip, clip)) {
+                    _mixer.play(clip, cmd.gain, cmd.loop);
+                }
+                break;
+            }
+            case CMD_STOP_ALL:
+                _mixer.stopAll();
+                break;
+            case CMD_MASTER_GAIN:
+                _mixer.setMasterGain(cmd.gain);
+                break;
+        }
+        // 先更新声部状态再标记已处理，isPlaying() 不会出现空窗
+        _voicesActive.store(_mixer.isActive(), std::memory_order_release);
+        _processed.fetch_add(1, std::memory_order_release);
+    }
+}
+
+#ifdef ARDUINO
+
+bool AudioPlayback::begin(i2s_port_t port, int bckPin, int wsPin, int doutPin, BaseType_t core) {
+    _port = port;
+
+    i2s_config_t i2s_config = {
+        .mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_TX),
+        .sample_rate = _mixer.outputRate(),
+        .bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT,
+        .channel_format = I2S_CHANNEL_FMT_ONLY_LEFT,   // NS4168 单声道
+        .communication_format = I2S_COMM_FORMAT_STAND_I2S,
+        .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,
+        .dma_buf_count = 4,
+        .dma_buf_len = PLAYBACK_FRAME_SAMPLES,
+        .use_apll = false,
+        .tx_desc_auto_clear = true,  // 取空时自动输出静音，避免重复播放旧数据
+        .fixed_mclk = 0
+    };
+
+    esp_err_t ret = i2s_driver_install(_port, &i2s_config, 8, &_events);
+    if (ret != ESP_OK) {
+        Serial.printf("[ERROR] 喇叭I2S驱动安装失败: %d\n", ret);
+        return false;
+    }
+
+    i2s_pin_config_t pin_config = {
+        .bck_io_num = bckPin,
+        .ws_io_num = wsPin,
+        .data_out_num = doutPin,
+        .data_in_num = I2S_PIN_NO_CHANGE
+    };
+
+    ret = i2s_set_pin(_port, &pin_config);
+    if (ret != ESP_OK) {
+        Serial.printf("[ERROR] 喇叭I2S引脚配置失败: %d\n", ret);
+        return false;
+    }
+    i2s_zero_dma_buffer(_port);
+
+    BaseType_t ok = xTaskCreatePinnedToCore(taskEntry, "audio_out", 4096, this,
+                                            configMAX_PRIORITIES - 2, &_task, core);
+    return ok == pdPASS;
+}
+
+void AudioPlayback::taskEntry(void* arg) {
+    ((AudioPlayback*)arg)->taskLoop();
+}
+
+void AudioPlayback::countUnderruns(bool playing) {
+    i2s_event_t event;
+    while (xQueueReceive(_events, &event, 0) == pdTRUE) {
+        // 空闲时 DMA 取空是预期行为，只统计播放期间的欠载
+        if (event.type == I2S_EVENT_TX_Q_OVF && playing) {
+            _underruns.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void AudioPlayback::taskLoop() {
+    while (true) {
+        processCommands();
+
+        bool playing = _mixer.isActive();
+        countUnderruns(playing);
+
+        if (!playing) {
+            _voicesActive.store(false, std::memory_order_release);
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(50));
+            continue;
+        }
+
+        size_t written = 0;
+        const int16_t* direct;
+        size_t n = _mixer.directSpan(&direct, PLAYBACK_FRAME_SAMPLES);
+        if (n > 0) {
+            // 零拷贝路径：映射区 -> DMA
+            i2s_write(_port, direct, n * sizeof(int16_t), &written, portMAX_DELAY);
+            _mixer.advance(written / sizeof(int16_t));
+        } else {
+            _mixer.render(_frame, PLAYBACK_FRAME_SAMPLES);
+            i2s_write(_port, _frame, sizeof(_frame), &written, portMAX_DELAY);
+        }
+
+        _voicesActive.store(_mixer.isActive(), std::memory_order_release);
+    }
+}
+
+#endif // ARDUINO
@@ -0,0 +1,93 @@
+#ifndef AUDIO_PLAYBACK_H
+#define AUDIO_PLAYBACK_H
+
+#include <stdint.h>
+#include <atomic>
+#include "AudioMixer.h"
+#include "SoundBank.h"
+#include "SpscRing.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <driver/i2s.h>
+#endif
+
+/**
+ * AudioPlayback - I2S 喇叭流式播放引擎（NS4168）
+ *
+ * 独立的输出任务循环执行：取命令 -> 混音 -> i2s_write。
+ * - 单个 PCM 声部且增益为1时，直接把映射区地址交给 i2s_write，
+ *   数据从闪存直接进入 DMA 缓冲区，没有中间缓冲
+ * - 多声部/ADPCM 时在一个小的帧缓冲中混音后写入
+ * - 空闲时任务阻塞等待通知，DMA 由 tx_desc_auto_clear 自动输出静音
+ * - 播放期间 DMA 取空（I2S_EVENT_TX_Q_OVF）计为一次欠载
+ *
+ * play()/stopAll() 可在任意单一任务中调用（通常是主循环），
+ * 通过 SpscRing 命令队列交给输出任务，调用本身不阻塞。
+ */
+
+#define PLAYBACK_FRAME_SAMPLES 256   // 每次写入 I2S 的采样数（16ms @ 16kHz）
+
+class AudioPlayback {
+public:
+    AudioPlayback(const SoundBank& bank, uint16_t sampleRate = 16000);
+
+#ifdef ARDUINO
+    /**
+     * 安装 I2S TX 驱动并启动输出任务
+     * @param core 输出任务绑定的核心
+     */
+    bool begin(i2s_port_t port, int bckPin, int wsPin, int doutPin, BaseType_t core = 0);
+#endif
+
+    bool play(int clipIndex, uint16_t gainQ15 = AUDIO_GAIN_UNITY, bool loop = false);
+    bool play(const char* clipName, uint16_t gainQ15 = AUDIO_GAIN_UNITY, bool loop = false);
+    void stopAll();
+    void setMasterGain(uint16_t gainQ15);
+
+    // 是否仍有声部在播放（含已提交但尚未被输出任务处理的命令）
+    bool isPlaying() const;
+
+    uint32_t underrunCount() const { return _underruns.load(std::memory_order_relaxed); }
+    uint32_t droppedCommands() const { return _droppedCommands; }
+
+private:
+    enum CommandType : uint8_t {
+        CMD_PLAY,
+        CMD_STOP_ALL,
+        CMD_MASTER_GAIN
+    };
+
+    struct Command {
+        CommandType type;
+        bool loop;
+        uint16_t gain;
+        int16_t clip;
+    };
+
+    bool submit(const Command& cmd);
+    void processCommands();
+
+#ifdef ARDUINO
+    static void taskEntry(void* arg);
+    void taskLoop();
+    void countUnderruns(bool playing);
+
+    i2s_port_t _port;
+    TaskHandle_t _task;
+    QueueHandle_t _events;
+    int16_t _frame[PLAYBACK_FRAME_SAMPLES];
+#endif
+
+    const SoundBank& _bank;
+    AudioMixer _mixer;
+    SpscRing<Command, 8> _commands;
+
+    std::atomic<uint32_t> _submitted;   // 生产者写
+    std::atomic<uint32_t> _processed;   // 输出任务写
+    std::atomic<bool> _voicesActive;
+    std::atomic<uint32_t> _underruns;
+    uint32_t _droppedCommands;
+};
+
+#endif // AUDIO_PLAYBACK_H
@@ -0,0 +1,99 @@
+#include "SoundBank.h"
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include <esp_partition.h>
+#endif
+
+SoundBank::SoundBank()
+    : _base(nullptr), _size(0), _entries(nullptr), _clipCount(0) {}
+
+bool SoundBank::attach(const uint8_t* base, size_t size) {
+    _base = nullptr;
+    _size = 0;
+    _entries = nullptr;
+    _clipCount = 0;
+
+    if (base == nullptr || size < sizeof(SoundBankHeader)) {
+        return false;
+    }
+
+    const SoundBankHeader* header = (const SoundBankHeader*)base;
+    if (header->magic != SOUND_BANK_MAGIC || header->version != SOUND_BANK_VERSION) {
+        return false;
+    }
+
+    size_t tableEnd = sizeof(SoundBankHeader) + (size_t)header->clipCount * sizeof(SoundClipEntry);
+    if (tableEnd > size) {
+        return false;
+    }
+
+    // 逐项检查数据段是否越界，避免坏分区导致越界读取
+    const SoundClipEntry* entries = (const SoundClipEntry*)(base + sizeof(SoundBankHeader));
+    for (uint16_t i = 0; i < header->clipCount; i++) {
+        const SoundClipEntry& e = entries[i];
+        if (e.offset < tableEnd || e.offset > size || e.dataBytes > size - e.offset) {
+            return false;
+        }
+        if (e.format == CLIP_PCM16 && e.dataBytes < e.sampleCount * 2) {
+            return false;
+        }
+        if (e.format == CLIP_IMA_ADPCM && e.dataBytes < (e.sampleCount + 1) / 2) {
+            return false;
+        }
+        if (e.format > CLIP_IMA_ADPCM) {
+            return false;
+        }
+    }
+
+    _base = base;
+    _size = size;
+    _entries = entries;
+    _clipCount = header->clipCount;
+    return true;
+}
+
+#ifdef ESP_PLATFORM
+bool SoundBank::mapPartition(const char* partitionLabel) {
+    const esp_partition_t* part = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, partitionLabel);
+    if (part == nullptr) {
+        return false;
+    }
+
+    // 映射整个分区到数据地址空间；映射句柄不释放，音效库在运行期常驻
+    const void* mapped = nullptr;
+    spi_flash_mmap_handle_t handle;
+    if (esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK) {
+        return false;
+    }
+
+    return attach((const uint8_t*)mapped, part->size);
+}
+#endif
+
+bool SoundBank::getClip(uint16_t index, SoundClip& clip) const {
+    if (index >= _clipCount) {
+        return false;
+    }
+
+    const SoundClipEntry& e = _entries[index];
+    clip.data = _base + e.offset;
+    clip.sampleCount = e.sampleCount;
+    clip.sampleRate = e.sampleRate;
+    clip.format = e.format;
+    return true;
+}
+
+int SoundBank::findClip(const char* name) const {
+    for (uint16_t i = 0; i < _clipCount; i++) {
+        if (strncmp(_entries[i].name, name, SOUND_CLIP_NAME_LEN) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char* SoundBank::clipName(uint16_t index) const {
+    return index < _clipCount ? _entries[index].name : "";
+}
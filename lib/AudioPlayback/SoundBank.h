@@ -0,0 +1,87 @@
+#ifndef SOUND_BANK_H
+#define SOUND_BANK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * SoundBank - 闪存音效库（只读，内存映射）
+ *
+ * 音效库是一个独立的 data 分区（默认名 "sounds"），由
+ * tools/make_soundbank.py 在构建时从 WAV 文件生成。
+ * 设备端用 esp_partition_mmap 映射到地址空间，解析后的
+ * SoundClip 直接指向映射区，播放时不做任何拷贝。
+ *
+ * 二进制格式（小端）：
+ *   SoundBankHeader                 8 字节
+ *   SoundClipEntry[clipCount]       每项 32 字节
+ *   采样数据（每段按4字节对齐）
+ */
+
+#define SOUND_BANK_MAGIC    0x42535249  // "IRSB"
+#define SOUND_BANK_VERSION  1
+#define SOUND_CLIP_NAME_LEN 16
+
+enum SoundClipFormat : uint8_t {
+    CLIP_PCM16     = 0,  // 16位有符号单声道 PCM
+    CLIP_IMA_ADPCM = 1   // IMA ADPCM 4位单声道，低半字节在前，初始预测值0/索引0
+};
+
+struct SoundBankHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t clipCount;
+};
+
+struct SoundClipEntry {
+    char     name[SOUND_CLIP_NAME_LEN];
+    uint8_t  format;
+    uint8_t  reserved;
+    uint16_t sampleRate;
+    uint32_t offset;       // 相对音效库起始地址
+    uint32_t dataBytes;
+    uint32_t sampleCount;
+};
+
+static_assert(sizeof(SoundBankHeader) == 8, "SoundBankHeader 布局错误");
+static_assert(sizeof(SoundClipEntry) == 32, "SoundClipEntry 布局错误");
+
+// 一段可播放的音频（指向映射区，不拥有数据）
+struct SoundClip {
+    const uint8_t* data;
+    uint32_t sampleCount;
+    uint16_t sampleRate;
+    uint8_t  format;
+};
+
+class SoundBank {
+public:
+    SoundBank();
+
+    /**
+     * 从一块内存解析音效库（设备端为映射地址，主机端为文件内容）
+     * @return 格式无效或越界时返回 false
+     */
+    bool attach(const uint8_t* base, size_t size);
+
+#ifdef ESP_PLATFORM
+    /**
+     * 查找并映射闪存分区
+     * @param partitionLabel 分区名（partitions.csv 中的 Name）
+     */
+    bool mapPartition(const char* partitionLabel = "sounds");
+#endif
+
+    uint16_t clipCount() const { return _clipCount; }
+    bool getClip(uint16_t index, SoundClip& clip) const;
+    int findClip(const char* name) const;  // 未找到返回 -1
+    const char* clipName(uint16_t index) const;
+
+private:
+    const uint8_t* _base;
+    size_t _size;
+    const SoundClipEntry* _entries;
+    uint16_t _clipCount;
+};
+
+#endif // SOUND_BANK_H
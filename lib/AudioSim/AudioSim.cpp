@@ -0,0 +1,318 @@
+#include "AudioSim.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+// 与综合测试中的定义一致
+static const float MIC_DISTANCE = 0.07f;  // 7cm
+static const float SOUND_SPEED = 343.0f;  // 声速 m/s
+
+// ========== WavAudioSource ==========
+
+bool WavAudioSource::open(const char* path) {
+    if (!_reader.open(path)) {
+        return false;
+    }
+    // 只接受单声道（复制到左右）或立体声
+    return _reader.channels() == 1 || _reader.channels() == 2;
+}
+
+size_t WavAudioSource::readFrame(int32_t* interleaved, size_t maxFrames) {
+    if (_reader.channels() == 2) {
+        return _reader.readFrames(interleaved, maxFrames);
+    }
+
+    if (maxFrames > CAPTURE_FRAME_SAMPLES) maxFrames = CAPTURE_FRAME_SAMPLES;
+    size_t n = _reader.readFrames(_mono, maxFrames);
+    for (size_t i = 0; i < n; i++) {
+        interleaved[i * 2] = _mono[i];
+        interleaved[i * 2 + 1] = _mono[i];
+    }
+    return n;
+}
+
+// ========== 合成声场 ==========
+
+struct SceneRandom {
+    uint32_t state;
+
+    float uniform() {
+        state = state * 1664525u + 1013904223u;
+        return ((state >> 8) + 0.5f) / 16777216.0f;  // (0, 1)
+    }
+
+    float gaussian() {
+        // Box-Muller
+        float u1 = uniform();
+        float u2 = uniform();
+        return sqrtf(-2.0f * logf(u1)) * cosf(2.0f * (float)M_PI * u2);
+    }
+};
+
+static float sourceSample(const SceneSpec& spec, SceneRandom& rng, float t) {
+    switch (spec.signal) {
+        case SIGNAL_TONE:
+            return sinf(2.0f * (float)M_PI * 500.0f * t);
+
+        case SIGNAL_NOISE_BURST:
+            return rng.uniform() * 2.0f - 1.0f;
+
+        case SIGNAL_SPEECHLIKE:
+        default: {
+            // 150Hz 基频 + 谐波，4Hz 音节包络
+            float v = 0;
+            for (int k = 1; k <= 8; k++) {
+                v += sinf(2.0f * (float)M_PI * 150.0f * k * t) / k;
+            }
+            float envelope = 0.5f * (1.0f - cosf(2.0f * (float)M_PI * 4.0f * t));
+            return v / 2.72f * envelope;  // 谐波和的峰值约 2.72
+        }
+    }
+}
+
+// 舵机自噪声：齿轮啸叫 + 啮合调制的宽带噪声，幅度随速度增大
+static float servoSample(const SceneSpec& spec, SceneRandom& rng, float t) {
+    float v = fabsf(spec.servoVelocityDps);
+    float f0 = 120.0f + 2.5f * v;
+
+    float whine = 0;
+    for (int k = 1; k <= 6; k++) {
+        whine += sinf(2.0f * (float)M_PI * f0 * k * t) / k;
+    }
+    whine /= 2.45f;  // 1 + 1/2 + ... + 1/6
+
+    float mesh = 0.5f * (1.0f + sinf(2.0f * (float)M_PI * f0 * 0.25f * t));
+    float rattle = rng.gaussian() * 0.3f * mesh;
+
+    return (0.6f * whine + rattle) * (0.5f + v / 200.0f);
+}
+
+// 舵机偏左安装：左声道近
+static const float SERVO_CHANNEL_GAIN[2] = { 1.0f, 0.6f };
+
+bool synthesizeScene(const SceneSpec& spec, const char* wavPath) {
+    WavWriter wav;
+    if (!wav.open(wavPath, spec.sampleRate, 2)) {
+        return false;
+    }
+
+    float s = sinf(spec.angleDeg * (float)M_PI / 180.0f);
+    int itd = (int)lroundf(fabsf(MIC_DISTANCE * s / SOUND_SPEED) * spec.sampleRate);
+    float farGain = 1.0f - 0.6f * fabsf(s);
+
+    // 正角度 = 右侧声源：右声道近，左声道延迟且衰减
+    int delayLeft = s > 0 ? itd : 0;
+    int delayRight = s > 0 ? 0 : itd;
+    float gainLeft = s > 0 ? farGain : 1.0f;
+    float gainRight = s > 0 ? 1.0f : farGain;
+
+    SceneRandom sourceRng = { spec.seed };
+    SceneRandom noiseRng = { spec.seed * 7919u + 1 };
+    SceneRandom servoRng = { spec.seed * 104729u + 3 };
+
+    uint32_t total = (uint32_t)(spec.totalSec * spec.sampleRate);
+    int32_t onset = (int32_t)(spec.onsetSec * spec.sampleRate);
+    int32_t length = (int32_t)(spec.durationSec * spec.sampleRate);
+    int32_t servoOnset = (int32_t)(spec.servoOnsetSec * spec.sampleRate);
+    int32_t servoLength = spec.servoLevel > 0 ? (int32_t)(spec.servoDurationSec * spec.sampleRate) : 0;
+
+    // 声源信号预先生成，便于按声道取不同延迟
+    int16_t* source = new int16_t[length > 0 ? length : 1];
+    for (int32_t i = 0; i < length; i++) {
+        float v = sourceSample(spec, sourceRng, (float)i / spec.sampleRate);
+        source[i] = (int16_t)(v * spec.sourceLevel * 32767.0f);
+    }
+
+    const size_t CHUNK = 256;
+    int16_t out[CHUNK * 2];
+    bool ok = true;
+
+    for (uint32_t base = 0; base < total && ok; base += CHUNK) {
+        size_t n = total - base;
+        if (n > CHUNK) n = CHUNK;
+
+        for (size_t i = 0; i < n; i++) {
+            int32_t t = (int32_t)(base + i);
+            float channels[2] = { 0, 0 };
+            int delays[2] = { delayLeft, delayRight };
+            float gains[2] = { gainLeft, gainRight };
+
+            float servo = 0;
+            int32_t ks = t - servoOnset;
+            if (ks >= 0 && ks < servoLength) {
+                servo = servoSample(spec, servoRng, (float)ks / spec.sampleRate) * spec.servoLevel * 32767.0f;
+            }
+
+            for (int c = 0; c < 2; c++) {
+                int32_t k = t - onset - delays[c];
+                if (k >= 0 && k < length) {
+                    channels[c] = source[k] * gains[c];
+                }
+                channels[c] += servo * SERVO_CHANNEL_GAIN[c];
+                channels[c] += noiseRng.gaussian() * spec.noiseLevel * 32767.0f;
+                if (channels[c] > 32767) channels[c] = 32767;
+                if (channels[c] < -32768) channels[c] = -32768;
+                out[i * 2 + c] = (int16_t)channels[c];
+            }
+        }
+        ok = wav.write(out, n * 2);
+    }
+
+    delete[] source;
+    return wav.close() && ok;
+}
+
+// ========== AudioPipelineSim ==========
+
+AudioPipelineSim::AudioPipelineSim(const AudioAnalyzerConfig& config)
+    : _config(config), _verbose(false), _windowSamples(CAPTURE_FRAME_SAMPLES),
+      _hopSamples(CAPTURE_HOP_SAMPLES), _gate(nullptr) {}
+
+void AudioPipelineSim::setFraming(size_t windowSamples, size_t hopSamples) {
+    _windowSamples = windowSamples > 0 ? windowSamples : CAPTURE_FRAME_SAMPLES;
+    _hopSamples = hopSamples > 0 && hopSamples <= _windowSamples ? hopSamples : _windowSamples;
+}
+
+void AudioPipelineSim::setMotion(const SimMotion& motion, SelfNoiseGate* gate) {
+    _motion = motion;
+    _gate = gate;
+}
+
+SimReport AudioPipelineSim::run(AudioSource& source, const SimGroundTruth& truth) {
+    SimReport report = {};
+    report.detectionLatencyMs = -1;
+    report.vadLatencyMs = -1;
+
+    // 与固件 captureFrame() 相同：窗口初始为静音，每读取一个 hop 滑入窗口并分析整个窗口
+    AudioAnalyzer analyzer(slidingWindowConfig(_config, _windowSamples, _hopSamples));
+    std::vector<int32_t> window(_windowSamples * CAPTURE_CHANNELS, 0);
+    std::vector<int32_t> hop(_hopSamples * CAPTURE_CHANNELS);
+    const size_t channelBytes = CAPTURE_CHANNELS * sizeof(int32_t);
+
+    const float rate = (float)source.sampleRate();
+    const bool knowOnset = truth.onsetSec >= 0;
+    const bool knowAngle = !isnan(truth.angleDeg);
+    uint64_t samples = 0;
+    double totalNs = 0;
+    double directionErrorSum = 0;
+
+    const bool hasMotion = _motion.endSec > _motion.startSec;
+
+    while (true) {
+        size_t n = source.readFrame(hop.data(), _hopSamples);
+        if (n == 0) break;
+        size_t keep = _windowSamples - n;
+        memmove(window.data(), window.data() + n * CAPTURE_CHANNELS, keep * channelBytes);
+        memcpy(window.data() + keep * CAPTURE_CHANNELS, hop.data(), n * channelBytes);
+
+        // 分析窗口与运动时间线有重叠即视为运动中（固件由 MotionTracker 的 settle 窗口覆盖）
+        MotionState motion = { false, 0 };
+        uint64_t windowStart = samples + n > _windowSamples ? samples + n - _windowSamples : 0;
+        if (hasMotion && (samples + n) / rate > _motion.startSec && windowStart / rate < _motion.endSec) {
+            motion.moving = true;
+            motion.velocityDps = _motion.velocityDps;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        SelfNoiseResult gate = {};
+        gate.gain = 1.0f;
+        if (_gate != nullptr) {
+            gate = _gate->process(window.data(), _windowSamples, motion);
+        }
+        AudioFrameStats stats = analyzer.process(window.data(), _windowSamples, gate.gain);
+        auto end = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        totalNs += ns;
+        if (ns > report.maxFrameNs) report.maxFrameNs = ns;
+
+        samples += n;
+        report.frames++;
+
+        // 帧结束时刻：一个 hop 采集完才能处理；帧开始为窗口中最早的采样
+        float frameEnd = samples / rate;
+        float frameStart = samples > _windowSamples ? (samples - _windowSamples) / rate : 0.0f;
+        bool sourcePresent = knowOnset && frameEnd > truth.onsetSec &&
+                             (truth.offsetSec < 0 || frameStart < truth.offsetSec);
+        bool beforeOnset = knowOnset && frameEnd <= truth.onsetSec;
+        bool afterOffset = knowOnset && truth.offsetSec >= 0 && frameStart >= truth.offsetSec;
+
+        if (motion.moving) {
+            report.motionFrames++;
+            if (gate.gated) report.gatedFrames++;
+            if (stats.triggered && (beforeOnset || afterOffset)) report.selfNoiseTriggers++;
+        }
+
+        if (stats.triggered) {
+            report.triggeredFrames++;
+            if (beforeOnset) {
+                report.falseTriggers++;
+            } else if (sourcePresent && report.detectionLatencyMs < 0) {
+                report.detectionLatencyMs = (frameEnd - truth.onsetSec) * 1000.0f;
+            }
+
+            if (sourcePresent && knowAngle) {
+                float error = fabsf(stats.direction - truth.angleDeg);
+                directionErrorSum += error;
+                if (error > report.maxDirectionError) report.maxDirectionError = error;
+                report.directionFrames++;
+            }
+        }
+
+        if (stats.voiceActive) {
+            if (beforeOnset) {
+                report.vadFalseFrames++;
+            } else if (sourcePresent && report.vadLatencyMs < 0) {
+                report.vadLatencyMs = (frameEnd - truth.onsetSec) * 1000.0f;
+            }
+        }
+
+        if (_verbose) {
+            printf("  %7.3fs  L=%6.0f R=%6.0f 角度=%6.1f RMS=%6.1f 噪声底=%6.1f %s%s%s\n",
+                   frameEnd, stats.leftPeak, stats.rightPeak, stats.direction,
+                   stats.rms, stats.noiseFloor,
+                   stats.triggered ? "[触发]" : "", stats.voiceActive ? "[语音]" : "",
+                   motion.moving ? (gate.gated ? "[运动/门控]" : "[运动]") : "");
+        }
+    }
+
+    report.audioSeconds = samples / rate;
+    if (report.frames > 0) {
+        report.avgFrameNs = totalNs / report.frames;
+    }
+    if (totalNs > 0) {
+        report.realtimeFactor = report.audioSeconds * 1e9 / totalNs;
+    }
+    if (report.directionFrames > 0) {
+        report.meanDirectionError = (float)(directionErrorSum / report.directionFrames);
+    }
+
+    return report;
+}
+
+void AudioPipelineSim::printReport(const char* label, const SimReport& r) {
+    printf("[SIM] %s\n", label);
+    printf("  音频: %.2fs, %u 帧\n", r.audioSeconds, (unsigned)r.frames);
+    if (r.detectionLatencyMs >= 0) {
+        printf("  触发延迟: %.1f ms\n", r.detectionLatencyMs);
+    } else {
+        printf("  触发延迟: 未检测到\n");
+    }
+    printf("  误触发帧: %u, 触发帧: %u\n", (unsigned)r.falseTriggers, (unsigned)r.triggeredFrames);
+    if (r.vadLatencyMs >= 0) {
+        printf("  VAD 延迟: %.1f ms, VAD 误报帧: %u\n", r.vadLatencyMs, (unsigned)r.vadFalseFrames);
+    } else {
+        printf("  VAD 延迟: 未检测到, VAD 误报帧: %u\n", (unsigned)r.vadFalseFrames);
+    }
+    if (r.directionFrames > 0) {
+        printf("  方向误差: 平均 %.1f°, 最大 %.1f°（%u 帧）\n",
+               r.meanDirectionError, r.maxDirectionError, (unsigned)r.directionFrames);
+    }
+    if (r.motionFrames > 0) {
+        printf("  运动帧: %u, 自噪声触发: %u, 门控帧: %u\n",
+               (unsigned)r.motionFrames, (unsigned)r.selfNoiseTriggers, (unsigned)r.gatedFrames);
+    }
+    printf("  CPU: 平均 %.0f ns/帧, 最大 %.0f ns/帧, 实时倍率 %.0fx\n",
+           r.avgFrameNs, r.maxFrameNs, r.realtimeFactor);
+}
@@ -0,0 +1,158 @@
+#ifndef AUDIO_SIM_H
+#define AUDIO_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include "AudioSource.h"
+#include "AudioAnalyzer.h"
+#include "SelfNoiseGate.h"
+#include "WavFile.h"
+
+/**
+ * AudioSim - 主机端音频链路仿真（WAV 驱动）
+ *
+ * - WavAudioSource：把 WAV 文件当作麦克风，帧格式与 I2S 采集一致
+ * - synthesizeScene()：生成带真值的合成立体声场（声源方向、起始时间、
+ *   左右时间差/衰减、背景噪声、舵机自噪声）
+ * - AudioPipelineSim：按固件的分帧方式（每读取 hop 个采样，分析最近 window 个采样）运行
+ *   AudioAnalyzer（可选 SelfNoiseGate），统计方向误差、检测延迟、误触发、自噪声触发和
+ *   每帧 CPU 耗时，速度远快于实时
+ *
+ * 只用于 native 环境，设备固件不链接本库。
+ */
+
+// ========== WAV 音频源 ==========
+
+class WavAudioSource : public AudioSource {
+public:
+    bool open(const char* path);
+    size_t readFrame(int32_t* interleaved, size_t maxFrames) override;
+    uint32_t sampleRate() const override { return _reader.sampleRate(); }
+    uint32_t totalFrames() const { return _reader.totalFrames(); }
+
+private:
+    WavReader _reader;
+    int32_t _mono[CAPTURE_FRAME_SAMPLES];
+};
+
+// ========== 合成声场 ==========
+
+enum SceneSignal : uint8_t {
+    SIGNAL_TONE,        // 正弦音（500Hz）
+    SIGNAL_NOISE_BURST, // 白噪声
+    SIGNAL_SPEECHLIKE   // 调幅谐波（约4Hz音节节奏），近似语音包络
+};
+
+struct SceneSpec {
+    float angleDeg;       // 声源方向：-90（左）~ +90（右）
+    float onsetSec;       // 声源开始时间
+    float durationSec;    // 声源持续时间
+    float totalSec;       // 文件总长
+    float sourceLevel;    // 声源峰值（16位满量程比例，0~1）
+    float noiseLevel;     // 背景噪声 RMS（0~1）
+    uint32_t sampleRate;
+    SceneSignal signal;
+    uint32_t seed;
+
+    // 舵机自噪声（servoLevel = 0 时不加）
+    float servoLevel;        // 100°/s 时的峰值（0~1），随速度增大
+    float servoVelocityDps;  // 指令速度，决定齿轮啸叫基频
+    float servoOnsetSec;
+    float servoDurationSec;
+
+    SceneSpec()
+        : angleDeg(0), onsetSec(1.0f), durationSec(1.0f), totalSec(3.0f),
+          sourceLevel(0.1f), noiseLevel(0.001f), sampleRate(16000),
+          signal(SIGNAL_SPEECHLIKE), seed(1), servoLevel(0), servoVelocityDps(100),
+          servoOnsetSec(0), servoDurationSec(0) {}
+};
+
+/**
+ * 生成立体声 WAV：
+ * - 时间差 ITD = 麦克风间距 × sin(角度) / 声速，取整到采样
+ * - 远侧声道按简化头影模型衰减：1 - 0.6 × |sin(角度)|
+ * - 舵机自噪声：齿轮啸叫（基频随速度升高，6次谐波）+ 按啮合频率调制的宽带噪声，
+ *   舵机偏左安装，左声道比右声道响（会把方向拉向左侧）
+ */
+bool synthesizeScene(const SceneSpec& spec, const char* wavPath);
+
+// ========== 链路仿真 ==========
+
+// 已知真值（来自合成声场或人工标注）
+struct SimGroundTruth {
+    float onsetSec;       // < 0 表示未知
+    float offsetSec;
+    float angleDeg;       // NAN 表示未知
+
+    SimGroundTruth() : onsetSec(-1), offsetSec(-1), angleDeg(NAN) {}
+};
+
+// 运动时间线（与 SceneSpec 的舵机噪声对应）
+struct SimMotion {
+    float startSec;
+    float endSec;
+    float velocityDps;
+
+    SimMotion() : startSec(0), endSec(0), velocityDps(0) {}
+};
+
+struct SimReport {
+    uint32_t frames;            // 分析次数（每个 hop 一次）
+    float audioSeconds;
+
+    // 触发（volume > 阈值）
+    float detectionLatencyMs;   // 从起始到首次触发，-1 表示未检测到
+    uint32_t falseTriggers;     // 声源出现前的触发帧数
+    uint32_t triggeredFrames;
+
+    // VAD
+    float vadLatencyMs;
+    uint32_t vadFalseFrames;
+
+    // 方向（只统计声源期间且触发的帧）
+    float meanDirectionError;
+    float maxDirectionError;
+    uint32_t directionFrames;
+
+    // 自噪声（只在设置了运动时间线时统计）
+    uint32_t motionFrames;
+    uint32_t selfNoiseTriggers;   // 运动中、声源不在时的触发帧（无效唤醒）
+    uint32_t gatedFrames;
+
+    // 性能
+    double avgFrameNs;
+    double maxFrameNs;
+    double realtimeFactor;
+};
+
+class AudioPipelineSim {
+public:
+    // config 的时间常数按不重叠分帧给出，运行时用 slidingWindowConfig() 换算到当前分帧
+    explicit AudioPipelineSim(const AudioAnalyzerConfig& config = AudioAnalyzerConfig());
+
+    SimReport run(AudioSource& source, const SimGroundTruth& truth);
+
+    void setVerbose(bool verbose) { _verbose = verbose; }
+
+    // 分帧（默认与固件相同：窗口 CAPTURE_FRAME_SAMPLES，每次滑动 CAPTURE_HOP_SAMPLES）；
+    // hop 为 0 或大于窗口时按窗口处理（不重叠分帧）
+    void setFraming(size_t windowSamples, size_t hopSamples);
+    size_t windowSamples() const { return _windowSamples; }
+    size_t hopSamples() const { return _hopSamples; }
+
+    // 设置运动时间线；gate 为 nullptr 时只统计自噪声触发，不做抑制
+    void setMotion(const SimMotion& motion, SelfNoiseGate* gate);
+
+    static void printReport(const char* label, const SimReport& report);
+
+private:
+    AudioAnalyzerConfig _config;
+    bool _verbose;
+    size_t _windowSamples;
+    size_t _hopSamples;
+    SimMotion _motion;
+    SelfNoiseGate* _gate;
+};
+
+#endif // AUDIO_SIM_H
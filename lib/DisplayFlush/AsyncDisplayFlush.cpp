@@ -0,0 +1,104 @@
+#include "AsyncDisplayFlush.h"
+#include <string.h>
+#include "Trace.h"
+
+AsyncDisplayFlush::AsyncDisplayFlush(TileFlusher& flusher)
+    :
+#ifdef ARDUINO
+      _task(nullptr),
+#endif
+      _flusher(flusher), _write(0), _read(2), _pending(1), _invalidate(false),
+      _submitted(0), _dropped(0), _flushed(0), _lastFlushUs(0), _maxFlushUs(0),
+      _flushHistogram(nullptr) {
+    memset(_slots, 0, sizeof(_slots));
+}
+
+// ========== 提交（绘制方任务） ==========
+
+bool AsyncDisplayFlush::submit(const uint8_t* buffer) {
+    memcpy(_slots[_write], buffer, DISPLAY_BUFFER_SIZE);
+
+    // 发布为最新帧，换回中间槽位继续绘制
+    uint8_t old = _pending.exchange((uint8_t)(_write | FRESH), std::memory_order_acq_rel);
+    _write = old & INDEX;
+    _submitted.fetch_add(1, std::memory_order_relaxed);
+
+    bool replaced = (old & FRESH) != 0;
+    if (replaced) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+#ifdef ARDUINO
+    if (_task != nullptr) {
+        xTaskNotifyGive(_task);  // 唤醒等待中的刷新任务
+    }
+#endif
+    return !replaced;
+}
+
+// ========== 发送（刷新任务） ==========
+
+bool AsyncDisplayFlush::service() {
+    if (!pending()) {
+        return false;
+    }
+    uint8_t old = _pending.exchange(_read, std::memory_order_acq_rel);
+    _read = old & INDEX;
+
+    if (_invalidate.exchange(false, std::memory_order_acq_rel)) {
+        _flusher.invalidate();
+    }
+
+    TRACE_SCOPE("display_flush");
+#ifdef ARDUINO
+    uint32_t start = micros();
+#endif
+    _flusher.flush(_slots[_read]);
+#ifdef ARDUINO
+    uint32_t us = micros() - start;
+    _lastFlushUs.store(us, std::memory_order_relaxed);
+    if (us > _maxFlushUs.load(std::memory_order_relaxed)) {
+        _maxFlushUs.store(us, std::memory_order_relaxed);
+    }
+    if (_flushHistogram != nullptr) {
+        _flushHistogram->record(us);
+    }
+#endif
+
+    _flushed.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+DisplayFlushStats AsyncDisplayFlush::stats() const {
+    DisplayFlushStats s;
+    s.submitted = _submitted.load(std::memory_order_relaxed);
+    s.flushed = _flushed.load(std::memory_order_acquire);
+    s.dropped = _dropped.load(std::memory_order_relaxed);
+    s.lastFlushUs = _lastFlushUs.load(std::memory_order_relaxed);
+    s.maxFlushUs = _maxFlushUs.load(std::memory_order_relaxed);
+    return s;
+}
+
+// ========== 刷新任务（设备端） ==========
+
+#ifdef ARDUINO
+
+bool AsyncDisplayFlush::begin(UBaseType_t priority, BaseType_t core) {
+    BaseType_t ok = xTaskCreatePinnedToCore(taskEntry, "display", 3072, this,
+                                            priority, &_task, core);
+    return ok == pdPASS;
+}
+
+void AsyncDisplayFlush::taskEntry(void* arg) {
+    ((AsyncDisplayFlush*)arg)->taskLoop();
+}
+
+void AsyncDisplayFlush::taskLoop() {
+    while (true) {
+        if (!service()) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+        }
+    }
+}
+
+#endif // ARDUINO
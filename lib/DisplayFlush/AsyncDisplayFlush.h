@@ -0,0 +1,97 @@
+#ifndef ASYNC_DISPLAY_FLUSH_H
+#define ASYNC_DISPLAY_FLUSH_H
+
+#include <stdint.h>
+#include <atomic>
+#include "TileFlusher.h"
+#include "LatencyHistogram.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+/**
+ * AsyncDisplayFlush - 显示刷新任务（I2C 不在主循环中发送）
+ *
+ * 主循环照常在 U8g2 缓冲（后台缓冲）中绘制，然后 submit()：
+ * 把整帧复制进一个空闲槽位并发布为"最新帧"，固定耗时（1KB 复制），与总线速度无关。
+ * 低优先级刷新任务取出最新帧，交给 TileFlusher 只发送变化的块。
+ *
+ * 三个槽位轮换（绘制方一个、刷新任务一个、中间一个"最新帧"），用一个原子下标交换：
+ * - 刷新任务还没取走上一帧时再次 submit()，上一帧直接被替换（计为丢帧），不会排队
+ * - 刷新任务发送的槽位在发送期间不会被绘制方改写
+ *
+ * ESP32-S3 的 I2C 控制器没有 DMA，Wire 发送时刷新任务阻塞等待 I2C 中断，CPU 让给其他任务。
+ * 启动任务后所有显示访问（包括 invalidate）都应经过本类，不要在主循环里再直接操作总线。
+ */
+
+#define DISPLAY_FLUSH_SLOTS 3
+
+struct DisplayFlushStats {
+    uint32_t submitted;   // submit() 次数
+    uint32_t flushed;     // 刷新任务发送的帧数
+    uint32_t dropped;     // 尚未发送就被更新帧替换的帧数
+    uint32_t lastFlushUs; // 最近一次发送耗时（设备端）
+    uint32_t maxFlushUs;  // 最长一次发送耗时（设备端）
+};
+
+class AsyncDisplayFlush {
+public:
+    explicit AsyncDisplayFlush(TileFlusher& flusher);
+
+#ifdef ARDUINO
+    /**
+     * 启动刷新任务
+     * @param priority 任务优先级（低于控制/音频任务）
+     */
+    bool begin(UBaseType_t priority = 1, BaseType_t core = 0);
+#endif
+
+    // 主循环：提交一帧（复制后立即返回），返回 false 表示替换了一帧尚未发送的帧
+    bool submit(const uint8_t* buffer);
+
+    // 下一次发送整帧（屏幕内容未知时）
+    void invalidate() { _invalidate.store(true, std::memory_order_release); }
+
+    /**
+     * 刷新任务：有新帧时取出并发送
+     * 设备端由任务循环调用，主机端测试直接调用（或在另一个线程中调用）
+     * @return 是否发送了一帧
+     */
+    bool service();
+
+    // 是否有已提交但尚未被刷新任务取走的帧
+    bool pending() const { return (_pending.load(std::memory_order_acquire) & FRESH) != 0; }
+
+    DisplayFlushStats stats() const;
+
+    // 每次发送的耗时（设备端）另外记入直方图（只由刷新任务写），在启动任务前设置
+    void setFlushHistogram(LatencyHistogram* histogram) { _flushHistogram = histogram; }
+
+private:
+    static const uint8_t FRESH = 0x80;   // _pending 中的"新帧"标志
+    static const uint8_t INDEX = 0x03;
+
+#ifdef ARDUINO
+    static void taskEntry(void* arg);
+    void taskLoop();
+
+    TaskHandle_t _task;
+#endif
+
+    TileFlusher& _flusher;
+    uint8_t _slots[DISPLAY_FLUSH_SLOTS][DISPLAY_BUFFER_SIZE];
+    uint8_t _write;                       // 绘制方持有
+    uint8_t _read;                        // 刷新任务持有
+    std::atomic<uint8_t> _pending;        // 最新帧槽位 | FRESH
+    std::atomic<bool> _invalidate;
+
+    std::atomic<uint32_t> _submitted;     // 绘制方写
+    std::atomic<uint32_t> _dropped;       // 绘制方写
+    std::atomic<uint32_t> _flushed;       // 刷新任务写
+    std::atomic<uint32_t> _lastFlushUs;
+    std::atomic<uint32_t> _maxFlushUs;
+    LatencyHistogram* _flushHistogram;
+};
+
+#endif // ASYNC_DISPLAY_FLUSH_H
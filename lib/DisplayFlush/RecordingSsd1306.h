@@ -0,0 +1,134 @@
+#ifndef RECORDING_SSD1306_H
+#define RECORDING_SSD1306_H
+
+#include <stdint.h>
+#include <string.h>
+#include "TileFlusher.h"
+#include "ScrollTicker.h"
+
+/**
+ * RecordingSsd1306 - 主机端 SSD1306 显存模拟（命令级）
+ *
+ * 代替 U8x8 + Wire：解析页寻址模式下的命令（页地址、列地址、滚动命令），数据写入模拟显存 ram
+ * （格式同 U8g2 缓冲），并按 ScrollTicker::commandBytes()/dataBytes() 统计总线字节。
+ * - 0x2C/0x2D 单列滚动：指定页整体右移/左移一列，移出的一列回绕到另一端
+ * - 0x26/0x27 连续滚动 + 0x2F 激活：只记录状态，激活期间写显存计为 writesWhileScrolling（数据手册不允许）
+ * 其他带参数的命令只跳过参数。
+ */
+
+class RecordingSsd1306 : public Ssd1306CommandTransport {
+public:
+    RecordingSsd1306() {
+        memset(ram, 0, sizeof(ram));
+        _page = 0;
+        _column = 0;
+        scrolling = false;
+        reset();
+    }
+
+    void sendCommands(const uint8_t* cmds, uint8_t count) override {
+        transfers++;
+        bytes += ScrollTicker::commandBytes(count);
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t c = cmds[i];
+            uint8_t remaining = (uint8_t)(count - i - 1);
+            if (c >= 0xB0 && c <= 0xB7) {
+                _page = c & 0x07;
+            } else if (c <= 0x0F) {
+                _column = (uint8_t)((_column & 0xF0) | c);
+            } else if (c >= 0x10 && c <= 0x1F) {
+                _column = (uint8_t)((_column & 0x0F) | ((c & 0x0F) << 4));
+            } else if (c == 0x2C || c == 0x2D) {
+                if (remaining < 6) {
+                    malformed++;
+                    return;
+                }
+                scrollOne(cmds[i + 2] & 0x07, cmds[i + 4] & 0x07, c == 0x2D);
+                i += 6;
+            } else if (c == 0x26 || c == 0x27) {
+                if (remaining < 6) {
+                    malformed++;
+                    return;
+                }
+                i += 6;
+            } else if (c == 0x2F) {
+                scrolling = true;
+            } else if (c == 0x2E) {
+                scrolling = false;
+            } else {
+                i += paramCount(c);
+            }
+        }
+    }
+
+    void sendData(const uint8_t* data, uint8_t count) override {
+        transfers++;
+        bytes += ScrollTicker::dataBytes(count);
+        if (scrolling) {
+            writesWhileScrolling++;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            ram[_page * DISPLAY_WIDTH + _column] = data[i];
+            _column = (uint8_t)((_column + 1) & (DISPLAY_WIDTH - 1));   // 页寻址：在页内回绕
+        }
+    }
+
+    // 屏幕上 (x, y) 是否点亮
+    bool pixel(int x, int y) const {
+        return (ram[(y >> 3) * DISPLAY_WIDTH + x] >> (y & 7)) & 1;
+    }
+
+    // 只清零计数，显存保持
+    void reset() {
+        transfers = 0;
+        bytes = 0;
+        scrollSteps = 0;
+        writesWhileScrolling = 0;
+        malformed = 0;
+    }
+
+    uint8_t ram[DISPLAY_BUFFER_SIZE];
+    bool scrolling;
+    uint32_t transfers;
+    uint32_t bytes;
+    uint32_t scrollSteps;
+    uint32_t writesWhileScrolling;
+    uint32_t malformed;
+
+private:
+    void scrollOne(uint8_t startPage, uint8_t endPage, bool left) {
+        scrollSteps++;
+        for (uint8_t p = startPage; p <= endPage && p < DISPLAY_TILE_ROWS; p++) {
+            uint8_t* row = ram + p * DISPLAY_WIDTH;
+            if (left) {
+                uint8_t first = row[0];
+                memmove(row, row + 1, DISPLAY_WIDTH - 1);
+                row[DISPLAY_WIDTH - 1] = first;
+            } else {
+                uint8_t last = row[DISPLAY_WIDTH - 1];
+                memmove(row + 1, row, DISPLAY_WIDTH - 1);
+                row[0] = last;
+            }
+        }
+    }
+
+    // 带参数的单字节命令的参数个数（页寻址模式下常见的初始化命令）
+    static uint8_t paramCount(uint8_t c) {
+        switch (c) {
+            case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+            case 0xD5: case 0xD9: case 0xDA: case 0xDB: case 0xA3:
+                return 1;
+            case 0x21: case 0x22:
+                return 2;
+            case 0x29: case 0x2A:
+                return 5;
+            default:
+                return 0;
+        }
+    }
+
+    uint8_t _page;
+    uint8_t _column;
+};
+
+#endif // RECORDING_SSD1306_H
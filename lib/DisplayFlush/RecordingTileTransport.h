@@ -0,0 +1,70 @@
+#ifndef RECORDING_TILE_TRANSPORT_H
+#define RECORDING_TILE_TRANSPORT_H
+
+#include <stdint.h>
+#include <string.h>
+#include "TileFlusher.h"
+
+/**
+ * RecordingTileTransport - 主机端 SSD1306 I2C 总线模拟
+ *
+ * 代替 U8g2 + Wire：把收到的块写进模拟的显存（screen，格式同 U8g2 缓冲），
+ * 并按 U8g2 SSD1306 I2C（u8x8_cad_ssd13xx_fast_i2c）的分包方式统计总线字节：
+ * - 每次 drawTiles()：一次命令传输 = 地址 + 0x00 + 列高位/列低位/页地址 3 条命令，共 5 字节
+ * - 数据按每包最多 24 字节拆分，每包 = 地址 + 0x40 + 数据
+ * 整帧 sendBuffer() 相当于 8 页各发 16 个块，共 1160 字节。
+ */
+
+#define SSD1306_I2C_CMD_BYTES     5
+#define SSD1306_I2C_DATA_CHUNK    24
+#define SSD1306_I2C_CHUNK_HEADER  2
+
+class RecordingTileTransport : public DisplayTileTransport {
+public:
+    RecordingTileTransport() {
+        memset(screen, 0, sizeof(screen));
+        reset();
+    }
+
+    void drawTiles(uint8_t tx, uint8_t ty, uint8_t count, const uint8_t* tiles) override {
+        calls++;
+        tilesDrawn += count;
+        bytes += busBytes(count);
+        if (ty < DISPLAY_TILE_ROWS && tx + count <= DISPLAY_TILE_COLS) {
+            memcpy(screen + ty * DISPLAY_WIDTH + tx * 8, tiles, count * 8);
+        } else {
+            outOfRange++;
+        }
+    }
+
+    // 一次 drawTiles() 在总线上的字节数
+    static uint32_t busBytes(uint8_t count) {
+        uint32_t data = count * 8;
+        uint32_t chunks = (data + SSD1306_I2C_DATA_CHUNK - 1) / SSD1306_I2C_DATA_CHUNK;
+        return SSD1306_I2C_CMD_BYTES + chunks * SSD1306_I2C_CHUNK_HEADER + data;
+    }
+
+    // 整帧 sendBuffer() 的字节数
+    static uint32_t fullFrameBytes() { return DISPLAY_TILE_ROWS * busBytes(DISPLAY_TILE_COLS); }
+
+    // 按每字节 9 个时钟（8 位 + ACK）估算总线时间
+    static float busTimeMs(uint32_t byteCount, uint32_t clockHz = 400000) {
+        return byteCount * 9 * 1000.0f / clockHz;
+    }
+
+    // 只清零计数，显存保持（与真实屏幕一样）
+    void reset() {
+        calls = 0;
+        tilesDrawn = 0;
+        bytes = 0;
+        outOfRange = 0;
+    }
+
+    uint8_t screen[DISPLAY_BUFFER_SIZE];
+    uint32_t calls;
+    uint32_t tilesDrawn;
+    uint32_t bytes;
+    uint32_t outOfRange;
+};
+
+#endif // RECORDING_TILE_TRANSPORT_H
@@ -0,0 +1,144 @@
+#include "ScrollTicker.h"
+#include <string.h>
+
+// SSD1306 命令
+#define SSD1306_SCROLL_OFF          0x2E
+#define SSD1306_SCROLL_LEFT_ONE     0x2D   // 内容左移一列（不需要激活）
+#define SSD1306_SET_PAGE            0xB0
+#define SSD1306_SET_COLUMN_LOW      0x00
+#define SSD1306_SET_COLUMN_HIGH     0x10
+
+#define I2C_TRANSFER_HEADER  2    // 地址 + 控制字节
+#define I2C_DATA_CHUNK       24   // U8g2 I2C 每包最多 24 字节数据
+
+ScrollTicker::ScrollTicker(Ssd1306CommandTransport& bus)
+    : _bus(bus), _columns(nullptr), _width(0), _gap(DISPLAY_WIDTH), _page(0),
+      _running(false), _position(0), _stepMs(20), _nextStepMs(0), _timeValid(false) {
+    resetStats();
+}
+
+void ScrollTicker::resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+uint32_t ScrollTicker::commandBytes(uint8_t count) {
+    return I2C_TRANSFER_HEADER + count;
+}
+
+uint32_t ScrollTicker::dataBytes(uint16_t count) {
+    uint32_t chunks = (count + I2C_DATA_CHUNK - 1) / I2C_DATA_CHUNK;
+    return chunks * I2C_TRANSFER_HEADER + count;
+}
+
+uint32_t ScrollTicker::stepBytes() {
+    // 滚动命令 + 第一页地址一次传输，之后每页一次数据、除第一页外各一次地址
+    return commandBytes(TICKER_SCROLL_CMD_BYTES + 3) + (TICKER_PAGES - 1) * commandBytes(3) +
+           TICKER_PAGES * dataBytes(1);
+}
+
+uint32_t ScrollTicker::fullFrameBytes() {
+    return DISPLAY_TILE_ROWS * (commandBytes(3) + dataBytes(DISPLAY_WIDTH));
+}
+
+void ScrollTicker::sendCommands(const uint8_t* cmds, uint8_t count) {
+    _bus.sendCommands(cmds, count);
+    _stats.transfers++;
+    _stats.busBytes += commandBytes(count);
+}
+
+void ScrollTicker::sendData(const uint8_t* data, uint8_t count) {
+    _bus.sendData(data, count);
+    _stats.transfers++;
+    _stats.busBytes += dataBytes(count);
+}
+
+void ScrollTicker::setSpeed(uint16_t pixelsPerSecond) {
+    if (pixelsPerSecond == 0) {
+        pixelsPerSecond = 1;
+    }
+    uint16_t ms = (uint16_t)(1000 / pixelsPerSecond);
+    _stepMs = ms < TICKER_MIN_STEP_MS ? TICKER_MIN_STEP_MS : ms;
+}
+
+uint16_t ScrollTicker::streamColumn(int32_t index) const {
+    if (index < 0 || _columns == nullptr) {
+        return 0;
+    }
+    uint32_t period = (uint32_t)_width + _gap;
+    uint32_t i = (uint32_t)index % period;
+    return i < _width ? _columns[i] : 0;
+}
+
+void ScrollTicker::begin(uint8_t page, const uint16_t* columns, uint16_t width, uint16_t gap) {
+    _page = page;
+    _columns = columns;
+    _width = width;
+    _gap = (width + gap) > 0 ? gap : 1;
+    _position = 0;
+    _timeValid = false;
+
+    // 关闭连续滚动（写显存前必须关闭），清空字幕区
+    uint8_t off = SSD1306_SCROLL_OFF;
+    sendCommands(&off, 1);
+    uint8_t zeros[DISPLAY_WIDTH];
+    memset(zeros, 0, sizeof(zeros));
+    for (uint8_t p = 0; p < TICKER_PAGES; p++) {
+        uint8_t addr[3] = {(uint8_t)(SSD1306_SET_PAGE | (page + p)), SSD1306_SET_COLUMN_LOW, SSD1306_SET_COLUMN_HIGH};
+        sendCommands(addr, 3);
+        sendData(zeros, DISPLAY_WIDTH);
+    }
+    _running = true;
+}
+
+void ScrollTicker::step() {
+    if (!_running) {
+        return;
+    }
+    // 新露出的最右列显示字幕流的第 position 列
+    uint16_t col = streamColumn((int32_t)_position);
+    const uint8_t last = DISPLAY_WIDTH - 1;
+
+    for (uint8_t p = 0; p < TICKER_PAGES; p++) {
+        uint8_t cmds[TICKER_SCROLL_CMD_BYTES + 3];
+        uint8_t n = 0;
+        if (p == 0) {
+            // 单列左移：A 空 / B 起始页 / C 0x01 / D 结束页 / E 0x00 / F 0xFF
+            cmds[n++] = SSD1306_SCROLL_LEFT_ONE;
+            cmds[n++] = 0x00;
+            cmds[n++] = _page;
+            cmds[n++] = 0x01;
+            cmds[n++] = (uint8_t)(_page + TICKER_PAGES - 1);
+            cmds[n++] = 0x00;
+            cmds[n++] = 0xFF;
+        }
+        cmds[n++] = (uint8_t)(SSD1306_SET_PAGE | (_page + p));
+        cmds[n++] = (uint8_t)(SSD1306_SET_COLUMN_LOW | (last & 0x0F));
+        cmds[n++] = (uint8_t)(SSD1306_SET_COLUMN_HIGH | (last >> 4));
+        sendCommands(cmds, n);
+
+        uint8_t data = (uint8_t)(col >> (p * 8));
+        sendData(&data, 1);
+    }
+    _position++;
+    _stats.steps++;
+}
+
+uint8_t ScrollTicker::update(uint32_t nowMs) {
+    if (!_running) {
+        return 0;
+    }
+    if (!_timeValid) {
+        _nextStepMs = nowMs;
+        _timeValid = true;
+    }
+    uint8_t steps = 0;
+    while ((int32_t)(nowMs - _nextStepMs) >= 0 && steps < 4) {
+        step();
+        _nextStepMs += _stepMs;
+        steps++;
+    }
+    if ((int32_t)(nowMs - _nextStepMs) >= 0) {
+        _nextStepMs = nowMs + _stepMs;   // 落后太多：丢掉积压的步数
+    }
+    return steps;
+}
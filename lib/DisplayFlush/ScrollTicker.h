@@ -0,0 +1,136 @@
+#ifndef SCROLL_TICKER_H
+#define SCROLL_TICKER_H
+
+#include <stdint.h>
+#include "TileFlusher.h"
+
+#ifdef ARDUINO
+#include <U8g2lib.h>
+#endif
+
+/**
+ * ScrollTicker - 用 SSD1306 硬件滚动实现的横向滚动字幕
+ *
+ * 原来的滚动文字每移动 2 像素就清屏、重画、整帧 sendBuffer()（1160 字节），动画期间 CPU 和 I2C 一直被占用。
+ * 本模块让屏幕自己移动显存：
+ * - 每一步发送一条单列滚动命令（0x2D，左移一列，只作用于字幕所在的 2 页），显存内容整体左移一列
+ * - SSD1306 没有屏幕外的列：最左一列移出后回绕到最右列，紧接着把字幕的下一列写进最右列（每页 1 字节）
+ * - 每步总线约 23 字节，与文字长度无关；文字可以比屏幕长（按列从字幕条中取）
+ *
+ * 字幕条为按列位图（每列 uint16_t，bit0 为字幕区最上一行，见 GlyphCache::renderColumns()），
+ * 后面接 gap 列空白后循环。开始时字幕区为空，文字从右边进入（与原来从 x = 128 开始相同）。
+ *
+ * 滚动期间不要再经 TileFlusher 发送字幕区；stop() 后屏幕内容与 U8g2 缓冲不一致，调用方需要 invalidate() 或重画整帧。
+ * 连续两次单列滚动之间至少间隔一帧（SSD1306 默认约 100Hz），update() 按 TICKER_MIN_STEP_MS 限制步进速度。
+ */
+
+#define TICKER_PAGES             2      // 字幕区高度（页），16 像素
+#define TICKER_SCROLL_CMD_BYTES  7
+#define TICKER_MIN_STEP_MS       10
+
+// SSD1306 命令/数据发送（每次调用为一次 I2C 传输）
+class Ssd1306CommandTransport {
+public:
+    virtual ~Ssd1306CommandTransport() {}
+
+    virtual void sendCommands(const uint8_t* cmds, uint8_t count) = 0;
+    virtual void sendData(const uint8_t* data, uint8_t count) = 0;
+};
+
+struct TickerStats {
+    uint32_t steps;       // 滚动的列数
+    uint32_t transfers;   // I2C 传输次数
+    uint32_t busBytes;    // 总线字节（含地址和控制字节）
+};
+
+class ScrollTicker {
+public:
+    explicit ScrollTicker(Ssd1306CommandTransport& bus);
+
+    /**
+     * 开始滚动：清空字幕区（page ~ page+1 两页），之后每一步左移一列
+     * @param columns 字幕条（按列），在滚动期间须保持有效
+     * @param gap 两次出现之间的空白列数（默认一屏宽）
+     */
+    void begin(uint8_t page, const uint16_t* columns, uint16_t width, uint16_t gap = DISPLAY_WIDTH);
+
+    // 停止（屏幕保持当前内容）
+    void stop() { _running = false; }
+
+    // 设置速度（像素/秒），下一次 update() 起生效
+    void setSpeed(uint16_t pixelsPerSecond);
+
+    /**
+     * 按时间推进，每次最多补 4 步（落后太多时丢弃，不一次性猛追）
+     * @return 本次滚动的列数
+     */
+    uint8_t update(uint32_t nowMs);
+
+    // 左移一列并写入新露出的列
+    void step();
+
+    bool running() const { return _running; }
+    // 已滚动的列数：屏幕第 x 列显示字幕流的第 position() - 128 + x 列（负数为空白）
+    uint32_t position() const { return _position; }
+    // 字幕条第一次完全移出屏幕时 position() 的值
+    uint32_t passLength() const { return (uint32_t)_width + DISPLAY_WIDTH; }
+
+    // 字幕流第 index 列（含循环和空白）
+    uint16_t streamColumn(int32_t index) const;
+
+    const TickerStats& stats() const { return _stats; }
+    void resetStats();
+
+    // 每一步的总线字节数
+    static uint32_t stepBytes();
+    // 整帧发送（U8g2 sendBuffer()）的总线字节数，用于对比
+    static uint32_t fullFrameBytes();
+    // SSD1306 I2C 传输的总线字节数（与 U8g2 fast I2C 相同：地址 + 控制字节，数据按 24 字节分包）
+    static uint32_t commandBytes(uint8_t count);
+    static uint32_t dataBytes(uint16_t count);
+
+private:
+    void sendCommands(const uint8_t* cmds, uint8_t count);
+    void sendData(const uint8_t* data, uint8_t count);
+
+    Ssd1306CommandTransport& _bus;
+    const uint16_t* _columns;
+    uint16_t _width;
+    uint16_t _gap;
+    uint8_t _page;
+    bool _running;
+    uint32_t _position;
+
+    uint16_t _stepMs;
+    uint32_t _nextStepMs;
+    bool _timeValid;
+
+    TickerStats _stats;
+};
+
+#ifdef ARDUINO
+// 经 U8x8 的命令/数据接口直接发送（与 U8g2 共用同一 I2C 总线，调用方保证不与刷新任务同时使用）
+class U8x8CommandTransport : public Ssd1306CommandTransport {
+public:
+    explicit U8x8CommandTransport(U8G2& u8g2) : _u8x8(u8g2.getU8x8()) {}
+
+    void sendCommands(const uint8_t* cmds, uint8_t count) override {
+        u8x8_cad_StartTransfer(_u8x8);
+        for (uint8_t i = 0; i < count; i++) {
+            u8x8_cad_SendCmd(_u8x8, cmds[i]);
+        }
+        u8x8_cad_EndTransfer(_u8x8);
+    }
+
+    void sendData(const uint8_t* data, uint8_t count) override {
+        u8x8_cad_StartTransfer(_u8x8);
+        u8x8_cad_SendData(_u8x8, count, (uint8_t*)data);
+        u8x8_cad_EndTransfer(_u8x8);
+    }
+
+private:
+    u8x8_t* _u8x8;
+};
+#endif
+
+#endif // SCROLL_TICKER_H
@@ -0,0 +1,70 @@
+#include "TileFlusher.h"
+#include <string.h>
+
+TileFlusher::TileFlusher(DisplayTileTransport& transport)
+    : _transport(transport), _valid(false) {
+    memset(_sent, 0, sizeof(_sent));
+    resetStats();
+}
+
+void TileFlusher::resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+uint16_t TileFlusher::diff(const uint8_t* buffer, uint16_t rowMasks[DISPLAY_TILE_ROWS]) const {
+    uint16_t changed = 0;
+    for (uint8_t ty = 0; ty < DISPLAY_TILE_ROWS; ty++) {
+        uint16_t mask = 0;
+        if (!_valid) {
+            mask = (uint16_t)((1u << DISPLAY_TILE_COLS) - 1);
+        } else {
+            const uint8_t* row = buffer + ty * DISPLAY_WIDTH;
+            const uint8_t* sentRow = _sent + ty * DISPLAY_WIDTH;
+            for (uint8_t tx = 0; tx < DISPLAY_TILE_COLS; tx++) {
+                if (memcmp(row + tx * 8, sentRow + tx * 8, 8) != 0) {
+                    mask |= (uint16_t)(1u << tx);
+                }
+            }
+        }
+        rowMasks[ty] = mask;
+        changed += (uint16_t)__builtin_popcount(mask);
+    }
+    return changed;
+}
+
+uint16_t TileFlusher::flush(const uint8_t* buffer) {
+    _stats.flushes++;
+
+    uint16_t masks[DISPLAY_TILE_ROWS];
+    uint16_t changed = diff(buffer, masks);
+    if (changed == 0) {
+        _stats.unchanged++;
+        return 0;
+    }
+
+    for (uint8_t ty = 0; ty < DISPLAY_TILE_ROWS; ty++) {
+        uint16_t mask = masks[ty];
+        uint8_t tx = 0;
+        while (mask) {
+            // 跳过未变化的块，取出一段连续变化的块
+            while (!(mask & 1)) {
+                mask >>= 1;
+                tx++;
+            }
+            uint8_t start = tx;
+            while (mask & 1) {
+                mask >>= 1;
+                tx++;
+            }
+            uint8_t count = tx - start;
+            size_t offset = ty * DISPLAY_WIDTH + start * 8;
+            _transport.drawTiles(start, ty, count, buffer + offset);
+            memcpy(_sent + offset, buffer + offset, count * 8);
+            _stats.runs++;
+        }
+    }
+
+    _valid = true;
+    _stats.tiles += changed;
+    return changed;
+}
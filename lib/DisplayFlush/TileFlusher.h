@@ -0,0 +1,91 @@
+#ifndef TILE_FLUSHER_H
+#define TILE_FLUSHER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <U8g2lib.h>
+#endif
+
+/**
+ * TileFlusher - SSD1306 按 8×8 块增量刷新
+ *
+ * U8g2 的全缓冲模式每次 sendBuffer() 都把 1KB 帧全部经 I2C 发出（400kHz 下约 26ms），
+ * 而一次 updateDisplay() 通常只改了音量数字和音量条。本模块：
+ * - 保存上一次发出的帧（影子缓冲），新帧按 8×8 块（U8g2 的 tile，缓冲中连续 8 字节）比较
+ * - 每一页（块行）中连续变化的块合成一段，每段调用一次发送器的 drawTiles()
+ *   （设备端即 U8g2 updateDisplayArea() 使用的 u8x8_DrawTile()）
+ * - 没有变化时不访问总线
+ *
+ * 缓冲格式与 U8g2 SSD1306 128×64 全缓冲相同：按页（8行）排列，
+ * buffer[page * 128 + x] 的 bit0~7 为该列从上到下 8 个像素，块 (tx, ty) 为 buffer[ty * 128 + tx * 8] 起 8 字节。
+ */
+
+#define DISPLAY_WIDTH        128
+#define DISPLAY_HEIGHT       64
+#define DISPLAY_TILE_COLS    (DISPLAY_WIDTH / 8)
+#define DISPLAY_TILE_ROWS    (DISPLAY_HEIGHT / 8)
+#define DISPLAY_BUFFER_SIZE  (DISPLAY_WIDTH * DISPLAY_TILE_ROWS)
+
+// 块发送器：设备端 U8g2TileTransport，主机端 RecordingTileTransport
+class DisplayTileTransport {
+public:
+    virtual ~DisplayTileTransport() {}
+
+    // 发送第 ty 页中从 tx 开始的 count 个块（tiles 为 count * 8 字节）
+    virtual void drawTiles(uint8_t tx, uint8_t ty, uint8_t count, const uint8_t* tiles) = 0;
+};
+
+struct TileFlushStats {
+    uint32_t flushes;     // flush() 调用次数
+    uint32_t unchanged;   // 没有任何变化、未访问总线的次数
+    uint32_t tiles;       // 发出的块数
+    uint32_t runs;        // drawTiles() 调用次数
+};
+
+class TileFlusher {
+public:
+    explicit TileFlusher(DisplayTileTransport& transport);
+
+    /**
+     * 比较新帧与上次发出的帧，只发送变化的块
+     * @return 发出的块数
+     */
+    uint16_t flush(const uint8_t* buffer);
+
+    /**
+     * 只比较不发送：rowMasks[ty] 的 bit tx 表示块 (tx, ty) 有变化
+     * @return 变化的块数
+     */
+    uint16_t diff(const uint8_t* buffer, uint16_t rowMasks[DISPLAY_TILE_ROWS]) const;
+
+    // 屏幕内容未知（重新初始化、硬件滚动等）时调用，下一次 flush() 发送整帧
+    void invalidate() { _valid = false; }
+
+    const TileFlushStats& stats() const { return _stats; }
+    void resetStats();
+
+private:
+    DisplayTileTransport& _transport;
+    uint8_t _sent[DISPLAY_BUFFER_SIZE];   // 屏幕上当前的内容
+    bool _valid;
+    TileFlushStats _stats;
+};
+
+#ifdef ARDUINO
+// 通过 U8g2 的块接口发送（与 updateDisplayArea() 相同的底层调用，只发出指定块）
+class U8g2TileTransport : public DisplayTileTransport {
+public:
+    explicit U8g2TileTransport(U8G2& u8g2) : _u8g2(u8g2) {}
+
+    void drawTiles(uint8_t tx, uint8_t ty, uint8_t count, const uint8_t* tiles) override {
+        u8x8_DrawTile(_u8g2.getU8x8(), tx, ty, count, (uint8_t*)tiles);
+    }
+
+private:
+    U8G2& _u8g2;
+};
+#endif
+
+#endif // TILE_FLUSHER_H
@@ -0,0 +1,300 @@
+#include "GlyphCache.h"
+#include <string.h>
+#include "TileFlusher.h"
+
+// ========== 位图绘制 ==========
+
+void glyphBlitColumns(uint8_t* buffer, int16_t x, int16_t y, const uint16_t* columns, uint8_t width) {
+    if (y <= -GLYPH_COLUMN_BITS || y >= DISPLAY_HEIGHT) {
+        return;
+    }
+    // 顶边所在页和页内偏移（y 可能为负：按向下取整的页计算）
+    int16_t page0 = (int16_t)((y + 64) >> 3) - 8;
+    uint8_t shift = (uint8_t)(y & 7);
+    for (uint8_t c = 0; c < width; c++) {
+        int16_t px = x + c;
+        uint32_t v = (uint32_t)columns[c] << shift;
+        if (v == 0 || px < 0 || px >= DISPLAY_WIDTH) {
+            continue;
+        }
+        // 16 位列移位后最多跨 3 页
+        for (int16_t p = page0; v != 0; p++, v >>= 8) {
+            if (p >= 0 && p < DISPLAY_TILE_ROWS) {
+                buffer[p * DISPLAY_WIDTH + px] |= (uint8_t)v;
+            }
+        }
+    }
+}
+
+void glyphBlitRows(uint8_t* buffer, int16_t x, int16_t y, const uint8_t* bits, uint8_t width, uint8_t height) {
+    uint8_t rowBytes = (uint8_t)((width + 7) / 8);
+    for (uint8_t r = 0; r < height; r++, bits += rowBytes) {
+        int16_t py = y + r;
+        if (py < 0 || py >= DISPLAY_HEIGHT) {
+            continue;
+        }
+        uint8_t* page = buffer + (py >> 3) * DISPLAY_WIDTH;
+        uint8_t mask = (uint8_t)(1 << (py & 7));
+        for (uint8_t c = 0; c < width; c++) {
+            int16_t px = x + c;
+            if ((bits[c >> 3] & (0x80 >> (c & 7))) && px >= 0 && px < DISPLAY_WIDTH) {
+                page[px] |= mask;
+            }
+        }
+    }
+}
+
+const GlyphLabel* glyphLabelFind(const GlyphLabel* labels, size_t count, const char* text) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(labels[i].text, text) == 0) {
+            return &labels[i];
+        }
+    }
+    return nullptr;
+}
+
+int16_t glyphLabelDraw(uint8_t* buffer, int16_t x, int16_t y, const GlyphLabel& label) {
+    glyphBlitColumns(buffer, x + label.left, y - label.top, label.columns, label.width);
+    return label.advance;
+}
+
+// ========== 缓存 ==========
+
+GlyphCache::GlyphCache(const uint8_t* font) : _font(font) {
+    u8g2FontReadInfo(font, _info);
+    clear();
+    resetStats();
+}
+
+void GlyphCache::clear() {
+    memset(_hash, NONE, sizeof(_hash));
+    _head = NONE;
+    _tail = NONE;
+    _count = 0;
+}
+
+void GlyphCache::resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+static inline uint8_t hashIndex(uint16_t encoding) {
+    return (uint8_t)((encoding * 2654435761u) >> 16) & (GLYPH_CACHE_HASH_SIZE - 1);
+}
+
+int16_t GlyphCache::findHash(uint16_t encoding) const {
+    uint8_t i = hashIndex(encoding);
+    while (_hash[i] != NONE) {
+        if (_slots[_hash[i]].glyph.encoding == encoding) {
+            return i;
+        }
+        i = (i + 1) & (GLYPH_CACHE_HASH_SIZE - 1);
+    }
+    return -1;
+}
+
+void GlyphCache::insertHash(uint16_t encoding, uint8_t slot) {
+    uint8_t i = hashIndex(encoding);
+    while (_hash[i] != NONE) {
+        i = (i + 1) & (GLYPH_CACHE_HASH_SIZE - 1);
+    }
+    _hash[i] = slot;
+}
+
+void GlyphCache::removeHash(uint16_t encoding) {
+    int16_t found = findHash(encoding);
+    if (found < 0) {
+        return;
+    }
+    // 线性探测的删除：把后面同一探测链上的项前移，不留墓碑
+    uint8_t hole = (uint8_t)found;
+    uint8_t i = hole;
+    for (;;) {
+        i = (i + 1) & (GLYPH_CACHE_HASH_SIZE - 1);
+        if (_hash[i] == NONE) {
+            break;
+        }
+        uint8_t home = hashIndex(_slots[_hash[i]].glyph.encoding);
+        // home 不在 (hole, i] 之间时，这一项可以移到 hole
+        bool between = hole <= i ? (home > hole && home <= i) : (home > hole || home <= i);
+        if (!between) {
+            _hash[hole] = _hash[i];
+            hole = i;
+        }
+    }
+    _hash[hole] = NONE;
+}
+
+void GlyphCache::unlink(uint8_t slot) {
+    Slot& s = _slots[slot];
+    if (s.prev != NONE) _slots[s.prev].next = s.next; else _head = s.next;
+    if (s.next != NONE) _slots[s.next].prev = s.prev; else _tail = s.prev;
+}
+
+void GlyphCache::pushFront(uint8_t slot) {
+    Slot& s = _slots[slot];
+    s.prev = NONE;
+    s.next = _head;
+    if (_head != NONE) _slots[_head].prev = slot;
+    _head = slot;
+    if (_tail == NONE) _tail = slot;
+}
+
+uint8_t GlyphCache::allocate() {
+    if (_count < GLYPH_CACHE_SLOTS) {
+        return _count++;
+    }
+    uint8_t victim = _tail;
+    unlink(victim);
+    removeHash(_slots[victim].glyph.encoding);
+    _stats.evictions++;
+    return victim;
+}
+
+const CachedGlyph* GlyphCache::load(uint16_t encoding, bool& oversized) {
+    oversized = false;
+    _stats.misses++;
+    const uint8_t* data = u8g2FontFindGlyph(_font, _info, encoding);
+    if (data == nullptr) {
+        _stats.missing++;
+        return nullptr;
+    }
+
+    size_t size = u8g2FontDecodeGlyph(_info, data, encoding, _scratchGlyph, _scratch, sizeof(_scratch));
+    if (size == 0 && _scratchGlyph.rowBytes() * _scratchGlyph.height > 0) {
+        _stats.missing++;   // 超过临时缓冲，字体不适用
+        return nullptr;
+    }
+    if (_scratchGlyph.width > GLYPH_CACHE_MAX_WIDTH || _scratchGlyph.height > GLYPH_COLUMN_BITS) {
+        _stats.uncached++;
+        oversized = true;
+        return nullptr;
+    }
+
+    // 按行位图转成按列
+    uint8_t slot = allocate();
+    CachedGlyph& g = _slots[slot].glyph;
+    g.encoding = encoding;
+    g.width = _scratchGlyph.width;
+    g.height = _scratchGlyph.height;
+    g.xOffset = _scratchGlyph.xOffset;
+    g.yOffset = _scratchGlyph.yOffset;
+    g.advance = _scratchGlyph.advance;
+    memset(g.columns, 0, sizeof(g.columns));
+    uint8_t rowBytes = _scratchGlyph.rowBytes();
+    for (uint8_t r = 0; r < g.height; r++) {
+        const uint8_t* row = _scratch + r * rowBytes;
+        for (uint8_t c = 0; c < g.width; c++) {
+            if (row[c >> 3] & (0x80 >> (c & 7))) {
+                g.columns[c] |= (uint16_t)(1u << r);
+            }
+        }
+    }
+    insertHash(encoding, slot);
+    pushFront(slot);
+    return &g;
+}
+
+const CachedGlyph* GlyphCache::fetch(uint16_t encoding, bool& oversized) {
+    int16_t h = findHash(encoding);
+    if (h < 0) {
+        return load(encoding, oversized);
+    }
+    oversized = false;
+    uint8_t slot = _hash[h];
+    if (slot != _head) {
+        unlink(slot);
+        pushFront(slot);
+    }
+    _stats.hits++;
+    return &_slots[slot].glyph;
+}
+
+const CachedGlyph* GlyphCache::get(uint16_t encoding) {
+    bool oversized;
+    return fetch(encoding, oversized);
+}
+
+int16_t GlyphCache::drawUTF8(uint8_t* buffer, int16_t x, int16_t y, const char* str) {
+    int16_t start = x;
+    uint16_t e;
+    while ((e = utf8Next(str)) != 0) {
+        if (e == 0xFFFF) {
+            continue;
+        }
+        bool oversized;
+        const CachedGlyph* g = fetch(e, oversized);
+        if (g != nullptr) {
+            glyphBlitColumns(buffer, x + g->xOffset, y - g->height - g->yOffset, g->columns, g->width);
+            x += g->advance;
+        } else if (oversized) {
+            const GlyphBitmap& b = _scratchGlyph;
+            glyphBlitRows(buffer, x + b.xOffset, y - b.height - b.yOffset, b.bits, b.width, b.height);
+            x += b.advance;
+        }
+    }
+    return x - start;
+}
+
+int16_t GlyphCache::utf8Width(const char* str) {
+    int16_t w = 0;
+    uint16_t e;
+    while ((e = utf8Next(str)) != 0) {
+        if (e == 0xFFFF) {
+            continue;
+        }
+        bool oversized;
+        const CachedGlyph* g = fetch(e, oversized);
+        if (g != nullptr) {
+            w += g->advance;
+        } else if (oversized) {
+            w += _scratchGlyph.advance;
+        }
+    }
+    return w;
+}
+
+uint16_t GlyphCache::renderColumns(const char* str, int8_t baseline, uint16_t* columns, uint16_t capacity) {
+    memset(columns, 0, capacity * sizeof(uint16_t));
+    int16_t x = 0;
+    uint16_t e;
+    while ((e = utf8Next(str)) != 0) {
+        if (e == 0xFFFF) {
+            continue;
+        }
+        bool oversized;
+        const CachedGlyph* g = fetch(e, oversized);
+        if (g != nullptr) {
+            int16_t top = baseline - g->height - g->yOffset;
+            for (uint8_t c = 0; c < g->width; c++) {
+                int16_t px = x + g->xOffset + c;
+                if (px < 0 || px >= capacity) {
+                    continue;
+                }
+                uint32_t v = top >= 0 ? (uint32_t)g->columns[c] << top : (uint32_t)g->columns[c] >> -top;
+                columns[px] |= (uint16_t)v;
+            }
+            x += g->advance;
+        } else if (oversized) {
+            const GlyphBitmap& b = _scratchGlyph;
+            int16_t top = baseline - b.height - b.yOffset;
+            uint8_t rowBytes = b.rowBytes();
+            for (uint8_t r = 0; r < b.height; r++) {
+                int16_t py = top + r;
+                if (py < 0 || py >= GLYPH_COLUMN_BITS) {
+                    continue;
+                }
+                for (uint8_t c = 0; c < b.width; c++) {
+                    int16_t px = x + b.xOffset + c;
+                    if (px >= 0 && px < capacity && (b.bits[r * rowBytes + (c >> 3)] & (0x80 >> (c & 7)))) {
+                        columns[px] |= (uint16_t)(1u << py);
+                    }
+                }
+            }
+            x += b.advance;
+        }
+    }
+    if (x <= 0) {
+        return 0;
+    }
+    return x < capacity ? (uint16_t)x : capacity;
+}
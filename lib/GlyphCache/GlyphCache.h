@@ -0,0 +1,139 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "U8g2Font.h"
+
+/**
+ * GlyphCache - 中文字形缓存（最近使用的字保留解码后的位图）
+ *
+ * U8g2 的 drawUTF8 每一帧都要对每个字在大字库（wqy14 gb2312 约 7000 字）中逐个跳过查找、再做行程解码，
+ * 而界面上反复出现的只有几十个字。本缓存：
+ * - 固定大小的槽位区（GLYPH_CACHE_SLOTS 个 16×16 以内的字形），不分配堆内存、不产生碎片
+ * - 字形按列存放（每列一个 uint16_t，bit0 为最上一行），与 SSD1306 按页竖排的缓冲对应，
+ *   绘制时每列移位后"或"进最多 3 页，不再逐像素写
+ * - 编码 -> 槽位用开放寻址哈希表，满了按 LRU 淘汰最久未用的字
+ * - 超过 16×16 的字形不缓存，解码到临时缓冲后逐像素绘制
+ *
+ * 静态标签（"系统状态"、"音量"…）可以用 tools/make_glyph_labels.py 在构建时预先渲染成整串按列位图放进闪存，
+ * 见 GlyphLabel / glyphLabelDraw()。
+ *
+ * 绘制到 U8g2 全缓冲格式（见 TileFlusher.h），y 为基线，像素按"或"写入，
+ * 与 U8g2 setFontMode(1)（透明）、setDrawColor(1) 的结果相同。
+ */
+
+#define GLYPH_CACHE_SLOTS      64
+#define GLYPH_COLUMN_BITS      16     // 按列存放的最大高度
+#define GLYPH_CACHE_MAX_WIDTH  16
+#define GLYPH_CACHE_HASH_SIZE  (GLYPH_CACHE_SLOTS * 2)
+#define GLYPH_SCRATCH_BYTES    512    // 不缓存的大字形（最大 64×64）
+
+struct GlyphCacheStats {
+    uint32_t hits;
+    uint32_t misses;      // 需要查找 + 解码
+    uint32_t evictions;   // 淘汰的字形
+    uint32_t uncached;    // 超过 16×16、直接绘制的字形
+    uint32_t missing;     // 字体中没有的字
+};
+
+// 缓存中的字形（按列）
+struct CachedGlyph {
+    uint16_t encoding;
+    uint8_t width;
+    uint8_t height;
+    int8_t xOffset;
+    int8_t yOffset;
+    int8_t advance;
+    uint16_t columns[GLYPH_CACHE_MAX_WIDTH];   // bit0 为最上一行
+};
+
+// 构建时预渲染的整串标签（tools/make_glyph_labels.py 生成），高度不超过 16
+struct GlyphLabel {
+    const char* text;
+    int16_t advance;          // 整串步进宽度（与 drawUTF8 返回值相同）
+    int8_t left;              // 位图左边相对绘制位置的偏移
+    int8_t top;               // 位图顶边相对基线的偏移（向上为正）
+    uint8_t width;
+    const uint16_t* columns;  // width 列，bit0 为最上一行
+};
+
+// 把按列位图"或"到显示缓冲，左上角为 (x, y)，超出屏幕的部分裁掉
+void glyphBlitColumns(uint8_t* buffer, int16_t x, int16_t y, const uint16_t* columns, uint8_t width);
+
+// 把按行 1bpp 位图（bit7 为最左像素）"或"到显示缓冲（不缓存的大字形）
+void glyphBlitRows(uint8_t* buffer, int16_t x, int16_t y, const uint8_t* bits, uint8_t width, uint8_t height);
+
+// 在表中查找与 text 完全相同的标签
+const GlyphLabel* glyphLabelFind(const GlyphLabel* labels, size_t count, const char* text);
+
+// 绘制预渲染标签，y 为基线，返回步进宽度（结果与 GlyphCache::drawUTF8 相同）
+int16_t glyphLabelDraw(uint8_t* buffer, int16_t x, int16_t y, const GlyphLabel& label);
+
+class GlyphCache {
+public:
+    explicit GlyphCache(const uint8_t* font);
+
+    /**
+     * 取字形（缓存命中直接返回，否则查找 + 解码并放入缓存）
+     * @return 字体中没有该字或字形超过 16×16 时返回 nullptr；指针在下一次 get()/drawUTF8() 之前有效
+     */
+    const CachedGlyph* get(uint16_t encoding);
+
+    // 绘制字符串（y 为基线），返回步进宽度
+    int16_t drawUTF8(uint8_t* buffer, int16_t x, int16_t y, const char* str);
+
+    // 字符串步进宽度（各字步进之和）
+    int16_t utf8Width(const char* str);
+
+    /**
+     * 把字符串渲染成 16 像素高的按列位图（bit0 为最上一行），用于横向滚动等需要整串列数据的场合
+     * @param baseline 基线在 16 行中的位置，超出 16 行的像素裁掉
+     * @return 写入的列数：字符串步进宽度，超过 capacity 时为 capacity（多出的列不写入，
+     *         返回值可以直接作为字幕条长度；完整宽度用 utf8Width()）
+     */
+    uint16_t renderColumns(const char* str, int8_t baseline, uint16_t* columns, uint16_t capacity);
+
+    void clear();
+
+    const U8g2FontInfo& info() const { return _info; }
+    const GlyphCacheStats& stats() const { return _stats; }
+    void resetStats();
+    uint8_t size() const { return _count; }
+
+private:
+    static const uint8_t NONE = 0xFF;
+
+    struct Slot {
+        CachedGlyph glyph;
+        uint8_t prev;   // LRU 链表（prev 更新）
+        uint8_t next;
+    };
+
+    // 命中直接返回；未命中时 load()
+    const CachedGlyph* fetch(uint16_t encoding, bool& oversized);
+    // 查找 + 解码，能缓存则放入缓存；超大字形留在 _scratchGlyph（oversized = true）
+    const CachedGlyph* load(uint16_t encoding, bool& oversized);
+    int16_t findHash(uint16_t encoding) const;
+    void insertHash(uint16_t encoding, uint8_t slot);
+    void removeHash(uint16_t encoding);
+    void unlink(uint8_t slot);
+    void pushFront(uint8_t slot);
+    uint8_t allocate();
+
+    const uint8_t* _font;
+    U8g2FontInfo _info;
+
+    Slot _slots[GLYPH_CACHE_SLOTS];
+    uint8_t _hash[GLYPH_CACHE_HASH_SIZE];   // 槽位号，NONE 为空
+    uint8_t _head;                          // 最近使用
+    uint8_t _tail;                          // 最久未用
+    uint8_t _count;
+
+    GlyphBitmap _scratchGlyph;
+    uint8_t _scratch[GLYPH_SCRATCH_BYTES];
+
+    GlyphCacheStats _stats;
+};
+
+#endif // GLYPH_CACHE_H
@@ -0,0 +1,276 @@
+#include "U8g2Font.h"
+#include <string.h>
+#include "TileFlusher.h"
+
+// ========== 字体头 ==========
+
+static uint16_t readWord(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);   // 大端
+}
+
+void u8g2FontReadInfo(const uint8_t* font, U8g2FontInfo& info) {
+    info.glyphCount = font[0];
+    info.bbxMode = font[1];
+    info.bitsPer0 = font[2];
+    info.bitsPer1 = font[3];
+    info.bitsPerCharWidth = font[4];
+    info.bitsPerCharHeight = font[5];
+    info.bitsPerCharX = font[6];
+    info.bitsPerCharY = font[7];
+    info.bitsPerDeltaX = font[8];
+    info.maxCharWidth = (int8_t)font[9];
+    info.maxCharHeight = (int8_t)font[10];
+    info.xOffset = (int8_t)font[11];
+    info.yOffset = (int8_t)font[12];
+    info.ascentA = (int8_t)font[13];
+    info.descentG = (int8_t)font[14];
+    info.ascentPara = (int8_t)font[15];
+    info.descentPara = (int8_t)font[16];
+    info.startPosUpperA = readWord(font + 17);
+    info.startPosLowerA = readWord(font + 19);
+    info.startPosUnicode = readWord(font + 21);
+}
+
+// ========== 查找 ==========
+
+const uint8_t* u8g2FontFindGlyph(const uint8_t* font, const U8g2FontInfo& info, uint16_t encoding) {
+    font += U8G2_FONT_HEADER_SIZE;
+
+    if (encoding <= 255) {
+        if (encoding >= 'a') {
+            font += info.startPosLowerA;
+        } else if (encoding >= 'A') {
+            font += info.startPosUpperA;
+        }
+        // 每个字形：[编码][到下一个字形的字节数]...，字节数为0表示结束
+        while (font[1] != 0) {
+            if (font[0] == encoding) {
+                return font + 2;
+            }
+            font += font[1];
+        }
+        return nullptr;
+    }
+
+    // Unicode 跳转表：[到块起始的偏移][块内最后一个编码]，按块累加偏移
+    font += info.startPosUnicode;
+    const uint8_t* table = font;
+    uint16_t last;
+    do {
+        font += readWord(table);
+        last = readWord(table + 2);
+        table += 4;
+    } while (last < encoding);
+
+    // 块内：[编码高][编码低][到下一个字形的字节数]...，编码为0表示结束
+    for (;;) {
+        uint16_t e = readWord(font);
+        if (e == 0) {
+            return nullptr;
+        }
+        if (e == encoding) {
+            return font + 3;
+        }
+        font += font[2];
+    }
+}
+
+// ========== 解码 ==========
+
+namespace {
+
+// 与 u8g2_font_decode_get_unsigned_bits 相同：低位在前，cnt <= 8
+struct BitReader {
+    const uint8_t* ptr;
+    uint8_t bitPos;
+
+    uint8_t get(uint8_t cnt) {
+        uint16_t val = (uint16_t)(ptr[0] >> bitPos);
+        uint8_t end = bitPos + cnt;
+        if (end >= 8) {
+            ptr++;
+            val |= (uint16_t)(ptr[0] << (8 - bitPos));
+            end -= 8;
+        }
+        bitPos = end;
+        return (uint8_t)(val & ((1u << cnt) - 1));
+    }
+
+    int8_t getSigned(uint8_t cnt) {
+        return (int8_t)((int16_t)get(cnt) - (int16_t)(1 << (cnt - 1)));
+    }
+};
+
+struct GlyphHeader {
+    uint8_t width;
+    uint8_t height;
+    int8_t x;
+    int8_t y;
+    int8_t dx;
+};
+
+GlyphHeader readHeader(const U8g2FontInfo& info, BitReader& r) {
+    GlyphHeader h;
+    h.width = r.get(info.bitsPerCharWidth);
+    h.height = r.get(info.bitsPerCharHeight);
+    h.x = r.getSigned(info.bitsPerCharX);
+    h.y = r.getSigned(info.bitsPerCharY);
+    h.dx = r.getSigned(info.bitsPerDeltaX);
+    return h;
+}
+
+/**
+ * 行程解码：每段 run(长度, 颜色) 按行从左到右、自动换行
+ * Sink 需要提供 void pixels(uint8_t x, uint8_t y, uint8_t len)（只对1像素调用）
+ */
+template <typename Sink>
+void decodeRuns(const U8g2FontInfo& info, BitReader& r, const GlyphHeader& h, Sink& sink) {
+    if (h.width == 0) {
+        return;
+    }
+    uint8_t x = 0;
+    uint8_t y = 0;
+
+    auto run = [&](uint8_t len, bool on) {
+        while (len > 0 && y < h.height) {
+            uint8_t n = h.width - x;
+            if (n > len) n = len;
+            if (on) sink.pixels(x, y, n);
+            len -= n;
+            x += n;
+            if (x >= h.width) {
+                x = 0;
+                y++;
+            }
+        }
+    };
+
+    for (;;) {
+        uint8_t a = r.get(info.bitsPer0);
+        uint8_t b = r.get(info.bitsPer1);
+        do {
+            run(a, false);
+            run(b, true);
+        } while (r.get(1) != 0);
+        if (y >= h.height) {
+            break;
+        }
+    }
+}
+
+struct BitmapSink {
+    uint8_t* bits;
+    uint8_t rowBytes;
+
+    void pixels(uint8_t x, uint8_t y, uint8_t len) {
+        uint8_t* row = bits + y * rowBytes;
+        for (uint8_t i = 0; i < len; i++, x++) {
+            row[x >> 3] |= (uint8_t)(0x80 >> (x & 7));
+        }
+    }
+};
+
+// 直接写入 U8g2 全缓冲（与 U8g2 逐段画水平线相同的工作量）
+struct PageSink {
+    uint8_t* buffer;
+    int16_t left;
+    int16_t top;
+
+    void pixels(uint8_t x, uint8_t y, uint8_t len) {
+        int16_t py = top + y;
+        if (py < 0 || py >= DISPLAY_HEIGHT) {
+            return;
+        }
+        uint8_t* page = buffer + (py >> 3) * DISPLAY_WIDTH;
+        uint8_t mask = (uint8_t)(1 << (py & 7));
+        for (int16_t px = left + x; px < left + x + len; px++) {
+            if (px >= 0 && px < DISPLAY_WIDTH) {
+                page[px] |= mask;
+            }
+        }
+    }
+};
+
+}  // namespace
+
+size_t u8g2FontDecodeGlyph(const U8g2FontInfo& info, const uint8_t* glyphData, uint16_t encoding,
+                           GlyphBitmap& out, uint8_t* bits, size_t capacity) {
+    BitReader r = {glyphData, 0};
+    GlyphHeader h = readHeader(info, r);
+
+    out.encoding = encoding;
+    out.width = h.width;
+    out.height = h.height;
+    out.xOffset = h.x;
+    out.yOffset = h.y;
+    out.advance = h.dx;
+    out.bits = bits;
+
+    size_t size = (size_t)out.rowBytes() * h.height;
+    if (size > capacity) {
+        return 0;
+    }
+    memset(bits, 0, size);
+    BitmapSink sink = {bits, out.rowBytes()};
+    decodeRuns(info, r, h, sink);
+    return size;
+}
+
+// ========== UTF-8 ==========
+
+uint16_t utf8Next(const char*& s) {
+    uint8_t c = (uint8_t)*s;
+    if (c == 0) {
+        return 0;
+    }
+    s++;
+    if (c < 0x80) {
+        return c;
+    }
+
+    uint8_t extra;
+    uint16_t code;
+    if ((c & 0xE0) == 0xC0) {
+        extra = 1;
+        code = c & 0x1F;
+    } else if ((c & 0xF0) == 0xE0) {
+        extra = 2;
+        code = c & 0x0F;
+    } else {
+        return 0xFFFF;
+    }
+    for (uint8_t i = 0; i < extra; i++) {
+        uint8_t cc = (uint8_t)*s;
+        if ((cc & 0xC0) != 0x80) {
+            return 0xFFFF;
+        }
+        code = (uint16_t)((code << 6) | (cc & 0x3F));
+        s++;
+    }
+    return code;
+}
+
+// ========== 不缓存绘制 ==========
+
+int16_t u8g2FontDrawUTF8(uint8_t* buffer, const uint8_t* font, int16_t x, int16_t y, const char* str) {
+    U8g2FontInfo info;
+    u8g2FontReadInfo(font, info);
+
+    int16_t start = x;
+    uint16_t e;
+    while ((e = utf8Next(str)) != 0) {
+        if (e == 0xFFFF) {
+            continue;
+        }
+        const uint8_t* data = u8g2FontFindGlyph(font, info, e);
+        if (data == nullptr) {
+            continue;
+        }
+        BitReader r = {data, 0};
+        GlyphHeader h = readHeader(info, r);
+        PageSink sink = {buffer, (int16_t)(x + h.x), (int16_t)(y - h.height - h.y)};
+        decodeRuns(info, r, h, sink);
+        x += h.dx;
+    }
+    return x - start;
+}
@@ -0,0 +1,87 @@
+#ifndef U8G2_FONT_H
+#define U8G2_FONT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * U8g2Font - 直接读取 U8g2 字体数据（如 u8g2_font_wqy14_t_gb2312）
+ *
+ * 与 U8g2 自身的 drawUTF8 使用同一格式和同一查找/解码过程（见 U8g2 csrc/u8g2_font.c）：
+ * - 23 字节字体头：各字段的位宽、'A'/'a'/Unicode 段起始偏移
+ * - 查找：编码 <= 255 时在 ASCII 段逐个跳过；否则先查 Unicode 跳转表定位块，再在块内逐个跳过
+ * - 解码：位流（低位在前）依次为 宽/高（无符号）、x/y 偏移和步进（有符号），
+ *   之后是 (0 的个数, 1 的个数, 重复位) 行程编码，按行从左到右填满 宽×高
+ *
+ * 解码结果为按行排列的 1bpp 位图（每行 (宽+7)/8 字节，bit7 为最左像素），供 GlyphCache 缓存。
+ * 本模块不依赖 U8g2 库，主机端可以直接测试。
+ */
+
+#define U8G2_FONT_HEADER_SIZE 23
+
+// 字体头（字段名与 U8g2 的 u8g2_font_info_t 对应）
+struct U8g2FontInfo {
+    uint8_t glyphCount;
+    uint8_t bbxMode;
+    uint8_t bitsPer0;
+    uint8_t bitsPer1;
+    uint8_t bitsPerCharWidth;
+    uint8_t bitsPerCharHeight;
+    uint8_t bitsPerCharX;
+    uint8_t bitsPerCharY;
+    uint8_t bitsPerDeltaX;
+    int8_t maxCharWidth;
+    int8_t maxCharHeight;
+    int8_t xOffset;
+    int8_t yOffset;
+    int8_t ascentA;
+    int8_t descentG;
+    int8_t ascentPara;
+    int8_t descentPara;
+    uint16_t startPosUpperA;
+    uint16_t startPosLowerA;
+    uint16_t startPosUnicode;
+};
+
+// 解码后的字形
+struct GlyphBitmap {
+    uint16_t encoding;
+    uint8_t width;
+    uint8_t height;
+    int8_t xOffset;      // 相对绘制位置的左边距
+    int8_t yOffset;      // 字形底边相对基线的偏移（向上为正）
+    int8_t advance;      // 步进（下一个字的 x 增量）
+    const uint8_t* bits; // 按行 1bpp，每行 rowBytes() 字节
+    uint8_t rowBytes() const { return (uint8_t)((width + 7) / 8); }
+};
+
+void u8g2FontReadInfo(const uint8_t* font, U8g2FontInfo& info);
+
+/**
+ * 查找字形数据（与 u8g2_font_get_glyph_data 相同）
+ * @return 指向该字形位流的指针，字体中没有该字时返回 nullptr
+ */
+const uint8_t* u8g2FontFindGlyph(const uint8_t* font, const U8g2FontInfo& info, uint16_t encoding);
+
+/**
+ * 把字形位流解码为 1bpp 位图
+ * @param bits 输出缓冲（按行），至少 rowBytes × 高 字节
+ * @return 输出字节数；缓冲不够时返回 0（out 中的尺寸仍然有效）
+ */
+size_t u8g2FontDecodeGlyph(const U8g2FontInfo& info, const uint8_t* glyphData, uint16_t encoding,
+                           GlyphBitmap& out, uint8_t* bits, size_t capacity);
+
+/**
+ * 取下一个 UTF-8 字符（U8g2 只支持 BMP，最多 3 字节）
+ * @return 编码，字符串结束返回 0，非法字节返回 0xFFFF 并跳过一个字节
+ */
+uint16_t utf8Next(const char*& s);
+
+/**
+ * 不缓存直接绘制（每个字都查找 + 解码，等同于 U8g2 drawUTF8 的工作量），用作对照
+ * 缓冲为 U8g2 全缓冲格式（见 TileFlusher.h），y 为基线，像素按"或"写入（透明字体模式）
+ * @return 字符串步进宽度
+ */
+int16_t u8g2FontDrawUTF8(uint8_t* buffer, const uint8_t* font, int16_t x, int16_t y, const char* str);
+
+#endif // U8G2_FONT_H
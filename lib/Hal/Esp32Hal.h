@@ -0,0 +1,61 @@
+#ifndef ESP32_HAL_H
+#define ESP32_HAL_H
+
+#include "Hal.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <ESP32Servo.h>
+
+/**
+ * Esp32Hal - 硬件抽象层的 ESP32 后端（时钟、舵机、串口）
+ *
+ * 采集、LED、显示的设备端后端在各自的库中：I2sAudioSource（AudioSource.h）、
+ * RmtLedTransport（AsyncLedStrip.h）、U8g2TileTransport（TileFlusher.h）。
+ */
+
+class Esp32Clock : public HalClock {
+public:
+    uint32_t nowUs() override { return micros(); }
+    uint32_t nowMs() override { return millis(); }
+
+    // 1ms 以上交给 FreeRTOS（让出处理器），不足 1ms 忙等
+    void sleepUs(uint32_t us) override {
+        if (us >= 1000) {
+            vTaskDelay(pdMS_TO_TICKS(us / 1000));
+        } else if (us > 0) {
+            delayMicroseconds(us);
+        }
+    }
+};
+
+// ESP32Servo（LEDC 定时器）输出 50Hz 脉冲
+class Esp32ServoOutput : public HalServo {
+public:
+    void writeMicroseconds(uint16_t us) override { _servo.writeMicroseconds(us); }
+
+protected:
+    bool attachPin(uint8_t pin, uint16_t minUs, uint16_t maxUs) override {
+        _servo.setPeriodHertz(HAL_SERVO_PERIOD_HZ);
+        return _servo.attach(pin, minUs, maxUs) != 0;
+    }
+
+private:
+    Servo _servo;
+};
+
+// 包装 Serial（HardwareSerial 或 USB CDC，都是 Stream）
+class Esp32Serial : public HalSerial {
+public:
+    explicit Esp32Serial(Stream& stream) : _stream(stream) {}
+
+    size_t write(const uint8_t* data, size_t length) override { return _stream.write(data, length); }
+    int available() override { return _stream.available(); }
+    int read() override { return _stream.read(); }
+
+private:
+    Stream& _stream;
+};
+#endif
+
+#endif // ESP32_HAL_H
@@ -0,0 +1,39 @@
+#ifndef HAL_H
+#define HAL_H
+
+#include "HalClock.h"
+#include "HalServo.h"
+#include "HalSerial.h"
+#include "AudioSource.h"
+#include "LedStrip.h"
+#include "TileFlusher.h"
+
+/**
+ * Hal - 硬件抽象层（一组接口的引用）
+ *
+ * 逻辑代码只通过这些接口访问硬件，同一份代码可以在设备上运行，也可以在主机（native 环境）上
+ * 按文件和 mock 全速运行：
+ *
+ * | 接口 | 设备端（Esp32Hal.h 等） | 主机端（lib/HostHal 等） |
+ * |------|-------------------------|--------------------------|
+ * | HalClock | Esp32Clock | SteadyClock、VirtualClock |
+ * | HalServo（PWM） | Esp32ServoOutput | RecordingServo（可写 CSV） |
+ * | AudioSource（I2S 采集） | I2sAudioSource | WavAudioSource（lib/AudioSim） |
+ * | LedStrip | AsyncLedStrip + RmtLedTransport | AsyncLedStrip + RecordingLedTransport |
+ * | DisplayTileTransport | U8g2TileTransport | RecordingTileTransport |
+ * | HalSerial | Esp32Serial | FileSerial |
+ *
+ * 各接口由对应模块定义（采集、LED、显示的接口早已在各自的库中），本头文件只把它们收在一起；
+ * Hal 只保存引用，后端对象由调用方持有（设备端为全局对象，主机端为 HostHal）。
+ */
+struct Hal {
+    HalClock& clock;
+    HalServo& servoH;
+    HalServo& servoV;
+    AudioSource& microphone;
+    LedStrip& leds;
+    DisplayTileTransport& display;
+    HalSerial& serial;
+};
+
+#endif // HAL_H
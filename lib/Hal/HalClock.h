@@ -0,0 +1,23 @@
+#ifndef HAL_CLOCK_H
+#define HAL_CLOCK_H
+
+#include <stdint.h>
+#include "TaskScheduler.h"
+
+/**
+ * HalClock - 时钟接口（代替 micros() / millis() / delay()）
+ *
+ * 继承 SchedulerClock，可以直接交给 TaskScheduler。
+ * 设备端 Esp32Clock（lib/Hal/Esp32Hal.h）；主机端 SteadyClock（真实时间，lib/HostHal）
+ * 或 VirtualClock（lib/TaskScheduler/VirtualClock.h，sleepUs() 只让时间前进，不真的等待）。
+ * 时间为 32 位，按有符号差比较（与 micros() / millis() 相同，回绕后仍然正确）。
+ */
+class HalClock : public SchedulerClock {
+public:
+    virtual uint32_t nowMs() = 0;
+
+    // 让出处理器至少 us 微秒（设备端为 FreeRTOS 延时，主机端虚拟时钟只前进时间）
+    virtual void sleepUs(uint32_t us) = 0;
+};
+
+#endif // HAL_CLOCK_H
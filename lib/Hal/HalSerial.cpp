@@ -0,0 +1,26 @@
+#include "HalSerial.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+size_t HalSerial::print(const char* text) {
+    return write((const uint8_t*)text, strlen(text));
+}
+
+size_t HalSerial::println(const char* text) {
+    size_t n = print(text);
+    return n + write((const uint8_t*)"\r\n", 2);
+}
+
+size_t HalSerial::printf(const char* format, ...) {
+    char buffer[HAL_SERIAL_PRINTF_MAX];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (n <= 0) {
+        return 0;
+    }
+    size_t length = (size_t)n < sizeof(buffer) ? (size_t)n : sizeof(buffer) - 1;
+    return write((const uint8_t*)buffer, length);
+}
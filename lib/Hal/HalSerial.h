@@ -0,0 +1,32 @@
+#ifndef HAL_SERIAL_H
+#define HAL_SERIAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * HalSerial - 串口接口（命令输入、文本和二进制输出）
+ *
+ * 后端只实现字节读写；print() / println() / printf() 在这里格式化后调用 write()。
+ * 设备端 Esp32Serial（lib/Hal/Esp32Hal.h，包装 Serial）；主机端 FileSerial（lib/HostHal，
+ * 输出写入文件或标准输出，输入来自脚本字符串或文件）。
+ */
+
+#define HAL_SERIAL_PRINTF_MAX 256   // printf() 一次最多输出的字节数（超出截断）
+
+class HalSerial {
+public:
+    virtual ~HalSerial() {}
+
+    virtual size_t write(const uint8_t* data, size_t length) = 0;
+    // 可读的字节数
+    virtual int available() = 0;
+    // 读一个字节，没有数据时返回 -1
+    virtual int read() = 0;
+
+    size_t print(const char* text);
+    size_t println(const char* text = "");
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+#endif // HAL_SERIAL_H
@@ -0,0 +1,55 @@
+#ifndef HAL_SERVO_H
+#define HAL_SERVO_H
+
+#include <stdint.h>
+
+/**
+ * HalServo - 舵机（50Hz PWM）输出接口
+ *
+ * 后端只实现按脉宽输出；角度到脉宽的换算在这里完成，各后端的脉宽完全相同：
+ * 与 ESP32Servo 的 write(angle) 一致，角度限制在 0~180°，线性映射到 attach() 给出的脉宽范围。
+ * 设备端 Esp32ServoOutput（lib/Hal/Esp32Hal.h，ESP32Servo / LEDC）；主机端 RecordingServo（lib/HostHal）。
+ */
+
+#define HAL_SERVO_MIN_US      500
+#define HAL_SERVO_MAX_US      2500
+#define HAL_SERVO_PERIOD_HZ   50
+
+class HalServo {
+public:
+    HalServo() : _minUs(HAL_SERVO_MIN_US), _maxUs(HAL_SERVO_MAX_US), _angle(90) {}
+    virtual ~HalServo() {}
+
+    // 开始在 pin 上输出；minUs/maxUs 为 0° 和 180° 的脉宽
+    bool attach(uint8_t pin, uint16_t minUs = HAL_SERVO_MIN_US, uint16_t maxUs = HAL_SERVO_MAX_US) {
+        if (minUs >= maxUs) {
+            return false;
+        }
+        _minUs = minUs;
+        _maxUs = maxUs;
+        return attachPin(pin, minUs, maxUs);
+    }
+
+    void write(int angle) {
+        _angle = angle < 0 ? 0 : (angle > 180 ? 180 : angle);
+        writeMicroseconds(pulseForAngle(_angle, _minUs, _maxUs));
+    }
+
+    // 最近一次 write() 的角度（限制后）
+    int read() const { return _angle; }
+
+    virtual void writeMicroseconds(uint16_t us) = 0;
+
+    static uint16_t pulseForAngle(int angle, uint16_t minUs, uint16_t maxUs) {
+        return (uint16_t)(minUs + (int32_t)(maxUs - minUs) * angle / 180);
+    }
+
+protected:
+    virtual bool attachPin(uint8_t pin, uint16_t minUs, uint16_t maxUs) = 0;
+
+    uint16_t _minUs;
+    uint16_t _maxUs;
+    int _angle;
+};
+
+#endif // HAL_SERVO_H
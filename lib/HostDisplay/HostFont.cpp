@@ -0,0 +1,265 @@
+#include "HostFont.h"
+#include "U8g2Font.h"
+
+// 各字段的位宽（与 u8g2 fontconv 对常见小字体的输出相近，足够表示 32×32 以内的字形）
+#define HF_BITS_0    4
+#define HF_BITS_1    4
+#define HF_BITS_W    5
+#define HF_BITS_H    5
+#define HF_BITS_X    4
+#define HF_BITS_Y    4
+#define HF_BITS_DX   6
+#define HF_BLOCK     100   // Unicode 段每块字数
+
+// ========== 编码 ==========
+
+namespace {
+
+struct BitWriter {
+    std::vector<uint8_t> bytes;
+    uint8_t bit = 0;
+
+    // 低位在前，与 U8g2 解码器的读取顺序一致
+    void put(uint32_t v, uint8_t count) {
+        for (uint8_t i = 0; i < count; i++) {
+            if (bit == 0) {
+                bytes.push_back(0);
+            }
+            if (v & (1u << i)) {
+                bytes.back() |= (uint8_t)(1 << bit);
+            }
+            bit = (uint8_t)((bit + 1) & 7);
+        }
+    }
+
+    void putSigned(int v, uint8_t count) {
+        put((uint32_t)(v + (1 << (count - 1))), count);
+    }
+};
+
+std::vector<uint8_t> encodeGlyph(const HostGlyph& g) {
+    BitWriter w;
+    w.put(g.width, HF_BITS_W);
+    w.put(g.height, HF_BITS_H);
+    w.putSigned(g.xOffset, HF_BITS_X);
+    w.putSigned(g.yOffset, HF_BITS_Y);
+    w.putSigned(g.advance, HF_BITS_DX);
+
+    // (0 的个数, 1 的个数, 重复位) 行程，重复位始终为 0
+    const uint32_t max0 = (1u << HF_BITS_0) - 1, max1 = (1u << HF_BITS_1) - 1;
+    const size_t n = (size_t)g.width * g.height;
+    size_t i = 0;
+    while (i < n) {
+        uint32_t zeros = 0, ones = 0;
+        while (i < n && !g.pixels[i] && zeros < max0) {
+            zeros++;
+            i++;
+        }
+        if (zeros == max0 && i < n && !g.pixels[i]) {
+            w.put(zeros, HF_BITS_0);
+            w.put(0, HF_BITS_1);
+            w.put(0, 1);
+            continue;
+        }
+        while (i < n && g.pixels[i] && ones < max1) {
+            ones++;
+            i++;
+        }
+        w.put(zeros, HF_BITS_0);
+        w.put(ones, HF_BITS_1);
+        w.put(0, 1);
+    }
+    // 解码器可能预读下一个字节
+    w.bytes.push_back(0);
+    return w.bytes;
+}
+
+void putWord(std::vector<uint8_t>& v, size_t pos, uint16_t word) {
+    v[pos] = (uint8_t)(word >> 8);
+    v[pos + 1] = (uint8_t)word;
+}
+
+// 由编码确定的伪随机序列（同一个字每次生成相同的字形）
+struct GlyphRandom {
+    uint32_t state;
+
+    explicit GlyphRandom(uint16_t encoding) : state(encoding * 2654435761u + 12345u) {}
+
+    int next(int min, int max) {
+        state = state * 1103515245u + 12345u;
+        return min + (int)((state >> 16) % (uint32_t)(max - min + 1));
+    }
+};
+
+HostGlyph cjkGlyph(uint16_t e) {
+    HostGlyph g = {e, 14, 14, 0, -2, 14, std::vector<uint8_t>(14 * 14, 0)};
+    GlyphRandom r(e);
+    int strokes = r.next(6, 11);
+    for (int s = 0; s < strokes; s++) {
+        int len = r.next(4, 13);
+        int a = r.next(0, 13), b = r.next(0, 14 - len);
+        for (int k = 0; k < len; k++) {
+            if (s & 1) {
+                g.pixels[(b + k) * 14 + a] = 1;   // 竖
+            } else {
+                g.pixels[a * 14 + b + k] = 1;     // 横
+            }
+        }
+    }
+    return g;
+}
+
+// 小字形：外框 + 由编码决定的内部点阵，不同字符一眼可以区分
+HostGlyph boxGlyph(uint16_t e, uint8_t w, uint8_t h, int8_t y, int8_t dx) {
+    HostGlyph g = {e, w, h, 0, y, dx, std::vector<uint8_t>(w * h, 0)};
+    GlyphRandom r(e);
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            bool edge = row == 0 || row == h - 1 || col == 0 || col == w - 1;
+            g.pixels[row * w + col] = edge ? (uint8_t)((row + col) % 2 == 0) : (uint8_t)(r.next(0, 2) == 0);
+        }
+    }
+    return g;
+}
+
+}  // namespace
+
+std::vector<uint8_t> hostFontBuild(const std::vector<HostGlyph>& glyphs, int8_t ascent, int8_t descent) {
+    std::vector<uint8_t> f(U8G2_FONT_HEADER_SIZE, 0);
+    int8_t maxW = 0, maxH = 0;
+    for (const HostGlyph& g : glyphs) {
+        maxW = g.width > maxW ? (int8_t)g.width : maxW;
+        maxH = g.height > maxH ? (int8_t)g.height : maxH;
+    }
+    f[0] = (uint8_t)glyphs.size();
+    f[2] = HF_BITS_0;
+    f[3] = HF_BITS_1;
+    f[4] = HF_BITS_W;
+    f[5] = HF_BITS_H;
+    f[6] = HF_BITS_X;
+    f[7] = HF_BITS_Y;
+    f[8] = HF_BITS_DX;
+    f[9] = (uint8_t)maxW;
+    f[10] = (uint8_t)maxH;
+    f[13] = (uint8_t)ascent;
+    f[14] = (uint8_t)descent;
+    f[15] = (uint8_t)ascent;
+    f[16] = (uint8_t)descent;
+
+    // ASCII 段：编码 + 长度 + 字形，结尾为 0 长度
+    uint16_t upperA = 0, lowerA = 0;
+    bool haveUpper = false, haveLower = false;
+    for (const HostGlyph& g : glyphs) {
+        if (g.encoding > 255) {
+            break;
+        }
+        uint16_t offset = (uint16_t)(f.size() - U8G2_FONT_HEADER_SIZE);
+        if (!haveUpper && g.encoding >= 'A') {
+            upperA = offset;
+            haveUpper = true;
+        }
+        if (!haveLower && g.encoding >= 'a') {
+            lowerA = offset;
+            haveLower = true;
+        }
+        std::vector<uint8_t> data = encodeGlyph(g);
+        f.push_back((uint8_t)g.encoding);
+        f.push_back((uint8_t)(data.size() + 2));
+        f.insert(f.end(), data.begin(), data.end());
+    }
+    uint16_t end = (uint16_t)(f.size() - U8G2_FONT_HEADER_SIZE);
+    if (!haveUpper) {
+        upperA = end;
+    }
+    if (!haveLower) {
+        lowerA = end;
+    }
+    f.push_back(0);
+    f.push_back(0);
+    uint16_t unicodeStart = (uint16_t)(f.size() - U8G2_FONT_HEADER_SIZE);
+
+    // Unicode 段：先生成各块，再写跳转表（每项：到本块的偏移、本块最后一个编码）
+    std::vector<std::vector<uint8_t>> blocks;
+    std::vector<uint16_t> lastInBlock;
+    std::vector<uint8_t> cur;
+    int inBlock = 0;
+    uint16_t last = 0;
+    for (const HostGlyph& g : glyphs) {
+        if (g.encoding <= 255) {
+            continue;
+        }
+        std::vector<uint8_t> data = encodeGlyph(g);
+        cur.push_back((uint8_t)(g.encoding >> 8));
+        cur.push_back((uint8_t)g.encoding);
+        cur.push_back((uint8_t)(data.size() + 3));
+        cur.insert(cur.end(), data.begin(), data.end());
+        last = g.encoding;
+        if (++inBlock == HF_BLOCK) {
+            blocks.push_back(cur);
+            lastInBlock.push_back(last);
+            cur.clear();
+            inBlock = 0;
+        }
+    }
+    if (!cur.empty()) {
+        blocks.push_back(cur);
+        lastInBlock.push_back(last);
+    }
+    if (blocks.empty()) {
+        blocks.push_back(std::vector<uint8_t>());
+        lastInBlock.push_back(0xFFFF);
+    }
+    lastInBlock.back() = 0xFFFF;
+
+    size_t tableStart = f.size();
+    f.resize(tableStart + blocks.size() * 4, 0);
+    for (size_t b = 0; b < blocks.size(); b++) {
+        uint16_t offset = (uint16_t)(b == 0 ? blocks.size() * 4 : blocks[b - 1].size());
+        putWord(f, tableStart + b * 4, offset);
+        putWord(f, tableStart + b * 4 + 2, lastInBlock[b]);
+    }
+    for (const std::vector<uint8_t>& blk : blocks) {
+        f.insert(f.end(), blk.begin(), blk.end());
+    }
+    f.push_back(0);
+    f.push_back(0);
+
+    putWord(f, 17, upperA);
+    putWord(f, 19, lowerA);
+    putWord(f, 21, unicodeStart);
+    return f;
+}
+
+// ========== 合成字体 ==========
+
+const uint8_t* hostFontCjk14() {
+    static std::vector<uint8_t> font;
+    if (font.empty()) {
+        std::vector<HostGlyph> glyphs;
+        glyphs.push_back(HostGlyph{' ', 0, 0, 0, 0, 7, {}});
+        for (uint16_t e = '!'; e <= '~'; e++) {
+            bool descender = (e == 'g' || e == 'j' || e == 'p' || e == 'q' || e == 'y');
+            glyphs.push_back(boxGlyph(e, 6, 10, (int8_t)(descender ? -3 : 0), 7));
+        }
+        glyphs.push_back(boxGlyph(0xB0, 4, 4, 6, 5));   // °
+        for (uint32_t e = 0x4E00; e <= 0x9FA5; e++) {
+            glyphs.push_back(cjkGlyph((uint16_t)e));
+        }
+        font = hostFontBuild(glyphs, 10, -3);
+    }
+    return font.data();
+}
+
+const uint8_t* hostFontDigits16() {
+    static std::vector<uint8_t> font;
+    if (font.empty()) {
+        std::vector<HostGlyph> glyphs;
+        glyphs.push_back(HostGlyph{' ', 0, 0, 0, 0, 11, {}});
+        const char* chars = "%-.0123456789:";
+        for (const char* c = chars; *c; c++) {
+            glyphs.push_back(boxGlyph((uint8_t)*c, 9, 16, 0, 11));
+        }
+        font = hostFontBuild(glyphs, 16, 0);
+    }
+    return font.data();
+}
@@ -0,0 +1,45 @@
+#ifndef HOST_FONT_H
+#define HOST_FONT_H
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * HostFont - 主机端生成 U8g2 格式字体
+ *
+ * 主机端没有 U8g2 字库（u8g2_fonts.c 只在 .pio/libdeps 中）。本模块按 u8g2_font.c 的格式
+ * （23 字节字体头、ASCII 段、Unicode 跳转表 + 块，行程编码字形，见 lib/GlyphCache/U8g2Font.h）
+ * 把任意像素字形编码成字体数据，HostU8g2 / GlyphCache 可以像真实字体一样使用。
+ *
+ * hostFontCjk14() / hostFontDigits16() 是代替 u8g2_font_wqy14_t_gb2312 / u8g2_font_logisoso16_tr 的
+ * 合成字体：尺寸和步进与原字体相同，字形由编码确定性生成（不是真实字形），
+ * 用于界面布局的快照和金样图像比较。
+ *
+ * 只用于 native 环境，设备固件不链接本库。
+ */
+
+struct HostGlyph {
+    uint16_t encoding;
+    uint8_t width;
+    uint8_t height;
+    int8_t xOffset;      // 左边距
+    int8_t yOffset;      // 底边相对基线（向上为正）
+    int8_t advance;
+    std::vector<uint8_t> pixels;   // 按行，每像素一个字节（非 0 为点亮）
+};
+
+/**
+ * 编码成 U8g2 字体数据
+ * @param glyphs 按编码升序；编码 <= 255 的放 ASCII 段，其余放 Unicode 段（每块 100 个字）
+ * @param ascent 字体头中 'A' 的高度（ascentA）
+ * @param descent 字体头中 'g' 的下沉（descentG，负数）
+ */
+std::vector<uint8_t> hostFontBuild(const std::vector<HostGlyph>& glyphs, int8_t ascent, int8_t descent);
+
+// 代替 u8g2_font_wqy14_t_gb2312：ASCII 6×10（步进 7）、° 和 GB2312 常用汉字区 U+4E00~U+9FA5（14×14，步进 14）
+const uint8_t* hostFontCjk14();
+
+// 代替 u8g2_font_logisoso16_tr：数字、':'、'.'、'-'、'%'，9×16（步进 11）
+const uint8_t* hostFontDigits16();
+
+#endif // HOST_FONT_H
@@ -0,0 +1,456 @@
+#include "HostU8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include "U8g2Font.h"
+
+static double nowUs() {
+    using namespace std::chrono;
+    return duration<double, std::micro>(steady_clock::now().time_since_epoch()).count();
+}
+
+HostU8g2::HostU8g2()
+    : _font(nullptr), _fontTransparent(false), _color(1), _frameStartUs(0) {
+    memset(_buffer, 0, sizeof(_buffer));
+    resetStats();
+}
+
+void HostU8g2::resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+    panel.reset();
+}
+
+bool HostU8g2::begin() {
+    clearBuffer();
+    sendBuffer();
+    resetStats();
+    return true;
+}
+
+// ========== 发送 ==========
+
+void HostU8g2::clearBuffer() {
+    memset(_buffer, 0, sizeof(_buffer));
+    _frameStartUs = nowUs();
+}
+
+void HostU8g2::endFrame(uint32_t busBytesBefore) {
+    _stats.frames++;
+    _stats.lastBusBytes = panel.bytes - busBytesBefore;
+    _stats.busBytes += _stats.lastBusBytes;
+    _stats.cpuUs += _stats.lastCpuUs;
+}
+
+void HostU8g2::sendBuffer() {
+    _stats.lastCpuUs = _frameStartUs > 0 ? nowUs() - _frameStartUs : 0;
+    uint32_t before = panel.bytes;
+    for (uint8_t ty = 0; ty < DISPLAY_TILE_ROWS; ty++) {
+        panel.drawTiles(0, ty, DISPLAY_TILE_COLS, _buffer + ty * DISPLAY_WIDTH);
+    }
+    endFrame(before);
+    _frameStartUs = nowUs();
+}
+
+void HostU8g2::updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+    _stats.lastCpuUs = _frameStartUs > 0 ? nowUs() - _frameStartUs : 0;
+    uint32_t before = panel.bytes;
+    // 与 U8g2 相同：超出屏幕的部分截掉
+    if (tx < DISPLAY_TILE_COLS && ty < DISPLAY_TILE_ROWS) {
+        if (tx + tw > DISPLAY_TILE_COLS) {
+            tw = (uint8_t)(DISPLAY_TILE_COLS - tx);
+        }
+        if (ty + th > DISPLAY_TILE_ROWS) {
+            th = (uint8_t)(DISPLAY_TILE_ROWS - ty);
+        }
+        for (uint8_t r = 0; r < th; r++) {
+            panel.drawTiles(tx, (uint8_t)(ty + r), tw, _buffer + (ty + r) * DISPLAY_WIDTH + tx * 8);
+        }
+    }
+    endFrame(before);
+    _frameStartUs = nowUs();
+}
+
+// ========== 图形 ==========
+
+void HostU8g2::drawPixel(int16_t x, int16_t y) {
+    if (x < 0 || x >= DISPLAY_WIDTH || y < 0 || y >= DISPLAY_HEIGHT) {
+        return;
+    }
+    uint8_t* p = _buffer + (y >> 3) * DISPLAY_WIDTH + x;
+    uint8_t mask = (uint8_t)(1 << (y & 7));
+    if (_color == 0) {
+        *p &= (uint8_t)~mask;
+    } else if (_color == 1) {
+        *p |= mask;
+    } else {
+        *p ^= mask;
+    }
+}
+
+void HostU8g2::drawHLine(int16_t x, int16_t y, int16_t w) {
+    for (int16_t i = 0; i < w; i++) {
+        drawPixel((int16_t)(x + i), y);
+    }
+}
+
+void HostU8g2::drawVLine(int16_t x, int16_t y, int16_t h) {
+    for (int16_t i = 0; i < h; i++) {
+        drawPixel(x, (int16_t)(y + i));
+    }
+}
+
+void HostU8g2::drawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    // u8g2_DrawLine：Bresenham，按长轴逐点
+    bool swapxy = false;
+    int16_t dx = (int16_t)(x2 > x1 ? x2 - x1 : x1 - x2);
+    int16_t dy = (int16_t)(y2 > y1 ? y2 - y1 : y1 - y2);
+    int16_t t;
+    if (dy > dx) {
+        swapxy = true;
+        t = dx; dx = dy; dy = t;
+        t = x1; x1 = y1; y1 = t;
+        t = x2; x2 = y2; y2 = t;
+    }
+    if (x1 > x2) {
+        t = x1; x1 = x2; x2 = t;
+        t = y1; y1 = y2; y2 = t;
+    }
+    int16_t err = (int16_t)(dx >> 1);
+    int16_t ystep = (int16_t)(y2 > y1 ? 1 : -1);
+    int16_t y = y1;
+    for (int16_t x = x1; x <= x2; x++) {
+        if (swapxy) {
+            drawPixel(y, x);
+        } else {
+            drawPixel(x, y);
+        }
+        err = (int16_t)(err - dy);
+        if (err < 0) {
+            y = (int16_t)(y + ystep);
+            err = (int16_t)(err + dx);
+        }
+    }
+}
+
+void HostU8g2::drawBox(int16_t x, int16_t y, int16_t w, int16_t h) {
+    for (int16_t i = 0; i < h; i++) {
+        drawHLine(x, (int16_t)(y + i), w);
+    }
+}
+
+void HostU8g2::drawFrame(int16_t x, int16_t y, int16_t w, int16_t h) {
+    // u8g2_DrawFrame：上下两条横线，左右竖线不重复画角点（异或模式下结果正确）
+    drawHLine(x, y, w);
+    if (h >= 2) {
+        drawHLine(x, (int16_t)(y + h - 1), w);
+        if (h > 2 && w >= 1) {
+            drawVLine(x, (int16_t)(y + 1), (int16_t)(h - 2));
+            if (w >= 2) {
+                drawVLine((int16_t)(x + w - 1), (int16_t)(y + 1), (int16_t)(h - 2));
+            }
+        }
+    }
+}
+
+void HostU8g2::drawCircle(int16_t x0, int16_t y0, int16_t rad, uint8_t option) {
+    // u8g2_draw_circle：中点画圆，每步画 8 个对称点
+    int16_t f = (int16_t)(1 - rad), ddFx = 1, ddFy = (int16_t)(-2 * rad), x = 0, y = rad;
+    for (;;) {
+        if (option & HOST_U8G2_DRAW_UPPER_RIGHT) {
+            drawPixel((int16_t)(x0 + x), (int16_t)(y0 - y));
+            drawPixel((int16_t)(x0 + y), (int16_t)(y0 - x));
+        }
+        if (option & HOST_U8G2_DRAW_UPPER_LEFT) {
+            drawPixel((int16_t)(x0 - x), (int16_t)(y0 - y));
+            drawPixel((int16_t)(x0 - y), (int16_t)(y0 - x));
+        }
+        if (option & HOST_U8G2_DRAW_LOWER_RIGHT) {
+            drawPixel((int16_t)(x0 + x), (int16_t)(y0 + y));
+            drawPixel((int16_t)(x0 + y), (int16_t)(y0 + x));
+        }
+        if (option & HOST_U8G2_DRAW_LOWER_LEFT) {
+            drawPixel((int16_t)(x0 - x), (int16_t)(y0 + y));
+            drawPixel((int16_t)(x0 - y), (int16_t)(y0 + x));
+        }
+        if (x >= y) {
+            break;
+        }
+        if (f >= 0) {
+            y--;
+            ddFy = (int16_t)(ddFy + 2);
+            f = (int16_t)(f + ddFy);
+        }
+        x++;
+        ddFx = (int16_t)(ddFx + 2);
+        f = (int16_t)(f + ddFx);
+    }
+}
+
+void HostU8g2::drawDisc(int16_t x0, int16_t y0, int16_t rad, uint8_t option) {
+    // u8g2_draw_disc：与画圆同样的步进，每步画 4 条竖线
+    int16_t f = (int16_t)(1 - rad), ddFx = 1, ddFy = (int16_t)(-2 * rad), x = 0, y = rad;
+    for (;;) {
+        if (option & HOST_U8G2_DRAW_UPPER_RIGHT) {
+            drawVLine((int16_t)(x0 + x), (int16_t)(y0 - y), (int16_t)(y + 1));
+            drawVLine((int16_t)(x0 + y), (int16_t)(y0 - x), (int16_t)(x + 1));
+        }
+        if (option & HOST_U8G2_DRAW_UPPER_LEFT) {
+            drawVLine((int16_t)(x0 - x), (int16_t)(y0 - y), (int16_t)(y + 1));
+            drawVLine((int16_t)(x0 - y), (int16_t)(y0 - x), (int16_t)(x + 1));
+        }
+        if (option & HOST_U8G2_DRAW_LOWER_RIGHT) {
+            drawVLine((int16_t)(x0 + x), y0, (int16_t)(y + 1));
+            drawVLine((int16_t)(x0 + y), y0, (int16_t)(x + 1));
+        }
+        if (option & HOST_U8G2_DRAW_LOWER_LEFT) {
+            drawVLine((int16_t)(x0 - x), y0, (int16_t)(y + 1));
+            drawVLine((int16_t)(x0 - y), y0, (int16_t)(x + 1));
+        }
+        if (x >= y) {
+            break;
+        }
+        if (f >= 0) {
+            y--;
+            ddFy = (int16_t)(ddFy + 2);
+            f = (int16_t)(f + ddFy);
+        }
+        x++;
+        ddFx = (int16_t)(ddFx + 2);
+        f = (int16_t)(f + ddFx);
+    }
+}
+
+// ========== 文字 ==========
+
+void HostU8g2::setFont(const uint8_t* font) {
+    _font = font;
+}
+
+int16_t HostU8g2::drawGlyphs(int16_t x, int16_t y, const char* str, bool utf8) {
+    if (_font == nullptr) {
+        return 0;
+    }
+    U8g2FontInfo info;
+    u8g2FontReadInfo(_font, info);
+    uint8_t bits[32 * 32 / 8];
+    int16_t start = x;
+    const uint8_t fg = _color;
+    const uint8_t bg = (uint8_t)(_color == 0 ? 1 : 0);
+
+    while (*str) {
+        uint16_t e = utf8 ? utf8Next(str) : (uint8_t)*str++;
+        if (e == 0) {
+            break;
+        }
+        const uint8_t* data = e == 0xFFFF ? nullptr : u8g2FontFindGlyph(_font, info, e);
+        if (data == nullptr) {
+            continue;
+        }
+        GlyphBitmap g;
+        if (u8g2FontDecodeGlyph(info, data, e, g, bits, sizeof(bits)) == 0 && g.width > 0) {
+            x = (int16_t)(x + g.advance);   // 超过 32×32 的字形不画
+            continue;
+        }
+        int16_t left = (int16_t)(x + g.xOffset), top = (int16_t)(y - g.height - g.yOffset);
+        for (uint8_t r = 0; r < g.height; r++) {
+            for (uint8_t c = 0; c < g.width; c++) {
+                bool on = (g.bits[r * g.rowBytes() + (c >> 3)] & (0x80 >> (c & 7))) != 0;
+                if (on) {
+                    drawPixel((int16_t)(left + c), (int16_t)(top + r));
+                } else if (!_fontTransparent && _color != 2) {
+                    // 实心字体模式：字形框内的 0 用背景色画
+                    _color = bg;
+                    drawPixel((int16_t)(left + c), (int16_t)(top + r));
+                    _color = fg;
+                }
+            }
+        }
+        x = (int16_t)(x + g.advance);
+    }
+    return (int16_t)(x - start);
+}
+
+int16_t HostU8g2::width(const char* str, bool utf8) {
+    if (_font == nullptr) {
+        return 0;
+    }
+    // u8g2_string_width：各字步进之和，最后一个字换成实际宽度 + x 偏移
+    U8g2FontInfo info;
+    u8g2FontReadInfo(_font, info);
+    int16_t w = 0, dx = 0;
+    GlyphBitmap last;
+    last.width = 0;
+    while (*str) {
+        uint16_t e = utf8 ? utf8Next(str) : (uint8_t)*str++;
+        if (e == 0) {
+            break;
+        }
+        const uint8_t* data = e == 0xFFFF ? nullptr : u8g2FontFindGlyph(_font, info, e);
+        if (data == nullptr) {
+            continue;
+        }
+        u8g2FontDecodeGlyph(info, data, e, last, nullptr, 0);
+        dx = last.advance;
+        w = (int16_t)(w + dx);
+    }
+    if (last.width != 0) {
+        w = (int16_t)(w - dx + last.width + last.xOffset);
+    }
+    return w;
+}
+
+int16_t HostU8g2::drawStr(int16_t x, int16_t y, const char* str) {
+    return drawGlyphs(x, y, str, false);
+}
+
+int16_t HostU8g2::drawUTF8(int16_t x, int16_t y, const char* str) {
+    return drawGlyphs(x, y, str, true);
+}
+
+int16_t HostU8g2::getStrWidth(const char* str) {
+    return width(str, false);
+}
+
+int16_t HostU8g2::getUTF8Width(const char* str) {
+    return width(str, true);
+}
+
+// ========== 快照 ==========
+
+static bool pixelOn(const uint8_t* buffer, int x, int y) {
+    return (buffer[(y >> 3) * DISPLAY_WIDTH + x] >> (y & 7)) & 1;
+}
+
+bool framebufferWritePbm(const char* path, const uint8_t* buffer) {
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    // P4：每行 16 字节，1 为黑（点亮的像素画成黑色）
+    fprintf(f, "P4\n%d %d\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+        uint8_t row[DISPLAY_WIDTH / 8] = {0};
+        for (int x = 0; x < DISPLAY_WIDTH; x++) {
+            if (pixelOn(buffer, x, y)) {
+                row[x >> 3] |= (uint8_t)(0x80 >> (x & 7));
+            }
+        }
+        fwrite(row, 1, sizeof(row), f);
+    }
+    return fclose(f) == 0;
+}
+
+bool framebufferReadPbm(const char* path, uint8_t* buffer) {
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    int w = 0, h = 0;
+    bool ok = fscanf(f, "P4 %d %d", &w, &h) == 2 && w == DISPLAY_WIDTH && h == DISPLAY_HEIGHT && fgetc(f) != EOF;
+    memset(buffer, 0, DISPLAY_BUFFER_SIZE);
+    for (int y = 0; ok && y < DISPLAY_HEIGHT; y++) {
+        uint8_t row[DISPLAY_WIDTH / 8];
+        if (fread(row, 1, sizeof(row), f) != sizeof(row)) {
+            ok = false;
+            break;
+        }
+        for (int x = 0; x < DISPLAY_WIDTH; x++) {
+            if (row[x >> 3] & (0x80 >> (x & 7))) {
+                buffer[(y >> 3) * DISPLAY_WIDTH + x] |= (uint8_t)(1 << (y & 7));
+            }
+        }
+    }
+    fclose(f);
+    return ok;
+}
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t n) {
+    crc = ~crc;
+    for (size_t i = 0; i < n; i++) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static void putBE32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void writeChunk(FILE* f, const char* type, const uint8_t* data, uint32_t n) {
+    uint8_t head[8];
+    putBE32(head, n);
+    memcpy(head + 4, type, 4);
+    fwrite(head, 1, 8, f);
+    fwrite(data, 1, n, f);
+    uint32_t crc = crc32Update(crc32Update(0, (const uint8_t*)type, 4), data, n);
+    uint8_t tail[4];
+    putBE32(tail, crc);
+    fwrite(tail, 1, 4, f);
+}
+
+bool framebufferWritePng(const char* path, const uint8_t* buffer) {
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    // 1 位灰度，点亮的像素为白（与屏幕一致）；IDAT 用不压缩的 deflate 块，不依赖 zlib
+    const int rowBytes = DISPLAY_WIDTH / 8 + 1;
+    uint8_t raw[DISPLAY_HEIGHT * rowBytes];
+    for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+        uint8_t* row = raw + y * rowBytes;
+        memset(row, 0, rowBytes);
+        for (int x = 0; x < DISPLAY_WIDTH; x++) {
+            if (pixelOn(buffer, x, y)) {
+                row[1 + (x >> 3)] |= (uint8_t)(0x80 >> (x & 7));
+            }
+        }
+    }
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < sizeof(raw); i++) {
+        a = (a + raw[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    uint8_t idat[2 + 5 + sizeof(raw) + 4];
+    idat[0] = 0x78;
+    idat[1] = 0x01;
+    idat[2] = 0x01;   // 最后一个块，不压缩
+    idat[3] = (uint8_t)(sizeof(raw) & 0xFF);
+    idat[4] = (uint8_t)(sizeof(raw) >> 8);
+    idat[5] = (uint8_t)~idat[3];
+    idat[6] = (uint8_t)~idat[4];
+    memcpy(idat + 7, raw, sizeof(raw));
+    putBE32(idat + 7 + sizeof(raw), (b << 16) | a);
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    fwrite(signature, 1, 8, f);
+    uint8_t ihdr[13];
+    putBE32(ihdr, DISPLAY_WIDTH);
+    putBE32(ihdr + 4, DISPLAY_HEIGHT);
+    ihdr[8] = 1;    // 位深
+    ihdr[9] = 0;    // 灰度
+    ihdr[10] = 0;
+    ihdr[11] = 0;
+    ihdr[12] = 0;
+    writeChunk(f, "IHDR", ihdr, sizeof(ihdr));
+    writeChunk(f, "IDAT", idat, sizeof(idat));
+    writeChunk(f, "IEND", nullptr, 0);
+    return fclose(f) == 0;
+}
+
+uint32_t framebufferDiff(const uint8_t* a, const uint8_t* b) {
+    uint32_t n = 0;
+    for (int i = 0; i < DISPLAY_BUFFER_SIZE; i++) {
+        uint8_t d = a[i] ^ b[i];
+        while (d) {
+            n += d & 1;
+            d >>= 1;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,99 @@
+#ifndef HOST_U8G2_H
+#define HOST_U8G2_H
+
+#include <stdint.h>
+#include "TileFlusher.h"
+#include "RecordingTileTransport.h"
+
+/**
+ * HostU8g2 - 主机端 U8g2 兼容显示（128×64 内存帧缓冲）
+ *
+ * 实现 test_oled_display.cpp / OledScreens.h 用到的 U8g2 接口子集，绘制结果与 U8g2 全缓冲模式逐像素相同：
+ * - 缓冲格式同 U8g2（按页，bit0 在上，见 TileFlusher.h），getBufferPtr() 可直接交给 GlyphCache / SpritePlayer
+ * - 直线、矩形、圆、实心圆按 U8g2 的算法（u8g2_line.c / u8g2_box.c / u8g2_circle.c）逐点绘制
+ * - 文字按 U8g2 字体格式解码（lib/GlyphCache/U8g2Font.h），支持透明/实心字体模式和 0/1/2 绘制颜色
+ * - sendBuffer() / updateDisplayArea() 把块交给 RecordingTileTransport：panel.screen 为屏幕显存，
+ *   panel.bytes 为按 SSD1306 I2C 分包统计的总线字节
+ * - 每帧 CPU 时间：从 clearBuffer() 到 sendBuffer() / updateDisplayArea() 的耗时（不含发送）
+ *
+ * 快照：framebufferWritePbm()/framebufferWritePng() 把缓冲写成 PBM（P4）或 PNG（1 位灰度），
+ * framebufferReadPbm() 读回，用于金样图像比较。
+ *
+ * 只用于 native 环境，设备固件不链接本库。
+ */
+
+#define HOST_U8G2_DRAW_UPPER_RIGHT  0x01
+#define HOST_U8G2_DRAW_UPPER_LEFT   0x02
+#define HOST_U8G2_DRAW_LOWER_LEFT   0x04
+#define HOST_U8G2_DRAW_LOWER_RIGHT  0x08
+#define HOST_U8G2_DRAW_ALL          0x0F
+
+struct HostFrameStats {
+    uint32_t frames;       // sendBuffer() + updateDisplayArea() 次数
+    uint32_t busBytes;     // 总线字节（同 panel.bytes，按帧累计）
+    double   cpuUs;        // 累计绘制耗时
+    double   lastCpuUs;    // 最近一帧的绘制耗时
+    uint32_t lastBusBytes; // 最近一帧的总线字节
+};
+
+class HostU8g2 {
+public:
+    HostU8g2();
+
+    bool begin();
+    void clearBuffer();
+    void sendBuffer();
+    // 与 U8g2 相同：以 8×8 块为单位发送矩形
+    void updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+    uint8_t* getBufferPtr() { return _buffer; }
+    void enableUTF8Print() {}
+
+    void setFont(const uint8_t* font);
+    void setFontMode(uint8_t transparent) { _fontTransparent = transparent != 0; }
+    void setDrawColor(uint8_t color) { _color = color; }
+
+    void drawPixel(int16_t x, int16_t y);
+    void drawHLine(int16_t x, int16_t y, int16_t w);
+    void drawVLine(int16_t x, int16_t y, int16_t h);
+    void drawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+    void drawBox(int16_t x, int16_t y, int16_t w, int16_t h);
+    void drawFrame(int16_t x, int16_t y, int16_t w, int16_t h);
+    void drawCircle(int16_t x0, int16_t y0, int16_t rad, uint8_t option = HOST_U8G2_DRAW_ALL);
+    void drawDisc(int16_t x0, int16_t y0, int16_t rad, uint8_t option = HOST_U8G2_DRAW_ALL);
+
+    // y 为基线；返回步进宽度
+    int16_t drawStr(int16_t x, int16_t y, const char* str);
+    int16_t drawUTF8(int16_t x, int16_t y, const char* str);
+    int16_t getStrWidth(const char* str);
+    int16_t getUTF8Width(const char* str);
+
+    const HostFrameStats& stats() const { return _stats; }
+    void resetStats();
+
+    // 屏幕（SSD1306 显存）与总线统计
+    RecordingTileTransport panel;
+
+private:
+    int16_t drawGlyphs(int16_t x, int16_t y, const char* str, bool utf8);
+    int16_t width(const char* str, bool utf8);
+    void endFrame(uint32_t busBytesBefore);
+
+    uint8_t _buffer[DISPLAY_BUFFER_SIZE];
+    const uint8_t* _font;
+    bool _fontTransparent;
+    uint8_t _color;
+
+    HostFrameStats _stats;
+    double _frameStartUs;
+};
+
+// ========== 快照 ==========
+
+bool framebufferWritePbm(const char* path, const uint8_t* buffer);
+bool framebufferReadPbm(const char* path, uint8_t* buffer);
+bool framebufferWritePng(const char* path, const uint8_t* buffer);
+
+// 不同的像素数
+uint32_t framebufferDiff(const uint8_t* a, const uint8_t* b);
+
+#endif // HOST_U8G2_H
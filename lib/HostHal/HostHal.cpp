@@ -0,0 +1,96 @@
+#include "HostHal.h"
+#include <chrono>
+#include <thread>
+
+// ========== SteadyClock ==========
+
+uint32_t SteadyClock::nowUs() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+uint32_t SteadyClock::nowMs() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void SteadyClock::sleepUs(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+// ========== RecordingServo ==========
+
+bool RecordingServo::writeCsv(const char* path) const {
+    FILE* f = fopen(path, "w");
+    if (f == nullptr) {
+        return false;
+    }
+    fprintf(f, "time_us,pulse_us,angle\n");
+    for (size_t i = 0; i < samples.size(); i++) {
+        float angle = (float)(samples[i].pulseUs - _minUs) * 180.0f / (float)(_maxUs - _minUs);
+        fprintf(f, "%lu,%u,%.1f\n", (unsigned long)samples[i].timeUs, (unsigned)samples[i].pulseUs, angle);
+    }
+    return fclose(f) == 0;
+}
+
+// ========== FileSerial ==========
+
+FileSerial::~FileSerial() {
+    if (_ownsOut) {
+        fclose(_out);
+    }
+}
+
+bool FileSerial::openOutput(const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    setOutput(f);
+    _ownsOut = true;
+    return true;
+}
+
+void FileSerial::setOutput(FILE* out) {
+    if (_ownsOut) {
+        fclose(_out);
+    }
+    _out = out;
+    _ownsOut = false;
+}
+
+bool FileSerial::openInput(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    char buffer[512];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+        _input.append(buffer, n);
+    }
+    fclose(f);
+    return true;
+}
+
+size_t FileSerial::write(const uint8_t* data, size_t length) {
+    if (capture) {
+        captured.append((const char*)data, length);
+    }
+    if (_out != nullptr) {
+        fwrite(data, 1, length, _out);
+    }
+    return length;
+}
+
+int FileSerial::read() {
+    if (_readPos >= _input.size()) {
+        return -1;
+    }
+    return (uint8_t)_input[_readPos++];
+}
+
+// ========== HostHal ==========
+
+HostHal::HostHal(uint16_t ledCount)
+    : servoH(&clock), servoV(&clock), ledTransport(true), leds(ledCount, ledTransport) {}
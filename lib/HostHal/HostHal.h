@@ -0,0 +1,114 @@
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "Hal.h"
+#include "VirtualClock.h"
+#include "AudioSim.h"
+#include "AsyncLedStrip.h"
+#include "RecordingLedTransport.h"
+#include "RecordingTileTransport.h"
+
+/**
+ * HostHal - 硬件抽象层的主机端后端（文件和 mock）
+ *
+ * - SteadyClock：真实时间（std::chrono），sleepUs() 真的等待
+ * - RecordingServo：记录每次输出的脉宽和时刻，可写成 CSV
+ * - FileSerial：输出写入文件或标准输出（可同时保存在内存中供测试检查），输入来自脚本字符串或文件
+ * - HostHal：一套完整的主机端后端：VirtualClock（全速、结果确定）、两个 RecordingServo、
+ *   WavAudioSource（WAV 文件当作麦克风）、AsyncLedStrip + RecordingLedTransport、
+ *   RecordingTileTransport（模拟 SSD1306 显存）、FileSerial；hal() 返回交给逻辑代码的 Hal
+ *
+ * 只用于 native 环境，设备固件不链接本库。
+ */
+
+class SteadyClock : public HalClock {
+public:
+    uint32_t nowUs() override;
+    uint32_t nowMs() override;
+    void sleepUs(uint32_t us) override;
+};
+
+struct ServoSample {
+    uint32_t timeUs;
+    uint16_t pulseUs;
+};
+
+class RecordingServo : public HalServo {
+public:
+    // clock 为 nullptr 时记录的时刻为 0
+    explicit RecordingServo(HalClock* clock = nullptr) : pin(-1), _clock(clock) {}
+
+    void writeMicroseconds(uint16_t us) override {
+        samples.push_back({_clock != nullptr ? _clock->nowUs() : 0, us});
+    }
+
+    // 最近一次输出的脉宽，没有输出时为 0
+    uint16_t lastPulse() const { return samples.empty() ? 0 : samples.back().pulseUs; }
+
+    // 写成 CSV：time_us,pulse_us,angle
+    bool writeCsv(const char* path) const;
+
+    int pin;   // attach() 的引脚，未 attach 时为 -1
+    std::vector<ServoSample> samples;
+
+protected:
+    bool attachPin(uint8_t p, uint16_t, uint16_t) override {
+        pin = p;
+        return true;
+    }
+
+private:
+    HalClock* _clock;
+};
+
+class FileSerial : public HalSerial {
+public:
+    // out 为 nullptr 时不写文件（只在 capture 时保存在内存中）
+    explicit FileSerial(FILE* out = stdout) : capture(false), _out(out), _ownsOut(false), _readPos(0) {}
+    ~FileSerial();
+
+    bool openOutput(const char* path);
+    // 改为写入 out（nullptr 表示不写文件）
+    void setOutput(FILE* out);
+    // 追加输入（模拟在串口终端中输入）
+    void feed(const char* text) { _input.append(text); }
+    bool openInput(const char* path);
+
+    size_t write(const uint8_t* data, size_t length) override;
+    int available() override { return (int)(_input.size() - _readPos); }
+    int read() override;
+
+    bool capture;           // 输出同时追加到 captured
+    std::string captured;
+
+private:
+    FileSerial(const FileSerial&);
+    FileSerial& operator=(const FileSerial&);
+
+    FILE* _out;
+    bool _ownsOut;
+    std::string _input;
+    size_t _readPos;
+};
+
+class HostHal {
+public:
+    explicit HostHal(uint16_t ledCount = 5);
+
+    Hal hal() { return Hal{clock, servoH, servoV, microphone, leds, display, serial}; }
+
+    VirtualClock clock;
+    RecordingServo servoH;
+    RecordingServo servoV;
+    WavAudioSource microphone;   // 先 open() 一个 WAV 文件
+    RecordingLedTransport ledTransport;
+    AsyncLedStrip leds;
+    RecordingTileTransport display;
+    FileSerial serial;
+};
+
+#endif // HOST_HAL_H
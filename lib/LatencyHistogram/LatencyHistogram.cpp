@@ -0,0 +1,147 @@
+#include "LatencyHistogram.h"
+#include <stdio.h>
+
+LatencyHistogram::LatencyHistogram(const char* name, uint32_t deadlineUs)
+    : _name(name), _deadlineUs(deadlineUs), _count(0), _missed(0), _overflow(0), _max(0) {
+    for (uint16_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        _counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+// ========== 分桶 ==========
+
+uint32_t LatencyHistogram::bucketLow(uint16_t index) {
+    if (index < LAT_HIST_SUB_COUNT) {
+        return index;
+    }
+    uint32_t shift = index / LAT_HIST_SUB_COUNT - 1;
+    uint32_t sub = index % LAT_HIST_SUB_COUNT;
+    return (LAT_HIST_SUB_COUNT + sub) << shift;
+}
+
+uint32_t LatencyHistogram::bucketHigh(uint16_t index) {
+    if (index < LAT_HIST_SUB_COUNT) {
+        return index;
+    }
+    uint32_t shift = index / LAT_HIST_SUB_COUNT - 1;
+    return bucketLow(index) + (1u << shift) - 1;
+}
+
+uint32_t LatencyHistogram::bucketCount(uint16_t index) const {
+    return index < LAT_HIST_BUCKETS ? _counts[index].load(std::memory_order_relaxed) : 0;
+}
+
+// ========== 查询 ==========
+
+uint32_t LatencyHistogram::percentile(float percent) const {
+    // 按桶累加得到总数，而不是读 _count：写入方同时记录时两者可能差一
+    uint32_t total = 0;
+    for (uint16_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        total += _counts[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+    if (percent < 0) {
+        percent = 0;
+    }
+    if (percent > 100) {
+        percent = 100;
+    }
+
+    // 第 rank 个值（从 1 开始）
+    uint32_t rank = (uint32_t)((double)total * percent / 100.0 + 0.999999);
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank > total) {
+        rank = total;
+    }
+
+    uint32_t max = maxUs();
+    uint32_t seen = 0;
+    for (uint16_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        seen += _counts[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            if (i == LAT_HIST_BUCKETS - 1 && overflow() > 0) {
+                return max;   // 最后一个桶没有上界
+            }
+            uint32_t high = bucketHigh(i);
+            return high < max ? high : max;
+        }
+    }
+    return max;
+}
+
+uint32_t LatencyHistogram::minUs() const {
+    for (uint16_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        if (_counts[i].load(std::memory_order_relaxed) > 0) {
+            return bucketLow(i);
+        }
+    }
+    return 0;
+}
+
+// ========== 合并 ==========
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (uint16_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        uint32_t n = other._counts[i].load(std::memory_order_relaxed);
+        if (n > 0) {
+            _counts[i].store(_counts[i].load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+    }
+    _count.store(count() + other.count(), std::memory_order_relaxed);
+    _missed.store(missed() + other.missed(), std::memory_order_relaxed);
+    _overflow.store(overflow() + other.overflow(), std::memory_order_relaxed);
+    if (other.maxUs() > maxUs()) {
+        _max.store(other.maxUs(), std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::copyFrom(const LatencyHistogram& other) {
+    reset();
+    merge(other);
+}
+
+void LatencyHistogram::reset() {
+    for (uint16_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        _counts[i].store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _missed.store(0, std::memory_order_relaxed);
+    _overflow.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+// ========== 文本输出 ==========
+
+size_t LatencyHistogram::serialize(char* out, size_t cap) const {
+    if (cap == 0) {
+        return 0;
+    }
+    int n = snprintf(out, cap, "HIST %s s=%u dl=%lu n=%lu miss=%lu max=%lu over=%lu b=", _name,
+                     (unsigned)LAT_HIST_SUB_BITS, (unsigned long)_deadlineUs, (unsigned long)count(),
+                     (unsigned long)missed(), (unsigned long)maxUs(), (unsigned long)overflow());
+    if (n < 0 || (size_t)n >= cap) {
+        out[0] = '\0';
+        return 0;
+    }
+    size_t len = (size_t)n;
+
+    bool first = true;
+    for (uint16_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        uint32_t c = _counts[i].load(std::memory_order_relaxed);
+        if (c == 0) {
+            continue;
+        }
+        n = snprintf(out + len, cap - len, first ? "%u:%lu" : ",%u:%lu", (unsigned)i, (unsigned long)c);
+        if (n < 0 || (size_t)n >= cap - len) {
+            out[0] = '\0';
+            return 0;
+        }
+        len += (size_t)n;
+        first = false;
+    }
+    return len;
+}
@@ -0,0 +1,117 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * LatencyHistogram - 控制循环的节拍/耗时直方图（对数-线性分桶，HDR 风格）
+ *
+ * 原来只有 maxRunUs / maxFlushUs 这类最大值：一次偶发的长停顿和每一拍都抖动看起来一样。
+ * 本模块按微秒记录每一次的值，随时给出 p50 / p99 / 最大值和超过截止时间的次数：
+ * - 0 ~ 31us 每微秒一个桶；之后每个 2 的幂区间分 32 个桶，相对误差不超过 1/32（约 3%）
+ * - 记录为常数时间（一次前导零计数 + 移位 + 加一），固定 640 个桶（2.5KB），不分配内存
+ * - 超过 16.7 秒的值记在最后一个桶中（计入 overflow），最大值仍然准确
+ * - 桶的划分与设备、固件无关：不同设备/不同时间的直方图可以直接相加（merge），
+ *   serialize() 输出一行文本，tools/merge_histograms.py 汇总多台设备的日志并与基线比较
+ *
+ * 单写入方：每个直方图只由一个任务 record()；计数为原子变量，其他任务可以随时读取
+ * （percentile / serialize 看到的是某一时刻附近的计数，不需要加锁）。
+ * reset() 与写入方同时进行时可能漏掉正在写入的一次，与 Pipeline::resetStats() 相同。
+ */
+
+#define LAT_HIST_SUB_BITS    5
+#define LAT_HIST_SUB_COUNT   (1u << LAT_HIST_SUB_BITS)   // 每个 2 的幂区间的桶数
+#define LAT_HIST_MAX_MSB     23                           // 最高位不超过 bit 23（< 16.7 秒）
+#define LAT_HIST_BUCKETS     ((LAT_HIST_MAX_MSB - LAT_HIST_SUB_BITS + 2) * LAT_HIST_SUB_COUNT)   // 640
+#define LAT_HIST_MAX_TRACKED ((1u << (LAT_HIST_MAX_MSB + 1)) - 1)
+
+class LatencyHistogram {
+public:
+    /**
+     * @param name 名称（常量字符串，只保存指针）
+     * @param deadlineUs 截止时间，大于它的值计为超时（0 为不统计）
+     */
+    explicit LatencyHistogram(const char* name = "", uint32_t deadlineUs = 0);
+
+    // 记录一个值（us），只能在一个任务中调用
+    void record(uint32_t us) {
+        uint16_t index = bucketIndex(us);
+        bump(_counts[index]);
+        bump(_count);
+        if (us > LAT_HIST_MAX_TRACKED) {
+            bump(_overflow);
+        }
+        if (_deadlineUs != 0 && us > _deadlineUs) {
+            bump(_missed);
+        }
+        if (us > _max.load(std::memory_order_relaxed)) {
+            _max.store(us, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * 百分位数：第 ceil(count × p / 100) 个值所在桶的上界（不超过最大值）
+     * @param percent 0 ~ 100
+     * @return 没有记录时为 0
+     */
+    uint32_t percentile(float percent) const;
+
+    uint32_t count() const { return _count.load(std::memory_order_relaxed); }
+    uint32_t missed() const { return _missed.load(std::memory_order_relaxed); }
+    uint32_t overflow() const { return _overflow.load(std::memory_order_relaxed); }
+    uint32_t maxUs() const { return _max.load(std::memory_order_relaxed); }
+    uint32_t minUs() const;   // 所在桶的下界，没有记录时为 0
+    uint32_t deadlineUs() const { return _deadlineUs; }
+    const char* name() const { return _name; }
+    uint32_t bucketCount(uint16_t index) const;
+
+    /**
+     * 加上另一个直方图的计数（两者可以来自不同任务/不同时间段）；截止时间不同时超时数仍直接相加
+     * 调用方需保证本直方图此时没有写入方
+     */
+    void merge(const LatencyHistogram& other);
+    // 复制另一个直方图的计数（快照），名称和截止时间不变；调用方需保证本直方图此时没有写入方
+    void copyFrom(const LatencyHistogram& other);
+    void reset();
+
+    /**
+     * 输出一行文本（不含换行）：
+     *   HIST <名称> s=<分桶位数> dl=<截止us> n=<次数> miss=<超时> max=<最大us> over=<溢出> b=<桶>:<次数>,...
+     * 只列出非空的桶
+     * @return 写入的字符数，cap 不够时返回 0（out 为空串）
+     */
+    size_t serialize(char* out, size_t cap) const;
+
+    // 值所在的桶，以及桶覆盖的值范围 [bucketLow, bucketHigh]
+    static uint16_t bucketIndex(uint32_t us) {
+        if (us < LAT_HIST_SUB_COUNT) {
+            return (uint16_t)us;
+        }
+        uint32_t msb = 31u - (uint32_t)__builtin_clz(us);
+        if (msb > LAT_HIST_MAX_MSB) {
+            return LAT_HIST_BUCKETS - 1;
+        }
+        uint32_t shift = msb - LAT_HIST_SUB_BITS;
+        return (uint16_t)((shift + 1) * LAT_HIST_SUB_COUNT + ((us >> shift) - LAT_HIST_SUB_COUNT));
+    }
+    static uint32_t bucketLow(uint16_t index);
+    static uint32_t bucketHigh(uint16_t index);
+
+private:
+    // 单写入方：读-加-写，不需要原子加法指令
+    static void bump(std::atomic<uint32_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    const char* _name;
+    uint32_t _deadlineUs;
+    std::atomic<uint32_t> _counts[LAT_HIST_BUCKETS];
+    std::atomic<uint32_t> _count;
+    std::atomic<uint32_t> _missed;
+    std::atomic<uint32_t> _overflow;
+    std::atomic<uint32_t> _max;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,256 @@
+#include "LedAnimation.h"
+#include <string.h>
+
+// ========== 内置轨道 ==========
+
+// 等级 136 经 gamma 后为 50，与原 eyeBreathEffect / 待机呼吸的最低亮度 50 相同
+static const LedKeyframe BREATHE_KEYS[] = {{0, 136}, {1200, 255}, {2400, 136}};
+static const LedKeyframe PULSE_KEYS[] = {{0, 255}, {500, 0}};
+static const LedKeyframe FADE_IN_KEYS[] = {{0, 0}, {300, 255}};
+static const LedKeyframe FADE_OUT_KEYS[] = {{0, 255}, {300, 0}};
+
+const LedTrack LED_TRACK_BREATHE = {BREATHE_KEYS, 3, true};
+const LedTrack LED_TRACK_PULSE = {PULSE_KEYS, 2, false};
+const LedTrack LED_TRACK_FADE_IN = {FADE_IN_KEYS, 2, false};
+const LedTrack LED_TRACK_FADE_OUT = {FADE_OUT_KEYS, 2, false};
+
+// gamma 2.6：round((i / 255)^2.6 * 255)
+const uint8_t LED_GAMMA8[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,
+      3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   5,   6,   6,   6,   6,   7,
+      7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  10,  11,  11,  11,  12,  12,
+     13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,
+     20,  21,  21,  22,  22,  23,  24,  24,  25,  25,  26,  27,  27,  28,  29,  29,
+     30,  31,  31,  32,  33,  34,  34,  35,  36,  37,  38,  38,  39,  40,  41,  42,
+     42,  43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,
+     58,  59,  60,  61,  62,  63,  64,  65,  66,  68,  69,  70,  71,  72,  73,  75,
+     76,  77,  78,  80,  81,  82,  84,  85,  86,  88,  89,  90,  92,  93,  94,  96,
+     97,  99, 100, 102, 103, 105, 106, 108, 109, 111, 112, 114, 115, 117, 119, 120,
+    122, 124, 125, 127, 129, 130, 132, 134, 136, 137, 139, 141, 143, 145, 146, 148,
+    150, 152, 154, 156, 158, 160, 162, 164, 166, 168, 170, 172, 174, 176, 178, 180,
+    182, 184, 186, 188, 191, 193, 195, 197, 199, 202, 204, 206, 209, 211, 213, 215,
+    218, 220, 223, 225, 227, 230, 232, 235, 237, 240, 242, 245, 247, 250, 252, 255,
+};
+
+// ========== LedAnimator ==========
+
+LedAnimator::LedAnimator(LedCompositor& frame, uint16_t frameMs)
+    : _frame(frame), _frameMs(frameMs ? frameMs : 1), _lastFrameMs(0), _started(false) {
+    memset(_layers, 0, sizeof(_layers));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+int8_t LedAnimator::addLayer(uint8_t zone, uint32_t color, const LedTrack* track, LedBlend blend, uint16_t opacity) {
+    if (zone >= _frame.zoneCount()) {
+        return -1;
+    }
+    for (int8_t i = 0; i < LED_ANIM_MAX_LAYERS; i++) {
+        Layer& l = _layers[i];
+        if (l.active) {
+            continue;
+        }
+        memset(&l, 0, sizeof(l));
+        l.active = true;
+        l.zone = zone;
+        l.color = color;
+        l.blend = blend;
+        l.opacity = opacity > LED_FIXED_ONE ? LED_FIXED_ONE : opacity;
+        l.track = track;
+        startTrack(l);
+        return i;
+    }
+    return -1;
+}
+
+void LedAnimator::removeLayer(int8_t layer) {
+    if (valid(layer)) {
+        _layers[layer].active = false;
+    }
+}
+
+void LedAnimator::setTrack(int8_t layer, const LedTrack* track) {
+    if (!valid(layer) || _layers[layer].track == track) {
+        return;
+    }
+    _layers[layer].track = track;
+    startTrack(_layers[layer]);
+}
+
+void LedAnimator::restart(int8_t layer) {
+    if (valid(layer)) {
+        startTrack(_layers[layer]);
+    }
+}
+
+void LedAnimator::setColor(int8_t layer, uint32_t color) {
+    if (valid(layer)) {
+        _layers[layer].color = color;
+    }
+}
+
+void LedAnimator::setOpacity(int8_t layer, uint16_t opacity) {
+    if (valid(layer)) {
+        _layers[layer].opacity = opacity > LED_FIXED_ONE ? LED_FIXED_ONE : opacity;
+    }
+}
+
+void LedAnimator::setLevel(int8_t layer, uint8_t level) {
+    // 只对输入图层有效，轨道图层的亮度由关键帧决定
+    if (valid(layer) && _layers[layer].track == nullptr) {
+        _layers[layer].level88 = (int32_t)level << 8;
+    }
+}
+
+uint8_t LedAnimator::level(int8_t layer) const {
+    return valid(layer) ? (uint8_t)(_layers[layer].level88 >> 8) : 0;
+}
+
+bool LedAnimator::finished(int8_t layer) const {
+    return !valid(layer) || _layers[layer].finished;
+}
+
+void LedAnimator::startTrack(Layer& l) {
+    l.key = 0;
+    l.step88 = 0;
+    l.framesLeft = 0;
+    if (l.track == nullptr || l.track->count == 0) {
+        l.level88 = (int32_t)255 << 8;
+        l.finished = true;
+        return;
+    }
+    l.level88 = (int32_t)l.track->keys[0].level << 8;
+    l.finished = false;
+    beginSegment(l);
+}
+
+void LedAnimator::beginSegment(Layer& l) {
+    const LedTrack& t = *l.track;
+    if (l.key + 1 >= t.count) {
+        if (!t.loop || t.count < 2) {
+            l.finished = true;   // 停在最后一个关键帧
+            return;
+        }
+        l.key = 0;
+        l.level88 = (int32_t)t.keys[0].level << 8;
+    }
+
+    const LedKeyframe& a = t.keys[l.key];
+    const LedKeyframe& b = t.keys[l.key + 1];
+    uint16_t duration = b.timeMs > a.timeMs ? b.timeMs - a.timeMs : 0;
+    uint16_t frames = (duration + _frameMs / 2) / _frameMs;
+    if (frames == 0) {
+        frames = 1;
+    }
+
+    // 每段一次除法，之后逐帧累加
+    l.framesLeft = frames;
+    l.step88 = (((int32_t)b.level << 8) - l.level88) / frames;
+}
+
+void LedAnimator::advance(Layer& l) {
+    if (l.finished) {
+        return;
+    }
+    l.level88 += l.step88;
+    if (--l.framesLeft == 0) {
+        // 段末对齐关键帧，消除累加误差
+        l.key++;
+        l.level88 = (int32_t)l.track->keys[l.key].level << 8;
+        beginSegment(l);
+    }
+}
+
+static inline uint8_t scaleChannel(uint8_t c, uint16_t scale) {
+    return (uint8_t)((c * scale) >> 8);
+}
+
+void LedAnimator::render() {
+    for (uint8_t z = 0; z < _frame.zoneCount(); z++) {
+        uint16_t r = 0, g = 0, b = 0;
+        bool any = false;
+
+        for (uint8_t i = 0; i < LED_ANIM_MAX_LAYERS; i++) {
+            const Layer& l = _layers[i];
+            if (!l.active || l.zone != z) {
+                continue;
+            }
+            any = true;
+
+            // 亮度经 gamma 后缩放颜色，再乘不透明度（均为 8.8，255 级时为 256 = 1.0）
+            uint16_t scale = (uint16_t)LED_GAMMA8[l.level88 >> 8] + 1;
+            uint16_t lr = scaleChannel(scaleChannel((uint8_t)(l.color >> 16), scale), l.opacity);
+            uint16_t lg = scaleChannel(scaleChannel((uint8_t)(l.color >> 8), scale), l.opacity);
+            uint16_t lb = scaleChannel(scaleChannel((uint8_t)l.color, scale), l.opacity);
+
+            switch (l.blend) {
+                case LED_BLEND_REPLACE:
+                    // 下层 × (1 - 不透明度) + 本层（本层已乘过不透明度）
+                    r = scaleChannel((uint8_t)r, LED_FIXED_ONE - l.opacity) + lr;
+                    g = scaleChannel((uint8_t)g, LED_FIXED_ONE - l.opacity) + lg;
+                    b = scaleChannel((uint8_t)b, LED_FIXED_ONE - l.opacity) + lb;
+                    break;
+                case LED_BLEND_ADD:
+                    r += lr;
+                    g += lg;
+                    b += lb;
+                    break;
+                case LED_BLEND_MAX:
+                    if (lr > r) r = lr;
+                    if (lg > g) g = lg;
+                    if (lb > b) b = lb;
+                    break;
+            }
+            if (r > 255) r = 255;
+            if (g > 255) g = 255;
+            if (b > 255) b = 255;
+        }
+
+        // 没有图层的区域保持原样，便于与直接写合成器的代码共存
+        if (any) {
+            _frame.fillZone(z, ledColor((uint8_t)r, (uint8_t)g, (uint8_t)b));
+        }
+    }
+    _stats.renders++;
+}
+
+void LedAnimator::step() {
+    for (uint8_t i = 0; i < LED_ANIM_MAX_LAYERS; i++) {
+        if (_layers[i].active) {
+            advance(_layers[i]);
+        }
+    }
+    _stats.frames++;
+    render();
+}
+
+bool LedAnimator::update(uint32_t nowMs) {
+    if (!_started) {
+        _started = true;
+        _lastFrameMs = nowMs;
+        render();
+        return false;
+    }
+
+    uint32_t frames = (nowMs - _lastFrameMs) / _frameMs;
+    if (frames == 0) {
+        return false;
+    }
+    _lastFrameMs += frames * _frameMs;
+
+    if (frames > LED_ANIM_MAX_CATCHUP) {
+        _stats.dropped += frames - LED_ANIM_MAX_CATCHUP;
+        frames = LED_ANIM_MAX_CATCHUP;
+    }
+    for (uint32_t f = 0; f < frames; f++) {
+        for (uint8_t i = 0; i < LED_ANIM_MAX_LAYERS; i++) {
+            if (_layers[i].active) {
+                advance(_layers[i]);
+            }
+        }
+        _stats.frames++;
+    }
+    render();
+    return true;
+}
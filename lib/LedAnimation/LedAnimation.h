@@ -0,0 +1,124 @@
+#ifndef LED_ANIMATION_H
+#define LED_ANIMATION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "LedCompositor.h"
+
+/**
+ * LedAnimation - 关键帧 LED 动画引擎
+ *
+ * 效果用数据描述，而不是各自带 static 计数器的函数：
+ * - 关键帧轨道（LedTrack）：一组 (时间, 亮度等级) 关键帧，可循环
+ *   呼吸 = 暗→亮→暗循环，脉冲 = 最亮后衰减一次，淡入/淡出 = 两个关键帧
+ * - 图层（layer）：区域 + 颜色 + 轨道 + 混合方式 + 不透明度，同一区域的图层按添加顺序叠加
+ * - 没有轨道的图层亮度由外部输入（setLevel），用于音频联动
+ *
+ * 计算方式：
+ * - 固定帧率（默认与 LED 合成器相同的 10ms），update() 按经过的时间补齐帧数
+ * - 亮度以 8.8 定点数逐帧累加步进值，只在关键帧段切换时做一次除法，段末对齐到关键帧值
+ * - 亮度等级经预计算的 gamma 查表（2.6）后缩放图层颜色，等级 255 时颜色不变
+ * - 混合（替换 / 相加 / 取最大）使用 8.8 定点不透明度，结果写入 LedCompositor 区域
+ */
+
+#define LED_ANIM_MAX_LAYERS    8
+#define LED_ANIM_MAX_CATCHUP   50      // 一次 update() 最多补的帧数（loop 被阻塞后不追赶过多）
+#define LED_FIXED_ONE          256     // 8.8 定点的 1.0
+
+struct LedKeyframe {
+    uint16_t timeMs;   // 相对轨道起点
+    uint8_t level;     // 亮度等级（gamma 之前）
+};
+
+struct LedTrack {
+    const LedKeyframe* keys;
+    uint8_t count;
+    bool loop;         // 循环轨道最后一个关键帧应与第一个相同
+};
+
+enum LedBlend : uint8_t {
+    LED_BLEND_REPLACE,   // 按不透明度覆盖下层
+    LED_BLEND_ADD,       // 叠加（饱和）
+    LED_BLEND_MAX        // 各通道取较大值
+};
+
+// 内置轨道
+extern const LedTrack LED_TRACK_BREATHE;    // 2.4s 呼吸，最暗 gamma 后约 50/255
+extern const LedTrack LED_TRACK_PULSE;      // 第一帧即最亮、500ms 衰减到0，一次（后面紧跟阻塞动作时也能看到）
+extern const LedTrack LED_TRACK_FADE_IN;    // 300ms 0→255
+extern const LedTrack LED_TRACK_FADE_OUT;   // 300ms 255→0
+
+extern const uint8_t LED_GAMMA8[256];
+
+struct LedAnimStats {
+    uint32_t frames;    // 已计算的动画帧
+    uint32_t renders;   // 写入合成器的次数（每次 update 至多一次）
+    uint32_t dropped;   // 超过 LED_ANIM_MAX_CATCHUP 而跳过的帧
+};
+
+class LedAnimator {
+public:
+    explicit LedAnimator(LedCompositor& frame, uint16_t frameMs = LED_FRAME_MS);
+
+    /**
+     * 添加图层
+     * @param track 关键帧轨道；nullptr 表示亮度由 setLevel() 输入（初始 255）
+     * @return 图层编号，图层已满或区域无效返回 -1
+     */
+    int8_t addLayer(uint8_t zone, uint32_t color, const LedTrack* track = nullptr,
+                    LedBlend blend = LED_BLEND_REPLACE, uint16_t opacity = LED_FIXED_ONE);
+    void removeLayer(int8_t layer);
+
+    // 切换轨道并从头播放（同一轨道不重启，状态重复进入时不会打断呼吸）
+    void setTrack(int8_t layer, const LedTrack* track);
+    void restart(int8_t layer);
+    void setColor(int8_t layer, uint32_t color);
+    void setOpacity(int8_t layer, uint16_t opacity);
+    void setLevel(int8_t layer, uint8_t level);
+
+    uint8_t level(int8_t layer) const;
+    bool finished(int8_t layer) const;
+
+    /**
+     * 推进到 nowMs：按固定帧率补齐帧，再把各区域混合结果写入合成器
+     * @return 是否推进了至少一帧
+     */
+    bool update(uint32_t nowMs);
+
+    // 单步一帧并写入合成器（测试、基准用）
+    void step();
+
+    uint16_t frameMs() const { return _frameMs; }
+    const LedAnimStats& stats() const { return _stats; }
+
+private:
+    struct Layer {
+        bool active;
+        bool finished;
+        uint8_t zone;
+        LedBlend blend;
+        uint16_t opacity;
+        uint32_t color;
+        const LedTrack* track;
+        uint8_t key;           // 当前段起点关键帧
+        uint16_t framesLeft;   // 当前段剩余帧数
+        int32_t level88;       // 当前亮度（8.8）
+        int32_t step88;        // 每帧增量（8.8）
+    };
+
+    bool valid(int8_t layer) const { return layer >= 0 && layer < LED_ANIM_MAX_LAYERS && _layers[layer].active; }
+    void startTrack(Layer& l);
+    void beginSegment(Layer& l);
+    void advance(Layer& l);
+    void render();
+
+    LedCompositor& _frame;
+    uint16_t _frameMs;
+    uint32_t _lastFrameMs;
+    bool _started;
+
+    Layer _layers[LED_ANIM_MAX_LAYERS];
+    LedAnimStats _stats;
+};
+
+#endif // LED_ANIMATION_H
@@ -0,0 +1,126 @@
+#include "LedVisualizer.h"
+#include <math.h>
+#include <string.h>
+
+LedVisualizer::LedVisualizer(LedAnimator& anim, uint16_t staleMs)
+    : _anim(anim), _staleMs(staleMs), _lastFrameMs(0), _started(false), _haveLatest(false) {
+    memset(&_latest, 0, sizeof(_latest));
+    memset(_bindings, 0, sizeof(_bindings));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+bool LedVisualizer::publish(const AudioLevelFrame& frame) {
+    if (!_queue.push(frame)) {
+        _stats.overflows++;
+        return false;
+    }
+    _stats.published++;
+    return true;
+}
+
+uint16_t LedVisualizer::coefficient(uint16_t tauMs) const {
+    if (tauMs == 0) {
+        return LED_FIXED_ONE;
+    }
+    // 一阶指数：每帧逼近 1 - e^(-帧长/时间常数)
+    float k = 1.0f - expf(-(float)_anim.frameMs() / tauMs);
+    uint16_t k88 = (uint16_t)(k * LED_FIXED_ONE + 0.5f);
+    return k88 == 0 ? 1 : k88;
+}
+
+int8_t LedVisualizer::bind(int8_t layer, LedVisSource source, uint16_t attackMs, uint16_t releaseMs, uint8_t floor) {
+    for (int8_t i = 0; i < LED_VIS_MAX_BINDINGS; i++) {
+        Binding& b = _bindings[i];
+        if (b.used) {
+            continue;
+        }
+        b.used = true;
+        b.enabled = true;
+        b.layer = layer;
+        b.source = source;
+        b.floor = floor;
+        b.attackK = coefficient(attackMs);
+        b.releaseK = coefficient(releaseMs);
+        b.env88 = 0;
+        return i;
+    }
+    return -1;
+}
+
+void LedVisualizer::setEnabled(int8_t binding, bool enabled) {
+    if (!valid(binding)) {
+        return;
+    }
+    Binding& b = _bindings[binding];
+    if (enabled && !b.enabled) {
+        b.env88 = 0;   // 重新启用时从最低亮度开始，不带上次残留
+    }
+    b.enabled = enabled;
+}
+
+uint8_t LedVisualizer::envelope(int8_t binding) const {
+    return valid(binding) ? (uint8_t)(_bindings[binding].env88 >> 8) : 0;
+}
+
+uint8_t LedVisualizer::output(int8_t binding) const {
+    if (!valid(binding)) {
+        return 0;
+    }
+    const Binding& b = _bindings[binding];
+    uint16_t out = b.floor + (((b.env88 >> 8) * (LED_FIXED_ONE - b.floor)) >> 8);
+    return out > 255 ? 255 : (uint8_t)out;
+}
+
+uint8_t LedVisualizer::sourceLevel(LedVisSource source) const {
+    switch (source) {
+        case LED_VIS_LOW:
+            return _latest.bands[AUDIO_LEVEL_LOW];
+        case LED_VIS_HIGH:
+            return _latest.bands[AUDIO_LEVEL_HIGH];
+        default:
+            return _latest.level;
+    }
+}
+
+void LedVisualizer::update(uint32_t nowMs) {
+    // 只保留最新一帧
+    AudioLevelFrame frame;
+    while (_queue.pop(frame)) {
+        _latest = frame;
+        _haveLatest = true;
+        _stats.consumed++;
+        _stats.lastAgeMs = nowMs - frame.timeMs;
+    }
+
+    uint32_t frames;
+    if (!_started) {
+        _started = true;
+        _lastFrameMs = nowMs;
+        frames = 1;
+    } else {
+        frames = (nowMs - _lastFrameMs) / _anim.frameMs();
+        if (frames == 0) {
+            return;
+        }
+        _lastFrameMs += frames * _anim.frameMs();
+        if (frames > LED_ANIM_MAX_CATCHUP) {
+            frames = LED_ANIM_MAX_CATCHUP;
+        }
+    }
+
+    bool fresh = _haveLatest && nowMs - _latest.timeMs <= _staleMs;
+
+    for (uint8_t i = 0; i < LED_VIS_MAX_BINDINGS; i++) {
+        Binding& b = _bindings[i];
+        if (!b.used || !b.enabled) {
+            continue;
+        }
+        int32_t target88 = fresh ? (int32_t)sourceLevel(b.source) << 8 : 0;
+        for (uint32_t f = 0; f < frames; f++) {
+            uint16_t k = target88 > b.env88 ? b.attackK : b.releaseK;
+            b.env88 += ((target88 - b.env88) * k) >> 8;
+        }
+        _anim.setLevel(b.layer, output(i));
+    }
+    _stats.frames += frames;
+}
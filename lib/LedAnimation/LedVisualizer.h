@@ -0,0 +1,99 @@
+#ifndef LED_VISUALIZER_H
+#define LED_VISUALIZER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "LedAnimation.h"
+#include "AudioLevels.h"
+#include "SpscRing.h"
+
+/**
+ * LedVisualizer - 音频联动灯效
+ *
+ * 采集端每处理完一段采样就 publish() 一帧电平（AudioLevelFrame），
+ * LED 端按动画帧率 update()：取最新一帧（不重读 I2S），经起音/释放包络后
+ * 写入 LedAnimator 的输入图层（addLayer 时不带轨道的图层）。
+ *
+ * - 发布与消费之间是 SpscRing，采集和灯效可以在不同任务/核上
+ * - 绑定（binding）= 图层 + 电平来源（全频带/低频/高频）+ 起音/释放时间 + 最低亮度，
+ *   增加联动效果只需增加绑定
+ * - 包络按 8.8 定点逐帧计算，系数在绑定时按帧长预计算（一阶指数，时间常数为 attack/release）
+ * - 超过 staleMs 没有新帧（例如不在采集的状态）时目标视为0，按释放时间衰减到最低亮度
+ *
+ * 声音到灯光的延迟 = 采集段长 + 最多一个灯效任务周期（发布不唤醒灯效任务）+ 起音包络，
+ * 综合测试中采集段为 16ms、灯效任务每个 LED 帧（LED_FRAME_MS = 10ms）运行一次、起音 5ms，
+ * 见 test_led_visualizer。
+ */
+
+#define LED_VIS_MAX_BINDINGS  4
+#define LED_VIS_QUEUE         8    // 发布队列长度（2的幂）
+
+enum LedVisSource : uint8_t {
+    LED_VIS_LEVEL,   // 全频带
+    LED_VIS_LOW,     // 低频
+    LED_VIS_HIGH     // 高频
+};
+
+struct LedVisStats {
+    uint32_t published;   // 发布成功的帧
+    uint32_t overflows;   // 队列满而丢弃的帧（消费者太慢）
+    uint32_t consumed;    // LED 端取出的帧
+    uint32_t frames;      // 包络计算的帧数
+    uint32_t lastAgeMs;   // 最近一次取到的帧在取出时的年龄
+};
+
+class LedVisualizer {
+public:
+    explicit LedVisualizer(LedAnimator& anim, uint16_t staleMs = 100);
+
+    // ========== 采集端 ==========
+
+    bool publish(const AudioLevelFrame& frame);
+
+    // ========== LED 端 ==========
+
+    /**
+     * 绑定输入图层
+     * @param floor 输出最低亮度等级（包络为0时的等级），包络满时为255
+     * @return 绑定编号，已满返回 -1
+     */
+    int8_t bind(int8_t layer, LedVisSource source, uint16_t attackMs, uint16_t releaseMs, uint8_t floor = 0);
+    void setEnabled(int8_t binding, bool enabled);
+
+    // 取最新帧，按动画帧率推进包络并写入图层（在 LedAnimator::update 之前调用）
+    void update(uint32_t nowMs);
+
+    uint8_t envelope(int8_t binding) const;
+    uint8_t output(int8_t binding) const;
+    const LedVisStats& stats() const { return _stats; }
+
+private:
+    struct Binding {
+        bool used;
+        bool enabled;
+        int8_t layer;
+        LedVisSource source;
+        uint8_t floor;
+        uint16_t attackK;    // 8.8 系数
+        uint16_t releaseK;
+        int32_t env88;
+    };
+
+    bool valid(int8_t binding) const { return binding >= 0 && binding < LED_VIS_MAX_BINDINGS && _bindings[binding].used; }
+    uint16_t coefficient(uint16_t tauMs) const;
+    uint8_t sourceLevel(LedVisSource source) const;
+
+    LedAnimator& _anim;
+    uint16_t _staleMs;
+    uint32_t _lastFrameMs;
+    bool _started;
+
+    SpscRing<AudioLevelFrame, LED_VIS_QUEUE> _queue;
+    AudioLevelFrame _latest;
+    bool _haveLatest;
+
+    Binding _bindings[LED_VIS_MAX_BINDINGS];
+    LedVisStats _stats;
+};
+
+#endif // LED_VISUALIZER_H
@@ -0,0 +1,101 @@
+#include "LedCompositor.h"
+#include <string.h>
+
+LedCompositor::LedCompositor(LedStrip& strip, uint32_t frameMs)
+    : _strip(strip), _frameMs(frameMs), _lastShowMs(0), _shown(false), _dirty(0), _zoneCount(0) {
+    _count = strip.numPixels();
+    if (_count > LED_MAX_PIXELS) _count = LED_MAX_PIXELS;
+
+    // 与后端初始状态（全黑）一致，不标记为脏
+    memset(_frame, 0, sizeof(_frame));
+    memset(_zones, 0, sizeof(_zones));
+    resetStats();
+}
+
+int8_t LedCompositor::defineZone(const char* name, uint16_t start, uint16_t count) {
+    if (_zoneCount >= LED_MAX_ZONES || count == 0 || start + count > _count) {
+        return -1;
+    }
+    _zones[_zoneCount].name = name;
+    _zones[_zoneCount].start = start;
+    _zones[_zoneCount].count = count;
+    return (int8_t)_zoneCount++;
+}
+
+int8_t LedCompositor::findZone(const char* name) const {
+    for (uint8_t i = 0; i < _zoneCount; i++) {
+        if (strcmp(_zones[i].name, name) == 0) {
+            return (int8_t)i;
+        }
+    }
+    return -1;
+}
+
+void LedCompositor::setPixel(uint16_t index, uint32_t color) {
+    if (index >= _count || _frame[index] == color) {
+        return;
+    }
+    _frame[index] = color;
+    _dirty |= 1UL << index;
+}
+
+void LedCompositor::fillZone(uint8_t zone, uint32_t color) {
+    if (zone >= _zoneCount) {
+        return;
+    }
+    const LedZone& z = _zones[zone];
+    for (uint16_t i = z.start; i < z.start + z.count; i++) {
+        setPixel(i, color);
+    }
+}
+
+void LedCompositor::fill(uint32_t color) {
+    for (uint16_t i = 0; i < _count; i++) {
+        setPixel(i, color);
+    }
+}
+
+void LedCompositor::send() {
+    // 后端保留上一帧内容，只需写入修改过的像素
+    uint32_t dirty = _dirty;
+    for (uint16_t i = 0; dirty != 0; i++, dirty >>= 1) {
+        if (dirty & 1) {
+            _strip.setPixelColor(i, _frame[i]);
+            _stats.pixelWrites++;
+        }
+    }
+    _dirty = 0;
+    _strip.show();
+    _stats.shows++;
+}
+
+bool LedCompositor::flush(uint32_t nowMs) {
+    _strip.poll();
+    if (_dirty == 0) {
+        _stats.cleanSkips++;
+        return false;
+    }
+    if (_shown && nowMs - _lastShowMs < _frameMs) {
+        _stats.deferred++;
+        return false;
+    }
+
+    send();
+    _lastShowMs = nowMs;
+    _shown = true;
+    return true;
+}
+
+bool LedCompositor::flushNow() {
+    _strip.poll();
+    if (_dirty == 0) {
+        _stats.cleanSkips++;
+        return false;
+    }
+    send();
+    return true;
+}
+
+void LedCompositor::resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
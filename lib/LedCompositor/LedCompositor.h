@@ -0,0 +1,90 @@
+#ifndef LED_COMPOSITOR_H
+#define LED_COMPOSITOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "LedStrip.h"
+
+/**
+ * LedCompositor - 带脏标记的 LED 帧合成器
+ *
+ * WS2812 的 show() 会关中断发送整条灯带，每次调用都会抖动 I2S 和舵机时序。
+ * 本模块把所有像素写入集中到一帧：
+ * - 像素按命名区域分组（如 eye = 0~1, body = 2~4），按区域填色
+ * - 每个像素单独记录脏标记，写入相同颜色不算修改
+ * - flush() 每帧（frameMs）最多调用一次 show()，且只在有修改时调用，
+ *   只把脏像素写给后端
+ *
+ * 用法：状态处理函数只写像素，loop() 末尾调用一次 flush(millis())。
+ */
+
+static const uint16_t LED_MAX_PIXELS = 32;
+static const uint8_t LED_MAX_ZONES = 4;
+static const uint32_t LED_FRAME_MS = 10;  // 100fps，与原 eyeBreathEffect 的最快节奏一致
+
+struct LedZone {
+    const char* name;
+    uint16_t start;
+    uint16_t count;
+};
+
+struct LedFlushStats {
+    uint32_t shows;         // 实际 show() 次数
+    uint32_t pixelWrites;   // 写给后端的像素数
+    uint32_t cleanSkips;    // 没有修改而跳过的 flush
+    uint32_t deferred;      // 同一帧内重复 flush 被推迟的次数
+};
+
+class LedCompositor {
+public:
+    explicit LedCompositor(LedStrip& strip, uint32_t frameMs = LED_FRAME_MS);
+
+    /**
+     * 定义区域
+     * @return 区域编号（按定义顺序从0开始），越界或区域已满返回 -1
+     */
+    int8_t defineZone(const char* name, uint16_t start, uint16_t count);
+    int8_t findZone(const char* name) const;
+    const LedZone& zone(uint8_t id) const { return _zones[id]; }
+    uint8_t zoneCount() const { return _zoneCount; }
+
+    void setPixel(uint16_t index, uint32_t color);
+    void fillZone(uint8_t zone, uint32_t color);
+    void fill(uint32_t color);
+
+    uint32_t pixel(uint16_t index) const { return index < _count ? _frame[index] : 0; }
+    uint16_t numPixels() const { return _count; }
+    bool isDirty() const { return _dirty != 0; }
+
+    /**
+     * 帧节拍 flush：有修改且距上次 show() 至少 frameMs 才发送
+     * @return 是否调用了 show()
+     */
+    bool flush(uint32_t nowMs);
+
+    // 立即发送（忽略帧节拍，仍然只在有修改时发送），用于启动动画等阻塞流程
+    bool flushNow();
+
+    void setFrameMs(uint32_t frameMs) { _frameMs = frameMs; }
+    const LedFlushStats& stats() const { return _stats; }
+    void resetStats();
+
+private:
+    void send();
+
+    LedStrip& _strip;
+    uint16_t _count;
+    uint32_t _frameMs;
+    uint32_t _lastShowMs;
+    bool _shown;
+
+    uint32_t _frame[LED_MAX_PIXELS];
+    uint32_t _dirty;  // 每个像素一位
+
+    LedZone _zones[LED_MAX_ZONES];
+    uint8_t _zoneCount;
+
+    LedFlushStats _stats;
+};
+
+#endif // LED_COMPOSITOR_H
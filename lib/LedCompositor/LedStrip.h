@@ -0,0 +1,43 @@
+#ifndef LED_STRIP_H
+#define LED_STRIP_H
+
+#include <stdint.h>
+
+/**
+ * LedStrip - LED 输出后端接口
+ *
+ * 颜色格式与 Adafruit_NeoPixel::Color() 相同：0x00RRGGBB。
+ * LedCompositor 只通过这个接口写像素，后端可以是 Adafruit_NeoPixel、
+ * AsyncLedStrip（RMT 非阻塞驱动，lib/LedDriver）或主机端 mock。
+ */
+
+class LedStrip {
+public:
+    virtual ~LedStrip() {}
+    virtual uint16_t numPixels() const = 0;
+    virtual void setPixelColor(uint16_t index, uint32_t color) = 0;
+    virtual void show() = 0;
+
+    // 周期性处理：异步后端在此启动因上一帧未发完而挂起的帧，同步后端无需处理
+    virtual void poll() {}
+};
+
+// 把任何带 numPixels()/setPixelColor()/show() 的类（如 Adafruit_NeoPixel）适配成 LedStrip
+template <typename Strip>
+class LedStripAdapter : public LedStrip {
+public:
+    explicit LedStripAdapter(Strip& strip) : _strip(strip) {}
+
+    uint16_t numPixels() const override { return _strip.numPixels(); }
+    void setPixelColor(uint16_t index, uint32_t color) override { _strip.setPixelColor(index, color); }
+    void show() override { _strip.show(); }
+
+private:
+    Strip& _strip;
+};
+
+static inline uint32_t ledColor(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+#endif // LED_STRIP_H
@@ -0,0 +1,116 @@
+#include "AsyncLedStrip.h"
+#include <string.h>
+#include "Trace.h"
+
+AsyncLedStrip::AsyncLedStrip(uint16_t count, LedWaveTransport& transport, const LedWaveTiming& timing)
+    : _transport(transport), _timing(timing), _brightness(0), _front(0), _pending(false) {
+    _count = count > LED_MAX_PIXELS ? LED_MAX_PIXELS : count;
+    memset(_pixels, 0, sizeof(_pixels));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+bool AsyncLedStrip::begin() {
+    return _transport.begin();
+}
+
+void AsyncLedStrip::setPixelColor(uint16_t index, uint32_t color) {
+    if (index < _count) {
+        _pixels[index] = color;
+    }
+}
+
+void AsyncLedStrip::clear() {
+    memset(_pixels, 0, sizeof(_pixels));
+}
+
+void AsyncLedStrip::encode(LedWaveItem* out) {
+    uint8_t grb[3];
+    size_t n = 0;
+    for (uint16_t i = 0; i < _count; i++) {
+        uint32_t c = _pixels[i];
+        uint8_t r = (uint8_t)(c >> 16);
+        uint8_t g = (uint8_t)(c >> 8);
+        uint8_t b = (uint8_t)c;
+        if (_brightness) {
+            r = (r * _brightness) >> 8;
+            g = (g * _brightness) >> 8;
+            b = (b * _brightness) >> 8;
+        }
+        grb[0] = g;
+        grb[1] = r;
+        grb[2] = b;
+        n += ledWaveEncodeBytes(grb, 3, _timing, out + n);
+    }
+    out[n] = ledWaveResetItem(_timing);
+}
+
+void AsyncLedStrip::show() {
+    TRACE_SCOPE("led_show");
+    _stats.shows++;
+
+    // 只有 _front 可能正在发送，另一个缓冲总是可以安全改写
+    if (_pending) {
+        _stats.superseded++;
+    }
+    encode(_wave[_front ^ 1]);
+    _pending = true;
+
+    if (_transport.busy()) {
+        _stats.queued++;
+        return;
+    }
+    poll();
+}
+
+void AsyncLedStrip::poll() {
+    if (!_pending || _transport.busy()) {
+        return;
+    }
+    _front ^= 1;
+    _pending = false;
+    _transport.transmit(_wave[_front], ledWaveItemCount(_count));
+    _stats.transmits++;
+}
+
+#ifdef ARDUINO
+RmtLedTransport::RmtLedTransport(int gpio, rmt_channel_t channel)
+    : _gpio(gpio), _channel(channel), _busy(false), _completed(0) {
+}
+
+bool RmtLedTransport::begin() {
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)_gpio, _channel);
+    config.clk_div = 2;          // 80MHz / 2 = 25ns/tick，与 WS2812_TIMING 一致
+    config.mem_block_num = 4;    // 4 × 48 项，5个LED的一帧全部放入 RMT 内存
+
+    esp_err_t err = rmt_config(&config);
+    if (err == ESP_OK) {
+        err = rmt_driver_install(_channel, 0, 0);
+    }
+    if (err != ESP_OK) {
+        Serial.printf("[ERROR] RMT LED驱动安装失败: %d\n", err);
+        return false;
+    }
+
+    // 发送结束回调是全局的，按通道分发（本工程只有一个 LED 通道）
+    rmt_register_tx_end_callback(onTxEnd, this);
+    return true;
+}
+
+void RmtLedTransport::transmit(const LedWaveItem* items, size_t count) {
+    _busy.store(true, std::memory_order_release);
+    // wait_tx_done = false：写入第一段后立即返回，其余由 RMT 中断补充
+    esp_err_t err = rmt_write_items(_channel, reinterpret_cast<const rmt_item32_t*>(items), count, false);
+    if (err != ESP_OK) {
+        _busy.store(false, std::memory_order_release);
+    }
+}
+
+void IRAM_ATTR RmtLedTransport::onTxEnd(rmt_channel_t channel, void* arg) {
+    RmtLedTransport* self = static_cast<RmtLedTransport*>(arg);
+    if (channel != self->_channel) {
+        return;
+    }
+    self->_completed.fetch_add(1, std::memory_order_relaxed);
+    self->_busy.store(false, std::memory_order_release);
+}
+#endif
@@ -0,0 +1,123 @@
+#ifndef ASYNC_LED_STRIP_H
+#define ASYNC_LED_STRIP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "LedStrip.h"
+#include "LedCompositor.h"
+#include "LedWaveform.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <driver/rmt.h>
+#endif
+
+/**
+ * AsyncLedStrip - 非阻塞 WS2812 输出（RMT）
+ *
+ * Adafruit_NeoPixel::show() 在调用核上关中断逐位发送，5个LED加复位约 450us，
+ * 期间 loop() 停住、I2S 中断被推迟。本驱动：
+ * - show() 只把像素编码成波形项交给发送器（RMT 硬件按波形自动输出），立即返回
+ * - 两个波形缓冲：一个正在发送，另一个用于编码下一帧，发送中的缓冲不会被改写
+ * - 上一帧还在发送时 show() 的帧先挂起，poll()（或下一次 show()）在发送完成后启动；
+ *   挂起期间再次 show() 只保留最新一帧
+ * - 发送完成由发送器的完成标志 / 计数给出（设备端在 RMT 发送结束中断里设置）
+ *
+ * 接口与 Adafruit_NeoPixel 保持一致（Color / setPixelColor / setBrightness / show），
+ * 并实现 LedStrip，可以直接交给 LedCompositor。
+ */
+
+#define LED_WAVE_MAX_ITEMS (LED_MAX_PIXELS * LED_WAVE_BITS_PER_PIXEL + 1)
+
+// 波形发送器：设备端 RmtLedTransport，主机端 RecordingLedTransport
+class LedWaveTransport {
+public:
+    virtual ~LedWaveTransport() {}
+    virtual bool begin() { return true; }
+
+    // 开始发送（不等待完成）；items 在发送完成前必须保持有效
+    virtual void transmit(const LedWaveItem* items, size_t count) = 0;
+
+    virtual bool busy() const = 0;
+    virtual uint32_t completedFrames() const = 0;
+};
+
+struct LedDriverStats {
+    uint32_t shows;        // show() 调用次数
+    uint32_t transmits;    // 实际开始发送的帧数
+    uint32_t queued;       // 因上一帧仍在发送而挂起的帧
+    uint32_t superseded;   // 挂起期间被更新帧替换、没有发出的帧
+};
+
+class AsyncLedStrip : public LedStrip {
+public:
+    AsyncLedStrip(uint16_t count, LedWaveTransport& transport, const LedWaveTiming& timing = WS2812_TIMING);
+
+    bool begin();
+
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) { return ledColor(r, g, b); }
+
+    uint16_t numPixels() const override { return _count; }
+    void setPixelColor(uint16_t index, uint32_t color) override;
+    void setPixelColor(uint16_t index, uint8_t r, uint8_t g, uint8_t b) { setPixelColor(index, ledColor(r, g, b)); }
+    uint32_t getPixelColor(uint16_t index) const { return index < _count ? _pixels[index] : 0; }
+    void clear();
+
+    // 与 Adafruit_NeoPixel 相同的缩放：输出 = 颜色 * (brightness + 1) >> 8，0 表示不缩放
+    void setBrightness(uint8_t brightness) { _brightness = brightness + 1; }
+    uint8_t getBrightness() const { return _brightness - 1; }
+
+    // 编码当前像素并开始发送（上一帧未完成时挂起），不阻塞
+    void show() override;
+
+    // 上一帧已完成且有挂起帧时开始发送
+    void poll() override;
+
+    // 是否有帧正在发送或挂起
+    bool busy() const { return _pending || _transport.busy(); }
+    uint32_t completedFrames() const { return _transport.completedFrames(); }
+
+    const LedDriverStats& stats() const { return _stats; }
+
+private:
+    void encode(LedWaveItem* out);
+
+    LedWaveTransport& _transport;
+    LedWaveTiming _timing;
+    uint16_t _count;
+    uint16_t _brightness;   // 0 = 不缩放（与 Adafruit 相同的存储方式）
+
+    uint32_t _pixels[LED_MAX_PIXELS];
+    LedWaveItem _wave[2][LED_WAVE_MAX_ITEMS];
+    uint8_t _front;         // 最近一次交给发送器的缓冲
+    bool _pending;          // 另一个缓冲里有等待发送的帧
+
+    LedDriverStats _stats;
+};
+
+#ifdef ARDUINO
+/**
+ * RMT 发送器（旧版 driver/rmt.h，与 I2S 驱动同一代 API）
+ * 5个LED的一帧（121项）装得进 4 个 RMT 内存块，发送过程中不需要中断补数据。
+ */
+class RmtLedTransport : public LedWaveTransport {
+public:
+    RmtLedTransport(int gpio, rmt_channel_t channel = RMT_CHANNEL_0);
+
+    bool begin() override;
+    void transmit(const LedWaveItem* items, size_t count) override;
+    bool busy() const override { return _busy.load(std::memory_order_acquire); }
+    uint32_t completedFrames() const override { return _completed.load(std::memory_order_acquire); }
+
+private:
+    static void onTxEnd(rmt_channel_t channel, void* arg);
+
+    int _gpio;
+    rmt_channel_t _channel;
+    std::atomic<bool> _busy;
+    std::atomic<uint32_t> _completed;
+};
+#endif
+
+#endif // ASYNC_LED_STRIP_H
@@ -0,0 +1,127 @@
+#ifndef LED_WAVEFORM_H
+#define LED_WAVEFORM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * LedWaveform - WS2812 波形编码 / 解码
+ *
+ * 每个数据位编码成一个波形项，格式与 ESP32 rmt_item32_t 相同：
+ *   bit0-14 duration0, bit15 level0, bit16-30 duration1, bit31 level1
+ * 数据位 = 高电平 duration0 + 低电平 duration1；帧尾追加一个全低电平的复位项。
+ * 发送顺序为 G, R, B，每字节高位在前（与 NEO_GRB 一致）。
+ *
+ * 编码在设备端写入 RMT 发送缓冲，主机端由 RecordingLedTransport 记录后解码校验。
+ */
+
+typedef uint32_t LedWaveItem;
+
+struct LedWaveTiming {
+    uint16_t t0h;          // 0码高电平（tick）
+    uint16_t t0l;          // 0码低电平
+    uint16_t t1h;          // 1码高电平
+    uint16_t t1l;          // 1码低电平
+    uint16_t resetTicks;   // 帧尾复位低电平（拆成两半放进一个波形项）
+    uint16_t toleranceTicks; // 解码时允许的高电平误差
+    uint32_t tickNs;       // 每个 tick 的纳秒数
+};
+
+// RMT 时钟：APB 80MHz / 2 = 40MHz，每 tick 25ns
+// WS2812B：T0H 0.4us, T0L 0.85us, T1H 0.8us, T1L 0.45us, 误差 ±150ns
+// 复位：新版 WS2812B-2020 要求 >280us，取 300us
+static const LedWaveTiming WS2812_TIMING = {16, 34, 32, 18, 12000, 6, 25};
+
+#define LED_WAVE_BITS_PER_PIXEL 24
+
+static inline LedWaveItem ledWaveItem(uint16_t duration0, uint8_t level0, uint16_t duration1, uint8_t level1) {
+    return (LedWaveItem)(duration0 & 0x7FFF) | ((LedWaveItem)(level0 & 1) << 15) |
+           ((LedWaveItem)(duration1 & 0x7FFF) << 16) | ((LedWaveItem)(level1 & 1) << 31);
+}
+
+static inline uint16_t ledWaveDuration0(LedWaveItem item) { return item & 0x7FFF; }
+static inline uint8_t ledWaveLevel0(LedWaveItem item) { return (item >> 15) & 1; }
+static inline uint16_t ledWaveDuration1(LedWaveItem item) { return (item >> 16) & 0x7FFF; }
+static inline uint8_t ledWaveLevel1(LedWaveItem item) { return (item >> 31) & 1; }
+
+// 一帧需要的波形项数（含复位项）
+static inline size_t ledWaveItemCount(uint16_t pixels) {
+    return (size_t)pixels * LED_WAVE_BITS_PER_PIXEL + 1;
+}
+
+/**
+ * 把 GRB 字节编码为波形项（不含复位项）
+ * @return 写入的波形项数
+ */
+static inline size_t ledWaveEncodeBytes(const uint8_t* bytes, size_t len, const LedWaveTiming& t, LedWaveItem* out) {
+    const LedWaveItem zero = ledWaveItem(t.t0h, 1, t.t0l, 0);
+    const LedWaveItem one = ledWaveItem(t.t1h, 1, t.t1l, 0);
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = bytes[i];
+        for (int bit = 0; bit < 8; bit++, b <<= 1) {
+            out[n++] = (b & 0x80) ? one : zero;
+        }
+    }
+    return n;
+}
+
+static inline LedWaveItem ledWaveResetItem(const LedWaveTiming& t) {
+    uint16_t half = t.resetTicks / 2;
+    return ledWaveItem(half, 0, t.resetTicks - half, 0);
+}
+
+// 波形总时长（纳秒）
+static inline uint32_t ledWaveDurationNs(const LedWaveItem* items, size_t count, const LedWaveTiming& t) {
+    uint32_t ticks = 0;
+    for (size_t i = 0; i < count; i++) {
+        ticks += ledWaveDuration0(items[i]) + ledWaveDuration1(items[i]);
+    }
+    return ticks * t.tickNs;
+}
+
+/**
+ * 解码波形（校验用）
+ * 每个数据项必须是"高-低"且高电平落在 0码/1码误差范围内，最后一项必须是足够长的复位
+ * @return 解码出的字节数，波形不合法返回 -1
+ */
+static inline int ledWaveDecode(const LedWaveItem* items, size_t count, const LedWaveTiming& t,
+                                uint8_t* bytes, size_t maxBytes) {
+    if (count == 0 || (count - 1) % 8 != 0 || (count - 1) / 8 > maxBytes) {
+        return -1;
+    }
+
+    LedWaveItem reset = items[count - 1];
+    if (ledWaveLevel0(reset) != 0 || ledWaveLevel1(reset) != 0 ||
+        ledWaveDuration0(reset) + ledWaveDuration1(reset) < t.resetTicks) {
+        return -1;
+    }
+
+    size_t len = (count - 1) / 8;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = 0;
+        for (int bit = 0; bit < 8; bit++) {
+            LedWaveItem item = items[i * 8 + bit];
+            if (ledWaveLevel0(item) != 1 || ledWaveLevel1(item) != 0) {
+                return -1;
+            }
+            int high = ledWaveDuration0(item);
+            int period = high + ledWaveDuration1(item);
+            int nominal = t.t0h + t.t0l;
+            if (period < nominal - 2 * t.toleranceTicks || period > nominal + 2 * t.toleranceTicks) {
+                return -1;
+            }
+
+            b <<= 1;
+            if (high >= t.t1h - t.toleranceTicks && high <= t.t1h + t.toleranceTicks) {
+                b |= 1;
+            } else if (high < t.t0h - t.toleranceTicks || high > t.t0h + t.toleranceTicks) {
+                return -1;
+            }
+        }
+        bytes[i] = b;
+    }
+    return (int)len;
+}
+
+#endif // LED_WAVEFORM_H
@@ -0,0 +1,69 @@
+#ifndef RECORDING_LED_TRANSPORT_H
+#define RECORDING_LED_TRANSPORT_H
+
+#include <stdint.h>
+#include <vector>
+#include "AsyncLedStrip.h"
+
+/**
+ * RecordingLedTransport - 主机端波形记录发送器
+ *
+ * 代替 RMT 硬件：记录每一帧交给 transmit() 的波形，并模拟"发送中"状态。
+ * - autoComplete = true：transmit() 后立即完成（相当于发送足够快）
+ * - autoComplete = false：保持 busy，直到测试调用 complete()，用于验证双缓冲/挂起逻辑
+ *
+ * 记录时会检查发送中的缓冲在 complete() 之前是否被改写（双缓冲是否生效）。
+ */
+class RecordingLedTransport : public LedWaveTransport {
+public:
+    explicit RecordingLedTransport(bool autoComplete = true)
+        : _autoComplete(autoComplete), _busy(false), _completed(0), _inFlight(nullptr),
+          _inFlightCount(0), _corrupted(0) {}
+
+    void transmit(const LedWaveItem* items, size_t count) override {
+        frames.push_back(std::vector<LedWaveItem>(items, items + count));
+        _inFlight = items;
+        _inFlightCount = count;
+        _busy = true;
+        if (_autoComplete) {
+            complete();
+        }
+    }
+
+    bool busy() const override { return _busy; }
+    uint32_t completedFrames() const override { return _completed; }
+
+    // 模拟 RMT 发送结束中断
+    void complete() {
+        if (!_busy) {
+            return;
+        }
+        // 发送期间缓冲必须保持不变
+        const std::vector<LedWaveItem>& sent = frames.back();
+        for (size_t i = 0; i < _inFlightCount; i++) {
+            if (_inFlight[i] != sent[i]) {
+                _corrupted++;
+                break;
+            }
+        }
+        _busy = false;
+        _completed++;
+    }
+
+    void setAutoComplete(bool autoComplete) { _autoComplete = autoComplete; }
+
+    // 发送期间被改写的帧数（应为0）
+    uint32_t corruptedFrames() const { return _corrupted; }
+
+    std::vector<std::vector<LedWaveItem>> frames;
+
+private:
+    bool _autoComplete;
+    bool _busy;
+    uint32_t _completed;
+    const LedWaveItem* _inFlight;
+    size_t _inFlightCount;
+    uint32_t _corrupted;
+};
+
+#endif // RECORDING_LED_TRANSPORT_H
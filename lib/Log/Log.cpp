@@ -0,0 +1,357 @@
+#include "Log.h"
+#include <stdio.h>
+#include "Telemetry.h"
+
+LogRing logRing;
+
+LogRing::LogRing()
+    : _next(0), _read(0), _lost(0), _readCount(0), _formatCount(0), _seq(0), _pendingValid(false) {
+    for (Slot& s : _slots) {
+        // 初始序号不等于任何下标 + 1 附近的值：读取方看作"尚未写入"
+        s.seq.store(0xFFFFFFFFu - LOG_RING_SIZE, std::memory_order_relaxed);
+        s.format.store(nullptr, std::memory_order_relaxed);
+        s.timeMs.store(0, std::memory_order_relaxed);
+        s.meta.store(0, std::memory_order_relaxed);
+        for (uint8_t i = 0; i < LOG_MAX_ARGS; i++) {
+            s.args[i].store(0, std::memory_order_relaxed);
+        }
+    }
+    memset(_formats, 0, sizeof(_formats));
+    memset(&_pending, 0, sizeof(_pending));
+}
+
+// ========== 写入 ==========
+
+void LogRing::append(uint8_t level, const char* format, const LogArg* args, uint8_t argc) {
+    uint32_t meta = (uint32_t)(level & 0x07) | ((uint32_t)argc << 3);
+    for (uint8_t i = 0; i < argc; i++) {
+        meta |= (uint32_t)(args[i].type & 0x07) << (6 + 3 * i);
+    }
+
+    uint32_t index = _next.fetch_add(1, std::memory_order_relaxed);
+    Slot& s = _slots[index & (LOG_RING_SIZE - 1)];
+    // 序号协议与 TraceRing 相同：写入中为 index，写完为 index + 1
+    s.seq.store(index, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.format.store(format, std::memory_order_relaxed);
+    s.timeMs.store(logMillis(), std::memory_order_relaxed);
+    s.meta.store(meta, std::memory_order_relaxed);
+    for (uint8_t i = 0; i < argc; i++) {
+        s.args[i].store(args[i].value, std::memory_order_relaxed);
+    }
+    s.seq.store(index + 1, std::memory_order_release);
+}
+
+// ========== 读取 ==========
+
+size_t LogRing::drain(LogRecord* out, size_t maxCount) {
+    uint32_t head = _next.load(std::memory_order_acquire);
+
+    // 落后超过一圈：最旧的记录已被覆盖
+    if (head - _read > LOG_RING_SIZE) {
+        _lost.fetch_add(head - _read - LOG_RING_SIZE, std::memory_order_relaxed);
+        _read = head - LOG_RING_SIZE;
+    }
+
+    size_t n = 0;
+    while (_read != head && n < maxCount) {
+        const Slot& s = _slots[_read & (LOG_RING_SIZE - 1)];
+        uint32_t expect = _read + 1;
+        uint32_t seq1 = s.seq.load(std::memory_order_acquire);
+        if (seq1 != expect) {
+            if ((int32_t)(seq1 - expect) > 0) {
+                // 已被下一圈覆盖
+                _lost.fetch_add(1, std::memory_order_relaxed);
+                _read++;
+                continue;
+            }
+            break;   // 写入方已占位但还没写完，下次再取
+        }
+
+        LogRecord r;
+        r.format = s.format.load(std::memory_order_relaxed);
+        r.timeMs = s.timeMs.load(std::memory_order_relaxed);
+        uint32_t meta = s.meta.load(std::memory_order_relaxed);
+        r.level = (uint8_t)(meta & 0x07);
+        r.argc = (uint8_t)((meta >> 3) & 0x07);
+        if (r.argc > LOG_MAX_ARGS) {
+            r.argc = LOG_MAX_ARGS;
+        }
+        for (uint8_t i = 0; i < LOG_MAX_ARGS; i++) {
+            r.types[i] = (uint8_t)((meta >> (6 + 3 * i)) & 0x07);
+            r.args[i] = i < r.argc ? s.args[i].load(std::memory_order_relaxed) : 0;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t seq2 = s.seq.load(std::memory_order_relaxed);
+        _read++;
+        if (seq2 != seq1) {
+            // 读取过程中被覆盖，内容可能不完整
+            _lost.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        out[n++] = r;
+    }
+    _readCount.store(_readCount.load(std::memory_order_relaxed) + (uint32_t)n, std::memory_order_relaxed);
+    return n;
+}
+
+LogStats LogRing::stats() const {
+    LogStats st;
+    st.written = _next.load(std::memory_order_relaxed);
+    st.read = _readCount.load(std::memory_order_relaxed);
+    st.lost = _lost.load(std::memory_order_relaxed);
+    return st;
+}
+
+// ========== 格式化 ==========
+
+char LogRing::levelChar(uint8_t level) {
+    static const char chars[] = "-EWIDV";
+    return level <= LOG_LEVEL_VERBOSE ? chars[level] : '?';
+}
+
+// 在 out[len] 处追加 snprintf 的结果，截断时 len 停在 capacity - 1
+#define LOG_APPEND(...) do { \
+        int _n = snprintf(out + len, capacity - len, __VA_ARGS__); \
+        if (_n > 0) len += (size_t)_n < capacity - len ? (size_t)_n : capacity - len - 1; \
+    } while (0)
+
+size_t LogRing::formatRecord(const LogRecord& record, char* out, size_t capacity) {
+    if (capacity == 0) {
+        return 0;
+    }
+    size_t len = 0;
+    out[0] = '\0';
+    const char* p = record.format != nullptr ? record.format : "(null)";
+    uint8_t argIndex = 0;
+
+    while (*p != '\0' && len + 1 < capacity) {
+        if (*p != '%') {
+            out[len++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[len++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // 转换说明：标志、宽度、精度原样保留，长度修饰按保存的类型重新给出
+        char spec[24];
+        size_t specLen = 0;
+        const char* start = p;
+        spec[specLen++] = *p++;
+        while (*p != '\0' && strchr("-+ #0123456789.", *p) != nullptr && specLen < sizeof(spec) - 4) {
+            spec[specLen++] = *p++;
+        }
+        bool longModifier = false;
+        while (*p != '\0' && strchr("hlLqjzt", *p) != nullptr) {
+            if (*p == 'l' || *p == 'j' || *p == 'z' || *p == 't' || *p == 'q') {
+                longModifier = true;
+            }
+            p++;
+        }
+        char conv = *p;
+        if (conv == '\0' || conv == '*' || argIndex >= record.argc) {
+            // 不支持或参数不够：原样输出
+            size_t n = (size_t)(p - start) + (conv != '\0' ? 1 : 0);
+            LOG_APPEND("%.*s", (int)n, start);
+            p = start + n;
+            continue;
+        }
+        p++;
+
+        uint8_t type = record.types[argIndex];
+        uintptr_t raw = record.args[argIndex++];
+        double number;
+        if (type == LOG_ARG_FLOAT) {
+            uint32_t bits = (uint32_t)raw;
+            float f;
+            memcpy(&f, &bits, sizeof(f));
+            number = f;
+        } else if (type == LOG_ARG_INT) {
+            number = (double)(intptr_t)raw;
+        } else {
+            number = (double)raw;
+        }
+
+        switch (conv) {
+            case 'd':
+            case 'i': {
+                long long v = type == LOG_ARG_FLOAT ? (long long)number
+                            : type == LOG_ARG_INT ? (long long)(intptr_t)raw : (long long)raw;
+                memcpy(spec + specLen, "lld", 4);
+                LOG_APPEND(spec, v);
+                break;
+            }
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o': {
+                unsigned long long v;
+                if (type == LOG_ARG_FLOAT) {
+                    v = (unsigned long long)(long long)number;
+                } else if (type == LOG_ARG_INT && !longModifier) {
+                    v = (unsigned int)(intptr_t)raw;   // 与 printf 相同：负的 int 按 32 位无符号输出
+                } else {
+                    v = type == LOG_ARG_INT ? (unsigned long long)(long long)(intptr_t)raw : (unsigned long long)raw;
+                }
+                spec[specLen] = 'l';
+                spec[specLen + 1] = 'l';
+                spec[specLen + 2] = conv;
+                spec[specLen + 3] = '\0';
+                LOG_APPEND(spec, v);
+                break;
+            }
+            case 'c':
+                memcpy(spec + specLen, "c", 2);
+                LOG_APPEND(spec, (int)raw);
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                spec[specLen] = conv;
+                spec[specLen + 1] = '\0';
+                LOG_APPEND(spec, number);
+                break;
+            case 's':
+                memcpy(spec + specLen, "s", 2);
+                if (type == LOG_ARG_STR || type == LOG_ARG_PTR) {
+                    const char* str = (const char*)raw;
+                    LOG_APPEND(spec, str != nullptr ? str : "(null)");
+                } else {
+                    LOG_APPEND(spec, "?");
+                }
+                break;
+            case 'p':
+                memcpy(spec + specLen, "p", 2);
+                LOG_APPEND(spec, (void*)raw);
+                break;
+            default: {
+                size_t n = (size_t)(p - start);
+                LOG_APPEND("%.*s", (int)n, start);
+                break;
+            }
+        }
+    }
+    out[len] = '\0';
+    return len;
+}
+
+size_t LogRing::formatNext(char* out, size_t capacity) {
+    if (capacity == 0) {
+        return 0;
+    }
+    LogRecord r;
+    if (drain(&r, 1) == 0) {
+        out[0] = '\0';
+        return 0;
+    }
+    size_t len = 0;
+    LOG_APPEND("%lu.%03lu %c ", (unsigned long)(r.timeMs / 1000), (unsigned long)(r.timeMs % 1000),
+               levelChar(r.level));
+    return len + formatRecord(r, out + len, capacity - len);
+}
+
+#undef LOG_APPEND
+
+// ========== 二进制导出 ==========
+
+void LogRing::resendFormats() {
+    _formatCount = 0;
+}
+
+uint16_t LogRing::formatId(const char* format, bool* isNew) {
+    *isNew = false;
+    for (uint16_t i = 0; i < _formatCount; i++) {
+        if (_formats[i] == format) {
+            return i;
+        }
+    }
+    if (_formatCount >= LOG_MAX_FORMATS) {
+        return LOG_NO_FORMAT;
+    }
+    _formats[_formatCount] = format;
+    *isNew = true;
+    return _formatCount++;
+}
+
+// 记录帧载荷：编号 u16, 级别 u8, 参数个数 u8, 每个参数：类型 u8 + 值 u32（字符串为长度 u8 + 字节）
+size_t LogRing::encodeRecord(const LogRecord& record, uint16_t id, uint8_t* payload) {
+    size_t n = 0;
+    payload[n++] = (uint8_t)id;
+    payload[n++] = (uint8_t)(id >> 8);
+    payload[n++] = record.level;
+    payload[n++] = record.argc;
+    for (uint8_t i = 0; i < record.argc; i++) {
+        payload[n++] = record.types[i];
+        if (record.types[i] == LOG_ARG_STR) {
+            const char* str = (const char*)record.args[i];
+            if (str == nullptr) {
+                str = "(null)";
+            }
+            size_t len = strnlen(str, LOG_STRING_MAX);
+            payload[n++] = (uint8_t)len;
+            memcpy(payload + n, str, len);
+            n += len;
+        } else {
+            uint32_t v = (uint32_t)record.args[i];
+            payload[n++] = (uint8_t)v;
+            payload[n++] = (uint8_t)(v >> 8);
+            payload[n++] = (uint8_t)(v >> 16);
+            payload[n++] = (uint8_t)(v >> 24);
+        }
+    }
+    return n;
+}
+
+size_t LogRing::exportFrames(uint8_t* out, size_t capacity) {
+    if (capacity < 2) {
+        return 0;
+    }
+    out[0] = 0x00;   // 与之前的串口文本分开
+    size_t len = 1;
+    uint8_t payload[TELEMETRY_FRAME_PAYLOAD_MAX];
+
+    while (true) {
+        if (!_pendingValid) {
+            if (drain(&_pending, 1) == 0) {
+                break;
+            }
+            _pendingValid = true;
+        }
+
+        bool isNew;
+        uint16_t id = formatId(_pending.format, &isNew);
+        if (isNew) {
+            size_t flen = strnlen(_pending.format, sizeof(payload) - 2);
+            payload[0] = (uint8_t)id;
+            payload[1] = (uint8_t)(id >> 8);
+            memcpy(payload + 2, _pending.format, flen);
+            size_t n = TelemetryChannel::encodeFrame(out + len, capacity - len, TELEMETRY_TYPE_LOG_FORMAT, _seq,
+                                                     0, payload, 2 + flen);
+            if (n == 0) {
+                _formatCount--;   // 下一批重新登记
+                break;
+            }
+            _seq++;
+            len += n;
+        }
+
+        size_t plen = encodeRecord(_pending, id, payload);
+        size_t n = TelemetryChannel::encodeFrame(out + len, capacity - len, TELEMETRY_TYPE_LOG, _seq,
+                                                 _pending.timeMs, payload, plen);
+        if (n == 0) {
+            break;
+        }
+        _seq++;
+        len += n;
+        _pendingValid = false;
+    }
+    return len > 1 ? len : 0;
+}
@@ -0,0 +1,226 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * Log - 延迟格式化的分级日志（编译期去掉关闭的级别）
+ *
+ * 原来运行中的消息都直接 Serial.printf：没有级别，格式化和串口发送都在调用的任务中完成，
+ * 没人看串口时也照样花时间。本模块：
+ * - LOG_ERROR / LOG_WARN / LOG_INFO / LOG_DEBUG / LOG_VERBOSE，格式与 printf 相同（编译器检查格式和参数）
+ * - 编译开关 LOG_LEVEL：高于它的级别展开为空，参数不求值，格式串也不进固件
+ * - 打开的调用只把格式串指针、时间和原始参数（最多 LOG_MAX_ARGS 个）写入全局环形缓冲 logRing，不格式化；
+ *   多个任务（含不同核）可以同时写，写满后覆盖最旧的记录，读取方发现被覆盖时计入 lost
+ * - 格式化推迟到低优先级任务：formatNext() 逐条格式化为文本行；
+ *   或者 exportFrames() 编码为与 lib/Telemetry 相同的 COBS 帧（格式串只发一次），
+ *   由 tools/telemetry_decode.py 在主机上格式化
+ *
+ * 参数的限制（因为格式化发生在之后）：
+ * - 字符串（%s）只保存指针，必须是常量字符串或一直有效的字符串（状态名、音效名），不能是栈上的缓冲
+ * - 浮点数按 float 保存（约 7 位有效数字）
+ * - 整数最多为指针宽度（设备端 32 位），设备端不支持 64 位整数；不支持 '*' 宽度
+ */
+
+#define LOG_LEVEL_NONE     0
+#define LOG_LEVEL_ERROR    1
+#define LOG_LEVEL_WARN     2
+#define LOG_LEVEL_INFO     3
+#define LOG_LEVEL_DEBUG    4
+#define LOG_LEVEL_VERBOSE  5
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE 128   // 记录数（2的幂），设备端每条在环中占 40 字节
+#endif
+
+#define LOG_MAX_ARGS     6
+#define LOG_MAX_FORMATS  128   // exportFrames() 的格式串表容量
+#define LOG_STRING_MAX   32    // exportFrames() 中 %s 参数最多发送的字节数
+#define LOG_NO_FORMAT    0xFFFF
+
+enum LogArgType : uint8_t {
+    LOG_ARG_INT = 0,
+    LOG_ARG_UINT = 1,
+    LOG_ARG_FLOAT = 2,    // float 的位模式
+    LOG_ARG_STR = 3,      // const char*
+    LOG_ARG_PTR = 4       // 其他指针
+};
+
+struct LogArg {
+    uintptr_t value;
+    uint8_t type;
+};
+
+struct LogRecord {
+    const char* format;
+    uint32_t timeMs;
+    uint8_t level;
+    uint8_t argc;
+    uint8_t types[LOG_MAX_ARGS];
+    uintptr_t args[LOG_MAX_ARGS];
+};
+
+struct LogStats {
+    uint32_t written;    // 写入的记录
+    uint32_t read;       // 格式化或导出的记录
+    uint32_t lost;       // 读取前被覆盖的记录
+};
+
+inline uint32_t logMillis() {
+#ifdef ARDUINO
+    return millis();
+#else
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// ========== 参数打包（按类型重载，只保存原始值和类型） ==========
+
+inline LogArg logArg(int v) { return {(uintptr_t)(intptr_t)v, LOG_ARG_INT}; }
+inline LogArg logArg(long v) { return {(uintptr_t)(intptr_t)v, LOG_ARG_INT}; }
+inline LogArg logArg(unsigned int v) { return {(uintptr_t)v, LOG_ARG_UINT}; }
+inline LogArg logArg(unsigned long v) { return {(uintptr_t)v, LOG_ARG_UINT}; }
+inline LogArg logArg(double v) {
+    float f = (float)v;
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return {(uintptr_t)bits, LOG_ARG_FLOAT};
+}
+inline LogArg logArg(const char* v) { return {(uintptr_t)v, LOG_ARG_STR}; }
+inline LogArg logArg(const void* v) { return {(uintptr_t)v, LOG_ARG_PTR}; }
+
+// 只用于编译器检查格式串和参数（在 if (0) 中调用，不生成代码）
+inline void logFormatCheck(const char*, ...) __attribute__((format(printf, 1, 2)));
+inline void logFormatCheck(const char*, ...) {}
+
+class LogRing {
+public:
+    LogRing();
+
+    // 写一条记录（任意任务/线程可同时调用，不阻塞），由 LOG_* 宏调用
+    template <typename... Args>
+    void write(uint8_t level, const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "日志参数超过 LOG_MAX_ARGS");
+        const LogArg packed[] = {logArg(args)..., LogArg{0, 0}};
+        append(level, format, packed, (uint8_t)sizeof...(Args));
+    }
+
+    void append(uint8_t level, const char* format, const LogArg* args, uint8_t argc);
+
+    /**
+     * 取出最多 maxCount 条新记录（从早到晚，只能在一个任务中调用）
+     * 正在写入的记录留到下一次；已被覆盖的记录计入 lost
+     */
+    size_t drain(LogRecord* out, size_t maxCount);
+
+    /**
+     * 取出一条记录并格式化为一行文本："秒.毫秒 级别 消息"（不含换行）
+     * 只能在一个任务中调用（与 drain 相同）
+     * @return 行的长度，没有新记录时为 0
+     */
+    size_t formatNext(char* out, size_t capacity);
+
+    /**
+     * 导出为 COBS 帧（帧格式见 lib/Telemetry）：新的格式串先发一个格式帧，记录帧中只有编号和参数，
+     * %s 参数按内容发送。尽量填满 capacity，每批前有一个 0x00；循环调用直到返回 0
+     * 只能在一个任务中调用（与 drain 相同）
+     * @return 写入的字节数，没有新记录时为 0
+     */
+    size_t exportFrames(uint8_t* out, size_t capacity);
+
+    // 下一次 exportFrames() 重新发送格式串（开始新的抓包时）
+    void resendFormats();
+
+    LogStats stats() const;
+
+    /**
+     * 按记录中的格式串和参数格式化消息（不含时间和级别）
+     * @return 写入的长度（截断到 capacity - 1）
+     */
+    static size_t formatRecord(const LogRecord& record, char* out, size_t capacity);
+
+    static char levelChar(uint8_t level);
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq;
+        std::atomic<const char*> format;
+        std::atomic<uint32_t> timeMs;
+        std::atomic<uint32_t> meta;   // 级别 | 参数个数 << 3 | 类型（每个 3 位）<< 6
+        std::atomic<uintptr_t> args[LOG_MAX_ARGS];
+    };
+
+    uint16_t formatId(const char* format, bool* isNew);
+    size_t encodeRecord(const LogRecord& record, uint16_t id, uint8_t* payload);
+
+    Slot _slots[LOG_RING_SIZE];
+    std::atomic<uint32_t> _next;
+    uint32_t _read;                   // 只由读取方使用
+    std::atomic<uint32_t> _lost;      // 由读取方写，stats() 可在其他任务中读
+    std::atomic<uint32_t> _readCount;
+
+    // 导出状态（只由读取方使用）
+    const char* _formats[LOG_MAX_FORMATS];
+    uint16_t _formatCount;
+    uint8_t _seq;
+    bool _pendingValid;               // 上一批放不下的记录
+    LogRecord _pending;
+
+    static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE 必须是2的幂");
+};
+
+extern LogRing logRing;
+
+// ========== 宏（高于 LOG_LEVEL 的级别展开为空） ==========
+
+#define LOG_AT(level, ...) do { \
+        if (0) logFormatCheck(__VA_ARGS__); \
+        logRing.write(level, __VA_ARGS__); \
+    } while (0)
+#define LOG_DISABLED(...) do { if (0) logFormatCheck(__VA_ARGS__); } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#define LOG_VERBOSE(...) LOG_AT(LOG_LEVEL_VERBOSE, __VA_ARGS__)
+#else
+#define LOG_VERBOSE(...) LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#endif // LOG_H
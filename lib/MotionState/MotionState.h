@@ -0,0 +1,61 @@
+#ifndef MOTION_STATE_H
+#define MOTION_STATE_H
+
+#include <stdint.h>
+
+/**
+ * MotionState - 运动层向音频链路发布的舵机运动状态
+ *
+ * smoothMove() 开始时调用 beginMove()，结束时调用 endMove()；
+ * 音频链路每帧调用 state(now) 取得当前是否在运动以及指令速度。
+ *
+ * 运动结束后仍按 settleMs 视为"运动中"：
+ * - I2S DMA 缓冲（4 × 256 帧 ≈ 64ms）中还有运动期间采到的声音
+ * - 舵机到位后齿轮还有短暂的抖动和回差声
+ *
+ * 纯数据，无硬件依赖，可在主机上测试。
+ */
+
+struct MotionState {
+    bool moving;          // 运动中（含结束后的 settle 窗口）
+    float velocityDps;    // 指令角速度（°/s），静止时为0
+};
+
+class MotionTracker {
+public:
+    static const uint32_t DEFAULT_SETTLE_MS = 100;
+
+    explicit MotionTracker(uint32_t settleMs = DEFAULT_SETTLE_MS)
+        : _settleMs(settleMs), _velocityDps(0), _endMs(0), _active(false), _everMoved(false) {}
+
+    void beginMove(float velocityDps) {
+        _velocityDps = velocityDps;
+        _active = true;
+        _everMoved = true;
+    }
+
+    void endMove(uint32_t nowMs) {
+        _active = false;
+        _endMs = nowMs;
+    }
+
+    MotionState state(uint32_t nowMs) const {
+        MotionState s = { false, 0 };
+        if (_active || (_everMoved && nowMs - _endMs < _settleMs)) {
+            s.moving = true;
+            s.velocityDps = _velocityDps;
+        }
+        return s;
+    }
+
+    void setSettleMs(uint32_t settleMs) { _settleMs = settleMs; }
+
+private:
+    uint32_t _settleMs;
+    float _velocityDps;
+    uint32_t _endMs;
+    bool _active;
+    bool _everMoved;
+};
+
+#endif // MOTION_STATE_H
@@ -0,0 +1,163 @@
+#ifndef OLED_SCREENS_H
+#define OLED_SCREENS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * OledScreens - OLED 测试界面的绘制（设备与主机共用）
+ *
+ * test_oled_display.cpp 各测试界面的绘制部分提取到这里，设备端画到 U8g2，主机端画到 HostU8g2
+ * （lib/HostDisplay），用于快照和金样图像比较，布局改动在主机上就能看到结果。
+ *
+ * - D：U8g2 兼容显示（setFont / setDrawColor / drawLine / drawBox / drawFrame / drawStr）
+ * - Text：中文绘制 int text(int x, int y, const char* str)，y 为基线，返回步进宽度
+ *   （设备端为 drawText：预渲染标签或 GlyphCache）
+ *
+ * 函数只画图，不调用 clearBuffer() / sendBuffer()，由调用方决定何时清屏和发送。
+ */
+
+// 界面用到的两种字体
+struct OledFonts {
+    const uint8_t* text;     // u8g2_font_wqy14_t_gb2312
+    const uint8_t* digits;   // u8g2_font_logisoso16_tr
+};
+
+// 启动画面
+template <class D, class Text>
+void oledDrawBoot(D& d, const OledFonts& f, Text text) {
+    d.setFont(f.text);
+    text(20, 25, "MOSS终端");
+    text(25, 45, "初始化中");
+}
+
+// 测试 1：基础中文显示
+template <class D, class Text>
+void oledDrawBasicChinese(D& d, const OledFonts& f, Text text) {
+    d.setFont(f.text);
+    text(10, 14, "你好世界");
+    text(10, 30, "MOSS终端");
+    text(10, 46, "中文测试");
+    text(10, 62, "显示正常");
+}
+
+// 测试 2：系统状态
+template <class D, class Text>
+void oledDrawSystemStatus(D& d, const OledFonts& f, Text text) {
+    d.setFont(f.text);
+    text(30, 13, "系统状态");
+    d.drawLine(0, 15, 128, 15);
+    text(5, 31, "运行:00:05:23");
+    text(5, 47, "内存:45%");
+    text(5, 61, "温度:42°C");
+}
+
+// 测试 3：菜单
+template <class D, class Text>
+void oledDrawMenu(D& d, const OledFonts& f, Text text) {
+    d.setFont(f.text);
+    text(35, 13, "主菜单");
+    d.drawLine(0, 15, 128, 15);
+    text(5, 31, ">1.开始对话");
+    text(5, 47, " 2.系统设置");
+    text(5, 61, " 3.关于MOSS");
+}
+
+// 测试 4：中英文混合
+template <class D, class Text>
+void oledDrawMixedText(D& d, const OledFonts& f, Text text) {
+    d.setFont(f.text);
+    text(5, 13, "状态:待机中");
+    text(5, 29, "音量:75%");
+    text(5, 45, "温度:28°C");
+    text(5, 61, "WiFi:已连接");
+}
+
+// 测试 5：进度条标题（只画一次）
+template <class D, class Text>
+void oledDrawLoadingTitle(D& d, const OledFonts& f, Text text) {
+    d.setFont(f.text);
+    text(35, 13, "加载中");
+}
+
+// 测试 5：进度条（清除标题以下区域后重画）
+template <class D>
+void oledDrawProgress(D& d, const OledFonts& f, int progress) {
+    d.setDrawColor(0);
+    d.drawBox(0, 20, 128, 44);
+    d.setDrawColor(1);
+
+    d.drawFrame(10, 25, 108, 15);
+    int barWidth = (progress * 104) / 100;
+    d.drawBox(12, 27, barWidth, 11);
+
+    char buf[10];
+    snprintf(buf, sizeof(buf), "%d%%", progress);
+    d.setFont(f.text);
+    d.drawStr(55, 55, buf);
+}
+
+// 测试 5：加载完成
+template <class D, class Text>
+void oledDrawLoaded(D& d, const OledFonts& f, Text text) {
+    d.setFont(f.text);
+    text(30, 35, "加载完成");
+}
+
+// 测试 6：音量标题（只画一次）
+template <class D, class Text>
+void oledDrawVolumeTitle(D& d, const OledFonts& f, Text text) {
+    d.setFont(f.text);
+    text(48, 13, "音量");
+}
+
+// 测试 6：音量条（清除标题以下区域后重画 10 根竖条）
+template <class D>
+void oledDrawVolume(D& d, const OledFonts& f, int vol) {
+    d.setDrawColor(0);
+    d.drawBox(0, 15, 128, 49);
+    d.setDrawColor(1);
+
+    int barHeight = (vol * 40) / 100;
+    for (int i = 0; i < 10; i++) {
+        int x = 10 + i * 11;
+        int h = (barHeight * (i + 1)) / 10;
+        d.drawBox(x, 54 - h, 8, h);
+    }
+
+    char buf[10];
+    snprintf(buf, sizeof(buf), "%d%%", vol);
+    d.setFont(f.text);
+    d.drawStr(55, 61, buf);
+}
+
+// 测试 9：时钟
+template <class D, class Text>
+void oledDrawClock(D& d, const OledFonts& f, Text text, int sec) {
+    d.setFont(f.text);
+    text(40, 13, "时钟");
+    d.drawLine(0, 15, 128, 15);
+
+    char timeStr[20];
+    snprintf(timeStr, sizeof(timeStr), "00:00:%02d", sec);
+    d.setFont(f.digits);
+    d.drawStr(25, 45, timeStr);
+}
+
+// 测试 0：仪表盘
+template <class D, class Text>
+void oledDrawDashboard(D& d, const OledFonts& f, Text text) {
+    d.setFont(f.text);
+    text(30, 13, "仪表盘");
+    d.drawLine(0, 15, 128, 15);
+
+    text(5, 31, "CPU:45%");
+    d.drawBox(60, 22, 45, 8);
+
+    text(5, 47, "内存:67%");
+    d.drawBox(60, 38, 67, 8);
+
+    text(5, 61, "温度:42°C");
+}
+
+#endif // OLED_SCREENS_H
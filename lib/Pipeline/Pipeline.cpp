@@ -0,0 +1,245 @@
+#include "Pipeline.h"
+
+Pipeline::Pipeline() : _stageCount(0), _queueCount(0), _running(false) {
+#ifdef ARDUINO
+    _alive.store(0);
+#endif
+    for (uint8_t i = 0; i < PIPELINE_MAX_QUEUES; i++) {
+        _queues[i] = nullptr;
+    }
+}
+
+Pipeline::~Pipeline() {
+    stop();
+}
+
+// ========== 拓扑 ==========
+
+int8_t Pipeline::addStage(const char* name, PipelineStageFn fn, void* arg, uint8_t core, uint8_t priority,
+                          uint32_t stackBytes) {
+    if (fn == nullptr || _stageCount >= PIPELINE_MAX_STAGES || running()) {
+        return PIPELINE_NO_STAGE;
+    }
+    Stage& s = _stages[_stageCount];
+    s.name = name;
+    s.fn = fn;
+    s.arg = arg;
+    s.core = core;
+    s.priority = priority;
+    s.stackBytes = stackBytes;
+    s.owner = this;
+    s.rounds.store(0);
+    s.wakeups.store(0);
+    s.busyUs.store(0);
+    s.maxRoundUs.store(0);
+    s.runningCore.store(-1);
+    return (int8_t)_stageCount++;
+}
+
+bool Pipeline::connect(PipelineQueueBase& queue, const char* name, int8_t producer, int8_t consumer) {
+    if (!validStage(producer) || !validStage(consumer) || producer == consumer ||
+        _queueCount >= PIPELINE_MAX_QUEUES || running()) {
+        return false;
+    }
+    for (uint8_t i = 0; i < _queueCount; i++) {
+        if (_queues[i] == &queue) {
+            return false;   // 第二个生产者/消费者会破坏 SPSC 前提
+        }
+    }
+    queue._name = name;
+    queue._producer = producer;
+    queue._consumer = consumer;
+    queue._wake = &_stages[consumer].signal;
+    _queues[_queueCount++] = &queue;
+    return true;
+}
+
+const char* Pipeline::validate() const {
+    if (_stageCount == 0) {
+        return "没有阶段";
+    }
+    for (uint8_t i = 0; i < _stageCount; i++) {
+        const Stage& s = _stages[i];
+        if (s.core >= PIPELINE_CORES) {
+            return "阶段核号无效";
+        }
+        if (s.priority > PIPELINE_MAX_PRIORITY) {
+            return "阶段优先级超出范围";
+        }
+        if (s.stackBytes < 1024) {
+            return "阶段栈太小";
+        }
+    }
+    for (uint8_t i = 0; i < _queueCount; i++) {
+        const PipelineQueueBase* q = _queues[i];
+        if (!validStage(q->_producer) || !validStage(q->_consumer) || q->_producer == q->_consumer) {
+            return "队列两端无效";
+        }
+    }
+    // 只有一个阶段时不需要队列；多个阶段时每个阶段都应至少连接一个队列
+    if (_stageCount > 1) {
+        for (uint8_t i = 0; i < _stageCount; i++) {
+            bool linked = false;
+            for (uint8_t k = 0; k < _queueCount && !linked; k++) {
+                linked = _queues[k]->_producer == i || _queues[k]->_consumer == i;
+            }
+            if (!linked) {
+                return "阶段没有连接任何队列";
+            }
+        }
+    }
+    return nullptr;
+}
+
+// ========== 查询 ==========
+
+const char* Pipeline::stageName(int8_t id) const {
+    return validStage(id) ? _stages[id].name : nullptr;
+}
+
+int8_t Pipeline::stageCore(int8_t id) const {
+    return validStage(id) ? (int8_t)_stages[id].core : PIPELINE_NO_STAGE;
+}
+
+uint8_t Pipeline::stagePriority(int8_t id) const {
+    return validStage(id) ? _stages[id].priority : 0;
+}
+
+PipelineStageStats Pipeline::stageStats(int8_t id) const {
+    PipelineStageStats st = {};
+    st.runningCore = -1;
+    if (!validStage(id)) {
+        return st;
+    }
+    const Stage& s = _stages[id];
+    st.rounds = s.rounds.load(std::memory_order_relaxed);
+    st.wakeups = s.wakeups.load(std::memory_order_relaxed);
+    st.busyUs = s.busyUs.load(std::memory_order_relaxed);
+    st.maxRoundUs = s.maxRoundUs.load(std::memory_order_relaxed);
+    st.runningCore = s.runningCore.load(std::memory_order_relaxed);
+    return st;
+}
+
+const PipelineQueueBase* Pipeline::queue(uint8_t index) const {
+    return index < _queueCount ? _queues[index] : nullptr;
+}
+
+void Pipeline::resetStats() {
+    for (uint8_t i = 0; i < _stageCount; i++) {
+        Stage& s = _stages[i];
+        s.rounds.store(0, std::memory_order_relaxed);
+        s.wakeups.store(0, std::memory_order_relaxed);
+        s.busyUs.store(0, std::memory_order_relaxed);
+        s.maxRoundUs.store(0, std::memory_order_relaxed);
+    }
+    for (uint8_t i = 0; i < _queueCount; i++) {
+        _queues[i]->resetStats();
+    }
+}
+
+// ========== 阶段循环（设备端任务 / 主机端线程） ==========
+
+void Pipeline::runStage(Stage& s) {
+#ifdef ARDUINO
+    s.runningCore.store((int8_t)xPortGetCoreID(), std::memory_order_relaxed);
+#endif
+    while (_running.load(std::memory_order_acquire)) {
+        uint32_t start = nowUs();
+        uint32_t waitUs = s.fn(s.arg);
+        uint32_t us = nowUs() - start;
+
+        // 统计只由本阶段写，其他任务读
+        s.rounds.fetch_add(1, std::memory_order_relaxed);
+        s.busyUs.fetch_add(us, std::memory_order_relaxed);
+        if (us > s.maxRoundUs.load(std::memory_order_relaxed)) {
+            s.maxRoundUs.store(us, std::memory_order_relaxed);
+        }
+
+        if (waitUs > 0 && _running.load(std::memory_order_acquire) && s.signal.wait(waitUs)) {
+            s.wakeups.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+#ifdef ARDUINO
+
+uint32_t Pipeline::nowUs() {
+    return micros();
+}
+
+bool Pipeline::start() {
+    if (running() || validate() != nullptr) {
+        return false;
+    }
+    _running.store(true, std::memory_order_release);
+    for (uint8_t i = 0; i < _stageCount; i++) {
+        Stage& s = _stages[i];
+        _alive.fetch_add(1);
+        BaseType_t ok = xTaskCreatePinnedToCore(taskEntry, s.name, s.stackBytes, &s,
+                                                s.priority, &s.signal.task, s.core);
+        if (ok != pdPASS) {
+            _alive.fetch_sub(1);
+            stop();
+            return false;
+        }
+    }
+    return true;
+}
+
+void Pipeline::stop() {
+    if (!running()) {
+        return;
+    }
+    // 不能在阶段内调用：等待所有任务结束当前一轮后退出
+    _running.store(false, std::memory_order_release);
+    for (uint8_t i = 0; i < _stageCount; i++) {
+        _stages[i].signal.notify();
+    }
+    while (_alive.load() > 0) {
+        vTaskDelay(1);
+    }
+}
+
+void Pipeline::taskEntry(void* arg) {
+    Stage* s = (Stage*)arg;
+    s->owner->runStage(*s);
+    s->signal.task = nullptr;
+    s->owner->_alive.fetch_sub(1);
+    vTaskDelete(NULL);
+}
+
+#else
+
+uint32_t Pipeline::nowUs() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+bool Pipeline::start() {
+    if (running() || validate() != nullptr) {
+        return false;
+    }
+    _running.store(true, std::memory_order_release);
+    for (uint8_t i = 0; i < _stageCount; i++) {
+        Stage* s = &_stages[i];
+        _threads[i] = std::thread([this, s]() { runStage(*s); });
+    }
+    return true;
+}
+
+void Pipeline::stop() {
+    if (!running()) {
+        return;
+    }
+    _running.store(false, std::memory_order_release);
+    for (uint8_t i = 0; i < _stageCount; i++) {
+        _stages[i].signal.notify();
+    }
+    for (uint8_t i = 0; i < _stageCount; i++) {
+        if (_threads[i].joinable()) {
+            _threads[i].join();
+        }
+    }
+}
+
+#endif // ARDUINO
@@ -0,0 +1,133 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdint.h>
+#include <atomic>
+#include "PipelineSignal.h"
+#include "PipelineQueue.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <thread>
+#endif
+
+/**
+ * Pipeline - 多核流水线拓扑
+ *
+ * 综合联动原来所有子系统在一个 Arduino loop 任务里（TaskScheduler 协作调度），
+ * 音频分析的耗时直接加在舵机/灯效的延迟上。本模块把系统划分为若干阶段，
+ * 每个阶段一个任务、固定在一个核上，阶段之间只经 PipelineQueue 通信：
+ *
+ *   采集+DSP（核0）──帧──> 决策状态机（核1）──命令──> 运动+灯效（核1，最高优先级）
+ *        ^                       └──状态──> 显示+遥测（核0）
+ *        └─────────运动事件（自噪声门控）─────────┘
+ *
+ * - addStage() 登记阶段（名称、核、优先级、栈），connect() 登记队列的生产者和消费者
+ * - validate() 检查拓扑：核号有效、每个队列恰好一个生产者和一个消费者且不是同一阶段
+ *   （SpscRing 的前提），start() 只启动检查通过的拓扑
+ * - 阶段函数运行一轮后返回最多等待多久；等待期间有队列写入会提前唤醒
+ * - 返回 0 表示立即再运行一轮，这样的阶段必须自己阻塞（例如 I2S 读取），
+ *   否则会饿死同核的低优先级任务
+ *
+ * 设备端用 xTaskCreatePinnedToCore 创建任务；主机端每个阶段一个 std::thread
+ * （不绑定核，只记录配置），用于在测试中验证拓扑和队列计数。
+ */
+
+#define PIPELINE_MAX_STAGES   6
+#define PIPELINE_MAX_QUEUES   8
+#define PIPELINE_NO_STAGE     -1
+#define PIPELINE_CORES        2     // ESP32-S3 双核
+#define PIPELINE_MAX_PRIORITY 24    // configMAX_PRIORITIES - 1
+
+/**
+ * 阶段函数：运行一轮（取队列、处理、写队列）
+ * @return 再次运行前最多等待的时间（us），0 为立即
+ */
+typedef uint32_t (*PipelineStageFn)(void* arg);
+
+struct PipelineStageStats {
+    uint32_t rounds;       // 运行轮数
+    uint32_t wakeups;      // 被队列写入提前唤醒的次数
+    uint32_t busyUs;       // 累计运行时间（resetStats() 清零）
+    uint32_t maxRoundUs;   // 单轮最长运行时间
+    int8_t runningCore;    // 实际运行的核（主机端为 -1）
+};
+
+class Pipeline {
+public:
+    Pipeline();
+    ~Pipeline();
+
+    /**
+     * 登记阶段
+     * @param core 运行的核（0 / 1）
+     * @param priority FreeRTOS 任务优先级，数值越大越优先
+     * @return 阶段编号，阶段表满、已启动或 fn 为空时返回 PIPELINE_NO_STAGE
+     */
+    int8_t addStage(const char* name, PipelineStageFn fn, void* arg, uint8_t core, uint8_t priority,
+                    uint32_t stackBytes = 4096);
+
+    /**
+     * 登记队列：producer 阶段写入，consumer 阶段取出，写入后唤醒 consumer
+     * @return 阶段编号无效、两端相同、队列已登记或已启动时返回 false
+     */
+    bool connect(PipelineQueueBase& queue, const char* name, int8_t producer, int8_t consumer);
+
+    // 检查拓扑，通过返回 nullptr，否则返回错误说明
+    const char* validate() const;
+
+    // 检查拓扑并启动所有阶段
+    bool start();
+    // 停止所有阶段：设备端任务在当前一轮结束后删除自身，主机端等待线程退出
+    void stop();
+    bool running() const { return _running.load(std::memory_order_acquire); }
+
+    uint8_t stageCount() const { return _stageCount; }
+    uint8_t queueCount() const { return _queueCount; }
+    const char* stageName(int8_t id) const;
+    int8_t stageCore(int8_t id) const;
+    uint8_t stagePriority(int8_t id) const;
+    PipelineStageStats stageStats(int8_t id) const;
+    const PipelineQueueBase* queue(uint8_t index) const;
+
+    // 阶段和队列计数清零
+    void resetStats();
+
+private:
+    struct Stage {
+        const char* name;
+        PipelineStageFn fn;
+        void* arg;
+        uint8_t core;
+        uint8_t priority;
+        uint32_t stackBytes;
+        Pipeline* owner;
+        PipelineSignal signal;
+
+        std::atomic<uint32_t> rounds;
+        std::atomic<uint32_t> wakeups;
+        std::atomic<uint32_t> busyUs;
+        std::atomic<uint32_t> maxRoundUs;
+        std::atomic<int8_t> runningCore;
+    };
+
+    bool validStage(int8_t id) const { return id >= 0 && id < _stageCount; }
+    void runStage(Stage& s);
+    static uint32_t nowUs();
+
+#ifdef ARDUINO
+    static void taskEntry(void* arg);
+    std::atomic<uint8_t> _alive;   // 尚未退出的任务数
+#else
+    std::thread _threads[PIPELINE_MAX_STAGES];
+#endif
+
+    Stage _stages[PIPELINE_MAX_STAGES];
+    uint8_t _stageCount;
+    PipelineQueueBase* _queues[PIPELINE_MAX_QUEUES];
+    uint8_t _queueCount;
+    std::atomic<bool> _running;
+};
+
+#endif // PIPELINE_H
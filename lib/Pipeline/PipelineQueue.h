@@ -0,0 +1,139 @@
+#ifndef PIPELINE_QUEUE_H
+#define PIPELINE_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "SpscRing.h"
+#include "PipelineSignal.h"
+
+/**
+ * PipelineQueue - 流水线阶段之间的有界队列
+ *
+ * 在 SpscRing 上加计数：写入/取出/丢弃次数、当前深度和最大深度，
+ * 用来判断哪个阶段跟不上（深度长期接近容量、丢弃增加）。
+ *
+ * - 满时丢弃新元素（push 返回 false 并计数），生产者不会因为下游慢而阻塞
+ * - 由 Pipeline::connect() 指定生产者和消费者阶段；写入成功后唤醒消费者阶段
+ * - 和 SpscRing 一样只能有一个生产者线程和一个消费者线程，拓扑检查保证这一点
+ */
+
+struct PipelineQueueStats {
+    uint32_t pushed;     // 写入成功
+    uint32_t popped;     // 取出
+    uint32_t dropped;    // 队列满而丢弃
+    uint32_t depth;      // 当前深度（近似值）
+    uint32_t maxDepth;   // 写入后观察到的最大深度
+    uint32_t capacity;
+};
+
+// 与元素类型无关的部分：Pipeline 据此记录拓扑、打印统计
+class PipelineQueueBase {
+public:
+    PipelineQueueBase() : _name(nullptr), _producer(-1), _consumer(-1), _wake(nullptr) {}
+    virtual ~PipelineQueueBase() {}
+
+    virtual PipelineQueueStats stats() const = 0;
+    virtual void resetStats() = 0;
+
+    const char* name() const { return _name; }
+    int8_t producer() const { return _producer; }
+    int8_t consumer() const { return _consumer; }
+
+protected:
+    friend class Pipeline;
+
+    const char* _name;
+    int8_t _producer;
+    int8_t _consumer;
+    PipelineSignal* _wake;   // 消费者阶段的唤醒信号
+};
+
+template <typename T, size_t N>
+class PipelineQueue : public PipelineQueueBase {
+public:
+    PipelineQueue() : _pushed(0), _dropped(0), _maxDepth(0), _popped(0) {}
+
+    // ========== 生产者端 ==========
+
+    /**
+     * 写入一个元素并唤醒消费者阶段
+     * @return 队列已满（元素被丢弃）时返回 false
+     */
+    bool push(const T& value) {
+        if (!_ring.push(value)) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        _pushed.fetch_add(1, std::memory_order_relaxed);
+
+        uint32_t depth = (uint32_t)_ring.size();
+        if (depth > _maxDepth.load(std::memory_order_relaxed)) {
+            _maxDepth.store(depth, std::memory_order_relaxed);
+        }
+
+        if (_wake != nullptr) {
+            _wake->notify();
+        }
+        return true;
+    }
+
+    // ========== 消费者端 ==========
+
+    bool pop(T& out) {
+        if (!_ring.pop(out)) {
+            return false;
+        }
+        _popped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * 取出全部元素，只保留最后一个（只关心最新值的消费者，例如最新一帧分析结果）
+     * @return 取出的数量，0 时 latest 不变
+     */
+    size_t drain(T& latest) {
+        size_t n = 0;
+        while (_ring.pop(latest)) {
+            n++;
+        }
+        if (n > 0) {
+            _popped.fetch_add((uint32_t)n, std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    // ========== 状态查询（任意线程） ==========
+
+    size_t depth() const { return _ring.size(); }
+    constexpr size_t capacity() const { return N; }
+
+    PipelineQueueStats stats() const override {
+        PipelineQueueStats s;
+        s.pushed = _pushed.load(std::memory_order_relaxed);
+        s.popped = _popped.load(std::memory_order_relaxed);
+        s.dropped = _dropped.load(std::memory_order_relaxed);
+        s.depth = (uint32_t)_ring.size();
+        s.maxDepth = _maxDepth.load(std::memory_order_relaxed);
+        s.capacity = (uint32_t)N;
+        return s;
+    }
+
+    // 计数清零（深度不变）；与生产者同时调用时可能漏掉一次计数
+    void resetStats() override {
+        _pushed.store(0, std::memory_order_relaxed);
+        _dropped.store(0, std::memory_order_relaxed);
+        _maxDepth.store(0, std::memory_order_relaxed);
+        _popped.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    SpscRing<T, N> _ring;
+
+    std::atomic<uint32_t> _pushed;     // 生产者写
+    std::atomic<uint32_t> _dropped;    // 生产者写
+    std::atomic<uint32_t> _maxDepth;   // 生产者写
+    std::atomic<uint32_t> _popped;     // 消费者写
+};
+
+#endif // PIPELINE_QUEUE_H
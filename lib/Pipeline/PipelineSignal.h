@@ -0,0 +1,65 @@
+#ifndef PIPELINE_SIGNAL_H
+#define PIPELINE_SIGNAL_H
+
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#endif
+
+/**
+ * PipelineSignal - 阶段唤醒信号
+ *
+ * 队列写入后 notify() 消费者阶段，阶段空闲时 wait() 到有新数据或超时。
+ * 设备端为 FreeRTOS 任务通知（与 AsyncDisplayFlush、AudioPlayback 相同），
+ * 主机端为条件变量。多次 notify() 合并为一次唤醒。
+ */
+class PipelineSignal {
+public:
+#ifdef ARDUINO
+    PipelineSignal() : task(nullptr) {}
+
+    void notify() {
+        if (task != nullptr) {
+            xTaskNotifyGive(task);
+        }
+    }
+
+    // 只能由所属任务调用；超时按节拍向上取整，至少一个节拍
+    bool wait(uint32_t timeoutUs) {
+        const uint32_t tickUs = portTICK_PERIOD_MS * 1000;
+        TickType_t ticks = (timeoutUs + tickUs - 1) / tickUs;
+        return ulTaskNotifyTake(pdTRUE, ticks > 0 ? ticks : 1) > 0;
+    }
+
+    TaskHandle_t task;   // 所属阶段任务，启动前为空（notify 忽略）
+#else
+    PipelineSignal() : _flag(false) {}
+
+    void notify() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _flag = true;
+        }
+        _cv.notify_one();
+    }
+
+    bool wait(uint32_t timeoutUs) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        bool woken = _cv.wait_for(lock, std::chrono::microseconds(timeoutUs), [this] { return _flag; });
+        _flag = false;
+        return woken;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _flag;
+#endif
+};
+
+#endif // PIPELINE_SIGNAL_H
@@ -0,0 +1,151 @@
+// 由 tools/make_sprite_anim.py 生成，请勿手工修改
+// 动画：blink（14 帧，80 ms）, look（16 帧，100 ms）, happy（10 帧，90 ms）
+#ifndef FACESPRITESDATA_H
+#define FACESPRITESDATA_H
+
+#include <stdint.h>
+
+// 用 SpriteBank::attach(FACE_SPRITES, sizeof(FACE_SPRITES)) 解析
+alignas(4) static const uint8_t FACE_SPRITES[] = {
+    0x49, 0x52, 0x53, 0x41, 0x01, 0x00, 0x03, 0x00, 0x62, 0x6c, 0x69, 0x6e, 0x6b, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x05, 0x0e, 0x00, 0x50, 0x00, 0x01, 0x00,
+    0x68, 0x00, 0x00, 0x00, 0xa8, 0x02, 0x00, 0x00, 0x6c, 0x6f, 0x6f, 0x6b, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x05, 0x10, 0x00, 0x64, 0x00, 0x01, 0x00,
+    0x10, 0x03, 0x00, 0x00, 0x5a, 0x03, 0x00, 0x00, 0x68, 0x61, 0x70, 0x70, 0x79, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x05, 0x0a, 0x00, 0x5a, 0x00, 0x00, 0x00,
+    0x6c, 0x06, 0x00, 0x00, 0x38, 0x02, 0x00, 0x00, 0x00, 0x00, 0x86, 0x00, 0x89, 0x00, 0x80, 0x80,
+    0x85, 0x40, 0x80, 0x80, 0xa3, 0x00, 0x80, 0x80, 0x85, 0x40, 0x80, 0x80, 0x8e, 0x00, 0x07, 0xe0,
+    0x18, 0x04, 0x02, 0x01, 0x00, 0xc0, 0xe0, 0x83, 0xf0, 0x07, 0xe0, 0xc0, 0x00, 0x01, 0x02, 0x04,
+    0x18, 0xe0, 0x99, 0x00, 0x07, 0xe0, 0x18, 0x04, 0x02, 0x01, 0x00, 0xc0, 0xe0, 0x83, 0xf0, 0x07,
+    0xe0, 0xc0, 0x00, 0x01, 0x02, 0x04, 0x18, 0xe0, 0x89, 0x00, 0x07, 0x0f, 0x30, 0x40, 0x80, 0x00,
+    0x00, 0x07, 0x0f, 0x83, 0x1f, 0x07, 0x0f, 0x07, 0x00, 0x00, 0x80, 0x40, 0x30, 0x0f, 0x99, 0x00,
+    0x07, 0x0f, 0x30, 0x40, 0x80, 0x00, 0x00, 0x07, 0x0f, 0x83, 0x1f, 0x07, 0x0f, 0x07, 0x00, 0x00,
+    0x80, 0x40, 0x30, 0x0f, 0x8d, 0x00, 0x02, 0x01, 0x02, 0x02, 0x85, 0x04, 0x80, 0x02, 0x00, 0x01,
+    0xa1, 0x00, 0x02, 0x01, 0x02, 0x02, 0x85, 0x04, 0x80, 0x02, 0x00, 0x01, 0x8d, 0x00, 0xc3, 0x04,
+    0x83, 0x00, 0x01, 0x00, 0x08, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x8b, 0x00, 0x01, 0x00,
+    0x08, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x8b, 0x00, 0x01, 0x00, 0x08, 0x00, 0xff, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0x8b, 0x00, 0x01, 0x00, 0x08, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+    0x8b, 0x00, 0x01, 0x00, 0x08, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x8b, 0x00, 0x01, 0x00,
+    0x08, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x8b, 0x00, 0x01, 0x00, 0x08, 0x00, 0xff, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0x8b, 0x00, 0x00, 0x00, 0x5e, 0x00, 0xd4, 0x00, 0x07, 0x80, 0x60, 0x30,
+    0x10, 0x08, 0x08, 0xcc, 0xe4, 0x83, 0xf4, 0x07, 0xe4, 0xcc, 0x08, 0x08, 0x10, 0x30, 0x60, 0x80,
+    0x99, 0x00, 0x07, 0x80, 0x60, 0x30, 0x10, 0x08, 0x08, 0xcc, 0xe4, 0x83, 0xf4, 0x07, 0xe4, 0xcc,
+    0x08, 0x08, 0x10, 0x30, 0x60, 0x80, 0x89, 0x00, 0x07, 0x03, 0x0c, 0x18, 0x10, 0x20, 0x20, 0x67,
+    0x4f, 0x83, 0x5f, 0x07, 0x4f, 0x67, 0x20, 0x20, 0x10, 0x18, 0x0c, 0x03, 0x99, 0x00, 0x07, 0x03,
+    0x0c, 0x18, 0x10, 0x20, 0x20, 0x67, 0x4f, 0x83, 0x5f, 0x07, 0x4f, 0x67, 0x20, 0x20, 0x10, 0x18,
+    0x0c, 0x03, 0xd9, 0x00, 0xc3, 0x04, 0x83, 0x00, 0x00, 0x00, 0x3a, 0x00, 0xd5, 0x00, 0x80, 0x80,
+    0x00, 0x00, 0x8b, 0x40, 0x02, 0x00, 0x80, 0x80, 0x9b, 0x00, 0x80, 0x80, 0x00, 0x00, 0x8b, 0x40,
+    0x02, 0x00, 0x80, 0x80, 0x8a, 0x00, 0x03, 0x01, 0x02, 0x02, 0x00, 0x8b, 0x04, 0x03, 0x00, 0x02,
+    0x02, 0x01, 0x99, 0x00, 0x03, 0x01, 0x02, 0x02, 0x00, 0x8b, 0x04, 0x03, 0x00, 0x02, 0x02, 0x01,
+    0xd9, 0x00, 0xc3, 0x04, 0x83, 0x00, 0x00, 0x00, 0x10, 0x00, 0xff, 0x00, 0xa3, 0x00, 0x93, 0x01,
+    0x99, 0x00, 0x93, 0x01, 0xd9, 0x00, 0xc3, 0x04, 0x83, 0x00, 0x01, 0x00, 0x34, 0x00, 0xd5, 0x00,
+    0x80, 0x80, 0x00, 0x00, 0x8b, 0x40, 0x02, 0x00, 0x80, 0x80, 0x9b, 0x00, 0x80, 0x80, 0x00, 0x00,
+    0x8b, 0x40, 0x02, 0x00, 0x80, 0x80, 0x8b, 0x00, 0x80, 0x03, 0x00, 0x01, 0x8b, 0x05, 0x02, 0x01,
+    0x03, 0x03, 0x9b, 0x00, 0x80, 0x03, 0x00, 0x01, 0x8b, 0x05, 0x02, 0x01, 0x03, 0x03, 0xff, 0x00,
+    0xa3, 0x00, 0x01, 0x00, 0x5c, 0x00, 0xd4, 0x00, 0x07, 0x80, 0xe0, 0xb0, 0x10, 0x48, 0x48, 0x8c,
+    0xa4, 0x83, 0xb4, 0x07, 0xa4, 0x8c, 0x48, 0x48, 0x10, 0xb0, 0xe0, 0x80, 0x99, 0x00, 0x07, 0x80,
+    0xe0, 0xb0, 0x10, 0x48, 0x48, 0x8c, 0xa4, 0x83, 0xb4, 0x07, 0xa4, 0x8c, 0x48, 0x48, 0x10, 0xb0,
+    0xe0, 0x80, 0x89, 0x00, 0x07, 0x02, 0x0e, 0x1a, 0x10, 0x24, 0x24, 0x63, 0x4b, 0x83, 0x5b, 0x07,
+    0x4b, 0x63, 0x24, 0x24, 0x10, 0x1a, 0x0e, 0x02, 0x99, 0x00, 0x07, 0x02, 0x0e, 0x1a, 0x10, 0x24,
+    0x24, 0x63, 0x4b, 0x83, 0x5b, 0x07, 0x4b, 0x63, 0x24, 0x24, 0x10, 0x1a, 0x0e, 0x02, 0xff, 0x00,
+    0xa2, 0x00, 0x01, 0x00, 0x7a, 0x00, 0x89, 0x00, 0x80, 0x80, 0x85, 0x40, 0x80, 0x80, 0xa3, 0x00,
+    0x80, 0x80, 0x85, 0x40, 0x80, 0x80, 0x8e, 0x00, 0x06, 0x60, 0x78, 0x34, 0x12, 0x09, 0x08, 0x0c,
+    0x85, 0x04, 0x06, 0x0c, 0x08, 0x09, 0x12, 0x34, 0x78, 0x60, 0x99, 0x00, 0x06, 0x60, 0x78, 0x34,
+    0x12, 0x09, 0x08, 0x0c, 0x85, 0x04, 0x06, 0x0c, 0x08, 0x09, 0x12, 0x34, 0x78, 0x60, 0x89, 0x00,
+    0x06, 0x0c, 0x3c, 0x58, 0x90, 0x20, 0x20, 0x60, 0x85, 0x40, 0x06, 0x60, 0x20, 0x20, 0x90, 0x58,
+    0x3c, 0x0c, 0x99, 0x00, 0x06, 0x0c, 0x3c, 0x58, 0x90, 0x20, 0x20, 0x60, 0x85, 0x40, 0x06, 0x60,
+    0x20, 0x20, 0x90, 0x58, 0x3c, 0x0c, 0x8d, 0x00, 0x02, 0x01, 0x02, 0x02, 0x85, 0x04, 0x80, 0x02,
+    0x00, 0x01, 0xa1, 0x00, 0x02, 0x01, 0x02, 0x02, 0x85, 0x04, 0x80, 0x02, 0x00, 0x01, 0xd7, 0x00,
+    0x00, 0x00, 0x86, 0x00, 0x89, 0x00, 0x80, 0x80, 0x85, 0x40, 0x80, 0x80, 0xa3, 0x00, 0x80, 0x80,
+    0x85, 0x40, 0x80, 0x80, 0x8e, 0x00, 0x07, 0xe0, 0x18, 0x04, 0x02, 0x01, 0x00, 0xc0, 0xe0, 0x83,
+    0xf0, 0x07, 0xe0, 0xc0, 0x00, 0x01, 0x02, 0x04, 0x18, 0xe0, 0x99, 0x00, 0x07, 0xe0, 0x18, 0x04,
+    0x02, 0x01, 0x00, 0xc0, 0xe0, 0x83, 0xf0, 0x07, 0xe0, 0xc0, 0x00, 0x01, 0x02, 0x04, 0x18, 0xe0,
+    0x89, 0x00, 0x07, 0x0f, 0x30, 0x40, 0x80, 0x00, 0x00, 0x07, 0x0f, 0x83, 0x1f, 0x07, 0x0f, 0x07,
+    0x00, 0x00, 0x80, 0x40, 0x30, 0x0f, 0x99, 0x00, 0x07, 0x0f, 0x30, 0x40, 0x80, 0x00, 0x00, 0x07,
+    0x0f, 0x83, 0x1f, 0x07, 0x0f, 0x07, 0x00, 0x00, 0x80, 0x40, 0x30, 0x0f, 0x8d, 0x00, 0x02, 0x01,
+    0x02, 0x02, 0x85, 0x04, 0x80, 0x02, 0x00, 0x01, 0xa1, 0x00, 0x02, 0x01, 0x02, 0x02, 0x85, 0x04,
+    0x80, 0x02, 0x00, 0x01, 0x8d, 0x00, 0xc3, 0x04, 0x83, 0x00, 0x01, 0x00, 0x3c, 0x00, 0xd8, 0x00,
+    0x03, 0xc0, 0xe0, 0x30, 0x10, 0x81, 0x00, 0x03, 0x10, 0x30, 0xe0, 0xc0, 0xa3, 0x00, 0x03, 0xc0,
+    0xe0, 0x30, 0x10, 0x81, 0x00, 0x03, 0x10, 0x30, 0xe0, 0xc0, 0x93, 0x00, 0x03, 0x07, 0x0f, 0x18,
+    0x10, 0x81, 0x00, 0x03, 0x10, 0x18, 0x0f, 0x07, 0xa3, 0x00, 0x03, 0x07, 0x0f, 0x18, 0x10, 0x81,
+    0x00, 0x03, 0x10, 0x18, 0x0f, 0x07, 0xff, 0x00, 0xa8, 0x00, 0x01, 0x00, 0x3c, 0x00, 0xd6, 0x00,
+    0x03, 0xc0, 0xe0, 0x30, 0x10, 0x81, 0x00, 0x03, 0x10, 0x30, 0xe0, 0xc0, 0xa3, 0x00, 0x03, 0xc0,
+    0xe0, 0x30, 0x10, 0x81, 0x00, 0x03, 0x10, 0x30, 0xe0, 0xc0, 0x93, 0x00, 0x03, 0x07, 0x0f, 0x18,
+    0x10, 0x81, 0x00, 0x03, 0x10, 0x18, 0x0f, 0x07, 0xa3, 0x00, 0x03, 0x07, 0x0f, 0x18, 0x10, 0x81,
+    0x00, 0x03, 0x10, 0x18, 0x0f, 0x07, 0xff, 0x00, 0xaa, 0x00, 0x01, 0x00, 0x34, 0x00, 0xd5, 0x00,
+    0x02, 0xc0, 0x20, 0x10, 0x82, 0x00, 0x02, 0x10, 0x20, 0xc0, 0xa4, 0x00, 0x02, 0xc0, 0x20, 0x10,
+    0x82, 0x00, 0x02, 0x10, 0x20, 0xc0, 0x94, 0x00, 0x02, 0x07, 0x08, 0x10, 0x82, 0x00, 0x02, 0x10,
+    0x08, 0x07, 0xa4, 0x00, 0x02, 0x07, 0x08, 0x10, 0x82, 0x00, 0x02, 0x10, 0x08, 0x07, 0xff, 0x00,
+    0xac, 0x00, 0x01, 0x00, 0x08, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x8b, 0x00, 0x01, 0x00,
+    0x08, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x8b, 0x00, 0x01, 0x00, 0x34, 0x00, 0xd5, 0x00,
+    0x02, 0xc0, 0x20, 0x10, 0x82, 0x00, 0x02, 0x10, 0x20, 0xc0, 0xa4, 0x00, 0x02, 0xc0, 0x20, 0x10,
+    0x82, 0x00, 0x02, 0x10, 0x20, 0xc0, 0x94, 0x00, 0x02, 0x07, 0x08, 0x10, 0x82, 0x00, 0x02, 0x10,
+    0x08, 0x07, 0xa4, 0x00, 0x02, 0x07, 0x08, 0x10, 0x82, 0x00, 0x02, 0x10, 0x08, 0x07, 0xff, 0x00,
+    0xac, 0x00, 0x01, 0x00, 0x3c, 0x00, 0xd6, 0x00, 0x03, 0xc0, 0xe0, 0x30, 0x10, 0x81, 0x00, 0x03,
+    0x10, 0x30, 0xe0, 0xc0, 0xa3, 0x00, 0x03, 0xc0, 0xe0, 0x30, 0x10, 0x81, 0x00, 0x03, 0x10, 0x30,
+    0xe0, 0xc0, 0x93, 0x00, 0x03, 0x07, 0x0f, 0x18, 0x10, 0x81, 0x00, 0x03, 0x10, 0x18, 0x0f, 0x07,
+    0xa3, 0x00, 0x03, 0x07, 0x0f, 0x18, 0x10, 0x81, 0x00, 0x03, 0x10, 0x18, 0x0f, 0x07, 0xff, 0x00,
+    0xaa, 0x00, 0x01, 0x00, 0x3c, 0x00, 0xd8, 0x00, 0x03, 0xc0, 0xe0, 0x30, 0x10, 0x81, 0x00, 0x03,
+    0x10, 0x30, 0xe0, 0xc0, 0xa3, 0x00, 0x03, 0xc0, 0xe0, 0x30, 0x10, 0x81, 0x00, 0x03, 0x10, 0x30,
+    0xe0, 0xc0, 0x93, 0x00, 0x03, 0x07, 0x0f, 0x18, 0x10, 0x81, 0x00, 0x03, 0x10, 0x18, 0x0f, 0x07,
+    0xa3, 0x00, 0x03, 0x07, 0x0f, 0x18, 0x10, 0x81, 0x00, 0x03, 0x10, 0x18, 0x0f, 0x07, 0xff, 0x00,
+    0xa8, 0x00, 0x01, 0x00, 0x3c, 0x00, 0xda, 0x00, 0x03, 0xc0, 0xe0, 0x30, 0x10, 0x81, 0x00, 0x03,
+    0x10, 0x30, 0xe0, 0xc0, 0xa3, 0x00, 0x03, 0xc0, 0xe0, 0x30, 0x10, 0x81, 0x00, 0x03, 0x10, 0x30,
+    0xe0, 0xc0, 0x93, 0x00, 0x03, 0x07, 0x0f, 0x18, 0x10, 0x81, 0x00, 0x03, 0x10, 0x18, 0x0f, 0x07,
+    0xa3, 0x00, 0x03, 0x07, 0x0f, 0x18, 0x10, 0x81, 0x00, 0x03, 0x10, 0x18, 0x0f, 0x07, 0xff, 0x00,
+    0xa6, 0x00, 0x01, 0x00, 0x3c, 0x00, 0xdc, 0x00, 0x03, 0xc0, 0xe0, 0x30, 0x10, 0x81, 0x00, 0x03,
+    0x10, 0x30, 0xe0, 0xc0, 0xa3, 0x00, 0x03, 0xc0, 0xe0, 0x30, 0x10, 0x81, 0x00, 0x03, 0x10, 0x30,
+    0xe0, 0xc0, 0x93, 0x00, 0x03, 0x07, 0x0f, 0x18, 0x10, 0x81, 0x00, 0x03, 0x10, 0x18, 0x0f, 0x07,
+    0xa3, 0x00, 0x03, 0x07, 0x0f, 0x18, 0x10, 0x81, 0x00, 0x03, 0x10, 0x18, 0x0f, 0x07, 0xff, 0x00,
+    0xa4, 0x00, 0x01, 0x00, 0x34, 0x00, 0xde, 0x00, 0x02, 0xc0, 0x20, 0x10, 0x82, 0x00, 0x02, 0x10,
+    0x20, 0xc0, 0xa4, 0x00, 0x02, 0xc0, 0x20, 0x10, 0x82, 0x00, 0x02, 0x10, 0x20, 0xc0, 0x94, 0x00,
+    0x02, 0x07, 0x08, 0x10, 0x82, 0x00, 0x02, 0x10, 0x08, 0x07, 0xa4, 0x00, 0x02, 0x07, 0x08, 0x10,
+    0x82, 0x00, 0x02, 0x10, 0x08, 0x07, 0xff, 0x00, 0xa3, 0x00, 0x01, 0x00, 0x08, 0x00, 0xff, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0x8b, 0x00, 0x01, 0x00, 0x08, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+    0x8b, 0x00, 0x01, 0x00, 0x34, 0x00, 0xde, 0x00, 0x02, 0xc0, 0x20, 0x10, 0x82, 0x00, 0x02, 0x10,
+    0x20, 0xc0, 0xa4, 0x00, 0x02, 0xc0, 0x20, 0x10, 0x82, 0x00, 0x02, 0x10, 0x20, 0xc0, 0x94, 0x00,
+    0x02, 0x07, 0x08, 0x10, 0x82, 0x00, 0x02, 0x10, 0x08, 0x07, 0xa4, 0x00, 0x02, 0x07, 0x08, 0x10,
+    0x82, 0x00, 0x02, 0x10, 0x08, 0x07, 0xff, 0x00, 0xa3, 0x00, 0x01, 0x00, 0x3c, 0x00, 0xdc, 0x00,
+    0x03, 0xc0, 0xe0, 0x30, 0x10, 0x81, 0x00, 0x03, 0x10, 0x30, 0xe0, 0xc0, 0xa3, 0x00, 0x03, 0xc0,
+    0xe0, 0x30, 0x10, 0x81, 0x00, 0x03, 0x10, 0x30, 0xe0, 0xc0, 0x93, 0x00, 0x03, 0x07, 0x0f, 0x18,
+    0x10, 0x81, 0x00, 0x03, 0x10, 0x18, 0x0f, 0x07, 0xa3, 0x00, 0x03, 0x07, 0x0f, 0x18, 0x10, 0x81,
+    0x00, 0x03, 0x10, 0x18, 0x0f, 0x07, 0xff, 0x00, 0xa4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x86, 0x00,
+    0x89, 0x00, 0x80, 0x80, 0x85, 0x40, 0x80, 0x80, 0xa3, 0x00, 0x80, 0x80, 0x85, 0x40, 0x80, 0x80,
+    0x8e, 0x00, 0x07, 0xe0, 0x18, 0x04, 0x02, 0x01, 0x00, 0xc0, 0xe0, 0x83, 0xf0, 0x07, 0xe0, 0xc0,
+    0x00, 0x01, 0x02, 0x04, 0x18, 0xe0, 0x99, 0x00, 0x07, 0xe0, 0x18, 0x04, 0x02, 0x01, 0x00, 0xc0,
+    0xe0, 0x83, 0xf0, 0x07, 0xe0, 0xc0, 0x00, 0x01, 0x02, 0x04, 0x18, 0xe0, 0x89, 0x00, 0x07, 0x0f,
+    0x30, 0x40, 0x80, 0x00, 0x00, 0x07, 0x0f, 0x83, 0x1f, 0x07, 0x0f, 0x07, 0x00, 0x00, 0x80, 0x40,
+    0x30, 0x0f, 0x99, 0x00, 0x07, 0x0f, 0x30, 0x40, 0x80, 0x00, 0x00, 0x07, 0x0f, 0x83, 0x1f, 0x07,
+    0x0f, 0x07, 0x00, 0x00, 0x80, 0x40, 0x30, 0x0f, 0x8d, 0x00, 0x02, 0x01, 0x02, 0x02, 0x85, 0x04,
+    0x80, 0x02, 0x00, 0x01, 0xa1, 0x00, 0x02, 0x01, 0x02, 0x02, 0x85, 0x04, 0x80, 0x02, 0x00, 0x01,
+    0x8d, 0x00, 0xc3, 0x04, 0x83, 0x00, 0x00, 0x00, 0x6a, 0x00, 0xd4, 0x00, 0x07, 0xc0, 0x30, 0x08,
+    0x04, 0x04, 0x02, 0xc2, 0xe1, 0x83, 0xf1, 0x07, 0xe1, 0xc2, 0x02, 0x04, 0x04, 0x08, 0x30, 0xc0,
+    0x99, 0x00, 0x07, 0xc0, 0x30, 0x08, 0x04, 0x04, 0x02, 0xc2, 0xe1, 0x83, 0xf1, 0x07, 0xe1, 0xc2,
+    0x02, 0x04, 0x04, 0x08, 0x30, 0xc0, 0x89, 0x00, 0x07, 0x07, 0x18, 0x20, 0x40, 0x40, 0x80, 0x87,
+    0x0f, 0x83, 0x1f, 0x07, 0x0f, 0x87, 0x80, 0x40, 0x40, 0x20, 0x18, 0x07, 0x99, 0x00, 0x07, 0x07,
+    0x18, 0x20, 0x40, 0x40, 0x80, 0x87, 0x0f, 0x83, 0x1f, 0x07, 0x0f, 0x87, 0x80, 0x40, 0x40, 0x20,
+    0x18, 0x07, 0x90, 0x00, 0x85, 0x01, 0xa7, 0x00, 0x85, 0x01, 0x90, 0x00, 0x87, 0x04, 0xb1, 0x08,
+    0x87, 0x04, 0x83, 0x00, 0x00, 0x00, 0x66, 0x00, 0xd4, 0x00, 0x07, 0x80, 0x60, 0x30, 0x10, 0x08,
+    0x08, 0xcc, 0xe4, 0x83, 0xf4, 0x07, 0xe4, 0xcc, 0x08, 0x08, 0x10, 0x30, 0x60, 0x80, 0x99, 0x00,
+    0x07, 0x80, 0x60, 0x30, 0x10, 0x08, 0x08, 0xcc, 0xe4, 0x83, 0xf4, 0x07, 0xe4, 0xcc, 0x08, 0x08,
+    0x10, 0x30, 0x60, 0x80, 0x89, 0x00, 0x07, 0x03, 0x0c, 0x18, 0x10, 0x20, 0x20, 0x67, 0x4f, 0x83,
+    0x5f, 0x07, 0x4f, 0x67, 0x20, 0x20, 0x10, 0x18, 0x0c, 0x03, 0x99, 0x00, 0x07, 0x03, 0x0c, 0x18,
+    0x10, 0x20, 0x20, 0x67, 0x4f, 0x83, 0x5f, 0x07, 0x4f, 0x67, 0x20, 0x20, 0x10, 0x18, 0x0c, 0x03,
+    0xd9, 0x00, 0x82, 0x04, 0x88, 0x08, 0xa7, 0x10, 0x88, 0x08, 0x82, 0x04, 0x83, 0x00, 0x00, 0x00,
+    0x46, 0x00, 0xd7, 0x00, 0x80, 0x80, 0x80, 0x40, 0x85, 0x20, 0x80, 0x40, 0x80, 0x80, 0x9f, 0x00,
+    0x80, 0x80, 0x80, 0x40, 0x85, 0x20, 0x80, 0x40, 0x80, 0x80, 0x8d, 0x00, 0x02, 0x1c, 0x03, 0x01,
+    0x8b, 0x00, 0x02, 0x01, 0x03, 0x1c, 0x9b, 0x00, 0x02, 0x1c, 0x03, 0x01, 0x8b, 0x00, 0x02, 0x01,
+    0x03, 0x1c, 0xda, 0x00, 0x81, 0x04, 0x84, 0x08, 0x85, 0x10, 0x8b, 0x20, 0x89, 0x40, 0x8b, 0x20,
+    0x85, 0x10, 0x84, 0x08, 0x81, 0x04, 0x83, 0x00, 0x01, 0x00, 0x2a, 0x00, 0xff, 0x00, 0xff, 0x00,
+    0xc4, 0x00, 0x00, 0x0c, 0x81, 0x00, 0x81, 0x18, 0x80, 0x00, 0x83, 0x30, 0x00, 0x00, 0x87, 0x60,
+    0x81, 0xa0, 0x89, 0xc0, 0x81, 0xa0, 0x87, 0x60, 0x00, 0x00, 0x83, 0x30, 0x80, 0x00, 0x81, 0x18,
+    0x81, 0x00, 0x00, 0x0c, 0x85, 0x00, 0x01, 0x00, 0x2a, 0x00, 0xff, 0x00, 0xff, 0x00, 0xc7, 0x00,
+    0x00, 0x18, 0x81, 0x00, 0x80, 0x30, 0x80, 0x00, 0x82, 0x60, 0x00, 0x00, 0x85, 0xc0, 0x00, 0x40,
+    0x8f, 0x80, 0x00, 0x40, 0x85, 0xc0, 0x00, 0x00, 0x82, 0x60, 0x80, 0x00, 0x80, 0x30, 0x81, 0x00,
+    0x00, 0x18, 0x88, 0x00, 0x01, 0x00, 0x08, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x8b, 0x00,
+    0x01, 0x00, 0x08, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x8b, 0x00, 0x01, 0x00, 0x08, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x8b, 0x00, 0x01, 0x00, 0x08, 0x00, 0xff, 0x00, 0xff, 0x00,
+    0xff, 0x00, 0x8b, 0x00,
+};
+
+#endif // FACESPRITESDATA_H
@@ -0,0 +1,263 @@
+#include "SpriteAnim.h"
+#include <string.h>
+#include "TileFlusher.h"
+
+#ifdef ESP_PLATFORM
+#include <esp_partition.h>
+#endif
+
+// ========== 帧解码 ==========
+
+bool spriteDecodeFrame(const uint8_t* data, uint16_t bytes, uint8_t type,
+                       uint8_t width, uint8_t pages, int16_t x, int8_t page, uint8_t* buffer) {
+    const uint32_t total = (uint32_t)width * pages;
+    const bool delta = (type == SPRITE_FRAME_DELTA);
+    uint32_t pos = 0;      // 精灵内的字节序号（按页，每页 width 字节）
+    uint16_t col = 0;
+    int16_t row = page;    // 当前屏幕页
+    uint16_t i = 0;
+
+    while (i < bytes) {
+        uint8_t ctrl = data[i++];
+        bool run = (ctrl & 0x80) != 0;
+        uint16_t count = run ? (uint16_t)((ctrl & 0x7F) + 2) : (uint16_t)(ctrl + 1);
+        if (pos + count > total || i + (run ? 1 : count) > bytes) {
+            return false;
+        }
+        uint8_t value = run ? data[i] : 0;
+
+        // 差分帧中的 0 行程：内容未变，只移动位置
+        if (run && delta && value == 0) {
+            pos += count;
+            col = (uint16_t)(pos % width);
+            row = (int16_t)(page + pos / width);
+            i++;
+            continue;
+        }
+
+        for (uint16_t k = 0; k < count; k++) {
+            uint8_t v = run ? value : data[i + k];
+            int16_t px = (int16_t)(x + col);
+            if (row >= 0 && row < DISPLAY_TILE_ROWS && px >= 0 && px < DISPLAY_WIDTH) {
+                uint8_t* dst = buffer + row * DISPLAY_WIDTH + px;
+                *dst = delta ? (uint8_t)(*dst ^ v) : v;
+            }
+            if (++col == width) {
+                col = 0;
+                row++;
+            }
+        }
+        pos += count;
+        i += run ? 1 : count;
+    }
+    return pos == total;
+}
+
+// ========== 动画库 ==========
+
+SpriteBank::SpriteBank()
+    : _base(nullptr), _size(0), _entries(nullptr), _animCount(0) {}
+
+bool SpriteBank::attach(const uint8_t* base, size_t size) {
+    _base = nullptr;
+    _size = 0;
+    _entries = nullptr;
+    _animCount = 0;
+
+    if (base == nullptr || size < sizeof(SpriteBankHeader)) {
+        return false;
+    }
+
+    SpriteBankHeader header;
+    memcpy(&header, base, sizeof(header));
+    if (header.magic != SPRITE_BANK_MAGIC || header.version != SPRITE_BANK_VERSION) {
+        return false;
+    }
+
+    size_t tableEnd = sizeof(SpriteBankHeader) + (size_t)header.animCount * sizeof(SpriteAnimEntry);
+    if (tableEnd > size) {
+        return false;
+    }
+
+    // 逐帧检查帧头，避免坏分区导致越界读取；播放时不再检查帧头
+    const SpriteAnimEntry* entries = (const SpriteAnimEntry*)(base + sizeof(SpriteBankHeader));
+    for (uint16_t a = 0; a < header.animCount; a++) {
+        const SpriteAnimEntry& e = entries[a];
+        if (e.offset < tableEnd || e.offset > size || e.dataBytes > size - e.offset) {
+            return false;
+        }
+        if (e.width == 0 || e.width > DISPLAY_WIDTH || e.pages == 0 || e.pages > DISPLAY_TILE_ROWS ||
+            e.frameCount == 0 || e.frameMs == 0) {
+            return false;
+        }
+        uint32_t cursor = 0;
+        for (uint16_t f = 0; f < e.frameCount; f++) {
+            if (e.dataBytes - cursor < sizeof(SpriteFrameHeader)) {
+                return false;
+            }
+            SpriteFrameHeader fh;
+            memcpy(&fh, base + e.offset + cursor, sizeof(fh));
+            if (fh.type > SPRITE_FRAME_DELTA || (f == 0 && fh.type != SPRITE_FRAME_KEY)) {
+                return false;
+            }
+            cursor += sizeof(SpriteFrameHeader);
+            if (fh.bytes > e.dataBytes - cursor) {
+                return false;
+            }
+            cursor += fh.bytes;
+        }
+        if (cursor != e.dataBytes) {
+            return false;
+        }
+    }
+
+    _base = base;
+    _size = size;
+    _entries = entries;
+    _animCount = header.animCount;
+    return true;
+}
+
+#ifdef ESP_PLATFORM
+bool SpriteBank::mapPartition(const char* partitionLabel) {
+    const esp_partition_t* part = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, partitionLabel);
+    if (part == nullptr) {
+        return false;
+    }
+
+    // 映射整个分区到数据地址空间；映射句柄不释放，动画库在运行期常驻
+    const void* mapped = nullptr;
+    spi_flash_mmap_handle_t handle;
+    if (esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK) {
+        return false;
+    }
+
+    return attach((const uint8_t*)mapped, part->size);
+}
+#endif
+
+bool SpriteBank::getAnim(uint16_t index, SpriteClip& clip) const {
+    if (index >= _animCount) {
+        return false;
+    }
+
+    const SpriteAnimEntry& e = _entries[index];
+    clip.frames = _base + e.offset;
+    clip.dataBytes = e.dataBytes;
+    clip.frameCount = e.frameCount;
+    clip.frameMs = e.frameMs;
+    clip.width = e.width;
+    clip.pages = e.pages;
+    clip.flags = e.flags;
+    return true;
+}
+
+int SpriteBank::findAnim(const char* name) const {
+    for (uint16_t i = 0; i < _animCount; i++) {
+        if (strncmp(_entries[i].name, name, SPRITE_NAME_LEN) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char* SpriteBank::animName(uint16_t index) const {
+    return index < _animCount ? _entries[index].name : "";
+}
+
+// ========== 播放 ==========
+
+SpritePlayer::SpritePlayer()
+    : _x(0), _page(0), _loop(false), _playing(false), _frame(-1), _cursor(0),
+      _keyCursor(0), _keyFrame(0), _nextFrameMs(0), _timeValid(false) {
+    memset(&_clip, 0, sizeof(_clip));
+    resetStats();
+}
+
+void SpritePlayer::resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void SpritePlayer::play(const SpriteClip& clip, int16_t x, int8_t page, bool loop) {
+    _clip = clip;
+    _x = x;
+    _page = page;
+    _loop = loop;
+    _playing = clip.frames != nullptr && clip.frameCount > 0;
+    _frame = -1;
+    _cursor = 0;
+    _keyCursor = 0;
+    _keyFrame = 0;
+    _timeValid = false;
+}
+
+bool SpritePlayer::decodeNext(uint8_t* buffer) {
+    // 最后一帧之后回到第一帧（关键帧）
+    if (_frame + 1 >= _clip.frameCount) {
+        _frame = -1;
+        _cursor = 0;
+    }
+
+    SpriteFrameHeader fh;
+    memcpy(&fh, _clip.frames + _cursor, sizeof(fh));
+    const uint8_t* data = _clip.frames + _cursor + sizeof(fh);
+    if (fh.type == SPRITE_FRAME_KEY) {
+        _keyCursor = _cursor;
+        _keyFrame = (int16_t)(_frame + 1);
+        _stats.keyFrames++;
+    }
+    if (!spriteDecodeFrame(data, fh.bytes, fh.type, _clip.width, _clip.pages, _x, _page, buffer)) {
+        _stats.errors++;
+        _playing = false;
+        return false;
+    }
+
+    _cursor += sizeof(fh) + fh.bytes;
+    _frame++;
+    _stats.frames++;
+    _stats.bytesRead += sizeof(fh) + fh.bytes;
+    return true;
+}
+
+uint8_t SpritePlayer::update(uint32_t nowMs, uint8_t* buffer) {
+    if (!_playing) {
+        return 0;
+    }
+    if (!_timeValid) {
+        _nextFrameMs = nowMs;
+        _timeValid = true;
+    }
+
+    uint8_t decoded = 0;
+    while (_playing && (int32_t)(nowMs - _nextFrameMs) >= 0 && decoded < SPRITE_MAX_CATCHUP) {
+        if (!decodeNext(buffer)) {
+            break;
+        }
+        decoded++;
+        _nextFrameMs += _clip.frameMs;
+        if (!_loop && _frame + 1 >= _clip.frameCount) {
+            _playing = false;   // 停在最后一帧
+        }
+    }
+    if (_playing && (int32_t)(nowMs - _nextFrameMs) >= 0) {
+        _nextFrameMs = nowMs + _clip.frameMs;   // 落后太多：丢掉积压的时间
+        _stats.late++;
+    }
+    return decoded;
+}
+
+void SpritePlayer::redraw(uint8_t* buffer) {
+    if (_frame < 0) {
+        return;
+    }
+    // 从最近的关键帧重新解码到当前帧（不计入统计）
+    uint32_t cursor = _keyCursor;
+    for (int16_t f = _keyFrame; f <= _frame; f++) {
+        SpriteFrameHeader fh;
+        memcpy(&fh, _clip.frames + cursor, sizeof(fh));
+        spriteDecodeFrame(_clip.frames + cursor + sizeof(fh), fh.bytes, fh.type,
+                          _clip.width, _clip.pages, _x, _page, buffer);
+        cursor += sizeof(fh) + fh.bytes;
+    }
+}
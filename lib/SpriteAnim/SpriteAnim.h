@@ -0,0 +1,192 @@
+#ifndef SPRITE_ANIM_H
+#define SPRITE_ANIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * SpriteAnim - 闪存表情动画（压缩帧，直接解码进显示缓冲）
+ *
+ * 动画库由 tools/make_sprite_anim.py 在构建时从 PNG 序列生成，可以是独立的 data 分区（默认名 "sprites"，
+ * 用 esp_partition_mmap 映射），也可以是编译进程序的常量数组（ESP32 上同样位于经缓存映射的闪存中）。
+ * 播放时不做拷贝：SpritePlayer 从映射区逐字节读出行程编码，直接写进 U8g2 缓冲的精灵矩形。
+ *
+ * 精灵按 U8g2 缓冲格式存放（按页，每页 width 字节，每字节 8 行，bit0 在上），放置时 y 对齐到页。
+ * 每帧为关键帧（整帧内容）或差分帧（与上一帧的异或，未变化处为 0 的长行程，解码时直接跳过），
+ * 两者都用同一种行程编码：
+ *   控制字节 0x00~0x7F：后面跟 n+1 个原样字节
+ *   控制字节 0x80~0xFF：后面 1 个字节重复 (n & 0x7F) + 2 次
+ * 第一帧必须是关键帧，循环时回到第一帧。
+ *
+ * 二进制格式（小端）：
+ *   SpriteBankHeader                8 字节
+ *   SpriteAnimEntry[animCount]      每项 32 字节
+ *   每个动画：frameCount 个 { SpriteFrameHeader 4 字节 + 行程数据 }
+ */
+
+#define SPRITE_BANK_MAGIC    0x41535249  // "IRSA"
+#define SPRITE_BANK_VERSION  1
+#define SPRITE_NAME_LEN      16
+#define SPRITE_MAX_CATCHUP   4           // update() 落后时最多连续解码的帧数
+
+enum SpriteFrameType : uint8_t {
+    SPRITE_FRAME_KEY   = 0,   // 覆盖写入
+    SPRITE_FRAME_DELTA = 1    // 与缓冲中的上一帧异或
+};
+
+enum SpriteAnimFlags : uint8_t {
+    SPRITE_ANIM_LOOP = 0x01   // 默认循环播放（play() 可覆盖）
+};
+
+struct SpriteBankHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t animCount;
+};
+
+struct SpriteAnimEntry {
+    char     name[SPRITE_NAME_LEN];
+    uint8_t  width;        // 像素，1~128
+    uint8_t  pages;        // 高度（页），1~8
+    uint16_t frameCount;
+    uint16_t frameMs;      // 每帧时长
+    uint8_t  flags;
+    uint8_t  reserved;
+    uint32_t offset;       // 第一帧相对动画库起始地址
+    uint32_t dataBytes;    // 所有帧（含帧头）
+};
+
+struct SpriteFrameHeader {
+    uint8_t  type;
+    uint8_t  reserved;
+    uint16_t bytes;        // 行程数据字节数（不含帧头）
+};
+
+static_assert(sizeof(SpriteBankHeader) == 8, "SpriteBankHeader 布局错误");
+static_assert(sizeof(SpriteAnimEntry) == 32, "SpriteAnimEntry 布局错误");
+static_assert(sizeof(SpriteFrameHeader) == 4, "SpriteFrameHeader 布局错误");
+
+// 一段可播放的动画（指向映射区，不拥有数据）
+struct SpriteClip {
+    const uint8_t* frames;
+    uint32_t dataBytes;
+    uint16_t frameCount;
+    uint16_t frameMs;
+    uint8_t  width;
+    uint8_t  pages;
+    uint8_t  flags;
+};
+
+/**
+ * 把一帧行程数据解码进 128×64 显示缓冲
+ * 精灵左上角在 (x, page * 8)，超出屏幕的部分跳过；关键帧覆盖写入，差分帧异或
+ * @return 行程数据与 width × pages 不符（截断或多余）时返回 false，此时缓冲可能已部分写入
+ */
+bool spriteDecodeFrame(const uint8_t* data, uint16_t bytes, uint8_t type,
+                       uint8_t width, uint8_t pages, int16_t x, int8_t page, uint8_t* buffer);
+
+class SpriteBank {
+public:
+    SpriteBank();
+
+    /**
+     * 从一块内存解析动画库（设备端为映射地址或常量数组，主机端为文件内容）
+     * 逐帧检查帧头：越界、帧数不符、第一帧不是关键帧时返回 false
+     */
+    bool attach(const uint8_t* base, size_t size);
+
+#ifdef ESP_PLATFORM
+    /**
+     * 查找并映射闪存分区
+     * @param partitionLabel 分区名（partitions.csv 中的 Name）
+     */
+    bool mapPartition(const char* partitionLabel = "sprites");
+#endif
+
+    uint16_t animCount() const { return _animCount; }
+    bool getAnim(uint16_t index, SpriteClip& clip) const;
+    int findAnim(const char* name) const;  // 未找到返回 -1
+    const char* animName(uint16_t index) const;
+
+private:
+    const uint8_t* _base;
+    size_t _size;
+    const SpriteAnimEntry* _entries;
+    uint16_t _animCount;
+};
+
+struct SpritePlayerStats {
+    uint32_t frames;       // 解码的帧数
+    uint32_t keyFrames;
+    uint32_t bytesRead;    // 从闪存读出的字节（含帧头）
+    uint32_t late;         // 落后超过 SPRITE_MAX_CATCHUP 帧、丢弃积压时间的次数
+    uint32_t errors;       // 解码错误（之后停止播放）
+};
+
+/**
+ * SpritePlayer - 非阻塞动画播放
+ *
+ * 在主循环中调用 update(millis(), buffer)：到时间才解码下一帧，返回非 0 时只需发送精灵矩形。
+ * 差分帧基于缓冲中的上一帧，所以播放期间精灵矩形归播放器所有，其他绘制不要覆盖；
+ * 缓冲被整屏清空或重画后调用 redraw()，从最近的关键帧重新解码到当前帧。
+ */
+class SpritePlayer {
+public:
+    SpritePlayer();
+
+    /**
+     * 开始播放，下一次 update() 立即画出第一帧
+     * @param page 精灵顶部所在页（y = page * 8），可以为负或超出屏幕
+     * @param loop 循环播放；为 false 时停在最后一帧
+     */
+    void play(const SpriteClip& clip, int16_t x, int8_t page, bool loop);
+    void play(const SpriteClip& clip, int16_t x, int8_t page) {
+        play(clip, x, page, (clip.flags & SPRITE_ANIM_LOOP) != 0);
+    }
+
+    // 停止（缓冲保持当前帧）
+    void stop() { _playing = false; }
+    bool playing() const { return _playing; }
+
+    /**
+     * 按时间推进，每次最多连续解码 SPRITE_MAX_CATCHUP 帧（落后太多时丢弃积压时间，不跳过差分帧）
+     * @return 本次解码的帧数，0 表示缓冲未改变
+     */
+    uint8_t update(uint32_t nowMs, uint8_t* buffer);
+
+    // 缓冲被清空后重画当前帧
+    void redraw(uint8_t* buffer);
+
+    // 当前帧序号（尚未画出第一帧时为 -1）
+    int16_t frame() const { return _frame; }
+
+    // 精灵矩形（像素，未裁剪）
+    int16_t x() const { return _x; }
+    int16_t y() const { return (int16_t)(_page * 8); }
+    uint8_t width() const { return _clip.width; }
+    uint8_t height() const { return (uint8_t)(_clip.pages * 8); }
+
+    const SpritePlayerStats& stats() const { return _stats; }
+    void resetStats();
+
+private:
+    bool decodeNext(uint8_t* buffer);
+
+    SpriteClip _clip;
+    int16_t _x;
+    int8_t _page;
+    bool _loop;
+    bool _playing;
+
+    int16_t _frame;
+    uint32_t _cursor;      // 下一帧帧头在 _clip.frames 中的偏移
+    uint32_t _keyCursor;   // 最近关键帧的偏移，redraw() 从这里开始
+    int16_t _keyFrame;
+
+    uint32_t _nextFrameMs;
+    bool _timeValid;
+
+    SpritePlayerStats _stats;
+};
+
+#endif // SPRITE_ANIM_H
@@ -0,0 +1,204 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * SpscRing - 单生产者/单消费者无锁环形缓冲区
+ *
+ * 用于任务间数据流（I2S帧、T-Code字节、舵机命令、遥测），
+ * 取代 audioBuffer / bytesRead 这类无同步的全局变量。
+ *
+ * 设计要点：
+ * - 容量 N 必须是2的幂，下标用位与取模
+ * - 读写下标自由增长（不回绕），已用数量 = head - tail
+ * - 生产者只写 _head，消费者只写 _tail，两者各占一条缓存行，避免伪共享
+ * - 发布数据用 release，读取对端下标用 acquire
+ * - 每端缓存一份对端下标，只有在看起来满/空时才重新读取原子变量
+ *
+ * 零拷贝批量接口：
+ *   生产者：claim() 拿到连续可写槽位 -> 直接写入 -> commit(n) 发布
+ *   消费者：peek()  拿到连续可读槽位 -> 直接处理 -> release(n) 归还
+ *
+ * 注意：同一时刻只能有一个生产者线程和一个消费者线程。
+ */
+
+#ifndef SPSC_CACHE_LINE
+#define SPSC_CACHE_LINE 64  // ESP32-S3 数据缓存行最大64字节，主机端同样取64
+#endif
+
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing: N 必须是2的幂");
+
+public:
+    static constexpr size_t CAPACITY = N;
+
+    SpscRing() : _head(0), _cachedTail(0), _tail(0), _cachedHead(0) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // ========== 生产者端 ==========
+
+    /**
+     * 写入一个元素
+     * @return 缓冲区已满时返回 false
+     */
+    bool push(const T& value) {
+        T* slot;
+        if (claim(&slot, 1) == 0) {
+            return false;
+        }
+        *slot = value;
+        commit(1);
+        return true;
+    }
+
+    /**
+     * 申请连续可写槽位（零拷贝）
+     * 返回的区间不会跨越缓冲区末尾，因此可能小于实际空闲数量；
+     * 需要更多空间时，commit 后再次 claim 即可拿到回绕后的部分。
+     * @param slot     输出：首个可写槽位
+     * @param maxCount 最多申请多少个
+     * @return 实际可写数量（0 表示已满）
+     */
+    size_t claim(T** slot, size_t maxCount) {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        size_t freeCount = N - (head - _cachedTail);
+        if (freeCount < maxCount) {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            freeCount = N - (head - _cachedTail);
+        }
+
+        const size_t index = head & MASK;
+        size_t count = N - index;  // 到缓冲区末尾的连续长度
+        if (count > freeCount) count = freeCount;
+        if (count > maxCount) count = maxCount;
+
+        *slot = &_buffer[index];
+        return count;
+    }
+
+    /**
+     * 发布 claim 后写入的 count 个元素
+     * count 不得超过上一次 claim 的返回值
+     */
+    void commit(size_t count) {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        _head.store(head + count, std::memory_order_release);
+    }
+
+    /**
+     * 批量写入（内部使用 claim/commit，最多两段拷贝）
+     * @return 实际写入数量
+     */
+    size_t write(const T* data, size_t count) {
+        size_t written = 0;
+        while (written < count) {
+            T* slot;
+            size_t n = claim(&slot, count - written);
+            if (n == 0) break;
+            for (size_t i = 0; i < n; i++) {
+                slot[i] = data[written + i];
+            }
+            commit(n);
+            written += n;
+        }
+        return written;
+    }
+
+    // ========== 消费者端 ==========
+
+    /**
+     * 读取一个元素
+     * @return 缓冲区为空时返回 false
+     */
+    bool pop(T& out) {
+        const T* slot;
+        if (peek(&slot, 1) == 0) {
+            return false;
+        }
+        out = *slot;
+        release(1);
+        return true;
+    }
+
+    /**
+     * 获取连续可读槽位（零拷贝）
+     * 与 claim 相同，返回区间不跨越缓冲区末尾。
+     * @return 实际可读数量（0 表示为空）
+     */
+    size_t peek(const T** slot, size_t maxCount) {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t available = _cachedHead - tail;
+        if (available < maxCount) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            available = _cachedHead - tail;
+        }
+
+        const size_t index = tail & MASK;
+        size_t count = N - index;
+        if (count > available) count = available;
+        if (count > maxCount) count = maxCount;
+
+        *slot = &_buffer[index];
+        return count;
+    }
+
+    /**
+     * 归还 peek 后处理完的 count 个槽位
+     */
+    void release(size_t count) {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        _tail.store(tail + count, std::memory_order_release);
+    }
+
+    /**
+     * 批量读取
+     * @return 实际读取数量
+     */
+    size_t read(T* out, size_t count) {
+        size_t readCount = 0;
+        while (readCount < count) {
+            const T* slot;
+            size_t n = peek(&slot, count - readCount);
+            if (n == 0) break;
+            for (size_t i = 0; i < n; i++) {
+                out[readCount + i] = slot[i];
+            }
+            release(n);
+            readCount += n;
+        }
+        return readCount;
+    }
+
+    // ========== 状态查询（任意线程，结果仅为近似值） ==========
+
+    size_t size() const {
+        const size_t tail = _tail.load(std::memory_order_acquire);
+        const size_t head = _head.load(std::memory_order_acquire);
+        return head - tail;
+    }
+
+    bool empty() const { return size() == 0; }
+    bool full() const { return size() >= N; }
+    constexpr size_t capacity() const { return N; }
+
+private:
+    static constexpr size_t MASK = N - 1;
+
+    // 生产者独占的缓存行
+    alignas(SPSC_CACHE_LINE) std::atomic<size_t> _head;
+    size_t _cachedTail;
+
+    // 消费者独占的缓存行
+    alignas(SPSC_CACHE_LINE) std::atomic<size_t> _tail;
+    size_t _cachedHead;
+
+    alignas(SPSC_CACHE_LINE) T _buffer[N];
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,229 @@
+#include "StateMachine.h"
+#include <string.h>
+
+StateMachine::StateMachine(const SmStateDef* states, uint8_t stateCount,
+                           const SmTransition* transitions, uint8_t transitionCount, void* ctx)
+    : _states(states), _stateCount(stateCount), _transitions(transitions), _transitionCount(transitionCount),
+      _ctx(ctx), _eventNames(nullptr), _eventCount(0), _state(0), _nowMs(0), _enteredMs(0),
+      _queueHead(0), _queueCount(0), _traceNext(0), _traceCount(0) {
+    memset(_timers, 0, sizeof(_timers));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void StateMachine::setEventNames(const char* const* names, uint8_t count) {
+    _eventNames = names;
+    _eventCount = count;
+}
+
+void StateMachine::begin(uint8_t initial, uint32_t nowMs) {
+    _nowMs = nowMs;
+    _queueHead = 0;
+    _queueCount = 0;
+    _traceNext = 0;
+    _traceCount = 0;
+    memset(_timers, 0, sizeof(_timers));
+    memset(&_stats, 0, sizeof(_stats));
+
+    _state = initial < _stateCount ? initial : 0;
+    _enteredMs = nowMs;
+    SmEvent none = {SM_NO_EVENT, 0, nowMs};
+    if (_states[_state].onEntry != nullptr) {
+        _states[_state].onEntry(_ctx, none);
+    }
+}
+
+// ========== 事件队列 ==========
+
+bool StateMachine::post(uint8_t event, int32_t arg) {
+    SmEvent e = {event, arg, _nowMs};
+    if (!enqueue(e, SM_MAX_TIMERS, 0)) {
+        _stats.dropped++;
+        return false;
+    }
+    return true;
+}
+
+bool StateMachine::enqueue(const SmEvent& event, uint8_t timer, uint16_t generation) {
+    if (_queueCount >= SM_QUEUE_SIZE) {
+        return false;
+    }
+    QueuedEvent& q = _queue[(_queueHead + _queueCount) % SM_QUEUE_SIZE];
+    q.event = event;
+    q.timer = timer;
+    q.generation = generation;
+    _queueCount++;
+    return true;
+}
+
+uint8_t StateMachine::process(uint32_t nowMs) {
+    _nowMs = nowMs;
+    fireTimers(nowMs);
+
+    uint8_t handled = 0;
+    while (_queueCount > 0 && handled < SM_QUEUE_SIZE * 2) {
+        QueuedEvent q = _queue[_queueHead];
+        _queueHead = (uint8_t)((_queueHead + 1) % SM_QUEUE_SIZE);
+        _queueCount--;
+        // 入队后定时器被停止、重启或随状态取消：事件已过期
+        if (q.timer < SM_MAX_TIMERS && _timers[q.timer].generation != q.generation) {
+            _stats.cancelled++;
+            continue;
+        }
+        dispatch(q.event);
+        handled++;
+    }
+    return handled;
+}
+
+// ========== 转换 ==========
+
+void StateMachine::dispatch(const SmEvent& event) {
+    _stats.events++;
+
+    for (uint8_t i = 0; i < _transitionCount; i++) {
+        const SmTransition& t = _transitions[i];
+        if (t.event != event.id || (t.from != SM_ANY_STATE && t.from != _state)) {
+            continue;
+        }
+        if (t.guard != nullptr && !t.guard(_ctx, event)) {
+            continue;
+        }
+
+        uint8_t from = _state;
+        if (t.to == SM_INTERNAL || t.to >= _stateCount) {
+            // 内部转换：不退出、不进入，定时器保留
+            record(event, from, from);
+            _stats.internal++;
+            if (t.action != nullptr) {
+                t.action(_ctx, event);
+            }
+            return;
+        }
+
+        record(event, from, t.to);
+        _stats.transitions++;
+        if (_states[from].onExit != nullptr) {
+            _states[from].onExit(_ctx, event);
+        }
+        if (t.action != nullptr) {
+            t.action(_ctx, event);
+        }
+        // 定时器属于离开的状态
+        for (Timer& timer : _timers) {
+            cancelTimer(timer);
+        }
+        _state = t.to;
+        _enteredMs = _nowMs;
+        if (_states[_state].onEntry != nullptr) {
+            _states[_state].onEntry(_ctx, event);
+        }
+        return;
+    }
+
+    _stats.unhandled++;
+}
+
+void StateMachine::record(const SmEvent& event, uint8_t from, uint8_t to) {
+    SmTraceEntry& e = _trace[_traceNext];
+    e.timeMs = _nowMs;
+    e.from = from;
+    e.to = to;
+    e.event = event.id;
+    e.arg = event.arg;
+    _traceNext = (uint8_t)((_traceNext + 1) % SM_TRACE_SIZE);
+    if (_traceCount < SM_TRACE_SIZE) {
+        _traceCount++;
+    }
+}
+
+const SmTraceEntry* StateMachine::trace(uint8_t index) const {
+    if (index >= _traceCount) {
+        return nullptr;
+    }
+    uint8_t oldest = (uint8_t)((_traceNext + SM_TRACE_SIZE - _traceCount) % SM_TRACE_SIZE);
+    return &_trace[(oldest + index) % SM_TRACE_SIZE];
+}
+
+// ========== 定时器 ==========
+
+bool StateMachine::startTimer(uint8_t timer, uint32_t delayMs, uint8_t event, bool periodic) {
+    if (timer >= SM_MAX_TIMERS || (periodic && delayMs == 0)) {
+        return false;
+    }
+    Timer& t = _timers[timer];
+    t.dueMs = _nowMs + delayMs;
+    t.periodMs = periodic ? delayMs : 0;
+    t.event = event;
+    t.active = true;
+    t.generation++;
+    return true;
+}
+
+bool StateMachine::stopTimer(uint8_t timer) {
+    if (timer >= SM_MAX_TIMERS) {
+        return false;
+    }
+    cancelTimer(_timers[timer]);
+    return true;
+}
+
+void StateMachine::cancelTimer(Timer& timer) {
+    timer.active = false;
+    timer.generation++;
+}
+
+bool StateMachine::timerActive(uint8_t timer) const {
+    return timer < SM_MAX_TIMERS && _timers[timer].active;
+}
+
+void StateMachine::fireTimers(uint32_t nowMs) {
+    for (uint8_t i = 0; i < SM_MAX_TIMERS; i++) {
+        Timer& t = _timers[i];
+        if (!t.active || (int32_t)(nowMs - t.dueMs) < 0) {
+            continue;
+        }
+        uint32_t due = t.dueMs;
+        if (t.periodMs == 0) {
+            t.active = false;
+        } else {
+            t.dueMs += t.periodMs;
+            // 落后超过一个周期（例如处理被阻塞）：只补一次，之后从现在重新计
+            if ((int32_t)(nowMs - t.dueMs) >= 0) {
+                t.dueMs = nowMs + t.periodMs;
+            }
+        }
+        _stats.timerFires++;
+        SmEvent e = {t.event, 0, due};
+        if (!enqueue(e, i, t.generation)) {
+            _stats.dropped++;
+        }
+    }
+}
+
+uint32_t StateMachine::msUntilNextTimer(uint32_t nowMs) const {
+    uint32_t next = UINT32_MAX;
+    for (const Timer& t : _timers) {
+        if (!t.active) {
+            continue;
+        }
+        int32_t left = (int32_t)(t.dueMs - nowMs);
+        uint32_t ms = left > 0 ? (uint32_t)left : 0;
+        if (ms < next) {
+            next = ms;
+        }
+    }
+    return next;
+}
+
+// ========== 查询 ==========
+
+const char* StateMachine::stateName(uint8_t state) const {
+    return state < _stateCount ? _states[state].name : "?";
+}
+
+const char* StateMachine::eventName(uint8_t event) const {
+    if (event == SM_NO_EVENT) {
+        return "begin";
+    }
+    return (_eventNames != nullptr && event < _eventCount) ? _eventNames[event] : "?";
+}
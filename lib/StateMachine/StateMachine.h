@@ -0,0 +1,175 @@
+#ifndef STATE_MACHINE_H
+#define STATE_MACHINE_H
+
+#include <stdint.h>
+
+/**
+ * StateMachine - 表驱动状态机（事件队列、进入/退出动作、定时器、转换轨迹）
+ *
+ * 原来每个状态一个处理函数，每轮都运行一遍：自己轮询音量和时间来判断转换，
+ * 用函数内 static 标志（例如"已转向"）记住进入后做过的事，离开状态时这些标志不会复位。
+ * 本模块：
+ * - 状态表：每个状态的名称、进入动作、退出动作
+ * - 转换表：{当前状态, 事件, 目标状态, 守卫, 动作}，按表中顺序取第一条匹配且守卫通过的；
+ *   当前状态可写 SM_ANY_STATE，目标可写 SM_INTERNAL（内部转换：只运行动作，不退出/进入）
+ * - 外部转换的顺序：退出动作 → 转换动作 → 切换状态 → 进入动作（进入动作收到触发事件）
+ * - 事件经固定长度队列：post() 只入队，process() 处理队列中已有的事件；没有事件时什么都不运行
+ * - 定时器到期时入队一个事件；状态切换时全部定时器取消（定时器属于状态，由进入动作启动），
+ *   已入队但尚未处理的定时器事件在定时器停止、重启或取消后丢弃，不会在新状态中迟到
+ * - 最近 SM_TRACE_SIZE 次转换（含内部转换）带时间戳记录在环形轨迹中
+ *
+ * 时间为毫秒，按有符号差比较（millis() 回绕后仍然正确）。
+ * 不分配堆内存；只在一个线程中使用，其他任务的事件应先经队列交给该线程。
+ */
+
+#define SM_QUEUE_SIZE   16
+#define SM_MAX_TIMERS   4
+#define SM_TRACE_SIZE   16
+#define SM_ANY_STATE    0xFF   // 转换表：任意当前状态
+#define SM_INTERNAL     0xFE   // 转换表：内部转换
+#define SM_NO_EVENT     0xFF   // begin() 时进入动作收到的事件
+
+struct SmEvent {
+    uint8_t id;
+    int32_t arg;       // 事件参数（例如声源方向、音效编号）
+    uint32_t timeMs;   // 入队时刻（定时器事件为到期时刻）
+};
+
+// 动作：ctx 为构造时传入的上下文
+typedef void (*SmActionFn)(void* ctx, const SmEvent& event);
+// 守卫：返回 false 时跳过这条转换，继续匹配下一条
+typedef bool (*SmGuardFn)(void* ctx, const SmEvent& event);
+
+struct SmStateDef {
+    const char* name;
+    SmActionFn onEntry;   // 可为空
+    SmActionFn onExit;    // 可为空
+};
+
+struct SmTransition {
+    uint8_t from;         // 状态编号或 SM_ANY_STATE
+    uint8_t event;
+    uint8_t to;           // 状态编号或 SM_INTERNAL
+    SmGuardFn guard;      // 可为空
+    SmActionFn action;    // 可为空
+};
+
+struct SmTraceEntry {
+    uint32_t timeMs;
+    uint8_t from;
+    uint8_t to;           // 内部转换时等于 from
+    uint8_t event;
+    int32_t arg;
+};
+
+struct SmStats {
+    uint32_t events;        // 处理的事件
+    uint32_t transitions;   // 外部转换
+    uint32_t internal;      // 内部转换
+    uint32_t unhandled;     // 没有匹配转换的事件
+    uint32_t dropped;       // 队列满而丢弃的事件
+    uint32_t timerFires;    // 定时器到期次数
+    uint32_t cancelled;     // 入队后定时器被停止/重启/取消而丢弃的定时器事件
+};
+
+class StateMachine {
+public:
+    /**
+     * @param states 状态表（下标即状态编号）
+     * @param transitions 转换表（按顺序匹配）
+     * @param ctx 传给动作和守卫的上下文
+     */
+    StateMachine(const SmStateDef* states, uint8_t stateCount,
+                 const SmTransition* transitions, uint8_t transitionCount, void* ctx = nullptr);
+
+    // 事件名称（用于打印轨迹），可不设置
+    void setEventNames(const char* const* names, uint8_t count);
+
+    // 进入初始状态（运行其进入动作），清空队列、定时器和轨迹
+    void begin(uint8_t initial, uint32_t nowMs);
+
+    /**
+     * 事件入队，在下一次 process() 中处理（动作中入队的事件在同一次 process() 中处理）
+     * @return 队列已满时返回 false（计入 dropped）
+     */
+    bool post(uint8_t event, int32_t arg = 0);
+
+    /**
+     * 把到期的定时器转成事件，处理队列中的事件
+     * 一次最多处理 SM_QUEUE_SIZE × 2 个事件，防止动作互相入队时一直占住
+     * @return 处理的事件数（不含过期的定时器事件）
+     */
+    uint8_t process(uint32_t nowMs);
+
+    // ========== 定时器（由动作调用，以当前处理时刻为起点） ==========
+
+    /**
+     * 启动（或重新启动）定时器：delayMs 后入队 event
+     * @param periodic true 时到期后按 delayMs 周期重复
+     */
+    bool startTimer(uint8_t timer, uint32_t delayMs, uint8_t event, bool periodic = false);
+    bool stopTimer(uint8_t timer);
+    bool timerActive(uint8_t timer) const;
+    // 距最近一个定时器到期的毫秒数，没有定时器时返回 UINT32_MAX
+    uint32_t msUntilNextTimer(uint32_t nowMs) const;
+
+    // ========== 查询 ==========
+
+    uint8_t state() const { return _state; }
+    const char* stateName(uint8_t state) const;
+    const char* eventName(uint8_t event) const;
+    uint32_t timeInStateMs(uint32_t nowMs) const { return nowMs - _enteredMs; }
+    bool pending() const { return _queueCount > 0; }
+    const SmStats& stats() const { return _stats; }
+
+    // 轨迹：0 为最早的一条
+    uint8_t traceCount() const { return _traceCount; }
+    const SmTraceEntry* trace(uint8_t index) const;
+
+private:
+    struct Timer {
+        uint32_t dueMs;
+        uint32_t periodMs;   // 0 为单次
+        uint8_t event;
+        bool active;
+        uint16_t generation; // 每次启动/停止/取消加一，用来识别队列中过期的定时器事件
+    };
+
+    struct QueuedEvent {
+        SmEvent event;
+        uint8_t timer;       // 产生事件的定时器，post() 入队的为 SM_MAX_TIMERS
+        uint16_t generation;
+    };
+
+    void dispatch(const SmEvent& event);
+    void fireTimers(uint32_t nowMs);
+    void record(const SmEvent& event, uint8_t from, uint8_t to);
+    bool enqueue(const SmEvent& event, uint8_t timer, uint16_t generation);
+    void cancelTimer(Timer& timer);
+
+    const SmStateDef* _states;
+    uint8_t _stateCount;
+    const SmTransition* _transitions;
+    uint8_t _transitionCount;
+    void* _ctx;
+    const char* const* _eventNames;
+    uint8_t _eventCount;
+
+    uint8_t _state;
+    uint32_t _nowMs;
+    uint32_t _enteredMs;
+
+    QueuedEvent _queue[SM_QUEUE_SIZE];
+    uint8_t _queueHead;
+    uint8_t _queueCount;
+
+    Timer _timers[SM_MAX_TIMERS];
+
+    SmTraceEntry _trace[SM_TRACE_SIZE];
+    uint8_t _traceNext;
+    uint8_t _traceCount;
+
+    SmStats _stats;
+};
+
+#endif // STATE_MACHINE_H
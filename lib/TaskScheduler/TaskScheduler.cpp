@@ -0,0 +1,206 @@
+#include "TaskScheduler.h"
+#include <string.h>
+
+// a 是否不晚于 b（按有符号差，允许回绕）
+static inline bool notAfter(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) <= 0;
+}
+
+TaskScheduler::TaskScheduler(SchedulerClock& clock) : _clock(clock) {
+    memset(_slots, 0, sizeof(_slots));
+    memset(&_totals, 0, sizeof(_totals));
+}
+
+int8_t TaskScheduler::add(const char* name, SchedTaskFn fn, void* arg, uint32_t periodUs, uint8_t priority,
+                          uint32_t deadlineUs, uint32_t delayUs) {
+    if (fn == nullptr) {
+        return SCHED_NO_TASK;
+    }
+    for (int8_t i = 0; i < SCHED_MAX_TASKS; i++) {
+        Slot& s = _slots[i];
+        if (s.used) {
+            continue;
+        }
+        memset(&s, 0, sizeof(s));
+        s.name = name;
+        s.fn = fn;
+        s.arg = arg;
+        s.periodUs = periodUs;
+        s.deadlineUs = deadlineUs;
+        s.releaseUs = _clock.nowUs() + delayUs;
+        s.priority = priority;
+        s.used = true;
+        s.enabled = true;
+        return i;
+    }
+    return SCHED_NO_TASK;
+}
+
+int8_t TaskScheduler::addPeriodic(const char* name, SchedTaskFn fn, void* arg, uint32_t periodUs, uint8_t priority,
+                                  uint32_t deadlineUs, uint32_t phaseUs) {
+    if (periodUs == 0) {
+        return SCHED_NO_TASK;
+    }
+    return add(name, fn, arg, periodUs, priority, deadlineUs ? deadlineUs : periodUs, phaseUs);
+}
+
+int8_t TaskScheduler::addOneShot(const char* name, SchedTaskFn fn, void* arg, uint32_t delayUs, uint8_t priority,
+                                 uint32_t deadlineUs) {
+    return add(name, fn, arg, 0, priority, deadlineUs, delayUs);
+}
+
+bool TaskScheduler::valid(int8_t id) const {
+    return id >= 0 && id < SCHED_MAX_TASKS && _slots[id].used;
+}
+
+bool TaskScheduler::remove(int8_t id) {
+    if (!valid(id)) {
+        return false;
+    }
+    _slots[id].used = false;
+    return true;
+}
+
+bool TaskScheduler::setEnabled(int8_t id, bool enabled) {
+    if (!valid(id)) {
+        return false;
+    }
+    Slot& s = _slots[id];
+    if (enabled && !s.enabled) {
+        s.releaseUs = _clock.nowUs();
+    }
+    s.enabled = enabled;
+    return true;
+}
+
+bool TaskScheduler::setPeriod(int8_t id, uint32_t periodUs) {
+    if (!valid(id) || _slots[id].periodUs == 0 || periodUs == 0) {
+        return false;
+    }
+    Slot& s = _slots[id];
+    // 截止时间原来等于周期时跟着改
+    if (s.deadlineUs == s.periodUs) {
+        s.deadlineUs = periodUs;
+    }
+    s.periodUs = periodUs;
+    return true;
+}
+
+// ========== 调度 ==========
+
+int8_t TaskScheduler::pickReady(uint32_t now) const {
+    int8_t best = SCHED_NO_TASK;
+    uint32_t bestDue = 0;
+    for (int8_t i = 0; i < SCHED_MAX_TASKS; i++) {
+        const Slot& s = _slots[i];
+        if (!s.used || !s.enabled || !notAfter(s.releaseUs, now)) {
+            continue;
+        }
+        // 没有截止时间的单次任务排在同优先级的最后
+        uint32_t due = s.releaseUs + (s.deadlineUs ? s.deadlineUs : 0x7FFFFFFFu);
+        if (best == SCHED_NO_TASK || s.priority > _slots[best].priority ||
+            (s.priority == _slots[best].priority && (int32_t)(due - bestDue) < 0)) {
+            best = i;
+            bestDue = due;
+        }
+    }
+    return best;
+}
+
+bool TaskScheduler::runOnce() {
+    uint32_t start = _clock.nowUs();
+    int8_t id = pickReady(start);
+    if (id == SCHED_NO_TASK) {
+        return false;
+    }
+    Slot& s = _slots[id];
+    SchedTaskFn fn = s.fn;
+    uint32_t release = s.releaseUs;
+
+    fn(s.arg, start);
+
+    uint32_t end = _clock.nowUs();
+    uint32_t runUs = end - start;
+    uint32_t latencyUs = start - release;
+    bool overrun = s.deadlineUs != 0 && (int32_t)(end - (release + s.deadlineUs)) > 0;
+    uint32_t skipped = 0;
+
+    // 任务在运行中把自己移除（或移除后槽位被新任务占用）时不再重新安排
+    bool stillMine = s.used && s.fn == fn && s.releaseUs == release;
+    if (stillMine) {
+        if (s.periodUs == 0) {
+            s.used = false;
+        } else {
+            s.releaseUs += s.periodUs;
+            // 已经错过下一次释放：跳到结束时刻之后的第一个释放点，保持相位
+            if ((int32_t)(end - s.releaseUs) > 0) {
+                skipped = (end - s.releaseUs + s.periodUs - 1) / s.periodUs;
+                s.releaseUs += skipped * s.periodUs;
+            }
+        }
+    }
+
+    SchedTaskStats* all[2] = {&_totals, stillMine ? &s.stats : nullptr};
+    for (SchedTaskStats* st : all) {
+        if (st == nullptr) {
+            continue;
+        }
+        st->runs++;
+        st->overruns += overrun ? 1 : 0;
+        st->skipped += skipped;
+        st->totalRunUs += runUs;
+        if (latencyUs > st->maxLatencyUs) {
+            st->maxLatencyUs = latencyUs;
+        }
+        if (runUs > st->maxRunUs) {
+            st->maxRunUs = runUs;
+        }
+    }
+    return true;
+}
+
+uint32_t TaskScheduler::runReady() {
+    // 每个任务一轮最多运行几次；上限防止周期短于运行时间的任务一直占住
+    for (int n = 0; n < SCHED_MAX_TASKS * 4 && runOnce(); n++) {
+    }
+
+    uint32_t now = _clock.nowUs();
+    uint32_t idle = SCHED_IDLE_MAX_US;
+    for (const Slot& s : _slots) {
+        if (!s.used || !s.enabled) {
+            continue;
+        }
+        if (notAfter(s.releaseUs, now)) {
+            return 0;
+        }
+        if (s.releaseUs - now < idle) {
+            idle = s.releaseUs - now;
+        }
+    }
+    return idle;
+}
+
+// ========== 统计 ==========
+
+const SchedTaskStats* TaskScheduler::stats(int8_t id) const {
+    return valid(id) ? &_slots[id].stats : nullptr;
+}
+
+const char* TaskScheduler::taskName(int8_t id) const {
+    return valid(id) ? _slots[id].name : nullptr;
+}
+
+uint8_t TaskScheduler::count() const {
+    uint8_t n = 0;
+    for (const Slot& s : _slots) {
+        n += s.used ? 1 : 0;
+    }
+    return n;
+}
+
+void TaskScheduler::resetStats() {
+    for (Slot& s : _slots) {
+        memset(&s.stats, 0, sizeof(s.stats));
+    }
+    memset(&_totals, 0, sizeof(_totals));
+}
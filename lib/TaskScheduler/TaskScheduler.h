@@ -0,0 +1,119 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+/**
+ * TaskScheduler - 按截止时间调度的协作式任务表
+ *
+ * 原来 loop() 依次调用状态处理、串口轮询，然后 delay(10)：所有子系统共用一个节拍，
+ * 任何一个慢调用都会推迟其他所有子系统。本模块：
+ * - 周期任务和单次任务，各自有周期、截止时间（相对释放时刻）和优先级
+ * - runOnce() 在到期任务中选优先级最高的运行；优先级相同时截止时间早的先运行
+ * - 协作式：任务运行完才会切换，一次 runReady() 运行所有到期任务，返回距下一个释放的时间
+ * - 完成时间超过截止时间计为超时（overruns）；落后超过一个周期的释放直接跳过并计数（skipped），
+ *   释放时刻保持在 起点 + n × 周期 上，不会因为迟到而漂移
+ * - 时间为 32 位微秒，按有符号差比较，micros() 回绕（约 71 分钟）后仍然正确
+ *
+ * 时间来源经 SchedulerClock：设备端 MicrosClock（micros()），主机端 VirtualClock
+ * （lib/TaskScheduler/VirtualClock.h，任务用 advance() 模拟耗时）。
+ * 任务表为固定数组，不分配堆内存；每个实例只在一个线程（Arduino loop 或一个流水线阶段）中使用。
+ */
+
+#define SCHED_MAX_TASKS    12
+#define SCHED_NO_TASK      -1
+#define SCHED_IDLE_MAX_US  100000   // runReady() 返回的空闲时间上限
+
+// 任务函数：arg 为添加任务时的参数，nowUs 为开始运行的时刻
+typedef void (*SchedTaskFn)(void* arg, uint32_t nowUs);
+
+class SchedulerClock {
+public:
+    virtual ~SchedulerClock() {}
+    virtual uint32_t nowUs() = 0;
+};
+
+#ifdef ARDUINO
+class MicrosClock : public SchedulerClock {
+public:
+    uint32_t nowUs() override { return micros(); }
+};
+#endif
+
+struct SchedTaskStats {
+    uint32_t runs;
+    uint32_t overruns;       // 完成时间超过截止时间
+    uint32_t skipped;        // 落后超过一个周期而跳过的释放
+    uint32_t maxLatencyUs;   // 释放到开始运行的最大延迟
+    uint32_t maxRunUs;       // 单次最长运行时间
+    uint64_t totalRunUs;
+};
+
+class TaskScheduler {
+public:
+    explicit TaskScheduler(SchedulerClock& clock);
+
+    /**
+     * 添加周期任务
+     * @param periodUs 周期（> 0）
+     * @param priority 数值越大越优先
+     * @param deadlineUs 相对释放时刻的截止时间，0 表示等于周期
+     * @param phaseUs 第一次释放相对现在的延迟
+     * @return 任务编号，任务表满或参数无效时返回 SCHED_NO_TASK
+     */
+    int8_t addPeriodic(const char* name, SchedTaskFn fn, void* arg, uint32_t periodUs, uint8_t priority,
+                       uint32_t deadlineUs = 0, uint32_t phaseUs = 0);
+
+    /**
+     * 添加单次任务：delayUs 后运行一次，运行后自动移除
+     * @param deadlineUs 相对释放时刻的截止时间，0 表示没有截止时间
+     */
+    int8_t addOneShot(const char* name, SchedTaskFn fn, void* arg, uint32_t delayUs, uint8_t priority,
+                      uint32_t deadlineUs = 0);
+
+    bool remove(int8_t id);
+    // 重新启用时立即释放（下一次 runOnce() 即可运行）
+    bool setEnabled(int8_t id, bool enabled);
+    // 新周期从下一次释放之后生效
+    bool setPeriod(int8_t id, uint32_t periodUs);
+
+    // 运行一个到期任务；没有到期任务时返回 false
+    bool runOnce();
+    // 运行所有到期任务，返回距下一个释放的时间（us，不超过 SCHED_IDLE_MAX_US）
+    uint32_t runReady();
+
+    const SchedTaskStats* stats(int8_t id) const;   // 编号无效时返回 nullptr
+    const char* taskName(int8_t id) const;
+    const SchedTaskStats& totals() const { return _totals; }   // 全部任务（含已移除的单次任务）的累计
+    uint8_t count() const;
+    void resetStats();
+
+private:
+    struct Slot {
+        const char* name;
+        SchedTaskFn fn;
+        void* arg;
+        uint32_t periodUs;     // 0 为单次任务
+        uint32_t deadlineUs;   // 0 为没有截止时间
+        uint32_t releaseUs;
+        uint8_t priority;
+        bool used;
+        bool enabled;
+        SchedTaskStats stats;
+    };
+
+    int8_t add(const char* name, SchedTaskFn fn, void* arg, uint32_t periodUs, uint8_t priority,
+               uint32_t deadlineUs, uint32_t delayUs);
+    bool valid(int8_t id) const;
+    int8_t pickReady(uint32_t now) const;
+
+    SchedulerClock& _clock;
+    Slot _slots[SCHED_MAX_TASKS];
+    SchedTaskStats _totals;
+};
+
+#endif // TASK_SCHEDULER_H
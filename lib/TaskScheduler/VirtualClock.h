@@ -0,0 +1,41 @@
+#ifndef VIRTUAL_CLOCK_H
+#define VIRTUAL_CLOCK_H
+
+#include <stdint.h>
+#include "TaskScheduler.h"
+#include "HalClock.h"
+
+/**
+ * VirtualClock - 主机端虚拟时钟
+ *
+ * 代替 micros()：时间只在 advance() 时前进。任务函数里 advance(耗时) 模拟运行时间，
+ * runFor() 在两次释放之间直接跳到下一个释放时刻，几秒的调度在主机上瞬间跑完且结果确定。
+ * 也是硬件抽象层的主机端时钟（HalClock）：sleepUs() 只让时间前进，nowMs() 由微秒换算
+ * （与 millis() 不同，约 71 分钟后随微秒一起回绕）。
+ */
+class VirtualClock : public HalClock {
+public:
+    explicit VirtualClock(uint32_t startUs = 0) : now(startUs) {}
+
+    uint32_t nowUs() override { return now; }
+    uint32_t nowMs() override { return now / 1000; }
+    void sleepUs(uint32_t us) override { advance(us); }
+    void advance(uint32_t us) { now += us; }
+
+    // 模拟 loop()：运行到期任务，空闲时跳到下一个释放时刻，直到经过 durationUs
+    void runFor(TaskScheduler& scheduler, uint32_t durationUs) {
+        uint32_t end = now + durationUs;
+        while ((int32_t)(end - now) > 0) {
+            uint32_t idle = scheduler.runReady();
+            uint32_t left = end - now;
+            if ((int32_t)left <= 0) {
+                break;
+            }
+            advance(idle == 0 ? 0 : (idle < left ? idle : left));
+        }
+    }
+
+    uint32_t now;
+};
+
+#endif // VIRTUAL_CLOCK_H
@@ -0,0 +1,280 @@
+#include "Telemetry.h"
+
+TelemetryChannel::TelemetryChannel()
+    : _sourceCount(0), _nextSource(0), _schemaPending(0), _seq(0), _frames(0), _bytes(0), _discarded(0) {
+    memset(_types, 0, sizeof(_types));
+    memset(_sources, 0, sizeof(_sources));
+    memset(_dropsReported, 0, sizeof(_dropsReported));
+}
+
+// ========== 登记 ==========
+
+size_t TelemetryChannel::fieldsSize(const char* fields) {
+    if (fields == nullptr || *fields == '\0') {
+        return 0;
+    }
+    size_t size = 0;
+    const char* p = fields;
+    while (*p != '\0') {
+        // 名称
+        const char* start = p;
+        while (*p != '\0' && *p != ':' && *p != ',') {
+            p++;
+        }
+        if (p == start || *p != ':') {
+            return 0;
+        }
+        p++;
+        // 类型
+        switch (*p) {
+            case 'b': case 'B': size += 1; break;
+            case 'h': case 'H': size += 2; break;
+            case 'i': case 'I': case 'f': size += 4; break;
+            default: return 0;
+        }
+        p++;
+        if (*p == ',') {
+            p++;
+            if (*p == '\0') {
+                return 0;
+            }
+        } else if (*p != '\0') {
+            return 0;
+        }
+    }
+    return size;
+}
+
+bool TelemetryChannel::defineType(uint8_t type, const char* name, const char* fields, size_t size) {
+    if (type == TELEMETRY_TYPE_SCHEMA || type >= TELEMETRY_MAX_TYPES || name == nullptr) {
+        return false;
+    }
+    size_t nameLen = strlen(name);
+    if (nameLen == 0 || nameLen > 15 || size > TELEMETRY_MAX_PAYLOAD || fieldsSize(fields) != size) {
+        return false;
+    }
+    if (1 + nameLen + 1 + strlen(fields) > TELEMETRY_SCHEMA_MAX) {
+        return false;
+    }
+    _types[type].name = name;
+    _types[type].fields = fields;
+    _types[type].defined = true;
+    _schemaPending |= (uint16_t)(1u << type);
+    return true;
+}
+
+bool TelemetryChannel::addSource(TelemetrySource& source) {
+    if (_sourceCount >= TELEMETRY_MAX_SOURCES) {
+        return false;
+    }
+    for (uint8_t i = 0; i < _sourceCount; i++) {
+        if (_sources[i] == &source) {
+            return false;
+        }
+    }
+    _dropsReported[_sourceCount] = source.dropped();
+    _sources[_sourceCount++] = &source;
+    return true;
+}
+
+void TelemetryChannel::resendSchema() {
+    for (uint8_t t = 1; t < TELEMETRY_MAX_TYPES; t++) {
+        if (_types[t].defined) {
+            _schemaPending |= (uint16_t)(1u << t);
+        }
+    }
+}
+
+// ========== 编码 ==========
+
+uint16_t TelemetryChannel::fletcher16(const uint8_t* data, size_t length) {
+    uint16_t a = 0;
+    uint16_t b = 0;
+    for (size_t i = 0; i < length; i++) {
+        a = (uint16_t)((a + data[i]) % 255);
+        b = (uint16_t)((b + a) % 255);
+    }
+    return (uint16_t)((b << 8) | a);
+}
+
+size_t TelemetryChannel::cobsEncode(const uint8_t* in, size_t length, uint8_t* out) {
+    size_t codeIndex = 0;
+    size_t o = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (in[i] == 0) {
+            out[codeIndex] = code;
+            codeIndex = o++;
+            code = 1;
+        } else {
+            out[o++] = in[i];
+            code++;
+            if (code == 0xFF) {
+                out[codeIndex] = code;
+                codeIndex = o++;
+                code = 1;
+            }
+        }
+    }
+    out[codeIndex] = code;
+    return o;
+}
+
+size_t TelemetryChannel::cobsDecode(const uint8_t* in, size_t length, uint8_t* out) {
+    size_t i = 0;
+    size_t o = 0;
+    while (i < length) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > length) {
+            return 0;
+        }
+        for (uint8_t k = 1; k < code; k++) {
+            if (in[i] == 0) {
+                return 0;
+            }
+            out[o++] = in[i++];
+        }
+        // 0xFF 块之后和最后一块之后没有隐含的 0
+        if (code != 0xFF && i < length) {
+            out[o++] = 0;
+        }
+    }
+    return o;
+}
+
+size_t TelemetryChannel::encodeFrame(uint8_t* out, size_t capacity, uint8_t type, uint8_t seq, uint32_t timeMs,
+                                     const uint8_t* payload, size_t length) {
+    if (length > TELEMETRY_FRAME_PAYLOAD_MAX) {
+        return 0;
+    }
+    uint8_t raw[TELEMETRY_FRAME_RAW_MAX];
+    raw[0] = type;
+    raw[1] = seq;
+    raw[2] = (uint8_t)timeMs;
+    raw[3] = (uint8_t)(timeMs >> 8);
+    raw[4] = (uint8_t)(timeMs >> 16);
+    raw[5] = (uint8_t)(timeMs >> 24);
+    memcpy(raw + TELEMETRY_FRAME_HEADER, payload, length);
+    size_t rawLen = TELEMETRY_FRAME_HEADER + length;
+    uint16_t sum = fletcher16(raw, rawLen);
+    raw[rawLen++] = (uint8_t)sum;
+    raw[rawLen++] = (uint8_t)(sum >> 8);
+
+    // 编码后最多多 rawLen / 254 + 1 字节，再加分隔符
+    if (rawLen + rawLen / 254 + 2 > capacity) {
+        return 0;
+    }
+    size_t n = cobsEncode(raw, rawLen, out);
+    out[n++] = 0x00;
+    return n;
+}
+
+size_t TelemetryChannel::writeFrame(uint8_t* out, size_t capacity, uint8_t type, uint32_t timeMs,
+                                    const uint8_t* payload, size_t length) {
+    size_t n = encodeFrame(out, capacity, type, _seq, timeMs, payload, length);
+    if (n == 0) {
+        return 0;
+    }
+    _seq++;
+    _frames.store(_frames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return n;
+}
+
+// ========== 发送 ==========
+
+size_t TelemetryChannel::pump(uint8_t* out, size_t capacity) {
+    if (capacity < 2) {
+        return 0;
+    }
+    out[0] = 0x00;   // 与之前的串口文本分开
+    size_t len = 1;
+    bool any = false;
+
+    // schema
+    for (uint8_t t = 1; t < TELEMETRY_MAX_TYPES && _schemaPending != 0; t++) {
+        if ((_schemaPending & (1u << t)) == 0) {
+            continue;
+        }
+        uint8_t payload[TELEMETRY_SCHEMA_MAX];
+        size_t nameLen = strlen(_types[t].name);
+        size_t fieldsLen = strlen(_types[t].fields);
+        payload[0] = t;
+        memcpy(payload + 1, _types[t].name, nameLen);
+        payload[1 + nameLen] = 0;
+        memcpy(payload + 2 + nameLen, _types[t].fields, fieldsLen);
+        size_t n = writeFrame(out + len, capacity - len, TELEMETRY_TYPE_SCHEMA, 0, payload, 2 + nameLen + fieldsLen);
+        if (n == 0) {
+            return any ? len : 0;
+        }
+        len += n;
+        any = true;
+        _schemaPending &= (uint16_t)~(1u << t);
+    }
+
+    // 丢弃通知
+    for (uint8_t s = 0; s < _sourceCount; s++) {
+        uint32_t dropped = _sources[s]->dropped();
+        if (dropped == _dropsReported[s]) {
+            continue;
+        }
+        uint8_t payload[5] = {s, (uint8_t)dropped, (uint8_t)(dropped >> 8), (uint8_t)(dropped >> 16),
+                              (uint8_t)(dropped >> 24)};
+        size_t n = writeFrame(out + len, capacity - len, TELEMETRY_TYPE_DROPS, 0, payload, sizeof(payload));
+        if (n == 0) {
+            return any ? len : 0;
+        }
+        len += n;
+        any = true;
+        _dropsReported[s] = dropped;
+    }
+
+    // 记录：各来源轮流取一条，直到都空或缓冲放不下
+    uint8_t empty = 0;
+    while (_sourceCount > 0 && empty < _sourceCount) {
+        TelemetrySource* src = _sources[_nextSource];
+        const TelemetryRecord* rec;
+        if (src->_ring.peek(&rec, 1) == 0) {
+            empty++;
+        } else {
+            size_t n = writeFrame(out + len, capacity - len, rec->type, rec->timeMs, rec->payload, rec->length);
+            if (n == 0) {
+                break;
+            }
+            src->_ring.release(1);
+            len += n;
+            any = true;
+            empty = 0;
+        }
+        _nextSource = (uint8_t)((_nextSource + 1) % _sourceCount);
+    }
+
+    if (!any) {
+        return 0;
+    }
+    _bytes.store(_bytes.load(std::memory_order_relaxed) + (uint32_t)len, std::memory_order_relaxed);
+    return len;
+}
+
+void TelemetryChannel::discard() {
+    for (uint8_t s = 0; s < _sourceCount; s++) {
+        const TelemetryRecord* rec;
+        size_t n;
+        while ((n = _sources[s]->_ring.peek(&rec, TELEMETRY_QUEUE_DEPTH)) > 0) {
+            _sources[s]->_ring.release(n);
+            _discarded.store(_discarded.load(std::memory_order_relaxed) + (uint32_t)n, std::memory_order_relaxed);
+        }
+        _dropsReported[s] = _sources[s]->dropped();
+    }
+}
+
+TelemetryStats TelemetryChannel::stats() const {
+    TelemetryStats st;
+    st.frames = _frames.load(std::memory_order_relaxed);
+    st.bytes = _bytes.load(std::memory_order_relaxed);
+    st.dropped = 0;
+    for (uint8_t s = 0; s < _sourceCount; s++) {
+        st.dropped += _sources[s]->dropped();
+    }
+    st.discarded = _discarded.load(std::memory_order_relaxed);
+    return st;
+}
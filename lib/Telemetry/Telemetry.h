@@ -0,0 +1,168 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include "SpscRing.h"
+
+/**
+ * Telemetry - 带类型的二进制遥测（COBS 分帧，后台发送）
+ *
+ * 原来热路径中每 200~1000ms 用 Serial.printf 打印带浮点数的调试行：格式化要时间，
+ * 115200 波特下一行要几毫秒，串口缓冲满时还会阻塞调用的任务。本模块：
+ * - 每个产生遥测的任务一个 TelemetrySource（SpscRing，单生产者）：send() 只复制固定长度的记录，
+ *   队列满时丢弃并计数，从不阻塞
+ * - TelemetryChannel 在低优先级任务中取出所有来源的记录，编码为帧写入缓冲，由调用方经串口发出
+ * - 帧 = COBS(类型 u8 | 序号 u8 | 时间 ms u32 | 载荷 | Fletcher-16 u16) + 0x00；每批帧前先发一个 0x00，
+ *   与串口文本交错时只有夹着文本的那一段校验失败
+ * - 类型用 define() 登记名称和字段（例如 "volume:f,angle:h"），以 schema 帧（类型 0）发出，
+ *   解码工具按 schema 解析，新增记录类型不需要改工具：tools/telemetry_decode.py 输出 CSV 或实时曲线
+ * - 来源的丢弃数增加时发出一个丢弃帧（类型 0xFF），序号不连续说明串口上丢了帧
+ *
+ * 字段类型与 Python struct 相同（小端）：b B h H i I f；记录结构体必须与字段描述逐字节一致（define() 检查大小）。
+ */
+
+#define TELEMETRY_MAX_PAYLOAD  24     // 每条记录的最大载荷字节数
+#define TELEMETRY_QUEUE_DEPTH  32     // 每个来源的队列长度（2的幂）
+#define TELEMETRY_MAX_TYPES    16     // 类型编号 1 ~ 15
+#define TELEMETRY_MAX_SOURCES  4
+#define TELEMETRY_SCHEMA_MAX   112    // schema 载荷最大字节数（编号 + 名称 + 0 + 字段描述）
+
+#define TELEMETRY_TYPE_SCHEMA  0x00
+#define TELEMETRY_TYPE_LOG_FORMAT 0xFD   // 日志格式串（lib/Log）：编号 u16, 格式串
+#define TELEMETRY_TYPE_LOG     0xFE   // 日志记录（lib/Log）：编号 u16, 级别 u8, 参数个数 u8, 参数
+#define TELEMETRY_TYPE_DROPS   0xFF   // 载荷：来源 u8, 累计丢弃 u32
+
+#define TELEMETRY_FRAME_HEADER 6      // 类型 + 序号 + 时间
+#define TELEMETRY_FRAME_PAYLOAD_MAX 240   // encodeFrame() 接受的最大载荷
+#define TELEMETRY_FRAME_RAW_MAX (TELEMETRY_FRAME_HEADER + TELEMETRY_FRAME_PAYLOAD_MAX + 2)
+
+struct TelemetryRecord {
+    uint32_t timeMs;
+    uint8_t type;
+    uint8_t length;
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD];
+};
+
+struct TelemetryStats {
+    uint32_t frames;     // 已编码的帧（含 schema 和丢弃帧）
+    uint32_t bytes;      // 已编码的字节（含分隔符）
+    uint32_t dropped;    // 各来源队列满时丢弃的记录
+    uint32_t discarded;  // discard() 丢掉的记录（未开启发送时）
+};
+
+// 单生产者队列：只能在一个任务中 send()
+class TelemetrySource {
+public:
+    TelemetrySource() : _sent(0), _dropped(0) {}
+
+    /**
+     * 发送一条记录（复制 sizeof(T) 字节）
+     * @return 队列满时返回 false（计入丢弃）
+     */
+    template <typename T>
+    bool send(uint8_t type, const T& value, uint32_t timeMs) {
+        static_assert(sizeof(T) <= TELEMETRY_MAX_PAYLOAD, "遥测记录超过 TELEMETRY_MAX_PAYLOAD");
+        TelemetryRecord* slot;
+        if (_ring.claim(&slot, 1) == 0) {
+            _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        slot->timeMs = timeMs;
+        slot->type = type;
+        slot->length = (uint8_t)sizeof(T);
+        memcpy(slot->payload, &value, sizeof(T));
+        _ring.commit(1);
+        _sent.store(_sent.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    uint32_t sent() const { return _sent.load(std::memory_order_relaxed); }
+    uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    friend class TelemetryChannel;
+
+    SpscRing<TelemetryRecord, TELEMETRY_QUEUE_DEPTH> _ring;
+    std::atomic<uint32_t> _sent;
+    std::atomic<uint32_t> _dropped;
+};
+
+class TelemetryChannel {
+public:
+    TelemetryChannel();
+
+    /**
+     * 登记记录类型：名称（最长 15 字节）和字段描述 "名称:类型,..."，字段总字节数必须等于 sizeof(T)
+     * 在启动发送前调用
+     * @return 编号无效、描述无效或大小不一致时返回 false
+     */
+    template <typename T>
+    bool define(uint8_t type, const char* name, const char* fields) {
+        return defineType(type, name, fields, sizeof(T));
+    }
+    bool defineType(uint8_t type, const char* name, const char* fields, size_t size);
+
+    // 登记来源（在启动发送前调用）
+    bool addSource(TelemetrySource& source);
+
+    /**
+     * 发送任务：把待发的 schema、丢弃通知和各来源的记录（轮流取）编码为完整的帧写入 out
+     * 只能在一个任务中调用
+     * @return 写入的字节数，没有可发送的内容时为 0
+     */
+    size_t pump(uint8_t* out, size_t capacity);
+
+    // 丢掉各来源中的记录（未开启发送时由发送任务调用，避免队列一直满着）
+    void discard();
+
+    // 下一次 pump() 重新发送全部 schema（开始新的抓包时）
+    void resendSchema();
+
+    TelemetryStats stats() const;
+
+    // 字段描述的总字节数，描述无效时为 0
+    static size_t fieldsSize(const char* fields);
+
+    /**
+     * COBS 编码（不含结尾的 0x00），out 容量至少 length + length / 254 + 1
+     * @return 编码后的字节数
+     */
+    static size_t cobsEncode(const uint8_t* in, size_t length, uint8_t* out);
+    // COBS 解码（输入不含 0x00 分隔符），数据无效时返回 0
+    static size_t cobsDecode(const uint8_t* in, size_t length, uint8_t* out);
+    static uint16_t fletcher16(const uint8_t* data, size_t length);
+
+    /**
+     * 编码一帧（含结尾的 0x00），与本通道共用帧格式的其他导出方（lib/Log）也用它
+     * @return 写入的字节数，载荷超过 TELEMETRY_FRAME_PAYLOAD_MAX 或 capacity 不够时为 0
+     */
+    static size_t encodeFrame(uint8_t* out, size_t capacity, uint8_t type, uint8_t seq, uint32_t timeMs,
+                              const uint8_t* payload, size_t length);
+
+private:
+    struct TypeDef {
+        const char* name;
+        const char* fields;
+        bool defined;
+    };
+
+    size_t writeFrame(uint8_t* out, size_t capacity, uint8_t type, uint32_t timeMs,
+                      const uint8_t* payload, size_t length);
+
+    TypeDef _types[TELEMETRY_MAX_TYPES];
+    TelemetrySource* _sources[TELEMETRY_MAX_SOURCES];
+    uint8_t _sourceCount;
+    uint8_t _nextSource;              // 轮流取的起点
+    uint16_t _schemaPending;          // 待发送 schema 的类型位图
+    uint32_t _dropsReported[TELEMETRY_MAX_SOURCES];
+    uint8_t _seq;
+
+    std::atomic<uint32_t> _frames;    // 发送任务写，stats() 可在其他任务中读
+    std::atomic<uint32_t> _bytes;
+    std::atomic<uint32_t> _discarded;
+};
+
+#endif // TELEMETRY_H
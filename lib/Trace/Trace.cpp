@@ -0,0 +1,227 @@
+#include "Trace.h"
+#include <string.h>
+
+TraceRing traceRing;
+
+thread_local uint8_t TraceRing::_thread = 0xFF;
+
+TraceRing::TraceRing() : _next(0), _read(0), _lost(0), _exported(0), _nameCount(0), _namesExported(0) {
+    for (Slot& s : _slots) {
+        // 初始序号不等于任何下标 + 1 附近的值：读取方看作"尚未写入"
+        s.seq.store(0xFFFFFFFFu - TRACE_RING_SIZE, std::memory_order_relaxed);
+        s.start.store(0, std::memory_order_relaxed);
+        s.value.store(0, std::memory_order_relaxed);
+        s.meta.store(0, std::memory_order_relaxed);
+    }
+    for (uint16_t i = 0; i < TRACE_MAX_NAMES; i++) {
+        _names[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+// ========== 名称 ==========
+
+uint16_t TraceRing::nameId(const char* name) {
+    uint32_t count = _nameCount.load(std::memory_order_acquire);
+    if (count > TRACE_MAX_NAMES) {
+        count = TRACE_MAX_NAMES;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        const char* n = _names[i].load(std::memory_order_acquire);
+        if (n != nullptr && (n == name || strcmp(n, name) == 0)) {
+            return (uint16_t)i;
+        }
+    }
+
+    uint32_t id = _nameCount.fetch_add(1, std::memory_order_acq_rel);
+    if (id >= TRACE_MAX_NAMES) {
+        return TRACE_NO_NAME;
+    }
+    _names[id].store(name, std::memory_order_release);
+    return (uint16_t)id;
+}
+
+const char* TraceRing::name(uint16_t id) const {
+    return id < TRACE_MAX_NAMES ? _names[id].load(std::memory_order_acquire) : nullptr;
+}
+
+// ========== 读取 ==========
+
+size_t TraceRing::drain(TraceRecord* out, size_t maxCount) {
+    uint32_t head = _next.load(std::memory_order_acquire);
+
+    // 落后超过一圈：最旧的记录已被覆盖
+    if (head - _read > TRACE_RING_SIZE) {
+        _lost.fetch_add(head - _read - TRACE_RING_SIZE, std::memory_order_relaxed);
+        _read = head - TRACE_RING_SIZE;
+    }
+
+    size_t n = 0;
+    while (_read != head && n < maxCount) {
+        const Slot& s = _slots[_read & (TRACE_RING_SIZE - 1)];
+        uint32_t expect = _read + 1;
+        uint32_t seq1 = s.seq.load(std::memory_order_acquire);
+        if (seq1 != expect) {
+            if ((int32_t)(seq1 - expect) > 0) {
+                // 已被下一圈覆盖
+                _lost.fetch_add(1, std::memory_order_relaxed);
+                _read++;
+                continue;
+            }
+            break;   // 写入方已占位但还没写完，下次再取
+        }
+
+        TraceRecord r;
+        r.start = s.start.load(std::memory_order_relaxed);
+        r.value = s.value.load(std::memory_order_relaxed);
+        uint32_t meta = s.meta.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t seq2 = s.seq.load(std::memory_order_relaxed);
+        _read++;
+        if (seq2 != seq1) {
+            // 读取过程中被覆盖，内容可能不完整
+            _lost.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        r.name = (uint16_t)(meta & 0xFFFF);
+        r.type = (uint8_t)(meta >> 16);
+        r.thread = (uint8_t)(meta >> 24);
+        out[n++] = r;
+    }
+    return n;
+}
+
+void TraceRing::clear() {
+    _read = _next.load(std::memory_order_acquire);
+    _namesExported = 0;
+}
+
+TraceStats TraceRing::stats() const {
+    TraceStats st;
+    st.written = _next.load(std::memory_order_relaxed);
+    st.exported = _exported.load(std::memory_order_relaxed);
+    st.lost = _lost.load(std::memory_order_relaxed);
+    uint32_t names = _nameCount.load(std::memory_order_relaxed);
+    st.names = names > TRACE_MAX_NAMES ? TRACE_MAX_NAMES : names;
+    return st;
+}
+
+// ========== 导出 ==========
+
+static void putU16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void putU32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+uint16_t TraceRing::fletcher16(const uint8_t* data, size_t length) {
+    uint16_t a = 0;
+    uint16_t b = 0;
+    for (size_t i = 0; i < length; i++) {
+        a = (uint16_t)((a + data[i]) % 255);
+        b = (uint16_t)((b + a) % 255);
+    }
+    return (uint16_t)((b << 8) | a);
+}
+
+size_t TraceRing::writeBlock(uint8_t* out, uint8_t type, const uint8_t* payload, uint16_t length) {
+    memcpy(out, TRACE_BLOCK_MAGIC, 4);
+    out[4] = type;
+    putU16(out + 5, length);
+    if (payload != out + TRACE_BLOCK_HEADER) {
+        memmove(out + TRACE_BLOCK_HEADER, payload, length);
+    }
+    putU16(out + TRACE_BLOCK_HEADER + length, fletcher16(out + 4, 3 + (size_t)length));
+    return TRACE_BLOCK_OVERHEAD + (size_t)length;
+}
+
+size_t TraceRing::exportBinary(uint8_t* out, size_t capacity, uint32_t anchorUs) {
+    // 名称块：只发新登记（且已发布）的名称
+    uint32_t names = _nameCount.load(std::memory_order_acquire);
+    if (names > TRACE_MAX_NAMES) {
+        names = TRACE_MAX_NAMES;
+    }
+    if (_namesExported < names && capacity > TRACE_BLOCK_OVERHEAD) {
+        uint8_t* payload = out + TRACE_BLOCK_HEADER;
+        size_t room = capacity - TRACE_BLOCK_OVERHEAD;
+        if (room > 0xFFFF) {
+            room = 0xFFFF;
+        }
+        size_t length = 0;
+        while (_namesExported < names) {
+            const char* n = _names[_namesExported].load(std::memory_order_acquire);
+            if (n == nullptr) {
+                break;   // 已预留但还没发布
+            }
+            size_t len = strlen(n);
+            if (len > TRACE_NAME_MAX) {
+                len = TRACE_NAME_MAX;
+            }
+            if (length + 3 + len > room) {
+                break;
+            }
+            putU16(payload + length, (uint16_t)_namesExported);
+            payload[length + 2] = (uint8_t)len;
+            memcpy(payload + length + 3, n, len);
+            length += 3 + len;
+            _namesExported++;
+        }
+        if (length > 0) {
+            return writeBlock(out, TRACE_BLOCK_NAMES, payload, (uint16_t)length);
+        }
+    }
+
+    // 记录块
+    if (capacity < TRACE_BLOCK_OVERHEAD + TRACE_RECORDS_HEADER + TRACE_RECORD_BYTES) {
+        return 0;
+    }
+    size_t maxRecords = (capacity - TRACE_BLOCK_OVERHEAD - TRACE_RECORDS_HEADER) / TRACE_RECORD_BYTES;
+    size_t limit = (0xFFFF - TRACE_RECORDS_HEADER) / TRACE_RECORD_BYTES;
+    if (maxRecords > limit) {
+        maxRecords = limit;
+    }
+
+    uint32_t anchorCycles = traceCycles();
+    uint8_t* payload = out + TRACE_BLOCK_HEADER;
+    uint8_t* p = payload + TRACE_RECORDS_HEADER;
+    size_t count = 0;
+    TraceRecord batch[16];
+    while (count < maxRecords) {
+        size_t want = maxRecords - count;
+        size_t got = drain(batch, want < 16 ? want : 16);
+        for (size_t i = 0; i < got; i++) {
+            putU32(p, batch[i].start);
+            putU32(p + 4, (uint32_t)batch[i].value);
+            putU16(p + 8, batch[i].name);
+            p[10] = batch[i].type;
+            p[11] = batch[i].thread;
+            p += TRACE_RECORD_BYTES;
+        }
+        count += got;
+        if (got < 16) {
+            break;
+        }
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+#ifdef ARDUINO
+    uint16_t cyclesPerUs = (uint16_t)getCpuFrequencyMhz();
+#else
+    uint16_t cyclesPerUs = 1000;   // 主机端计数单位为纳秒
+#endif
+    putU32(payload, anchorCycles);
+    putU32(payload + 4, anchorUs);
+    putU16(payload + 8, cyclesPerUs);
+    putU32(payload + 10, _lost.load(std::memory_order_relaxed));
+    putU16(payload + 14, (uint16_t)count);
+    _exported.fetch_add((uint32_t)count, std::memory_order_relaxed);
+    return writeBlock(out, TRACE_BLOCK_RECORDS, payload,
+                      (uint16_t)(TRACE_RECORDS_HEADER + count * TRACE_RECORD_BYTES));
+}
@@ -0,0 +1,212 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * Trace - 热路径周期计数追踪（无锁环形记录 + 二进制导出）
+ *
+ * 原来只能靠 Serial.printf 打印耗时，看不出一轮中时间花在哪里（i2s_read、显示发送、LED show）。
+ * 本模块：
+ * - TRACE_SCOPE("name")：作用域开始时读周期计数器，结束时写一条 {开始, 时长} 记录
+ * - TRACE_INSTANT / TRACE_COUNTER：瞬时事件 / 计数器值
+ * - TRACE_THREAD("name")：给当前任务（线程）命名，记录中带任务编号，时间线上按任务分行
+ * - 记录固定 12 字节，写入全局环形缓冲 traceRing；多个任务（含不同核）可以同时写，
+ *   写满后覆盖最旧的记录（飞行记录器），读取方发现被覆盖时计入 lost
+ * - exportBinary() 把新记录打成带校验的二进制块，经串口发出；
+ *   tools/trace_to_chrome.py 把串口抓包转成 Chrome trace JSON（chrome://tracing 或 Perfetto 打开）
+ *
+ * 编译开关：TRACE_ENABLED 为 0（默认）时所有 TRACE_* 宏展开为空，参数不求值，没有任何开销；
+ * 需要追踪时在 build_flags 中加 -DTRACE_ENABLED=1（库和程序都要看到同一个值）。
+ *
+ * 周期计数器：设备端为 CPU 的 CCOUNT（ESP.getCycleCount()，240MHz 下约 17.9 秒回绕，两个核各自计数），
+ * 主机端为 steady_clock 纳秒。导出块带当时的计数值和微秒时间作锚点，转换工具据此还原绝对时间，
+ * 因此两次导出之间不应超过计数器回绕周期的一半（设备端约 8.9 秒）。
+ * 两个核的 CCOUNT 不同步，另一个核上任务的时间相对导出任务可能有固定偏移；同一任务内的时长不受影响。
+ */
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 0
+#endif
+
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE 1024   // 记录数（2的幂），每条在环中占 16 字节
+#endif
+
+#define TRACE_MAX_NAMES    64   // 名称表容量（事件名和任务名共用）
+#define TRACE_NAME_MAX     31   // 导出时名称最长字节数
+#define TRACE_NO_NAME      0xFFFF
+
+// 导出块格式（小端）：
+//   'T' 'R' 'C' '1' | 类型 u8 | 载荷长度 u16 | 载荷 | Fletcher-16 校验 u16（覆盖类型、长度和载荷）
+//   名称块载荷：重复 {编号 u16, 长度 u8, 字节}
+//   记录块载荷：锚点周期 u32, 锚点微秒 u32, 每微秒周期数 u16, 累计丢失 u32, 记录数 u16, 记录 × 12 字节
+#define TRACE_BLOCK_MAGIC     "TRC1"
+#define TRACE_BLOCK_NAMES     1
+#define TRACE_BLOCK_RECORDS   2
+#define TRACE_BLOCK_HEADER    7    // 魔数 + 类型 + 长度
+#define TRACE_BLOCK_OVERHEAD  9    // 块头 + 校验
+#define TRACE_RECORDS_HEADER  16
+#define TRACE_RECORD_BYTES    12
+
+enum TraceType : uint8_t {
+    TRACE_TYPE_SPAN = 0,      // 作用域：start + value（时长，周期）
+    TRACE_TYPE_INSTANT = 1,   // 瞬时事件：value 为参数
+    TRACE_TYPE_COUNTER = 2    // 计数器：value 为当前值
+};
+
+struct TraceRecord {
+    uint32_t start;      // 周期计数
+    int32_t value;       // 时长（周期）/ 参数 / 计数器值
+    uint16_t name;       // 名称编号
+    uint8_t type;        // TraceType
+    uint8_t thread;      // TRACE_THREAD 登记的任务名编号（低8位），未登记为 0xFF
+};
+
+struct TraceStats {
+    uint32_t written;    // 写入的记录
+    uint32_t exported;   // 导出的记录
+    uint32_t lost;       // 导出前被覆盖的记录
+    uint32_t names;      // 登记的名称数
+};
+
+// 读周期计数器（内联，设备端一条 RSR 指令）
+inline uint32_t traceCycles() {
+#ifdef ARDUINO
+    return ESP.getCycleCount();
+#else
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+class TraceRing {
+public:
+    TraceRing();
+
+    /**
+     * 登记名称（已登记的相同字符串返回同一编号），名称必须是常量字符串（只保存指针）
+     * @return 名称表满时返回 TRACE_NO_NAME（该事件不记录）
+     */
+    uint16_t nameId(const char* name);
+    const char* name(uint16_t id) const;
+
+    // 写一条记录（任意任务/线程可同时调用，不阻塞）
+    void record(uint16_t name, uint8_t type, uint32_t start, int32_t value) {
+        if (name == TRACE_NO_NAME) {
+            return;
+        }
+        uint32_t index = _next.fetch_add(1, std::memory_order_relaxed);
+        Slot& s = _slots[index & (TRACE_RING_SIZE - 1)];
+        // 序号协议：写入中为 index，写完为 index + 1（读取方据此判断写入中或已被覆盖）
+        s.seq.store(index, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.start.store(start, std::memory_order_relaxed);
+        s.value.store(value, std::memory_order_relaxed);
+        s.meta.store((uint32_t)name | ((uint32_t)type << 16) | ((uint32_t)_thread << 24),
+                     std::memory_order_relaxed);
+        s.seq.store(index + 1, std::memory_order_release);
+    }
+
+    // 当前任务的名称编号（TRACE_THREAD 设置），记录中带低8位
+    static void setThread(uint16_t name) { _thread = (uint8_t)name; }
+
+    /**
+     * 取出最多 maxCount 条新记录（从早到晚，只能在一个任务中调用）
+     * 正在写入的记录留到下一次；已被覆盖的记录计入 lost
+     */
+    size_t drain(TraceRecord* out, size_t maxCount);
+
+    /**
+     * 导出为二进制块：有新名称时先写名称块，再写一个记录块（尽量填满 capacity）
+     * 循环调用直到返回 0；只能在一个任务中调用（与 drain 相同）
+     * @param anchorUs 当前的微秒时间（设备端 micros()），写入记录块作锚点
+     * @return 写入 out 的字节数，没有新内容或 capacity 不够一个块时为 0
+     */
+    size_t exportBinary(uint8_t* out, size_t capacity, uint32_t anchorUs);
+
+    // 丢弃未导出的记录，开始新的抓包：名称表保留，下一次导出重新发送全部名称
+    void clear();
+
+    TraceStats stats() const;
+
+    // 写导出块（块头 + 校验），返回块的总字节数
+    static size_t writeBlock(uint8_t* out, uint8_t type, const uint8_t* payload, uint16_t length);
+    static uint16_t fletcher16(const uint8_t* data, size_t length);
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq;
+        std::atomic<uint32_t> start;
+        std::atomic<int32_t> value;
+        std::atomic<uint32_t> meta;   // 名称 | 类型 << 16 | 任务 << 24
+    };
+
+    Slot _slots[TRACE_RING_SIZE];
+    std::atomic<uint32_t> _next;
+    uint32_t _read;                   // 只由读取方使用
+    std::atomic<uint32_t> _lost;      // 由读取方写，stats() 可在其他任务中读
+    std::atomic<uint32_t> _exported;
+
+    // 名称表：先用 _nameCount 预留下标，再发布指针（不加锁，不同优先级的任务同时登记也不会互相等待；
+    // 同一名称被同时登记时可能占两个编号，转换工具按编号取名，不影响结果）
+    std::atomic<const char*> _names[TRACE_MAX_NAMES];
+    std::atomic<uint32_t> _nameCount;
+    uint32_t _namesExported;          // 只由读取方使用
+
+    static thread_local uint8_t _thread;
+
+    static_assert((TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) == 0, "TRACE_RING_SIZE 必须是2的幂");
+};
+
+extern TraceRing traceRing;
+
+// 作用域记录：构造时读计数器，析构时写 {开始, 时长}
+class TraceScope {
+public:
+    TraceScope(uint16_t name) : _name(name), _start(traceCycles()) {}
+    ~TraceScope() { traceRing.record(_name, TRACE_TYPE_SPAN, _start, (int32_t)(traceCycles() - _start)); }
+
+private:
+    uint16_t _name;
+    uint32_t _start;
+};
+
+// ========== 宏（TRACE_ENABLED 为 0 时展开为空） ==========
+
+#define TRACE_CAT_(a, b) a##b
+#define TRACE_CAT(a, b) TRACE_CAT_(a, b)
+
+#if TRACE_ENABLED
+// 每个调用点第一次执行时登记名称，之后只读一个静态变量
+#define TRACE_SCOPE(name) \
+    static const uint16_t TRACE_CAT(_traceId, __LINE__) = traceRing.nameId(name); \
+    TraceScope TRACE_CAT(_traceScope, __LINE__)(TRACE_CAT(_traceId, __LINE__))
+#define TRACE_INSTANT(name, arg) do { \
+        static const uint16_t _traceId = traceRing.nameId(name); \
+        traceRing.record(_traceId, TRACE_TYPE_INSTANT, traceCycles(), (int32_t)(arg)); \
+    } while (0)
+#define TRACE_COUNTER(name, value) do { \
+        static const uint16_t _traceId = traceRing.nameId(name); \
+        traceRing.record(_traceId, TRACE_TYPE_COUNTER, traceCycles(), (int32_t)(value)); \
+    } while (0)
+#define TRACE_THREAD(name) do { \
+        static const uint16_t _traceId = traceRing.nameId(name); \
+        TraceRing::setThread(_traceId); \
+    } while (0)
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_INSTANT(name, arg) do { } while (0)
+#define TRACE_COUNTER(name, value) do { } while (0)
+#define TRACE_THREAD(name) do { } while (0)
+#endif
+
+#endif // TRACE_H
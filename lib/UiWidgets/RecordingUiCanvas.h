@@ -0,0 +1,102 @@
+#ifndef RECORDING_UI_CANVAS_H
+#define RECORDING_UI_CANVAS_H
+
+#include <stdint.h>
+#include <string.h>
+#include "UiWidgets.h"
+#include "TileFlusher.h"
+
+/**
+ * RecordingUiCanvas - 主机端绘图（代替 U8g2）
+ *
+ * 画进与 U8g2 SSD1306 128×64 全缓冲相同格式的 buffer，遵守裁剪区域，并统计调用次数和写入的像素数。
+ * 主机端没有 U8g2 字体：文字按每字节 6 像素步进、基线上方 7 行画一个由字节值决定的 5×7 图案，
+ * 不同文字得到不同像素，足够检验重画结果。
+ */
+
+#define RECORDING_UI_CHAR_WIDTH  6
+
+class RecordingUiCanvas : public UiCanvas {
+public:
+    RecordingUiCanvas() {
+        memset(buffer, 0, sizeof(buffer));
+        clearClip();
+        reset();
+    }
+
+    void setClip(const UiRect& clip) override { _clip = clip; }
+
+    void clearClip() override { _clip = UiRect{0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT}; }
+
+    void fill(const UiRect& rect, bool on) override {
+        fills++;
+        for (int16_t y = rect.y; y < rect.y + rect.h; y++) {
+            for (int16_t x = rect.x; x < rect.x + rect.w; x++) {
+                pixel(x, y, on);
+            }
+        }
+    }
+
+    void text(int16_t x, int16_t y, const char* str, const uint8_t* font) override {
+        (void)font;
+        texts++;
+        for (; *str; str++, x += RECORDING_UI_CHAR_WIDTH) {
+            uint8_t c = (uint8_t)*str;
+            for (int16_t col = 0; col < 5; col++) {
+                uint8_t bits = (uint8_t)((c * (col + 3)) ^ (c >> (col + 1))) & 0x7F;
+                for (int16_t row = 0; row < 7; row++) {
+                    if (bits & (1 << row)) {
+                        pixel(x + col, y - 7 + row, true);
+                    }
+                }
+            }
+        }
+    }
+
+    void bitmap(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* xbm) override {
+        bitmaps++;
+        int16_t rowBytes = (int16_t)((w + 7) / 8);
+        for (int16_t r = 0; r < h; r++) {
+            for (int16_t c = 0; c < w; c++) {
+                pixel(x + c, y + r, (xbm[r * rowBytes + c / 8] >> (c % 8)) & 1);
+            }
+        }
+    }
+
+    // 清零计数（缓冲保持）
+    void reset() {
+        fills = 0;
+        texts = 0;
+        bitmaps = 0;
+        pixelsWritten = 0;
+    }
+
+    void clearBuffer() { memset(buffer, 0, sizeof(buffer)); }
+
+    uint8_t buffer[DISPLAY_BUFFER_SIZE];
+    uint32_t fills;
+    uint32_t texts;
+    uint32_t bitmaps;
+    uint32_t pixelsWritten;
+
+private:
+    void pixel(int16_t x, int16_t y, bool on) {
+        if (x < _clip.x || x >= _clip.x + _clip.w || y < _clip.y || y >= _clip.y + _clip.h) {
+            return;
+        }
+        if (x < 0 || x >= DISPLAY_WIDTH || y < 0 || y >= DISPLAY_HEIGHT) {
+            return;
+        }
+        pixelsWritten++;
+        uint8_t mask = (uint8_t)(1 << (y & 7));
+        if (on) {
+            buffer[(y >> 3) * DISPLAY_WIDTH + x] |= mask;
+        } else {
+            buffer[(y >> 3) * DISPLAY_WIDTH + x] &= (uint8_t)~mask;
+        }
+    }
+
+    UiRect _clip;
+};
+
+#endif // RECORDING_UI_CANVAS_H
@@ -0,0 +1,216 @@
+#include "UiWidgets.h"
+#include <stdio.h>
+#include <string.h>
+
+// ========== 矩形 ==========
+
+bool uiRectIntersects(const UiRect& a, const UiRect& b) {
+    return a.w > 0 && a.h > 0 && b.w > 0 && b.h > 0 &&
+           a.x < b.x + b.w && b.x < a.x + a.w &&
+           a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+UiRect uiRectUnion(const UiRect& a, const UiRect& b) {
+    if (a.w <= 0 || a.h <= 0) return b;
+    if (b.w <= 0 || b.h <= 0) return a;
+    int16_t x0 = a.x < b.x ? a.x : b.x;
+    int16_t y0 = a.y < b.y ? a.y : b.y;
+    int16_t x1 = a.x + a.w > b.x + b.w ? a.x + a.w : b.x + b.w;
+    int16_t y1 = a.y + a.h > b.y + b.h ? a.y + a.h : b.y + b.h;
+    return UiRect{x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+}
+
+// ========== UiLabel ==========
+
+UiLabel::UiLabel(const UiRect& rect, const uint8_t* font, int16_t baseline, const char* text)
+    : UiWidget(rect), _font(font), _baseline(baseline) {
+    _text[0] = '\0';
+    setText(text);
+}
+
+void UiLabel::setText(const char* text) {
+    if (strncmp(_text, text, sizeof(_text) - 1) == 0) {
+        return;
+    }
+    strncpy(_text, text, sizeof(_text) - 1);
+    _text[sizeof(_text) - 1] = '\0';
+    _dirty = true;
+}
+
+void UiLabel::draw(UiCanvas& canvas) {
+    if (_text[0] != '\0') {
+        canvas.text(_rect.x, _rect.y + _baseline, _text, _font);
+    }
+}
+
+// ========== UiValue ==========
+
+UiValue::UiValue(const UiRect& rect, const uint8_t* font, int16_t baseline,
+                 const char* prefix, const char* suffix)
+    : UiWidget(rect), _font(font), _baseline(baseline),
+      _prefix(prefix), _suffix(suffix), _value(0) {}
+
+void UiValue::setValue(int32_t value) {
+    if (value == _value) {
+        return;
+    }
+    _value = value;
+    _dirty = true;
+}
+
+void UiValue::draw(UiCanvas& canvas) {
+    char buf[UI_LABEL_MAX];
+    snprintf(buf, sizeof(buf), "%s%ld%s", _prefix, (long)_value, _suffix);
+    canvas.text(_rect.x, _rect.y + _baseline, buf, _font);
+}
+
+// ========== UiBar ==========
+
+UiBar::UiBar(const UiRect& rect, int32_t maxValue, uint8_t flags)
+    : UiWidget(rect), _max(maxValue > 0 ? maxValue : 1), _flags(flags), _value(0), _fill(0) {}
+
+int16_t UiBar::fillFor(int32_t value) const {
+    if (value < 0) value = 0;
+    if (value > _max) value = _max;
+    int16_t inset = (_flags & UI_BAR_FRAME) ? 2 : 0;
+    int16_t span = ((_flags & UI_BAR_VERTICAL) ? _rect.h : _rect.w) - inset;
+    if (span <= 0) {
+        return 0;
+    }
+    return (int16_t)((int32_t)span * value / _max);
+}
+
+void UiBar::setValue(int32_t value) {
+    _value = value;
+    int16_t fill = fillFor(value);
+    if (fill == _fill) {
+        return;
+    }
+    _fill = fill;
+    _dirty = true;
+}
+
+void UiBar::draw(UiCanvas& canvas) {
+    UiRect inner = _rect;
+    if (_flags & UI_BAR_FRAME) {
+        canvas.fill(_rect, true);
+        inner = UiRect{(int16_t)(_rect.x + 1), (int16_t)(_rect.y + 1),
+                       (int16_t)(_rect.w - 2), (int16_t)(_rect.h - 2)};
+        canvas.fill(inner, false);
+    }
+    if (_fill <= 0) {
+        return;
+    }
+    if (_flags & UI_BAR_VERTICAL) {
+        canvas.fill(UiRect{inner.x, (int16_t)(inner.y + inner.h - _fill), inner.w, _fill}, true);
+    } else {
+        canvas.fill(UiRect{inner.x, inner.y, _fill, inner.h}, true);
+    }
+}
+
+// ========== UiIcon ==========
+
+UiIcon::UiIcon(const UiRect& rect, const uint8_t* xbm)
+    : UiWidget(rect), _xbm(xbm), _visible(true) {}
+
+void UiIcon::setImage(const uint8_t* xbm) {
+    if (xbm == _xbm) {
+        return;
+    }
+    _xbm = xbm;
+    _dirty = true;
+}
+
+void UiIcon::setVisible(bool visible) {
+    if (visible == _visible) {
+        return;
+    }
+    _visible = visible;
+    _dirty = true;
+}
+
+void UiIcon::draw(UiCanvas& canvas) {
+    if (_visible && _xbm != nullptr) {
+        canvas.bitmap(_rect.x, _rect.y, _rect.w, _rect.h, _xbm);
+    }
+}
+
+// ========== UiScreen ==========
+
+UiScreen::UiScreen() : _count(0), _lastBounds{0, 0, 0, 0} {
+    resetStats();
+}
+
+void UiScreen::resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+bool UiScreen::add(UiWidget& widget) {
+    if (_count >= UI_MAX_WIDGETS) {
+        return false;
+    }
+    _widgets[_count++] = &widget;
+    widget.invalidate();
+    return true;
+}
+
+void UiScreen::invalidateAll() {
+    for (uint8_t i = 0; i < _count; i++) {
+        _widgets[i]->invalidate();
+    }
+}
+
+uint8_t UiScreen::render(UiCanvas& canvas, UiRect* boxes, uint8_t capacity) {
+    _stats.renders++;
+    _lastBounds = UiRect{0, 0, 0, 0};
+
+    // 重画某个控件会先清空它的矩形：与它相交的控件都要一起重画（直到不再扩大）
+    uint16_t redraw = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_widgets[i]->_dirty) {
+            redraw |= (uint16_t)(1u << i);
+        }
+    }
+    uint16_t requested = redraw;
+    bool grown = redraw != 0;
+    while (grown) {
+        grown = false;
+        for (uint8_t i = 0; i < _count; i++) {
+            if (redraw & (1u << i)) {
+                continue;
+            }
+            for (uint8_t j = 0; j < _count; j++) {
+                if ((redraw & (1u << j)) && uiRectIntersects(_widgets[i]->_rect, _widgets[j]->_rect)) {
+                    redraw |= (uint16_t)(1u << i);
+                    grown = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    uint8_t drawn = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        UiWidget& w = *_widgets[i];
+        if (!(redraw & (1u << i))) {
+            _stats.skipped++;
+            continue;
+        }
+        canvas.setClip(w._rect);
+        canvas.fill(w._rect, false);
+        w.draw(canvas);
+        w._dirty = false;
+
+        if (boxes != nullptr && drawn < capacity) {
+            boxes[drawn] = w._rect;
+        }
+        _lastBounds = uiRectUnion(_lastBounds, w._rect);
+        drawn++;
+    }
+    if (drawn > 0) {
+        canvas.clearClip();
+    }
+    _stats.drawn += drawn;
+    _stats.overlaps += (uint32_t)__builtin_popcount(redraw & ~requested);
+    return drawn;
+}
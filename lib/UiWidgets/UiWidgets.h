@@ -0,0 +1,224 @@
+#ifndef UI_WIDGETS_H
+#define UI_WIDGETS_H
+
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <U8g2lib.h>
+#endif
+
+/**
+ * UiWidgets - 保留模式界面（控件布局一次，只重画变化的控件）
+ *
+ * 原来的界面函数（updateDisplay、test2_SystemStatus…）每次都清屏后重画全部文字和进度条，
+ * 哪怕只变了一个数字。本模块：
+ * - 控件（文字 UiLabel、数值 UiValue、进度条 UiBar、图标 UiIcon）创建时确定矩形区域，加入 UiScreen
+ * - set*() 只在绑定的值确实变化（进度条为填充像素数变化）时标记控件无效
+ * - render() 只重画无效控件：先清空控件矩形，在矩形内裁剪绘制，并返回各控件的包围盒
+ * - 控件矩形重叠时，与重画控件相交的控件一起按加入顺序重画，结果与整屏重画相同
+ *
+ * 控件对象由调用方持有（全局或静态），UiScreen 只保存指针，不分配堆内存。
+ * 绘制经 UiCanvas：设备端 U8g2UiCanvas，主机端 RecordingUiCanvas。
+ */
+
+#define UI_MAX_WIDGETS   16
+#define UI_LABEL_MAX     32     // UiLabel 文字最大字节数（含结尾 0）
+
+// 进度条选项
+#define UI_BAR_FRAME     0x01   // 画 1 像素外框，填充在框内
+#define UI_BAR_VERTICAL  0x02   // 从下往上填充
+
+struct UiRect {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+};
+
+bool uiRectIntersects(const UiRect& a, const UiRect& b);
+UiRect uiRectUnion(const UiRect& a, const UiRect& b);   // 空矩形（w 或 h 为 0）不参与合并
+
+// 绘图接口（坐标为屏幕像素，y 向下）
+class UiCanvas {
+public:
+    virtual ~UiCanvas() {}
+
+    // 之后的绘制只影响 clip 内的像素
+    virtual void setClip(const UiRect& clip) = 0;
+    virtual void clearClip() = 0;
+
+    virtual void fill(const UiRect& rect, bool on) = 0;
+    // y 为基线
+    virtual void text(int16_t x, int16_t y, const char* str, const uint8_t* font) = 0;
+    // XBM 格式（按行，每行 (w+7)/8 字节，bit0 为最左像素），与 U8g2 drawXBMP 相同
+    virtual void bitmap(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* xbm) = 0;
+};
+
+class UiWidget {
+public:
+    explicit UiWidget(const UiRect& rect) : _rect(rect), _dirty(true) {}
+    virtual ~UiWidget() {}
+
+    const UiRect& rect() const { return _rect; }
+    bool dirty() const { return _dirty; }
+    void invalidate() { _dirty = true; }
+
+protected:
+    friend class UiScreen;
+
+    // 矩形已清空、裁剪已设置
+    virtual void draw(UiCanvas& canvas) = 0;
+
+    UiRect _rect;
+    bool _dirty;
+};
+
+// 文字（内容复制保存，可以传临时字符串）
+class UiLabel : public UiWidget {
+public:
+    /**
+     * @param baseline 基线相对矩形顶边的偏移
+     */
+    UiLabel(const UiRect& rect, const uint8_t* font, int16_t baseline, const char* text = "");
+
+    void setText(const char* text);
+    const char* text() const { return _text; }
+
+protected:
+    void draw(UiCanvas& canvas) override;
+
+private:
+    const uint8_t* _font;
+    int16_t _baseline;
+    char _text[UI_LABEL_MAX];
+};
+
+// 整数值，显示为 prefix + 数值 + suffix（prefix/suffix 须为常量字符串）
+class UiValue : public UiWidget {
+public:
+    UiValue(const UiRect& rect, const uint8_t* font, int16_t baseline,
+            const char* prefix = "", const char* suffix = "");
+
+    void setValue(int32_t value);
+    int32_t value() const { return _value; }
+
+protected:
+    void draw(UiCanvas& canvas) override;
+
+private:
+    const uint8_t* _font;
+    int16_t _baseline;
+    const char* _prefix;
+    const char* _suffix;
+    int32_t _value;
+};
+
+// 进度条（0 ~ maxValue），填充像素数不变时不重画
+class UiBar : public UiWidget {
+public:
+    UiBar(const UiRect& rect, int32_t maxValue, uint8_t flags = 0);
+
+    void setValue(int32_t value);
+    int32_t value() const { return _value; }
+    int16_t fillPixels() const { return _fill; }
+
+protected:
+    void draw(UiCanvas& canvas) override;
+
+private:
+    int16_t fillFor(int32_t value) const;
+
+    int32_t _max;
+    uint8_t _flags;
+    int32_t _value;
+    int16_t _fill;
+};
+
+// 图标（XBM 位图，尺寸与矩形相同），切换图片或显隐时重画
+class UiIcon : public UiWidget {
+public:
+    UiIcon(const UiRect& rect, const uint8_t* xbm);
+
+    void setImage(const uint8_t* xbm);
+    void setVisible(bool visible);
+
+protected:
+    void draw(UiCanvas& canvas) override;
+
+private:
+    const uint8_t* _xbm;
+    bool _visible;
+};
+
+struct UiRenderStats {
+    uint32_t renders;    // render() 次数
+    uint32_t drawn;      // 重画的控件数
+    uint32_t skipped;    // 未变化、跳过的控件数
+    uint32_t overlaps;   // 因与重画控件重叠而一起重画的控件数
+};
+
+class UiScreen {
+public:
+    UiScreen();
+
+    // 按绘制顺序加入（后加入的画在上面），超过 UI_MAX_WIDGETS 返回 false
+    bool add(UiWidget& widget);
+
+    // 全部标记无效（屏幕被其他内容覆盖后）
+    void invalidateAll();
+
+    /**
+     * 重画无效控件
+     * @param boxes 输出重画控件的矩形（可为 nullptr），最多 capacity 个
+     * @return 重画的控件数，0 表示屏幕没有变化
+     */
+    uint8_t render(UiCanvas& canvas, UiRect* boxes = nullptr, uint8_t capacity = 0);
+
+    // 最近一次 render() 重画区域的并集（没有重画时 w = h = 0）
+    const UiRect& lastBounds() const { return _lastBounds; }
+
+    uint8_t count() const { return _count; }
+    const UiRenderStats& stats() const { return _stats; }
+    void resetStats();
+
+private:
+    UiWidget* _widgets[UI_MAX_WIDGETS];
+    uint8_t _count;
+    UiRect _lastBounds;
+    UiRenderStats _stats;
+};
+
+#ifdef ARDUINO
+// 直接画进 U8g2 缓冲（不发送，发送由 TileFlusher / AsyncDisplayFlush 负责）
+class U8g2UiCanvas : public UiCanvas {
+public:
+    explicit U8g2UiCanvas(U8G2& u8g2) : _u8g2(u8g2) {}
+
+    void setClip(const UiRect& clip) override {
+        _u8g2.setClipWindow(clip.x, clip.y, clip.x + clip.w, clip.y + clip.h);
+    }
+
+    void clearClip() override { _u8g2.setMaxClipWindow(); }
+
+    void fill(const UiRect& rect, bool on) override {
+        _u8g2.setDrawColor(on ? 1 : 0);
+        _u8g2.drawBox(rect.x, rect.y, rect.w, rect.h);
+        _u8g2.setDrawColor(1);
+    }
+
+    void text(int16_t x, int16_t y, const char* str, const uint8_t* font) override {
+        _u8g2.setFont(font);
+        _u8g2.setFontMode(1);
+        _u8g2.drawUTF8(x, y, str);
+    }
+
+    void bitmap(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* xbm) override {
+        _u8g2.drawXBMP(x, y, w, h, xbm);
+    }
+
+private:
+    U8G2& _u8g2;
+};
+#endif
+
+#endif // UI_WIDGETS_H
@@ -0,0 +1,212 @@
+#include "WavFile.h"
+#include <string.h>
+
+// WAV 文件头固定44字节（RIFF + fmt + data）
+static const uint32_t WAV_HEADER_SIZE = 44;
+
+static void putLE16(uint8_t* p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static void putLE32(uint8_t* p, uint32_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = v >> 24;
+}
+
+// ========== WavWriter ==========
+
+WavWriter::WavWriter() : _file(nullptr), _sampleRate(0), _channels(0), _dataBytes(0) {}
+
+WavWriter::~WavWriter() {
+    close();
+}
+
+bool WavWriter::open(const char* path, uint32_t sampleRate, uint16_t channels) {
+    close();
+
+    _file = fopen(path, "wb");
+    if (_file == nullptr) {
+        return false;
+    }
+
+    _sampleRate = sampleRate;
+    _channels = channels;
+    _dataBytes = 0;
+    return writeHeader();
+}
+
+bool WavWriter::writeHeader() {
+    uint8_t h[WAV_HEADER_SIZE];
+    memcpy(h, "RIFF", 4);
+    putLE32(h + 4, 36 + _dataBytes);
+    memcpy(h + 8, "WAVEfmt ", 8);
+    putLE32(h + 16, 16);                              // fmt 块长度
+    putLE16(h + 20, 1);                               // PCM
+    putLE16(h + 22, _channels);
+    putLE32(h + 24, _sampleRate);
+    putLE32(h + 28, _sampleRate * _channels * 2);     // 字节率
+    putLE16(h + 32, _channels * 2);                   // 块对齐
+    putLE16(h + 34, 16);                              // 位深
+    memcpy(h + 36, "data", 4);
+    putLE32(h + 40, _dataBytes);
+
+    fseek(_file, 0, SEEK_SET);
+    return fwrite(h, 1, sizeof(h), _file) == sizeof(h);
+}
+
+bool WavWriter::write(const int16_t* samples, size_t count) {
+    if (_file == nullptr) {
+        return false;
+    }
+
+    // 逐个转小端，主机字节序无关
+    uint8_t buf[256];
+    size_t done = 0;
+    while (done < count) {
+        size_t n = count - done;
+        if (n > sizeof(buf) / 2) n = sizeof(buf) / 2;
+        for (size_t i = 0; i < n; i++) {
+            putLE16(buf + i * 2, (uint16_t)samples[done + i]);
+        }
+        if (fwrite(buf, 2, n, _file) != n) {
+            return false;
+        }
+        done += n;
+    }
+
+    _dataBytes += count * 2;
+    return true;
+}
+
+bool WavWriter::close() {
+    if (_file == nullptr) {
+        return true;
+    }
+
+    bool ok = writeHeader();
+    ok = (fclose(_file) == 0) && ok;
+    _file = nullptr;
+    return ok;
+}
+
+// ========== WavReader ==========
+
+static uint16_t getLE16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t getLE32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+WavReader::WavReader()
+    : _file(nullptr), _sampleRate(0), _channels(0), _bitsPerSample(0),
+      _totalFrames(0), _framesRead(0), _dataStart(0) {}
+
+WavReader::~WavReader() {
+    close();
+}
+
+void WavReader::close() {
+    if (_file != nullptr) {
+        fclose(_file);
+        _file = nullptr;
+    }
+}
+
+bool WavReader::open(const char* path) {
+    close();
+
+    _file = fopen(path, "rb");
+    if (_file == nullptr) {
+        return false;
+    }
+
+    uint8_t riff[12];
+    if (fread(riff, 1, 12, _file) != 12 || memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0) {
+        close();
+        return false;
+    }
+
+    // 逐块扫描，跳过 LIST 等无关块
+    bool haveFormat = false;
+    uint8_t chunk[8];
+    while (fread(chunk, 1, 8, _file) == 8) {
+        uint32_t size = getLE32(chunk + 4);
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            uint8_t fmt[16];
+            if (size < 16 || fread(fmt, 1, 16, _file) != 16) break;
+            uint16_t formatTag = getLE16(fmt);
+            _channels = getLE16(fmt + 2);
+            _sampleRate = getLE32(fmt + 4);
+            _bitsPerSample = getLE16(fmt + 14);
+            // 1 = PCM, 0xFFFE = WAVE_FORMAT_EXTENSIBLE（按 PCM 处理）
+            haveFormat = (formatTag == 1 || formatTag == 0xFFFE) && _channels > 0 &&
+                         (_bitsPerSample == 16 || _bitsPerSample == 24 || _bitsPerSample == 32);
+            fseek(_file, (long)(size - 16 + (size & 1)), SEEK_CUR);
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!haveFormat) break;
+            _dataStart = ftell(_file);
+            _totalFrames = size / (_channels * (_bitsPerSample / 8));
+            _framesRead = 0;
+            return true;
+        } else {
+            fseek(_file, (long)(size + (size & 1)), SEEK_CUR);
+        }
+    }
+
+    close();
+    return false;
+}
+
+size_t WavReader::readFrames(int32_t* out, size_t frames) {
+    if (_file == nullptr) {
+        return 0;
+    }
+
+    size_t remaining = _totalFrames - _framesRead;
+    if (frames > remaining) frames = remaining;
+
+    const size_t bytesPerSample = _bitsPerSample / 8;
+    uint8_t buf[512];
+    size_t samplesWanted = frames * _channels;
+    size_t done = 0;
+
+    while (done < samplesWanted) {
+        size_t n = samplesWanted - done;
+        if (n > sizeof(buf) / bytesPerSample) n = sizeof(buf) / bytesPerSample;
+        size_t got = fread(buf, bytesPerSample, n, _file);
+
+        for (size_t i = 0; i < got; i++) {
+            const uint8_t* p = buf + i * bytesPerSample;
+            uint32_t v;
+            if (bytesPerSample == 2) {
+                v = (uint32_t)getLE16(p) << 16;
+            } else if (bytesPerSample == 3) {
+                v = ((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24);
+            } else {
+                v = getLE32(p);
+            }
+            out[done + i] = (int32_t)v;
+        }
+
+        done += got;
+        if (got < n) break;  // 文件被截断
+    }
+
+    size_t framesDone = done / _channels;
+    _framesRead += framesDone;
+    return framesDone;
+}
+
+bool WavReader::rewind() {
+    if (_file == nullptr) {
+        return false;
+    }
+    _framesRead = 0;
+    return fseek(_file, _dataStart, SEEK_SET) == 0;
+}
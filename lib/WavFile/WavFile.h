@@ -0,0 +1,73 @@
+#ifndef WAV_FILE_H
+#define WAV_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * WavFile - PCM WAV 文件读写（主机端工具）
+ *
+ * 用于主机端测试和仿真：把混音输出写成 WAV 方便试听/比对，
+ * 或者把录音/合成声场读出来喂给音频处理链路。
+ * 写入只支持 16位 PCM；读取支持 16/24/32位 PCM，声道数任意（采样交织存放）。
+ */
+
+class WavWriter {
+public:
+    WavWriter();
+    ~WavWriter();
+
+    bool open(const char* path, uint32_t sampleRate, uint16_t channels = 1);
+
+    // 写入 samples 个 int16（多声道时为交织后的总数）
+    bool write(const int16_t* samples, size_t count);
+
+    // 回填文件头中的长度字段并关闭
+    bool close();
+
+    uint32_t samplesWritten() const { return _dataBytes / 2; }
+
+private:
+    bool writeHeader();
+
+    FILE* _file;
+    uint32_t _sampleRate;
+    uint16_t _channels;
+    uint32_t _dataBytes;
+};
+
+class WavReader {
+public:
+    WavReader();
+    ~WavReader();
+
+    bool open(const char* path);
+    void close();
+
+    /**
+     * 读取最多 frames 帧，输出为左对齐 int32（与 I2S 32位采样格式一致：
+     * 16位样本位于高16位）
+     * @param out 交织输出，容量至少 frames * channels()
+     * @return 实际读取帧数，0 表示文件结束
+     */
+    size_t readFrames(int32_t* out, size_t frames);
+
+    bool rewind();
+
+    uint32_t sampleRate() const { return _sampleRate; }
+    uint16_t channels() const { return _channels; }
+    uint16_t bitsPerSample() const { return _bitsPerSample; }
+    uint32_t totalFrames() const { return _totalFrames; }
+
+private:
+    FILE* _file;
+    uint32_t _sampleRate;
+    uint16_t _channels;
+    uint16_t _bitsPerSample;
+    uint32_t _totalFrames;
+    uint32_t _framesRead;
+    long _dataStart;
+};
+
+#endif // WAV_FILE_H
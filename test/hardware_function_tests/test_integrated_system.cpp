@@ -1,10 +1,30 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <U8g2lib.h>
-#include <Adafruit_NeoPixel.h>
-#include <ESP32Servo.h>
 // 使用Arduino兼容的旧版I2S API
 #include <driver/i2s.h>
+#include "SoundBank.h"
+#include "AudioPlayback.h"
+#include "AudioSource.h"
+#include "AudioAnalyzer.h"
+#include "SelfNoiseGate.h"
+#include "MotionState.h"
+#include "LedCompositor.h"
+#include "AsyncLedStrip.h"
+#include "LedAnimation.h"
+#include "LedVisualizer.h"
+#include "AudioLevels.h"
+#include "TileFlusher.h"
+#include "AsyncDisplayFlush.h"
+#include "UiWidgets.h"
+#include "TaskScheduler.h"
+#include "Pipeline.h"
+#include "StateMachine.h"
+#include "Trace.h"
+#include "LatencyHistogram.h"
+#include "Telemetry.h"
+#include "Log.h"
+#include "Esp32Hal.h"
 
 /**
  * MOSS 综合联动测试程序 - I2S数字麦克风版本
@@ -24,6 +44,21 @@
 // 使用 U8g2 库（支持中文）
 U8G2_SSD1306_128X64_NONAME_F_HW_I2C display(U8G2_R0, U8X8_PIN_NONE, I2C_SCL, I2C_SDA);
 
+// 绘制仍在 U8g2 缓冲中进行，发送时只发出与上一帧不同的 8×8 块（代替整帧 sendBuffer()）
+U8g2TileTransport displayBus(display);
+TileFlusher displayFlush(displayBus);
+
+// I2C 发送放在低优先级刷新任务中：主循环只复制缓冲（固定耗时），刷新跟不上时丢弃旧帧
+AsyncDisplayFlush displayTask(displayFlush);
+
+// 状态界面（保留模式）：控件布局一次，updateDisplay() 只重画值有变化的控件，没有变化时不提交
+U8g2UiCanvas uiCanvas(display);
+UiLabel uiTitle(UiRect{30, 3, 64, 20}, u8g2_font_ncenB14_tr, 17, "MOSS");
+UiLabel uiState(UiRect{0, 26, 128, 12}, u8g2_font_ncenB08_tr, 9);
+UiValue uiVolume(UiRect{0, 41, 64, 12}, u8g2_font_ncenB08_tr, 9, "Vol: ");
+UiBar uiVolumeBar(UiRect{0, 54, 128, 10}, 256);   // 宽度 = 音量 / 2
+UiScreen statusScreen;
+
 // ========== LED 配置 ==========
 #define LED_PIN         48  // 所有LED共用一个引脚
 #define LED_COUNT       5   // 总共5个LED（2个摄像头 + 3个机身）
@@ -32,17 +67,54 @@ U8G2_SSD1306_128X64_NONAME_F_HW_I2C display(U8G2_R0, U8X8_PIN_NONE, I2C_SCL, I2C
 #define LED_BODY_START   2  // 机身LED起始索引
 #define LED_BODY_COUNT   3  // 机身LED数量
 
-Adafruit_NeoPixel leds(LED_COUNT, LED_PIN, NEO_GRB + NEO_KHZ800);
+// RMT 非阻塞输出：show() 只编码波形，发送由 RMT 硬件完成，不再关中断逐位发送
+RmtLedTransport ledTransport(LED_PIN, RMT_CHANNEL_0);
+AsyncLedStrip leds(LED_COUNT, ledTransport);
+
+// 所有像素写入先进入帧合成器，loop() 末尾每帧最多 show() 一次（只在有修改时）
+LedCompositor ledFrame(leds);
+int8_t zoneEye = -1;   // 瞳孔（索引0-1）
+int8_t zoneBody = -1;  // 机身（索引2-4）
+
+// 灯效由关键帧动画引擎按固定帧率计算，状态切换时只更换图层的颜色/轨道
+LedAnimator ledAnim(ledFrame);
+int8_t layerEye = -1;    // 瞳孔底色
+int8_t layerBody = -1;   // 机身底色
+int8_t layerFlash = -1;  // 机身叠加闪光（检测到声音时脉冲一次）
+int8_t layerEyeAudio = -1;  // 瞳孔叠加：随高频电平（辅音）闪亮
+
+// 音频联动：采集端每段发布电平，LED 端按帧取最新一帧驱动图层（监听/活跃状态启用）
+LedVisualizer ledVis(ledAnim);
+int8_t visBody = -1;     // 机身亮度跟随全频带电平
+int8_t visEye = -1;      // 瞳孔叠加跟随高频电平
+
+// 瞳孔呼吸：比待机呼吸快（与原 eyeBreathEffect 的约1.6秒周期一致）
+const LedKeyframe EYE_BREATH_KEYS[] = {{0, 136}, {800, 255}, {1600, 136}};
+const LedTrack EYE_BREATH = {EYE_BREATH_KEYS, 3, true};
 
 // ========== 舵机配置 ==========
 #define SERVO_PIN_HORIZONTAL  4
 #define SERVO_PIN_VERTICAL    5
 
-Servo servoH;
-Servo servoV;
+// 经硬件抽象层输出（lib/Hal）：设备端 ESP32Servo，主机端可换成 RecordingServo
+Esp32ServoOutput servoH;
+Esp32ServoOutput servoV;
+
+// 运动阶段写入，决策阶段读取（待机微动以当前角度为基准）
+std::atomic<int> angleH(90);
+std::atomic<int> angleV(90);
 
-int angleH = 90;
-int angleV = 90;
+// 进行中的平滑转动：运动阶段收到转动命令后设定目标，舵机任务按步进间隔推进
+struct ServoMove {
+    int fromH, fromV;
+    int toH, toV;
+    int steps;
+    int step;
+    unsigned long stepMs;
+    unsigned long lastStepMs;
+    bool active;
+};
+ServoMove servoMove = {};
 
 // ========== 麦克风配置 ==========
 // I2S数字麦克风（INMP441或类似）- 立体声配置
@@ -51,20 +123,37 @@ int angleV = 90;
 #define I2S_WS_PIN      7   // 字选择（两个麦克风共用，区分左右声道）
 #define I2S_SD_PIN      12  // 数据线（两个麦克风共用，分时复用）
 #define SAMPLE_RATE     16000
-#define BUFFER_SIZE     512
+#define BUFFER_SIZE     CAPTURE_FRAME_SAMPLES  // 分析窗口 512
+#define CAPTURE_HOP     CAPTURE_HOP_SAMPLES    // 每次读取一个 DMA 缓冲（16ms）
 
-// 音频缓冲区
+// 音频缓冲区（分析窗口，每次滑动 CAPTURE_HOP）
 int32_t audioBuffer[BUFFER_SIZE * 2];  // 立体声需要双倍大小
+int32_t hopBuffer[CAPTURE_HOP * 2];
 size_t bytesRead = 0;
 
 // 麦克风间距（单位：米）
 const float MIC_DISTANCE = 0.07;  // 7cm
 const float SOUND_SPEED = 343.0;  // 声速 m/s
 
+// 麦克风帧来源与分析器（主机端仿真 tools/audio_sim 使用同一个 AudioAnalyzer）
+I2sAudioSource micSource(I2S_PORT, SAMPLE_RATE, pdMS_TO_TICKS(10));
+AudioAnalyzer analyzer;
+AudioLevelMeter levelMeter(SAMPLE_RATE);
+
+// 舵机自噪声：运动阶段发布转动开始/结束事件，采集阶段据此按速度档抑制齿轮声
+MotionTracker motion;
+SelfNoiseGate selfNoise;
+
 // ========== 喇叭配置 ==========
 #define SPK_LCK     9
 #define SPK_BCK     10
 #define SPK_DOUT    11
+#define SPK_I2S_PORT I2S_NUM_1  // 麦克风占用 I2S_NUM_0
+
+// 音效库：闪存 "sounds" 分区（tools/make_soundbank.py 生成），内存映射后直接播放
+SoundBank soundBank;
+AudioPlayback speaker(soundBank, SAMPLE_RATE);
+bool speakerReady = false;
 
 // ========== 系统状态 ==========
 enum SystemState {
@@ -74,13 +163,163 @@ enum SystemState {
     STATE_SPEAKING   // 说话中
 };
 
-SystemState currentState = STATE_IDLE;
-unsigned long lastSoundTime = 0;
-unsigned long stateStartTime = 0;
+// 状态机事件：声音/转动/播放事件由决策阶段每轮从队列和帧中产生（见 runDecisionRound），
+// 命令事件由串口命令产生，定时器事件由状态的定时器产生
+enum SystemEvent : uint8_t {
+    EV_SOUND_ONSET,      // 音量越过阈值（arg = 声源方向°）
+    EV_SOUND_END,        // 音量回到阈值以下
+    EV_SILENCE_TIMEOUT,  // 活跃状态持续无声（定时器）
+    EV_MOTION_DONE,      // 运动阶段报告转动结束（arg = 水平角度）
+    EV_IDLE_TICK,        // 待机微动（定时器）
+    EV_PLAYBACK_DONE,    // 播放结束
+    EV_CMD_IDLE,         // 命令：回到待机
+    EV_CMD_LISTEN,       // 命令：进入监听
+    EV_CMD_TRIGGER,      // 命令：模拟声音触发（arg = 声源方向°）
+    EV_CMD_SPEAK,        // 命令：播放音效（arg = 音效编号）
+    EV_COUNT
+};
+
+// 状态机定时器：状态切换时全部取消，由进入动作重新启动
+enum SystemTimer : uint8_t {
+    TIMER_STATE    // 待机微动 / 活跃静音超时
+};
+
+#define SILENCE_TIMEOUT_MS   3000   // 活跃状态无声多久回到监听
+#define IDLE_MOVE_MS         3000   // 待机微动间隔
+
+// 显示阶段绘制的状态栏内容（决策阶段经状态队列发来）
+const char* statusText = "IDLE";
+float statusVolume = 0;
+
+// 决策阶段取到的最新一帧分析结果
+AudioFrameStats latestFrame = {};
+
+// 运动阶段的灯效状态（决策阶段在状态变化时经命令队列发来）
+SystemState ledTargetState = STATE_IDLE;
+
+// ========== 流水线 ==========
+// 四个阶段各一个 FreeRTOS 任务、固定在一个核上，阶段之间只经有界队列通信（lib/Pipeline）：
+//   采集+DSP（核0）--frames--> 决策（核1）--motion--> 运动+灯效（核1）
+//   决策 --status--> 显示+遥测（核0）；运动 --events--> 采集（自噪声门控）；运动 --done--> 决策（转动结束）
+// 音频分析的耗时不再推迟舵机和灯效；阶段内的子任务仍由各自的 TaskScheduler 按周期调度
+#define SERVO_PERIOD_US      5000                                        // 200Hz
+#define AUDIO_PERIOD_US      (CAPTURE_HOP * 1000000UL / SAMPLE_RATE)     // 每个采集块，16ms（由 I2S 读取决定）
+#define LED_PERIOD_US        (LED_FRAME_MS * 1000)                       // 100Hz，与 LED 帧相同（声音到灯光 < 30ms）
+#define DISPLAY_PERIOD_US    100000                                      // 10Hz
+#define SERIAL_PERIOD_US     20000                                       // 50Hz
+#define TELEMETRY_PERIOD_US  1000000                                     // 1Hz
+#define TRACE_PERIOD_US      100000                                      // 10Hz（'x' 开启时导出追踪块）
+#define TRACE_EXPORT_BYTES   1024                                        // 每个追踪块的最大字节数
+#define TELEM_TX_PERIOD_US   50000                                       // 20Hz（'b' 开启时发送遥测帧）
+#define TELEM_TX_BYTES       512                                         // 每次 pump 的缓冲
+#define LOG_PERIOD_US        50000                                       // 20Hz（格式化或导出日志）
+#define LOG_LINES_PER_RUN    8                                           // 文本模式每次最多打印的行数
+
+// 决策 → 运动：转动目标或灯效状态
+enum MotionCommandType : uint8_t {
+    MOTION_MOVE,
+    MOTION_LED_STATE
+};
+
+struct MotionCommand {
+    MotionCommandType type;
+    int16_t targetH;
+    int16_t targetV;
+    uint16_t stepMs;
+    uint8_t state;
+};
+
+// 运动 → 采集：转动开始/结束
+struct MotionEvent {
+    bool moving;
+    float velocityDps;
+    uint32_t timeMs;
+};
+
+// 决策 → 显示：状态栏内容（变化时才发送）
+struct StatusUpdate {
+    const char* text;
+    float volume;
+};
+
+PipelineQueue<AudioFrameStats, 8> frameQueue;
+PipelineQueue<MotionCommand, 8> motionQueue;
+PipelineQueue<StatusUpdate, 8> statusQueue;
+PipelineQueue<MotionEvent, 8> motionEventQueue;
+PipelineQueue<int16_t, 4> motionDoneQueue;   // 运动 → 决策：转动结束时的水平角度
+Pipeline pipeline;
+
+Esp32Clock halClock;                       // 硬件抽象层的时钟（micros/millis）
+Esp32Serial halSerial(Serial);             // 命令输入和二进制帧输出
+TaskScheduler decisionTasks(halClock);     // 决策阶段：串口命令（状态处理由状态机按事件运行）
+TaskScheduler motionTasks(halClock);       // 运动阶段：舵机、灯效
+TaskScheduler uiTasks(halClock);           // 显示阶段：显示、遥测
+int8_t serialTaskId = SCHED_NO_TASK;
+
+std::atomic<bool> ledTestActive(false);       // LED 映射测试直接写 LED，期间灯效任务暂停
+std::atomic<bool> telemetryRequested(false);  // 'p' 命令：下一次遥测时打印统计
+std::atomic<bool> traceStreaming(false);      // 'x' 命令：显示阶段持续经串口发送追踪块
+std::atomic<bool> histogramsRequested(false); // 'j' 命令：下一次遥测时打印直方图
+
+// 节拍/耗时直方图（lib/LatencyHistogram）：从启动开始累计，'j' 打印 p50/p99/最大值和超时次数，
+// 并输出 HIST 行供 tools/merge_histograms.py 汇总多台设备
+LatencyHistogram motionTickHist("motion_tick", SERVO_PERIOD_US * 3 / 2);   // 舵机任务相邻两拍的间隔，晚半个周期算超时
+LatencyHistogram audioFrameHist("audio_frame", AUDIO_PERIOD_US);           // 每个采集块的处理耗时，超过一个采集块算超时
+LatencyHistogram displayFlushHist("display_flush", DISPLAY_PERIOD_US);     // 每帧的 I2C 发送耗时，超过显示周期算超时
+uint32_t queueDropsSeen[PIPELINE_MAX_QUEUES] = {};
+
+// ========== 二进制遥测 ==========
+// 取代原来监听/活跃状态中定时打印的调试行（lib/Telemetry）：各阶段只把定长记录复制进自己的队列，
+// 显示阶段的发送任务在 'b' 开启时编码为 COBS 帧经串口发出，由 tools/telemetry_decode.py 转成 CSV 或曲线；
+// 未开启时记录被丢掉。字段描述必须与结构体逐字节一致（setupTelemetry 检查大小）
+enum TelemetryType : uint8_t {
+    TEL_LEVELS = 1,   // 决策阶段，每个新帧
+    TEL_ANGLES = 2,   // 运动阶段，舵机每走一步
+    TEL_STATE = 3,    // 决策阶段，状态变化时
+    TEL_TIMING = 4    // 显示阶段，每秒一次（直方图的 p99 和超时次数）
+};
+
+struct LevelsTelemetry {
+    float leftPeak;
+    float rightPeak;
+    float volume;
+    float rms;
+    float noiseFloor;
+    int16_t direction;
+    uint8_t state;
+    uint8_t flags;      // bit0 = 越过阈值，bit1 = 有人声
+};
+
+struct AnglesTelemetry {
+    int16_t h;
+    int16_t v;
+    int16_t targetH;
+    int16_t targetV;
+};
+
+struct StateTelemetry {
+    uint8_t from;
+    uint8_t to;
+    int16_t direction;
+};
+
+struct TimingTelemetry {
+    uint32_t motionP99Us;
+    uint32_t audioP99Us;
+    uint32_t flushP99Us;
+    uint32_t motionMissed;
+    uint32_t audioMissed;
+    uint32_t flushMissed;
+};
+
+TelemetryChannel telemetry;
+TelemetrySource decisionTelemetry;   // 只在决策阶段 send
+TelemetrySource motionTelemetry;     // 只在运动阶段 send
+TelemetrySource uiTelemetry;         // 只在显示阶段 send
+std::atomic<bool> telemetryStreaming(false);   // 'b' 命令：显示阶段持续经串口发送遥测帧
 
 // 音量阈值（固定低阈值）
 const float TRIGGER_THRESHOLD = 100;  // 固定阈值90
-float currentVolume = 0;
 
 // ========== 颜色定义 ==========
 // 机身LED状态颜色（索引2-4）
@@ -112,7 +351,20 @@ void setupDisplay() {
     display.setCursor(20, 50);
     display.print("Starting...");
     
-    display.sendBuffer();
+    displayFlush.flush(display.getBufferPtr());
+    
+    // 状态界面：启动画面之后第一次 updateDisplay() 在清空的缓冲上画出全部控件
+    statusScreen.add(uiTitle);
+    statusScreen.add(uiState);
+    statusScreen.add(uiVolume);
+    statusScreen.add(uiVolumeBar);
+    display.clearBuffer();
+    
+    // 此后显示只经刷新任务访问 I2C（核心0，低于音频输出任务）
+    displayTask.setFlushHistogram(&displayFlushHist);
+    if (!displayTask.begin(1, 0)) {
+        Serial.println("[ERROR] 显示刷新任务启动失败");
+    }
     
     Serial.println("[INIT] ✓ 显示屏初始化成功");
 }
@@ -120,11 +372,28 @@ void setupDisplay() {
 void setupLEDs() {
     Serial.println("[INIT] 初始化LED（5个LED串联）...");
     
-    leds.begin();
+    if (!leds.begin()) {
+        Serial.println("[ERROR] LED初始化失败（RMT）");
+        return;
+    }
     leds.setBrightness(128);
     leds.show();
     
-    Serial.println("[INIT] ✓ LED初始化成功（GPIO48控制5个LED）");
+    zoneEye = ledFrame.defineZone("eye", LED_CAMERA_START, LED_CAMERA_COUNT);
+    zoneBody = ledFrame.defineZone("body", LED_BODY_START, LED_BODY_COUNT);
+    
+    layerBody = ledAnim.addLayer(zoneBody, COLOR_IDLE, &LED_TRACK_BREATHE);
+    layerEye = ledAnim.addLayer(zoneEye, COLOR_EYE_DIM);
+    layerFlash = ledAnim.addLayer(zoneBody, leds.Color(255, 255, 255), nullptr, LED_BLEND_ADD, LED_FIXED_ONE / 2);
+    ledAnim.setLevel(layerFlash, 0);
+    layerEyeAudio = ledAnim.addLayer(zoneEye, COLOR_EYE_FOCUS, nullptr, LED_BLEND_ADD, LED_FIXED_ONE / 2);
+    ledAnim.setLevel(layerEyeAudio, 0);
+    
+    // 起音 5ms（下一个 LED 帧即亮），释放较慢避免闪烁；机身最低保持约一半亮度
+    visBody = ledVis.bind(layerBody, LED_VIS_LEVEL, 5, 250, 136);
+    visEye = ledVis.bind(layerEyeAudio, LED_VIS_HIGH, 5, 150);
+    
+    Serial.println("[INIT] ✓ LED初始化成功（GPIO48控制5个LED，RMT非阻塞输出）");
 }
 
 void setupServos() {
@@ -133,10 +402,7 @@ void setupServos() {
     ESP32PWM::allocateTimer(0);
     ESP32PWM::allocateTimer(1);
     
-    servoH.setPeriodHertz(50);
     servoH.attach(SERVO_PIN_HORIZONTAL, 500, 2500);
-    
-    servoV.setPeriodHertz(50);
     servoV.attach(SERVO_PIN_VERTICAL, 500, 2500);
     
     servoH.write(angleH);
@@ -183,6 +449,11 @@ void setupMicrophone() {
         return;
     }
     
+    // 每 16ms 分析一次（窗口重叠一半），按帧计的时间常数加倍以保持原来的时长（与 audio_sim 相同）
+    AudioAnalyzerConfig config;
+    config.triggerThreshold = TRIGGER_THRESHOLD;
+    analyzer.setConfig(slidingWindowConfig(config, BUFFER_SIZE, CAPTURE_HOP));
+    
     Serial.println("[INIT] ✓ I2S麦克风初始化成功");
     Serial.printf("[INFO] 采样率: %d Hz\n", SAMPLE_RATE);
     Serial.println("[INFO] 引脚: SCK=GPIO13, WS=GPIO7, SD=GPIO12");
@@ -194,337 +465,514 @@ void setupMicrophone() {
     Serial.println("  右麦克风：SEL接3.3V");
 }
 
+// 舵机自噪声校准：保持安静，按 smoothMove 的三种速度来回转动水平舵机并学习噪声谱
+void calibrateSelfNoise() {
+    Serial.println("[INIT] 舵机自噪声校准（请保持安静）...");
+
+    const float velocities[3] = { 50.0f, 100.0f, 200.0f };  // smoothMove 延时 20 / 10 / 5ms
+    const int FRAMES_PER_SPEED = 24;                         // 约0.8秒
+    const float frameSec = (float)BUFFER_SIZE / SAMPLE_RATE;
+
+    for (int v = 0; v < 3; v++) {
+        float stepDeg = velocities[v] * frameSec;  // 每帧转动角度
+        float angle = 90;
+        int dir = 1;
+
+        // 丢弃 DMA 缓冲中的旧数据
+        micSource.readFrame(audioBuffer, BUFFER_SIZE);
+        micSource.readFrame(audioBuffer, BUFFER_SIZE);
+
+        for (int i = 0; i < FRAMES_PER_SPEED; i++) {
+            angle += dir * stepDeg;
+            if (angle >= 110 || angle <= 70) dir = -dir;
+            servoH.write((int)angle);
+
+            size_t frames = micSource.readFrame(audioBuffer, BUFFER_SIZE);
+            selfNoise.learn(audioBuffer, frames, velocities[v]);
+        }
+        Serial.printf("[INFO] 速度 %.0f°/s 噪声谱已学习\n", velocities[v]);
+    }
+
+    servoH.write(angleH);
+    delay(200);
+    Serial.println("[INIT] ✓ 自噪声校准完成");
+}
+
+void setupSpeaker() {
+    Serial.println("[INIT] 初始化喇叭（NS4168, I2S）...");
+    
+    if (!soundBank.mapPartition("sounds")) {
+        Serial.println("[WARN] 未找到音效分区 \"sounds\"，喇叭不可用");
+        return;
+    }
+    
+    if (!speaker.begin(SPK_I2S_PORT, SPK_BCK, SPK_LCK, SPK_DOUT, 0)) {
+        Serial.println("[ERROR] 喇叭输出任务启动失败");
+        return;
+    }
+    
+    speakerReady = true;
+    Serial.printf("[INIT] ✓ 喇叭初始化成功（%d 个音效）\n", soundBank.clipCount());
+    Serial.println("[INFO] 引脚: LCK=GPIO9, BCK=GPIO10, DOUT=GPIO11");
+}
+
 // ========== 功能函数 ==========
 
+// 以下函数直接写入帧合成器，用于启动自检和LED映射测试（阻塞流程，用 showLEDs() 立即发送）；
+// 正常运行时的灯效由 updateLEDs() 中的动画引擎写入
+
 void setAllLEDs(uint32_t color) {
-    for (int i = 0; i < LED_COUNT; i++) {
-        leds.setPixelColor(i, color);
-    }
-    leds.show();
+    ledFrame.fill(color);
 }
 
 // 只设置摄像头LED（瞳孔，索引0-1）
 void setEyeLEDs(uint32_t color) {
-    for (int i = LED_CAMERA_START; i < LED_CAMERA_START + LED_CAMERA_COUNT; i++) {
-        leds.setPixelColor(i, color);
-    }
-    leds.show();
+    ledFrame.fillZone(zoneEye, color);
 }
 
 // 只设置机身LED（状态灯环，索引2-4）
 void setBodyLEDs(uint32_t color) {
-    for (int i = LED_BODY_START; i < LED_BODY_START + LED_BODY_COUNT; i++) {
-        leds.setPixelColor(i, color);
-    }
-    leds.show();
+    ledFrame.fillZone(zoneBody, color);
 }
 
-// 同时设置机身和瞳孔LED（避免两次show()调用）
-void setBodyAndEyeLEDs(uint32_t bodyColor, uint32_t eyeColor) {
-    for (int i = LED_BODY_START; i < LED_BODY_START + LED_BODY_COUNT; i++) {
-        leds.setPixelColor(i, bodyColor);
-    }
-    for (int i = LED_CAMERA_START; i < LED_CAMERA_START + LED_CAMERA_COUNT; i++) {
-        leds.setPixelColor(i, eyeColor);
-    }
-    leds.show();
+// 立即发送（仍然只在有修改时调用 show()）
+void showLEDs() {
+    ledFrame.flushNow();
 }
 
-// 瞳孔呼吸效果（模拟注意力集中）
-void eyeBreathEffect() {
-    static unsigned long lastUpdate = 0;
-    static int brightness = 50;
-    static int direction = 1;
-    
-    if (millis() - lastUpdate > 10) {
-        brightness += direction * 5;
-        
-        if (brightness >= 255) {
-            brightness = 255;
-            direction = -1;
-        } else if (brightness <= 50) {
-            brightness = 50;
-            direction = 1;
-        }
-        
-        uint32_t color = leds.Color(brightness, 0, 0);
-        setEyeLEDs(color);
-        lastUpdate = millis();
+// 音频联动开关：关闭时机身恢复常亮、瞳孔叠加熄灭
+void setAudioReactive(bool enabled) {
+    ledVis.setEnabled(visBody, enabled);
+    ledVis.setEnabled(visEye, enabled);
+    if (!enabled) {
+        ledAnim.setLevel(layerBody, 255);
+        ledAnim.setLevel(layerEyeAudio, 0);
     }
 }
 
-void updateDisplay(const char* status, float volume) {
-    display.clearBuffer();
-    
-    // 标题（大字体）
-    display.setFont(u8g2_font_ncenB14_tr);
-    display.setCursor(30, 20);
-    display.print("MOSS");
-    
-    // 状态
-    display.setFont(u8g2_font_ncenB08_tr);
-    display.setCursor(0, 35);
-    display.print("State: ");
-    display.print(status);
+// 按状态设置图层（只在状态变化时调用）
+void applyStateLEDs(SystemState state) {
+    setAudioReactive(state == STATE_LISTENING || state == STATE_ACTIVE);
     
-    // 音量
-    display.setCursor(0, 50);
-    display.print("Vol: ");
-    display.print((int)volume);
-    
-    // 音量条
-    int barWidth = (int)(volume / 2);
-    barWidth = constrain(barWidth, 0, 128);
-    display.drawBox(0, 54, barWidth, 10);
-    
-    display.sendBuffer();
+    switch (state) {
+        case STATE_IDLE:
+            // 机身蓝色呼吸 + 瞳孔暗红
+            ledAnim.setColor(layerBody, COLOR_IDLE);
+            ledAnim.setTrack(layerBody, &LED_TRACK_BREATHE);
+            ledAnim.setColor(layerEye, COLOR_EYE_DIM);
+            ledAnim.setTrack(layerEye, nullptr);
+            break;
+            
+        case STATE_LISTENING:
+            // 机身绿色随音量起伏 + 瞳孔暗红（辅音时叠加亮红）
+            ledAnim.setColor(layerBody, COLOR_LISTENING);
+            ledAnim.setTrack(layerBody, nullptr);
+            ledAnim.setColor(layerEye, COLOR_EYE_DIM);
+            ledAnim.setTrack(layerEye, nullptr);
+            break;
+            
+        case STATE_ACTIVE:
+            // 机身橙色随音量起伏 + 白色闪一下 + 瞳孔红色呼吸（模拟注意力集中）
+            ledAnim.setColor(layerBody, COLOR_ACTIVE);
+            ledAnim.setTrack(layerBody, nullptr);
+            ledAnim.setTrack(layerFlash, &LED_TRACK_PULSE);
+            ledAnim.restart(layerFlash);
+            ledAnim.setColor(layerEye, COLOR_EYE_FOCUS);
+            ledAnim.setTrack(layerEye, &EYE_BREATH);
+            break;
+            
+        case STATE_SPEAKING:
+            // 机身紫色 + 瞳孔亮红
+            ledAnim.setColor(layerBody, COLOR_SPEAKING);
+            ledAnim.setTrack(layerBody, nullptr);
+            ledAnim.setColor(layerEye, COLOR_EYE_FOCUS);
+            ledAnim.setTrack(layerEye, nullptr);
+            break;
+    }
 }
 
-float getVolume() {
-    esp_err_t ret = i2s_read(I2S_PORT, audioBuffer, sizeof(audioBuffer), &bytesRead, pdMS_TO_TICKS(10));
-    
-    int32_t peak = 0;
-    
-    if (ret == ESP_OK && bytesRead > 0) {
-        size_t samplesRead = bytesRead / sizeof(int32_t);
-        for (size_t i = 0; i < samplesRead; i++) {
-            // I2S 32位数据，取高16位
-            int32_t sample = abs(audioBuffer[i] >> 16);
-            if (sample > peak) {
-                peak = sample;
-            }
-        }
+// 灯效任务（100Hz）：状态变化时切换灯效，推进动画，每帧最多 show() 一次
+void updateLEDs() {
+    static int ledState = -1;
+    if (ledState != ledTargetState) {
+        applyStateLEDs(ledTargetState);
+        ledState = ledTargetState;
     }
     
-    return (float)peak;
+    unsigned long now = millis();
+    ledVis.update(now);
+    ledAnim.update(now);
+    ledFrame.flush(now);
 }
 
-// 立体声声源定位：通过左右声道音量差异判断方向
-float getSoundDirection(float* leftVol, float* rightVol) {
-    esp_err_t ret = i2s_read(I2S_PORT, audioBuffer, sizeof(audioBuffer), &bytesRead, pdMS_TO_TICKS(10));
-    
-    if (ret != ESP_OK || bytesRead == 0) {
-        *leftVol = 0;
-        *rightVol = 0;
-        return 0;
+// 状态处理只把要显示的内容发给显示阶段（内容变化时），由显示任务（10Hz）绘制
+void setStatus(const char* status, float volume) {
+    static const char* lastText = nullptr;
+    static int lastVolume = -1;
+    if (status == lastText && (int)volume == lastVolume) {
+        return;
     }
-    
-    size_t samplesRead = bytesRead / sizeof(int32_t);
-    
-    float leftPeak = 0;
-    float rightPeak = 0;
-    
-    // I2S立体声数据格式：左, 右, 左, 右...
-    for (size_t i = 0; i < samplesRead; i += 2) {
-        // 左声道（偶数索引）
-        int32_t leftSample = abs(audioBuffer[i] >> 16);  // 取高16位
-        if (leftSample > leftPeak) {
-            leftPeak = leftSample;
-        }
-        
-        // 右声道（奇数索引）
-        if (i + 1 < samplesRead) {
-            int32_t rightSample = abs(audioBuffer[i + 1] >> 16);
-            if (rightSample > rightPeak) {
-                rightPeak = rightSample;
-            }
-        }
+    StatusUpdate update = {status, volume};
+    if (statusQueue.push(update)) {
+        lastText = status;
+        lastVolume = (int)volume;
     }
-    
-    *leftVol = leftPeak;
-    *rightVol = rightPeak;
-    
-    // 调试输出
-    static unsigned long lastDebugPrint = 0;
-    if (millis() - lastDebugPrint > 1000) {
-        Serial.printf("[DEBUG] 左麦: %.0f, 右麦: %.0f, 差异: %.1f%%\n", 
-                      leftPeak, rightPeak, 
-                      (leftPeak + rightPeak > 0) ? (rightPeak - leftPeak) / (leftPeak + rightPeak) * 100 : 0);
-        lastDebugPrint = millis();
+}
+
+void updateDisplay() {
+    char stateText[UI_LABEL_MAX];
+    snprintf(stateText, sizeof(stateText), "State: %s", statusText);
+    uiState.setText(stateText);
+    uiVolume.setValue((int)statusVolume);
+    uiVolumeBar.setValue((int)statusVolume);
+    
+    // 只重画变化的控件（标题只在第一次画）；屏幕没有变化时不提交
+    if (statusScreen.render(uiCanvas) > 0) {
+        displayTask.submit(display.getBufferPtr());
     }
-    
-    float totalVolume = leftPeak + rightPeak;
-    if (totalVolume < 100) {
-        return 0;
+}
+
+// 采集阶段（每个采集块）：读取一段新采样滑入分析窗口并分析（帧格式见 AudioSource.h），
+// 舵机运动中先做自噪声门控；新采样的电平发布给灯效（灯效不重读 I2S）
+AudioFrameStats captureFrame() {
+    size_t frames = micSource.readFrame(hopBuffer, CAPTURE_HOP);
+    bytesRead = frames * CAPTURE_CHANNELS * sizeof(int32_t);
+    if (frames == 0) {
+        // 读取超时或出错：窗口没有新采样，不重复分析旧窗口（峰值、VAD 拖尾会被重复计入），
+        // 也不发布电平（否则灯效会闪暗）；返回音量、方向都为0的空帧
+        AudioFrameStats empty = {};
+        return empty;
     }
+    size_t keep = BUFFER_SIZE - frames;
+    memmove(audioBuffer, audioBuffer + frames * CAPTURE_CHANNELS, keep * CAPTURE_CHANNELS * sizeof(int32_t));
+    memcpy(audioBuffer + keep * CAPTURE_CHANNELS, hopBuffer, frames * CAPTURE_CHANNELS * sizeof(int32_t));
+    
+    TRACE_SCOPE("analyze");
+    uint32_t handlerStart = micros();
+    unsigned long now = millis();
+    SelfNoiseResult gate = selfNoise.process(audioBuffer, BUFFER_SIZE, motion.state(now));
+    ledVis.publish(levelMeter.measure(hopBuffer, frames, now, gate.gain));
+    AudioFrameStats stats = analyzer.process(audioBuffer, BUFFER_SIZE, gate.gain);
+    audioFrameHist.record(micros() - handlerStart);
+    return stats;
+}
+
+// 立体声声源定位：通过左右声道音量差异判断方向
+float getSoundDirection(float* leftVol, float* rightVol) {
+    const AudioFrameStats& stats = latestFrame;
     
-    // 计算音量差异比例
-    float volumeDiff = (rightPeak - leftPeak) / totalVolume;
-    
-    // 转换为角度（-90到+90度）
-    float angle = volumeDiff * 90.0;
+    *leftVol = stats.leftPeak;
+    *rightVol = stats.rightPeak;
     
-    return angle;
+    // 转换为角度（-90到+90度），总音量过小时为0
+    return stats.direction;
 }
 
+// 平滑转动到目标角度，每步1°、间隔 delayMs；只发出转动命令，由运动阶段的舵机任务推进
+// （转动中再调用则从当前位置改向新目标）
 void smoothMove(int targetH, int targetV, int delayMs = 10) {
+    MotionCommand cmd = {MOTION_MOVE, (int16_t)targetH, (int16_t)targetV, (uint16_t)delayMs, 0};
+    if (!motionQueue.push(cmd)) {
+        LOG_WARN("运动命令队列已满，丢弃转动命令");
+    }
+}
+
+// 运动阶段：转动开始/结束通知采集阶段的自噪声门控
+void publishMotion(bool moving, float velocityDps) {
+    MotionEvent event = {moving, velocityDps, (uint32_t)millis()};
+    motionEventQueue.push(event);
+}
+
+// 运动阶段：执行转动命令
+void startMove(int targetH, int targetV, int delayMs) {
     int stepsH = abs(targetH - angleH);
     int stepsV = abs(targetV - angleV);
     int maxSteps = max(stepsH, stepsV);
     
-    if (maxSteps == 0) return;
+    if (maxSteps == 0) {
+        // 已在目标位置：停止进行中的转动
+        if (servoMove.active) {
+            servoMove.active = false;
+            publishMotion(false, 0);
+        }
+        motionDoneQueue.push((int16_t)angleH);
+        return;
+    }
     
-    for (int step = 0; step <= maxSteps; step++) {
-        int newH = angleH + (targetH - angleH) * step / maxSteps;
-        int newV = angleV + (targetV - angleV) * step / maxSteps;
-        
-        servoH.write(newH);
-        servoV.write(newV);
-        
-        delay(delayMs);
+    // 每步1°，指令速度 = 1000 / delayMs °/s
+    LOG_DEBUG("[MOVE] (%d, %d) → (%d, %d)，%d 步 × %dms", angleH.load(), angleV.load(),
+              targetH, targetV, maxSteps, delayMs);
+    publishMotion(true, 1000.0f / delayMs);
+    servoMove = {angleH, angleV, targetH, targetV, maxSteps, 0, (unsigned long)delayMs, millis(), true};
+}
+
+// 舵机任务（200Hz）：到了步进间隔就走下一步，到位后通知自噪声门控和决策阶段
+void servoTask(void*, uint32_t nowUs) {
+    // 节拍间隔（不论是否在转动）：调度抖动和同核高优先级任务的占用都会反映在这里
+    static uint32_t lastTickUs = 0;
+    if (lastTickUs != 0) {
+        motionTickHist.record(nowUs - lastTickUs);
     }
+    lastTickUs = nowUs;
+    
+    if (!servoMove.active) return;
     
-    angleH = targetH;
-    angleV = targetV;
+    unsigned long now = millis();
+    bool moved = false;
+    while (servoMove.step < servoMove.steps && now - servoMove.lastStepMs >= servoMove.stepMs) {
+        servoMove.step++;
+        servoMove.lastStepMs += servoMove.stepMs;
+        moved = true;
+    }
+    if (moved) {
+        angleH = servoMove.fromH + (servoMove.toH - servoMove.fromH) * servoMove.step / servoMove.steps;
+        angleV = servoMove.fromV + (servoMove.toV - servoMove.fromV) * servoMove.step / servoMove.steps;
+        servoH.write(angleH);
+        servoV.write(angleV);
+        AnglesTelemetry rec = {(int16_t)angleH, (int16_t)angleV, (int16_t)servoMove.toH, (int16_t)servoMove.toV};
+        motionTelemetry.send(TEL_ANGLES, rec, (uint32_t)now);
+    }
+    if (servoMove.step >= servoMove.steps) {
+        servoMove.active = false;
+        publishMotion(false, 0);
+        motionDoneQueue.push((int16_t)angleH);
+    }
 }
 
 // ========== 状态处理 ==========
+// 表驱动状态机（lib/StateMachine）：状态只在事件到来时转换，不再每轮运行当前状态的处理函数。
+// 一次性的事（转向声源、回中）在进入/退出动作中做；周期性的事（待机微动）
+// 和静音超时由状态的定时器产生事件，离开状态时自动取消；声道电平经遥测发出（见 runDecisionRound）
 
-void handleIdleState() {
-    // 待机状态：机身LED蓝色呼吸 + 瞳孔暗红常亮 + 微动
-    static unsigned long lastBreath = 0;
-    static int brightness = 50;
-    static int direction = 1;
-    
-    if (millis() - lastBreath > 20) {
-        brightness += direction * 5;
-        
-        if (brightness >= 255) {
-            brightness = 255;
-            direction = -1;
-        } else if (brightness <= 50) {
-            brightness = 50;
-            direction = 1;
-        }
-        
-        // 机身LED：蓝色呼吸（按比例缩放RGB）
-        uint32_t bodyColor = leds.Color(0, brightness * 50 / 255, brightness * 100 / 255);
-        
-        // 分别设置机身和瞳孔
-        for (int i = LED_BODY_START; i < LED_BODY_START + LED_BODY_COUNT; i++) {
-            leds.setPixelColor(i, bodyColor);
-        }
-        for (int i = LED_CAMERA_START; i < LED_CAMERA_START + LED_CAMERA_COUNT; i++) {
-            leds.setPixelColor(i, COLOR_EYE_DIM);
-        }
-        
-        leds.show();
-        lastBreath = millis();
+void enterIdle(void*, const SmEvent&);
+void enterListening(void*, const SmEvent&);
+void enterActive(void*, const SmEvent&);
+void exitActive(void*, const SmEvent&);
+void enterSpeaking(void*, const SmEvent&);
+void idleMicroMove(void*, const SmEvent&);
+void logSoundOnset(void*, const SmEvent&);
+void logTrigger(void*, const SmEvent&);
+void refuseTrigger(void*, const SmEvent&);
+void stopSilenceTimer(void*, const SmEvent&);
+void startSilenceTimer(void*, const SmEvent&);
+void logTurnDone(void*, const SmEvent&);
+void logSilence(void*, const SmEvent&);
+void logPlaybackDone(void*, const SmEvent&);
+void centerHead(void*, const SmEvent&);
+bool trySpeak(void*, const SmEvent&);
+
+// 下标与 SystemState 相同
+const SmStateDef STATE_TABLE[] = {
+    {"IDLE", enterIdle, nullptr},
+    {"LISTENING", enterListening, nullptr},
+    {"ACTIVE", enterActive, exitActive},
+    {"SPEAKING", enterSpeaking, nullptr},
+};
+
+// 状态栏文字（下标与 SystemState 相同）
+const char* const STATUS_TEXT[] = {"IDLE", "LISTEN", "ACTIVE!", "SPEAKING"};
+
+// 下标与 SystemEvent 相同
+const char* const EVENT_NAMES[EV_COUNT] = {
+    "sound_onset", "sound_end", "silence_timeout", "motion_done", "idle_tick", "playback_done",
+    "cmd_idle", "cmd_listen", "cmd_trigger", "cmd_speak"
+};
+
+// 按顺序匹配：状态专用的转换在前，任意状态的命令在后
+const SmTransition TRANSITION_TABLE[] = {
+    {STATE_IDLE,      EV_IDLE_TICK,       SM_INTERNAL,     nullptr, idleMicroMove},
+    {STATE_LISTENING, EV_SOUND_ONSET,     STATE_ACTIVE,    nullptr, logSoundOnset},
+    {STATE_LISTENING, EV_CMD_TRIGGER,     STATE_ACTIVE,    nullptr, logTrigger},
+    {STATE_ACTIVE,    EV_SOUND_ONSET,     SM_INTERNAL,     nullptr, stopSilenceTimer},
+    {STATE_ACTIVE,    EV_SOUND_END,       SM_INTERNAL,     nullptr, startSilenceTimer},
+    {STATE_ACTIVE,    EV_SILENCE_TIMEOUT, STATE_LISTENING, nullptr, logSilence},
+    {STATE_ACTIVE,    EV_MOTION_DONE,     SM_INTERNAL,     nullptr, logTurnDone},
+    {STATE_SPEAKING,  EV_PLAYBACK_DONE,   STATE_LISTENING, nullptr, logPlaybackDone},
+    {SM_ANY_STATE,    EV_CMD_SPEAK,       STATE_SPEAKING,  trySpeak, nullptr},
+    {SM_ANY_STATE,    EV_CMD_LISTEN,      STATE_LISTENING, nullptr, nullptr},
+    {SM_ANY_STATE,    EV_CMD_IDLE,        STATE_IDLE,      nullptr, centerHead},
+    {SM_ANY_STATE,    EV_CMD_TRIGGER,     SM_INTERNAL,     nullptr, refuseTrigger},
+};
+
+StateMachine fsm(STATE_TABLE, sizeof(STATE_TABLE) / sizeof(STATE_TABLE[0]),
+                 TRANSITION_TABLE, sizeof(TRANSITION_TABLE) / sizeof(TRANSITION_TABLE[0]));
+
+// 待机：机身LED蓝色呼吸 + 瞳孔暗红常亮（见 applyStateLEDs）+ 定时微动
+void enterIdle(void*, const SmEvent&) {
+    fsm.startTimer(TIMER_STATE, IDLE_MOVE_MS, EV_IDLE_TICK, true);
+}
+
+void idleMicroMove(void*, const SmEvent&) {
+    int randomH = angleH + random(-5, 6);
+    int randomV = angleV + random(-3, 4);
+
+    randomH = constrain(randomH, 80, 100);
+    randomV = constrain(randomV, 85, 95);
+
+    smoothMove(randomH, randomV, 20);
+}
+
+// 监听：机身LED绿色常亮 + 瞳孔暗红（见 applyStateLEDs）
+void enterListening(void*, const SmEvent&) {
+    // 进入时声音已在进行（没有新的越过阈值事件）：按刚检测到声音处理
+    if (latestFrame.triggered) {
+        fsm.post(EV_SOUND_ONSET, (int32_t)latestFrame.direction);
     }
-    
-    // 微动
-    static unsigned long lastMove = 0;
-    if (millis() - lastMove > 3000) {
-        int randomH = angleH + random(-5, 6);
-        int randomV = angleV + random(-3, 4);
-        
-        randomH = constrain(randomH, 80, 100);
-        randomV = constrain(randomV, 85, 95);
-        
-        smoothMove(randomH, randomV, 20);
-        lastMove = millis();
+}
+
+void logSoundOnset(void*, const SmEvent&) {
+    LOG_INFO("[STATE] 检测到声音！峰值: %.0f (阈值: %.0f)", latestFrame.volume, TRIGGER_THRESHOLD);
+}
+
+void logTrigger(void*, const SmEvent& ev) {
+    LOG_INFO("[TEST] 进入活跃状态（模拟），方向 %ld°", (long)ev.arg);
+}
+
+void refuseTrigger(void*, const SmEvent&) {
+    LOG_INFO("[TEST] 请先进入监听模式（按1）");
+}
+
+// 活跃：机身LED橙色常亮 + 瞳孔呼吸（见 applyStateLEDs）；进入时转向声源一次，
+// 声音停止后开始计时，无声 SILENCE_TIMEOUT_MS 回到监听
+void enterActive(void*, const SmEvent& ev) {
+    float leftVol, rightVol;
+    getSoundDirection(&leftVol, &rightVol);
+    LOG_INFO("[LOCATE] 左声道: %.0f, 右声道: %.0f, 计算角度: %ld°", leftVol, rightVol, (long)ev.arg);
+
+    int targetH = 90 + (int)ev.arg;
+    targetH = constrain(targetH, 30, 150);
+    smoothMove(targetH, 90, 5);
+    LOG_INFO("[LOCATE] 舵机转向: H=%d° (中心90°)", targetH);
+
+    // 由命令触发（或声音已经结束）时立即开始计时；声音仍在时等 EV_SOUND_END
+    if (!latestFrame.triggered) {
+        fsm.startTimer(TIMER_STATE, SILENCE_TIMEOUT_MS, EV_SILENCE_TIMEOUT);
     }
-    
-    updateDisplay("IDLE", 0);
 }
 
-void handleListeningState() {
-    // 监听状态：机身LED绿色常亮 + 瞳孔暗红
-    static bool ledSet = false;
-    if (!ledSet) {
-        setBodyAndEyeLEDs(COLOR_LISTENING, COLOR_EYE_DIM);
-        ledSet = true;
+void exitActive(void*, const SmEvent&) {
+    smoothMove(90, 90, 10);
+}
+
+void stopSilenceTimer(void*, const SmEvent&) {
+    fsm.stopTimer(TIMER_STATE);
+}
+
+void startSilenceTimer(void*, const SmEvent&) {
+    fsm.startTimer(TIMER_STATE, SILENCE_TIMEOUT_MS, EV_SILENCE_TIMEOUT);
+}
+
+void logSilence(void*, const SmEvent&) {
+    LOG_INFO("[STATE] 回到监听状态");
+}
+
+void logTurnDone(void*, const SmEvent& ev) {
+    LOG_INFO("[LOCATE] 转向完成: H=%ld°", (long)ev.arg);
+}
+
+// 说话：机身LED紫色 + 瞳孔亮红（见 applyStateLEDs），播放结束回到监听
+// 守卫：喇叭就绪且开始播放才进入说话状态
+bool trySpeak(void*, const SmEvent& ev) {
+    if (!speakerReady) {
+        LOG_WARN("[SPEAK] 喇叭未就绪");
+        return false;
     }
-    
-    float volume = getVolume();
-    currentVolume = volume;
-    
-    // 调试：显示左右声道音量
-    static unsigned long lastDebug = 0;
-    if (millis() - lastDebug > 500) {  // 每500ms输出一次
-        float leftVol, rightVol;
-        getSoundDirection(&leftVol, &rightVol);
-        
-        // 强制输出，即使音量为0
-        Serial.printf("[DEBUG] 音量: %.0f, 左: %.0f, 右: %.0f, 差异: %.1f%%\n", 
-                     volume, leftVol, rightVol, 
-                     (leftVol + rightVol > 0) ? (rightVol - leftVol) / (leftVol + rightVol) * 100 : 0);
-        
-        lastDebug = millis();
+    return speaker.play((int)ev.arg);
+}
+
+void enterSpeaking(void*, const SmEvent& ev) {
+    LOG_INFO("[SPEAK] 播放音效 %ld: %s", (long)ev.arg, soundBank.clipName((int)ev.arg));
+}
+
+void logPlaybackDone(void*, const SmEvent&) {
+    LOG_INFO("[STATE] 播放结束，回到监听（欠载: %lu）", (unsigned long)speaker.underrunCount());
+}
+
+void centerHead(void*, const SmEvent&) {
+    smoothMove(90, 90, 10);
+}
+
+// 决策阶段一轮：把新的音频帧（越过/回到阈值）、转动结束和播放结束转成事件，运行串口命令，
+// 然后处理队列中的事件和到期的定时器；没有事件时不运行任何状态动作。
+// 每个新帧的电平和状态变化作为遥测记录发出（只是复制进队列）。
+// 返回可以等待的微秒数（新帧到达时由帧队列唤醒）
+uint32_t runDecisionRound() {
+    static bool loud = false;
+    static int sentState = -1;
+    static uint8_t reportedState = STATE_IDLE;
+
+    AudioFrameStats frame;
+    bool newFrame = false;
+    while (frameQueue.pop(frame)) {
+        latestFrame = frame;
+        newFrame = true;
+        if (frame.triggered != loud) {
+            loud = frame.triggered;
+            fsm.post(loud ? EV_SOUND_ONSET : EV_SOUND_END, (int32_t)frame.direction);
+        }
     }
-    
-    updateDisplay("LISTEN", volume);
-    
-    // 检测声音（固定阈值90，正常说话即可触发）
-    if (volume > TRIGGER_THRESHOLD) {
-        currentState = STATE_ACTIVE;
-        stateStartTime = millis();
-        lastSoundTime = millis();
-        ledSet = false;  // 重置LED标志
-        
-        Serial.printf("[STATE] 检测到声音！峰值: %.0f (阈值: %.0f)\n", volume, TRIGGER_THRESHOLD);
+    int16_t doneH;
+    while (motionDoneQueue.pop(doneH)) {
+        fsm.post(EV_MOTION_DONE, doneH);
+    }
+    // 按状态判断而不是按播放的下降沿：很短的音效可能在两轮之间就播完
+    if (fsm.state() == STATE_SPEAKING && !speaker.isPlaying()) {
+        fsm.post(EV_PLAYBACK_DONE);
     }
-}
 
-void handleActiveState() {
-    // 活跃状态：机身LED橙色常亮 + 瞳孔呼吸（模拟注意力集中）
-    static bool bodyLedSet = false;
-    if (!bodyLedSet) {
-        setBodyLEDs(COLOR_ACTIVE);
-        bodyLedSet = true;
+    // 串口命令先运行，它发出的命令事件在本轮处理
+    uint32_t idleUs = decisionTasks.runReady();
+    uint32_t now = millis();
+    fsm.process(now);
+
+    // 状态变化时通知运动阶段切换灯效（队列满时下一轮重发）
+    uint8_t state = fsm.state();
+    if (state != reportedState) {
+        LOG_DEBUG("[FSM] %s → %s", fsm.stateName(reportedState), fsm.stateName(state));
+        StateTelemetry rec = {reportedState, state, (int16_t)latestFrame.direction};
+        decisionTelemetry.send(TEL_STATE, rec, now);
+        reportedState = state;
     }
-    eyeBreathEffect();  // 瞳孔呼吸
-    
-    float volume = getVolume();
-    updateDisplay("ACTIVE!", volume);
-    
-    // 【修改】持续检测声源方向，不只是转一次
-    static unsigned long lastDirectionCheck = 0;
-    if (millis() - lastDirectionCheck > 200) {  // 每200ms检测一次
-        float leftVol, rightVol;
-        float direction = getSoundDirection(&leftVol, &rightVol);
-        
-        // 持续输出调试信息
-        Serial.printf("[ACTIVE] 左: %.0f, 右: %.0f, 差异: %.1f%%, 角度: %.1f°\n", 
-                     leftVol, rightVol, 
-                     (leftVol + rightVol > 0) ? (rightVol - leftVol) / (leftVol + rightVol) * 100 : 0,
-                     direction);
-        
-        lastDirectionCheck = millis();
+    if (sentState != state) {
+        MotionCommand cmd = {MOTION_LED_STATE, 0, 0, 0, state};
+        if (motionQueue.push(cmd)) {
+            sentState = state;
+        }
     }
-    
-    // 声源定位并转向（只在刚进入状态时转一次）
-    static bool turned = false;
-    if (!turned) {
-        float leftVol, rightVol;
-        float direction = getSoundDirection(&leftVol, &rightVol);
-        
-        Serial.printf("[LOCATE] 左声道: %.0f, 右声道: %.0f\n", leftVol, rightVol);
-        Serial.printf("[LOCATE] 音量差异: %.1f%%, 计算角度: %.1f°\n", 
-                     (rightVol - leftVol) / (leftVol + rightVol) * 100, direction);
-        
-        int targetH = 90 + (int)direction;
-        targetH = constrain(targetH, 30, 150);
-        int targetV = 90;
-        
-        smoothMove(targetH, targetV, 5);
-        turned = true;
-        
-        Serial.printf("[LOCATE] 舵机转向: H=%d° (中心90°)\n", targetH);
+    if (newFrame) {
+        LevelsTelemetry rec = {latestFrame.leftPeak, latestFrame.rightPeak, latestFrame.volume,
+                               latestFrame.rms, latestFrame.noiseFloor, (int16_t)latestFrame.direction, state,
+                               (uint8_t)((latestFrame.triggered ? 1 : 0) | (latestFrame.voiceActive ? 2 : 0))};
+        decisionTelemetry.send(TEL_LEVELS, rec, now);
+        bool showVolume = state == STATE_LISTENING || state == STATE_ACTIVE;
+        setStatus(STATUS_TEXT[state], showVolume ? latestFrame.volume : 0);
     }
-    
-    // 持续检测声音（固定阈值）
-    if (volume > TRIGGER_THRESHOLD) {
-        lastSoundTime = millis();
+
+    uint32_t timerMs = fsm.msUntilNextTimer(now);
+    if (timerMs < idleUs / 1000) {
+        idleUs = timerMs * 1000;
     }
-    
-    // 3秒无声音，回到监听
-    if (millis() - lastSoundTime > 3000) {
-        currentState = STATE_LISTENING;
-        turned = false;
-        bodyLedSet = false;  // 重置LED标志
-        smoothMove(90, 90, 10);
-        Serial.println("[STATE] 回到监听状态");
+    return idleUs;
+}
+
+// 打印状态机计数和最近的转换（从早到晚）；只在决策阶段中调用
+void printStateTrace() {
+    const SmStats& st = fsm.stats();
+    uint32_t now = millis();
+    Serial.printf("[FSM] 当前 %s（%lums），事件 %lu，转换 %lu，内部 %lu，未处理 %lu，丢弃 %lu，定时器 %lu\n",
+                  fsm.stateName(fsm.state()), (unsigned long)fsm.timeInStateMs(now),
+                  (unsigned long)st.events, (unsigned long)st.transitions, (unsigned long)st.internal,
+                  (unsigned long)st.unhandled, (unsigned long)st.dropped, (unsigned long)st.timerFires);
+    Serial.println("[FSM]   时刻ms  状态        事件(参数)");
+    for (uint8_t i = 0; i < fsm.traceCount(); i++) {
+        const SmTraceEntry* e = fsm.trace(i);
+        if (e->from == e->to) {
+            Serial.printf("[FSM] %8lu  %-9s   %s(%ld)\n", (unsigned long)e->timeMs,
+                          fsm.stateName(e->from), fsm.eventName(e->event), (long)e->arg);
+        } else {
+            Serial.printf("[FSM] %8lu  %-9s → %-9s %s(%ld)\n", (unsigned long)e->timeMs,
+                          fsm.stateName(e->from), fsm.stateName(e->to), fsm.eventName(e->event), (long)e->arg);
+        }
     }
 }
 
@@ -534,8 +982,13 @@ void testLEDMapping() {
     Serial.println("\n[TEST] LED索引映射测试");
     Serial.println("[TEST] 逐个点亮LED，观察实际位置...\n");
     
+    // 暂停运动阶段的灯效任务（等它写完当前一帧），测试期间由本函数直接写 LED
+    ledTestActive = true;
+    delay(LED_PERIOD_US / 1000 + 1);
+    
     // 关闭所有LED
     setAllLEDs(leds.Color(0, 0, 0));
+    showLEDs();
     delay(1000);
     
     // 逐个点亮，用不同颜色标识
@@ -551,17 +1004,19 @@ void testLEDMapping() {
         
         // 关闭所有
         setAllLEDs(leds.Color(0, 0, 0));
+        showLEDs();
         delay(200);
         
         // 只点亮当前索引（白色）
-        leds.setPixelColor(i, leds.Color(255, 255, 255));
-        leds.show();
+        ledFrame.setPixel(i, leds.Color(255, 255, 255));
+        showLEDs();
         
         delay(2000);  // 停留2秒观察
     }
     
     // 关闭所有
     setAllLEDs(leds.Color(0, 0, 0));
+    showLEDs();
     delay(500);
     
     Serial.println("\n[TEST] 请根据实际观察结果调整索引定义");
@@ -574,49 +1029,435 @@ void testLEDMapping() {
     while (Serial.available()) {
         Serial.read();
     }
+    ledTestActive = false;
 }
 
 // ========== 演示模式 ==========
 
+// 在决策阶段内运行一段时间；演示由串口命令启动（在串口任务中嵌套运行），期间停用串口任务
+void runScheduler(unsigned long ms) {
+    unsigned long start = millis();
+    while (millis() - start < ms) {
+        uint32_t idleUs = runDecisionRound();
+        if (idleUs >= 1000) {
+            delay(idleUs / 1000);
+        }
+    }
+}
+
 void demoMode() {
     Serial.println("[DEMO] 开始演示...");
+    decisionTasks.setEnabled(serialTaskId, false);
     
     // 1. 待机状态
     Serial.println("[DEMO] 1. 待机状态（5秒）");
-    currentState = STATE_IDLE;
-    unsigned long start = millis();
-    while (millis() - start < 5000) {
-        handleIdleState();
-        delay(10);
-    }
+    fsm.post(EV_CMD_IDLE);
+    runScheduler(5000);
     
     // 2. 监听状态
     Serial.println("[DEMO] 2. 监听状态（3秒）");
-    currentState = STATE_LISTENING;
-    start = millis();
-    while (millis() - start < 3000) {
-        handleListeningState();
-        delay(10);
-    }
+    fsm.post(EV_CMD_LISTEN);
+    runScheduler(3000);
     
-    // 3. 活跃状态（模拟）
+    // 3. 活跃状态（模拟正前方声源，无声 3 秒后回到监听）
     Serial.println("[DEMO] 3. 活跃状态（转向）");
-    currentState = STATE_ACTIVE;
-    lastSoundTime = millis();
-    start = millis();
-    while (millis() - start < 5000) {
-        handleActiveState();
-        delay(10);
-    }
+    fsm.post(EV_CMD_TRIGGER, 0);
+    runScheduler(5000);
     
-    // 4. 回到待机
+    // 4. 回到待机（回中由转换动作完成）
     Serial.println("[DEMO] 4. 回到待机");
-    currentState = STATE_IDLE;
-    smoothMove(90, 90, 10);
+    fsm.post(EV_CMD_IDLE);
     
+    decisionTasks.setEnabled(serialTaskId, true);
     Serial.println("[DEMO] ✓ 演示完成");
 }
 
+// 打印一个阶段内各任务的运行次数、超时、跳过和最大延迟（累计值：统计由所在阶段写入，这里只读）
+void printSchedulerStats(TaskScheduler& sched) {
+    for (int8_t id = 0; id < SCHED_MAX_TASKS; id++) {
+        const SchedTaskStats* st = sched.stats(id);
+        if (st == nullptr) continue;
+        Serial.printf("[SCHED] %-9s %7lu %6lu %5lu %11lu %11lu %11lu\n", sched.taskName(id),
+                      (unsigned long)st->runs, (unsigned long)st->overruns, (unsigned long)st->skipped,
+                      (unsigned long)st->maxLatencyUs, (unsigned long)st->maxRunUs,
+                      (unsigned long)(st->runs ? st->totalRunUs / st->runs : 0));
+    }
+}
+
+// 打印各阶段的核、占用和最长一轮，各队列的深度和丢弃（自上次打印以来），以及阶段内任务统计
+void printPipelineStats() {
+    static uint32_t windowStartUs = 0;
+    uint32_t now = micros();
+    uint32_t elapsedUs = now - windowStartUs;
+    
+    Serial.println("[PIPE] 阶段      核 优先级     轮数     唤醒  占用%  最长一轮us");
+    for (int8_t id = 0; id < (int8_t)pipeline.stageCount(); id++) {
+        PipelineStageStats st = pipeline.stageStats(id);
+        Serial.printf("[PIPE] %-9s %2d %6u %8lu %8lu %6.1f %11lu\n", pipeline.stageName(id), st.runningCore,
+                      pipeline.stagePriority(id), (unsigned long)st.rounds, (unsigned long)st.wakeups,
+                      elapsedUs ? st.busyUs * 100.0f / elapsedUs : 0.0f, (unsigned long)st.maxRoundUs);
+    }
+    
+    Serial.println("[PIPE] 队列          写入     取出   丢弃  深度  最大深度/容量");
+    for (uint8_t i = 0; i < pipeline.queueCount(); i++) {
+        const PipelineQueueBase* q = pipeline.queue(i);
+        PipelineQueueStats s = q->stats();
+        Serial.printf("[PIPE] %-10s %8lu %8lu %6lu %5lu %8lu/%lu\n", q->name(),
+                      (unsigned long)s.pushed, (unsigned long)s.popped, (unsigned long)s.dropped,
+                      (unsigned long)s.depth, (unsigned long)s.maxDepth, (unsigned long)s.capacity);
+        queueDropsSeen[i] = 0;
+    }
+    
+    Serial.println("[SCHED] 任务       次数    超时  跳过  最大延迟us  最长运行us  平均运行us");
+    printSchedulerStats(decisionTasks);
+    printSchedulerStats(motionTasks);
+    printSchedulerStats(uiTasks);
+    
+    pipeline.resetStats();
+    windowStartUs = now;
+}
+
+// 打印节拍/耗时直方图（从启动开始累计），以及可供多台设备汇总的 HIST 行
+void printHistograms() {
+    static LatencyHistogram* const hists[] = {&motionTickHist, &audioFrameHist, &displayFlushHist};
+    static char line[2048];
+    
+    Serial.println("[HIST] 名称            次数      p50us    p99us    最大us  截止us  超时");
+    for (LatencyHistogram* h : hists) {
+        Serial.printf("[HIST] %-13s %8lu %8lu %8lu %9lu %7lu %5lu\n", h->name(), (unsigned long)h->count(),
+                      (unsigned long)h->percentile(50), (unsigned long)h->percentile(99),
+                      (unsigned long)h->maxUs(), (unsigned long)h->deadlineUs(), (unsigned long)h->missed());
+    }
+    for (LatencyHistogram* h : hists) {
+        if (h->serialize(line, sizeof(line)) > 0) {
+            Serial.println(line);
+        } else {
+            Serial.printf("[WARN] %s 的非空桶过多，HIST 行超过 %u 字节\n", h->name(), (unsigned)sizeof(line));
+        }
+    }
+}
+
+// ========== 任务 ==========
+
+void ledTask(void*, uint32_t) {
+    if (ledTestActive) {
+        return;
+    }
+    updateLEDs();
+}
+
+// 显示任务（10Hz）：只重画变化的控件（标题只在第一次画）；屏幕没有变化时不提交
+void displayUpdateTask(void*, uint32_t) {
+    updateDisplay();
+}
+
+// 遥测任务（1Hz）：任何队列出现新的丢弃时报警；'p' 命令请求时打印完整统计；
+// 发出一条节拍/耗时记录（二进制遥测）
+void telemetryTask(void*, uint32_t) {
+    TimingTelemetry timing = {motionTickHist.percentile(99), audioFrameHist.percentile(99),
+                              displayFlushHist.percentile(99), motionTickHist.missed(),
+                              audioFrameHist.missed(), displayFlushHist.missed()};
+    uiTelemetry.send(TEL_TIMING, timing, millis());
+    
+    for (uint8_t i = 0; i < pipeline.queueCount(); i++) {
+        const PipelineQueueBase* q = pipeline.queue(i);
+        PipelineQueueStats s = q->stats();
+        if (s.dropped > queueDropsSeen[i]) {
+            LOG_WARN("队列 %s 丢弃 %lu 个（深度 %lu/%lu）", q->name(),
+                     (unsigned long)(s.dropped - queueDropsSeen[i]),
+                     (unsigned long)s.depth, (unsigned long)s.capacity);
+            queueDropsSeen[i] = s.dropped;
+        }
+    }
+    
+    if (telemetryRequested.exchange(false)) {
+        printPipelineStats();
+    }
+    if (histogramsRequested.exchange(false)) {
+        printHistograms();
+    }
+}
+
+// 追踪导出任务（10Hz）：'x' 开启后把新的追踪记录打成二进制块经串口发出，
+// 与文本输出交错，由 tools/trace_to_chrome.py 从抓包中找出
+void traceTask(void*, uint32_t) {
+    if (!traceStreaming) {
+        return;
+    }
+    static uint8_t block[TRACE_EXPORT_BYTES];
+    size_t n;
+    while ((n = traceRing.exportBinary(block, sizeof(block), micros())) > 0) {
+        halSerial.write(block, n);
+    }
+}
+
+// 遥测发送任务（20Hz）：'b' 开启后把各阶段的记录编码成帧经串口发出，与文本输出交错
+// （每批帧前有一个 0x00 分隔）；未开启时丢掉记录，队列不会一直满着
+void telemetrySenderTask(void*, uint32_t) {
+    if (!telemetryStreaming) {
+        telemetry.discard();
+        return;
+    }
+    static uint8_t frames[TELEM_TX_BYTES];
+    size_t n;
+    while ((n = telemetry.pump(frames, sizeof(frames))) > 0) {
+        halSerial.write(frames, n);
+    }
+}
+
+// 日志任务（20Hz）：把各阶段 LOG_* 写下的记录在这里格式化（不占运动/决策阶段的时间）。
+// 'b' 开启时改为导出日志帧（与遥测帧交错，由 tools/telemetry_decode.py 格式化），
+// 否则每次最多打印 LOG_LINES_PER_RUN 行文本，来不及打印的记录在环中被覆盖并计入丢失
+void logTask(void*, uint32_t) {
+    if (telemetryStreaming) {
+        static uint8_t frames[TELEM_TX_BYTES];
+        size_t n;
+        while ((n = logRing.exportFrames(frames, sizeof(frames))) > 0) {
+            halSerial.write(frames, n);
+        }
+        return;
+    }
+    char line[160];
+    for (int i = 0; i < LOG_LINES_PER_RUN && logRing.formatNext(line, sizeof(line)) > 0; i++) {
+        Serial.println(line);
+    }
+}
+
+// 登记遥测记录类型和来源（发送任务启动前）
+void setupTelemetry() {
+    bool ok = telemetry.define<LevelsTelemetry>(TEL_LEVELS, "levels",
+                  "left:f,right:f,volume:f,rms:f,noise:f,direction:h,state:B,flags:B");
+    ok = telemetry.define<AnglesTelemetry>(TEL_ANGLES, "angles", "h:h,v:h,target_h:h,target_v:h") && ok;
+    ok = telemetry.define<StateTelemetry>(TEL_STATE, "state", "from:B,to:B,direction:h") && ok;
+    ok = telemetry.define<TimingTelemetry>(TEL_TIMING, "timing",
+                  "motion_p99:I,audio_p99:I,flush_p99:I,motion_miss:I,audio_miss:I,flush_miss:I") && ok;
+    if (!ok) {
+        Serial.println("[ERROR] 遥测记录的字段描述与结构体大小不一致");
+    }
+    telemetry.addSource(decisionTelemetry);
+    telemetry.addSource(motionTelemetry);
+    telemetry.addSource(uiTelemetry);
+}
+
+// 串口命令
+void handleCommand(char cmd) {
+    switch (cmd) {
+        case '1':
+            Serial.println("\n[CMD] 进入监听模式");
+            fsm.post(EV_CMD_LISTEN);
+            break;
+            
+        case '0':
+            Serial.println("\n[CMD] 回到待机模式");
+            fsm.post(EV_CMD_IDLE);
+            break;
+            
+        case 'h':
+        case 'H':
+            Serial.println("\n[CMD] 回到中心位置");
+            smoothMove(90, 90, 10);
+            break;
+            
+        case 'd':
+        case 'D':
+            Serial.println("\n[CMD] 演示模式");
+            demoMode();
+            break;
+            
+        case 't':
+        case 'T':
+            Serial.println("\n[CMD] LED索引映射测试");
+            testLEDMapping();
+            break;
+            
+        case 'a':
+        case 'A':
+            Serial.println("\n[CMD] 模拟声音触发");
+            fsm.post(EV_CMD_TRIGGER, (int32_t)latestFrame.direction);
+            break;
+            
+        case 'l':
+        case 'L':
+            Serial.println("\n[CMD] 模拟左侧声源");
+            fsm.post(EV_CMD_TRIGGER, -30);  // 转向左侧60度
+            break;
+            
+        case 'r':
+        case 'R':
+            Serial.println("\n[CMD] 模拟右侧声源");
+            fsm.post(EV_CMD_TRIGGER, 30);   // 转向右侧120度
+            break;
+            
+        case 's':
+        case 'S': {
+            Serial.println("\n[CMD] 播放音效");
+            static int nextClip = 0;
+            if (soundBank.clipCount() > 0) {
+                fsm.post(EV_CMD_SPEAK, nextClip);
+                nextClip = (nextClip + 1) % soundBank.clipCount();
+            }
+            break;
+        }
+            
+        case 'p':
+        case 'P':
+            Serial.println("\n[CMD] 流水线统计（由遥测任务打印）");
+            telemetryRequested = true;
+            break;
+            
+        case 'm':
+        case 'M':
+            Serial.println("\n[CMD] 状态机轨迹");
+            printStateTrace();
+            break;
+            
+        case 'j':
+        case 'J':
+            Serial.println("\n[CMD] 节拍/耗时直方图（由遥测任务打印）");
+            histogramsRequested = true;
+            break;
+            
+        case 'x':
+        case 'X':
+#if TRACE_ENABLED
+            if (traceStreaming) {
+                traceStreaming = false;
+                TraceStats st = traceRing.stats();
+                Serial.printf("\n[CMD] 停止追踪：写入 %lu 条，导出 %lu 条，丢失 %lu 条\n",
+                              (unsigned long)st.written, (unsigned long)st.exported, (unsigned long)st.lost);
+            } else {
+                Serial.println("\n[CMD] 开始追踪（二进制块，用 tools/trace_to_chrome.py 转换）");
+                traceRing.clear();
+                traceStreaming = true;
+            }
+#else
+            Serial.println("\n[WARN] 追踪未编译进来（build_flags 加 -DTRACE_ENABLED=1）");
+#endif
+            break;
+            
+        case 'b':
+        case 'B':
+            if (telemetryStreaming) {
+                telemetryStreaming = false;
+                TelemetryStats st = telemetry.stats();
+                Serial.printf("\n[CMD] 停止遥测：发送 %lu 帧 %lu 字节，队列满丢弃 %lu 条\n",
+                              (unsigned long)st.frames, (unsigned long)st.bytes, (unsigned long)st.dropped);
+            } else {
+                Serial.println("\n[CMD] 开始遥测（二进制帧，用 tools/telemetry_decode.py 转换）");
+                telemetry.resendSchema();
+                logRing.resendFormats();
+                telemetryStreaming = true;
+            }
+            break;
+    }
+}
+
+// 串口任务（50Hz）：每次处理一个命令
+void serialTask(void*, uint32_t) {
+    if (halSerial.available() > 0) {
+        handleCommand(halSerial.read());
+    }
+}
+
+// ========== 流水线阶段 ==========
+
+// 采集+DSP（核0）：I2S 读取按采集块阻塞，读完立即分析，结果发给决策阶段
+uint32_t captureStage(void*) {
+    TRACE_THREAD("capture");
+    TRACE_SCOPE("capture");
+    MotionEvent event;
+    while (motionEventQueue.pop(event)) {
+        if (event.moving) {
+            motion.beginMove(event.velocityDps);
+        } else {
+            motion.endMove(event.timeMs);
+        }
+    }
+    
+    // 满时丢弃（计数），决策阶段只用最新一帧
+    frameQueue.push(captureFrame());
+    return 0;
+}
+
+// 决策（核1）：把新帧和转动/播放结束转成事件，运行串口命令和状态机
+uint32_t decisionStage(void*) {
+    TRACE_THREAD("decide");
+    TRACE_SCOPE("decide");
+    return runDecisionRound();
+}
+
+// 运动+灯效（核1，最高优先级）：执行转动/灯效命令，推进舵机和灯效动画
+uint32_t motionStage(void*) {
+    TRACE_THREAD("motion");
+    TRACE_SCOPE("motion");
+    MotionCommand cmd;
+    while (motionQueue.pop(cmd)) {
+        if (cmd.type == MOTION_MOVE) {
+            startMove(cmd.targetH, cmd.targetV, cmd.stepMs);
+        } else {
+            ledTargetState = (SystemState)cmd.state;
+        }
+    }
+    return motionTasks.runReady();
+}
+
+// 显示+遥测（核0，最低优先级）：取最新状态栏内容，重画界面、检查队列
+uint32_t uiStage(void*) {
+    TRACE_THREAD("ui");
+    TRACE_SCOPE("ui");
+    StatusUpdate update;
+    if (statusQueue.drain(update) > 0) {
+        statusText = update.text;
+        statusVolume = update.volume;
+    }
+    return uiTasks.runReady();
+}
+
+void setupPipeline() {
+    Serial.println("[INIT] 启动流水线...");
+    
+    // 阶段内任务的优先级只在同一阶段内比较
+    serialTaskId = decisionTasks.addPeriodic("serial", serialTask, nullptr, SERIAL_PERIOD_US, 0);
+    motionTasks.addPeriodic("servo", servoTask, nullptr, SERVO_PERIOD_US, 1);
+    motionTasks.addPeriodic("led", ledTask, nullptr, LED_PERIOD_US, 0);
+    uiTasks.addPeriodic("display", displayUpdateTask, nullptr, DISPLAY_PERIOD_US, 1);
+    uiTasks.addPeriodic("telemetry", telemetryTask, nullptr, TELEMETRY_PERIOD_US, 0);
+    uiTasks.addPeriodic("trace", traceTask, nullptr, TRACE_PERIOD_US, 0);
+    uiTasks.addPeriodic("telem_tx", telemetrySenderTask, nullptr, TELEM_TX_PERIOD_US, 0);
+    uiTasks.addPeriodic("log", logTask, nullptr, LOG_PERIOD_US, 0);
+    setupTelemetry();
+    
+    // 核0：采集（大部分时间阻塞在 I2S 读取）和显示；核1：运动（最高优先级）和决策
+    int8_t capture = pipeline.addStage("capture", captureStage, nullptr, 0, 4, 8192);
+    int8_t decide = pipeline.addStage("decide", decisionStage, nullptr, 1, 2, 8192);
+    int8_t output = pipeline.addStage("motion", motionStage, nullptr, 1, 3, 4096);
+    int8_t ui = pipeline.addStage("ui", uiStage, nullptr, 0, 1, 4096);
+    pipeline.connect(frameQueue, "frames", capture, decide);
+    pipeline.connect(motionQueue, "motion", decide, output);
+    pipeline.connect(statusQueue, "status", decide, ui);
+    pipeline.connect(motionEventQueue, "events", output, capture);
+    pipeline.connect(motionDoneQueue, "done", output, decide);
+    
+    const char* error = pipeline.validate();
+    if (error != nullptr) {
+        Serial.printf("[ERROR] 流水线拓扑无效：%s\n", error);
+        return;
+    }
+    
+    // 状态机只在决策阶段中使用；在阶段任务启动前进入初始状态
+    fsm.setEventNames(EVENT_NAMES, EV_COUNT);
+    fsm.begin(STATE_IDLE, millis());
+    
+    if (!pipeline.start()) {
+        Serial.println("[ERROR] 流水线任务启动失败");
+        return;
+    }
+    
+    Serial.printf("[INIT] ✓ %d 个阶段：采集 %luHz（核0）、决策（事件驱动）+ 串口 50Hz（核1）、"
+                  "舵机 200Hz + 灯效 100Hz（核1）、显示 10Hz + 遥测 1Hz（核0）\n",
+                  pipeline.stageCount(), 1000000UL / AUDIO_PERIOD_US);
+}
+
 // ========== 主程序 ==========
 
 void setup() {
@@ -647,6 +1488,12 @@ void setup() {
     setupMicrophone();
     delay(500);
     
+    calibrateSelfNoise();
+    delay(500);
+    
+    setupSpeaker();
+    delay(500);
+    
     Serial.println();
     Serial.println("=================================");
     Serial.println("   初始化完成！");
@@ -656,6 +1503,7 @@ void setup() {
     Serial.println("  - 待机：机身蓝色呼吸 + 瞳孔暗红 + 微动");
     Serial.println("  - 监听：机身绿色 + 瞳孔暗红");
     Serial.println("  - 活跃：机身橙色 + 瞳孔呼吸 + 声源定位转向");
+    Serial.println("  - 说话：机身紫色 + 瞳孔亮红 + 喇叭播放");
     Serial.println("  - 触发阈值：90（峰值检测）");
     Serial.println("  - 声源定位：I2S立体声麦克风");
     Serial.println("  - LED分组：索引0-1=瞳孔, 索引2-4=机身");
@@ -669,6 +1517,12 @@ void setup() {
     Serial.println("  a - 模拟声音触发（测试活跃状态）");
     Serial.println("  l - 模拟左侧声源（转向-30度）");
     Serial.println("  r - 模拟右侧声源（转向+30度）");
+    Serial.println("  s - 播放音效（进入说话状态）");
+    Serial.println("  p - 流水线统计（阶段占用、队列深度/丢弃、任务延迟）");
+    Serial.println("  m - 状态机轨迹（最近的转换和事件计数）");
+    Serial.println("  j - 节拍/耗时直方图（p50/p99/最大值/超时次数）");
+    Serial.println("  x - 开始/停止追踪导出（需 -DTRACE_ENABLED=1）");
+    Serial.println("  b - 开始/停止二进制遥测（电平、角度、状态、耗时、日志）");
     Serial.println();
     
     // 启动动画：分别测试瞳孔和机身LED
@@ -677,122 +1531,32 @@ void setup() {
     // 测试瞳孔LED（红色）
     Serial.println("[TEST] 瞳孔LED（索引0-1）- 红色");
     setEyeLEDs(leds.Color(255, 0, 0));
+    showLEDs();
     delay(500);
     
     // 测试机身LED（绿色）
     Serial.println("[TEST] 机身LED（索引2-4）- 绿色");
     setBodyLEDs(leds.Color(0, 255, 0));
+    showLEDs();
     delay(500);
     
     // 测试全部LED（蓝色）
     Serial.println("[TEST] 全部LED - 蓝色");
     setAllLEDs(leds.Color(0, 0, 255));
+    showLEDs();
     delay(500);
     
     // 关闭所有LED
     setAllLEDs(leds.Color(0, 0, 0));
+    showLEDs();
     delay(200);
     
     Serial.println("[TEST] ✓ LED测试完成\n");
     
-    currentState = STATE_IDLE;
-    stateStartTime = millis();
+    setupPipeline();
 }
 
 void loop() {
-    // 状态机
-    switch (currentState) {
-        case STATE_IDLE:
-            handleIdleState();
-            break;
-            
-        case STATE_LISTENING:
-            handleListeningState();
-            break;
-            
-        case STATE_ACTIVE:
-            handleActiveState();
-            break;
-    }
-    
-    // 串口命令
-    if (Serial.available() > 0) {
-        char cmd = Serial.read();
-        
-        switch (cmd) {
-            case '1':
-                Serial.println("\n[CMD] 进入监听模式");
-                currentState = STATE_LISTENING;
-                stateStartTime = millis();
-                break;
-                
-            case '0':
-                Serial.println("\n[CMD] 回到待机模式");
-                currentState = STATE_IDLE;
-                smoothMove(90, 90, 10);
-                stateStartTime = millis();
-                break;
-                
-            case 'h':
-            case 'H':
-                Serial.println("\n[CMD] 回到中心位置");
-                smoothMove(90, 90, 10);
-                break;
-                
-            case 'd':
-            case 'D':
-                Serial.println("\n[CMD] 演示模式");
-                demoMode();
-                break;
-                
-            case 't':
-            case 'T':
-                Serial.println("\n[CMD] LED索引映射测试");
-                testLEDMapping();
-                break;
-                
-            case 'a':
-            case 'A':
-                Serial.println("\n[CMD] 模拟声音触发");
-                if (currentState == STATE_LISTENING) {
-                    currentState = STATE_ACTIVE;
-                    stateStartTime = millis();
-                    lastSoundTime = millis();
-                    Serial.println("[TEST] 进入活跃状态（模拟）");
-                } else {
-                    Serial.println("[TEST] 请先进入监听模式（按1）");
-                }
-                break;
-                
-            case 'l':
-            case 'L':
-                Serial.println("\n[CMD] 模拟左侧声源");
-                if (currentState == STATE_LISTENING) {
-                    currentState = STATE_ACTIVE;
-                    stateStartTime = millis();
-                    lastSoundTime = millis();
-                    smoothMove(60, 90, 5);  // 转向左侧（-30度）
-                    Serial.println("[TEST] 转向左侧60度");
-                } else {
-                    Serial.println("[TEST] 请先进入监听模式（按1）");
-                }
-                break;
-                
-            case 'r':
-            case 'R':
-                Serial.println("\n[CMD] 模拟右侧声源");
-                if (currentState == STATE_LISTENING) {
-                    currentState = STATE_ACTIVE;
-                    stateStartTime = millis();
-                    lastSoundTime = millis();
-                    smoothMove(120, 90, 5);  // 转向右侧（+30度）
-                    Serial.println("[TEST] 转向右侧120度");
-                } else {
-                    Serial.println("[TEST] 请先进入监听模式（按1）");
-                }
-                break;
-        }
-    }
-    
-    delay(10);
+    // 所有工作都在流水线阶段中，Arduino loop 任务不再需要
+    vTaskDelete(NULL);
 }
@@ -1,6 +1,19 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <U8g2lib.h>
+#include "GlyphCache.h"
+#include "TileFlusher.h"
+#include "UiWidgets.h"
+#include "ScrollTicker.h"
+#include "SpriteAnim.h"
+#include "FaceSpritesData.h"
+#include "OledScreens.h"
+
+// 构建时用 tools/make_glyph_labels.py 生成了预渲染标签时直接使用
+#if __has_include("GlyphLabelsData.h")
+#include "GlyphLabelsData.h"
+#define HAVE_GLYPH_LABELS 1
+#endif
 
 // 硬件连接：SDA接GPIO2，SCL接GPIO1
 #define I2C_SDA 2
@@ -8,91 +21,76 @@
 
 U8G2_SSD1306_128X64_NONAME_F_HW_I2C display(U8G2_R0, U8X8_PIN_NONE, I2C_SCL, I2C_SDA);
 
+// 界面字体（界面绘制见 OledScreens.h，主机端用同一份代码生成快照）
+const OledFonts oledFonts = {u8g2_font_wqy14_t_gb2312, u8g2_font_logisoso16_tr};
+
+// 中文字形缓存：常用字解码一次后直接从缓存绘制，不再每帧在大字库中查找解码
+GlyphCache cjk(u8g2_font_wqy14_t_gb2312);
+
+// 滚动字幕：SSD1306 硬件单列滚动，每像素只发新露出的一列
+U8x8CommandTransport oledBus(display);
+ScrollTicker ticker(oledBus);
+uint16_t tickerColumns[512];
+
+// 表情动画：tools/make_sprite_anim.py 从 assets/sprites 的 PNG 序列生成，常量数组直接从闪存解码
+SpriteBank faces;
+SpritePlayer face;
+
+// 绘制中文（y 为基线），先查预渲染标签，没有再用字形缓存；返回步进宽度
+int drawText(int x, int y, const char* str) {
+    uint8_t* buffer = display.getBufferPtr();
+#ifdef HAVE_GLYPH_LABELS
+    const GlyphLabel* label = glyphLabelFind(GLYPH_LABELS, GLYPH_LABEL_COUNT, str);
+    if (label != nullptr) {
+        return glyphLabelDraw(buffer, x, y, *label);
+    }
+#endif
+    return cjk.drawUTF8(buffer, x, y, str);
+}
+
+// 只发送矩形覆盖的 8×8 块
+void sendBox(const UiRect& r) {
+    int x0 = max(0, (int)r.x), y0 = max(0, (int)r.y);
+    int x1 = min(DISPLAY_WIDTH - 1, r.x + r.w - 1), y1 = min(DISPLAY_HEIGHT - 1, r.y + r.h - 1);
+    if (x1 < x0 || y1 < y0) {
+        return;
+    }
+    display.updateDisplayArea(x0 / 8, y0 / 8, x1 / 8 - x0 / 8 + 1, y1 / 8 - y0 / 8 + 1);
+}
+
 // ========== 测试函数 ==========
 
 void test1_BasicChinese() {
     display.clearBuffer();
-    display.setFont(u8g2_font_wqy14_t_gb2312);
-    
-    display.drawUTF8(10, 14, "你好世界");
-    display.drawUTF8(10, 30, "MOSS终端");
-    display.drawUTF8(10, 46, "中文测试");
-    display.drawUTF8(10, 62, "显示正常");
-    
+    oledDrawBasicChinese(display, oledFonts, drawText);
     display.sendBuffer();
 }
 
 void test2_SystemStatus() {
     display.clearBuffer();
-    display.setFont(u8g2_font_wqy14_t_gb2312);
-    
-    // 标题
-    display.drawUTF8(30, 13, "系统状态");
-    
-    // 分隔线
-    display.drawLine(0, 15, 128, 15);
-    
-    // 状态信息（恢复完整文字）
-    display.drawUTF8(5, 31, "运行:00:05:23");
-    display.drawUTF8(5, 47, "内存:45%");
-    display.drawUTF8(5, 61, "温度:42°C");
-    
+    oledDrawSystemStatus(display, oledFonts, drawText);
     display.sendBuffer();
 }
 
 void test3_Menu() {
     display.clearBuffer();
-    display.setFont(u8g2_font_wqy14_t_gb2312);
-    
-    // 标题
-    display.drawUTF8(35, 13, "主菜单");
-    display.drawLine(0, 15, 128, 15);
-    
-    // 菜单项（恢复完整文字）
-    display.drawUTF8(5, 31, ">1.开始对话");
-    display.drawUTF8(5, 47, " 2.系统设置");
-    display.drawUTF8(5, 61, " 3.关于MOSS");
-    
+    oledDrawMenu(display, oledFonts, drawText);
     display.sendBuffer();
 }
 
 void test4_MixedText() {
     display.clearBuffer();
-    display.setFont(u8g2_font_wqy14_t_gb2312);
-    
-    display.drawUTF8(5, 13, "状态:待机中");
-    display.drawUTF8(5, 29, "音量:75%");
-    display.drawUTF8(5, 45, "温度:28°C");
-    display.drawUTF8(5, 61, "WiFi:已连接");
-    
+    oledDrawMixedText(display, oledFonts, drawText);
     display.sendBuffer();
 }
 
 void test5_ProgressBar() {
     display.clearBuffer();
-    display.setFont(u8g2_font_wqy14_t_gb2312);
-    
-    display.drawUTF8(35, 13, "加载中");
+    oledDrawLoadingTitle(display, oledFonts, drawText);
     
     // 进度条动画
     for (int progress = 0; progress <= 100; progress += 5) {
-        // 清除进度条区域
-        display.setDrawColor(0);
-        display.drawBox(0, 20, 128, 44);
-        display.setDrawColor(1);
-        
-        // 绘制进度条边框
-        display.drawFrame(10, 25, 108, 15);
-        
-        // 绘制进度
-        int barWidth = (progress * 104) / 100;
-        display.drawBox(12, 27, barWidth, 11);
-        
-        // 显示百分比
-        char buf[10];
-        sprintf(buf, "%d%%", progress);
-        display.drawStr(55, 55, buf);
-        
+        oledDrawProgress(display, oledFonts, progress);
         display.sendBuffer();
         delay(50);
     }
@@ -100,38 +98,18 @@ void test5_ProgressBar() {
     delay(500);
     
     display.clearBuffer();
-    display.setFont(u8g2_font_wqy14_t_gb2312);
-    display.drawUTF8(30, 35, "加载完成");
+    oledDrawLoaded(display, oledFonts, drawText);
     display.sendBuffer();
     delay(1000);
 }
 
 void test6_VolumeBar() {
     display.clearBuffer();
-    display.setFont(u8g2_font_wqy14_t_gb2312);
-    
-    display.drawUTF8(48, 13, "音量");
+    oledDrawVolumeTitle(display, oledFonts, drawText);
     
     // 音量条动画
     for (int vol = 0; vol <= 100; vol += 5) {
-        // 清除音量条区域
-        display.setDrawColor(0);
-        display.drawBox(0, 15, 128, 49);
-        display.setDrawColor(1);
-        
-        // 绘制音量条（竖条）
-        int barHeight = (vol * 40) / 100;
-        for (int i = 0; i < 10; i++) {
-            int x = 10 + i * 11;
-            int h = (barHeight * (i + 1)) / 10;
-            display.drawBox(x, 54 - h, 8, h);
-        }
-        
-        // 显示数值
-        char buf[10];
-        sprintf(buf, "%d%%", vol);
-        display.drawStr(55, 61, buf);
-        
+        oledDrawVolume(display, oledFonts, vol);
         display.sendBuffer();
         delay(30);
     }
@@ -140,58 +118,76 @@ void test6_VolumeBar() {
 }
 
 void test7_Animation() {
-    // 简单的表情动画
-    for (int i = 0; i < 3; i++) {
-        // 睁眼
-        display.clearBuffer();
-        display.drawCircle(40, 32, 10);  // 左眼
-        display.drawCircle(88, 32, 10);  // 右眼
-        display.drawDisc(40, 32, 4);     // 左瞳孔
-        display.drawDisc(88, 32, 4);     // 右瞳孔
-        display.drawLine(30, 50, 98, 50); // 嘴巴
-        display.sendBuffer();
-        delay(500);
-        
-        // 闭眼
-        display.clearBuffer();
-        display.drawLine(30, 32, 50, 32); // 左眼
-        display.drawLine(78, 32, 98, 32); // 右眼
-        display.drawLine(30, 50, 98, 50); // 嘴巴
-        display.sendBuffer();
-        delay(200);
+    // 表情动画：眨眼、左右看、眨眼、笑，每帧只解码进缓冲并发送脸部所在的块
+    if (!faces.attach(FACE_SPRITES, sizeof(FACE_SPRITES))) {
+        Serial.println("[ERROR] 表情动画库无效");
+        return;
     }
+    const char* sequence[] = {"blink", "look", "blink", "happy"};
+    
+    display.clearBuffer();
+    display.sendBuffer();
+    face.resetStats();
+    uint32_t decodeUs = 0;
+    
+    for (const char* name : sequence) {
+        SpriteClip clip;
+        if (!faces.getAnim(faces.findAnim(name), clip)) {
+            continue;
+        }
+        face.play(clip, 24, 2, false);   // 脸在 (24, 16)，80×40
+        while (face.playing()) {
+            uint32_t t0 = micros();
+            if (face.update(millis(), display.getBufferPtr()) > 0) {
+                decodeUs += micros() - t0;
+                sendBox(UiRect{face.x(), face.y(), face.width(), face.height()});
+            }
+            delay(1);
+        }
+    }
+    delay(500);
+    
+    const SpritePlayerStats& st = face.stats();
+    Serial.printf("[INFO] 表情动画 %lu 帧，解码平均 %.1f us/帧，读闪存 %lu 字节（动画库共 %u 字节）\n",
+                  (unsigned long)st.frames, st.frames ? (float)decodeUs / st.frames : 0.0f,
+                  (unsigned long)st.bytesRead, (unsigned)sizeof(FACE_SPRITES));
 }
 
 void test8_ScrollText() {
     const char* text = "欢迎使用MOSS智能教育终端";
     
-    display.setFont(u8g2_font_wqy14_t_gb2312);
-    int textWidth = display.getUTF8Width(text);
+    display.clearBuffer();
+    display.sendBuffer();
     
-    for (int x = 128; x > -textWidth; x -= 2) {
-        display.clearBuffer();
-        display.drawUTF8(x, 35, text);
-        display.sendBuffer();
-        delay(20);
+    // 文字渲染成字幕区（第 3~4 页，第 24~39 行）的列位图，基线在第 37 行；
+    // 返回写入的列数（不超过 tickerColumns 容量），超长文字截断而不是让 ticker 读越界
+    uint16_t textWidth = cjk.renderColumns(text, 13, tickerColumns, sizeof(tickerColumns) / sizeof(tickerColumns[0]));
+    ticker.setSpeed(43);   // 与原来相同：每 46ms 2 像素
+    ticker.resetStats();
+    ticker.begin(3, tickerColumns, textWidth);
+    
+    // 滚动一遍：屏幕自己移动显存，CPU 每 23ms 只发一列
+    uint32_t start = millis();
+    while (ticker.position() < ticker.passLength()) {
+        ticker.update(millis());
+        delay(1);
     }
+    float seconds = (millis() - start) / 1000.0f;
+    ticker.stop();
+    display.sendBuffer();   // 屏幕与缓冲重新一致
+    
+    const TickerStats& st = ticker.stats();
+    float tickerRate = st.busBytes / seconds;
+    float fullRate = (st.steps / 2) * ScrollTicker::fullFrameBytes() / seconds;   // 原做法：每 2 像素整帧发送
+    Serial.printf("[INFO] 硬件滚动 %lu 像素 / %.1f 秒：%.0f 字节/秒（整帧刷新同速度约 %.0f 字节/秒，%.0fx）\n",
+                  (unsigned long)st.steps, seconds, tickerRate, fullRate, fullRate / tickerRate);
 }
 
 void test9_Clock() {
-    display.clearBuffer();
-    display.setFont(u8g2_font_wqy14_t_gb2312);
-    
     // 模拟时钟显示
     for (int sec = 0; sec < 10; sec++) {
         display.clearBuffer();
-        
-        display.drawUTF8(40, 13, "时钟");
-        display.drawLine(0, 15, 128, 15);
-        
-        char timeStr[20];
-        sprintf(timeStr, "00:00:%02d", sec);
-        display.setFont(u8g2_font_logisoso16_tr);
-        display.drawStr(25, 45, timeStr);
-        
+        oledDrawClock(display, oledFonts, drawText, sec);
         display.sendBuffer();
         delay(1000);
     }
@@ -199,24 +195,124 @@ void test9_Clock() {
 
 void test10_Dashboard() {
     display.clearBuffer();
+    oledDrawDashboard(display, oledFonts, drawText);
+    display.sendBuffer();
+}
+
+void test11_GlyphCache() {
+    static const char* samples[] = {
+        "你好世界", "系统状态", "运行:00:05:23", "温度:42°C", ">1.开始对话", "WiFi:已连接", "欢迎使用MOSS智能教育终端"
+    };
+    const int count = sizeof(samples) / sizeof(samples[0]);
+    static uint8_t reference[DISPLAY_BUFFER_SIZE];
+
+    // 1. 与 U8g2 drawUTF8 逐像素比较（透明模式）
     display.setFont(u8g2_font_wqy14_t_gb2312);
-    
-    // 仪表盘样式
-    display.drawUTF8(30, 13, "仪表盘");
-    display.drawLine(0, 15, 128, 15);
-    
-    // CPU（恢复中文）
-    display.drawUTF8(5, 31, "CPU:45%");
-    display.drawBox(60, 22, 45, 8);
-    
-    // 内存
-    display.drawUTF8(5, 47, "内存:67%");
-    display.drawBox(60, 38, 67, 8);
-    
-    // 温度
-    display.drawUTF8(5, 61, "温度:42°C");
-    
+    display.setFontMode(1);
+    int mismatches = 0;
+    for (int i = 0; i < count; i++) {
+        display.clearBuffer();
+        display.drawUTF8(0, 30, samples[i]);
+        memcpy(reference, display.getBufferPtr(), DISPLAY_BUFFER_SIZE);
+        display.clearBuffer();
+        drawText(0, 30, samples[i]);
+        if (memcmp(reference, display.getBufferPtr(), DISPLAY_BUFFER_SIZE) != 0) {
+            Serial.printf("[ERROR] 字形缓存绘制与 U8g2 不一致: %s\n", samples[i]);
+            mismatches++;
+        }
+    }
+    display.setFontMode(0);
+    if (mismatches == 0) {
+        Serial.printf("[INFO] 字形缓存绘制与 U8g2 一致（%d 个字符串）\n", count);
+    }
+
+    // 2. 每帧绘制耗时对比
+    const int rounds = 50;
+    uint32_t start = micros();
+    for (int r = 0; r < rounds; r++) {
+        display.clearBuffer();
+        for (int i = 0; i < count; i++) {
+            display.drawUTF8(0, 14 + (i % 4) * 16, samples[i]);
+        }
+    }
+    uint32_t directUs = (micros() - start) / rounds;
+
+    start = micros();
+    for (int r = 0; r < rounds; r++) {
+        display.clearBuffer();
+        for (int i = 0; i < count; i++) {
+            drawText(0, 14 + (i % 4) * 16, samples[i]);
+        }
+    }
+    uint32_t cachedUs = (micros() - start) / rounds;
+
+    const GlyphCacheStats& st = cjk.stats();
+    Serial.printf("[INFO] U8g2 drawUTF8: %lu us/帧，字形缓存: %lu us/帧\n",
+                  (unsigned long)directUs, (unsigned long)cachedUs);
+    Serial.printf("[INFO] 缓存 %u/%d 个字，命中 %lu，未命中 %lu，淘汰 %lu\n",
+                  cjk.size(), GLYPH_CACHE_SLOTS, (unsigned long)st.hits, (unsigned long)st.misses,
+                  (unsigned long)st.evictions);
+#ifdef HAVE_GLYPH_LABELS
+    Serial.printf("[INFO] 预渲染标签 %d 个\n", (int)GLYPH_LABEL_COUNT);
+#endif
+    display.sendBuffer();
+}
+
+void test12_RetainedDashboard() {
+    // 与 test10 相同的仪表盘，控件布局一次
+    U8g2UiCanvas canvas(display);
+    UiLabel title(UiRect{30, 0, 60, 15}, u8g2_font_wqy14_t_gb2312, 13, "仪表盘");
+    UiBar line(UiRect{0, 15, 128, 1}, 1);
+    UiValue cpu(UiRect{5, 18, 55, 15}, u8g2_font_wqy14_t_gb2312, 13, "CPU:", "%");
+    UiBar cpuBar(UiRect{60, 22, 67, 8}, 100);
+    UiValue mem(UiRect{5, 34, 55, 15}, u8g2_font_wqy14_t_gb2312, 13, "内存:", "%");
+    UiBar memBar(UiRect{60, 38, 67, 8}, 100);
+    UiValue temp(UiRect{5, 48, 80, 16}, u8g2_font_wqy14_t_gb2312, 13, "温度:", "°C");
+    UiScreen screen;
+    screen.add(title);
+    screen.add(line);
+    screen.add(cpu);
+    screen.add(cpuBar);
+    screen.add(mem);
+    screen.add(memBar);
+    screen.add(temp);
+    line.setValue(1);
+
+    display.clearBuffer();
+    screen.render(canvas);
     display.sendBuffer();
+
+    // CPU 每帧变化，内存/温度偶尔变化：每帧只重画并发送变化的控件
+    UiRect boxes[UI_MAX_WIDGETS];
+    uint32_t drawUs = 0, sendUs = 0, widgets = 0;
+    const int frames = 100;
+    for (int i = 0; i < frames; i++) {
+        int load = 30 + random(0, 40);
+        cpu.setValue(load);
+        cpuBar.setValue(load);
+        if (i % 20 == 0) {
+            mem.setValue(60 + random(0, 10));
+            memBar.setValue(mem.value());
+            temp.setValue(40 + random(0, 5));
+        }
+
+        uint32_t t0 = micros();
+        uint8_t n = screen.render(canvas, boxes, UI_MAX_WIDGETS);
+        uint32_t t1 = micros();
+        for (uint8_t k = 0; k < n; k++) {
+            sendBox(boxes[k]);
+        }
+        drawUs += t1 - t0;
+        sendUs += micros() - t1;
+        widgets += n;
+        delay(50);
+    }
+
+    const UiRenderStats& st = screen.stats();
+    Serial.printf("[INFO] 每帧重画 %.1f/%d 个控件，绘制 %lu us，发送 %lu us\n",
+                  widgets / (float)frames, screen.count(),
+                  (unsigned long)(drawUs / frames), (unsigned long)(sendUs / frames));
+    Serial.printf("[INFO] 共重画 %lu 个控件，跳过 %lu 个\n", (unsigned long)st.drawn, (unsigned long)st.skipped);
 }
 
 // ========== 主程序 ==========
@@ -235,9 +331,7 @@ void setup() {
     
     // 启动画面
     display.clearBuffer();
-    display.setFont(u8g2_font_wqy14_t_gb2312);
-    display.drawUTF8(20, 25, "MOSS终端");
-    display.drawUTF8(25, 45, "初始化中");
+    oledDrawBoot(display, oledFonts, drawText);
     display.sendBuffer();
     delay(1500);
     
@@ -252,6 +346,8 @@ void setup() {
     Serial.println("  8 - 滚动文字");
     Serial.println("  9 - 时钟显示");
     Serial.println("  0 - 仪表盘");
+    Serial.println("  g - 字形缓存校验与耗时");
+    Serial.println("  u - 保留模式仪表盘");
     Serial.println("  a - 自动演示全部\n");
     
     // 默认显示
@@ -313,6 +409,16 @@ void loop() {
                 test10_Dashboard();
                 break;
                 
+            case 'g':
+                Serial.println("\n[测试11] 字形缓存");
+                test11_GlyphCache();
+                break;
+                
+            case 'u':
+                Serial.println("\n[测试12] 保留模式仪表盘");
+                test12_RetainedDashboard();
+                break;
+                
             case 'a':
             case 'A':
                 Serial.println("\n[自动演示] 开始...");
@@ -0,0 +1,335 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "TileFlusher.h"
+#include "RecordingTileTransport.h"
+#include "AsyncDisplayFlush.h"
+
+// ========================================
+// AsyncDisplayFlush 测试（主机端，native 环境）
+// 绘制方 submit() 固定耗时、刷新任务只取最新帧、落后时丢帧不排队、发送中的帧不被改写
+// 运行：python tools/run_native_tests.py test_async_display_flush
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 27182;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+// 整帧填充同一个值（帧编号），收到的块内容可直接看出属于哪一帧
+static void fillFrame(uint8_t* buf, uint8_t id) {
+    memset(buf, id, DISPLAY_BUFFER_SIZE);
+}
+
+/**
+ * 慢速总线：在 RecordingTileTransport 基础上按字节忙等（模拟 I2C 发送时间），
+ * 检查每一帧的所有块都来自同一帧（没有撕裂），并且帧编号递增
+ */
+class SlowBus : public RecordingTileTransport {
+public:
+    explicit SlowBus(uint32_t nsPerByte) : nsPerByte(nsPerByte), torn(0), outOfOrder(0), frameId(-1), lastId(-1) {}
+
+    void beginFrame() { frameId = -1; }
+
+    void drawTiles(uint8_t tx, uint8_t ty, uint8_t count, const uint8_t* tiles) override {
+        uint8_t id = tiles[0];
+        for (int i = 0; i < count * 8; i++) {
+            if (tiles[i] != id) {
+                torn++;
+                break;
+            }
+        }
+        if (frameId < 0) {
+            frameId = id;
+            if (lastId >= 0 && (uint8_t)(id - lastId) > 128) outOfOrder++;
+            lastId = id;
+        } else if (frameId != id) {
+            torn++;
+        }
+
+        uint32_t before = bytes;
+        RecordingTileTransport::drawTiles(tx, ty, count, tiles);
+        spin((bytes - before) * nsPerByte);
+
+        // 发送期间缓冲必须保持不变
+        for (int i = 0; i < count * 8; i++) {
+            if (tiles[i] != id) {
+                torn++;
+                break;
+            }
+        }
+    }
+
+    static void spin(uint64_t ns) {
+        auto until = std::chrono::steady_clock::now() + std::chrono::nanoseconds(ns);
+        while (std::chrono::steady_clock::now() < until) {
+        }
+    }
+
+    uint32_t nsPerByte;
+    uint32_t torn;
+    uint32_t outOfOrder;
+    int frameId;
+    int lastId;
+};
+
+// 发送途中回调绘制方：模拟主循环在 I2C 传输期间继续 submit()
+class ReentrantBus : public RecordingTileTransport {
+public:
+    ReentrantBus() : display(nullptr), corrupted(0), nested(0) {}
+
+    void drawTiles(uint8_t tx, uint8_t ty, uint8_t count, const uint8_t* tiles) override {
+        uint8_t snapshot[DISPLAY_BUFFER_SIZE];
+        memcpy(snapshot, tiles, count * 8);
+
+        static uint8_t frame[DISPLAY_BUFFER_SIZE];
+        for (int k = 0; k < 3; k++) {
+            fillFrame(frame, (uint8_t)(200 + nested++ % 50));
+            display->submit(frame);
+        }
+
+        if (memcmp(snapshot, tiles, count * 8) != 0) {
+            corrupted++;
+        }
+        RecordingTileTransport::drawTiles(tx, ty, count, tiles);
+    }
+
+    AsyncDisplayFlush* display;
+    uint32_t corrupted;
+    uint32_t nested;
+};
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: 提交后由 service() 发送，没有新帧时 service() 不访问总线
+void test_unit_submit_then_service() {
+    RecordingTileTransport bus;
+    TileFlusher flusher(bus);
+    AsyncDisplayFlush display(flusher);
+    static uint8_t frame[DISPLAY_BUFFER_SIZE];
+
+    TEST_ASSERT_FALSE(display.service());
+    fillFrame(frame, 7);
+    TEST_ASSERT_TRUE(display.submit(frame));
+    TEST_ASSERT_TRUE(display.pending());
+    TEST_ASSERT_EQUAL(0, bus.calls);            // submit() 本身不访问总线
+
+    TEST_ASSERT_TRUE(display.service());
+    TEST_ASSERT_EQUAL_MEMORY(frame, bus.screen, DISPLAY_BUFFER_SIZE);
+    TEST_ASSERT_FALSE(display.pending());
+    TEST_ASSERT_FALSE(display.service());
+    TEST_ASSERT_EQUAL(1, display.stats().flushed);
+}
+
+// 单元测试2: 刷新任务落后时只保留最新一帧，其余计为丢帧
+void test_unit_drop_when_behind() {
+    RecordingTileTransport bus;
+    TileFlusher flusher(bus);
+    AsyncDisplayFlush display(flusher);
+    static uint8_t frame[DISPLAY_BUFFER_SIZE];
+
+    fillFrame(frame, 1);
+    TEST_ASSERT_TRUE(display.submit(frame));
+    fillFrame(frame, 2);
+    TEST_ASSERT_FALSE(display.submit(frame));
+    fillFrame(frame, 3);
+    TEST_ASSERT_FALSE(display.submit(frame));
+
+    TEST_ASSERT_TRUE(display.service());
+    TEST_ASSERT_FALSE(display.service());
+    TEST_ASSERT_EQUAL_HEX8(3, bus.screen[0]);
+    TEST_ASSERT_EQUAL_HEX8(3, bus.screen[DISPLAY_BUFFER_SIZE - 1]);
+
+    DisplayFlushStats s = display.stats();
+    TEST_ASSERT_EQUAL(3, s.submitted);
+    TEST_ASSERT_EQUAL(1, s.flushed);
+    TEST_ASSERT_EQUAL(2, s.dropped);
+}
+
+// 单元测试3: 发送途中继续 submit()，正在发送的槽位不被改写
+void test_unit_sending_slot_untouched() {
+    ReentrantBus bus;
+    TileFlusher flusher(bus);
+    AsyncDisplayFlush display(flusher);
+    bus.display = &display;
+    static uint8_t frame[DISPLAY_BUFFER_SIZE];
+
+    fillFrame(frame, 9);
+    display.submit(frame);
+    TEST_ASSERT_TRUE(display.service());         // 整帧 8 段，每段期间提交 3 帧
+
+    TEST_ASSERT_EQUAL(0, bus.corrupted);
+    TEST_ASSERT_EQUAL_HEX8(9, bus.screen[0]);
+    TEST_ASSERT_EQUAL_HEX8(9, bus.screen[DISPLAY_BUFFER_SIZE - 1]);
+    TEST_ASSERT_TRUE(display.pending());
+}
+
+// 单元测试4: 只发送变化的块（经 TileFlusher），invalidate() 后下一帧发整帧
+void test_unit_partial_and_invalidate() {
+    RecordingTileTransport bus;
+    TileFlusher flusher(bus);
+    AsyncDisplayFlush display(flusher);
+    static uint8_t frame[DISPLAY_BUFFER_SIZE];
+
+    fillFrame(frame, 0);
+    display.submit(frame);
+    display.service();
+    bus.reset();
+
+    frame[300] = 0xFF;
+    display.submit(frame);
+    display.service();
+    TEST_ASSERT_EQUAL(1, bus.tilesDrawn);
+
+    bus.reset();
+    display.invalidate();
+    display.submit(frame);
+    display.service();
+    TEST_ASSERT_EQUAL(128, bus.tilesDrawn);
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 随机交错 submit()/service()：
+// - 每次 service() 后屏幕内容等于最后一次提交的帧
+// - submitted == flushed + dropped + (pending ? 1 : 0)
+void test_property_latest_frame_wins() {
+    printf("\n[Property Test] 随机交错提交/发送，屏幕总是最新帧且计数守恒 - 100次迭代\n");
+
+    for (int i = 0; i < 100; i++) {
+        RecordingTileTransport bus;
+        TileFlusher flusher(bus);
+        AsyncDisplayFlush display(flusher);
+        static uint8_t frame[DISPLAY_BUFFER_SIZE];
+        static uint8_t last[DISPLAY_BUFFER_SIZE];
+        bool any = false;
+
+        for (int op = 0; op < 60; op++) {
+            if (testRandomInt(0, 2) > 0) {
+                int edits = testRandomInt(1, 20);
+                for (int e = 0; e < edits; e++) {
+                    frame[testRandomInt(0, DISPLAY_BUFFER_SIZE - 1)] = (uint8_t)testRandomInt(0, 255);
+                }
+                display.submit(frame);
+                memcpy(last, frame, sizeof(frame));
+                any = true;
+            } else {
+                display.service();
+                if (any && !display.pending() && memcmp(bus.screen, last, DISPLAY_BUFFER_SIZE) != 0) {
+                    char msg[64];
+                    snprintf(msg, sizeof(msg), "Iter %d op %d: 屏幕不是最新帧", i, op);
+                    TEST_FAIL_MESSAGE(msg);
+                }
+            }
+            DisplayFlushStats s = display.stats();
+            if (s.submitted != s.flushed + s.dropped + (display.pending() ? 1 : 0)) {
+                TEST_FAIL_MESSAGE("帧计数不守恒");
+            }
+        }
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+
+    TEST_PASS();
+}
+
+// ========================================
+// 性能测试
+// ========================================
+
+// 两个线程：绘制方每 periodUs 提交一帧（每帧整屏内容都变），刷新线程经慢速总线发送
+static void runThreaded(uint32_t busHz, uint32_t periodUs, int frames) {
+    // 主机端按 1/10 时间模拟总线（每字节 9 个时钟）
+    uint32_t nsPerByte = (uint32_t)(9ull * 1000000000ull / busHz / 10);
+    SlowBus bus(nsPerByte);
+    TileFlusher flusher(bus);
+    AsyncDisplayFlush display(flusher);
+    std::atomic<bool> done(false);
+
+    std::thread consumer([&]() {
+        while (true) {
+            bool finished = done.load(std::memory_order_acquire);
+            bus.beginFrame();
+            if (!display.service()) {
+                if (finished) break;
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    static uint8_t frame[DISPLAY_BUFFER_SIZE];
+    double maxNs = 0, sumNs = 0;
+    for (int f = 0; f < frames; f++) {
+        fillFrame(frame, (uint8_t)(f & 0xFF));
+        auto start = std::chrono::steady_clock::now();
+        display.submit(frame);
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        sumNs += ns;
+        if (ns > maxNs) maxNs = ns;
+        SlowBus::spin((uint64_t)periodUs * 1000 / 10);
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    DisplayFlushStats s = display.stats();
+    printf("  总线 %3u kHz: submit() 平均 %.0f ns / 最长 %.0f ns，发送 %u 帧，丢弃 %u 帧，撕裂 %u，乱序 %u\n",
+           busHz / 1000, sumNs / frames, maxNs, s.flushed, s.dropped, bus.torn, bus.outOfOrder);
+
+    TEST_ASSERT_EQUAL(0, bus.torn);
+    TEST_ASSERT_EQUAL(0, bus.outOfOrder);
+    TEST_ASSERT_EQUAL(s.submitted, s.flushed + s.dropped);
+    TEST_ASSERT_EQUAL_HEX8((frames - 1) & 0xFF, bus.screen[0]);   // 最后一帧一定发出
+}
+
+// 性能1: 主循环每 10ms 提交一帧（整屏变化，最坏情况），400kHz / 100kHz 总线
+// submit() 耗时与总线速度无关，总线跟不上时丢帧而不是排队
+void test_benchmark_submit_cost_vs_bus() {
+    printf("\n[Benchmark] submit() 耗时与总线速度（主机按 1/10 时间模拟，整屏每帧都变）\n");
+
+    runThreaded(400000, 10000, 300);
+    runThreaded(100000, 10000, 300);
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("AsyncDisplayFlush 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_submit_then_service);
+    RUN_TEST(test_unit_drop_when_behind);
+    RUN_TEST(test_unit_sending_slot_untouched);
+    RUN_TEST(test_unit_partial_and_invalidate);
+
+    printf("\n========================================\n");
+    printf("AsyncDisplayFlush 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_latest_frame_wins);
+
+    printf("\n========================================\n");
+    printf("AsyncDisplayFlush 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_submit_cost_vs_bus);
+
+    return UNITY_END();
+}
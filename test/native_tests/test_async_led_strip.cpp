@@ -0,0 +1,349 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include "LedWaveform.h"
+#include "AsyncLedStrip.h"
+#include "RecordingLedTransport.h"
+#include "LedCompositor.h"
+
+// ========================================
+// AsyncLedStrip 测试（主机端，native 环境）
+// 用 RecordingLedTransport 代替 RMT，记录波形后解码校验
+// 运行：python tools/run_native_tests.py test_async_led_strip
+// ========================================
+
+static const uint16_t LED_COUNT = 5;
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 24680;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+// 把一帧波形解码回 0x00RRGGBB 像素
+static int decodePixels(const std::vector<LedWaveItem>& wave, uint32_t* pixels, uint16_t maxPixels) {
+    uint8_t bytes[LED_MAX_PIXELS * 3];
+    int len = ledWaveDecode(wave.data(), wave.size(), WS2812_TIMING, bytes, sizeof(bytes));
+    if (len < 0 || len % 3 != 0 || len / 3 > maxPixels) {
+        return -1;
+    }
+    for (int i = 0; i < len / 3; i++) {
+        pixels[i] = ledColor(bytes[i * 3 + 1], bytes[i * 3], bytes[i * 3 + 2]);
+    }
+    return len / 3;
+}
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: 波形项位布局与 rmt_item32_t 一致
+void test_unit_item_layout() {
+    LedWaveItem item = ledWaveItem(16, 1, 34, 0);
+    TEST_ASSERT_EQUAL_HEX32(16u | (1u << 15) | (34u << 16), item);
+    TEST_ASSERT_EQUAL(16, ledWaveDuration0(item));
+    TEST_ASSERT_EQUAL(1, ledWaveLevel0(item));
+    TEST_ASSERT_EQUAL(34, ledWaveDuration1(item));
+    TEST_ASSERT_EQUAL(0, ledWaveLevel1(item));
+
+    LedWaveItem max = ledWaveItem(0x7FFF, 0, 0x7FFF, 1);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFF7FFF, max);
+}
+
+// 单元测试2: GRB 顺序、高位在前、每位时序正确
+void test_unit_encode_grb_msb_first() {
+    RecordingLedTransport tx;
+    AsyncLedStrip strip(1, tx);
+    strip.setPixelColor(0, AsyncLedStrip::Color(0x12, 0x80, 0x01));
+    strip.show();
+
+    TEST_ASSERT_EQUAL(1, tx.frames.size());
+    const std::vector<LedWaveItem>& wave = tx.frames[0];
+    TEST_ASSERT_EQUAL(25, wave.size());
+
+    // G = 0x80：第一位为1，其余为0
+    TEST_ASSERT_EQUAL(WS2812_TIMING.t1h, ledWaveDuration0(wave[0]));
+    TEST_ASSERT_EQUAL(WS2812_TIMING.t1l, ledWaveDuration1(wave[0]));
+    TEST_ASSERT_EQUAL(WS2812_TIMING.t0h, ledWaveDuration0(wave[1]));
+    // B = 0x01：最后一个数据位为1
+    TEST_ASSERT_EQUAL(WS2812_TIMING.t1h, ledWaveDuration0(wave[23]));
+    // 复位项：全低电平 300us
+    TEST_ASSERT_EQUAL(0, ledWaveLevel0(wave[24]));
+    TEST_ASSERT_EQUAL(WS2812_TIMING.resetTicks, ledWaveDuration0(wave[24]) + ledWaveDuration1(wave[24]));
+
+    uint32_t pixel = 0;
+    TEST_ASSERT_EQUAL(1, decodePixels(wave, &pixel, 1));
+    TEST_ASSERT_EQUAL_HEX32(0x128001, pixel);
+}
+
+// 单元测试3: 亮度缩放与 Adafruit_NeoPixel 相同
+void test_unit_brightness_matches_neopixel() {
+    RecordingLedTransport tx;
+    AsyncLedStrip strip(1, tx);
+    strip.setBrightness(128);   // 综合测试使用的亮度
+    strip.setPixelColor(0, 255, 100, 1);
+    strip.show();
+
+    uint32_t pixel = 0;
+    decodePixels(tx.frames[0], &pixel, 1);
+    // Adafruit: (c * (128 + 1)) >> 8
+    TEST_ASSERT_EQUAL_HEX32(ledColor(255 * 129 >> 8, 100 * 129 >> 8, 0), pixel);
+    TEST_ASSERT_EQUAL(128, strip.getBrightness());
+    // getPixelColor 返回未缩放的颜色
+    TEST_ASSERT_EQUAL_HEX32(ledColor(255, 100, 1), strip.getPixelColor(0));
+}
+
+// 单元测试4: 发送中 show() 挂起，发送中的缓冲不被改写，完成后 poll() 发出
+void test_unit_double_buffer_pending() {
+    RecordingLedTransport tx(false);
+    AsyncLedStrip strip(LED_COUNT, tx);
+
+    strip.setPixelColor(0, ledColor(255, 0, 0));
+    strip.show();
+    TEST_ASSERT_TRUE(tx.busy());
+    TEST_ASSERT_EQUAL(1, tx.frames.size());
+
+    strip.setPixelColor(0, ledColor(0, 255, 0));
+    strip.show();                       // 上一帧还在发送：挂起
+    TEST_ASSERT_EQUAL(1, tx.frames.size());
+    TEST_ASSERT_TRUE(strip.busy());
+    TEST_ASSERT_EQUAL(1, strip.stats().queued);
+
+    strip.poll();                       // 仍在发送：不动
+    TEST_ASSERT_EQUAL(1, tx.frames.size());
+
+    tx.complete();
+    TEST_ASSERT_EQUAL(1, strip.completedFrames());
+    strip.poll();
+    TEST_ASSERT_EQUAL(2, tx.frames.size());
+    tx.complete();
+    TEST_ASSERT_FALSE(strip.busy());
+
+    uint32_t pixels[LED_COUNT];
+    decodePixels(tx.frames[0], pixels, LED_COUNT);
+    TEST_ASSERT_EQUAL_HEX32(ledColor(255, 0, 0), pixels[0]);
+    decodePixels(tx.frames[1], pixels, LED_COUNT);
+    TEST_ASSERT_EQUAL_HEX32(ledColor(0, 255, 0), pixels[0]);
+    TEST_ASSERT_EQUAL(0, tx.corruptedFrames());
+}
+
+// 单元测试5: 挂起期间多次 show() 只发最新一帧
+void test_unit_superseded_frames() {
+    RecordingLedTransport tx(false);
+    AsyncLedStrip strip(LED_COUNT, tx);
+
+    strip.show();
+    for (int i = 1; i <= 5; i++) {
+        strip.setPixelColor(4, ledColor(0, 0, i * 40));
+        strip.show();
+    }
+    tx.complete();
+    strip.poll();
+    tx.complete();
+
+    TEST_ASSERT_EQUAL(2, tx.frames.size());
+    TEST_ASSERT_EQUAL(6, strip.stats().shows);
+    TEST_ASSERT_EQUAL(4, strip.stats().superseded);
+
+    uint32_t pixels[LED_COUNT];
+    decodePixels(tx.frames[1], pixels, LED_COUNT);
+    TEST_ASSERT_EQUAL_HEX32(ledColor(0, 0, 200), pixels[4]);
+}
+
+// 单元测试6: 解码器拒绝不合法的波形
+void test_unit_decoder_rejects_bad_timing() {
+    uint8_t byte = 0xA5;
+    LedWaveItem wave[9];
+    ledWaveEncodeBytes(&byte, 1, WS2812_TIMING, wave);
+    wave[8] = ledWaveResetItem(WS2812_TIMING);
+
+    uint8_t out = 0;
+    TEST_ASSERT_EQUAL(1, ledWaveDecode(wave, 9, WS2812_TIMING, &out, 1));
+    TEST_ASSERT_EQUAL_HEX8(0xA5, out);
+
+    LedWaveItem bad[9];
+    memcpy(bad, wave, sizeof(wave));
+    bad[3] = ledWaveItem(24, 1, 26, 0);          // 高电平 600ns：介于 0码/1码之间
+    TEST_ASSERT_EQUAL(-1, ledWaveDecode(bad, 9, WS2812_TIMING, &out, 1));
+
+    memcpy(bad, wave, sizeof(wave));
+    bad[8] = ledWaveItem(1000, 0, 1000, 0);      // 复位只有 50us
+    TEST_ASSERT_EQUAL(-1, ledWaveDecode(bad, 9, WS2812_TIMING, &out, 1));
+}
+
+// 单元测试7: 作为 LedCompositor 的后端，flush() 里的 poll() 发出挂起帧
+void test_unit_compositor_backend() {
+    RecordingLedTransport tx(false);
+    AsyncLedStrip strip(LED_COUNT, tx);
+    LedCompositor frame(strip);
+    frame.defineZone("eye", 0, 2);
+    frame.defineZone("body", 2, 3);
+
+    frame.fillZone(1, ledColor(255, 100, 0));
+    TEST_ASSERT_TRUE(frame.flush(0));
+    frame.fillZone(0, ledColor(255, 0, 0));
+    TEST_ASSERT_TRUE(frame.flush(10));          // 挂起在驱动里
+    TEST_ASSERT_EQUAL(1, tx.frames.size());
+
+    tx.complete();
+    TEST_ASSERT_FALSE(frame.flush(20));         // 合成器没有新修改，但 poll() 发出挂起帧
+    TEST_ASSERT_EQUAL(2, tx.frames.size());
+
+    uint32_t pixels[LED_COUNT];
+    decodePixels(tx.frames[1], pixels, LED_COUNT);
+    for (uint16_t i = 0; i < LED_COUNT; i++) {
+        TEST_ASSERT_EQUAL_HEX32(frame.pixel(i), pixels[i]);
+    }
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 随机像素修改、随机 show() / 完成时刻：
+// - 每一帧波形都能按 WS2812 时序解码
+// - 每一帧等于某次 show() 时的像素，且按 show() 顺序发出
+// - 发送中的缓冲从不被改写；全部完成后最后一帧等于当前像素
+void test_property_random_show_and_complete() {
+    printf("\n[Property Test] 随机 show()/发送完成时序 - 100次迭代\n");
+
+    for (int i = 0; i < 100; i++) {
+        RecordingLedTransport tx(false);
+        uint16_t count = (uint16_t)testRandomInt(1, LED_MAX_PIXELS);
+        AsyncLedStrip strip(count, tx);
+
+        std::vector<std::vector<uint32_t>> shown;   // 每次 show() 时的像素
+        for (int op = 0; op < 100; op++) {
+            int changes = testRandomInt(0, 3);
+            for (int c = 0; c < changes; c++) {
+                strip.setPixelColor(testRandomInt(0, count - 1),
+                                    ledColor(testRandomInt(0, 255), testRandomInt(0, 255), testRandomInt(0, 255)));
+            }
+            if (testRandomInt(0, 1)) {
+                std::vector<uint32_t> snap(count);
+                for (uint16_t p = 0; p < count; p++) snap[p] = strip.getPixelColor(p);
+                shown.push_back(snap);
+                strip.show();
+            }
+            if (testRandomInt(0, 2) == 0) tx.complete();
+            strip.poll();
+        }
+        while (strip.busy()) {
+            tx.complete();
+            strip.poll();
+        }
+
+        TEST_ASSERT_EQUAL(0, tx.corruptedFrames());
+        TEST_ASSERT_EQUAL(shown.size(), strip.stats().transmits + strip.stats().superseded);
+
+        // 发出的帧是 shown 的一个保序子序列，且包含最后一次 show()
+        size_t next = 0;
+        for (size_t f = 0; f < tx.frames.size(); f++) {
+            uint32_t pixels[LED_MAX_PIXELS];
+            if (decodePixels(tx.frames[f], pixels, count) != count) {
+                TEST_FAIL_MESSAGE("波形解码失败");
+            }
+            while (next < shown.size() && memcmp(shown[next].data(), pixels, count * sizeof(uint32_t)) != 0) {
+                next++;
+            }
+            if (next == shown.size()) {
+                char msg[80];
+                snprintf(msg, sizeof(msg), "Iter %d: 第 %u 帧不是任何一次 show() 的内容", i, (unsigned)f);
+                TEST_FAIL_MESSAGE(msg);
+            }
+            next++;
+        }
+        if (!shown.empty() && next != shown.size()) {
+            TEST_FAIL_MESSAGE("最后一次 show() 没有发出");
+        }
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+
+    TEST_PASS();
+}
+
+// ========================================
+// 性能测试
+// ========================================
+
+// 性能1: show() 在调用核上的耗时（编码）对比同步发送的阻塞时间（波形时长）
+void test_benchmark_show_cost() {
+    printf("\n[Benchmark] show() 调用耗时 vs 同步发送阻塞时间\n");
+
+    const uint16_t sizes[] = {LED_COUNT, LED_MAX_PIXELS};
+    for (uint16_t count : sizes) {
+        RecordingLedTransport tx;
+        AsyncLedStrip strip(count, tx);
+        for (uint16_t p = 0; p < count; p++) {
+            strip.setPixelColor(p, ledColor(p * 7, 255 - p, p * 3));
+        }
+
+        const int RUNS = 2000;
+        uint32_t encodeOnly = 0;
+        LedWaveItem wave[LED_WAVE_MAX_ITEMS];
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < RUNS; r++) {
+            uint8_t grb[3] = {(uint8_t)r, 0x55, 0xAA};
+            for (uint16_t p = 0; p < count; p++) {
+                encodeOnly += (uint32_t)ledWaveEncodeBytes(grb, 3, WS2812_TIMING, wave + p * 24);
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        double encodeNs = std::chrono::duration<double, std::nano>(end - start).count() / RUNS;
+
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < RUNS; r++) {
+            strip.setPixelColor(0, ledColor(r & 0xFF, 0, 0));
+            strip.show();
+            if (tx.frames.size() > 16) tx.frames.clear();
+        }
+        end = std::chrono::steady_clock::now();
+        double showNs = std::chrono::duration<double, std::nano>(end - start).count() / RUNS;
+
+        uint32_t waveNs = ledWaveDurationNs(tx.frames.back().data(), tx.frames.back().size(), WS2812_TIMING);
+        printf("  %2u 个LED: show() %.0f ns（纯编码 %.0f ns，含记录开销），同步发送阻塞 %.1f us\n",
+               count, showNs, encodeNs, waveNs / 1000.0f);
+        TEST_ASSERT_TRUE(encodeOnly > 0);
+        TEST_ASSERT_TRUE(showNs < waveNs);
+    }
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("AsyncLedStrip 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_item_layout);
+    RUN_TEST(test_unit_encode_grb_msb_first);
+    RUN_TEST(test_unit_brightness_matches_neopixel);
+    RUN_TEST(test_unit_double_buffer_pending);
+    RUN_TEST(test_unit_superseded_frames);
+    RUN_TEST(test_unit_decoder_rejects_bad_timing);
+    RUN_TEST(test_unit_compositor_backend);
+
+    printf("\n========================================\n");
+    printf("AsyncLedStrip 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_random_show_and_complete);
+
+    printf("\n========================================\n");
+    printf("AsyncLedStrip 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_show_cost);
+
+    return UNITY_END();
+}
@@ -0,0 +1,362 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "SoundBank.h"
+#include "AudioMixer.h"
+#include "WavFile.h"
+
+// ========================================
+// AudioMixer / SoundBank 测试（主机端，native 环境）
+// 验证定点混音正确性，测量混音耗时，并输出 WAV 供试听
+// 运行：python tools/run_native_tests.py test_audio_mixer
+// ========================================
+
+static const uint16_t RATE = 16000;
+static const uint32_t CLIP_SAMPLES = 8000;  // 0.5秒
+
+// 简单的伪随机数生成器（用于属性测试）
+static unsigned long testRandomInt(unsigned long min, unsigned long max) {
+    static unsigned long seed = 13579;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + seed % (max - min + 1);
+}
+
+// ========== 测试用音效库（模拟映射后的闪存分区） ==========
+
+static uint8_t bankImage[64 * 1024];
+static size_t bankSize = 0;
+static int16_t sineA[CLIP_SAMPLES];   // 440Hz
+static int16_t sineB[CLIP_SAMPLES];   // 660Hz
+static int16_t fullA[CLIP_SAMPLES];   // 550Hz 满幅
+static int16_t fullB[CLIP_SAMPLES];   // 770Hz 满幅
+
+static void fillSine(int16_t* out, uint32_t count, float freq, float amplitude) {
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = (int16_t)(amplitude * sinf(2.0f * (float)M_PI * freq * i / RATE));
+    }
+}
+
+// 按 tools/make_soundbank.py 的格式在内存中构建音效库：
+// 0 = "tone_a" PCM, 1 = "tone_b" PCM, 2 = "tone_a_adpcm" ADPCM
+static void buildBank() {
+    fillSine(sineA, CLIP_SAMPLES, 440.0f, 12000.0f);
+    fillSine(sineB, CLIP_SAMPLES, 660.0f, 12000.0f);
+    fillSine(fullA, CLIP_SAMPLES, 550.0f, 32767.0f);
+    fillSine(fullB, CLIP_SAMPLES, 770.0f, 32767.0f);
+
+    const uint16_t clipCount = 3;
+    SoundBankHeader header = { SOUND_BANK_MAGIC, SOUND_BANK_VERSION, clipCount };
+    memcpy(bankImage, &header, sizeof(header));
+
+    uint32_t offset = sizeof(SoundBankHeader) + clipCount * sizeof(SoundClipEntry);
+    SoundClipEntry entries[clipCount];
+    memset(entries, 0, sizeof(entries));
+
+    const char* names[clipCount] = { "tone_a", "tone_b", "tone_a_adpcm" };
+    for (int i = 0; i < clipCount; i++) {
+        strncpy(entries[i].name, names[i], SOUND_CLIP_NAME_LEN - 1);
+        entries[i].sampleRate = RATE;
+        entries[i].sampleCount = CLIP_SAMPLES;
+        entries[i].offset = offset;
+
+        if (i < 2) {
+            entries[i].format = CLIP_PCM16;
+            entries[i].dataBytes = CLIP_SAMPLES * 2;
+            memcpy(bankImage + offset, i == 0 ? sineA : sineB, CLIP_SAMPLES * 2);
+        } else {
+            entries[i].format = CLIP_IMA_ADPCM;
+            entries[i].dataBytes = CLIP_SAMPLES / 2;
+            ImaAdpcmState state = { 0, 0 };
+            for (uint32_t k = 0; k < CLIP_SAMPLES; k += 2) {
+                uint8_t lo = imaAdpcmEncodeSample(state, sineA[k]);
+                uint8_t hi = imaAdpcmEncodeSample(state, sineA[k + 1]);
+                bankImage[offset + k / 2] = lo | (hi << 4);
+            }
+        }
+        offset += (entries[i].dataBytes + 3) & ~3u;
+    }
+
+    memcpy(bankImage + sizeof(SoundBankHeader), entries, sizeof(entries));
+    bankSize = offset;
+}
+
+static SoundClip getClip(int index) {
+    SoundBank bank;
+    bank.attach(bankImage, bankSize);
+    SoundClip clip;
+    bank.getClip(index, clip);
+    return clip;
+}
+
+// 不经过音效库，直接把 PCM 数组包装成音效
+static SoundClip pcmClip(const int16_t* samples) {
+    SoundClip clip = { (const uint8_t*)samples, CLIP_SAMPLES, RATE, CLIP_PCM16 };
+    return clip;
+}
+
+static int16_t saturate(int64_t v) {
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return (int16_t)v;
+}
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: 音效库解析
+void test_unit_bank_parse() {
+    SoundBank bank;
+    TEST_ASSERT_TRUE(bank.attach(bankImage, bankSize));
+    TEST_ASSERT_EQUAL(3, bank.clipCount());
+    TEST_ASSERT_EQUAL(1, bank.findClip("tone_b"));
+    TEST_ASSERT_EQUAL(-1, bank.findClip("missing"));
+
+    SoundClip clip;
+    TEST_ASSERT_TRUE(bank.getClip(2, clip));
+    TEST_ASSERT_EQUAL(CLIP_IMA_ADPCM, clip.format);
+    TEST_ASSERT_FALSE(bank.getClip(3, clip));
+
+    // 映射区内直接引用，不拷贝
+    TEST_ASSERT_TRUE(clip.data > bankImage && clip.data < bankImage + bankSize);
+}
+
+// 单元测试2: 损坏的音效库被拒绝
+void test_unit_bank_reject_corrupt() {
+    SoundBank bank;
+    static uint8_t corrupt[sizeof(bankImage)];
+    memcpy(corrupt, bankImage, bankSize);
+
+    corrupt[0] ^= 0xFF;  // 魔数错误
+    TEST_ASSERT_FALSE(bank.attach(corrupt, bankSize));
+
+    memcpy(corrupt, bankImage, bankSize);
+    TEST_ASSERT_FALSE(bank.attach(corrupt, bankSize / 2));  // 数据段越界
+    TEST_ASSERT_EQUAL(0, bank.clipCount());
+}
+
+// 单元测试3: 单声部增益为1时输出与源数据逐位一致
+void test_unit_single_voice_bit_exact() {
+    AudioMixer mixer(RATE);
+    TEST_ASSERT_EQUAL(0, mixer.play(getClip(0)));
+
+    static int16_t out[CLIP_SAMPLES];
+    size_t audible = mixer.render(out, CLIP_SAMPLES);
+
+    TEST_ASSERT_EQUAL(CLIP_SAMPLES, audible);
+    TEST_ASSERT_EQUAL_MEMORY(sineA, out, sizeof(out));
+    TEST_ASSERT_FALSE(mixer.isActive());  // 播完自动释放声部
+}
+
+// 单元测试4: 饱和处理
+void test_unit_saturation() {
+    AudioMixer mixer(RATE);
+    for (int i = 0; i < 3; i++) {
+        mixer.play(getClip(0));  // 三个同相声部，峰值 36000 超出 int16
+    }
+
+    static int16_t out[CLIP_SAMPLES];
+    mixer.render(out, CLIP_SAMPLES);
+
+    TEST_ASSERT_TRUE(mixer.clippedSamples() > 0);
+    for (uint32_t i = 0; i < CLIP_SAMPLES; i++) {
+        TEST_ASSERT_EQUAL(saturate(3 * (int32_t)sineA[i]), out[i]);
+    }
+}
+
+// 单元测试5: ADPCM 解码质量（信噪比 > 25dB）
+void test_unit_adpcm_quality() {
+    AudioMixer mixer(RATE);
+    mixer.play(getClip(2));
+
+    static int16_t out[CLIP_SAMPLES];
+    mixer.render(out, CLIP_SAMPLES);
+
+    double signal = 0, noise = 0;
+    for (uint32_t i = 0; i < CLIP_SAMPLES; i++) {
+        signal += (double)sineA[i] * sineA[i];
+        double e = (double)out[i] - sineA[i];
+        noise += e * e;
+    }
+    double snr = 10.0 * log10(signal / noise);
+    printf("  ADPCM 信噪比: %.1f dB\n", snr);
+    TEST_ASSERT_TRUE(snr > 25.0);
+}
+
+// 单元测试6: 声部满时抢占最早的声部
+void test_unit_voice_stealing() {
+    AudioMixer mixer(RATE);
+    int first = mixer.play(getClip(0));
+    for (int i = 1; i < AudioMixer::MAX_VOICES; i++) {
+        mixer.play(getClip(1));
+    }
+    TEST_ASSERT_EQUAL(AudioMixer::MAX_VOICES, mixer.activeVoices());
+
+    int stolen = mixer.play(getClip(1));
+    TEST_ASSERT_EQUAL(first, stolen);
+    TEST_ASSERT_EQUAL(AudioMixer::MAX_VOICES, mixer.activeVoices());
+}
+
+// 单元测试7: 零拷贝快速路径条件
+void test_unit_direct_span() {
+    AudioMixer mixer(RATE);
+    const int16_t* span;
+
+    TEST_ASSERT_EQUAL(0, mixer.directSpan(&span, 256));  // 无声部
+
+    mixer.play(getClip(0));
+    TEST_ASSERT_EQUAL(256, mixer.directSpan(&span, 256));
+    TEST_ASSERT_TRUE((const uint8_t*)span == getClip(0).data);  // 指向映射区本身
+    mixer.advance(256);
+    TEST_ASSERT_EQUAL(256, mixer.directSpan(&span, 256));
+    TEST_ASSERT_TRUE(span == (const int16_t*)getClip(0).data + 256);
+
+    mixer.play(getClip(1));
+    TEST_ASSERT_EQUAL(0, mixer.directSpan(&span, 256));  // 两个声部必须混音
+
+    mixer.stopAll();
+    mixer.play(getClip(2));
+    TEST_ASSERT_EQUAL(0, mixer.directSpan(&span, 256));  // ADPCM 必须解码
+}
+
+// 单元测试8: 循环播放与采样率校验
+void test_unit_loop_and_rate() {
+    AudioMixer mixer(RATE);
+    mixer.play(getClip(0), AUDIO_GAIN_UNITY, true);
+
+    static int16_t out[CLIP_SAMPLES * 2 + 100];
+    mixer.render(out, CLIP_SAMPLES * 2 + 100);
+    TEST_ASSERT_TRUE(mixer.isActive());
+    TEST_ASSERT_EQUAL(sineA[50], out[CLIP_SAMPLES * 2 + 50]);
+
+    AudioMixer mixer8k(8000);
+    TEST_ASSERT_EQUAL(-1, mixer8k.play(getClip(0)));  // 采样率不匹配拒绝播放
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 任意增益组合下，输出等于各声部 (s*g)>>15 之和再乘主音量的饱和值
+// 4 个声部全部占满（其中 2 个满幅），主音量不为1，累加和乘主音量会超出 int32
+void test_property_fixed_point_mix() {
+    printf("\n[Property Test] 定点混音 - 100次迭代\n");
+
+    const int16_t* sources[AudioMixer::MAX_VOICES] = { sineA, sineB, fullA, fullB };
+    static int16_t out[1024];
+    for (int i = 0; i < 100; i++) {
+        AudioMixer mixer(RATE);
+        uint16_t gains[AudioMixer::MAX_VOICES];
+        gains[0] = (uint16_t)testRandomInt(0, 32767);
+        gains[1] = (uint16_t)testRandomInt(0, 32767);
+        gains[2] = (uint16_t)testRandomInt(16384, 32767);
+        gains[3] = (uint16_t)testRandomInt(16384, 32767);
+        uint16_t master = (uint16_t)testRandomInt(16384, 32766);
+        mixer.setMasterGain(master);
+        for (int v = 0; v < AudioMixer::MAX_VOICES; v++) {
+            mixer.play(pcmClip(sources[v]), gains[v]);
+        }
+
+        mixer.render(out, 1024);
+
+        uint32_t expectedClips = 0;
+        for (int k = 0; k < 1024; k++) {
+            int64_t sum = 0;
+            for (int v = 0; v < AudioMixer::MAX_VOICES; v++) {
+                int32_t s = sources[v][k];
+                sum += gains[v] == AUDIO_GAIN_UNITY ? s : (s * gains[v]) >> 15;
+            }
+            int64_t expected = (sum * master) >> 15;
+            if (expected != saturate(expected)) {
+                expectedClips++;
+            }
+            if (out[k] != saturate(expected)) {
+                char msg[120];
+                snprintf(msg, sizeof(msg), "Iter %d, sample %d: expected %d, got %d",
+                         i, k, saturate(expected), out[k]);
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+        TEST_ASSERT_EQUAL_UINT32(expectedClips, mixer.clippedSamples());
+    }
+
+    TEST_PASS();
+}
+
+// ========================================
+// 性能测试 + WAV 输出
+// ========================================
+
+// 4个声部（2 PCM + 1 ADPCM + 1 PCM 循环）混音10秒，输出 WAV 并统计耗时
+void test_benchmark_mix_to_wav() {
+    const uint32_t SECONDS = 10;
+    const size_t FRAME = 256;
+
+    AudioMixer mixer(RATE);
+    WavWriter wav;
+    TEST_ASSERT_TRUE(wav.open("audio_mixer_output.wav", RATE, 1));
+
+    static int16_t frame[FRAME];
+    double mixSeconds = 0;
+    uint32_t totalSamples = 0;
+
+    for (uint32_t n = 0; totalSamples < SECONDS * RATE; n++) {
+        // 每0.25秒触发一个新音效，保持声部满载
+        if (n % 16 == 0) {
+            int clip = (n / 16) % 3;
+            mixer.play(getClip(clip), 16384, clip == 1);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        mixer.render(frame, FRAME);
+        auto end = std::chrono::steady_clock::now();
+        mixSeconds += std::chrono::duration<double>(end - start).count();
+
+        wav.write(frame, FRAME);
+        totalSamples += FRAME;
+    }
+    TEST_ASSERT_TRUE(wav.close());
+
+    double nsPerSample = mixSeconds * 1e9 / totalSamples;
+    printf("  混音 %u 采样（%u 声部上限）: %.1f ns/采样, 实时倍率 %.0fx\n",
+           (unsigned)totalSamples, (unsigned)AudioMixer::MAX_VOICES,
+           nsPerSample, SECONDS / mixSeconds);
+    printf("  输出文件: audio_mixer_output.wav（%u 采样）\n", (unsigned)wav.samplesWritten());
+
+    TEST_ASSERT_EQUAL(totalSamples, wav.samplesWritten());
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    buildBank();
+
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("AudioMixer 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_bank_parse);
+    RUN_TEST(test_unit_bank_reject_corrupt);
+    RUN_TEST(test_unit_single_voice_bit_exact);
+    RUN_TEST(test_unit_saturation);
+    RUN_TEST(test_unit_adpcm_quality);
+    RUN_TEST(test_unit_voice_stealing);
+    RUN_TEST(test_unit_direct_span);
+    RUN_TEST(test_unit_loop_and_rate);
+
+    printf("\n========================================\n");
+    printf("AudioMixer 属性测试 / 性能测试\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_fixed_point_mix);
+    RUN_TEST(test_benchmark_mix_to_wav);
+
+    return UNITY_END();
+}
@@ -0,0 +1,250 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include "AudioSource.h"
+#include "AudioAnalyzer.h"
+#include "AudioSim.h"
+#include "WavFile.h"
+
+// ========================================
+// 音频链路仿真测试（主机端，native 环境）
+// 用合成 WAV 声场驱动 AudioAnalyzer，验证音量/方向/VAD 与检测延迟
+// 运行：python tools/run_native_tests.py test_audio_sim
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static float testRandom(float min, float max) {
+    static unsigned long seed = 97531;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    float normalized = (float)seed / (float)0x7fffffff;
+    return min + normalized * (max - min);
+}
+
+static SimReport runScene(const SceneSpec& spec, const char* path,
+                          const AudioAnalyzerConfig& config = AudioAnalyzerConfig()) {
+    synthesizeScene(spec, path);
+
+    WavAudioSource source;
+    source.open(path);
+
+    SimGroundTruth truth;
+    truth.onsetSec = spec.onsetSec;
+    truth.offsetSec = spec.onsetSec + spec.durationSec;
+    truth.angleDeg = spec.angleDeg;
+
+    AudioPipelineSim sim(config);
+    return sim.run(source, truth);
+}
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: WAV 读写往返，读出为左对齐 int32（与 I2S 帧格式一致）
+void test_unit_wav_roundtrip() {
+    int16_t samples[8] = { 0, 1, -1, 32767, -32768, 1234, -4321, 100 };
+
+    WavWriter writer;
+    TEST_ASSERT_TRUE(writer.open("sim_roundtrip.wav", 16000, 2));
+    writer.write(samples, 8);
+    TEST_ASSERT_TRUE(writer.close());
+
+    WavReader reader;
+    TEST_ASSERT_TRUE(reader.open("sim_roundtrip.wav"));
+    TEST_ASSERT_EQUAL(2, reader.channels());
+    TEST_ASSERT_EQUAL(4, reader.totalFrames());
+
+    int32_t frames[8];
+    TEST_ASSERT_EQUAL(4, reader.readFrames(frames, 8));
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(samples[i], frames[i] >> 16);
+    }
+    TEST_ASSERT_EQUAL(0, reader.readFrames(frames, 4));  // 文件结束
+}
+
+// 单元测试2: 单声道 WAV 复制到左右声道
+void test_unit_mono_source() {
+    int16_t samples[4] = { 10, -20, 30, -40 };
+    WavWriter writer;
+    writer.open("sim_mono.wav", 16000, 1);
+    writer.write(samples, 4);
+    writer.close();
+
+    WavAudioSource source;
+    TEST_ASSERT_TRUE(source.open("sim_mono.wav"));
+
+    int32_t frame[CAPTURE_FRAME_SAMPLES * 2];
+    TEST_ASSERT_EQUAL(4, source.readFrame(frame, CAPTURE_FRAME_SAMPLES));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(samples[i], frame[i * 2] >> 16);
+        TEST_ASSERT_EQUAL(samples[i], frame[i * 2 + 1] >> 16);
+    }
+}
+
+// 单元测试3: 峰值和方向公式与 getVolume()/getSoundDirection() 一致
+void test_unit_analyzer_formula() {
+    // 16位样本放在高16位（乘 65536 等价于左移16位）
+    int32_t frame[4 * 2] = {
+        100 * 65536,  -300 * 65536,
+        -200 * 65536,  50 * 65536,
+        50 * 65536,    10 * 65536,
+        0,             0
+    };
+
+    AudioAnalyzer analyzer;
+    AudioFrameStats stats = analyzer.process(frame, 4);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 200, stats.leftPeak);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 300, stats.rightPeak);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 300, stats.volume);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, (300.0f - 200.0f) / 500.0f * 90.0f, stats.direction);
+    TEST_ASSERT_TRUE(stats.triggered);
+
+    // 总音量低于阈值时方向为0
+    int32_t quiet[2] = { 30 * 65536, 60 * 65536 };
+    stats = analyzer.process(quiet, 1);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, stats.direction);
+    TEST_ASSERT_FALSE(stats.triggered);
+}
+
+// 单元测试4: 右侧/左侧声源方向符号
+void test_unit_direction_sign() {
+    SceneSpec spec;
+    spec.noiseLevel = 0.0005f;
+
+    spec.angleDeg = 60;
+    SimReport right = runScene(spec, "sim_right.wav");
+    spec.angleDeg = -60;
+    SimReport left = runScene(spec, "sim_left.wav");
+
+    TEST_ASSERT_TRUE(right.directionFrames > 0);
+    TEST_ASSERT_TRUE(left.directionFrames > 0);
+    // 音量差法低估角度，但方向误差应小于真实角度本身（符号正确）
+    TEST_ASSERT_TRUE(right.meanDirectionError < 60);
+    TEST_ASSERT_TRUE(left.meanDirectionError < 60);
+}
+
+// 单元测试5: 响亮声源在一帧内触发，安静背景无误触发
+void test_unit_detection_latency() {
+    SceneSpec spec;
+    spec.noiseLevel = 0.0005f;
+    spec.sourceLevel = 0.2f;
+    spec.signal = SIGNAL_NOISE_BURST;
+
+    SimReport report = runScene(spec, "sim_latency.wav");
+    AudioPipelineSim::printReport("sim_latency.wav", report);
+
+    float frameMs = 1000.0f * CAPTURE_FRAME_SAMPLES / 16000;
+    TEST_ASSERT_TRUE(report.detectionLatencyMs >= 0);
+    TEST_ASSERT_TRUE(report.detectionLatencyMs <= frameMs);
+    TEST_ASSERT_EQUAL(0, report.falseTriggers);
+}
+
+// 单元测试6: VAD 检测到类语音信号，静音期间不误报
+void test_unit_vad() {
+    SceneSpec spec;
+    spec.noiseLevel = 0.0005f;
+    spec.durationSec = 1.5f;
+
+    SimReport report = runScene(spec, "sim_vad.wav");
+    TEST_ASSERT_TRUE(report.vadLatencyMs >= 0);
+    TEST_ASSERT_TRUE(report.vadLatencyMs < 200);
+    TEST_ASSERT_EQUAL(0, report.vadFalseFrames);
+}
+
+// 单元测试7: 阈值高于声源时不触发
+void test_unit_threshold_tuning() {
+    SceneSpec spec;
+    spec.noiseLevel = 0.0005f;
+    spec.sourceLevel = 0.01f;  // 峰值约 330
+
+    AudioAnalyzerConfig config;
+    config.triggerThreshold = 100;
+    SimReport low = runScene(spec, "sim_threshold.wav", config);
+    config.triggerThreshold = 1000;
+    SimReport high = runScene(spec, "sim_threshold.wav", config);
+
+    TEST_ASSERT_TRUE(low.detectionLatencyMs >= 0);
+    TEST_ASSERT_TRUE(high.detectionLatencyMs < 0);
+    TEST_ASSERT_EQUAL(0, high.triggeredFrames);
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 任意方向的声源，估计角度符号与真实方向一致，且触发延迟不超过两帧
+void test_property_direction_and_latency() {
+    printf("\n[Property Test] 随机声源方向 - 100次迭代\n");
+
+    float maxLatency = 2000.0f * CAPTURE_FRAME_SAMPLES / 16000;
+    double cpuNs = 0;
+
+    for (int i = 0; i < 100; i++) {
+        SceneSpec spec;
+        spec.angleDeg = testRandom(-90, 90);
+        if (fabsf(spec.angleDeg) < 10) continue;  // 中心附近符号无意义
+        spec.onsetSec = testRandom(0.1f, 0.3f);
+        spec.durationSec = 0.3f;
+        spec.totalSec = 0.8f;
+        spec.sourceLevel = testRandom(0.05f, 0.5f);
+        spec.noiseLevel = 0.0005f;
+        spec.signal = (SceneSignal)(i % 3);
+        spec.seed = i + 1;
+
+        SimReport report = runScene(spec, "sim_property.wav");
+        cpuNs += report.avgFrameNs;
+
+        if (report.detectionLatencyMs < 0 || report.detectionLatencyMs > maxLatency) {
+            char msg[120];
+            snprintf(msg, sizeof(msg), "Iter %d: angle %.1f latency %.1f ms",
+                     i, spec.angleDeg, report.detectionLatencyMs);
+            TEST_FAIL_MESSAGE(msg);
+        }
+        if (report.meanDirectionError >= fabsf(spec.angleDeg)) {
+            char msg[120];
+            snprintf(msg, sizeof(msg), "Iter %d: angle %.1f mean error %.1f (wrong side)",
+                     i, spec.angleDeg, report.meanDirectionError);
+            TEST_FAIL_MESSAGE(msg);
+        }
+        if (report.realtimeFactor < 10) {
+            TEST_FAIL_MESSAGE("仿真速度低于10倍实时");
+        }
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+
+    printf("  平均每帧处理耗时: %.0f ns\n", cpuNs / 100);
+    TEST_PASS();
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("音频链路仿真 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_wav_roundtrip);
+    RUN_TEST(test_unit_mono_source);
+    RUN_TEST(test_unit_analyzer_formula);
+    RUN_TEST(test_unit_direction_sign);
+    RUN_TEST(test_unit_detection_latency);
+    RUN_TEST(test_unit_vad);
+    RUN_TEST(test_unit_threshold_tuning);
+
+    printf("\n========================================\n");
+    printf("音频链路仿真 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_direction_and_latency);
+
+    return UNITY_END();
+}
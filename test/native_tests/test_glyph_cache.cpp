@@ -0,0 +1,557 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include "TileFlusher.h"
+#include "U8g2Font.h"
+#include "GlyphCache.h"
+
+// ========================================
+// GlyphCache 测试（主机端，native 环境）
+// U8g2 字体读取/解码、LRU 字形缓存、预渲染标签，与逐字解码绘制对比
+// 运行：python tools/run_native_tests.py test_glyph_cache
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 16180;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+// ========== 按 U8g2 格式生成测试字体 ==========
+// 主机端没有 U8g2 字库，按 u8g2_font.c 的格式生成一个与 wqy14_t_gb2312 规模相近的字体：
+// ASCII 95 个字 + 约 7000 个 14×14 汉字（随机笔画），Unicode 跳转表每块 100 个字
+
+struct TestGlyph {
+    uint8_t w, h;
+    int8_t x, y, dx;
+    std::vector<uint8_t> pixels;   // 按行，每像素一个字节
+};
+
+static std::map<uint16_t, TestGlyph> fontGlyphs;
+static std::vector<uint8_t> fontData;
+
+static const uint8_t BP0 = 4, BP1 = 4, BPW = 5, BPH = 5, BPX = 4, BPY = 4, BPDX = 6;
+
+struct BitWriter {
+    std::vector<uint8_t> bytes;
+    uint8_t bit = 0;
+
+    void put(uint32_t v, uint8_t cnt) {
+        for (uint8_t i = 0; i < cnt; i++) {
+            if (bit == 0) bytes.push_back(0);
+            if (v & (1u << i)) bytes.back() |= (uint8_t)(1 << bit);
+            bit = (bit + 1) & 7;
+        }
+    }
+    void putSigned(int v, uint8_t cnt) { put((uint32_t)(v + (1 << (cnt - 1))), cnt); }
+};
+
+static std::vector<uint8_t> encodeGlyph(const TestGlyph& g) {
+    BitWriter w;
+    w.put(g.w, BPW);
+    w.put(g.h, BPH);
+    w.putSigned(g.x, BPX);
+    w.putSigned(g.y, BPY);
+    w.putSigned(g.dx, BPDX);
+    if (g.w > 0) {
+        const size_t n = g.pixels.size();
+        size_t i = 0;
+        const uint32_t max0 = (1u << BP0) - 1, max1 = (1u << BP1) - 1;
+        while (i < n) {
+            uint32_t a = 0, b = 0;
+            while (i < n && !g.pixels[i] && a < max0) { a++; i++; }
+            if (a == max0 && i < n && !g.pixels[i]) {
+                w.put(a, BP0); w.put(0, BP1); w.put(0, 1);
+                continue;
+            }
+            while (i < n && g.pixels[i] && b < max1) { b++; i++; }
+            w.put(a, BP0); w.put(b, BP1); w.put(0, 1);
+        }
+    }
+    // 补一个字节，解码器按 U8g2 方式可能预读下一字节
+    w.bytes.push_back(0);
+    return w.bytes;
+}
+
+static TestGlyph randomCjkGlyph() {
+    TestGlyph g = {14, 14, 0, -2, 14, std::vector<uint8_t>(14 * 14, 0)};
+    int strokes = testRandomInt(6, 11);
+    for (int s = 0; s < strokes; s++) {
+        int len = testRandomInt(4, 13);
+        int a = testRandomInt(0, 13), b = testRandomInt(0, 14 - len);
+        for (int k = 0; k < len; k++) {
+            if (s & 1) g.pixels[(b + k) * 14 + a] = 1;   // 竖
+            else g.pixels[a * 14 + b + k] = 1;            // 横
+        }
+    }
+    return g;
+}
+
+static TestGlyph randomAsciiGlyph(uint16_t e) {
+    if (e == ' ') return TestGlyph{0, 0, 0, 0, 7, {}};
+    TestGlyph g = {6, 10, 0, 0, 7, std::vector<uint8_t>(60, 0)};
+    for (auto& p : g.pixels) p = (uint8_t)(testRandomInt(0, 2) == 0);
+    if (e == 'g' || e == 'y') g.y = -3;
+    return g;
+}
+
+static void putWord(std::vector<uint8_t>& v, size_t pos, uint16_t w) {
+    v[pos] = (uint8_t)(w >> 8);
+    v[pos + 1] = (uint8_t)w;
+}
+
+static void buildFont() {
+    if (!fontData.empty()) return;
+
+    for (uint16_t e = 32; e < 127; e++) fontGlyphs[e] = randomAsciiGlyph(e);
+    fontGlyphs[0xB0] = randomAsciiGlyph(0xB0);   // °
+
+    // 界面上用到的字一定在字库中，其余随机取约 7000 个
+    const char* used = "你好世界终端中文测试显示正常系统状态运行内存温度主菜单开始对话设置关于待机已连接"
+                       "加载完成音量时钟欢迎使用智能教育仪表盘初始化";
+    const char* p = used;
+    uint16_t e;
+    while ((e = utf8Next(p)) != 0) fontGlyphs[e] = randomCjkGlyph();
+    for (uint32_t c = 0x4E00; c <= 0x9FA5; c++) {
+        if (testRandomInt(0, 2) == 0 && !fontGlyphs.count((uint16_t)c)) fontGlyphs[(uint16_t)c] = randomCjkGlyph();
+    }
+    // 一个超过缓存槽位的大字形（20×20）
+    TestGlyph big = {20, 20, 0, 0, 21, std::vector<uint8_t>(400, 0)};
+    for (int i = 0; i < 400; i += 3) big.pixels[i] = 1;
+    fontGlyphs[0xE000] = big;
+
+    std::vector<uint8_t>& f = fontData;
+    f.assign(U8G2_FONT_HEADER_SIZE, 0);
+    f[0] = (uint8_t)fontGlyphs.size();
+    f[2] = BP0; f[3] = BP1; f[4] = BPW; f[5] = BPH; f[6] = BPX; f[7] = BPY; f[8] = BPDX;
+    f[9] = 20; f[10] = 20; f[13] = 12; f[14] = (uint8_t)-2;
+
+    // ASCII 段
+    uint16_t upperA = 0, lowerA = 0;
+    bool haveUpper = false, haveLower = false;
+    for (auto& kv : fontGlyphs) {
+        if (kv.first > 255) break;
+        size_t off = f.size() - U8G2_FONT_HEADER_SIZE;
+        if (!haveUpper && kv.first >= 'A') { upperA = (uint16_t)off; haveUpper = true; }
+        if (!haveLower && kv.first >= 'a') { lowerA = (uint16_t)off; haveLower = true; }
+        std::vector<uint8_t> data = encodeGlyph(kv.second);
+        f.push_back((uint8_t)kv.first);
+        f.push_back((uint8_t)(data.size() + 2));
+        f.insert(f.end(), data.begin(), data.end());
+    }
+    f.push_back(0);
+    f.push_back(0);
+    uint16_t unicodeStart = (uint16_t)(f.size() - U8G2_FONT_HEADER_SIZE);
+
+    // Unicode 段：先生成各块，再写跳转表
+    std::vector<std::vector<uint8_t>> blocks;
+    std::vector<uint16_t> lastInBlock;
+    std::vector<uint8_t> cur;
+    int inBlock = 0;
+    uint16_t last = 0;
+    for (auto& kv : fontGlyphs) {
+        if (kv.first <= 255) continue;
+        std::vector<uint8_t> data = encodeGlyph(kv.second);
+        cur.push_back((uint8_t)(kv.first >> 8));
+        cur.push_back((uint8_t)kv.first);
+        cur.push_back((uint8_t)(data.size() + 3));
+        cur.insert(cur.end(), data.begin(), data.end());
+        last = kv.first;
+        if (++inBlock == 100) {
+            blocks.push_back(cur); lastInBlock.push_back(last);
+            cur.clear(); inBlock = 0;
+        }
+    }
+    if (!cur.empty()) { blocks.push_back(cur); lastInBlock.push_back(last); }
+    lastInBlock.back() = 0xFFFF;
+
+    size_t tableStart = f.size();
+    f.resize(tableStart + blocks.size() * 4, 0);
+    for (size_t b = 0; b < blocks.size(); b++) {
+        uint16_t off = (uint16_t)(b == 0 ? blocks.size() * 4 : blocks[b - 1].size());
+        putWord(f, tableStart + b * 4, off);
+        putWord(f, tableStart + b * 4 + 2, lastInBlock[b]);
+    }
+    for (auto& blk : blocks) f.insert(f.end(), blk.begin(), blk.end());
+    f.push_back(0);
+    f.push_back(0);
+
+    putWord(f, 17, upperA);
+    putWord(f, 19, lowerA);
+    putWord(f, 21, unicodeStart);
+}
+
+static const uint8_t* testFont() {
+    buildFont();
+    return fontData.data();
+}
+
+// 参考绘制：直接按原始像素画（与编码无关）
+static void referenceDraw(uint8_t* buf, int x, int y, const char* s) {
+    uint16_t e;
+    while ((e = utf8Next(s)) != 0) {
+        auto it = fontGlyphs.find(e);
+        if (it == fontGlyphs.end()) continue;
+        const TestGlyph& g = it->second;
+        int left = x + g.x, top = y - g.h - g.y;
+        for (int r = 0; r < g.h; r++) {
+            for (int c = 0; c < g.w; c++) {
+                int px = left + c, py = top + r;
+                if (g.pixels[r * g.w + c] && px >= 0 && px < DISPLAY_WIDTH && py >= 0 && py < DISPLAY_HEIGHT) {
+                    buf[(py / 8) * DISPLAY_WIDTH + px] |= (uint8_t)(1 << (py % 8));
+                }
+            }
+        }
+        x += g.dx;
+    }
+}
+
+// 与 tools/make_glyph_labels.py 相同的预渲染：整串画到大画布，取包围盒
+struct LabelStore {
+    std::vector<std::string> texts;
+    std::vector<std::vector<uint16_t>> columns;
+    std::vector<GlyphLabel> labels;
+};
+
+static void addLabel(LabelStore& store, const char* text) {
+    // 基线 y=40、x=0 画到一个临时缓冲，再取出包围盒
+    static uint8_t canvas[DISPLAY_BUFFER_SIZE];
+    memset(canvas, 0, sizeof(canvas));
+    int16_t advance = u8g2FontDrawUTF8(canvas, testFont(), 0, 40, text);
+    int x0 = 999, y0 = 999, x1 = -1, y1 = -1;
+    for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+        for (int x = 0; x < DISPLAY_WIDTH; x++) {
+            if (canvas[(y / 8) * DISPLAY_WIDTH + x] & (1 << (y % 8))) {
+                if (x < x0) x0 = x;
+                if (x > x1) x1 = x;
+                if (y < y0) y0 = y;
+                if (y > y1) y1 = y;
+            }
+        }
+    }
+    TEST_ASSERT_TRUE(y1 - y0 < GLYPH_COLUMN_BITS);
+    std::vector<uint16_t> columns(x1 - x0 + 1, 0);
+    for (int y = y0; y <= y1; y++)
+        for (int x = x0; x <= x1; x++)
+            if (canvas[(y / 8) * DISPLAY_WIDTH + x] & (1 << (y % 8)))
+                columns[x - x0] |= (uint16_t)(1u << (y - y0));
+    store.texts.push_back(text);
+    store.columns.push_back(columns);
+    store.labels.push_back(GlyphLabel{nullptr, advance, (int8_t)x0, (int8_t)(40 - y0), (uint8_t)columns.size(), nullptr});
+}
+
+static void finishLabels(LabelStore& store) {
+    for (size_t i = 0; i < store.labels.size(); i++) {
+        store.labels[i].text = store.texts[i].c_str();
+        store.labels[i].columns = store.columns[i].data();
+    }
+}
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: 所有字都能按 U8g2 的查找过程找到，解码结果与原始像素一致
+void test_unit_find_and_decode_all() {
+    const uint8_t* font = testFont();
+    U8g2FontInfo info;
+    u8g2FontReadInfo(font, info);
+    TEST_ASSERT_EQUAL(4, info.bitsPer0);
+    TEST_ASSERT_EQUAL(6, info.bitsPerDeltaX);
+
+    static uint8_t bits[GLYPH_SCRATCH_BYTES];
+    int checked = 0;
+    for (auto& kv : fontGlyphs) {
+        const uint8_t* data = u8g2FontFindGlyph(font, info, kv.first);
+        TEST_ASSERT_NOT_NULL(data);
+        GlyphBitmap g;
+        u8g2FontDecodeGlyph(info, data, kv.first, g, bits, sizeof(bits));
+        const TestGlyph& t = kv.second;
+        TEST_ASSERT_EQUAL(t.w, g.width);
+        TEST_ASSERT_EQUAL(t.h, g.height);
+        TEST_ASSERT_EQUAL(t.y, g.yOffset);
+        TEST_ASSERT_EQUAL(t.dx, g.advance);
+        for (int r = 0; r < t.h; r++)
+            for (int c = 0; c < t.w; c++) {
+                bool on = (bits[r * g.rowBytes() + c / 8] >> (7 - c % 8)) & 1;
+                if (on != (t.pixels[r * t.w + c] != 0)) TEST_FAIL_MESSAGE("解码像素不一致");
+            }
+        checked++;
+    }
+    printf("  测试字库: %d 个字，%u 字节\n", checked, (unsigned)fontData.size());
+
+    TEST_ASSERT_NULL(u8g2FontFindGlyph(font, info, 0x9FFF));   // 不在字库中
+    TEST_ASSERT_NULL(u8g2FontFindGlyph(font, info, 0x01));
+}
+
+// 单元测试2: UTF-8 解码（ASCII、两字节、三字节、非法字节）
+void test_unit_utf8() {
+    const char* s = "A\xC2\xB0\xE4\xBD\xA0\xFF" "B";
+    TEST_ASSERT_EQUAL(0x41, utf8Next(s));
+    TEST_ASSERT_EQUAL(0xB0, utf8Next(s));
+    TEST_ASSERT_EQUAL(0x4F60, utf8Next(s));   // 你
+    TEST_ASSERT_EQUAL(0xFFFF, utf8Next(s));
+    TEST_ASSERT_EQUAL(0x42, utf8Next(s));
+    TEST_ASSERT_EQUAL(0, utf8Next(s));
+}
+
+// 单元测试3: 缓存绘制与逐字解码绘制、参考像素逐像素相同（含屏幕边缘裁剪、° 等 Latin-1 字符）
+void test_unit_cached_matches_direct() {
+    GlyphCache cache(testFont());
+    static uint8_t a[DISPLAY_BUFFER_SIZE], b[DISPLAY_BUFFER_SIZE], ref[DISPLAY_BUFFER_SIZE];
+    const char* lines[] = {"系统状态", "温度:42°C", "运行:00:05:23", "欢迎使用MOSS智能教育终端", "gy"};
+    const int pos[][2] = {{30, 13}, {5, 61}, {-20, 31}, {60, 35}, {120, 66}};
+
+    for (int pass = 0; pass < 2; pass++) {   // 第一遍全部未命中，第二遍全部命中
+        memset(a, 0, sizeof(a));
+        memset(b, 0, sizeof(b));
+        memset(ref, 0, sizeof(ref));
+        for (int i = 0; i < 5; i++) {
+            int16_t wa = cache.drawUTF8(a, pos[i][0], pos[i][1], lines[i]);
+            int16_t wb = u8g2FontDrawUTF8(b, testFont(), pos[i][0], pos[i][1], lines[i]);
+            TEST_ASSERT_EQUAL(wb, wa);
+            referenceDraw(ref, pos[i][0], pos[i][1], lines[i]);
+        }
+        TEST_ASSERT_EQUAL_MEMORY(ref, b, DISPLAY_BUFFER_SIZE);
+        TEST_ASSERT_EQUAL_MEMORY(ref, a, DISPLAY_BUFFER_SIZE);
+    }
+    TEST_ASSERT_TRUE(cache.stats().hits > 0);
+    TEST_ASSERT_EQUAL(cache.stats().misses, cache.size());
+}
+
+// 单元测试4: 满了按 LRU 淘汰最久未用的字
+void test_unit_lru_eviction() {
+    GlyphCache cache(testFont());
+    std::vector<uint16_t> codes;
+    for (auto& kv : fontGlyphs) {
+        if (kv.first > 255 && kv.first < 0xE000) codes.push_back(kv.first);
+        if (codes.size() == GLYPH_CACHE_SLOTS + 1) break;
+    }
+
+    for (int i = 0; i < GLYPH_CACHE_SLOTS; i++) cache.get(codes[i]);
+    TEST_ASSERT_EQUAL(GLYPH_CACHE_SLOTS, cache.size());
+    cache.get(codes[0]);                       // codes[0] 变为最近使用，codes[1] 最久未用
+    cache.get(codes[GLYPH_CACHE_SLOTS]);       // 淘汰 codes[1]
+    TEST_ASSERT_EQUAL(1, cache.stats().evictions);
+
+    cache.resetStats();
+    cache.get(codes[0]);
+    TEST_ASSERT_EQUAL(1, cache.stats().hits);
+    cache.get(codes[1]);
+    TEST_ASSERT_EQUAL(1, cache.stats().misses);
+    for (int i = 3; i < GLYPH_CACHE_SLOTS; i++) cache.get(codes[i]);
+    TEST_ASSERT_EQUAL(GLYPH_CACHE_SLOTS - 2, cache.stats().hits);
+}
+
+// 单元测试5: 超过槽位大小的字形不缓存但正确绘制；字库中没有的字跳过
+void test_unit_uncached_and_missing() {
+    GlyphCache cache(testFont());
+    static uint8_t a[DISPLAY_BUFFER_SIZE], ref[DISPLAY_BUFFER_SIZE];
+    memset(a, 0, sizeof(a));
+    memset(ref, 0, sizeof(ref));
+
+    const char* s = "\xEE\x80\x80\xEF\xBF\xBD" "A";   // U+E000（20×20）、U+FFFD（不在字库）、A
+    cache.drawUTF8(a, 10, 30, s);
+    referenceDraw(ref, 10, 30, s);
+    TEST_ASSERT_EQUAL_MEMORY(ref, a, DISPLAY_BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(1, cache.stats().uncached);
+    TEST_ASSERT_EQUAL(1, cache.stats().missing);
+    TEST_ASSERT_EQUAL(1, cache.size());
+}
+
+// 单元测试6: 预渲染标签与 drawUTF8 结果相同，查找按完整字符串匹配
+void test_unit_prerendered_labels() {
+    LabelStore store;
+    addLabel(store, "系统状态");
+    addLabel(store, "温度:42°C");
+    addLabel(store, "gy");
+    finishLabels(store);
+
+    GlyphCache cache(testFont());
+    static uint8_t a[DISPLAY_BUFFER_SIZE], b[DISPLAY_BUFFER_SIZE];
+    for (size_t i = 0; i < store.labels.size(); i++) {
+        memset(a, 0, sizeof(a));
+        memset(b, 0, sizeof(b));
+        const GlyphLabel* label = glyphLabelFind(store.labels.data(), store.labels.size(), store.texts[i].c_str());
+        TEST_ASSERT_NOT_NULL(label);
+        int16_t wa = glyphLabelDraw(a, 7, 20, *label);
+        int16_t wb = cache.drawUTF8(b, 7, 20, store.texts[i].c_str());
+        TEST_ASSERT_EQUAL(wb, wa);
+        TEST_ASSERT_EQUAL_MEMORY(b, a, DISPLAY_BUFFER_SIZE);
+    }
+    TEST_ASSERT_NULL(glyphLabelFind(store.labels.data(), store.labels.size(), "系统"));
+}
+
+// 单元测试7: renderColumns() 的 16 行列位图与 drawUTF8 画出的对应行相同（含超大字形裁剪）；
+// 超出容量时只写入、只返回 capacity 列
+void test_unit_render_columns() {
+    GlyphCache cache(testFont());
+    const char* s = "温度:42°C gy\xEE\x80\x80";
+    static uint16_t columns[200];
+    static uint8_t buf[DISPLAY_BUFFER_SIZE];
+    memset(buf, 0, sizeof(buf));
+
+    uint16_t width = cache.renderColumns(s, 12, columns, 200);
+    int16_t drawn = cache.drawUTF8(buf, 0, 16 + 12, s);   // 字幕区为屏幕第 16~31 行
+    TEST_ASSERT_EQUAL(drawn, width);
+    for (int x = 0; x < DISPLAY_WIDTH; x++) {
+        uint16_t expect = (uint16_t)(buf[2 * DISPLAY_WIDTH + x] | (buf[3 * DISPLAY_WIDTH + x] << 8));
+        TEST_ASSERT_EQUAL_HEX32(expect, columns[x]);
+    }
+
+    static uint16_t small[10];
+    TEST_ASSERT_EQUAL(10, cache.renderColumns(s, 12, small, 10));   // 只返回写入的列数
+    TEST_ASSERT_EQUAL_MEMORY(columns, small, sizeof(small));
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 随机字符串（超过缓存容量的字集，反复出现一部分）、随机位置：
+// - 缓存绘制与参考像素完全一致，步进宽度相同
+// - 缓存内字数不超过槽位数，命中 + 未命中 = 查询次数
+void test_property_random_text() {
+    printf("\n[Property Test] 随机文字/位置下缓存绘制与参考一致 - 100次迭代\n");
+
+    std::vector<uint16_t> pool;
+    for (auto& kv : fontGlyphs) pool.push_back(kv.first);
+
+    GlyphCache cache(testFont());
+    uint32_t lookups = 0;
+    for (int i = 0; i < 100; i++) {
+        static uint8_t a[DISPLAY_BUFFER_SIZE], ref[DISPLAY_BUFFER_SIZE];
+        memset(a, 0, sizeof(a));
+        memset(ref, 0, sizeof(ref));
+
+        for (int line = 0; line < 4; line++) {
+            std::string s;
+            int n = testRandomInt(1, 10);
+            for (int k = 0; k < n; k++) {
+                // 一半来自 40 个常用字，一半来自整个字库
+                uint16_t c = testRandomInt(0, 1) ? pool[100 + testRandomInt(0, 39)]
+                                                 : pool[testRandomInt(0, (int)pool.size() - 1)];
+                if (c < 0x80) s += (char)c;
+                else if (c < 0x800) { s += (char)(0xC0 | (c >> 6)); s += (char)(0x80 | (c & 0x3F)); }
+                else { s += (char)(0xE0 | (c >> 12)); s += (char)(0x80 | ((c >> 6) & 0x3F)); s += (char)(0x80 | (c & 0x3F)); }
+                lookups++;
+            }
+            int x = testRandomInt(-30, 127), y = testRandomInt(0, 80);
+            referenceDraw(ref, x, y, s.c_str());
+            cache.drawUTF8(a, x, y, s.c_str());
+        }
+
+        if (memcmp(a, ref, DISPLAY_BUFFER_SIZE) != 0) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "Iter %d: 缓存绘制与参考不一致", i);
+            TEST_FAIL_MESSAGE(msg);
+        }
+        if (cache.size() > GLYPH_CACHE_SLOTS) TEST_FAIL_MESSAGE("缓存字数超过槽位数");
+        if (cache.stats().hits + cache.stats().misses != lookups) TEST_FAIL_MESSAGE("命中计数不守恒");
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+    printf("  命中 %u，未命中 %u，淘汰 %u\n", cache.stats().hits, cache.stats().misses, cache.stats().evictions);
+
+    TEST_PASS();
+}
+
+// ========================================
+// 性能测试
+// ========================================
+
+// test_oled_display.cpp 的系统状态 + 仪表盘界面
+static const char* SCREEN_TEXT[] = {"系统状态", "运行:00:05:23", "内存:45%", "温度:42°C",
+                                    "仪表盘", "CPU:45%", "内存:67%", "温度:42°C"};
+static const int SCREEN_POS[][2] = {{30, 13}, {5, 31}, {5, 47}, {5, 61}, {30, 13}, {5, 31}, {5, 47}, {5, 61}};
+
+// 性能1: 每帧绘制整屏中文：逐字查找解码（U8g2 drawUTF8 的工作量）vs 缓存命中 vs 预渲染标签
+void test_benchmark_draw_cost() {
+    printf("\n[Benchmark] 每帧绘制中文界面：逐字解码 vs 字形缓存 vs 预渲染标签\n");
+
+    const int FRAMES = 5000;
+    static uint8_t buf[DISPLAY_BUFFER_SIZE];
+    const uint8_t* font = testFont();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < FRAMES; f++) {
+        memset(buf, 0, sizeof(buf));
+        for (int i = 0; i < 8; i++) u8g2FontDrawUTF8(buf, font, SCREEN_POS[i][0], SCREEN_POS[i][1], SCREEN_TEXT[i]);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double directUs = std::chrono::duration<double, std::micro>(end - start).count() / FRAMES;
+
+    GlyphCache cache(font);
+    start = std::chrono::steady_clock::now();
+    for (int f = 0; f < FRAMES; f++) {
+        memset(buf, 0, sizeof(buf));
+        for (int i = 0; i < 8; i++) cache.drawUTF8(buf, SCREEN_POS[i][0], SCREEN_POS[i][1], SCREEN_TEXT[i]);
+    }
+    end = std::chrono::steady_clock::now();
+    double cachedUs = std::chrono::duration<double, std::micro>(end - start).count() / FRAMES;
+
+    LabelStore store;
+    for (int i = 0; i < 8; i++) addLabel(store, SCREEN_TEXT[i]);
+    finishLabels(store);
+    start = std::chrono::steady_clock::now();
+    for (int f = 0; f < FRAMES; f++) {
+        memset(buf, 0, sizeof(buf));
+        for (int i = 0; i < 8; i++) {
+            const GlyphLabel* l = glyphLabelFind(store.labels.data(), store.labels.size(), SCREEN_TEXT[i]);
+            glyphLabelDraw(buf, SCREEN_POS[i][0], SCREEN_POS[i][1], *l);
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    double labelUs = std::chrono::duration<double, std::micro>(end - start).count() / FRAMES;
+
+    printf("  逐字查找 + 解码: %.2f us/帧\n", directUs);
+    printf("  字形缓存（命中）: %.2f us/帧（%.1fx），命中率 %.1f%%\n", cachedUs, directUs / cachedUs,
+           100.0 * cache.stats().hits / (cache.stats().hits + cache.stats().misses));
+    printf("  预渲染标签: %.2f us/帧（%.1fx）\n", labelUs, directUs / labelUs);
+    printf("  缓存占用: %u 字节\n", (unsigned)sizeof(GlyphCache));
+
+    TEST_ASSERT_TRUE(cachedUs < directUs);
+    TEST_ASSERT_TRUE(labelUs < directUs);
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("GlyphCache 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_find_and_decode_all);
+    RUN_TEST(test_unit_utf8);
+    RUN_TEST(test_unit_cached_matches_direct);
+    RUN_TEST(test_unit_lru_eviction);
+    RUN_TEST(test_unit_uncached_and_missing);
+    RUN_TEST(test_unit_prerendered_labels);
+    RUN_TEST(test_unit_render_columns);
+
+    printf("\n========================================\n");
+    printf("GlyphCache 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_random_text);
+
+    printf("\n========================================\n");
+    printf("GlyphCache 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_draw_cost);
+
+    return UNITY_END();
+}
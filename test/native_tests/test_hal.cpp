@@ -0,0 +1,410 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include "Hal.h"
+#include "HostHal.h"
+#include "TaskScheduler.h"
+#include "AudioAnalyzer.h"
+#include "AudioSim.h"
+
+// ========================================
+// Hal 测试（主机端，native 环境）
+// 舵机脉宽换算、时钟、串口格式化和脚本输入、只经 Hal 访问硬件的联动逻辑在主机后端上全速运行
+// 运行：python tools/run_native_tests.py test_hal
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 48721;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+// Arduino map()（ESP32Servo 的 write(angle) 用它换算脉宽）
+static long arduinoMap(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ========== 只经 Hal 访问硬件的联动逻辑（与综合测试相同的行为，缩减版） ==========
+
+// 采集一帧 → 越过阈值时转向声源；舵机每 5ms 走 1°；灯效随状态；串口命令 c（回中）、s（状态）
+struct HeadDemo {
+    Hal& hal;
+    TaskScheduler tasks;
+    AudioAnalyzer analyzer;
+    int32_t frame[CAPTURE_FRAME_SAMPLES * CAPTURE_CHANNELS];
+    int angle;
+    int target;
+    bool triggered;
+    uint32_t frames;
+    uint32_t triggers;
+    bool micDone;
+
+    explicit HeadDemo(Hal& h)
+        : hal(h), tasks(h.clock), analyzer(demoConfig()), angle(90), target(90), triggered(false), frames(0),
+          triggers(0), micDone(false) {}
+
+    static AudioAnalyzerConfig demoConfig() {
+        AudioAnalyzerConfig config;
+        config.triggerThreshold = 1000;   // 合成声场的声源峰值约 3300，背景噪声约 100
+        return config;
+    }
+
+    static void captureTask(void* arg, uint32_t) {
+        HeadDemo* d = (HeadDemo*)arg;
+        size_t n = d->hal.microphone.readFrame(d->frame, CAPTURE_FRAME_SAMPLES);
+        if (n == 0) {
+            d->micDone = true;
+            return;
+        }
+        AudioFrameStats st = d->analyzer.process(d->frame, n);
+        d->frames++;
+        if (st.triggered && !d->triggered) {
+            d->triggers++;
+            d->target = 90 + (int)st.direction;
+            d->target = d->target < 30 ? 30 : (d->target > 150 ? 150 : d->target);
+            d->hal.serial.printf("[LOCATE] %lu 转向 H=%d°\n", (unsigned long)d->hal.clock.nowMs(), d->target);
+        }
+        d->triggered = st.triggered;
+    }
+
+    static void servoTask(void* arg, uint32_t) {
+        HeadDemo* d = (HeadDemo*)arg;
+        if (d->angle != d->target) {
+            d->angle += d->angle < d->target ? 1 : -1;
+            d->hal.servoH.write(d->angle);
+        }
+    }
+
+    static void ledTask(void* arg, uint32_t) {
+        HeadDemo* d = (HeadDemo*)arg;
+        uint32_t color = d->triggered ? ledColor(255, 120, 0) : ledColor(0, 0, 80);
+        for (uint16_t i = 0; i < d->hal.leds.numPixels(); i++) {
+            d->hal.leds.setPixelColor(i, color);
+        }
+        d->hal.leds.show();
+    }
+
+    static void serialTask(void* arg, uint32_t) {
+        HeadDemo* d = (HeadDemo*)arg;
+        int c = d->hal.serial.read();
+        if (c == 'c') {
+            d->target = 90;
+            d->hal.serial.println("[CMD] 回到中心位置");
+        } else if (c == 's') {
+            d->hal.serial.printf("[CMD] H=%d° 目标 %d° 帧 %lu\n", d->angle, d->target, (unsigned long)d->frames);
+        }
+    }
+
+    void begin() {
+        hal.servoH.attach(4);
+        hal.servoV.attach(5);
+        hal.servoH.write(angle);
+        hal.servoV.write(90);
+        uint32_t framePeriodUs = CAPTURE_FRAME_SAMPLES * 1000000UL / hal.microphone.sampleRate();
+        tasks.addPeriodic("capture", captureTask, this, framePeriodUs, 2);
+        tasks.addPeriodic("servo", servoTask, this, 5000, 3);
+        tasks.addPeriodic("led", ledTask, this, 16667, 1);
+        tasks.addPeriodic("serial", serialTask, this, 20000, 0);
+    }
+
+    // 运行到麦克风数据结束；返回空闲时间由时钟“睡眠”
+    void run() {
+        while (!micDone) {
+            uint32_t idle = tasks.runReady();
+            hal.clock.sleepUs(idle);
+        }
+    }
+};
+
+static const char* makeScene(float angleDeg, float totalSec) {
+    static char path[64];
+    snprintf(path, sizeof(path), "hal_scene_%d.wav", (int)angleDeg);
+    SceneSpec spec;
+    spec.angleDeg = angleDeg;
+    spec.onsetSec = 1.0f;
+    spec.durationSec = 0.5f;
+    spec.totalSec = totalSec;
+    spec.signal = SIGNAL_TONE;
+    synthesizeScene(spec, path);
+    return path;
+}
+
+// ========== 单元测试 ==========
+
+// 单元测试1: 舵机角度换算与 ESP32Servo 相同（含限幅和自定义脉宽范围）；记录脉宽和时刻；写 CSV
+void test_unit_servo() {
+    VirtualClock clock(1000);
+    RecordingServo servo(&clock);
+    TEST_ASSERT_EQUAL(-1, servo.pin);
+    TEST_ASSERT_FALSE(servo.attach(4, 2000, 1000));
+    TEST_ASSERT_TRUE(servo.attach(4));
+    TEST_ASSERT_EQUAL(4, servo.pin);
+
+    servo.write(0);
+    TEST_ASSERT_EQUAL(500, servo.lastPulse());
+    clock.advance(20000);
+    servo.write(90);
+    TEST_ASSERT_EQUAL(1500, servo.lastPulse());
+    servo.write(180);
+    TEST_ASSERT_EQUAL(2500, servo.lastPulse());
+    servo.write(-20);
+    TEST_ASSERT_EQUAL(500, servo.lastPulse());
+    TEST_ASSERT_EQUAL(0, servo.read());
+    servo.write(200);
+    TEST_ASSERT_EQUAL(2500, servo.lastPulse());
+    TEST_ASSERT_EQUAL(180, servo.read());
+    servo.writeMicroseconds(1234);
+    TEST_ASSERT_EQUAL(1234, servo.lastPulse());
+
+    TEST_ASSERT_EQUAL(6, servo.samples.size());
+    TEST_ASSERT_EQUAL(1000, servo.samples[0].timeUs);
+    TEST_ASSERT_EQUAL(21000, servo.samples[1].timeUs);
+
+    RecordingServo narrow;
+    TEST_ASSERT_TRUE(narrow.attach(5, 1000, 2000));
+    narrow.write(45);
+    TEST_ASSERT_EQUAL(arduinoMap(45, 0, 180, 1000, 2000), narrow.lastPulse());
+    TEST_ASSERT_EQUAL(0, narrow.samples[0].timeUs);   // 没有时钟
+
+    TEST_ASSERT_TRUE(servo.writeCsv("hal_servo.csv"));
+    FILE* f = fopen("hal_servo.csv", "r");
+    TEST_ASSERT_NOT_NULL(f);
+    char line[64];
+    TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), f));
+    TEST_ASSERT_EQUAL_STRING("time_us,pulse_us,angle\n", line);
+    TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), f));
+    TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), f));
+    TEST_ASSERT_EQUAL_STRING("21000,1500,90.0\n", line);
+    fclose(f);
+    remove("hal_servo.csv");
+}
+
+// 单元测试2: 时钟：VirtualClock 作为 HalClock 时 sleepUs() 只前进时间；SteadyClock 真的等待且单调
+void test_unit_clocks() {
+    VirtualClock virtualClock(0);
+    HalClock& clock = virtualClock;
+    clock.sleepUs(2500);
+    TEST_ASSERT_EQUAL(2500, clock.nowUs());
+    TEST_ASSERT_EQUAL(2, clock.nowMs());
+    clock.sleepUs(1000000);
+    TEST_ASSERT_EQUAL(1002, clock.nowMs());
+
+    SteadyClock steady;
+    uint32_t t0 = steady.nowUs();
+    uint32_t m0 = steady.nowMs();
+    steady.sleepUs(3000);
+    uint32_t elapsed = steady.nowUs() - t0;
+    TEST_ASSERT_TRUE(elapsed >= 3000);
+    TEST_ASSERT_TRUE(elapsed < 500000);
+    TEST_ASSERT_TRUE(steady.nowMs() - m0 >= 3);
+}
+
+// 单元测试3: 串口：print/println/printf（超长截断）、脚本输入按顺序读出、输入输出文件
+void test_unit_serial() {
+    FileSerial serial(nullptr);
+    serial.capture = true;
+    TEST_ASSERT_EQUAL(5, serial.print("hello"));
+    TEST_ASSERT_EQUAL(2, serial.println());
+    TEST_ASSERT_EQUAL(6, serial.println("abcd"));
+    serial.printf("%d-%s-%.1f", 42, "x", 1.5);
+    TEST_ASSERT_EQUAL_STRING("hello\r\nabcd\r\n42-x-1.5", serial.captured.c_str());
+
+    serial.captured.clear();
+    std::string longText(400, 'a');
+    size_t n = serial.printf("%s", longText.c_str());
+    TEST_ASSERT_EQUAL(HAL_SERIAL_PRINTF_MAX - 1, n);
+    TEST_ASSERT_EQUAL(HAL_SERIAL_PRINTF_MAX - 1, serial.captured.size());
+
+    TEST_ASSERT_EQUAL(0, serial.available());
+    TEST_ASSERT_EQUAL(-1, serial.read());
+    serial.feed("1c");
+    serial.feed("\xff");
+    TEST_ASSERT_EQUAL(3, serial.available());
+    TEST_ASSERT_EQUAL('1', serial.read());
+    TEST_ASSERT_EQUAL('c', serial.read());
+    TEST_ASSERT_EQUAL(0xFF, serial.read());
+    TEST_ASSERT_EQUAL(-1, serial.read());
+
+    FILE* f = fopen("hal_input.txt", "wb");
+    fputs("s\n", f);
+    fclose(f);
+    TEST_ASSERT_TRUE(serial.openInput("hal_input.txt"));
+    TEST_ASSERT_FALSE(serial.openInput("hal_missing/input.txt"));
+    remove("hal_input.txt");
+    TEST_ASSERT_EQUAL('s', serial.read());
+    TEST_ASSERT_EQUAL('\n', serial.read());
+
+    {
+        FileSerial out(nullptr);
+        TEST_ASSERT_TRUE(out.openOutput("hal_output.bin"));
+        const uint8_t bytes[] = {0x00, 0x41, 0xFF, 0x0A};
+        TEST_ASSERT_EQUAL(4, out.write(bytes, sizeof(bytes)));
+        out.print("ok");
+    }
+    f = fopen("hal_output.bin", "rb");
+    uint8_t back[8];
+    TEST_ASSERT_EQUAL(6, fread(back, 1, sizeof(back), f));
+    fclose(f);
+    remove("hal_output.bin");
+    TEST_ASSERT_EQUAL(0x00, back[0]);
+    TEST_ASSERT_EQUAL(0xFF, back[2]);
+    TEST_ASSERT_EQUAL('k', back[5]);
+}
+
+// 单元测试4: 联动逻辑只经 Hal 访问硬件，在主机后端上运行：WAV 声源在右侧 40°，
+// 舵机转向声源（按音量差估计的方向，偏向右侧）、灯效随状态变化、串口命令回中并打印状态
+void test_unit_host_hal_demo() {
+    HostHal host;
+    TEST_ASSERT_TRUE(host.microphone.open(makeScene(40, 3.0f)));
+    host.serial.setOutput(nullptr);
+    host.serial.capture = true;
+    Hal hal = host.hal();
+    TEST_ASSERT_EQUAL(5, hal.leds.numPixels());
+
+    HeadDemo demo(hal);
+    demo.begin();
+    demo.run();
+
+    printf("  %lu 帧，触发 %lu 次，舵机输出 %lu 次，LED %lu 帧，虚拟时间 %lu ms\n", (unsigned long)demo.frames,
+           (unsigned long)demo.triggers, (unsigned long)host.servoH.samples.size(),
+           (unsigned long)host.ledTransport.frames.size(), (unsigned long)host.clock.nowMs());
+    TEST_ASSERT_EQUAL(4, host.servoH.pin);
+    TEST_ASSERT_EQUAL(5, host.servoV.pin);
+    TEST_ASSERT_TRUE(demo.frames >= 90);
+    TEST_ASSERT_EQUAL(1, demo.triggers);
+    TEST_ASSERT_TRUE(demo.target > 100);
+    TEST_ASSERT_EQUAL(demo.target, demo.angle);
+    TEST_ASSERT_EQUAL(HalServo::pulseForAngle(demo.angle, HAL_SERVO_MIN_US, HAL_SERVO_MAX_US),
+                      host.servoH.lastPulse());
+    // 转动时每 5ms 一步
+    const std::vector<ServoSample>& s = host.servoH.samples;
+    TEST_ASSERT_EQUAL(5000, s[s.size() - 1].timeUs - s[s.size() - 2].timeUs);
+    TEST_ASSERT_TRUE(host.clock.nowMs() >= 2900);
+    TEST_ASSERT_TRUE(host.ledTransport.frames.size() >= 170);
+    TEST_ASSERT_NOT_NULL(strstr(host.serial.captured.c_str(), "[LOCATE]"));
+
+    // 串口命令：回中后再打印状态
+    host.serial.feed("cs");
+    demo.micDone = false;
+    uint32_t end = host.clock.nowUs() + 600000;
+    while ((int32_t)(end - host.clock.nowUs()) > 0) {
+        host.clock.sleepUs(demo.tasks.runReady());
+    }
+    TEST_ASSERT_EQUAL(90, demo.angle);
+    TEST_ASSERT_EQUAL(1500, host.servoH.lastPulse());
+    TEST_ASSERT_NOT_NULL(strstr(host.serial.captured.c_str(), "[CMD] 回到中心位置\r\n"));
+    TEST_ASSERT_NOT_NULL(strstr(host.serial.captured.c_str(), "[CMD] H="));
+}
+
+// ========== 属性测试 ==========
+
+// 属性测试1: 随机脉宽范围和角度：换算与 Arduino map() 相同、随角度单调不减；
+// 随机分段写入串口的输出与一次写入相同
+void test_property_servo_and_serial() {
+    printf("\n[Property Test] 舵机换算与串口分段写入 - 100次迭代\n");
+    for (int iter = 0; iter < 100; iter++) {
+        uint16_t minUs = (uint16_t)testRandomInt(400, 1400);
+        uint16_t maxUs = (uint16_t)testRandomInt(minUs + 1, 2600);
+        RecordingServo servo;
+        TEST_ASSERT_TRUE(servo.attach((uint8_t)testRandomInt(0, 48), minUs, maxUs));
+        uint16_t last = 0;
+        for (int angle = -10; angle <= 190; angle += testRandomInt(1, 7)) {
+            servo.write(angle);
+            int clamped = angle < 0 ? 0 : (angle > 180 ? 180 : angle);
+            TEST_ASSERT_EQUAL(arduinoMap(clamped, 0, 180, minUs, maxUs), servo.lastPulse());
+            TEST_ASSERT_TRUE(servo.lastPulse() >= last);
+            last = servo.lastPulse();
+        }
+
+        std::string text;
+        int length = testRandomInt(0, 300);
+        for (int i = 0; i < length; i++) {
+            text.push_back((char)testRandomInt(0, 255));
+        }
+        FileSerial serial(nullptr);
+        serial.capture = true;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t chunk = (size_t)testRandomInt(1, 40);
+            chunk = chunk < text.size() - pos ? chunk : text.size() - pos;
+            serial.write((const uint8_t*)text.data() + pos, chunk);
+            pos += chunk;
+        }
+        TEST_ASSERT_TRUE(serial.captured == text);
+        serial.feed(text.c_str());   // 到第一个 0 为止
+        std::string back;
+        int c;
+        while ((c = serial.read()) >= 0) {
+            back.push_back((char)c);
+        }
+        TEST_ASSERT_TRUE(back == std::string(text.c_str()));
+
+        if ((iter + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", iter + 1);
+        }
+    }
+}
+
+// ========== 性能测试 ==========
+
+// 主机后端全速运行：联动逻辑跑 20 秒声音场景所需的实际时间
+void test_benchmark_host_speed() {
+    printf("\n[Benchmark] 主机后端全速运行\n");
+    HostHal host;
+    TEST_ASSERT_TRUE(host.microphone.open(makeScene(-60, 20.0f)));
+    host.serial.setOutput(nullptr);
+    Hal hal = host.hal();
+    HeadDemo demo(hal);
+    demo.begin();
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    demo.run();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double realMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double virtualMs = host.clock.nowMs();
+    const SchedTaskStats& totals = demo.tasks.totals();
+
+    printf("  虚拟时间 %.0f ms，实际 %.1f ms（%.0fx 实时）\n", virtualMs, realMs, virtualMs / realMs);
+    printf("  任务运行 %lu 次，舵机输出 %lu 次，LED %lu 帧，采集 %lu 帧\n", (unsigned long)totals.runs,
+           (unsigned long)host.servoH.samples.size(), (unsigned long)host.ledTransport.frames.size(),
+           (unsigned long)demo.frames);
+    TEST_ASSERT_EQUAL(1, demo.triggers);
+    TEST_ASSERT_TRUE(demo.target < 80);
+    TEST_ASSERT_TRUE(virtualMs / realMs > 1.0);
+}
+
+// ========================================
+// 主函数
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("Hal 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_servo);
+    RUN_TEST(test_unit_clocks);
+    RUN_TEST(test_unit_serial);
+    RUN_TEST(test_unit_host_hal_demo);
+
+    printf("\n========================================\n");
+    printf("Hal 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_servo_and_serial);
+
+    printf("\n========================================\n");
+    printf("Hal 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_host_speed);
+
+    return UNITY_END();
+}
@@ -0,0 +1,398 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LatencyHistogram.h"
+
+// ========================================
+// LatencyHistogram 测试（主机端，native 环境）
+// 对数-线性分桶直方图：分桶误差、百分位数、超时计数、合并、文本输出、跨线程读取
+// 运行：python tools/run_native_tests.py test_latency_histogram
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 39388;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+// 随机的"节拍"值：大部分在周期附近，偶尔有长停顿，范围覆盖 0 ~ 2^24
+static uint32_t randomLatency() {
+    int kind = testRandomInt(0, 9);
+    if (kind < 6) {
+        return (uint32_t)testRandomInt(4800, 5200);
+    }
+    if (kind < 9) {
+        return (uint32_t)testRandomInt(0, 100);
+    }
+    int bits = testRandomInt(0, 23);
+    return (uint32_t)testRandomInt(0, (1 << bits) - 1) | (1u << bits);
+}
+
+// 精确的第 rank 个值（与 percentile 的取法相同）
+static uint32_t exactPercentile(std::vector<uint32_t> values, float percent) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    uint32_t rank = (uint32_t)((double)values.size() * percent / 100.0 + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > values.size()) rank = (uint32_t)values.size();
+    return values[rank - 1];
+}
+
+// 解析 serialize() 的输出（与 tools/merge_histograms.py 相同的格式）
+struct ParsedHist {
+    std::string name;
+    std::map<std::string, unsigned long> fields;
+    std::map<unsigned, unsigned long> buckets;
+};
+
+static bool parseHist(const char* line, ParsedHist& out) {
+    if (strncmp(line, "HIST ", 5) != 0) {
+        return false;
+    }
+    const char* p = line + 5;
+    const char* sp = strchr(p, ' ');
+    if (sp == nullptr) {
+        return false;
+    }
+    out.name.assign(p, sp - p);
+    p = sp + 1;
+    while (*p != '\0') {
+        const char* eq = strchr(p, '=');
+        if (eq == nullptr) {
+            return false;
+        }
+        std::string key(p, eq - p);
+        p = eq + 1;
+        if (key == "b") {
+            while (*p != '\0') {
+                char* end;
+                unsigned long index = strtoul(p, &end, 10);
+                if (*end != ':') return false;
+                unsigned long count = strtoul(end + 1, &end, 10);
+                out.buckets[(unsigned)index] = count;
+                p = end;
+                if (*p == ',') p++;
+                else break;
+            }
+            break;
+        }
+        char* end;
+        out.fields[key] = strtoul(p, &end, 10);
+        p = end;
+        if (*p == ' ') p++;
+    }
+    return true;
+}
+
+// ========== 单元测试 ==========
+
+// 单元测试1: 分桶：0~31 精确；之后每个值落在自己的桶内，桶宽不超过下界的 1/32；桶连续不重叠
+void test_unit_bucket_mapping() {
+    for (uint32_t v = 0; v < 32; v++) {
+        TEST_ASSERT_EQUAL(v, LatencyHistogram::bucketIndex(v));
+        TEST_ASSERT_EQUAL(v, LatencyHistogram::bucketLow((uint16_t)v));
+        TEST_ASSERT_EQUAL(v, LatencyHistogram::bucketHigh((uint16_t)v));
+    }
+    TEST_ASSERT_EQUAL(32, LatencyHistogram::bucketIndex(32));
+    TEST_ASSERT_EQUAL(63, LatencyHistogram::bucketIndex(63));
+    TEST_ASSERT_EQUAL(64, LatencyHistogram::bucketIndex(64));
+    TEST_ASSERT_EQUAL(64, LatencyHistogram::bucketIndex(65));   // 64~127 每 2us 一个桶
+    TEST_ASSERT_EQUAL(LAT_HIST_BUCKETS - 1, LatencyHistogram::bucketIndex(LAT_HIST_MAX_TRACKED));
+    TEST_ASSERT_EQUAL(LAT_HIST_BUCKETS - 1, LatencyHistogram::bucketIndex(0xFFFFFFFFu));
+
+    // 相邻桶首尾相接，覆盖 0 ~ LAT_HIST_MAX_TRACKED
+    for (uint16_t i = 1; i < LAT_HIST_BUCKETS; i++) {
+        TEST_ASSERT_EQUAL(LatencyHistogram::bucketHigh(i - 1) + 1, LatencyHistogram::bucketLow(i));
+        uint32_t low = LatencyHistogram::bucketLow(i);
+        uint32_t width = LatencyHistogram::bucketHigh(i) - low + 1;
+        TEST_ASSERT_TRUE(width * 32 <= low || low < 32);
+        TEST_ASSERT_EQUAL(i, LatencyHistogram::bucketIndex(low));
+        TEST_ASSERT_EQUAL(i, LatencyHistogram::bucketIndex(LatencyHistogram::bucketHigh(i)));
+    }
+    TEST_ASSERT_EQUAL(LAT_HIST_MAX_TRACKED, LatencyHistogram::bucketHigh(LAT_HIST_BUCKETS - 1));
+}
+
+// 单元测试2: 百分位数、最大值、最小值和超时计数；空直方图；超出范围的值
+void test_unit_percentiles_and_deadline() {
+    static LatencyHistogram h("tick", 5500);
+    TEST_ASSERT_EQUAL(0, h.percentile(50));
+    TEST_ASSERT_EQUAL(0, h.minUs());
+
+    // 98 拍正常（5000us），1 拍 5600us（超时），1 拍 20000us（超时）
+    for (int i = 0; i < 98; i++) h.record(5000);
+    h.record(5600);
+    h.record(20000);
+    TEST_ASSERT_EQUAL(100, h.count());
+    TEST_ASSERT_EQUAL(2, h.missed());
+    TEST_ASSERT_EQUAL(20000, h.maxUs());
+    TEST_ASSERT_EQUAL(LatencyHistogram::bucketLow(LatencyHistogram::bucketIndex(5000)), h.minUs());
+
+    uint32_t p50 = h.percentile(50);
+    TEST_ASSERT_TRUE(p50 >= 5000 && p50 <= 5000 + 5000 / 32);
+    uint32_t p99 = h.percentile(99);
+    TEST_ASSERT_TRUE(p99 >= 5600 && p99 <= 5600 + 5600 / 32);
+    TEST_ASSERT_EQUAL(20000, h.percentile(100));   // 不超过最大值
+    TEST_ASSERT_EQUAL(h.percentile(0), h.percentile(1));
+
+    // 等于截止时间不算超时
+    static LatencyHistogram edge("edge", 100);
+    edge.record(100);
+    TEST_ASSERT_EQUAL(0, edge.missed());
+    edge.record(101);
+    TEST_ASSERT_EQUAL(1, edge.missed());
+
+    // 没有截止时间：不统计超时
+    static LatencyHistogram free("free");
+    free.record(1000000);
+    TEST_ASSERT_EQUAL(0, free.missed());
+
+    // 超出范围：记在最后一个桶，计入溢出，百分位数返回准确的最大值
+    static LatencyHistogram big("big");
+    big.record(40000000);
+    TEST_ASSERT_EQUAL(1, big.overflow());
+    TEST_ASSERT_EQUAL(1, big.bucketCount(LAT_HIST_BUCKETS - 1));
+    TEST_ASSERT_EQUAL(40000000, big.percentile(50));
+
+    h.reset();
+    TEST_ASSERT_EQUAL(0, h.count());
+    TEST_ASSERT_EQUAL(0, h.missed());
+    TEST_ASSERT_EQUAL(0, h.maxUs());
+    TEST_ASSERT_EQUAL(0, h.percentile(99));
+}
+
+// 单元测试3: 合并两个直方图与把所有值记入一个直方图相同；copyFrom 为快照
+void test_unit_merge() {
+    static LatencyHistogram a("a", 1000);
+    static LatencyHistogram b("b", 1000);
+    static LatencyHistogram all("all", 1000);
+    for (uint32_t v = 0; v < 3000; v += 7) {
+        a.record(v);
+        all.record(v);
+    }
+    for (uint32_t v = 500; v < 90000; v += 113) {
+        b.record(v);
+        all.record(v);
+    }
+
+    static LatencyHistogram merged("merged", 1000);
+    merged.merge(a);
+    merged.merge(b);
+    TEST_ASSERT_EQUAL(all.count(), merged.count());
+    TEST_ASSERT_EQUAL(all.missed(), merged.missed());
+    TEST_ASSERT_EQUAL(all.maxUs(), merged.maxUs());
+    for (uint16_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        TEST_ASSERT_EQUAL(all.bucketCount(i), merged.bucketCount(i));
+    }
+    TEST_ASSERT_EQUAL(all.percentile(99), merged.percentile(99));
+    TEST_ASSERT_EQUAL_STRING("merged", merged.name());
+
+    static LatencyHistogram snap("snap", 0);
+    snap.copyFrom(a);
+    a.record(5);
+    TEST_ASSERT_EQUAL(a.count() - 1, snap.count());
+    TEST_ASSERT_EQUAL(0, snap.deadlineUs());
+}
+
+// 单元测试4: 文本输出：字段与计数一致，只列非空桶；容量不够时返回 0
+void test_unit_serialize() {
+    static LatencyHistogram h("motion_tick", 7500);
+    for (int i = 0; i < 50; i++) h.record(5000);
+    h.record(7600);
+    h.record(3);
+
+    char line[512];
+    size_t n = h.serialize(line, sizeof(line));
+    TEST_ASSERT_EQUAL(strlen(line), n);
+    printf("  %s\n", line);
+
+    ParsedHist parsed;
+    TEST_ASSERT_TRUE(parseHist(line, parsed));
+    TEST_ASSERT_EQUAL_STRING("motion_tick", parsed.name.c_str());
+    TEST_ASSERT_EQUAL(LAT_HIST_SUB_BITS, parsed.fields["s"]);
+    TEST_ASSERT_EQUAL(7500, parsed.fields["dl"]);
+    TEST_ASSERT_EQUAL(52, parsed.fields["n"]);
+    TEST_ASSERT_EQUAL(1, parsed.fields["miss"]);
+    TEST_ASSERT_EQUAL(7600, parsed.fields["max"]);
+    TEST_ASSERT_EQUAL(0, parsed.fields["over"]);
+    TEST_ASSERT_EQUAL(3, parsed.buckets.size());
+    TEST_ASSERT_EQUAL(50, parsed.buckets[LatencyHistogram::bucketIndex(5000)]);
+    TEST_ASSERT_EQUAL(1, parsed.buckets[3]);
+
+    TEST_ASSERT_EQUAL(0, h.serialize(line, 20));
+    TEST_ASSERT_EQUAL(0, line[0]);
+    TEST_ASSERT_EQUAL(0, h.serialize(line, n));   // 差一个字节（结尾的 0）
+    TEST_ASSERT_EQUAL(n, h.serialize(line, n + 1));
+}
+
+// 单元测试5: 一个线程写、另一个线程同时读百分位数和文本：读到的值单调、最终计数准确
+void test_unit_concurrent_reader() {
+    static LatencyHistogram h("flush", 30000);
+    const uint32_t total = 200000;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&]() {
+        for (uint32_t i = 0; i < total; i++) {
+            h.record(20000 + (i % 16) * 1000);
+            if ((i & 255) == 0) {
+                std::this_thread::yield();   // 让读取线程在单核主机上也能穿插进来
+            }
+        }
+        done = true;
+    });
+
+    uint32_t lastCount = 0;
+    int reads = 0;
+    char line[512];
+    bool consistent = true;
+    while (!done) {
+        uint32_t c = h.count();
+        if (c < lastCount) consistent = false;
+        lastCount = c;
+        uint32_t p = h.percentile(99);
+        if (c > 0 && (p < 20000 || p > 35000)) consistent = false;
+        h.serialize(line, sizeof(line));
+        reads++;
+    }
+    writer.join();
+
+    printf("  写入 %lu 次，同时读取 %d 次\n", (unsigned long)total, reads);
+    TEST_ASSERT_TRUE(consistent);
+    TEST_ASSERT_EQUAL(total, h.count());
+    TEST_ASSERT_EQUAL(total / 16 * 5, h.missed());   // 31000~35000 超过 30000
+    TEST_ASSERT_EQUAL(35000, h.maxUs());
+}
+
+// ========== 属性测试 ==========
+
+// 属性测试1: 随机值：百分位数不小于精确值、相对误差不超过 1/32；随机拆成两半再合并与整体一致
+void test_property_percentile_error() {
+    printf("\n[Property Test] 百分位数误差与合并 - 100次迭代\n");
+    static LatencyHistogram whole("whole", 5500);
+    static LatencyHistogram left("left", 5500);
+    static LatencyHistogram right("right", 5500);
+    static LatencyHistogram merged("merged", 5500);
+    const float percents[] = {0, 1, 25, 50, 90, 99, 99.9f, 100};
+
+    for (int iter = 0; iter < 100; iter++) {
+        whole.reset();
+        left.reset();
+        right.reset();
+        merged.reset();
+        std::vector<uint32_t> values;
+        int n = testRandomInt(1, 2000);
+        uint32_t missed = 0;
+        for (int i = 0; i < n; i++) {
+            uint32_t v = randomLatency();
+            values.push_back(v);
+            whole.record(v);
+            (testRandomInt(0, 1) ? left : right).record(v);
+            if (v > 5500) missed++;
+        }
+
+        TEST_ASSERT_EQUAL(n, whole.count());
+        TEST_ASSERT_EQUAL(missed, whole.missed());
+        TEST_ASSERT_EQUAL(*std::max_element(values.begin(), values.end()), whole.maxUs());
+        for (float p : percents) {
+            uint32_t exact = exactPercentile(values, p);
+            uint32_t got = whole.percentile(p);
+            TEST_ASSERT_TRUE(got >= exact);
+            TEST_ASSERT_TRUE((uint64_t)(got - exact) * 32 <= exact);
+        }
+
+        merged.merge(left);
+        merged.merge(right);
+        for (float p : percents) {
+            TEST_ASSERT_EQUAL(whole.percentile(p), merged.percentile(p));
+        }
+        TEST_ASSERT_EQUAL(whole.missed(), merged.missed());
+
+        if ((iter + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", iter + 1);
+        }
+    }
+}
+
+// ========== 性能测试 ==========
+
+// 记录开销（与保存原始值后排序求百分位数对比）、查询开销和内存
+void test_benchmark_histogram() {
+    printf("\n[Benchmark] 记录与查询开销\n");
+    static LatencyHistogram h("bench", 5500);
+    const int rounds = 1000000;
+    static uint32_t values[4096];
+    for (int i = 0; i < 4096; i++) values[i] = randomLatency();
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; i++) h.record(values[i & 4095]);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double recordNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / rounds;
+
+    volatile uint32_t sink = 0;
+    auto t2 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < 1000; i++) sink = sink + h.percentile(99);
+    auto t3 = std::chrono::high_resolution_clock::now();
+    double queryUs = std::chrono::duration<double, std::micro>(t3 - t2).count() / 1000;
+
+    // 对比：保存最近 4096 个原始值，查询时排序
+    std::vector<uint32_t> raw(values, values + 4096);
+    auto t4 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < 100; i++) sink = sink + exactPercentile(raw, 99);
+    auto t5 = std::chrono::high_resolution_clock::now();
+    double sortUs = std::chrono::duration<double, std::micro>(t5 - t4).count() / 100;
+
+    char line[2048];
+    size_t bytes = h.serialize(line, sizeof(line));
+
+    printf("  record：%.1f ns/次（常数时间，不分配内存）\n", recordNs);
+    printf("  percentile：%.2f us/次（遍历 %d 个桶）；对比保存 4096 个原始值排序：%.1f us/次\n",
+           queryUs, LAT_HIST_BUCKETS, sortUs);
+    printf("  每个直方图 %lu 字节（覆盖 0 ~ %.1f 秒，相对误差 <= 1/%d），记录 %d 次后文本 %lu 字节\n",
+           (unsigned long)sizeof(LatencyHistogram), LAT_HIST_MAX_TRACKED / 1e6, LAT_HIST_SUB_COUNT,
+           rounds, (unsigned long)bytes);
+    TEST_ASSERT_EQUAL(rounds, h.count());
+    TEST_ASSERT_TRUE(bytes > 0);
+}
+
+// ========================================
+// 主函数
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("LatencyHistogram 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_bucket_mapping);
+    RUN_TEST(test_unit_percentiles_and_deadline);
+    RUN_TEST(test_unit_merge);
+    RUN_TEST(test_unit_serialize);
+    RUN_TEST(test_unit_concurrent_reader);
+
+    printf("\n========================================\n");
+    printf("LatencyHistogram 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_percentile_error);
+
+    printf("\n========================================\n");
+    printf("LatencyHistogram 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_histogram);
+
+    return UNITY_END();
+}
@@ -0,0 +1,343 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include "LedStrip.h"
+#include "LedCompositor.h"
+#include "LedAnimation.h"
+
+// ========================================
+// LedAnimation 测试（主机端，native 环境）
+// 关键帧插值、图层混合、固定帧率推进，以及与原手写呼吸效果的对比
+// 运行：python tools/run_native_tests.py test_led_animation
+// ========================================
+
+static const uint16_t LED_COUNT = 5;
+
+class MockStrip : public LedStrip {
+public:
+    MockStrip() : shows(0) { memset(pixels, 0, sizeof(pixels)); }
+    uint16_t numPixels() const override { return LED_COUNT; }
+    void setPixelColor(uint16_t index, uint32_t color) override { pixels[index] = color; }
+    void show() override { shows++; }
+
+    uint32_t pixels[LED_COUNT];
+    uint32_t shows;
+};
+
+// 与综合测试一致的区域
+struct Rig {
+    MockStrip strip;
+    LedCompositor frame;
+    LedAnimator anim;
+    uint8_t eye;
+    uint8_t body;
+
+    Rig() : frame(strip), anim(frame) {
+        eye = (uint8_t)frame.defineZone("eye", 0, 2);
+        body = (uint8_t)frame.defineZone("body", 2, 3);
+    }
+};
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 86420;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+static uint8_t red(uint32_t c) { return (uint8_t)(c >> 16); }
+static uint8_t green(uint32_t c) { return (uint8_t)(c >> 8); }
+static uint8_t blue(uint32_t c) { return (uint8_t)c; }
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: gamma 表端点、单调，等级 136 对应原呼吸最低亮度 50
+void test_unit_gamma_lut() {
+    TEST_ASSERT_EQUAL(0, LED_GAMMA8[0]);
+    TEST_ASSERT_EQUAL(255, LED_GAMMA8[255]);
+    TEST_ASSERT_EQUAL(50, LED_GAMMA8[136]);
+    for (int i = 1; i < 256; i++) {
+        TEST_ASSERT_TRUE(LED_GAMMA8[i] >= LED_GAMMA8[i - 1]);
+    }
+}
+
+// 单元测试2: 单段关键帧逐帧插值，段末精确到达并保持
+void test_unit_keyframe_interpolation() {
+    Rig rig;
+    static const LedKeyframe keys[] = {{0, 0}, {100, 200}};
+    static const LedTrack track = {keys, 2, false};
+    int8_t layer = rig.anim.addLayer(rig.body, ledColor(255, 255, 255), &track);
+
+    TEST_ASSERT_EQUAL(0, rig.anim.level(layer));
+    for (int f = 0; f < 5; f++) rig.anim.step();
+    TEST_ASSERT_INT_WITHIN(1, 100, rig.anim.level(layer));
+    TEST_ASSERT_FALSE(rig.anim.finished(layer));
+
+    for (int f = 0; f < 5; f++) rig.anim.step();
+    TEST_ASSERT_EQUAL(200, rig.anim.level(layer));
+    TEST_ASSERT_TRUE(rig.anim.finished(layer));
+
+    for (int f = 0; f < 20; f++) rig.anim.step();
+    TEST_ASSERT_EQUAL(200, rig.anim.level(layer));
+}
+
+// 单元测试3: 循环呼吸轨道——周期、最亮/最暗与起点一致
+void test_unit_breathe_loop() {
+    Rig rig;
+    int8_t layer = rig.anim.addLayer(rig.body, ledColor(0, 0, 255), &LED_TRACK_BREATHE);
+
+    uint8_t lo = 255, hi = 0;
+    int peakFrame = -1;
+    for (int f = 1; f <= 240; f++) {
+        rig.anim.step();
+        uint8_t lv = rig.anim.level(layer);
+        if (lv < lo) lo = lv;
+        if (lv > hi) { hi = lv; peakFrame = f; }
+    }
+    TEST_ASSERT_EQUAL(136, lo);
+    TEST_ASSERT_EQUAL(255, hi);
+    TEST_ASSERT_EQUAL(120, peakFrame);                    // 1200ms / 10ms
+    TEST_ASSERT_EQUAL(136, rig.anim.level(layer));        // 2400ms 回到起点
+    TEST_ASSERT_FALSE(rig.anim.finished(layer));
+}
+
+// 单元测试4: 无轨道图层颜色不变；setLevel 只对输入图层生效
+void test_unit_solid_and_input_layers() {
+    Rig rig;
+    int8_t solid = rig.anim.addLayer(rig.eye, ledColor(50, 0, 0));
+    int8_t input = rig.anim.addLayer(rig.body, ledColor(0, 255, 0));
+    int8_t tracked = rig.anim.addLayer(rig.body, ledColor(0, 0, 0), &LED_TRACK_FADE_IN, LED_BLEND_ADD);
+
+    rig.anim.step();
+    TEST_ASSERT_EQUAL_HEX32(ledColor(50, 0, 0), rig.frame.pixel(0));
+    TEST_ASSERT_EQUAL_HEX32(ledColor(0, 255, 0), rig.frame.pixel(2));
+
+    rig.anim.setLevel(input, 0);
+    rig.anim.step();
+    TEST_ASSERT_EQUAL_HEX32(0, rig.frame.pixel(3));
+
+    uint8_t before = rig.anim.level(tracked);
+    rig.anim.setLevel(tracked, 255);                      // 轨道图层忽略外部输入
+    TEST_ASSERT_EQUAL(before, rig.anim.level(tracked));
+    TEST_ASSERT_EQUAL(255, rig.anim.level(solid));
+}
+
+// 单元测试5: 混合方式——替换（半透明）、相加（饱和）、取最大
+void test_unit_blend_modes() {
+    Rig rig;
+    rig.anim.addLayer(rig.body, ledColor(200, 0, 100));
+    int8_t over = rig.anim.addLayer(rig.body, ledColor(0, 200, 100), nullptr, LED_BLEND_REPLACE, LED_FIXED_ONE / 2);
+    rig.anim.step();
+    uint32_t c = rig.frame.pixel(2);
+    TEST_ASSERT_INT_WITHIN(1, 100, red(c));
+    TEST_ASSERT_INT_WITHIN(1, 100, green(c));
+    TEST_ASSERT_INT_WITHIN(1, 100, blue(c));
+
+    rig.anim.removeLayer(over);
+    rig.anim.addLayer(rig.body, ledColor(100, 255, 0), nullptr, LED_BLEND_ADD);
+    rig.anim.step();
+    c = rig.frame.pixel(2);
+    TEST_ASSERT_EQUAL(255, red(c));
+    TEST_ASSERT_EQUAL(255, green(c));
+    TEST_ASSERT_EQUAL(100, blue(c));
+
+    Rig rig2;
+    rig2.anim.addLayer(rig2.eye, ledColor(10, 200, 30));
+    rig2.anim.addLayer(rig2.eye, ledColor(100, 20, 30), nullptr, LED_BLEND_MAX);
+    rig2.anim.step();
+    TEST_ASSERT_EQUAL_HEX32(ledColor(100, 200, 30), rig2.frame.pixel(1));
+}
+
+// 单元测试6: 固定帧率——不规则 update 时刻下帧数只由经过时间决定，阻塞过久时限制补帧
+void test_unit_fixed_frame_rate() {
+    Rig rig;
+    rig.anim.addLayer(rig.body, ledColor(0, 0, 255), &LED_TRACK_BREATHE);
+
+    rig.anim.update(1000);
+    uint32_t t = 1000;
+    const uint32_t gaps[] = {3, 7, 12, 1, 25, 9, 10, 33};
+    for (int i = 0; i < 40; i++) {
+        t += gaps[i % 8];
+        rig.anim.update(t);
+    }
+    TEST_ASSERT_EQUAL((t - 1000) / 10, rig.anim.stats().frames);
+    TEST_ASSERT_TRUE(rig.anim.stats().renders <= 41);
+
+    // loop() 被 smoothMove 阻塞 2 秒
+    uint32_t before = rig.anim.stats().frames;
+    rig.anim.update(t + 2000);
+    TEST_ASSERT_EQUAL(before + LED_ANIM_MAX_CATCHUP, rig.anim.stats().frames);
+    TEST_ASSERT_EQUAL(200 - LED_ANIM_MAX_CATCHUP, rig.anim.stats().dropped);
+}
+
+// 单元测试7: 待机呼吸颜色范围与原手写代码相同（0,9,19）~（0,50,100）
+void test_unit_matches_old_idle_breath() {
+    Rig rig;
+    const uint32_t COLOR_IDLE = ledColor(0, 50, 100);
+    rig.anim.addLayer(rig.body, COLOR_IDLE, &LED_TRACK_BREATHE);
+
+    uint8_t minG = 255, maxG = 0, minB = 255, maxB = 0;
+    for (int f = 0; f < 480; f++) {
+        rig.anim.step();
+        uint32_t c = rig.frame.pixel(2);
+        if (green(c) < minG) minG = green(c);
+        if (green(c) > maxG) maxG = green(c);
+        if (blue(c) < minB) minB = blue(c);
+        if (blue(c) > maxB) maxB = blue(c);
+    }
+    // 原代码：brightness 50~255，颜色 = (0, b*50/255, b*100/255)
+    TEST_ASSERT_EQUAL(50 * 50 / 255, minG);
+    TEST_ASSERT_EQUAL(50 * 100 / 255, minB);
+    TEST_ASSERT_EQUAL(50, maxG);
+    TEST_ASSERT_EQUAL(100, maxB);
+}
+
+// 单元测试8: 切换到同一轨道不重启；restart() 重新播放一次性脉冲
+void test_unit_set_track_and_restart() {
+    Rig rig;
+    int8_t body = rig.anim.addLayer(rig.body, ledColor(0, 0, 255), &LED_TRACK_BREATHE);
+    for (int f = 0; f < 50; f++) rig.anim.step();
+    uint8_t lv = rig.anim.level(body);
+    rig.anim.setTrack(body, &LED_TRACK_BREATHE);
+    TEST_ASSERT_EQUAL(lv, rig.anim.level(body));
+
+    int8_t flash = rig.anim.addLayer(rig.body, ledColor(255, 255, 255), &LED_TRACK_PULSE, LED_BLEND_ADD);
+    TEST_ASSERT_EQUAL(255, rig.anim.level(flash));       // 第一帧即最亮
+    for (int f = 0; f < 60; f++) rig.anim.step();
+    TEST_ASSERT_TRUE(rig.anim.finished(flash));
+    TEST_ASSERT_EQUAL(0, rig.anim.level(flash));
+    rig.anim.restart(flash);
+    TEST_ASSERT_EQUAL(255, rig.anim.level(flash));
+    TEST_ASSERT_FALSE(rig.anim.finished(flash));
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 随机关键帧轨道逐帧推进，与浮点线性插值参考值相差不超过1级，关键帧处精确
+void test_property_random_tracks() {
+    printf("\n[Property Test] 随机关键帧轨道 vs 浮点参考插值 - 100次迭代\n");
+
+    int maxErr = 0;
+    for (int i = 0; i < 100; i++) {
+        Rig rig;
+        LedKeyframe keys[8];
+        int count = testRandomInt(2, 8);
+        uint16_t t = 0;
+        for (int k = 0; k < count; k++) {
+            if (k > 0) t += (uint16_t)(testRandomInt(1, 60) * 10);   // 段长为帧长整数倍
+            keys[k].timeMs = t;
+            keys[k].level = (uint8_t)testRandomInt(0, 255);
+        }
+        LedTrack track = {keys, (uint8_t)count, false};
+        int8_t layer = rig.anim.addLayer(rig.body, ledColor(255, 255, 255), &track);
+
+        int totalFrames = keys[count - 1].timeMs / 10;
+        for (int f = 1; f <= totalFrames + 5; f++) {
+            rig.anim.step();
+            int ms = f * 10;
+            float ref;
+            if (ms >= keys[count - 1].timeMs) {
+                ref = keys[count - 1].level;
+            } else {
+                int k = 0;
+                while (keys[k + 1].timeMs <= ms) k++;
+                float u = (float)(ms - keys[k].timeMs) / (keys[k + 1].timeMs - keys[k].timeMs);
+                ref = keys[k].level + u * (keys[k + 1].level - keys[k].level);
+            }
+
+            int err = (int)rig.anim.level(layer) - (int)(ref + 0.5f);
+            if (err < 0) err = -err;
+            if (err > maxErr) maxErr = err;
+            if (err > 1) {
+                char msg[96];
+                snprintf(msg, sizeof(msg), "Iter %d frame %d: level %u, ref %.1f", i, f, rig.anim.level(layer), ref);
+                TEST_FAIL_MESSAGE(msg);
+            }
+            for (int k = 1; k < count; k++) {
+                if (keys[k].timeMs == ms && rig.anim.level(layer) != keys[k].level) {
+                    TEST_FAIL_MESSAGE("关键帧处未精确对齐");
+                }
+            }
+        }
+        TEST_ASSERT_TRUE(rig.anim.finished(layer));
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+    printf("  最大误差: %d 级\n", maxErr);
+
+    TEST_PASS();
+}
+
+// ========================================
+// 性能测试
+// ========================================
+
+// 性能1: 每帧计算耗时（综合测试的3个图层，以及满 8 个图层）
+void test_benchmark_frame_cost() {
+    printf("\n[Benchmark] 每帧动画计算 + 写入合成器耗时\n");
+
+    for (int layers = 3; layers <= LED_ANIM_MAX_LAYERS; layers += LED_ANIM_MAX_LAYERS - 3) {
+        Rig rig;
+        rig.anim.addLayer(rig.body, ledColor(0, 50, 100), &LED_TRACK_BREATHE);
+        rig.anim.addLayer(rig.eye, ledColor(255, 0, 0), &LED_TRACK_BREATHE);
+        rig.anim.addLayer(rig.body, ledColor(255, 255, 255), &LED_TRACK_PULSE, LED_BLEND_ADD, LED_FIXED_ONE / 2);
+        for (int l = 3; l < layers; l++) {
+            rig.anim.addLayer(l % 2 ? rig.eye : rig.body, ledColor(l * 30, 0, 255 - l * 30),
+                              &LED_TRACK_BREATHE, LED_BLEND_MAX, 200);
+        }
+
+        const int FRAMES = 100000;
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < FRAMES; f++) {
+            rig.anim.step();
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / FRAMES;
+
+        printf("  %d 个图层: %.0f ns/帧（10ms 帧长的 %.4f%%）\n", layers, ns, ns / 1e7 * 100.0);
+        TEST_ASSERT_TRUE(ns < 10000.0);
+    }
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("LedAnimation 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_gamma_lut);
+    RUN_TEST(test_unit_keyframe_interpolation);
+    RUN_TEST(test_unit_breathe_loop);
+    RUN_TEST(test_unit_solid_and_input_layers);
+    RUN_TEST(test_unit_blend_modes);
+    RUN_TEST(test_unit_fixed_frame_rate);
+    RUN_TEST(test_unit_matches_old_idle_breath);
+    RUN_TEST(test_unit_set_track_and_restart);
+
+    printf("\n========================================\n");
+    printf("LedAnimation 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_random_tracks);
+
+    printf("\n========================================\n");
+    printf("LedAnimation 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_frame_cost);
+
+    return UNITY_END();
+}
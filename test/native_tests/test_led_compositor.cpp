@@ -0,0 +1,322 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "LedStrip.h"
+#include "LedCompositor.h"
+
+// ========================================
+// LedCompositor 测试（主机端，native 环境）
+// 用记录 show() 次数的 mock 灯带，对比原来每次修改都 show() 的写法
+// 运行：python tools/run_native_tests.py test_led_compositor
+// ========================================
+
+// 与综合测试一致：5个LED，瞳孔 0-1，机身 2-4
+static const uint16_t LED_COUNT = 5;
+
+// 5个像素发送 + 复位：5 × 24bit × 1.25us + 300us ≈ 450us（关中断）
+static const float SHOW_COST_US = 450.0f;
+
+class MockStrip : public LedStrip {
+public:
+    MockStrip() : shows(0), writes(0) { memset(pixels, 0, sizeof(pixels)); memset(shown, 0, sizeof(shown)); }
+
+    uint16_t numPixels() const override { return LED_COUNT; }
+    void setPixelColor(uint16_t index, uint32_t color) override { pixels[index] = color; writes++; }
+    void show() override { memcpy(shown, pixels, sizeof(shown)); shows++; }
+
+    uint32_t pixels[LED_COUNT];
+    uint32_t shown[LED_COUNT];   // 最近一次 show() 时灯带上的颜色
+    uint32_t shows;
+    uint32_t writes;
+};
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 13579;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+static void defineRobotZones(LedCompositor& frame) {
+    frame.defineZone("eye", 0, 2);
+    frame.defineZone("body", 2, 3);
+}
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: 区域定义与查找
+void test_unit_zones() {
+    MockStrip strip;
+    LedCompositor frame(strip);
+
+    TEST_ASSERT_EQUAL(0, frame.defineZone("eye", 0, 2));
+    TEST_ASSERT_EQUAL(1, frame.defineZone("body", 2, 3));
+    TEST_ASSERT_EQUAL(-1, frame.defineZone("tail", 4, 2));   // 越界
+    TEST_ASSERT_EQUAL(-1, frame.defineZone("none", 0, 0));   // 空区域
+
+    TEST_ASSERT_EQUAL(1, frame.findZone("body"));
+    TEST_ASSERT_EQUAL(-1, frame.findZone("tail"));
+    TEST_ASSERT_EQUAL(3, frame.zone(1).count);
+}
+
+// 单元测试2: 写入相同颜色不算修改，不调用 show()
+void test_unit_same_color_is_clean() {
+    MockStrip strip;
+    LedCompositor frame(strip);
+    defineRobotZones(frame);
+
+    frame.fill(0);                          // 初始即全黑
+    TEST_ASSERT_FALSE(frame.isDirty());
+    TEST_ASSERT_FALSE(frame.flush(100));
+
+    frame.fillZone(0, ledColor(50, 0, 0));
+    TEST_ASSERT_TRUE(frame.flush(200));
+    frame.fillZone(0, ledColor(50, 0, 0));  // 再写一次相同颜色
+    TEST_ASSERT_FALSE(frame.flush(300));
+
+    TEST_ASSERT_EQUAL(1, strip.shows);
+    TEST_ASSERT_EQUAL(1, frame.stats().shows);
+}
+
+// 单元测试3: 只把脏像素写给后端
+void test_unit_only_dirty_pixels_written() {
+    MockStrip strip;
+    LedCompositor frame(strip);
+    defineRobotZones(frame);
+
+    frame.fillZone(1, ledColor(0, 255, 0));
+    frame.flush(0);
+    TEST_ASSERT_EQUAL(3, strip.writes);
+
+    frame.setPixel(3, ledColor(255, 100, 0));
+    frame.flush(100);
+    TEST_ASSERT_EQUAL(4, strip.writes);
+
+    TEST_ASSERT_EQUAL_HEX32(0, strip.shown[0]);
+    TEST_ASSERT_EQUAL_HEX32(ledColor(0, 255, 0), strip.shown[2]);
+    TEST_ASSERT_EQUAL_HEX32(ledColor(255, 100, 0), strip.shown[3]);
+}
+
+// 单元测试4: 同一帧内多次修改合并为一次 show()
+void test_unit_coalesce_within_frame() {
+    MockStrip strip;
+    LedCompositor frame(strip, 10);
+    defineRobotZones(frame);
+
+    frame.fillZone(0, ledColor(255, 0, 0));
+    TEST_ASSERT_TRUE(frame.flush(0));
+
+    // 同一帧内：瞳孔、机身各改一次，两次 flush 请求
+    frame.fillZone(0, ledColor(100, 0, 0));
+    TEST_ASSERT_FALSE(frame.flush(3));
+    frame.fillZone(1, ledColor(0, 0, 255));
+    TEST_ASSERT_FALSE(frame.flush(6));
+    TEST_ASSERT_EQUAL(1, strip.shows);
+    TEST_ASSERT_EQUAL(2, frame.stats().deferred);
+
+    // 下一帧：一次发送全部修改
+    TEST_ASSERT_TRUE(frame.flush(10));
+    TEST_ASSERT_EQUAL(2, strip.shows);
+    TEST_ASSERT_EQUAL_HEX32(ledColor(100, 0, 0), strip.shown[1]);
+    TEST_ASSERT_EQUAL_HEX32(ledColor(0, 0, 255), strip.shown[4]);
+}
+
+// 单元测试5: flushNow() 忽略帧节拍，但没有修改时仍不发送
+void test_unit_flush_now() {
+    MockStrip strip;
+    LedCompositor frame(strip, 10);
+
+    frame.setPixel(0, ledColor(1, 2, 3));
+    TEST_ASSERT_TRUE(frame.flush(0));
+    frame.setPixel(0, ledColor(4, 5, 6));
+    TEST_ASSERT_TRUE(frame.flushNow());
+    TEST_ASSERT_FALSE(frame.flushNow());
+    TEST_ASSERT_EQUAL(2, strip.shows);
+}
+
+// 单元测试6: 综合测试的待机 / 活跃节奏，对比原写法的 show() 次数
+void test_unit_state_patterns_vs_direct() {
+    // 原写法：待机每20ms设置全部像素 + show()；活跃每10ms setEyeLEDs() + show()。
+    // 呼吸颜色几乎每次都变，show() 次数持平，节省在于不再重写未变的像素
+    const uint32_t DURATION_MS = 10000;
+    uint32_t directShows = 0;
+
+    MockStrip strip;
+    LedCompositor frame(strip);
+    defineRobotZones(frame);
+
+    // 待机：机身蓝色呼吸，瞳孔常亮暗红；loop() 每10ms一轮
+    int brightness = 50, direction = 1;
+    uint32_t lastBreath = 0;
+    for (uint32_t t = 0; t < DURATION_MS; t += 10) {
+        if (t - lastBreath > 20) {
+            brightness += direction * 5;
+            if (brightness >= 255) { brightness = 255; direction = -1; }
+            else if (brightness <= 50) { brightness = 50; direction = 1; }
+
+            uint32_t body = ledColor(0, brightness * 50 / 255, brightness * 100 / 255);
+            frame.fillZone(1, body);
+            frame.fillZone(0, ledColor(50, 0, 0));
+            directShows++;
+            lastBreath = t;
+        }
+        frame.flush(t);
+    }
+    uint32_t idleShows = strip.shows;
+
+    // 活跃：机身橙色常亮（只设置一次），瞳孔呼吸；原写法每次 setEyeLEDs 都 show()
+    uint32_t directActive = 1;
+    frame.fillZone(1, ledColor(255, 100, 0));
+    brightness = 50;
+    direction = 1;
+    uint32_t lastUpdate = 0;
+    for (uint32_t t = DURATION_MS; t < 2 * DURATION_MS; t += 10) {
+        if (t - lastUpdate > 10) {
+            brightness += direction * 5;
+            if (brightness >= 255) { brightness = 255; direction = -1; }
+            else if (brightness <= 50) { brightness = 50; direction = 1; }
+            frame.fillZone(0, ledColor(brightness, 0, 0));
+            directActive++;
+            lastUpdate = t;
+        }
+        frame.flush(t);
+    }
+    uint32_t activeShows = strip.shows - idleShows;
+
+    printf("  待机 10s: 原写法 %u 次 show()，合成器 %u 次\n", (unsigned)directShows, (unsigned)idleShows);
+    printf("  活跃 10s: 原写法 %u 次 show()，合成器 %u 次\n", (unsigned)directActive, (unsigned)activeShows);
+    printf("  像素写入: %u（原写法 %u）\n", (unsigned)strip.writes,
+           (unsigned)((directShows + directActive) * LED_COUNT));
+    printf("  关中断时间: 原写法 %.0f ms，合成器 %.0f ms（每次 show() 约 %.0fus）\n",
+           (directShows + directActive) * SHOW_COST_US / 1000.0f,
+           strip.shows * SHOW_COST_US / 1000.0f, SHOW_COST_US);
+
+    // 每帧最多一次，且不会比原写法多
+    TEST_ASSERT_TRUE(idleShows <= DURATION_MS / LED_FRAME_MS);
+    TEST_ASSERT_TRUE(idleShows <= directShows);
+    TEST_ASSERT_TRUE(activeShows <= directActive);
+    TEST_ASSERT_TRUE(strip.writes < (directShows + directActive) * LED_COUNT / 2);
+}
+
+// 单元测试7: 同一轮 loop() 内多处写灯（状态切换 + 呼吸 + 演示），原写法每处都 show()
+void test_unit_multiple_writers_per_loop() {
+    MockStrip strip;
+    LedCompositor frame(strip);
+    defineRobotZones(frame);
+
+    uint32_t directShows = 0;
+    uint32_t loops = 0;
+    for (uint32_t t = 0; t < 10000; t += 10, loops++) {
+        // 每 200ms 一次状态切换：setBodyLEDs() + setEyeLEDs()
+        if (t % 200 == 0) {
+            frame.fillZone(1, (t / 200) % 2 ? ledColor(255, 100, 0) : ledColor(0, 255, 0));
+            frame.fillZone(0, ledColor(50, 0, 0));
+            directShows += 2;
+        }
+        // 瞳孔呼吸（每轮都写，原写法每次 show()）
+        int level = 50 + (int)((t / 10) % 40) * 5;
+        frame.fillZone(0, ledColor(level, 0, 0));
+        directShows++;
+        // 同一轮又把瞳孔写成相同颜色（例如音量指示复写），原写法又一次 show()
+        frame.fillZone(0, ledColor(level, 0, 0));
+        directShows++;
+
+        frame.flush(t);
+    }
+
+    printf("  %u 轮 loop(): 原写法 %u 次 show()，合成器 %u 次（减少 %.0f%%）\n",
+           (unsigned)loops, (unsigned)directShows, (unsigned)strip.shows,
+           100.0f * (1.0f - (float)strip.shows / directShows));
+
+    TEST_ASSERT_TRUE(strip.shows <= loops);
+    TEST_ASSERT_TRUE(strip.shows * 2 <= directShows);
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 任意写入序列和 flush 时刻：
+// - 每次 show() 后灯带内容与合成器帧一致
+// - 相邻两次 flush() 触发的 show() 间隔不小于一帧
+// - 没有修改时从不 show()
+void test_property_random_sequences() {
+    printf("\n[Property Test] 随机写入/flush 序列 - 100次迭代\n");
+
+    for (int i = 0; i < 100; i++) {
+        MockStrip strip;
+        LedCompositor frame(strip, 10);
+        defineRobotZones(frame);
+
+        uint32_t now = 0;
+        uint32_t lastShowAt = 0;
+        bool shownOnce = false;
+
+        for (int op = 0; op < 200; op++) {
+            int kind = testRandomInt(0, 3);
+            uint32_t color = ledColor(testRandomInt(0, 3) * 80, 0, testRandomInt(0, 1) * 255);
+            if (kind == 0) frame.setPixel(testRandomInt(0, LED_COUNT - 1), color);
+            else if (kind == 1) frame.fillZone(testRandomInt(0, 1), color);
+            else if (kind == 2) frame.fill(color);
+
+            now += testRandomInt(0, 7);
+            bool wasDirty = frame.isDirty();
+            uint32_t showsBefore = strip.shows;
+            bool sent = frame.flush(now);
+
+            if (sent) {
+                if (!wasDirty) TEST_FAIL_MESSAGE("没有修改却调用了 show()");
+                if (shownOnce && now - lastShowAt < 10) TEST_FAIL_MESSAGE("同一帧内 show() 两次");
+                if (strip.shows != showsBefore + 1) TEST_FAIL_MESSAGE("show() 次数不一致");
+                for (uint16_t p = 0; p < LED_COUNT; p++) {
+                    if (strip.shown[p] != frame.pixel(p)) {
+                        char msg[80];
+                        snprintf(msg, sizeof(msg), "Iter %d: 像素 %u 与合成器帧不一致", i, p);
+                        TEST_FAIL_MESSAGE(msg);
+                    }
+                }
+                lastShowAt = now;
+                shownOnce = true;
+            } else if (strip.shows != showsBefore) {
+                TEST_FAIL_MESSAGE("flush() 返回 false 却调用了 show()");
+            }
+        }
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+
+    TEST_PASS();
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("LedCompositor 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_zones);
+    RUN_TEST(test_unit_same_color_is_clean);
+    RUN_TEST(test_unit_only_dirty_pixels_written);
+    RUN_TEST(test_unit_coalesce_within_frame);
+    RUN_TEST(test_unit_flush_now);
+    RUN_TEST(test_unit_state_patterns_vs_direct);
+    RUN_TEST(test_unit_multiple_writers_per_loop);
+
+    printf("\n========================================\n");
+    printf("LedCompositor 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_random_sequences);
+
+    return UNITY_END();
+}
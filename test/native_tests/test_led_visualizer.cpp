@@ -0,0 +1,405 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "AudioLevels.h"
+#include "LedStrip.h"
+#include "LedCompositor.h"
+#include "LedAnimation.h"
+#include "LedVisualizer.h"
+
+// ========================================
+// LedVisualizer 测试（主机端，native 环境）
+// 采集电平 -> 发布 -> LED 帧率包络 -> 动画图层，以及声音到灯光的端到端延迟
+// 运行：python tools/run_native_tests.py test_led_visualizer
+// ========================================
+
+static const uint32_t SAMPLE_RATE = 16000;
+static const uint16_t LED_COUNT = 5;
+static const uint32_t LED_TASK_MS = LED_FRAME_MS;   // 综合测试 LED_PERIOD_US：灯效任务每个 LED 帧运行一次
+
+class MockStrip : public LedStrip {
+public:
+    MockStrip() : shows(0) { memset(pixels, 0, sizeof(pixels)); }
+    uint16_t numPixels() const override { return LED_COUNT; }
+    void setPixelColor(uint16_t index, uint32_t color) override { pixels[index] = color; }
+    void show() override { shows++; }
+
+    uint32_t pixels[LED_COUNT];
+    uint32_t shows;
+};
+
+// 与综合测试一致：机身输入图层（绿色，监听状态）+ 瞳孔高频叠加
+struct Rig {
+    MockStrip strip;
+    LedCompositor frame;
+    LedAnimator anim;
+    LedVisualizer vis;
+    int8_t bodyLayer;
+    int8_t eyeLayer;
+    int8_t bodyBinding;
+    int8_t eyeBinding;
+
+    Rig() : frame(strip), anim(frame), vis(anim) {
+        uint8_t eye = (uint8_t)frame.defineZone("eye", 0, 2);
+        uint8_t body = (uint8_t)frame.defineZone("body", 2, 3);
+        bodyLayer = anim.addLayer(body, ledColor(0, 255, 0));
+        eyeLayer = anim.addLayer(eye, ledColor(255, 0, 0), nullptr, LED_BLEND_ADD, LED_FIXED_ONE / 2);
+        bodyBinding = vis.bind(bodyLayer, LED_VIS_LEVEL, 5, 250, 136);
+        eyeBinding = vis.bind(eyeLayer, LED_VIS_HIGH, 5, 150);
+    }
+
+    void tick(uint32_t nowMs) {
+        vis.update(nowMs);
+        anim.update(nowMs);
+        frame.flush(nowMs);
+    }
+};
+
+// 简单的伪随机数生成器（用于属性测试）
+static float testRandom(float min, float max) {
+    static unsigned long seed = 11235;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (max - min) * (seed / (float)0x7fffffff);
+}
+
+// 生成立体声交织采样（16位样本位于高16位，与 SPH0645 相同）
+static void makeTone(int32_t* out, size_t frames, float freq, float amplitude, size_t startSample = 0) {
+    for (size_t i = 0; i < frames; i++) {
+        float v = amplitude * sinf(2.0f * (float)M_PI * freq * (startSample + i) / SAMPLE_RATE);
+        int32_t s = (int32_t)v;
+        out[i * 2] = (int32_t)((uint32_t)s << 16);
+        out[i * 2 + 1] = (int32_t)((uint32_t)s << 16);
+    }
+}
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: 电平按 dBFS 映射（静音 0，-40dBFS ≈ 127，满量程 255）
+void test_unit_meter_db_mapping() {
+    AudioLevelMeter meter(SAMPLE_RATE);
+    static int32_t buf[256 * 2];
+
+    memset(buf, 0, sizeof(buf));
+    TEST_ASSERT_EQUAL(0, meter.measure(buf, 256, 0).level);
+
+    // 正弦 RMS = 峰值 / sqrt(2)；-40dBFS RMS = 327.68
+    makeTone(buf, 256, 1000, 327.68f * sqrtf(2.0f));
+    TEST_ASSERT_INT_WITHIN(3, 127, meter.measure(buf, 256, 16).level);
+
+    makeTone(buf, 256, 1000, 30000);
+    TEST_ASSERT_EQUAL(255, meter.measure(buf, 256, 32).level);
+
+    // 自噪声门控增益为0时电平为0
+    TEST_ASSERT_EQUAL(0, meter.measure(buf, 256, 48, 0.0f).level);
+}
+
+// 单元测试2: 低频音主要进入低频带，高频音主要进入高频带
+void test_unit_meter_bands() {
+    AudioLevelMeter meter(SAMPLE_RATE);
+    static int32_t buf[512 * 2];
+
+    makeTone(buf, 512, 150, 3000);
+    AudioLevelFrame low = meter.measure(buf, 512, 0);
+    TEST_ASSERT_TRUE(low.bands[AUDIO_LEVEL_LOW] > low.bands[AUDIO_LEVEL_HIGH] + 20);
+
+    meter.reset();
+    makeTone(buf, 512, 3000, 3000);
+    AudioLevelFrame high = meter.measure(buf, 512, 32);
+    TEST_ASSERT_TRUE(high.bands[AUDIO_LEVEL_HIGH] > high.bands[AUDIO_LEVEL_LOW] + 20);
+}
+
+// 单元测试3: 起音快、释放慢；输出不低于 floor
+void test_unit_attack_release() {
+    Rig rig;
+    rig.tick(0);
+    TEST_ASSERT_EQUAL(136, rig.vis.output(rig.bodyBinding));
+
+    AudioLevelFrame f = {0, 200, {200, 0}};
+    f.timeMs = 5;
+    rig.vis.publish(f);
+    rig.tick(10);
+    TEST_ASSERT_TRUE(rig.vis.envelope(rig.bodyBinding) >= 170);     // 5ms 起音：一帧到 86%
+
+    // 持续有声 100ms 后静音：释放 250ms，100ms 后仍在一半以上
+    for (uint32_t t = 20; t <= 100; t += 10) {
+        f.timeMs = t;
+        rig.vis.publish(f);
+        rig.tick(t);
+    }
+    for (uint32_t t = 110; t <= 200; t += 10) {
+        f.timeMs = t;
+        f.level = 0;
+        rig.vis.publish(f);
+        rig.tick(t);
+    }
+    uint8_t env = rig.vis.envelope(rig.bodyBinding);
+    TEST_ASSERT_TRUE(env > 100 && env < 200);
+    TEST_ASSERT_TRUE(rig.vis.output(rig.bodyBinding) >= 136);
+}
+
+// 单元测试4: 一帧 LED 内发布多帧时只用最新一帧
+void test_unit_latest_frame_only() {
+    Rig rig;
+    rig.tick(0);
+    AudioLevelFrame a = {1, 255, {0, 255}};
+    AudioLevelFrame b = {2, 0, {0, 0}};
+    rig.vis.publish(a);
+    rig.vis.publish(b);
+    rig.tick(10);
+
+    TEST_ASSERT_EQUAL(2, rig.vis.stats().consumed);
+    TEST_ASSERT_EQUAL(0, rig.vis.envelope(rig.bodyBinding));
+    TEST_ASSERT_EQUAL(8, rig.vis.stats().lastAgeMs);
+}
+
+// 单元测试5: 超过 staleMs 没有新帧时按释放衰减到 floor
+void test_unit_stale_decays() {
+    Rig rig;
+    rig.tick(0);
+    AudioLevelFrame f = {0, 255, {255, 255}};
+    rig.vis.publish(f);
+    rig.tick(10);
+    TEST_ASSERT_TRUE(rig.vis.envelope(rig.bodyBinding) > 200);
+
+    for (uint32_t t = 20; t <= 3000; t += 10) {
+        rig.tick(t);
+    }
+    TEST_ASSERT_EQUAL(0, rig.vis.envelope(rig.bodyBinding));
+    TEST_ASSERT_EQUAL(136, rig.vis.output(rig.bodyBinding));
+}
+
+// 单元测试6: 禁用的绑定不写图层；重新启用从 floor 开始
+void test_unit_disabled_binding() {
+    Rig rig;
+    rig.tick(0);
+    rig.vis.setEnabled(rig.bodyBinding, false);
+    rig.anim.setLevel(rig.bodyLayer, 255);
+
+    AudioLevelFrame f = {5, 0, {0, 0}};
+    rig.vis.publish(f);
+    rig.tick(10);
+    TEST_ASSERT_EQUAL(255, rig.anim.level(rig.bodyLayer));
+    TEST_ASSERT_EQUAL_HEX32(ledColor(0, 255, 0), rig.frame.pixel(2));
+
+    rig.vis.setEnabled(rig.bodyBinding, true);
+    rig.tick(20);
+    TEST_ASSERT_EQUAL(136, rig.anim.level(rig.bodyLayer));
+}
+
+// 端到端：语音大小的 1kHz 音在 onsetMs 出现，采集按 hopSamples 一段段发布，
+// 灯效任务每 ledPeriodMs 运行一次（相位 ledPhaseMs），返回机身亮度升过一半所用时间
+static float measureLatency(size_t hopSamples, uint32_t ledPeriodMs, float onsetMs, uint32_t ledPhaseMs) {
+    Rig rig;
+    AudioLevelMeter meter(SAMPLE_RATE);
+    static int32_t hop[512 * 2];
+
+    const size_t onsetSample = (size_t)(onsetMs * SAMPLE_RATE / 1000.0f);
+
+    // 稳态亮度：整段都是音
+    const uint8_t quiet = 136;
+    uint8_t steady = 0;
+    {
+        Rig ref;
+        AudioLevelMeter m(SAMPLE_RATE);
+        for (uint32_t t = 0; t < 500; t += 1) {
+            if (t % 16 == 0) {
+                makeTone(hop, 256, 1000, 3000, t * 16);
+                ref.vis.publish(m.measure(hop, 256, t));
+            }
+            if (t % ledPeriodMs == 0) {
+                ref.tick(t);
+            }
+        }
+        steady = ref.vis.output(ref.bodyBinding);
+    }
+    uint8_t threshold = quiet + (steady - quiet) / 2;
+
+    size_t nextSample = 0;
+    for (uint32_t t = ledPhaseMs; t < 1000 + ledPhaseMs; t++) {
+        // 采集：一段采满即处理并发布
+        while ((nextSample + hopSamples) * 1000.0f / SAMPLE_RATE <= t - ledPhaseMs) {
+            for (size_t i = 0; i < hopSamples; i++) {
+                size_t n = nextSample + i;
+                int32_t s = n >= onsetSample ? (int32_t)(3000 * sinf(2.0f * (float)M_PI * 1000 * n / SAMPLE_RATE)) : 0;
+                hop[i * 2] = (int32_t)((uint32_t)s << 16);
+                hop[i * 2 + 1] = (int32_t)((uint32_t)s << 16);
+            }
+            nextSample += hopSamples;
+            rig.vis.publish(meter.measure(hop, hopSamples, t));
+        }
+        if ((t - ledPhaseMs) % ledPeriodMs != 0) {
+            continue;   // 发布的电平要等到下一次灯效任务才被看到
+        }
+        rig.tick(t);
+
+        float now = (float)(t - ledPhaseMs);
+        if (now >= onsetMs && rig.anim.level(rig.bodyLayer) >= threshold) {
+            return now - onsetMs;
+        }
+    }
+    return 1e9f;
+}
+
+// 各种声音起点和灯效任务相位下的最坏延迟
+static float worstLatency(size_t hopSamples, uint32_t ledPeriodMs, float* average) {
+    float worst = 0, sum = 0;
+    int runs = 0;
+    for (uint32_t phase = 0; phase < ledPeriodMs; phase += 3) {
+        for (float onset = 200.0f; onset < 232.0f; onset += 1.7f) {
+            float latency = measureLatency(hopSamples, ledPeriodMs, onset, phase);
+            if (latency > worst) worst = latency;
+            sum += latency;
+            runs++;
+        }
+    }
+    if (average != nullptr) {
+        *average = sum / runs;
+    }
+    return worst;
+}
+
+// 单元测试7: 声音到灯光延迟——16ms 采集段 + 10ms 灯效任务 < 30ms；
+// 原来的 32ms 采集帧、或灯效任务降到 60Hz 都做不到
+void test_unit_sound_to_light_latency() {
+    float avg256 = 0;
+    float worst256 = worstLatency(256, LED_TASK_MS, &avg256);
+    float worst512 = worstLatency(512, LED_TASK_MS, nullptr);
+    float worst60Hz = worstLatency(256, 17, nullptr);
+    printf("  16ms 采集段 + %lums 灯效任务: 平均 %.1f ms，最坏 %.1f ms\n",
+           (unsigned long)LED_TASK_MS, avg256, worst256);
+    printf("  32ms 采集帧 + %lums 灯效任务: 最坏 %.1f ms\n", (unsigned long)LED_TASK_MS, worst512);
+    printf("  16ms 采集段 + 17ms 灯效任务（60Hz）: 最坏 %.1f ms\n", worst60Hz);
+    printf("  （另加 RMT 发送约 0.45 ms）\n");
+
+    TEST_ASSERT_TRUE(worst256 + 0.45f < 30.0f);
+    TEST_ASSERT_TRUE(worst512 > worst256);
+    TEST_ASSERT_TRUE(worst60Hz > worst256);
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 随机电平序列、随机发布/更新时刻：
+// - 包络每帧只向目标靠近，不越过目标
+// - 输出始终在 [floor, 255]，并写入了对应图层
+void test_property_envelope_bounded() {
+    printf("\n[Property Test] 随机电平/时序下包络有界且单调逼近 - 100次迭代\n");
+
+    for (int i = 0; i < 100; i++) {
+        Rig rig;
+        uint32_t t = 0;
+        rig.tick(t);
+        uint8_t target = 0;
+        bool fresh = false;
+
+        for (int op = 0; op < 200; op++) {
+            if (testRandom(0, 1) < 0.6f) {
+                target = (uint8_t)testRandom(0, 255);
+                AudioLevelFrame f = {t, target, {target, (uint8_t)(255 - target)}};
+                rig.vis.publish(f);
+                fresh = true;
+            }
+            uint8_t before = rig.vis.envelope(rig.bodyBinding);
+            t += (uint32_t)testRandom(1, 14);
+            rig.tick(t);
+            uint8_t after = rig.vis.envelope(rig.bodyBinding);
+
+            if (fresh) {
+                uint8_t lo = before < target ? before : target;
+                uint8_t hi = before < target ? target : before;
+                if (after < lo || after > hi) {
+                    char msg[96];
+                    snprintf(msg, sizeof(msg), "Iter %d: 包络 %u -> %u 越过目标 %u", i, before, after, target);
+                    TEST_FAIL_MESSAGE(msg);
+                }
+            }
+            uint8_t out = rig.vis.output(rig.bodyBinding);
+            if (out < 136) TEST_FAIL_MESSAGE("输出低于 floor");
+            if (rig.anim.level(rig.bodyLayer) != out) TEST_FAIL_MESSAGE("图层亮度与输出不一致");
+        }
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+
+    TEST_PASS();
+}
+
+// ========================================
+// 性能测试
+// ========================================
+
+// 性能1: 每段采集计算电平、每个 LED 帧更新包络的耗时
+void test_benchmark_costs() {
+    printf("\n[Benchmark] 电平计算与包络更新耗时\n");
+
+    AudioLevelMeter meter(SAMPLE_RATE);
+    static int32_t buf[256 * 2];
+    makeTone(buf, 256, 440, 2000);
+
+    const int RUNS = 20000;
+    uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < RUNS; r++) {
+        sink += meter.measure(buf, 256, r).level;
+    }
+    auto end = std::chrono::steady_clock::now();
+    double meterNs = std::chrono::duration<double, std::nano>(end - start).count() / RUNS;
+
+    Rig rig;
+    rig.tick(0);
+    start = std::chrono::steady_clock::now();
+    for (int r = 1; r <= RUNS; r++) {
+        AudioLevelFrame f = {(uint32_t)(r * 10), (uint8_t)(r * 7), {(uint8_t)r, (uint8_t)(r * 3)}};
+        rig.vis.publish(f);
+        rig.vis.update(r * 10);
+    }
+    end = std::chrono::steady_clock::now();
+    double visNs = std::chrono::duration<double, std::nano>(end - start).count() / RUNS;
+
+    printf("  电平计算（256 个立体声采样）: %.0f ns\n", meterNs);
+    printf("  包络更新（2 个绑定，每 LED 帧）: %.0f ns\n", visNs);
+    TEST_ASSERT_TRUE(sink > 0);
+    TEST_ASSERT_TRUE(visNs < 10000.0);
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("LedVisualizer 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_meter_db_mapping);
+    RUN_TEST(test_unit_meter_bands);
+    RUN_TEST(test_unit_attack_release);
+    RUN_TEST(test_unit_latest_frame_only);
+    RUN_TEST(test_unit_stale_decays);
+    RUN_TEST(test_unit_disabled_binding);
+    RUN_TEST(test_unit_sound_to_light_latency);
+
+    printf("\n========================================\n");
+    printf("LedVisualizer 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_envelope_bounded);
+
+    printf("\n========================================\n");
+    printf("LedVisualizer 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_costs);
+
+    return UNITY_END();
+}
@@ -0,0 +1,532 @@
+#define LOG_LEVEL LOG_LEVEL_DEBUG   // 本测试中 VERBOSE 必须被编译期去掉
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Log.h"
+#include "Telemetry.h"
+
+// ========================================
+// Log 测试（主机端，native 环境）
+// 编译期级别、延迟格式化与 printf 一致、覆盖与丢失计数、二进制导出、多线程写入
+// 运行：python tools/run_native_tests.py test_log
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 45610;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+static int sideEffects = 0;
+
+static int countedArg() {
+    sideEffects++;
+    return 7;
+}
+
+// 取出一条记录并格式化消息（不含时间和级别）
+static std::string formatOne(LogRing& ring) {
+    LogRecord r;
+    if (ring.drain(&r, 1) == 0) {
+        return "<empty>";
+    }
+    char line[256];
+    LogRing::formatRecord(r, line, sizeof(line));
+    return line;
+}
+
+// 写入后延迟格式化的结果必须与 snprintf 相同
+#define CHECK_FORMAT(ring, ...) do { \
+        char expected[256]; \
+        snprintf(expected, sizeof(expected), __VA_ARGS__); \
+        (ring).write(LOG_LEVEL_INFO, __VA_ARGS__); \
+        TEST_ASSERT_EQUAL_STRING(expected, formatOne(ring).c_str()); \
+    } while (0)
+
+// 主机端解码导出的帧（与 tools/telemetry_decode.py 相同的步骤），还原记录后用同一个格式化函数输出
+struct FrameDecoder {
+    std::map<uint16_t, std::string> formats;
+    std::vector<std::string> strings;   // 还原的 %s 参数（保持指针有效）
+    std::vector<std::string> lines;
+    std::vector<uint8_t> seqs;
+    int formatFrames = 0;
+    int bad = 0;
+
+    void feed(const uint8_t* data, size_t length) {
+        std::vector<uint8_t> chunk;
+        for (size_t i = 0; i < length; i++) {
+            if (data[i] != 0) {
+                chunk.push_back(data[i]);
+                continue;
+            }
+            if (!chunk.empty()) {
+                frame(chunk);
+                chunk.clear();
+            }
+        }
+    }
+
+    void frame(const std::vector<uint8_t>& chunk) {
+        uint8_t raw[512];
+        size_t n = TelemetryChannel::cobsDecode(chunk.data(), chunk.size(), raw);
+        if (n < TELEMETRY_FRAME_HEADER + 2 ||
+            TelemetryChannel::fletcher16(raw, n - 2) != (uint16_t)(raw[n - 2] | (raw[n - 1] << 8))) {
+            bad++;
+            return;
+        }
+        seqs.push_back(raw[1]);
+        const uint8_t* p = raw + TELEMETRY_FRAME_HEADER;
+        size_t plen = n - 2 - TELEMETRY_FRAME_HEADER;
+        uint16_t id = (uint16_t)(p[0] | (p[1] << 8));
+        if (raw[0] == TELEMETRY_TYPE_LOG_FORMAT) {
+            formats[id] = std::string((const char*)p + 2, plen - 2);
+            formatFrames++;
+            return;
+        }
+        if (raw[0] != TELEMETRY_TYPE_LOG || formats.count(id) == 0) {
+            bad++;
+            return;
+        }
+        LogRecord r;
+        memset(&r, 0, sizeof(r));
+        r.format = formats[id].c_str();
+        r.timeMs = (uint32_t)raw[2] | ((uint32_t)raw[3] << 8) | ((uint32_t)raw[4] << 16) | ((uint32_t)raw[5] << 24);
+        r.level = p[2];
+        r.argc = p[3];
+        size_t k = 4;
+        strings.reserve(1024);
+        for (uint8_t i = 0; i < r.argc; i++) {
+            r.types[i] = p[k++];
+            if (r.types[i] == LOG_ARG_STR) {
+                uint8_t len = p[k++];
+                strings.push_back(std::string((const char*)p + k, len));
+                r.args[i] = (uintptr_t)strings.back().c_str();
+                k += len;
+            } else {
+                uint32_t v = (uint32_t)p[k] | ((uint32_t)p[k + 1] << 8) | ((uint32_t)p[k + 2] << 16) |
+                             ((uint32_t)p[k + 3] << 24);
+                r.args[i] = r.types[i] == LOG_ARG_INT ? (uintptr_t)(intptr_t)(int32_t)v : (uintptr_t)v;
+                k += 4;
+            }
+        }
+        char line[256];
+        LogRing::formatRecord(r, line, sizeof(line));
+        lines.push_back(line);
+    }
+};
+
+// ========== 单元测试 ==========
+
+// 单元测试1: 编译期级别：关闭的级别参数不求值、不写入；打开的级别写入一条带级别的记录
+void test_unit_level_elimination() {
+    LogStats before = logRing.stats();
+    sideEffects = 0;
+    LOG_VERBOSE("不会出现 %d", countedArg());
+    TEST_ASSERT_EQUAL(0, sideEffects);
+    TEST_ASSERT_EQUAL(before.written, logRing.stats().written);
+
+    LOG_DEBUG("调试 %d", countedArg());
+    LOG_INFO("信息");
+    LOG_WARN("警告 %s", "w");
+    LOG_ERROR("错误 %.1f", 1.5);
+    TEST_ASSERT_EQUAL(1, sideEffects);
+    TEST_ASSERT_EQUAL(before.written + 4, logRing.stats().written);
+
+    LogRecord r[8];
+    size_t n = logRing.drain(r, 8);
+    TEST_ASSERT_EQUAL(4, n);
+    TEST_ASSERT_EQUAL(LOG_LEVEL_DEBUG, r[0].level);
+    TEST_ASSERT_EQUAL(LOG_LEVEL_INFO, r[1].level);
+    TEST_ASSERT_EQUAL(0, r[1].argc);
+    TEST_ASSERT_EQUAL(LOG_LEVEL_WARN, r[2].level);
+    TEST_ASSERT_EQUAL(LOG_ARG_STR, r[2].types[0]);
+    TEST_ASSERT_EQUAL(LOG_LEVEL_ERROR, r[3].level);
+    TEST_ASSERT_EQUAL(LOG_ARG_FLOAT, r[3].types[0]);
+    TEST_ASSERT_EQUAL('D', LogRing::levelChar(LOG_LEVEL_DEBUG));
+    TEST_ASSERT_EQUAL('E', LogRing::levelChar(LOG_LEVEL_ERROR));
+}
+
+// 单元测试2: 延迟格式化与 snprintf 相同：整数（有/无符号、长度修饰）、标志/宽度/精度、浮点、字符、字符串、%%
+void test_unit_format_matches_printf() {
+    static LogRing ring;
+    CHECK_FORMAT(ring, "[STATE] 检测到声音！峰值: %.0f (阈值: %.0f)", 1234.5, 100.0);
+    CHECK_FORMAT(ring, "[LOCATE] 转向完成: H=%ld°", (long)-30);
+    CHECK_FORMAT(ring, "%d %i %u %x %X %o", -42, 17, 4000000000u, 255, 0xBEEF, 8);
+    CHECK_FORMAT(ring, "%x %u", -1, -1);   // 负的 int 按 32 位无符号
+    CHECK_FORMAT(ring, "%ld %lu %lx", -123456789L, 123456789UL, 0xABCDEFUL);
+    CHECK_FORMAT(ring, "[%5d] [%-5d] [%05d] [%+d] [% d]", 42, 42, 42, 42, 42);
+    CHECK_FORMAT(ring, "%.2f %8.3f %-8.1f| %e %g %G", 3.25f, -2.5f, 0.5f, 1024.0f, 0.0001f, 1e10f);
+    CHECK_FORMAT(ring, "%c%c %s [%8s] [%-6s] [%.3s]", 'O', 'K', "状态", "LISTEN", "IDLE", "ACTIVE");
+    CHECK_FORMAT(ring, "100%% 完成，%hhu %hu %zu", (unsigned char)200, (unsigned short)60000, (size_t)4096);
+    CHECK_FORMAT(ring, "%d %d %d %d %d %d", 1, 2, 3, 4, 5, 6);
+    CHECK_FORMAT(ring, "没有参数");
+    const char* nullName = nullptr;
+    ring.write(LOG_LEVEL_INFO, "名称 %s", nullName);
+    TEST_ASSERT_EQUAL_STRING("名称 (null)", formatOne(ring).c_str());
+}
+
+// 单元测试3: 行格式（秒.毫秒 级别 消息）、截断、参数不够和不支持的转换原样输出
+void test_unit_format_next_and_edges() {
+    static LogRing ring;
+    char line[128];
+    TEST_ASSERT_EQUAL(0, ring.formatNext(line, sizeof(line)));
+
+    ring.write(LOG_LEVEL_WARN, "队列 %s 丢弃 %lu 个", "frames", 3UL);
+    size_t n = ring.formatNext(line, sizeof(line));
+    TEST_ASSERT_EQUAL(strlen(line), n);
+    printf("  %s\n", line);
+    const char* msg = strstr(line, " W ");
+    TEST_ASSERT_NOT_NULL(msg);
+    TEST_ASSERT_EQUAL_STRING("队列 frames 丢弃 3 个", msg + 3);
+    TEST_ASSERT_NOT_NULL(strchr(line, '.'));   // 秒.毫秒
+
+    // 截断：不越界，结尾为 0
+    ring.write(LOG_LEVEL_INFO, "%s %s %s", "aaaaaaaaaa", "bbbbbbbbbb", "cccccccccc");
+    char small[16];
+    memset(small, 'X', sizeof(small));
+    n = ring.formatNext(small, sizeof(small));
+    TEST_ASSERT_EQUAL(sizeof(small) - 1, n);
+    TEST_ASSERT_EQUAL(0, small[sizeof(small) - 1]);
+
+    // 参数不够、'*' 宽度：原样输出转换说明
+    LogArg one = logArg(5);
+    ring.append(LOG_LEVEL_INFO, "%d %d", &one, 1);
+    TEST_ASSERT_EQUAL_STRING("5 %d", formatOne(ring).c_str());
+    ring.append(LOG_LEVEL_INFO, "[%*d]", &one, 1);
+    TEST_ASSERT_EQUAL_STRING("[%*d]", formatOne(ring).c_str());
+    ring.append(LOG_LEVEL_INFO, "结尾 %", nullptr, 0);
+    TEST_ASSERT_EQUAL_STRING("结尾 %", formatOne(ring).c_str());
+}
+
+// 单元测试4: 写满后覆盖最旧的记录：读到最新的 LOG_RING_SIZE 条，其余计入丢失
+void test_unit_overwrite_and_lost() {
+    static LogRing ring;
+    const int total = LOG_RING_SIZE + 10;
+    for (int i = 0; i < total; i++) {
+        ring.write(LOG_LEVEL_INFO, "第 %d 条", i);
+    }
+    static LogRecord r[LOG_RING_SIZE + 16];
+    size_t n = ring.drain(r, LOG_RING_SIZE + 16);
+    TEST_ASSERT_EQUAL(LOG_RING_SIZE, n);
+    TEST_ASSERT_EQUAL(10, (int)(intptr_t)r[0].args[0]);
+    TEST_ASSERT_EQUAL(total - 1, (int)(intptr_t)r[n - 1].args[0]);
+
+    LogStats st = ring.stats();
+    TEST_ASSERT_EQUAL(total, st.written);
+    TEST_ASSERT_EQUAL(LOG_RING_SIZE, st.read);
+    TEST_ASSERT_EQUAL(10, st.lost);
+    TEST_ASSERT_EQUAL(0, ring.drain(r, 1));
+}
+
+// 单元测试5: 二进制导出：格式串只发一次，记录帧中字符串按内容发送；主机端还原的文本与设备端格式化相同
+void test_unit_export_frames() {
+    static LogRing ring;
+    static const char* const names[] = {"IDLE", "LISTENING"};
+    uint8_t buffer[512];
+    FrameDecoder decoder;
+    TEST_ASSERT_EQUAL(0, ring.exportFrames(buffer, sizeof(buffer)));
+
+    for (int i = 0; i < 3; i++) {
+        ring.write(LOG_LEVEL_INFO, "[FSM] %s → %s（%d）", names[i % 2], names[(i + 1) % 2], i);
+    }
+    ring.write(LOG_LEVEL_WARN, "[WARN] 音量 %.1f 超过 %u", 1500.5f, 1000u);
+    size_t n = ring.exportFrames(buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(n > 0);
+    TEST_ASSERT_EQUAL(0, buffer[0]);
+    decoder.feed(buffer, n);
+    TEST_ASSERT_EQUAL(0, decoder.bad);
+    TEST_ASSERT_EQUAL(2, decoder.formatFrames);   // 两个格式串
+    TEST_ASSERT_EQUAL(4, decoder.lines.size());
+    TEST_ASSERT_EQUAL_STRING("[FSM] LISTENING → IDLE（1）", decoder.lines[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("[WARN] 音量 1500.5 超过 1000", decoder.lines[3].c_str());
+    for (size_t i = 1; i < decoder.seqs.size(); i++) {
+        TEST_ASSERT_EQUAL((uint8_t)(decoder.seqs[i - 1] + 1), decoder.seqs[i]);
+    }
+
+    // 已发过的格式串不再发送；resendFormats 后重新发送
+    ring.write(LOG_LEVEL_INFO, "[FSM] %s → %s（%d）", names[0], names[1], 9);
+    decoder.feed(buffer, ring.exportFrames(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL(2, decoder.formatFrames);
+    ring.resendFormats();
+    ring.write(LOG_LEVEL_INFO, "[FSM] %s → %s（%d）", names[1], names[0], 10);
+    decoder.feed(buffer, ring.exportFrames(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL(3, decoder.formatFrames);
+    TEST_ASSERT_EQUAL_STRING("[FSM] LISTENING → IDLE（10）", decoder.lines.back().c_str());
+
+    // 缓冲只够一帧：放不下的记录留到下一批，不丢失
+    for (int i = 0; i < 5; i++) {
+        ring.write(LOG_LEVEL_INFO, "[FSM] %s → %s（%d）", names[0], names[0], 100 + i);
+    }
+    size_t before = decoder.lines.size();
+    int batches = 0;
+    while ((n = ring.exportFrames(buffer, 48)) > 0) {
+        decoder.feed(buffer, n);
+        batches++;
+    }
+    TEST_ASSERT_EQUAL(before + 5, decoder.lines.size());
+    TEST_ASSERT_EQUAL(5, batches);
+    TEST_ASSERT_EQUAL_STRING("[FSM] IDLE → IDLE（104）", decoder.lines.back().c_str());
+}
+
+// 单元测试6: 三个线程同时写、主线程同时格式化：同一线程的记录按顺序，读到的加丢失等于写入
+void test_unit_concurrent_writers() {
+    static LogRing ring;
+    const int perThread = 30000;
+    std::atomic<int> running(3);
+
+    auto writer = [&](int id) {
+        for (int i = 0; i < perThread; i++) {
+            ring.write(LOG_LEVEL_DEBUG, "线程 %d 第 %d 条 %s", id, i, "x");
+            if ((i & 63) == 0) {
+                std::this_thread::yield();
+            }
+        }
+        running--;
+    };
+    std::thread a(writer, 0);
+    std::thread b(writer, 1);
+    std::thread c(writer, 2);
+
+    int last[3] = {-1, -1, -1};
+    bool ordered = true;
+    bool wellFormed = true;
+    uint32_t lines = 0;
+    char line[128];
+    auto consume = [&]() {
+        size_t n;
+        while ((n = ring.formatNext(line, sizeof(line))) > 0) {
+            int id, i;
+            const char* msg = strstr(line, " D ");
+            if (msg == nullptr || sscanf(msg + 3, "线程 %d 第 %d 条", &id, &i) != 2 || id < 0 || id > 2) {
+                wellFormed = false;
+                continue;
+            }
+            if (i <= last[id]) ordered = false;
+            last[id] = i;
+            lines++;
+        }
+    };
+    while (running > 0) {
+        consume();
+    }
+    a.join();
+    b.join();
+    c.join();
+    consume();
+
+    LogStats st = ring.stats();
+    printf("  写入 %lu 条，格式化 %lu 条，丢失 %lu 条\n", (unsigned long)st.written, (unsigned long)lines,
+           (unsigned long)st.lost);
+    TEST_ASSERT_TRUE(wellFormed);
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_EQUAL(3 * perThread, st.written);
+    TEST_ASSERT_EQUAL(st.written, lines + st.lost);
+}
+
+// ========== 属性测试 ==========
+
+// 随机的一个转换说明和参数；expected 为 snprintf 的结果
+static void randomPiece(std::string& fmt, LogArg& arg, std::string& expected, std::vector<std::string>& keep) {
+    static const char* const words[] = {"IDLE", "监听", "", "ACTIVE!", "a b c"};
+    char flags[8] = "";
+    int f = 0;
+    if (testRandomInt(0, 3) == 0) flags[f++] = "-+ 0#"[testRandomInt(0, 4)];
+    flags[f] = '\0';
+    char width[8] = "";
+    if (testRandomInt(0, 2) == 0) snprintf(width, sizeof(width), "%d", testRandomInt(1, 12));
+    char precision[8] = "";
+    if (testRandomInt(0, 2) == 0) snprintf(precision, sizeof(precision), ".%d", testRandomInt(0, 6));
+
+    char spec[32];
+    char out[128];
+    switch (testRandomInt(0, 4)) {
+        case 0: {
+            int v = testRandomInt(-2000000, 2000000) * (testRandomInt(0, 1) ? 1000 : 1);
+            const char conv = "di"[testRandomInt(0, 1)];
+            snprintf(spec, sizeof(spec), "%%%s%s%s%c", flags, width, precision, conv);
+            snprintf(out, sizeof(out), spec, v);
+            arg = logArg(v);
+            break;
+        }
+        case 1: {
+            unsigned v = (unsigned)testRandomInt(0, 0x3FFFFFFF) * (unsigned)testRandomInt(1, 4);
+            const char conv = "uxXo"[testRandomInt(0, 3)];
+            snprintf(spec, sizeof(spec), "%%%s%s%s%c", flags, width, precision, conv);
+            snprintf(out, sizeof(out), spec, v);
+            arg = logArg(v);
+            break;
+        }
+        case 2: {
+            float v = (float)testRandomInt(-100000, 100000) / (float)testRandomInt(1, 1000);
+            const char conv = "fFeEgG"[testRandomInt(0, 5)];
+            snprintf(spec, sizeof(spec), "%%%s%s%s%c", flags, width, precision, conv);
+            snprintf(out, sizeof(out), spec, (double)v);
+            arg = logArg(v);
+            break;
+        }
+        case 3: {
+            keep.push_back(words[testRandomInt(0, 4)]);
+            const char* v = keep.back().c_str();
+            snprintf(spec, sizeof(spec), "%%%s%s%ss", flags[0] == '-' ? "-" : "", width, precision);
+            snprintf(out, sizeof(out), spec, v);
+            arg = logArg(v);
+            break;
+        }
+        default: {
+            int v = testRandomInt(33, 126);
+            snprintf(spec, sizeof(spec), "%%%sc", width);
+            snprintf(out, sizeof(out), spec, v);
+            arg = logArg(v);
+            break;
+        }
+    }
+    fmt += spec;
+    expected += out;
+}
+
+// 属性测试1: 随机格式串（随机的标志/宽度/精度/类型组合，夹着文字和 %%）：
+// 设备端格式化、以及经二进制导出后主机端还原的结果都与 snprintf 相同
+void test_property_matches_printf() {
+    printf("\n[Property Test] 延迟格式化与 printf 一致 - 100次迭代\n");
+    static LogRing ring;
+    FrameDecoder decoder;
+    uint8_t buffer[512];
+
+    for (int iter = 0; iter < 100; iter++) {
+        std::string fmt = "T";
+        std::string expected = "T";
+        std::vector<std::string> keep;
+        keep.reserve(LOG_MAX_ARGS);
+        LogArg args[LOG_MAX_ARGS];
+        int argc = testRandomInt(0, LOG_MAX_ARGS);
+        for (int i = 0; i < argc; i++) {
+            bool percent = testRandomInt(0, 3) == 0;
+            fmt += percent ? " 100%% " : " ";
+            expected += percent ? " 100% " : " ";
+            randomPiece(fmt, args[i], expected, keep);
+        }
+
+        ring.append(LOG_LEVEL_INFO, fmt.c_str(), args, (uint8_t)argc);
+        ring.append(LOG_LEVEL_INFO, fmt.c_str(), args, (uint8_t)argc);
+        TEST_ASSERT_EQUAL_STRING(expected.c_str(), formatOne(ring).c_str());
+
+        // 每次迭代的格式串地址不同：重新发送格式串，主机端按编号覆盖
+        ring.resendFormats();
+        size_t before = decoder.lines.size();
+        size_t n;
+        while ((n = ring.exportFrames(buffer, sizeof(buffer))) > 0) {
+            decoder.feed(buffer, n);
+        }
+        TEST_ASSERT_EQUAL(0, decoder.bad);
+        TEST_ASSERT_EQUAL(before + 1, decoder.lines.size());
+        TEST_ASSERT_EQUAL_STRING(expected.c_str(), decoder.lines.back().c_str());
+
+        if ((iter + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", iter + 1);
+        }
+    }
+}
+
+// ========== 性能测试 ==========
+
+// 调用方的开销：LOG_INFO（只写原始参数）对比 snprintf 同一行；读取方格式化和导出的开销与字节数
+void test_benchmark_log_vs_printf() {
+    printf("\n[Benchmark] 写入开销与 snprintf 对比\n");
+    const int rounds = 100000;
+    char line[128];
+    volatile size_t sink = 0;
+    float volume = 1234.5f;
+
+    double logNs = 0;
+    double formatNs = 0;
+    double exportNs = 0;
+    size_t textBytes = 0;
+    size_t binaryBytes = 0;
+    uint8_t buffer[1024];
+    logRing.resendFormats();
+    for (int i = 0; i < rounds; i += 64) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (int k = 0; k < 64; k++) {
+            volume += 1.0f;
+            LOG_INFO("[STATE] 检测到声音！峰值: %.0f (阈值: %.0f) 方向 %d", volume, 100.0f, -30);
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        // 一半格式化为文本，一半导出为帧
+        for (int k = 0; k < 32; k++) {
+            textBytes += logRing.formatNext(line, sizeof(line)) + 2;
+        }
+        auto t2 = std::chrono::high_resolution_clock::now();
+        size_t n;
+        while ((n = logRing.exportFrames(buffer, sizeof(buffer))) > 0) {
+            binaryBytes += n;
+        }
+        auto t3 = std::chrono::high_resolution_clock::now();
+        logNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        formatNs += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        exportNs += std::chrono::duration<double, std::nano>(t3 - t2).count();
+    }
+    int loops = (rounds + 63) / 64;
+    logNs /= loops * 64;
+    formatNs /= loops * 32;
+    exportNs /= loops * 32;
+
+    auto t4 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        volume += 1.0f;
+        sink = sink + (size_t)snprintf(line, sizeof(line), "[STATE] 检测到声音！峰值: %.0f (阈值: %.0f) 方向 %d",
+                                       volume, 100.0f, -30);
+    }
+    auto t5 = std::chrono::high_resolution_clock::now();
+    double printfNs = std::chrono::duration<double, std::nano>(t5 - t4).count() / rounds;
+
+    LogStats st = logRing.stats();
+    printf("  LOG_INFO：%.1f ns/条；snprintf：%.1f ns/行（%.1fx）\n", logNs, printfNs, printfNs / logNs);
+    printf("  读取方：格式化 %.1f ns/条（%.1f 字节/行），导出 %.1f ns/条（%.1f 字节/条）\n", formatNs,
+           (double)textBytes / (loops * 32), exportNs, (double)binaryBytes / (loops * 32));
+    printf("  丢失 %lu 条；环形缓冲 %lu 字节（%d 条）\n", (unsigned long)st.lost,
+           (unsigned long)sizeof(LogRing), LOG_RING_SIZE);
+    TEST_ASSERT_EQUAL(0, st.lost);
+    TEST_ASSERT_TRUE(logNs < printfNs);
+}
+
+// ========================================
+// 主函数
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("Log 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_level_elimination);
+    RUN_TEST(test_unit_format_matches_printf);
+    RUN_TEST(test_unit_format_next_and_edges);
+    RUN_TEST(test_unit_overwrite_and_lost);
+    RUN_TEST(test_unit_export_frames);
+    RUN_TEST(test_unit_concurrent_writers);
+
+    printf("\n========================================\n");
+    printf("Log 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_matches_printf);
+
+    printf("\n========================================\n");
+    printf("Log 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_log_vs_printf);
+
+    return UNITY_END();
+}
@@ -0,0 +1,429 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "HostU8g2.h"
+#include "HostFont.h"
+#include "GlyphCache.h"
+#include "U8g2Font.h"
+#include "OledScreens.h"
+
+// ========================================
+// OledScreens 测试（主机端，native 环境）
+// 主机帧缓冲显示 HostU8g2：U8g2 绘图算法、快照、总线字节；OLED 测试界面与金样图像比较
+// 运行：python tools/run_native_tests.py test_oled_screens
+// 更新金样：UPDATE_GOLDEN=1 python tools/run_native_tests.py test_oled_screens
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 26457;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+static int countPixels(const uint8_t* buffer) {
+    int n = 0;
+    for (int i = 0; i < DISPLAY_BUFFER_SIZE; i++) {
+        for (uint8_t b = buffer[i]; b; b >>= 1) n += b & 1;
+    }
+    return n;
+}
+
+static bool pixelAt(const uint8_t* buffer, int x, int y) {
+    return (buffer[(y >> 3) * DISPLAY_WIDTH + x] >> (y & 7)) & 1;
+}
+
+// 金样目录：与本文件同目录下的 golden/
+static std::string goldenPath(const char* name, const char* ext) {
+    std::string dir = __FILE__;
+    size_t slash = dir.find_last_of("/\\");
+    dir = slash == std::string::npos ? std::string(".") : dir.substr(0, slash);
+    return dir + "/golden/" + name + ext;
+}
+
+// ========== 界面 ==========
+
+// 与设备端相同：中文经字形缓存绘制，界面字体为主机合成字体（见 HostFont.h）
+struct HostScreens {
+    HostU8g2 display;
+    GlyphCache cjk;
+    OledFonts fonts;
+
+    HostScreens() : cjk(hostFontCjk14()) {
+        fonts.text = hostFontCjk14();
+        fonts.digits = hostFontDigits16();
+        display.begin();
+    }
+
+    // 返回给 OledScreens 的中文绘制函数
+    struct Text {
+        HostScreens* s;
+        int operator()(int x, int y, const char* str) const {
+            return s->cjk.drawUTF8(s->display.getBufferPtr(), (int16_t)x, (int16_t)y, str);
+        }
+    };
+    Text text() { return Text{this}; }
+
+    // 按编号画一屏（每屏从清屏开始，与 test_oled_display.cpp 各测试的最终画面相同）
+    void render(int screen) {
+        display.clearBuffer();
+        switch (screen) {
+            case 0: oledDrawBoot(display, fonts, text()); break;
+            case 1: oledDrawBasicChinese(display, fonts, text()); break;
+            case 2: oledDrawSystemStatus(display, fonts, text()); break;
+            case 3: oledDrawMenu(display, fonts, text()); break;
+            case 4: oledDrawMixedText(display, fonts, text()); break;
+            case 5:
+                oledDrawLoadingTitle(display, fonts, text());
+                oledDrawProgress(display, fonts, 65);
+                break;
+            case 6: oledDrawLoaded(display, fonts, text()); break;
+            case 7:
+                oledDrawVolumeTitle(display, fonts, text());
+                oledDrawVolume(display, fonts, 75);
+                break;
+            case 8: oledDrawClock(display, fonts, text(), 42); break;
+            case 9: oledDrawDashboard(display, fonts, text()); break;
+        }
+        display.sendBuffer();
+    }
+};
+
+static const char* SCREEN_NAMES[] = {
+    "boot", "basic_chinese", "system_status", "menu", "mixed_text",
+    "progress", "loaded", "volume", "clock", "dashboard"
+};
+static const int SCREEN_COUNT = sizeof(SCREEN_NAMES) / sizeof(SCREEN_NAMES[0]);
+
+// ========== 单元测试 ==========
+
+// 测试1：直线、矩形、圆与 U8g2 算法的已知结果一致
+void test_unit_primitives() {
+    HostU8g2 d;
+    uint8_t* buf = d.getBufferPtr();
+
+    // 横线含两端：U8g2 drawLine(0,15,128,15) 画 0~127（128 在屏幕外被裁掉）
+    d.clearBuffer();
+    d.drawLine(0, 15, 128, 15);
+    TEST_ASSERT_EQUAL(128, countPixels(buf));
+    TEST_ASSERT_TRUE(pixelAt(buf, 0, 15));
+    TEST_ASSERT_TRUE(pixelAt(buf, 127, 15));
+
+    // 斜线：长轴每步一点
+    d.clearBuffer();
+    d.drawLine(2, 3, 12, 7);
+    TEST_ASSERT_EQUAL(11, countPixels(buf));
+    TEST_ASSERT_TRUE(pixelAt(buf, 2, 3));
+    TEST_ASSERT_TRUE(pixelAt(buf, 12, 7));
+
+    // 矩形框：周长像素，角点不重复（异或模式画一次不留空洞）
+    d.clearBuffer();
+    d.setDrawColor(2);
+    d.drawFrame(10, 25, 108, 15);
+    d.setDrawColor(1);
+    TEST_ASSERT_EQUAL(2 * 108 + 2 * 13, countPixels(buf));
+    TEST_ASSERT_TRUE(pixelAt(buf, 10, 25));
+    TEST_ASSERT_TRUE(pixelAt(buf, 117, 39));
+
+    // 实心矩形，再用颜色 0 挖掉中间
+    d.clearBuffer();
+    d.drawBox(0, 0, 10, 10);
+    d.setDrawColor(0);
+    d.drawBox(2, 2, 6, 6);
+    d.setDrawColor(1);
+    TEST_ASSERT_EQUAL(100 - 36, countPixels(buf));
+
+    // 圆：半径 5 的 U8g2 圆共 28 个点，上下左右四个顶点
+    d.clearBuffer();
+    d.drawCircle(30, 30, 5);
+    TEST_ASSERT_EQUAL(28, countPixels(buf));
+    TEST_ASSERT_TRUE(pixelAt(buf, 30, 25));
+    TEST_ASSERT_TRUE(pixelAt(buf, 35, 30));
+    TEST_ASSERT_TRUE(pixelAt(buf, 30, 35));
+    TEST_ASSERT_TRUE(pixelAt(buf, 25, 30));
+
+    // 实心圆包含同半径圆的全部点
+    uint8_t circle[DISPLAY_BUFFER_SIZE];
+    memcpy(circle, buf, sizeof(circle));
+    d.clearBuffer();
+    d.drawDisc(30, 30, 5);
+    for (int i = 0; i < DISPLAY_BUFFER_SIZE; i++) {
+        TEST_ASSERT_EQUAL_HEX8(circle[i], circle[i] & buf[i]);
+    }
+    TEST_ASSERT_TRUE(pixelAt(buf, 30, 30));
+
+    // 屏幕外的部分被裁掉，不越界
+    d.clearBuffer();
+    d.drawBox(-5, -5, 200, 200);
+    TEST_ASSERT_EQUAL(DISPLAY_WIDTH * DISPLAY_HEIGHT, countPixels(buf));
+}
+
+// 测试2：文字绘制与 U8g2 字体解码、GlyphCache 结果一致
+void test_unit_text() {
+    HostU8g2 d;
+    uint8_t* buf = d.getBufferPtr();
+    const uint8_t* font = hostFontCjk14();
+    d.setFont(font);
+
+    // 透明模式与 u8g2FontDrawUTF8（U8g2 drawUTF8 的对照实现）逐像素相同
+    const char* str = "温度:42°C";
+    uint8_t expected[DISPLAY_BUFFER_SIZE] = {0};
+    int16_t w0 = u8g2FontDrawUTF8(expected, font, 5, 61, str);
+    d.setFontMode(1);
+    d.clearBuffer();
+    int16_t w1 = d.drawUTF8(5, 61, str);
+    TEST_ASSERT_EQUAL(w0, w1);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buf, DISPLAY_BUFFER_SIZE);
+
+    // GlyphCache 画出的结果也相同
+    GlyphCache cjk(font);
+    uint8_t cached[DISPLAY_BUFFER_SIZE] = {0};
+    TEST_ASSERT_EQUAL(w0, cjk.drawUTF8(cached, 5, 61, str));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, cached, DISPLAY_BUFFER_SIZE);
+
+    // 宽度：前面各字步进 + 最后一个字的实际宽度（u8g2_string_width）
+    TEST_ASSERT_EQUAL(7 + 7 + 6, d.getStrWidth("AB1"));
+    TEST_ASSERT_EQUAL(14 + 7 + 6, d.getUTF8Width("中:C"));
+    TEST_ASSERT_EQUAL(0, d.getStrWidth(""));
+
+    // drawStr 按字节解释：中文不会被画出
+    d.clearBuffer();
+    TEST_ASSERT_EQUAL(0, d.drawStr(0, 20, "中"));
+    TEST_ASSERT_EQUAL(0, countPixels(buf));
+
+    // 实心模式：字形框内的 0 被清掉
+    d.clearBuffer();
+    d.drawBox(0, 0, 20, 20);
+    d.setFontMode(0);
+    d.drawStr(0, 15, "A");
+    int solid = countPixels(buf);
+    d.clearBuffer();
+    d.drawStr(0, 15, "A");
+    int glyphOnly = countPixels(buf);
+    TEST_ASSERT_EQUAL(400 - 6 * 10 + glyphOnly, solid);
+}
+
+// 测试3：整帧和局部发送的总线字节、屏幕显存
+void test_unit_bus_bytes() {
+    HostU8g2 d;
+    d.begin();
+    TEST_ASSERT_EQUAL(0, d.stats().frames);
+
+    d.clearBuffer();
+    d.drawBox(0, 0, 64, 32);
+    d.sendBuffer();
+    TEST_ASSERT_EQUAL(1, d.stats().frames);
+    TEST_ASSERT_EQUAL(RecordingTileTransport::fullFrameBytes(), d.stats().lastBusBytes);
+    TEST_ASSERT_EQUAL(1160, d.panel.bytes);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(d.getBufferPtr(), d.panel.screen, DISPLAY_BUFFER_SIZE);
+
+    // 局部发送：只有覆盖的块写进显存
+    d.drawBox(120, 56, 8, 8);
+    d.updateDisplayArea(15, 7, 1, 1);
+    TEST_ASSERT_EQUAL(RecordingTileTransport::busBytes(1), d.stats().lastBusBytes);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, d.panel.screen[7 * DISPLAY_WIDTH + 127]);
+
+    // 超出屏幕的块数被截掉
+    d.updateDisplayArea(14, 6, 4, 4);
+    TEST_ASSERT_EQUAL(2 * RecordingTileTransport::busBytes(2), d.stats().lastBusBytes);
+    TEST_ASSERT_EQUAL(0, d.panel.outOfRange);
+
+    TEST_ASSERT_EQUAL(3, d.stats().frames);
+    TEST_ASSERT_EQUAL(d.panel.bytes, d.stats().busBytes);
+    TEST_ASSERT_TRUE(d.stats().cpuUs >= 0);
+}
+
+// 测试4：PBM 写入读回一致，PNG 文件结构正确
+void test_unit_snapshot_files() {
+    HostU8g2 d;
+    d.clearBuffer();
+    d.drawCircle(64, 32, 20);
+    d.drawLine(0, 0, 127, 63);
+
+    const char* pbm = "test_oled_screens_snapshot.pbm";
+    const char* png = "test_oled_screens_snapshot.png";
+    TEST_ASSERT_TRUE(framebufferWritePbm(pbm, d.getBufferPtr()));
+    uint8_t back[DISPLAY_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(framebufferReadPbm(pbm, back));
+    TEST_ASSERT_EQUAL(0, framebufferDiff(d.getBufferPtr(), back));
+
+    TEST_ASSERT_TRUE(framebufferWritePng(png, d.getBufferPtr()));
+    FILE* f = fopen(png, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    uint8_t head[24];
+    TEST_ASSERT_EQUAL(24, fread(head, 1, sizeof(head), f));
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    TEST_ASSERT_EQUAL_HEX8(0x89, head[0]);
+    TEST_ASSERT_EQUAL(0, memcmp(head + 1, "PNG", 3));
+    TEST_ASSERT_EQUAL(0, memcmp(head + 12, "IHDR", 4));
+    TEST_ASSERT_EQUAL(128, head[19]);
+    TEST_ASSERT_EQUAL(64, head[23]);
+    // 签名 8 + IHDR 25 + IDAT(12 + 2 + 5 + 64×17 + 4) + IEND 12
+    TEST_ASSERT_EQUAL(8 + 25 + 12 + 2 + 5 + 64 * 17 + 4 + 12, size);
+
+    // 不存在或格式不对的文件返回 false
+    TEST_ASSERT_FALSE(framebufferReadPbm("no_such_file.pbm", back));
+    f = fopen(pbm, "wb");
+    fputs("P4\n64 32\n", f);
+    fclose(f);
+    TEST_ASSERT_FALSE(framebufferReadPbm(pbm, back));
+    remove(pbm);
+    remove(png);
+}
+
+// 测试5：各界面与金样图像逐像素一致
+void test_unit_golden_screens() {
+    HostScreens s;
+    bool update = getenv("UPDATE_GOLDEN") != nullptr;
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+        s.render(i);
+        const uint8_t* buf = s.display.getBufferPtr();
+        std::string path = goldenPath(SCREEN_NAMES[i], ".pbm");
+        if (update) {
+            TEST_ASSERT_TRUE(framebufferWritePbm(path.c_str(), buf));
+            framebufferWritePng(goldenPath(SCREEN_NAMES[i], ".png").c_str(), buf);
+            printf("  已更新金样 %s\n", path.c_str());
+            continue;
+        }
+        uint8_t golden[DISPLAY_BUFFER_SIZE];
+        char msg[160];
+        snprintf(msg, sizeof(msg), "缺少金样 %s（UPDATE_GOLDEN=1 生成）", path.c_str());
+        TEST_ASSERT_TRUE_MESSAGE(framebufferReadPbm(path.c_str(), golden), msg);
+        uint32_t diff = framebufferDiff(golden, buf);
+        if (diff != 0) {
+            // 实际画面写在金样旁边，便于对比
+            framebufferWritePng(goldenPath(SCREEN_NAMES[i], ".actual.png").c_str(), buf);
+        }
+        snprintf(msg, sizeof(msg), "界面 %s 与金样相差 %lu 像素", SCREEN_NAMES[i], (unsigned long)diff);
+        TEST_ASSERT_EQUAL_MESSAGE(0, diff, msg);
+        // 屏幕显存与缓冲一致
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(buf, s.display.panel.screen, DISPLAY_BUFFER_SIZE);
+    }
+}
+
+// ========== 属性测试 ==========
+
+// 属性：随机直线两个方向画结果相同、端点点亮、点数为长轴长度 + 1；随机画面 PBM 读回一致
+void test_property_lines_and_snapshots() {
+    printf("\n[Property Test] 随机直线对称性与快照读回 - 100次迭代\n");
+    HostU8g2 a, b;
+    const char* pbm = "test_oled_screens_property.pbm";
+
+    for (int i = 0; i < 100; i++) {
+        int16_t x1 = (int16_t)testRandomInt(0, 127), y1 = (int16_t)testRandomInt(0, 63);
+        int16_t x2 = (int16_t)testRandomInt(0, 127), y2 = (int16_t)testRandomInt(0, 63);
+        a.clearBuffer();
+        b.clearBuffer();
+        a.drawLine(x1, y1, x2, y2);
+        b.drawLine(x2, y2, x1, y1);
+        char msg[96];
+        snprintf(msg, sizeof(msg), "Iter %d: (%d,%d)-(%d,%d)", i, x1, y1, x2, y2);
+        TEST_ASSERT_EQUAL_MESSAGE(0, framebufferDiff(a.getBufferPtr(), b.getBufferPtr()), msg);
+        TEST_ASSERT_TRUE_MESSAGE(pixelAt(a.getBufferPtr(), x1, y1), msg);
+        TEST_ASSERT_TRUE_MESSAGE(pixelAt(a.getBufferPtr(), x2, y2), msg);
+        int dx = abs(x2 - x1), dy = abs(y2 - y1);
+        TEST_ASSERT_EQUAL_MESSAGE((dx > dy ? dx : dy) + 1, countPixels(a.getBufferPtr()), msg);
+
+        // 随机叠加矩形、圆（含异或），快照读回一致
+        for (int k = testRandomInt(1, 6); k > 0; k--) {
+            a.setDrawColor((uint8_t)testRandomInt(0, 2));
+            int16_t x = (int16_t)testRandomInt(-20, 127), y = (int16_t)testRandomInt(-20, 63);
+            switch (testRandomInt(0, 3)) {
+                case 0: a.drawBox(x, y, (int16_t)testRandomInt(1, 60), (int16_t)testRandomInt(1, 40)); break;
+                case 1: a.drawFrame(x, y, (int16_t)testRandomInt(1, 60), (int16_t)testRandomInt(1, 40)); break;
+                case 2: a.drawCircle(x, y, (int16_t)testRandomInt(1, 30)); break;
+                default: a.drawDisc(x, y, (int16_t)testRandomInt(1, 30)); break;
+            }
+        }
+        a.setDrawColor(1);
+        uint8_t back[DISPLAY_BUFFER_SIZE];
+        TEST_ASSERT_TRUE(framebufferWritePbm(pbm, a.getBufferPtr()));
+        TEST_ASSERT_TRUE(framebufferReadPbm(pbm, back));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(a.getBufferPtr(), back, DISPLAY_BUFFER_SIZE, msg);
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+    remove(pbm);
+}
+
+// ========== 性能测试 ==========
+
+// 每个界面的绘制 CPU 时间和发送字节；进度条动画整帧发送与只发进度区域的对比
+void test_benchmark_screens() {
+    printf("\n[Benchmark] OLED 界面：每帧绘制耗时（主机）与 I2C 总线字节\n");
+    HostScreens s;
+    const int rounds = 200;
+
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+        s.render(i);   // 预热字形缓存
+        s.display.resetStats();
+        for (int r = 0; r < rounds; r++) {
+            s.render(i);
+        }
+        const HostFrameStats& st = s.display.stats();
+        printf("  %-14s 绘制 %6.2f us/帧，发送 %lu 字节/帧（400kHz 约 %.1f ms）\n",
+               SCREEN_NAMES[i], st.cpuUs / st.frames, (unsigned long)(st.busBytes / st.frames),
+               RecordingTileTransport::busTimeMs(st.busBytes / st.frames));
+        TEST_ASSERT_EQUAL(rounds, st.frames);
+        TEST_ASSERT_EQUAL(RecordingTileTransport::fullFrameBytes() * rounds, st.busBytes);
+    }
+
+    // 进度条 0~100%（21 帧）：整帧发送 vs 只发进度条和百分比所在的块（第 3~6 页）
+    s.display.clearBuffer();
+    oledDrawLoadingTitle(s.display, s.fonts, s.text());
+    s.display.sendBuffer();
+    s.display.resetStats();
+    for (int p = 0; p <= 100; p += 5) {
+        oledDrawProgress(s.display, s.fonts, p);
+        s.display.sendBuffer();
+    }
+    uint32_t full = s.display.stats().busBytes;
+    s.display.resetStats();
+    for (int p = 0; p <= 100; p += 5) {
+        oledDrawProgress(s.display, s.fonts, p);
+        s.display.updateDisplayArea(0, 3, DISPLAY_TILE_COLS, 4);
+    }
+    uint32_t area = s.display.stats().busBytes;
+    printf("  进度条 21 帧：整帧发送 %lu 字节，只发第 3~6 页 %lu 字节（%.0f%%）\n",
+           (unsigned long)full, (unsigned long)area, area * 100.0f / full);
+    TEST_ASSERT_TRUE(area < full);
+}
+
+// ========================================
+// 主函数
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("OledScreens 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_primitives);
+    RUN_TEST(test_unit_text);
+    RUN_TEST(test_unit_bus_bytes);
+    RUN_TEST(test_unit_snapshot_files);
+    RUN_TEST(test_unit_golden_screens);
+
+    printf("\n========================================\n");
+    printf("OledScreens 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_lines_and_snapshots);
+
+    printf("\n========================================\n");
+    printf("OledScreens 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_screens);
+
+    return UNITY_END();
+}
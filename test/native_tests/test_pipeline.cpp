@@ -0,0 +1,534 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+#include "Pipeline.h"
+#include "PipelineQueue.h"
+#include "TaskScheduler.h"
+#include "VirtualClock.h"
+
+// ========================================
+// Pipeline 测试（主机端，native 环境）
+// 多核流水线：有界队列计数、拓扑检查、std::thread 运行四阶段拓扑
+// 运行：python tools/run_native_tests.py test_pipeline
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 30000;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+static uint32_t wallUs() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static uint32_t idleStage(void*) {
+    return 10000;
+}
+
+// ========== 单元测试 ==========
+
+// 单元测试1: 写入/取出/丢弃计数，深度与最大深度
+void test_unit_queue_counters() {
+    PipelineQueue<int, 4> q;
+    TEST_ASSERT_EQUAL(4, q.capacity());
+
+    for (int i = 0; i < 6; i++) {
+        bool ok = q.push(i);
+        TEST_ASSERT_EQUAL(i < 4, ok);   // 满时丢弃新元素
+    }
+    PipelineQueueStats s = q.stats();
+    TEST_ASSERT_EQUAL(4, s.pushed);
+    TEST_ASSERT_EQUAL(2, s.dropped);
+    TEST_ASSERT_EQUAL(4, s.depth);
+    TEST_ASSERT_EQUAL(4, s.maxDepth);
+
+    int v = -1;
+    TEST_ASSERT_TRUE(q.pop(v));
+    TEST_ASSERT_EQUAL(0, v);
+    TEST_ASSERT_TRUE(q.pop(v));
+    TEST_ASSERT_EQUAL(1, v);
+    s = q.stats();
+    TEST_ASSERT_EQUAL(2, s.popped);
+    TEST_ASSERT_EQUAL(2, s.depth);
+    TEST_ASSERT_EQUAL(4, s.maxDepth);
+
+    // drain 只保留最后一个
+    q.push(7);
+    TEST_ASSERT_EQUAL(3, q.drain(v));
+    TEST_ASSERT_EQUAL(7, v);
+    TEST_ASSERT_EQUAL(0, q.drain(v));
+    TEST_ASSERT_EQUAL(7, v);
+    TEST_ASSERT_EQUAL(5, q.stats().popped);
+
+    q.resetStats();
+    s = q.stats();
+    TEST_ASSERT_EQUAL(0, s.pushed + s.popped + s.dropped + s.maxDepth);
+}
+
+// 单元测试2: 拓扑检查
+void test_unit_topology_validation() {
+    PipelineQueue<int, 4> a, b;
+
+    Pipeline empty;
+    TEST_ASSERT_NOT_NULL(empty.validate());
+    TEST_ASSERT_FALSE(empty.start());
+
+    Pipeline p;
+    TEST_ASSERT_EQUAL(PIPELINE_NO_STAGE, p.addStage("null", nullptr, nullptr, 0, 1));
+    int8_t s0 = p.addStage("capture", idleStage, nullptr, 0, 3);
+    int8_t s1 = p.addStage("decide", idleStage, nullptr, 1, 2);
+    TEST_ASSERT_EQUAL(0, s0);
+    TEST_ASSERT_EQUAL(1, s1);
+    TEST_ASSERT_EQUAL(1, p.stageCore(s1));
+    TEST_ASSERT_EQUAL(2, p.stagePriority(s1));
+
+    // 阶段没有连接任何队列
+    TEST_ASSERT_NOT_NULL(p.validate());
+
+    // 两端相同、阶段编号无效、同一队列登记两次（第二个生产者/消费者）
+    TEST_ASSERT_FALSE(p.connect(a, "self", s0, s0));
+    TEST_ASSERT_FALSE(p.connect(a, "bad", s0, 5));
+    TEST_ASSERT_TRUE(p.connect(a, "frames", s0, s1));
+    TEST_ASSERT_FALSE(p.connect(a, "again", s1, s0));
+    TEST_ASSERT_EQUAL(1, p.queueCount());
+    TEST_ASSERT_NULL(p.validate());
+    TEST_ASSERT_EQUAL_STRING("frames", p.queue(0)->name());
+    TEST_ASSERT_EQUAL(s0, p.queue(0)->producer());
+    TEST_ASSERT_EQUAL(s1, p.queue(0)->consumer());
+
+    // 反向队列（运动事件回到采集）合法
+    TEST_ASSERT_TRUE(p.connect(b, "events", s1, s0));
+    TEST_ASSERT_NULL(p.validate());
+
+    // 核号无效的阶段使拓扑无效
+    PipelineQueue<int, 4> c;
+    int8_t s2 = p.addStage("ui", idleStage, nullptr, 2, 1);
+    TEST_ASSERT_TRUE(p.connect(c, "status", s1, s2));
+    TEST_ASSERT_NOT_NULL(p.validate());
+    TEST_ASSERT_FALSE(p.start());
+    TEST_ASSERT_FALSE(p.running());
+}
+
+// 单元测试3: 写入唤醒等待中的消费者阶段（等待超时 2 秒，实际应立即处理）
+struct WakeProbe {
+    PipelineQueue<uint32_t, 8>* queue;
+    std::atomic<uint32_t> lagUs;
+    std::atomic<int> received;
+};
+
+static uint32_t wakeConsumer(void* arg) {
+    WakeProbe* w = (WakeProbe*)arg;
+    uint32_t sentUs;
+    while (w->queue->pop(sentUs)) {
+        uint32_t lag = wallUs() - sentUs;
+        if (lag > w->lagUs.load()) w->lagUs.store(lag);
+        w->received++;
+    }
+    return 2000000;
+}
+
+void test_unit_push_wakes_consumer() {
+    PipelineQueue<uint32_t, 8> q;
+    WakeProbe w;
+    w.queue = &q;
+    w.lagUs = 0;
+    w.received = 0;
+
+    Pipeline p;
+    int8_t prod = p.addStage("producer", idleStage, nullptr, 0, 1);
+    int8_t cons = p.addStage("consumer", wakeConsumer, &w, 1, 1);
+    TEST_ASSERT_TRUE(p.connect(q, "wake", prod, cons));
+    TEST_ASSERT_TRUE(p.start());
+    TEST_ASSERT_TRUE(p.running());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));   // 消费者进入等待
+
+    // 测试线程代替生产者阶段写入（同一时刻只有这一个生产者）
+    for (int i = 0; i < 5; i++) {
+        q.push(wallUs());
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    uint32_t t0 = wallUs();
+    while (w.received.load() < 5 && wallUs() - t0 < 1000000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    p.stop();
+    TEST_ASSERT_FALSE(p.running());
+
+    printf("  5 次写入，最大唤醒延迟 %lu us（等待超时 2 s）\n", (unsigned long)w.lagUs.load());
+    TEST_ASSERT_EQUAL(5, w.received.load());
+    TEST_ASSERT_LESS_THAN(500000, w.lagUs.load());
+    TEST_ASSERT_GREATER_OR_EQUAL(5, p.stageStats(cons).wakeups);
+    TEST_ASSERT_EQUAL(-1, p.stageStats(cons).runningCore);   // 主机端不绑定核
+}
+
+// 单元测试4: 综合联动的四阶段拓扑在 std::thread 上运行
+// 采集 --frames--> 决策 --commands--> 输出；决策 --status--> 显示；输出 --events--> 采集
+struct Frame {
+    uint32_t seq;
+    int16_t level;
+};
+
+struct Command {
+    uint32_t seq;
+    int16_t angle;
+};
+
+struct Status {
+    uint32_t seq;
+};
+
+struct MotionEvent {
+    uint32_t seq;
+};
+
+struct TopologyRig {
+    PipelineQueue<Frame, 16> frames;
+    PipelineQueue<Command, 16> commands;
+    PipelineQueue<Status, 8> status;
+    PipelineQueue<MotionEvent, 16> events;
+
+    uint32_t total;
+    uint32_t produced;            // 采集阶段
+    uint32_t eventsSeen;          // 采集阶段
+    uint32_t lastCommand;         // 输出阶段
+    bool ordered;                 // 输出阶段
+    std::atomic<uint32_t> executed;
+    uint32_t statusSeen;          // 显示阶段
+};
+
+static uint32_t captureStage(void* arg) {
+    TopologyRig* r = (TopologyRig*)arg;
+    MotionEvent e;
+    while (r->events.pop(e)) {
+        r->eventsSeen++;
+    }
+    if (r->produced >= r->total) {
+        return 10000;
+    }
+    Frame f = {r->produced, (int16_t)(r->produced % 200)};
+    if (r->frames.push(f)) {
+        r->produced++;
+    }
+    return 500;   // 模拟采集块间隔
+}
+
+static uint32_t decideStage(void* arg) {
+    TopologyRig* r = (TopologyRig*)arg;
+    Frame f;
+    while (r->frames.pop(f)) {
+        Command c = {f.seq, (int16_t)(90 + f.level / 10)};
+        r->commands.push(c);
+        if (f.seq % 10 == 0) {
+            Status s = {f.seq};
+            r->status.push(s);
+        }
+    }
+    return 100000;
+}
+
+static uint32_t outputStage(void* arg) {
+    TopologyRig* r = (TopologyRig*)arg;
+    Command c;
+    while (r->commands.pop(c)) {
+        if (r->executed.load() > 0 && c.seq != r->lastCommand + 1) r->ordered = false;
+        if (r->executed.load() == 0 && c.seq != 0) r->ordered = false;
+        r->lastCommand = c.seq;
+        MotionEvent e = {c.seq};
+        r->events.push(e);
+        r->executed++;
+    }
+    return 100000;
+}
+
+static uint32_t uiStage(void* arg) {
+    TopologyRig* r = (TopologyRig*)arg;
+    Status s;
+    while (r->status.pop(s)) {
+        r->statusSeen++;
+    }
+    return 100000;
+}
+
+void test_unit_four_stage_topology() {
+    static TopologyRig r;
+    r.total = 400;
+    r.produced = 0;
+    r.eventsSeen = 0;
+    r.lastCommand = 0;
+    r.ordered = true;
+    r.executed = 0;
+    r.statusSeen = 0;
+
+    Pipeline p;
+    int8_t capture = p.addStage("capture", captureStage, &r, 0, 3);
+    int8_t decide = p.addStage("decide", decideStage, &r, 1, 2);
+    int8_t output = p.addStage("output", outputStage, &r, 1, 4);
+    int8_t ui = p.addStage("ui", uiStage, &r, 0, 1);
+    TEST_ASSERT_TRUE(p.connect(r.frames, "frames", capture, decide));
+    TEST_ASSERT_TRUE(p.connect(r.commands, "commands", decide, output));
+    TEST_ASSERT_TRUE(p.connect(r.status, "status", decide, ui));
+    TEST_ASSERT_TRUE(p.connect(r.events, "events", output, capture));
+    TEST_ASSERT_NULL(p.validate());
+    TEST_ASSERT_TRUE(p.start());
+
+    uint32_t t0 = wallUs();
+    while (r.executed.load() < r.total && wallUs() - t0 < 5000000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));   // 采集阶段取完最后的运动事件
+    p.stop();
+
+    TEST_ASSERT_EQUAL(r.total, r.executed.load());
+    TEST_ASSERT_TRUE_MESSAGE(r.ordered, "命令丢失或乱序");
+    TEST_ASSERT_EQUAL(r.total, r.eventsSeen);
+    TEST_ASSERT_EQUAL(r.total / 10, r.statusSeen);
+
+    printf("  %-10s %8s %8s %8s %8s %8s\n", "队列", "写入", "取出", "丢弃", "最大深度", "容量");
+    for (uint8_t i = 0; i < p.queueCount(); i++) {
+        PipelineQueueStats s = p.queue(i)->stats();
+        printf("  %-10s %8lu %8lu %8lu %8lu %8lu\n", p.queue(i)->name(), (unsigned long)s.pushed,
+               (unsigned long)s.popped, (unsigned long)s.dropped, (unsigned long)s.maxDepth,
+               (unsigned long)s.capacity);
+        TEST_ASSERT_EQUAL(0, s.dropped);
+        TEST_ASSERT_EQUAL(s.pushed, s.popped);
+        TEST_ASSERT_EQUAL(0, s.depth);
+        TEST_ASSERT_LESS_OR_EQUAL(s.capacity, s.maxDepth);
+    }
+    for (int8_t i = 0; i < (int8_t)p.stageCount(); i++) {
+        PipelineStageStats st = p.stageStats(i);
+        printf("  阶段 %-8s 核%d 优先级%d：%lu 轮，唤醒 %lu 次\n", p.stageName(i), p.stageCore(i),
+               p.stagePriority(i), (unsigned long)st.rounds, (unsigned long)st.wakeups);
+        TEST_ASSERT_GREATER_THAN(0, st.rounds);
+    }
+    // 事件驱动的阶段靠写入唤醒，而不是轮询超时
+    TEST_ASSERT_GREATER_THAN(10, p.stageStats(output).wakeups);
+}
+
+// ========== 属性测试 ==========
+
+// 属性测试1: 随机写入/取出序列，计数与参考模型一致
+void test_property_queue_accounting() {
+    printf("\n[Property Test] 随机写入/取出序列的队列计数 - 100次迭代\n");
+
+    for (int i = 0; i < 100; i++) {
+        PipelineQueue<uint32_t, 8> q;
+        std::deque<uint32_t> model;
+        uint32_t next = 0, pushed = 0, popped = 0, dropped = 0, maxDepth = 0;
+        char msg[96];
+
+        int ops = testRandomInt(20, 300);
+        int pushBias = testRandomInt(30, 80);   // 写入概率（%），覆盖长期满和长期空
+        for (int k = 0; k < ops; k++) {
+            int op = testRandomInt(0, 99);
+            if (op < pushBias) {
+                bool ok = q.push(next);
+                bool expect = model.size() < 8;
+                snprintf(msg, sizeof(msg), "Iter %d 操作 %d: push 结果", i, k);
+                TEST_ASSERT_EQUAL_MESSAGE(expect, ok, msg);
+                if (expect) {
+                    model.push_back(next);
+                    pushed++;
+                    if (model.size() > maxDepth) maxDepth = (uint32_t)model.size();
+                } else {
+                    dropped++;
+                }
+                next++;
+            } else if (op < 95) {
+                uint32_t v = 0;
+                bool ok = q.pop(v);
+                TEST_ASSERT_EQUAL(!model.empty(), ok);
+                if (ok) {
+                    snprintf(msg, sizeof(msg), "Iter %d 操作 %d: FIFO 顺序", i, k);
+                    TEST_ASSERT_EQUAL_MESSAGE(model.front(), v, msg);
+                    model.pop_front();
+                    popped++;
+                }
+            } else {
+                uint32_t v = 0xFFFFFFFFu;
+                size_t n = q.drain(v);
+                TEST_ASSERT_EQUAL(model.size(), n);
+                if (n > 0) {
+                    TEST_ASSERT_EQUAL(model.back(), v);
+                }
+                popped += (uint32_t)n;
+                model.clear();
+            }
+
+            PipelineQueueStats s = q.stats();
+            snprintf(msg, sizeof(msg), "Iter %d 操作 %d: 计数不一致", i, k);
+            TEST_ASSERT_EQUAL_MESSAGE(pushed, s.pushed, msg);
+            TEST_ASSERT_EQUAL_MESSAGE(popped, s.popped, msg);
+            TEST_ASSERT_EQUAL_MESSAGE(dropped, s.dropped, msg);
+            TEST_ASSERT_EQUAL_MESSAGE(model.size(), s.depth, msg);
+            TEST_ASSERT_EQUAL_MESSAGE(maxDepth, s.maxDepth, msg);
+            TEST_ASSERT_EQUAL_MESSAGE(s.pushed - s.popped, s.depth, msg);
+        }
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+}
+
+// ========== 性能测试 ==========
+
+// 舵机延迟：单个 loop 任务（音频分析与舵机共用一个协作调度器）与流水线（舵机所在的
+// 运动阶段只和灯效共用调度器，音频在另一个核）。虚拟时钟，负载同 test_task_scheduler
+struct CostProbe {
+    VirtualClock* clock;
+    uint32_t costUs;
+};
+
+static void costTask(void* arg, uint32_t) {
+    CostProbe* p = (CostProbe*)arg;
+    p->clock->advance(p->costUs);
+}
+
+static uint32_t servoLatency(bool pipelined, uint32_t audioCostUs) {
+    VirtualClock clock;
+    TaskScheduler sched(clock);
+    CostProbe servo = {&clock, 150}, audio = {&clock, audioCostUs}, state = {&clock, 300},
+              led = {&clock, 400}, display = {&clock, 3000}, serial = {&clock, 50};
+    int8_t servoId = sched.addPeriodic("servo", costTask, &servo, 5000, 5);
+    sched.addPeriodic("led", costTask, &led, 16667, 2);
+    if (!pipelined) {
+        // 采集块由 I2S 决定节拍，相位与舵机无关：每块开始时刻相对舵机释放依次错开 1ms
+        sched.addPeriodic("audio", costTask, &audio, 16000, 4, 0, 4500);
+        sched.addPeriodic("state", costTask, &state, 10000, 3);
+        sched.addPeriodic("display", costTask, &display, 100000, 1);
+        sched.addPeriodic("serial", costTask, &serial, 20000, 0);
+    }
+    clock.runFor(sched, 10000000);
+    return sched.stats(servoId)->maxLatencyUs;
+}
+
+// 线程版：舵机阶段 1ms 周期，音频阶段每 4ms 忙等 costUs，测舵机释放到运行的实际延迟
+struct ThreadLoad {
+    uint32_t audioCostUs;
+    uint32_t nextServoUs;
+    uint32_t nextAudioUs;
+    uint32_t maxLateUs;
+    uint32_t servoRuns;
+    bool single;   // true：音频在舵机阶段内运行
+};
+
+static void burn(uint32_t us) {
+    uint32_t t0 = wallUs();
+    while (wallUs() - t0 < us) {
+    }
+}
+
+static uint32_t threadServoStage(void* arg) {
+    ThreadLoad* l = (ThreadLoad*)arg;
+    uint32_t now = wallUs();
+    if ((int32_t)(now - l->nextServoUs) >= 0) {
+        uint32_t late = now - l->nextServoUs;
+        if (l->servoRuns > 0 && late > l->maxLateUs) l->maxLateUs = late;
+        l->servoRuns++;
+        l->nextServoUs += 1000;
+        if ((int32_t)(now - l->nextServoUs) > 0) l->nextServoUs = now + 1000;
+    }
+    if (l->single && (int32_t)(now - l->nextAudioUs) >= 0) {
+        burn(l->audioCostUs);
+        l->nextAudioUs += 4000;
+    }
+    int32_t wait = (int32_t)(l->nextServoUs - wallUs());
+    return wait > 0 ? (uint32_t)wait : 0;
+}
+
+static uint32_t threadAudioStage(void* arg) {
+    ThreadLoad* l = (ThreadLoad*)arg;
+    if (!l->single) {
+        burn(l->audioCostUs);
+    }
+    return 4000 - l->audioCostUs;
+}
+
+static uint32_t threadServoLatency(bool single, uint32_t audioCostUs) {
+    ThreadLoad l = {audioCostUs, wallUs(), wallUs(), 0, 0, single};
+    PipelineQueue<int, 2> link;
+    Pipeline p;
+    int8_t servo = p.addStage("servo", threadServoStage, &l, 1, 4);
+    int8_t audio = p.addStage("audio", threadAudioStage, &l, 0, 3);
+    p.connect(link, "link", audio, servo);
+    p.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    p.stop();
+    return l.maxLateUs;
+}
+
+void test_benchmark_pipeline() {
+    printf("\n[Benchmark] 舵机最大延迟：单个 loop 任务 与 流水线（音频在另一个核）\n");
+    printf("  %-12s %14s %14s\n", "音频耗时us", "单loop 延迟us", "流水线 延迟us");
+    const uint32_t costs[] = {1000, 2500, 5000};
+    for (uint32_t cost : costs) {
+        uint32_t single = servoLatency(false, cost);
+        uint32_t pipelined = servoLatency(true, cost);
+        printf("  %-12lu %14lu %14lu\n", (unsigned long)cost, (unsigned long)single, (unsigned long)pipelined);
+        // 流水线中舵机延迟只取决于同阶段的灯效，与音频耗时无关
+        TEST_ASSERT_GREATER_OR_EQUAL(cost - 500, single);
+        TEST_ASSERT_LESS_OR_EQUAL(400, pipelined);
+    }
+
+    // 主机线程受操作系统调度影响（单核主机上两阶段反而互相抢占），只打印不断言
+    unsigned cores = std::thread::hardware_concurrency();
+    uint32_t threadSingle = threadServoLatency(true, 2500);
+    uint32_t threadPipelined = threadServoLatency(false, 2500);
+    printf("  std::thread（主机 %u 核，音频 2.5ms/4ms）：单阶段 %lu us，两阶段 %lu us\n", cores,
+           (unsigned long)threadSingle, (unsigned long)threadPipelined);
+
+    // 队列开销：push + pop 一对
+    static PipelineQueue<Frame, 64> q;
+    const int rounds = 1000000;
+    Frame f = {0, 0};
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        f.seq = (uint32_t)i;
+        q.push(f);
+        q.pop(f);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / rounds;
+    printf("  队列 push+pop（主机）：%.1f ns/对\n", ns);
+    TEST_ASSERT_EQUAL(rounds, q.stats().popped);
+}
+
+// ========================================
+// 主函数
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("Pipeline 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_queue_counters);
+    RUN_TEST(test_unit_topology_validation);
+    RUN_TEST(test_unit_push_wakes_consumer);
+    RUN_TEST(test_unit_four_stage_topology);
+
+    printf("\n========================================\n");
+    printf("Pipeline 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_queue_accounting);
+
+    printf("\n========================================\n");
+    printf("Pipeline 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_pipeline);
+
+    return UNITY_END();
+}
@@ -0,0 +1,277 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "RealFft.h"
+#include "SpectralFeatures.h"
+
+// ========================================
+// RealFft / SpectralFeatures 测试（主机端，native 环境）
+// 与朴素 DFT 对比正确性和速度
+// 运行：python tools/run_native_tests.py test_real_fft
+// ========================================
+
+static const uint32_t RATE = 16000;
+
+// 简单的伪随机数生成器（用于属性测试）
+static float testRandom(float min, float max) {
+    static unsigned long seed = 11223;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    float normalized = (float)seed / (float)0x7fffffff;
+    return min + normalized * (max - min);
+}
+
+// 朴素 DFT（双精度），输出与 RealFft 相同的打包格式
+static void naiveDft(const float* x, size_t n, double* packed) {
+    for (size_t k = 0; k <= n / 2; k++) {
+        double re = 0, im = 0;
+        for (size_t t = 0; t < n; t++) {
+            double angle = -2.0 * M_PI * (double)k * t / n;
+            re += x[t] * cos(angle);
+            im += x[t] * sin(angle);
+        }
+        if (k == 0) {
+            packed[0] = re;
+        } else if (k == n / 2) {
+            packed[1] = re;
+        } else {
+            packed[2 * k] = re;
+            packed[2 * k + 1] = im;
+        }
+    }
+}
+
+// 相对误差：max|fft - dft| / max|dft|
+template <size_t N>
+static double compareWithDft(const float* input) {
+    static float buf[N];
+    static double ref[N];
+    memcpy(buf, input, sizeof(buf));
+
+    RealFft<N>::transform(buf);
+    naiveDft(input, N, ref);
+
+    double maxErr = 0, maxRef = 0;
+    for (size_t i = 0; i < N; i++) {
+        double err = fabs(buf[i] - ref[i]);
+        if (err > maxErr) maxErr = err;
+        if (fabs(ref[i]) > maxRef) maxRef = fabs(ref[i]);
+    }
+    return maxRef > 0 ? maxErr / maxRef : maxErr;
+}
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: 编译期表（汉宁窗两端为0，中点为1）
+void test_unit_tables() {
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, RealFft<512>::windowAt(0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, RealFft<512>::windowAt(256));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, RealFft<512>::windowAt(1), RealFft<512>::windowAt(511));
+}
+
+// 单元测试2: 直流与奈奎斯特
+void test_unit_dc_nyquist() {
+    float buf[256];
+    for (int i = 0; i < 256; i++) {
+        buf[i] = 1.0f + ((i & 1) ? -0.5f : 0.5f);
+    }
+    RealFft<256>::transform(buf);
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 256.0f, buf[0]);   // 直流
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 128.0f, buf[1]);   // 奈奎斯特
+    for (int i = 2; i < 256; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, buf[i]);
+    }
+}
+
+// 单元测试3: 正弦波峰值落在正确频点
+void test_unit_sine_peak() {
+    static float buf[512];
+    static float mag[RealFft<512>::BINS];
+    const float freq = 1000.0f;  // 正好落在第32个频点
+
+    for (int i = 0; i < 512; i++) {
+        buf[i] = sinf(2.0f * (float)M_PI * freq * i / RATE);
+    }
+    RealFft<512>::forward(buf);
+    spectrumMagnitude(buf, 512, mag);
+
+    size_t peak = 0;
+    for (size_t k = 1; k < RealFft<512>::BINS; k++) {
+        if (mag[k] > mag[peak]) peak = k;
+    }
+    TEST_ASSERT_EQUAL(frequencyToBin(freq, 512, RATE), peak);
+    TEST_ASSERT_EQUAL(32, peak);
+}
+
+// 单元测试4: 与朴素 DFT 一致（256 / 512）
+void test_unit_matches_dft() {
+    static float x[512];
+    for (int i = 0; i < 512; i++) {
+        x[i] = sinf(i * 0.37f) + 0.3f * cosf(i * 1.91f) + 0.1f * (i % 7);
+    }
+    double err256 = compareWithDft<256>(x);
+    double err512 = compareWithDft<512>(x);
+    printf("  相对误差: N=256 %.2e, N=512 %.2e\n", err256, err512);
+
+    TEST_ASSERT_TRUE(err256 < 1e-5);
+    TEST_ASSERT_TRUE(err512 < 1e-5);
+}
+
+// 单元测试5: 原地转换采集帧（立体声 int32 -> 单声道加窗 float）
+void test_unit_load_capture_frame() {
+    static int32_t frame[512 * 2];
+    for (int i = 0; i < 512; i++) {
+        frame[i * 2] = (int32_t)(1000 * 65536);
+        frame[i * 2 + 1] = (int32_t)(3000 * 65536);
+    }
+
+    float* buf = RealFft<512>::loadCaptureFrame(frame);
+    TEST_ASSERT_TRUE((void*)buf == (void*)frame);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, buf[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f, 2000.0f, buf[256]);  // (1000+3000)/2 × 窗口峰值
+}
+
+// 单元测试6: 频带能量与频谱通量
+void test_unit_band_energy_and_flux() {
+    static float buf[256];
+    static float power[RealFft<256>::BINS];
+    static float mag[RealFft<256>::BINS];
+    static float prev[RealFft<256>::BINS];
+
+    for (int i = 0; i < 256; i++) {
+        buf[i] = sinf(2.0f * (float)M_PI * 3000.0f * i / RATE);
+    }
+    RealFft<256>::forward(buf);
+    spectrumPower(buf, 256, power);
+
+    const float edges[4] = { 0, 1000, 2500, 8000 };
+    float energies[3];
+    bandEnergies(power, 256, RATE, edges, 3, energies);
+    TEST_ASSERT_TRUE(energies[2] > 100 * energies[0]);
+    TEST_ASSERT_TRUE(energies[2] > 100 * energies[1]);
+
+    // 从静音到有声：通量为正；再来一帧相同的：通量为0
+    memset(prev, 0, sizeof(prev));
+    spectrumMagnitude(buf, 256, mag);
+    TEST_ASSERT_TRUE(spectralFlux(mag, prev, RealFft<256>::BINS) > 0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, spectralFlux(mag, prev, RealFft<256>::BINS));
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 任意随机输入，FFT 与 DFT 的相对误差 < 1e-4，且满足 Parseval 定理
+void test_property_random_signals() {
+    printf("\n[Property Test] 随机信号 vs DFT - 100次迭代\n");
+
+    static float x[256];
+    static float buf[256];
+    for (int i = 0; i < 100; i++) {
+        double timeEnergy = 0;
+        for (int t = 0; t < 256; t++) {
+            x[t] = testRandom(-32768, 32767);
+            timeEnergy += (double)x[t] * x[t];
+        }
+
+        double err = compareWithDft<256>(x);
+        if (err > 1e-4) {
+            char msg[100];
+            snprintf(msg, sizeof(msg), "Iter %d: relative error %.2e", i, err);
+            TEST_FAIL_MESSAGE(msg);
+        }
+
+        // Parseval：Σx² = (X0² + XN/2² + 2ΣXk²) / N
+        memcpy(buf, x, sizeof(buf));
+        RealFft<256>::transform(buf);
+        double freqEnergy = (double)buf[0] * buf[0] + (double)buf[1] * buf[1];
+        for (int k = 1; k < 128; k++) {
+            freqEnergy += 2.0 * ((double)buf[2 * k] * buf[2 * k] + (double)buf[2 * k + 1] * buf[2 * k + 1]);
+        }
+        freqEnergy /= 256;
+        if (fabs(freqEnergy - timeEnergy) / timeEnergy > 1e-4) {
+            TEST_FAIL_MESSAGE("Parseval 定理不成立");
+        }
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+
+    TEST_PASS();
+}
+
+// ========================================
+// 性能测试
+// ========================================
+
+template <size_t N>
+static void benchmarkSize() {
+    static float x[N];
+    static float buf[N];
+    static double ref[N];
+    for (size_t i = 0; i < N; i++) x[i] = testRandom(-1, 1);
+
+    const int FFT_RUNS = 20000;
+    float sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < FFT_RUNS; r++) {
+        memcpy(buf, x, sizeof(buf));
+        RealFft<N>::forward(buf);
+        sink += buf[2];
+    }
+    auto end = std::chrono::steady_clock::now();
+    double fftNs = std::chrono::duration<double, std::nano>(end - start).count() / FFT_RUNS;
+
+    const int DFT_RUNS = 20;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < DFT_RUNS; r++) {
+        naiveDft(x, N, ref);
+        sink += (float)ref[2];
+    }
+    end = std::chrono::steady_clock::now();
+    double dftNs = std::chrono::duration<double, std::nano>(end - start).count() / DFT_RUNS;
+
+    double frameNs = 1e9 * N / RATE;
+    printf("  N=%-4u FFT %8.0f ns  DFT %10.0f ns  加速 %6.0fx  帧预算占用 %.4f%%  (%g)\n",
+           (unsigned)N, fftNs, dftNs, dftNs / fftNs, 100.0 * fftNs / frameNs, sink * 0);
+}
+
+void test_benchmark_fft_vs_dft() {
+    benchmarkSize<256>();
+    benchmarkSize<512>();
+    TEST_PASS();
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("RealFft 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_tables);
+    RUN_TEST(test_unit_dc_nyquist);
+    RUN_TEST(test_unit_sine_peak);
+    RUN_TEST(test_unit_matches_dft);
+    RUN_TEST(test_unit_load_capture_frame);
+    RUN_TEST(test_unit_band_energy_and_flux);
+
+    printf("\n========================================\n");
+    printf("RealFft 属性测试 / 性能测试\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_random_signals);
+    RUN_TEST(test_benchmark_fft_vs_dft);
+
+    return UNITY_END();
+}
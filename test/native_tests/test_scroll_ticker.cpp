@@ -0,0 +1,283 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "TileFlusher.h"
+#include "RecordingTileTransport.h"
+#include "ScrollTicker.h"
+#include "RecordingSsd1306.h"
+
+// ========================================
+// ScrollTicker 测试（主机端，native 环境）
+// SSD1306 单列硬件滚动字幕：显存模拟、新露出列的写入、总线字节对比
+// 运行：python tools/run_native_tests.py test_scroll_ticker
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 17320;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+// 随机字幕条（代替 GlyphCache::renderColumns 的结果）
+static std::vector<uint16_t> randomStrip(int width) {
+    std::vector<uint16_t> s(width);
+    for (auto& c : s) c = (uint16_t)testRandomInt(1, 0xFFFF);
+    return s;
+}
+
+// 字幕区每一列是否等于字幕流第 position - 128 + x 列，其余页保持 fill
+static bool screenMatches(const RecordingSsd1306& oled, const ScrollTicker& t, uint8_t page, uint8_t fill) {
+    for (int x = 0; x < DISPLAY_WIDTH; x++) {
+        uint16_t expect = t.streamColumn((int32_t)t.position() - DISPLAY_WIDTH + x);
+        uint16_t got = (uint16_t)(oled.ram[page * DISPLAY_WIDTH + x] | (oled.ram[(page + 1) * DISPLAY_WIDTH + x] << 8));
+        if (got != expect) return false;
+    }
+    for (int p = 0; p < DISPLAY_TILE_ROWS; p++) {
+        if (p == page || p == page + 1) continue;
+        for (int x = 0; x < DISPLAY_WIDTH; x++) {
+            if (oled.ram[p * DISPLAY_WIDTH + x] != fill) return false;
+        }
+    }
+    return true;
+}
+
+// ========================================
+// 单元测试
+// ========================================
+
+// 单元测试1: begin() 关闭连续滚动、只清空字幕区两页
+void test_unit_begin_clears_band() {
+    RecordingSsd1306 oled;
+    memset(oled.ram, 0xA5, sizeof(oled.ram));
+    oled.scrolling = true;
+    ScrollTicker ticker(oled);
+    std::vector<uint16_t> strip = randomStrip(50);
+
+    ticker.begin(3, strip.data(), (uint16_t)strip.size());
+    TEST_ASSERT_FALSE(oled.scrolling);
+    TEST_ASSERT_EQUAL(0, oled.writesWhileScrolling);
+    TEST_ASSERT_TRUE(screenMatches(oled, ticker, 3, 0xA5));
+    TEST_ASSERT_EQUAL(oled.bytes, ticker.stats().busBytes);
+    TEST_ASSERT_EQUAL(0, oled.malformed);
+}
+
+// 单元测试2: 每一步显存左移一列，新露出的最右列为字幕下一列
+void test_unit_step_reveals_next_column() {
+    RecordingSsd1306 oled;
+    ScrollTicker ticker(oled);
+    std::vector<uint16_t> strip = randomStrip(40);
+    ticker.begin(2, strip.data(), (uint16_t)strip.size(), 10);
+
+    for (int i = 0; i < 60; i++) {
+        ticker.step();
+        TEST_ASSERT_TRUE(screenMatches(oled, ticker, 2, 0));
+    }
+    TEST_ASSERT_EQUAL(60, oled.scrollSteps);
+    TEST_ASSERT_EQUAL(60, ticker.position());
+    // 第 60 步后最右列为字幕流第 59 列 = 空白区（40~49）之后的第 9 列
+    uint16_t right = (uint16_t)(oled.ram[2 * DISPLAY_WIDTH + 127] | (oled.ram[3 * DISPLAY_WIDTH + 127] << 8));
+    TEST_ASSERT_EQUAL_HEX32(strip[9], right);
+}
+
+// 单元测试3: 每步总线字节固定（与文字长度无关），与模拟统计一致
+void test_unit_step_bytes_constant() {
+    RecordingSsd1306 oled;
+    ScrollTicker ticker(oled);
+    std::vector<uint16_t> shortStrip = randomStrip(10), longStrip = randomStrip(1000);
+
+    ticker.begin(0, shortStrip.data(), 10);
+    oled.reset();
+    ticker.step();
+    TEST_ASSERT_EQUAL(ScrollTicker::stepBytes(), oled.bytes);
+
+    ticker.begin(0, longStrip.data(), 1000);
+    oled.reset();
+    for (int i = 0; i < 500; i++) ticker.step();
+    TEST_ASSERT_EQUAL(500 * ScrollTicker::stepBytes(), oled.bytes);
+    TEST_ASSERT_EQUAL(23, ScrollTicker::stepBytes());
+    TEST_ASSERT_EQUAL(RecordingTileTransport::fullFrameBytes(), ScrollTicker::fullFrameBytes());
+    TEST_ASSERT_TRUE(screenMatches(oled, ticker, 0, 0));
+}
+
+// 单元测试4: 比屏幕长的文字循环滚动，空白后重新出现
+void test_unit_long_text_loops() {
+    RecordingSsd1306 oled;
+    ScrollTicker ticker(oled);
+    std::vector<uint16_t> strip = randomStrip(300);
+    ticker.begin(5, strip.data(), 300, 64);
+
+    TEST_ASSERT_EQUAL(428, ticker.passLength());
+    for (uint32_t i = 0; i < 300 + 64 + 200; i++) ticker.step();
+    TEST_ASSERT_TRUE(screenMatches(oled, ticker, 5, 0));
+    TEST_ASSERT_EQUAL_HEX32(strip[0], ticker.streamColumn(364));
+    TEST_ASSERT_EQUAL_HEX32(0, ticker.streamColumn(310));
+}
+
+// 单元测试5: update() 按速度步进，落后时最多补 4 步，速度不超过每帧一步
+void test_unit_update_timing() {
+    RecordingSsd1306 oled;
+    ScrollTicker ticker(oled);
+    std::vector<uint16_t> strip = randomStrip(20);
+    ticker.begin(0, strip.data(), 20);
+    ticker.setSpeed(50);   // 20ms 一步
+
+    TEST_ASSERT_EQUAL(1, ticker.update(1000));
+    TEST_ASSERT_EQUAL(0, ticker.update(1019));
+    TEST_ASSERT_EQUAL(1, ticker.update(1020));
+    TEST_ASSERT_EQUAL(2, ticker.update(1060));
+    TEST_ASSERT_EQUAL(4, ticker.update(2000));   // 落后很多：只补 4 步
+    TEST_ASSERT_EQUAL(0, ticker.update(2019));
+    TEST_ASSERT_EQUAL(1, ticker.update(2020));
+
+    ticker.setSpeed(1000);   // 限制为 TICKER_MIN_STEP_MS
+    ticker.update(3000);
+    TEST_ASSERT_EQUAL(0, ticker.update(3000 + TICKER_MIN_STEP_MS - 1));
+    TEST_ASSERT_EQUAL(1, ticker.update(3000 + TICKER_MIN_STEP_MS));
+
+    ticker.stop();
+    TEST_ASSERT_EQUAL(0, ticker.update(5000));
+    TEST_ASSERT_TRUE(screenMatches(oled, ticker, 0, 0));
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 随机字幕长度/空白/页/步数：
+// - 字幕区始终等于字幕流对应的窗口，其余页不变
+// - 总线字节 = begin() 字节 + 步数 × stepBytes()，没有在连续滚动激活时写显存
+void test_property_window_matches_stream() {
+    printf("\n[Property Test] 随机字幕滚动后屏幕窗口与字幕流一致 - 100次迭代\n");
+
+    for (int i = 0; i < 100; i++) {
+        RecordingSsd1306 oled;
+        uint8_t fill = (uint8_t)testRandomInt(0, 255);
+        memset(oled.ram, fill, sizeof(oled.ram));
+        ScrollTicker ticker(oled);
+        std::vector<uint16_t> strip = randomStrip(testRandomInt(1, 600));
+        uint8_t page = (uint8_t)testRandomInt(0, DISPLAY_TILE_ROWS - TICKER_PAGES);
+        ticker.begin(page, strip.data(), (uint16_t)strip.size(), (uint16_t)testRandomInt(0, 200));
+        uint32_t beginBytes = oled.bytes;
+
+        int steps = testRandomInt(0, 1500);
+        for (int s = 0; s < steps; s++) ticker.step();
+
+        if (!screenMatches(oled, ticker, page, fill)) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "Iter %d: 屏幕与字幕流不一致", i);
+            TEST_FAIL_MESSAGE(msg);
+        }
+        if (oled.bytes != beginBytes + steps * ScrollTicker::stepBytes()) TEST_FAIL_MESSAGE("总线字节不符");
+        if (oled.writesWhileScrolling != 0 || oled.malformed != 0) TEST_FAIL_MESSAGE("命令序列错误");
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+
+    TEST_PASS();
+}
+
+// ========================================
+// 性能测试
+// ========================================
+
+// 把字幕条按 x 偏移画进 U8g2 缓冲（原 test8_ScrollText 每帧的内容）
+static void drawStripFrame(uint8_t* buf, const std::vector<uint16_t>& strip, int x, int top) {
+    memset(buf, 0, DISPLAY_BUFFER_SIZE);
+    for (int c = 0; c < (int)strip.size(); c++) {
+        int px = x + c;
+        if (px < 0 || px >= DISPLAY_WIDTH) continue;
+        for (int r = 0; r < 16; r++) {
+            int py = top + r;
+            if ((strip[c] >> r) & 1) buf[(py / 8) * DISPLAY_WIDTH + px] |= (uint8_t)(1 << (py % 8));
+        }
+    }
+}
+
+// 性能1: 滚动一遍 "欢迎使用MOSS智能教育终端"（约 200 列）的总线字节/秒：
+// 整帧 sendBuffer、TileFlusher 增量发送、硬件滚动字幕，速度相同
+void test_benchmark_bus_bytes_per_second() {
+    printf("\n[Benchmark] 滚动字幕总线字节/秒（400kHz，速度相同）\n");
+
+    std::vector<uint16_t> strip = randomStrip(196);
+    const int width = (int)strip.size();
+    const int passPixels = width + DISPLAY_WIDTH;
+
+    // 原做法：每 2 像素清屏重画 + 整帧发送，再 delay(20)：速度受总线时间限制
+    float fullFrameMs = RecordingTileTransport::busTimeMs(RecordingTileTransport::fullFrameBytes());
+    float frameMs = 20.0f + fullFrameMs;
+    float speed = 2.0f * 1000.0f / frameMs;   // 像素/秒
+    float passSeconds = passPixels / speed;
+    uint32_t fullBytes = (uint32_t)((passPixels / 2) * RecordingTileTransport::fullFrameBytes());
+
+    // TileFlusher：同样每 2 像素一帧，只发变化的块（字幕区不对齐页边界，跨 3 页）
+    RecordingTileTransport bus;
+    TileFlusher flusher(bus);
+    static uint8_t buf[DISPLAY_BUFFER_SIZE];
+    drawStripFrame(buf, strip, DISPLAY_WIDTH, 22);
+    flusher.flush(buf);
+    bus.reset();
+    for (int x = DISPLAY_WIDTH; x > -width; x -= 2) {
+        drawStripFrame(buf, strip, x, 22);
+        flusher.flush(buf);
+    }
+    uint32_t tileBytes = bus.bytes;
+
+    // 硬件滚动：每像素一步
+    RecordingSsd1306 oled;
+    ScrollTicker ticker(oled);
+    ticker.begin(3, strip.data(), (uint16_t)width);
+    uint32_t beginBytes = oled.bytes;
+    while (ticker.position() < ticker.passLength()) ticker.step();
+    uint32_t tickerBytes = oled.bytes;
+
+    float fullRate = fullBytes / passSeconds;
+    float tileRate = tileBytes / passSeconds;
+    float tickerRate = (tickerBytes - beginBytes) / passSeconds;
+    float busCapacity = 400000.0f / 9;   // 每字节 9 个时钟
+    printf("  速度 %.1f 像素/秒，一遍 %d 像素（%.1f 秒）\n", speed, passPixels, passSeconds);
+    printf("  整帧 sendBuffer:  %7.0f 字节/秒（总线占用 %4.1f%%）\n", fullRate, 100 * fullRate / busCapacity);
+    printf("  TileFlusher 增量: %7.0f 字节/秒（总线占用 %4.1f%%）\n", tileRate, 100 * tileRate / busCapacity);
+    printf("  硬件滚动字幕:     %7.0f 字节/秒（总线占用 %4.1f%%），每像素 %u 字节，开始时 %u 字节\n",
+           tickerRate, 100 * tickerRate / busCapacity, ScrollTicker::stepBytes(), beginBytes);
+    printf("  相对整帧减少 %.0fx\n", fullRate / tickerRate);
+
+    TEST_ASSERT_TRUE(tickerRate * 20 < fullRate);
+    TEST_ASSERT_TRUE(tickerRate < tileRate);
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("ScrollTicker 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_begin_clears_band);
+    RUN_TEST(test_unit_step_reveals_next_column);
+    RUN_TEST(test_unit_step_bytes_constant);
+    RUN_TEST(test_unit_long_text_loops);
+    RUN_TEST(test_unit_update_timing);
+
+    printf("\n========================================\n");
+    printf("ScrollTicker 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_window_matches_stream);
+
+    printf("\n========================================\n");
+    printf("ScrollTicker 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_bus_bytes_per_second);
+
+    return UNITY_END();
+}
@@ -0,0 +1,369 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "AudioSource.h"
+#include "AudioAnalyzer.h"
+#include "SelfNoiseGate.h"
+#include "MotionState.h"
+#include "AudioSim.h"
+
+// ========================================
+// 舵机自噪声门控测试（主机端，native 环境）
+// 用"语音 + 舵机噪声"合成录音验证：运动中不误唤醒、不误转向，语音仍能检测
+// 运行：python tools/run_native_tests.py test_self_noise_gate
+// ========================================
+
+// 综合测试中 smoothMove 的三种速度：延时 20ms / 10ms / 5ms
+static const float SKETCH_VELOCITIES[3] = { 50.0f, 100.0f, 200.0f };
+
+// 安静房间背景噪声（峰值低于触发阈值），误触发只可能来自舵机
+static const float ROOM_NOISE = 0.0005f;
+
+// 简单的伪随机数生成器（用于属性测试）
+static float testRandom(float min, float max) {
+    static unsigned long seed = 24680;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    float normalized = (float)seed / (float)0x7fffffff;
+    return min + normalized * (max - min);
+}
+
+// 校准：安静环境中按指定速度转动舵机，学习噪声谱
+static void calibrate(SelfNoiseGate& gate, float velocityDps, float servoLevel, uint32_t seed) {
+    SceneSpec spec;
+    spec.sourceLevel = 0;
+    spec.noiseLevel = ROOM_NOISE;
+    spec.totalSec = 1.0f;
+    spec.servoLevel = servoLevel;
+    spec.servoVelocityDps = velocityDps;
+    spec.servoOnsetSec = 0;
+    spec.servoDurationSec = 1.0f;
+    spec.seed = seed;
+    synthesizeScene(spec, "noise_calib.wav");
+
+    WavAudioSource source;
+    source.open("noise_calib.wav");
+    static int32_t frame[CAPTURE_FRAME_SAMPLES * CAPTURE_CHANNELS];
+    size_t n;
+    while ((n = source.readFrame(frame, CAPTURE_FRAME_SAMPLES)) == CAPTURE_FRAME_SAMPLES) {
+        gate.learn(frame, n, velocityDps);
+    }
+}
+
+static SimReport runMix(const SceneSpec& spec, const char* path, SelfNoiseGate* gate) {
+    synthesizeScene(spec, path);
+
+    WavAudioSource source;
+    source.open(path);
+
+    SimGroundTruth truth;
+    if (spec.sourceLevel > 0) {
+        truth.onsetSec = spec.onsetSec;
+        truth.offsetSec = spec.onsetSec + spec.durationSec;
+        truth.angleDeg = spec.angleDeg;
+    } else {
+        truth.onsetSec = spec.totalSec;  // 没有声源：全部帧都在"声源出现前"
+    }
+
+    SimMotion motion;
+    motion.startSec = spec.servoOnsetSec;
+    motion.endSec = spec.servoOnsetSec + spec.servoDurationSec;
+    motion.velocityDps = spec.servoVelocityDps;
+
+    // 门控参数按不重叠的 512 采样帧整定，这里保持该分帧（固件分帧的结果见 audio_sim）
+    AudioPipelineSim sim;
+    sim.setFraming(CAPTURE_FRAME_SAMPLES, CAPTURE_FRAME_SAMPLES);
+    sim.setMotion(motion, gate);
+    return sim.run(source, truth);
+}
+
+// 舵机噪声在声源之前开始、与声源重叠一段
+static SceneSpec overlapScene(float velocityDps) {
+    SceneSpec spec;
+    spec.onsetSec = 1.0f;
+    spec.durationSec = 1.0f;
+    spec.totalSec = 2.5f;
+    spec.angleDeg = 45;
+    spec.sourceLevel = 0.15f;
+    spec.noiseLevel = ROOM_NOISE;
+    spec.servoLevel = 0.02f;
+    spec.servoVelocityDps = velocityDps;
+    spec.servoOnsetSec = 0.3f;
+    spec.servoDurationSec = 1.0f;
+    spec.seed = 5;
+    return spec;
+}
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: MotionTracker 运动状态与 settle 窗口
+void test_unit_motion_tracker() {
+    MotionTracker tracker(100);
+
+    TEST_ASSERT_FALSE(tracker.state(0).moving);
+
+    tracker.beginMove(200);
+    MotionState s = tracker.state(10);
+    TEST_ASSERT_TRUE(s.moving);
+    TEST_ASSERT_EQUAL_FLOAT(200, s.velocityDps);
+
+    tracker.endMove(1000);
+    TEST_ASSERT_TRUE(tracker.state(1050).moving);   // DMA 缓冲 + 齿轮余振
+    TEST_ASSERT_FALSE(tracker.state(1100).moving);
+    TEST_ASSERT_EQUAL_FLOAT(0, tracker.state(1100).velocityDps);
+}
+
+// 单元测试2: 速度分档（对应 smoothMove 的三种延时）
+void test_unit_velocity_class() {
+    SelfNoiseGate gate;
+    TEST_ASSERT_EQUAL(0, gate.velocityClass(10));
+    TEST_ASSERT_EQUAL(1, gate.velocityClass(50));
+    TEST_ASSERT_EQUAL(2, gate.velocityClass(100));
+    TEST_ASSERT_EQUAL(3, gate.velocityClass(200));
+    TEST_ASSERT_EQUAL(3, gate.velocityClass(-200));
+}
+
+// 单元测试3: 静止时直通，结果与不经过门控完全相同
+void test_unit_still_passthrough() {
+    static int32_t frame[CAPTURE_FRAME_SAMPLES * CAPTURE_CHANNELS];
+    for (size_t i = 0; i < CAPTURE_FRAME_SAMPLES; i++) {
+        int32_t v = (int32_t)(2000 * sinf(i * 0.2f));
+        frame[i * 2] = v * 65536;
+        frame[i * 2 + 1] = v / 2 * 65536;
+    }
+
+    SelfNoiseGate gate;
+    MotionState still = { false, 0 };
+    SelfNoiseResult r = gate.process(frame, CAPTURE_FRAME_SAMPLES, still);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, r.gain);
+    TEST_ASSERT_FALSE(r.gated);
+    TEST_ASSERT_FALSE(r.profiled);
+
+    AudioAnalyzer a, b;
+    AudioFrameStats plain = a.process(frame, CAPTURE_FRAME_SAMPLES);
+    AudioFrameStats gated = b.process(frame, CAPTURE_FRAME_SAMPLES, r.gain);
+    TEST_ASSERT_EQUAL_FLOAT(plain.volume, gated.volume);
+    TEST_ASSERT_EQUAL_FLOAT(plain.direction, gated.direction);
+    TEST_ASSERT_EQUAL_FLOAT(plain.rms, gated.rms);
+}
+
+// 单元测试4: 没有噪声谱时，运动中整帧门控（可关闭）
+void test_unit_unprofiled() {
+    static int32_t frame[CAPTURE_FRAME_SAMPLES * CAPTURE_CHANNELS];
+    memset(frame, 0, sizeof(frame));
+    MotionState moving = { true, 100 };
+
+    SelfNoiseGate gate;
+    SelfNoiseResult r = gate.process(frame, CAPTURE_FRAME_SAMPLES, moving);
+    TEST_ASSERT_TRUE(r.gated);
+    TEST_ASSERT_EQUAL_FLOAT(0, r.gain);
+
+    SelfNoiseGateConfig config;
+    config.gateUnprofiled = false;
+    gate.setConfig(config);
+    r = gate.process(frame, CAPTURE_FRAME_SAMPLES, moving);
+    TEST_ASSERT_FALSE(r.gated);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, r.gain);
+}
+
+// 单元测试5: 学习噪声谱，缺少的档位使用最近的已学习档位
+void test_unit_learn_profile() {
+    SelfNoiseGate gate;
+    TEST_ASSERT_FALSE(gate.hasProfile(2));
+
+    calibrate(gate, 100, 0.02f, 1);
+    TEST_ASSERT_TRUE(gate.hasProfile(2));
+    TEST_ASSERT_FALSE(gate.hasProfile(3));
+
+    // 基频 370Hz 及低次谐波落在低频带，能量最大
+    const float* profile = gate.profile(2);
+    size_t loudest = 0;
+    for (size_t b = 1; b < SELF_NOISE_BANDS; b++) {
+        if (profile[b] > profile[loudest]) loudest = b;
+    }
+    TEST_ASSERT_TRUE(loudest <= 2);
+
+    static int32_t frame[CAPTURE_FRAME_SAMPLES * CAPTURE_CHANNELS];
+    memset(frame, 0, sizeof(frame));
+    MotionState fast = { true, 200 };
+    SelfNoiseResult r = gate.process(frame, CAPTURE_FRAME_SAMPLES, fast);
+    TEST_ASSERT_TRUE(r.profiled);
+    TEST_ASSERT_EQUAL(3, r.velocityClass);
+}
+
+// 单元测试6: 纯舵机噪声——无门控时误唤醒，有门控时不触发
+void test_unit_servo_only() {
+    SceneSpec spec;
+    spec.sourceLevel = 0;
+    spec.noiseLevel = ROOM_NOISE;
+    spec.totalSec = 2.0f;
+    spec.servoLevel = 0.02f;
+    spec.servoVelocityDps = 100;
+    spec.servoOnsetSec = 0.5f;
+    spec.servoDurationSec = 1.0f;
+    spec.seed = 9;
+
+    SimReport raw = runMix(spec, "noise_servo_only.wav", nullptr);
+
+    SelfNoiseGate gate;
+    calibrate(gate, 100, 0.02f, 2);
+    SimReport gated = runMix(spec, "noise_servo_only.wav", &gate);
+
+    AudioPipelineSim::printReport("无门控", raw);
+    AudioPipelineSim::printReport("有门控", gated);
+
+    TEST_ASSERT_TRUE(raw.selfNoiseTriggers > 10);
+    TEST_ASSERT_EQUAL(0, gated.selfNoiseTriggers);
+    TEST_ASSERT_EQUAL(0, gated.falseTriggers);
+    TEST_ASSERT_EQUAL(0, gated.vadFalseFrames);
+}
+
+// 单元测试7: 运动中说话——语音仍被检测到，方向不被舵机拉偏
+void test_unit_speech_during_motion() {
+    SceneSpec spec = overlapScene(100);
+
+    SimReport raw = runMix(spec, "noise_overlap.wav", nullptr);
+
+    SelfNoiseGate gate;
+    calibrate(gate, 100, 0.02f, 3);
+    SimReport gated = runMix(spec, "noise_overlap.wav", &gate);
+
+    AudioPipelineSim::printReport("无门控", raw);
+    AudioPipelineSim::printReport("有门控", gated);
+
+    TEST_ASSERT_TRUE(raw.falseTriggers > 0);
+    TEST_ASSERT_EQUAL(0, gated.falseTriggers);
+    TEST_ASSERT_TRUE(gated.detectionLatencyMs >= 0);
+    TEST_ASSERT_TRUE(gated.detectionLatencyMs <= 64);
+    TEST_ASSERT_TRUE(gated.meanDirectionError <= raw.meanDirectionError + 1.0f);
+}
+
+// 单元测试8: 自噪声帧不更新 VAD 噪声底
+void test_unit_noise_floor_frozen() {
+    static int32_t quiet[CAPTURE_FRAME_SAMPLES * CAPTURE_CHANNELS];
+    static int32_t loud[CAPTURE_FRAME_SAMPLES * CAPTURE_CHANNELS];
+    for (size_t i = 0; i < CAPTURE_FRAME_SAMPLES * CAPTURE_CHANNELS; i++) {
+        quiet[i] = (int32_t)(((i * 37) % 21) - 10) * 65536;
+        loud[i] = (int32_t)(((i * 37) % 2001) - 1000) * 65536;
+    }
+
+    AudioAnalyzer analyzer;
+    float floor = analyzer.process(quiet, CAPTURE_FRAME_SAMPLES).noiseFloor;
+    for (int i = 0; i < 50; i++) {
+        AudioFrameStats s = analyzer.process(loud, CAPTURE_FRAME_SAMPLES, 0.3f);
+        TEST_ASSERT_EQUAL_FLOAT(floor, s.noiseFloor);
+    }
+    AudioFrameStats s = analyzer.process(loud, CAPTURE_FRAME_SAMPLES, 0.0f);
+    TEST_ASSERT_FALSE(s.triggered);
+    TEST_ASSERT_EQUAL_FLOAT(0, s.direction);
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 任意速度（smoothMove 三档 ±10%）、噪声电平、声源方向/电平：
+// 运动中无声源时不触发；声源在三帧内被检测到（声源包络从0渐起，开头与舵机噪声重叠）
+void test_property_gating() {
+    printf("\n[Property Test] 语音 + 舵机噪声 - 100次迭代\n");
+
+    SelfNoiseGate gate;
+    for (int v = 0; v < 3; v++) {
+        calibrate(gate, SKETCH_VELOCITIES[v], 0.02f, 100 + v);
+    }
+
+    uint32_t rawWakeups = 0;
+    for (int i = 0; i < 100; i++) {
+        SceneSpec spec = overlapScene(SKETCH_VELOCITIES[i % 3] * testRandom(0.9f, 1.1f));
+        spec.servoLevel = testRandom(0.01f, 0.03f);
+        spec.sourceLevel = testRandom(0.08f, 0.3f);
+        spec.angleDeg = testRandom(-60, 60);
+        spec.seed = 1000 + i;
+
+        SimReport gated = runMix(spec, "noise_property.wav", &gate);
+        if (i % 10 == 0) {
+            rawWakeups += runMix(spec, "noise_property.wav", nullptr).falseTriggers;
+        }
+
+        if (gated.falseTriggers != 0 || gated.selfNoiseTriggers != 0) {
+            char msg[120];
+            snprintf(msg, sizeof(msg), "Iter %d: v=%.0f servo=%.3f 自噪声触发 %u 帧", i,
+                     spec.servoVelocityDps, spec.servoLevel, (unsigned)gated.falseTriggers);
+            TEST_FAIL_MESSAGE(msg);
+        }
+        if (gated.detectionLatencyMs < 0 || gated.detectionLatencyMs > 96) {
+            char msg[120];
+            snprintf(msg, sizeof(msg), "Iter %d: level=%.2f 检测延迟 %.1fms", i,
+                     spec.sourceLevel, gated.detectionLatencyMs);
+            TEST_FAIL_MESSAGE(msg);
+        }
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+
+    printf("  抽样10次无门控误唤醒帧: %u，有门控: 0\n", (unsigned)rawWakeups);
+    TEST_ASSERT_TRUE(rawWakeups > 0);
+}
+
+// ========================================
+// 性能测试
+// ========================================
+
+void test_benchmark_gate_cost() {
+    SelfNoiseGate gate;
+    calibrate(gate, 100, 0.02f, 7);
+
+    static int32_t frame[CAPTURE_FRAME_SAMPLES * CAPTURE_CHANNELS];
+    for (size_t i = 0; i < CAPTURE_FRAME_SAMPLES * CAPTURE_CHANNELS; i++) {
+        frame[i] = (int32_t)(testRandom(-3000, 3000)) * 65536;
+    }
+
+    const int RUNS = 5000;
+    MotionState moving = { true, 100 };
+    float sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < RUNS; r++) {
+        sink += gate.process(frame, CAPTURE_FRAME_SAMPLES, moving).gain;
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / RUNS;
+
+    printf("  运动中每帧门控耗时: %.0f ns（帧长 32ms）%s\n", ns, sink < 0 ? "" : "");
+    TEST_PASS();
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("SelfNoiseGate 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_motion_tracker);
+    RUN_TEST(test_unit_velocity_class);
+    RUN_TEST(test_unit_still_passthrough);
+    RUN_TEST(test_unit_unprofiled);
+    RUN_TEST(test_unit_learn_profile);
+    RUN_TEST(test_unit_servo_only);
+    RUN_TEST(test_unit_speech_during_motion);
+    RUN_TEST(test_unit_noise_floor_frozen);
+
+    printf("\n========================================\n");
+    printf("SelfNoiseGate 属性测试 / 性能测试\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_gating);
+    RUN_TEST(test_benchmark_gate_cost);
+
+    return UNITY_END();
+}
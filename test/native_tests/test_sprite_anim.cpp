@@ -0,0 +1,525 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "SpriteAnim.h"
+#include "TileFlusher.h"
+#include "RecordingTileTransport.h"
+#include "FaceSpritesData.h"
+
+// ========================================
+// SpriteAnim 测试（主机端，native 环境）
+// 闪存表情动画：行程编码、关键帧/差分帧、动画库解析、非阻塞播放
+// 运行：python tools/run_native_tests.py test_sprite_anim
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 22360;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+typedef std::vector<uint8_t> Bytes;
+
+// 与 tools/make_sprite_anim.py rle_encode() 相同的行程编码
+static Bytes rleEncode(const Bytes& data) {
+    Bytes out, literal;
+    auto flush = [&]() {
+        if (!literal.empty()) {
+            out.push_back((uint8_t)(literal.size() - 1));
+            out.insert(out.end(), literal.begin(), literal.end());
+            literal.clear();
+        }
+    };
+    size_t i = 0;
+    while (i < data.size()) {
+        size_t run = 1;
+        while (i + run < data.size() && data[i + run] == data[i] && run < 129) run++;
+        if (run >= 3 || (run == 2 && literal.empty())) {
+            flush();
+            out.push_back((uint8_t)(0x80 | (run - 2)));
+            out.push_back(data[i]);
+            i += run;
+        } else {
+            literal.push_back(data[i++]);
+            if (literal.size() == 128) flush();
+        }
+    }
+    flush();
+    return out;
+}
+
+// 动画库构建（与 make_sprite_anim.py 的输出格式相同）；types 为空时第一帧关键帧、其余差分帧
+struct TestAnim {
+    const char* name;
+    uint8_t width, pages;
+    uint16_t frameMs;
+    uint8_t flags;
+    std::vector<Bytes> frames;
+    std::vector<uint8_t> types;
+};
+
+static Bytes buildBank(const std::vector<TestAnim>& anims) {
+    Bytes table, blob;
+    uint32_t offset = sizeof(SpriteBankHeader) + anims.size() * sizeof(SpriteAnimEntry);
+    for (const TestAnim& a : anims) {
+        while (offset % 4) {
+            blob.push_back(0);
+            offset++;
+        }
+        Bytes data;
+        for (size_t f = 0; f < a.frames.size(); f++) {
+            uint8_t type = f < a.types.size() ? a.types[f] : (uint8_t)(f == 0 ? SPRITE_FRAME_KEY : SPRITE_FRAME_DELTA);
+            Bytes src = a.frames[f];
+            if (type == SPRITE_FRAME_DELTA && f > 0) {
+                for (size_t k = 0; k < src.size(); k++) src[k] ^= a.frames[f - 1][k];
+            }
+            Bytes rle = rleEncode(src);
+            SpriteFrameHeader fh = {type, 0, (uint16_t)rle.size()};
+            data.insert(data.end(), (uint8_t*)&fh, (uint8_t*)&fh + sizeof(fh));
+            data.insert(data.end(), rle.begin(), rle.end());
+        }
+        SpriteAnimEntry e;
+        memset(&e, 0, sizeof(e));
+        strncpy(e.name, a.name, SPRITE_NAME_LEN - 1);
+        e.width = a.width;
+        e.pages = a.pages;
+        e.frameCount = (uint16_t)a.frames.size();
+        e.frameMs = a.frameMs;
+        e.flags = a.flags;
+        e.offset = offset;
+        e.dataBytes = (uint32_t)data.size();
+        table.insert(table.end(), (uint8_t*)&e, (uint8_t*)&e + sizeof(e));
+        blob.insert(blob.end(), data.begin(), data.end());
+        offset += data.size();
+    }
+    SpriteBankHeader h = {SPRITE_BANK_MAGIC, SPRITE_BANK_VERSION, (uint16_t)anims.size()};
+    Bytes bank((uint8_t*)&h, (uint8_t*)&h + sizeof(h));
+    bank.insert(bank.end(), table.begin(), table.end());
+    bank.insert(bank.end(), blob.begin(), blob.end());
+    return bank;
+}
+
+// 随机帧：稀疏的小块图案，相邻帧只改一部分（接近表情动画）
+static Bytes randomFrame(uint8_t width, uint8_t pages) {
+    Bytes f(width * pages, 0);
+    int blobs = testRandomInt(0, 6);
+    for (int b = 0; b < blobs; b++) {
+        int at = testRandomInt(0, (int)f.size() - 1), len = testRandomInt(1, 12);
+        for (int k = 0; k < len && at + k < (int)f.size(); k++) f[at + k] = (uint8_t)testRandomInt(0, 255);
+    }
+    return f;
+}
+
+static Bytes mutateFrame(const Bytes& prev) {
+    Bytes f = prev;
+    int edits = testRandomInt(0, 8);
+    for (int e = 0; e < edits; e++) f[testRandomInt(0, (int)f.size() - 1)] = (uint8_t)testRandomInt(0, 255);
+    return f;
+}
+
+// 直接把帧按位置贴进缓冲（参考结果）
+static void blit(uint8_t* buffer, const Bytes& frame, uint8_t width, uint8_t pages, int x, int page) {
+    for (int p = 0; p < pages; p++) {
+        for (int c = 0; c < width; c++) {
+            int row = page + p, px = x + c;
+            if (row >= 0 && row < DISPLAY_TILE_ROWS && px >= 0 && px < DISPLAY_WIDTH) {
+                buffer[row * DISPLAY_WIDTH + px] = frame[p * width + c];
+            }
+        }
+    }
+}
+
+// ========================================
+// 单元测试
+// ========================================
+
+// 单元测试1: 关键帧解码：原样段 + 重复段，精灵矩形外不变
+void test_unit_key_frame_decode() {
+    Bytes frame(24 * 2);
+    for (size_t i = 0; i < frame.size(); i++) frame[i] = (i < 10) ? 0xFF : (uint8_t)(i * 37);
+    Bytes rle = rleEncode(frame);
+    TEST_ASSERT_TRUE(rle.size() < frame.size() + 2);
+
+    uint8_t buffer[DISPLAY_BUFFER_SIZE], expect[DISPLAY_BUFFER_SIZE];
+    memset(buffer, 0x5A, sizeof(buffer));
+    memcpy(expect, buffer, sizeof(buffer));
+    blit(expect, frame, 24, 2, 30, 3);
+
+    TEST_ASSERT_TRUE(spriteDecodeFrame(rle.data(), (uint16_t)rle.size(), SPRITE_FRAME_KEY, 24, 2, 30, 3, buffer));
+    TEST_ASSERT_EQUAL_MEMORY(expect, buffer, DISPLAY_BUFFER_SIZE);
+}
+
+// 单元测试2: 差分帧异或到上一帧得到下一帧，未变化处的 0 行程只占 2 字节
+void test_unit_delta_frame_decode() {
+    Bytes a(64 * 4, 0), b;
+    for (int i = 0; i < 64; i++) a[64 + i] = (uint8_t)(i & 0x0F);
+    b = a;
+    b[100] ^= 0x81;
+    b[200] = 0x3C;
+
+    Bytes diff(a.size());
+    for (size_t i = 0; i < a.size(); i++) diff[i] = a[i] ^ b[i];
+    Bytes rle = rleEncode(diff);
+    TEST_ASSERT_TRUE(rle.size() <= 12);
+
+    uint8_t buffer[DISPLAY_BUFFER_SIZE], expect[DISPLAY_BUFFER_SIZE];
+    memset(buffer, 0, sizeof(buffer));
+    blit(buffer, a, 64, 4, 10, 2);
+    memcpy(expect, buffer, sizeof(buffer));
+    blit(expect, b, 64, 4, 10, 2);
+
+    TEST_ASSERT_TRUE(spriteDecodeFrame(rle.data(), (uint16_t)rle.size(), SPRITE_FRAME_DELTA, 64, 4, 10, 2, buffer));
+    TEST_ASSERT_EQUAL_MEMORY(expect, buffer, DISPLAY_BUFFER_SIZE);
+}
+
+// 单元测试3: 部分或全部在屏幕外：只写可见部分，不越界；数据长度不符返回 false
+void test_unit_clipping_and_malformed() {
+    Bytes frame(40 * 3);
+    for (size_t i = 0; i < frame.size(); i++) frame[i] = (uint8_t)(i + 1);
+    Bytes rle = rleEncode(frame);
+
+    const int positions[][2] = {{-20, 0}, {110, 6}, {-40, 0}, {128, 0}, {0, -2}, {50, 7}, {-10, -1}};
+    for (const auto& pos : positions) {
+        uint8_t guarded[DISPLAY_BUFFER_SIZE + 32];
+        memset(guarded, 0xEE, sizeof(guarded));
+        uint8_t* buffer = guarded + 16;
+        memset(buffer, 0, DISPLAY_BUFFER_SIZE);
+        uint8_t expect[DISPLAY_BUFFER_SIZE];
+        memset(expect, 0, sizeof(expect));
+        blit(expect, frame, 40, 3, pos[0], pos[1]);
+
+        TEST_ASSERT_TRUE(spriteDecodeFrame(rle.data(), (uint16_t)rle.size(), SPRITE_FRAME_KEY, 40, 3,
+                                           (int16_t)pos[0], (int8_t)pos[1], buffer));
+        TEST_ASSERT_EQUAL_MEMORY(expect, buffer, DISPLAY_BUFFER_SIZE);
+        for (int k = 0; k < 16; k++) {
+            TEST_ASSERT_EQUAL_HEX8(0xEE, guarded[k]);
+            TEST_ASSERT_EQUAL_HEX8(0xEE, guarded[16 + DISPLAY_BUFFER_SIZE + k]);
+        }
+    }
+
+    uint8_t buffer[DISPLAY_BUFFER_SIZE];
+    TEST_ASSERT_FALSE(spriteDecodeFrame(rle.data(), (uint16_t)(rle.size() - 1), SPRITE_FRAME_KEY, 40, 3, 0, 0, buffer));
+    TEST_ASSERT_FALSE(spriteDecodeFrame(rle.data(), (uint16_t)rle.size(), SPRITE_FRAME_KEY, 40, 2, 0, 0, buffer));
+    TEST_ASSERT_FALSE(spriteDecodeFrame(rle.data(), (uint16_t)rle.size(), SPRITE_FRAME_KEY, 41, 3, 0, 0, buffer));
+}
+
+// 单元测试4: 动画库解析：正常库可查找；魔数、越界、帧数、第一帧类型错误时拒绝
+void test_unit_bank_attach() {
+    TestAnim a = {"blink", 16, 2, 50, SPRITE_ANIM_LOOP, {}, {}};
+    a.frames.push_back(randomFrame(16, 2));
+    a.frames.push_back(mutateFrame(a.frames[0]));
+    TestAnim b = {"look", 8, 1, 100, 0, {}, {}};
+    b.frames.push_back(randomFrame(8, 1));
+    Bytes bank = buildBank({a, b});
+
+    SpriteBank sb;
+    TEST_ASSERT_TRUE(sb.attach(bank.data(), bank.size()));
+    TEST_ASSERT_EQUAL(2, sb.animCount());
+    TEST_ASSERT_EQUAL(1, sb.findAnim("look"));
+    TEST_ASSERT_EQUAL(-1, sb.findAnim("happy"));
+    TEST_ASSERT_EQUAL_STRING("blink", sb.animName(0));
+    SpriteClip clip;
+    TEST_ASSERT_TRUE(sb.getAnim(0, clip));
+    TEST_ASSERT_EQUAL(2, clip.frameCount);
+    TEST_ASSERT_EQUAL(16, clip.width);
+    TEST_ASSERT_EQUAL(50, clip.frameMs);
+    TEST_ASSERT_FALSE(sb.getAnim(2, clip));
+
+    Bytes bad = bank;
+    bad[0] ^= 1;
+    TEST_ASSERT_FALSE(sb.attach(bad.data(), bad.size()));
+    TEST_ASSERT_EQUAL(0, sb.animCount());
+    TEST_ASSERT_FALSE(sb.attach(bank.data(), bank.size() - 1));   // 最后一帧被截断
+
+    bad = bank;
+    SpriteAnimEntry* e0 = (SpriteAnimEntry*)(bad.data() + sizeof(SpriteBankHeader));
+    e0->frameCount = 3;
+    TEST_ASSERT_FALSE(sb.attach(bad.data(), bad.size()));
+    bad = bank;
+    e0 = (SpriteAnimEntry*)(bad.data() + sizeof(SpriteBankHeader));
+    e0->offset = 1 << 20;
+    TEST_ASSERT_FALSE(sb.attach(bad.data(), bad.size()));
+
+    TestAnim c = a;
+    c.types = {SPRITE_FRAME_DELTA, SPRITE_FRAME_DELTA};
+    c.frames[0] = Bytes(32, 0);   // 第一帧按差分帧存放
+    Bytes noKey = buildBank({c});
+    TEST_ASSERT_FALSE(sb.attach(noKey.data(), noKey.size()));
+}
+
+// 单元测试5: 按帧时长推进，落后时最多连续解码 SPRITE_MAX_CATCHUP 帧；循环回到第一帧，单次播放停在最后一帧
+void test_unit_player_timing() {
+    TestAnim a = {"t", 8, 1, 40, 0, {}, {}};
+    for (int f = 0; f < 5; f++) a.frames.push_back(Bytes(8, (uint8_t)(f + 1)));
+    Bytes bank = buildBank({a});
+    SpriteBank sb;
+    TEST_ASSERT_TRUE(sb.attach(bank.data(), bank.size()));
+    SpriteClip clip;
+    sb.getAnim(0, clip);
+
+    uint8_t buffer[DISPLAY_BUFFER_SIZE];
+    memset(buffer, 0, sizeof(buffer));
+    SpritePlayer player;
+    player.play(clip, 0, 0, true);
+    TEST_ASSERT_EQUAL(-1, player.frame());
+
+    TEST_ASSERT_EQUAL(1, player.update(1000, buffer));
+    TEST_ASSERT_EQUAL(0, player.frame());
+    TEST_ASSERT_EQUAL_HEX8(1, buffer[0]);
+    TEST_ASSERT_EQUAL(0, player.update(1039, buffer));
+    TEST_ASSERT_EQUAL(1, player.update(1040, buffer));
+    TEST_ASSERT_EQUAL_HEX8(2, buffer[7]);
+    TEST_ASSERT_EQUAL(2, player.update(1120, buffer));
+    TEST_ASSERT_EQUAL(3, player.frame());
+    TEST_ASSERT_EQUAL(SPRITE_MAX_CATCHUP, player.update(2000, buffer));   // 落后很多：不跳过差分帧，只补 4 帧
+    TEST_ASSERT_EQUAL(2, player.frame());                                  // 4 → 0（循环）→ 1 → 2
+    TEST_ASSERT_EQUAL_HEX8(3, buffer[0]);
+    TEST_ASSERT_EQUAL(1, player.stats().late);
+    TEST_ASSERT_EQUAL(0, player.update(2039, buffer));
+    TEST_ASSERT_EQUAL(1, player.update(2040, buffer));
+
+    player.play(clip, 0, 0, false);
+    uint32_t now = 5000;
+    int decoded = 0;
+    for (int i = 0; i < 20; i++, now += 40) decoded += player.update(now, buffer);
+    TEST_ASSERT_EQUAL(5, decoded);
+    TEST_ASSERT_FALSE(player.playing());
+    TEST_ASSERT_EQUAL(4, player.frame());
+    TEST_ASSERT_EQUAL_HEX8(5, buffer[3]);
+    TEST_ASSERT_EQUAL(0, player.stats().errors);
+}
+
+// 单元测试6: 缓冲被清空后 redraw() 从最近的关键帧重画出当前帧
+void test_unit_redraw_after_clear() {
+    TestAnim a = {"r", 20, 2, 10, SPRITE_ANIM_LOOP, {}, {}};
+    a.frames.push_back(randomFrame(20, 2));
+    for (int f = 1; f < 8; f++) a.frames.push_back(mutateFrame(a.frames[f - 1]));
+    a.types = {SPRITE_FRAME_KEY, SPRITE_FRAME_DELTA, SPRITE_FRAME_DELTA, SPRITE_FRAME_KEY,
+               SPRITE_FRAME_DELTA, SPRITE_FRAME_DELTA, SPRITE_FRAME_DELTA, SPRITE_FRAME_DELTA};
+    Bytes bank = buildBank({a});
+    SpriteBank sb;
+    TEST_ASSERT_TRUE(sb.attach(bank.data(), bank.size()));
+    SpriteClip clip;
+    sb.getAnim(0, clip);
+
+    uint8_t buffer[DISPLAY_BUFFER_SIZE], expect[DISPLAY_BUFFER_SIZE];
+    memset(buffer, 0, sizeof(buffer));
+    SpritePlayer player;
+    player.redraw(buffer);   // 尚未开始：什么也不做
+    player.play(clip, 100, 5);
+    for (uint32_t t = 0; t <= 50; t += 10) player.update(t, buffer);
+    TEST_ASSERT_EQUAL(5, player.frame());
+
+    memset(buffer, 0, sizeof(buffer));
+    player.redraw(buffer);
+    memset(expect, 0, sizeof(expect));
+    blit(expect, a.frames[5], 20, 2, 100, 5);
+    TEST_ASSERT_EQUAL_MEMORY(expect, buffer, DISPLAY_BUFFER_SIZE);
+
+    // 重画后继续播放仍然正确
+    player.update(60, buffer);
+    blit(expect, a.frames[6], 20, 2, 100, 5);
+    TEST_ASSERT_EQUAL_MEMORY(expect, buffer, DISPLAY_BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(2, player.stats().keyFrames);
+}
+
+// 单元测试7: 生成的表情库（FaceSpritesData.h）能解析，所有帧解码无误，与 test7 的布局一致
+void test_unit_face_sprites() {
+    SpriteBank sb;
+    TEST_ASSERT_TRUE(sb.attach(FACE_SPRITES, sizeof(FACE_SPRITES)));
+    TEST_ASSERT_EQUAL(3, sb.animCount());
+    TEST_ASSERT_TRUE(sb.findAnim("blink") >= 0);
+    TEST_ASSERT_TRUE(sb.findAnim("look") >= 0);
+    TEST_ASSERT_TRUE(sb.findAnim("happy") >= 0);
+
+    for (uint16_t a = 0; a < sb.animCount(); a++) {
+        SpriteClip clip;
+        sb.getAnim(a, clip);
+        TEST_ASSERT_EQUAL(80, clip.width);
+        TEST_ASSERT_EQUAL(5, clip.pages);
+
+        uint8_t buffer[DISPLAY_BUFFER_SIZE];
+        memset(buffer, 0, sizeof(buffer));
+        SpritePlayer player;
+        player.play(clip, 24, 2, false);
+        for (uint32_t t = 0; player.playing(); t += clip.frameMs) player.update(t, buffer);
+        TEST_ASSERT_EQUAL(clip.frameCount - 1, player.frame());
+        TEST_ASSERT_EQUAL(0, player.stats().errors);
+        TEST_ASSERT_EQUAL(clip.dataBytes, player.stats().bytesRead);
+    }
+
+    // blink 第一帧：嘴巴为 (30, 50) ~ (98, 50) 的横线，与 test7 原来的位置相同
+    SpriteClip blink;
+    sb.getAnim((uint16_t)sb.findAnim("blink"), blink);
+    uint8_t buffer[DISPLAY_BUFFER_SIZE];
+    memset(buffer, 0, sizeof(buffer));
+    SpritePlayer player;
+    player.play(blink, 24, 2);
+    player.update(0, buffer);
+    for (int x = 30; x <= 98; x++) {
+        TEST_ASSERT_TRUE((buffer[6 * DISPLAY_WIDTH + x] >> 2) & 1);
+    }
+    TEST_ASSERT_FALSE((buffer[6 * DISPLAY_WIDTH + 29] >> 2) & 1);
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 随机尺寸/位置/帧序列/关键帧分布：
+// - 每次 update() 后精灵矩形等于当前帧，矩形外的缓冲不变
+// - 读出的字节数等于已播放帧的数据量
+void test_property_playback_matches_frames() {
+    printf("\n[Property Test] 随机动画逐帧播放与原始帧一致 - 100次迭代\n");
+
+    for (int i = 0; i < 100; i++) {
+        TestAnim a = {"p", (uint8_t)testRandomInt(1, 128), (uint8_t)testRandomInt(1, 8),
+                      (uint16_t)testRandomInt(1, 100), SPRITE_ANIM_LOOP, {}, {}};
+        int count = testRandomInt(1, 12);
+        a.frames.push_back(randomFrame(a.width, a.pages));
+        a.types.push_back(SPRITE_FRAME_KEY);
+        for (int f = 1; f < count; f++) {
+            a.frames.push_back(testRandomInt(0, 3) == 0 ? randomFrame(a.width, a.pages) : mutateFrame(a.frames[f - 1]));
+            a.types.push_back(testRandomInt(0, 4) == 0 ? SPRITE_FRAME_KEY : SPRITE_FRAME_DELTA);
+        }
+        Bytes bank = buildBank({a});
+        SpriteBank sb;
+        if (!sb.attach(bank.data(), bank.size())) TEST_FAIL_MESSAGE("动画库解析失败");
+        SpriteClip clip;
+        sb.getAnim(0, clip);
+
+        int x = testRandomInt(-a.width, DISPLAY_WIDTH), page = testRandomInt(-a.pages, DISPLAY_TILE_ROWS);
+        uint8_t fill = (uint8_t)testRandomInt(0, 255);
+        uint8_t buffer[DISPLAY_BUFFER_SIZE], expect[DISPLAY_BUFFER_SIZE];
+        memset(buffer, fill, sizeof(buffer));
+
+        SpritePlayer player;
+        player.play(clip, (int16_t)x, (int8_t)page);
+        uint32_t now = 0;
+        int plays = count * 2 + 1;   // 至少循环一次
+        for (int s = 0; s < plays; s++, now += a.frameMs) {
+            if (player.update(now, buffer) != 1) TEST_FAIL_MESSAGE("按时调用时应解码一帧");
+            memset(expect, fill, sizeof(expect));
+            blit(expect, a.frames[s % count], a.width, a.pages, x, page);
+            if (memcmp(expect, buffer, sizeof(buffer)) != 0) {
+                char msg[64];
+                snprintf(msg, sizeof(msg), "Iter %d 第 %d 帧: 缓冲与原始帧不一致", i, s);
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+        uint32_t expectBytes = (plays / count) * clip.dataBytes;
+        uint32_t cursor = 0;
+        for (int f = 0; f < plays % count; f++) {
+            SpriteFrameHeader fh;
+            memcpy(&fh, clip.frames + cursor, sizeof(fh));
+            cursor += sizeof(fh) + fh.bytes;
+        }
+        if (player.stats().bytesRead != expectBytes + cursor) TEST_FAIL_MESSAGE("读出字节数不符");
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+
+    TEST_PASS();
+}
+
+// ========================================
+// 性能测试
+// ========================================
+
+// 性能1: 表情库的闪存占用、每帧解码时间和总线字节（原 test7 每帧整帧 sendBuffer）
+void test_benchmark_face_sprites() {
+    printf("\n[Benchmark] 表情动画：闪存占用、解码时间、每帧总线字节\n");
+
+    SpriteBank sb;
+    TEST_ASSERT_TRUE(sb.attach(FACE_SPRITES, sizeof(FACE_SPRITES)));
+
+    uint32_t rawBytes = 0, frames = 0;
+    for (uint16_t a = 0; a < sb.animCount(); a++) {
+        SpriteClip clip;
+        sb.getAnim(a, clip);
+        rawBytes += (uint32_t)clip.frameCount * clip.width * clip.pages;
+        frames += clip.frameCount;
+    }
+    printf("  %d 个表情 %lu 帧：原始位图 %lu 字节，动画库 %lu 字节（%.1f%%）\n",
+           (int)sb.animCount(), (unsigned long)frames, (unsigned long)rawBytes,
+           (unsigned long)sizeof(FACE_SPRITES), 100.0 * sizeof(FACE_SPRITES) / rawBytes);
+
+    const int LOOPS = 2000;
+    uint8_t buffer[DISPLAY_BUFFER_SIZE];
+    for (uint16_t a = 0; a < sb.animCount(); a++) {
+        SpriteClip clip;
+        sb.getAnim(a, clip);
+        memset(buffer, 0, sizeof(buffer));
+
+        SpritePlayer player;
+        player.play(clip, 24, 2, true);
+        uint32_t now = 0;
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (int k = 0; k < LOOPS * clip.frameCount; k++, now += clip.frameMs) {
+            player.update(now, buffer);
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        double us = std::chrono::duration<double, std::micro>(t1 - t0).count() / (LOOPS * clip.frameCount);
+
+        // 每帧只发送变化的块
+        RecordingTileTransport bus;
+        TileFlusher flusher(bus);
+        memset(buffer, 0, sizeof(buffer));
+        player.play(clip, 24, 2, true);
+        player.update(0, buffer);
+        flusher.flush(buffer);
+        bus.reset();
+        now = 0;
+        for (int k = 1; k < clip.frameCount; k++) {
+            player.update(now += clip.frameMs, buffer);
+            flusher.flush(buffer);
+        }
+        double busPerFrame = (double)bus.bytes / (clip.frameCount - 1);
+        printf("  %-6s %2d 帧：解码 %5.2f us/帧，读 %5.1f 字节/帧，增量发送 %6.1f 字节/帧（整帧 %lu）\n",
+               sb.animName(a), (int)clip.frameCount, us, (double)player.stats().bytesRead / player.stats().frames,
+               busPerFrame, (unsigned long)RecordingTileTransport::fullFrameBytes());
+        TEST_ASSERT_EQUAL(0, player.stats().errors);
+        TEST_ASSERT_TRUE(busPerFrame < RecordingTileTransport::fullFrameBytes());
+    }
+    TEST_ASSERT_TRUE(sizeof(FACE_SPRITES) * 4 < rawBytes);
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("SpriteAnim 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_key_frame_decode);
+    RUN_TEST(test_unit_delta_frame_decode);
+    RUN_TEST(test_unit_clipping_and_malformed);
+    RUN_TEST(test_unit_bank_attach);
+    RUN_TEST(test_unit_player_timing);
+    RUN_TEST(test_unit_redraw_after_clear);
+    RUN_TEST(test_unit_face_sprites);
+
+    printf("\n========================================\n");
+    printf("SpriteAnim 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_playback_matches_frames);
+
+    printf("\n========================================\n");
+    printf("SpriteAnim 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_face_sprites);
+
+    return UNITY_END();
+}
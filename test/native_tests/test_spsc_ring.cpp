@@ -0,0 +1,337 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <thread>
+#include <chrono>
+#include "SpscRing.h"
+
+// ========================================
+// SpscRing 测试（主机端，native 环境）
+// Property: 单生产者/单消费者下数据不丢失、不重复、不乱序
+// 运行：python tools/run_native_tests.py test_spsc_ring
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static unsigned long testRandomInt(unsigned long min, unsigned long max) {
+    static unsigned long seed = 24680;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + seed % (max - min + 1);
+}
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: 基本读写
+void test_unit_push_pop() {
+    SpscRing<int, 8> ring;
+
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_TRUE(ring.push(1));
+    TEST_ASSERT_TRUE(ring.push(2));
+    TEST_ASSERT_EQUAL(2, ring.size());
+
+    int value = 0;
+    TEST_ASSERT_TRUE(ring.pop(value));
+    TEST_ASSERT_EQUAL(1, value);
+    TEST_ASSERT_TRUE(ring.pop(value));
+    TEST_ASSERT_EQUAL(2, value);
+    TEST_ASSERT_FALSE(ring.pop(value));
+}
+
+// 单元测试2: 满/空边界
+void test_unit_full_empty() {
+    SpscRing<int, 4> ring;
+
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ring.push(i));
+    }
+    TEST_ASSERT_TRUE(ring.full());
+    TEST_ASSERT_FALSE(ring.push(99));  // 满时拒绝写入
+
+    int value;
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ring.pop(value));
+        TEST_ASSERT_EQUAL(i, value);
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+// 单元测试3: claim 不跨越缓冲区末尾
+void test_unit_claim_contiguous() {
+    SpscRing<int, 8> ring;
+    int* slot;
+    const int* rslot;
+
+    // 先推进到下标6
+    TEST_ASSERT_EQUAL(6, ring.claim(&slot, 6));
+    ring.commit(6);
+    TEST_ASSERT_EQUAL(6, ring.peek(&rslot, 6));
+    ring.release(6);
+
+    // 剩余8个空闲，但到末尾只有2个连续槽位
+    size_t n = ring.claim(&slot, 8);
+    TEST_ASSERT_EQUAL(2, n);
+    slot[0] = 10;
+    slot[1] = 11;
+    ring.commit(n);
+
+    // 回绕后拿到剩下的6个
+    n = ring.claim(&slot, 8);
+    TEST_ASSERT_EQUAL(6, n);
+    for (size_t i = 0; i < n; i++) slot[i] = 12 + (int)i;
+    ring.commit(n);
+
+    int out[8];
+    TEST_ASSERT_EQUAL(8, ring.read(out, 8));
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(10 + i, out[i]);
+    }
+}
+
+// 单元测试4: 未 commit 的数据对消费者不可见
+void test_unit_uncommitted_invisible() {
+    SpscRing<int, 8> ring;
+    int* slot;
+    const int* rslot;
+
+    ring.claim(&slot, 4);
+    slot[0] = 1;
+    TEST_ASSERT_EQUAL(0, ring.peek(&rslot, 4));
+
+    ring.commit(1);
+    TEST_ASSERT_EQUAL(1, ring.peek(&rslot, 4));
+    TEST_ASSERT_EQUAL(1, rslot[0]);
+}
+
+// 单元测试5: 下标布局（生产者/消费者下标不在同一缓存行）
+void test_unit_cache_line_padding() {
+    TEST_ASSERT_TRUE(alignof(SpscRing<uint8_t, 16>) >= SPSC_CACHE_LINE);
+    TEST_ASSERT_TRUE(sizeof(SpscRing<uint8_t, 16>) >= 3 * SPSC_CACHE_LINE);
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 随机批量读写顺序一致（单线程交错）
+void test_property_random_batches() {
+    printf("\n[Property Test] 随机批量读写 - 100次迭代\n");
+
+    for (int i = 0; i < 100; i++) {
+        SpscRing<uint32_t, 64> ring;
+        uint32_t nextWrite = 0;
+        uint32_t nextRead = 0;
+
+        for (int step = 0; step < 200; step++) {
+            uint32_t* slot;
+            size_t n = ring.claim(&slot, testRandomInt(1, 40));
+            for (size_t k = 0; k < n; k++) slot[k] = nextWrite++;
+            ring.commit(n);
+
+            const uint32_t* rslot;
+            size_t m = ring.peek(&rslot, testRandomInt(1, 40));
+            for (size_t k = 0; k < m; k++) {
+                if (rslot[k] != nextRead) {
+                    char msg[100];
+                    snprintf(msg, sizeof(msg), "Iter %d: expected %u, got %u",
+                             i, (unsigned)nextRead, (unsigned)rslot[k]);
+                    TEST_FAIL_MESSAGE(msg);
+                }
+                nextRead++;
+            }
+            ring.release(m);
+
+            if (ring.size() > ring.capacity()) {
+                TEST_FAIL_MESSAGE("size() 超过容量");
+            }
+        }
+    }
+
+    TEST_PASS();
+}
+
+// ========================================
+// 多线程压力测试与吞吐量
+// ========================================
+
+static const uint32_t STRESS_ITEMS = 2000000;
+
+// 压力测试1: 单元素 push/pop，两个线程
+void test_stress_single_items() {
+    static SpscRing<uint32_t, 256> ring;
+    bool ordered = true;
+
+    std::thread consumer([&]() {
+        uint32_t expected = 0;
+        uint32_t value;
+        while (expected < STRESS_ITEMS) {
+            if (ring.pop(value)) {
+                if (value != expected) ordered = false;
+                expected++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (uint32_t i = 0; i < STRESS_ITEMS; ) {
+        if (ring.push(i)) {
+            i++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    TEST_ASSERT_TRUE_MESSAGE(ordered, "多线程下出现丢失/乱序");
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+// 压力测试2: 零拷贝批量接口，两个线程，随机批量大小
+void test_stress_batches() {
+    static SpscRing<uint32_t, 1024> ring;
+    bool ordered = true;
+
+    std::thread consumer([&]() {
+        uint32_t expected = 0;
+        size_t batch = 1;
+        while (expected < STRESS_ITEMS) {
+            const uint32_t* slot;
+            size_t n = ring.peek(&slot, batch);
+            for (size_t k = 0; k < n; k++) {
+                if (slot[k] != expected) ordered = false;
+                expected++;
+            }
+            ring.release(n);
+            if (n == 0) std::this_thread::yield();
+            batch = (batch * 7 + 3) % 300 + 1;
+        }
+    });
+
+    uint32_t next = 0;
+    size_t batch = 1;
+    while (next < STRESS_ITEMS) {
+        uint32_t* slot;
+        size_t want = batch;
+        if (want > STRESS_ITEMS - next) want = STRESS_ITEMS - next;
+        size_t n = ring.claim(&slot, want);
+        for (size_t k = 0; k < n; k++) slot[k] = next++;
+        ring.commit(n);
+        if (n == 0) std::this_thread::yield();
+        batch = (batch * 5 + 1) % 250 + 1;
+    }
+    consumer.join();
+
+    TEST_ASSERT_TRUE_MESSAGE(ordered, "批量接口出现丢失/乱序");
+}
+
+// 吞吐量: 模拟I2S帧（512个立体声采样）在线程间传递
+struct AudioFrame {
+    int32_t samples[512 * 2];
+};
+
+void test_throughput_frames() {
+    static SpscRing<AudioFrame, 8> ring;
+    const int FRAMES = 20000;
+    int64_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread consumer([&]() {
+        int received = 0;
+        while (received < FRAMES) {
+            const AudioFrame* frame;
+            if (ring.peek(&frame, 1) == 1) {
+                checksum += frame->samples[0];
+                ring.release(1);
+                received++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (int i = 0; i < FRAMES; ) {
+        AudioFrame* frame;
+        if (ring.claim(&frame, 1) == 1) {
+            frame->samples[0] = i;  // 生产者直接写入槽位，无中间拷贝
+            ring.commit(1);
+            i++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    printf("  帧吞吐: %.0f 帧/秒 (%.1f MB/s)\n",
+           FRAMES / seconds, FRAMES * sizeof(AudioFrame) / seconds / 1e6);
+    TEST_ASSERT_EQUAL((int64_t)FRAMES * (FRAMES - 1) / 2, checksum);
+}
+
+void test_throughput_items() {
+    static SpscRing<uint32_t, 1024> ring;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread consumer([&]() {
+        uint32_t received = 0;
+        while (received < STRESS_ITEMS) {
+            const uint32_t* slot;
+            size_t n = ring.peek(&slot, 64);
+            ring.release(n);
+            received += n;
+            if (n == 0) std::this_thread::yield();
+        }
+    });
+
+    uint32_t sent = 0;
+    while (sent < STRESS_ITEMS) {
+        uint32_t* slot;
+        size_t n = ring.claim(&slot, 64);
+        for (size_t k = 0; k < n; k++) slot[k] = sent + k;
+        ring.commit(n);
+        sent += n;
+        if (n == 0) std::this_thread::yield();
+    }
+    consumer.join();
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    printf("  元素吞吐（批量64）: %.1f M元素/秒\n", STRESS_ITEMS / seconds / 1e6);
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("SpscRing 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_push_pop);
+    RUN_TEST(test_unit_full_empty);
+    RUN_TEST(test_unit_claim_contiguous);
+    RUN_TEST(test_unit_uncommitted_invisible);
+    RUN_TEST(test_unit_cache_line_padding);
+
+    printf("\n========================================\n");
+    printf("SpscRing 属性测试 / 压力测试\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_random_batches);
+    RUN_TEST(test_stress_single_items);
+    RUN_TEST(test_stress_batches);
+    RUN_TEST(test_throughput_frames);
+    RUN_TEST(test_throughput_items);
+
+    return UNITY_END();
+}
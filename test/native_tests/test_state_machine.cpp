@@ -0,0 +1,575 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "StateMachine.h"
+
+// ========================================
+// StateMachine 测试（主机端，native 环境）
+// 表驱动状态机：进入/退出动作、守卫、内部转换、事件队列、定时器、转换轨迹
+// 运行：python tools/run_native_tests.py test_state_machine
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 33166;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+// ========== 测试用状态机（与综合联动程序的状态和事件相同） ==========
+
+enum { S_IDLE, S_LISTEN, S_ACTIVE, S_SPEAK, S_COUNT };
+enum {
+    E_SOUND, E_QUIET, E_SILENCE, E_TICK, E_MOTION_DONE,
+    E_CMD_IDLE, E_CMD_LISTEN, E_CMD_TRIGGER, E_CMD_SPEAK, E_PLAY_DONE, E_COUNT
+};
+enum { T_SILENCE, T_TICK };
+
+static const char* const EVENT_NAMES[E_COUNT] = {
+    "sound", "quiet", "silence", "tick", "motion_done",
+    "cmd_idle", "cmd_listen", "cmd_trigger", "cmd_speak", "play_done"
+};
+
+struct Robot {
+    StateMachine* fsm;
+    std::vector<std::string> log;
+    bool speakerReady;
+    int entries;
+    int exits;
+    int actions;
+    int32_t lastEntryArg;
+    int repost;   // 大于0时 E_MOTION_DONE 动作再入队自己
+};
+
+static void say(void* ctx, const char* what) {
+    ((Robot*)ctx)->log.push_back(what);
+}
+
+static void enterIdle(void* ctx, const SmEvent&) {
+    Robot* r = (Robot*)ctx;
+    r->entries++;
+    say(ctx, "enter idle");
+    r->fsm->startTimer(T_TICK, 3000, E_TICK, true);
+}
+
+static void enterListen(void* ctx, const SmEvent&) {
+    Robot* r = (Robot*)ctx;
+    r->entries++;
+    say(ctx, "enter listen");
+    r->fsm->startTimer(T_TICK, 500, E_TICK, true);
+}
+
+static void enterActive(void* ctx, const SmEvent& ev) {
+    Robot* r = (Robot*)ctx;
+    r->entries++;
+    r->lastEntryArg = ev.arg;
+    say(ctx, "enter active");
+    r->fsm->startTimer(T_SILENCE, 3000, E_SILENCE);
+}
+
+static void exitActive(void* ctx, const SmEvent&) {
+    ((Robot*)ctx)->exits++;
+    say(ctx, "exit active");
+}
+
+static void enterSpeak(void* ctx, const SmEvent&) {
+    ((Robot*)ctx)->entries++;
+    say(ctx, "enter speak");
+}
+
+static void exitCount(void* ctx, const SmEvent&) {
+    ((Robot*)ctx)->exits++;
+    say(ctx, "exit");
+}
+
+static void act(void* ctx, const SmEvent& ev) {
+    Robot* r = (Robot*)ctx;
+    r->actions++;
+    char buf[32];
+    snprintf(buf, sizeof(buf), "act %s %d", EVENT_NAMES[ev.id], (int)ev.arg);
+    say(ctx, buf);
+    if (ev.id == E_MOTION_DONE && r->repost > 0) {
+        r->repost--;
+        r->fsm->post(E_MOTION_DONE, ev.arg + 1);
+    }
+}
+
+static void stopSilence(void* ctx, const SmEvent& ev) {
+    act(ctx, ev);
+    ((Robot*)ctx)->fsm->stopTimer(T_SILENCE);
+}
+
+static void startSilence(void* ctx, const SmEvent& ev) {
+    act(ctx, ev);
+    ((Robot*)ctx)->fsm->startTimer(T_SILENCE, 3000, E_SILENCE);
+}
+
+static bool canSpeak(void* ctx, const SmEvent&) {
+    return ((Robot*)ctx)->speakerReady;
+}
+
+static const SmStateDef STATES[S_COUNT] = {
+    {"IDLE", enterIdle, exitCount},
+    {"LISTENING", enterListen, exitCount},
+    {"ACTIVE", enterActive, exitActive},
+    {"SPEAKING", enterSpeak, exitCount},
+};
+
+static const SmTransition TABLE[] = {
+    {S_IDLE, E_TICK, SM_INTERNAL, nullptr, act},
+    {S_LISTEN, E_SOUND, S_ACTIVE, nullptr, act},
+    {S_LISTEN, E_CMD_TRIGGER, S_ACTIVE, nullptr, nullptr},
+    {S_LISTEN, E_TICK, SM_INTERNAL, nullptr, act},
+    {S_ACTIVE, E_SOUND, SM_INTERNAL, nullptr, stopSilence},
+    {S_ACTIVE, E_QUIET, SM_INTERNAL, nullptr, startSilence},
+    {S_ACTIVE, E_SILENCE, S_LISTEN, nullptr, act},
+    {S_ACTIVE, E_MOTION_DONE, SM_INTERNAL, nullptr, act},
+    {S_SPEAK, E_PLAY_DONE, S_LISTEN, nullptr, nullptr},
+    {SM_ANY_STATE, E_CMD_SPEAK, S_SPEAK, canSpeak, act},
+    {SM_ANY_STATE, E_CMD_LISTEN, S_LISTEN, nullptr, nullptr},
+    {SM_ANY_STATE, E_CMD_IDLE, S_IDLE, nullptr, act},
+    {SM_ANY_STATE, E_CMD_TRIGGER, SM_INTERNAL, nullptr, act},
+};
+static const uint8_t TABLE_SIZE = sizeof(TABLE) / sizeof(TABLE[0]);
+
+struct Rig {
+    Robot robot;
+    StateMachine fsm;
+
+    Rig() : fsm(STATES, S_COUNT, TABLE, TABLE_SIZE, &robot) {
+        robot.fsm = &fsm;
+        robot.speakerReady = true;
+        robot.entries = 0;
+        robot.exits = 0;
+        robot.actions = 0;
+        robot.lastEntryArg = 0;
+        robot.repost = 0;
+        fsm.setEventNames(EVENT_NAMES, E_COUNT);
+    }
+};
+
+static bool logIs(const Robot& r, const std::vector<std::string>& expect) {
+    if (r.log != expect) {
+        for (const std::string& s : r.log) printf("    log: %s\n", s.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ========== 单元测试 ==========
+
+// 单元测试1: 初始状态的进入动作；外部转换依次运行 退出 → 转换动作 → 进入，进入动作收到触发事件
+void test_unit_entry_exit_order() {
+    Rig rig;
+    rig.fsm.begin(S_IDLE, 1000);
+    TEST_ASSERT_EQUAL(S_IDLE, rig.fsm.state());
+    TEST_ASSERT_TRUE(logIs(rig.robot, {"enter idle"}));
+
+    rig.robot.log.clear();
+    rig.fsm.post(E_CMD_LISTEN);
+    TEST_ASSERT_TRUE(rig.fsm.pending());
+    TEST_ASSERT_EQUAL(S_IDLE, rig.fsm.state());   // post 只入队
+    TEST_ASSERT_EQUAL(1, rig.fsm.process(1010));
+    TEST_ASSERT_EQUAL(S_LISTEN, rig.fsm.state());
+    TEST_ASSERT_TRUE(logIs(rig.robot, {"exit", "enter listen"}));
+
+    rig.robot.log.clear();
+    rig.fsm.post(E_SOUND, -35);
+    rig.fsm.process(1200);
+    TEST_ASSERT_EQUAL(S_ACTIVE, rig.fsm.state());
+    TEST_ASSERT_TRUE(logIs(rig.robot, {"exit", "act sound -35", "enter active"}));
+    TEST_ASSERT_EQUAL(-35, rig.robot.lastEntryArg);
+    TEST_ASSERT_EQUAL(0, rig.fsm.timeInStateMs(1200));
+    TEST_ASSERT_EQUAL(300, rig.fsm.timeInStateMs(1500));
+
+    // 没有事件时 process() 什么都不运行
+    rig.robot.log.clear();
+    TEST_ASSERT_EQUAL(0, rig.fsm.process(1300));
+    TEST_ASSERT_EQUAL(0, rig.robot.log.size());
+
+    const SmStats& st = rig.fsm.stats();
+    TEST_ASSERT_EQUAL(2, st.events);
+    TEST_ASSERT_EQUAL(2, st.transitions);
+    TEST_ASSERT_EQUAL(0, st.unhandled);
+}
+
+// 单元测试2: 守卫、任意状态转换、内部转换（不退出/进入，定时器保留）、没有匹配的事件
+void test_unit_guards_and_internal() {
+    Rig rig;
+    rig.fsm.begin(S_LISTEN, 0);
+
+    // 守卫不通过：继续匹配，没有其他转换时计为未处理
+    rig.robot.speakerReady = false;
+    rig.fsm.post(E_CMD_SPEAK, 2);
+    rig.fsm.process(10);
+    TEST_ASSERT_EQUAL(S_LISTEN, rig.fsm.state());
+    TEST_ASSERT_EQUAL(1, rig.fsm.stats().unhandled);
+
+    rig.robot.speakerReady = true;
+    rig.fsm.post(E_CMD_SPEAK, 2);
+    rig.fsm.process(20);
+    TEST_ASSERT_EQUAL(S_SPEAK, rig.fsm.state());
+
+    // 状态专用的转换排在任意状态之前：SPEAKING 中的触发命令落到任意状态的内部转换
+    rig.robot.log.clear();
+    rig.fsm.post(E_CMD_TRIGGER, 30);
+    rig.fsm.process(30);
+    TEST_ASSERT_EQUAL(S_SPEAK, rig.fsm.state());
+    TEST_ASSERT_TRUE(logIs(rig.robot, {"act cmd_trigger 30"}));
+
+    rig.fsm.post(E_PLAY_DONE);
+    rig.fsm.post(E_CMD_TRIGGER, 30);
+    rig.fsm.process(40);
+    TEST_ASSERT_EQUAL(S_ACTIVE, rig.fsm.state());
+    TEST_ASSERT_EQUAL(30, rig.robot.lastEntryArg);
+    TEST_ASSERT_TRUE(rig.fsm.timerActive(T_SILENCE));
+
+    // 内部转换：只运行动作
+    rig.robot.log.clear();
+    rig.fsm.post(E_MOTION_DONE);
+    rig.fsm.post(E_SOUND);
+    rig.fsm.process(50);
+    TEST_ASSERT_EQUAL(S_ACTIVE, rig.fsm.state());
+    TEST_ASSERT_TRUE(logIs(rig.robot, {"act motion_done 0", "act sound 0"}));
+    TEST_ASSERT_FALSE(rig.fsm.timerActive(T_SILENCE));   // 动作停止了静音定时器
+    TEST_ASSERT_EQUAL(3, rig.fsm.stats().internal);
+
+    // IDLE 中的声音事件没有转换
+    rig.fsm.post(E_CMD_IDLE);
+    rig.fsm.post(E_SOUND);
+    rig.fsm.process(60);
+    TEST_ASSERT_EQUAL(S_IDLE, rig.fsm.state());
+    TEST_ASSERT_EQUAL(2, rig.fsm.stats().unhandled);
+}
+
+// 单元测试3: 事件队列先进先出、满时丢弃并计数；动作中入队的事件同一次处理，但每次处理有上限
+void test_unit_event_queue() {
+    Rig rig;
+    rig.fsm.begin(S_ACTIVE, 0);
+    rig.robot.log.clear();
+
+    for (int i = 0; i < SM_QUEUE_SIZE + 4; i++) {
+        bool ok = rig.fsm.post(E_MOTION_DONE, i);
+        TEST_ASSERT_EQUAL(i < SM_QUEUE_SIZE, ok);
+    }
+    TEST_ASSERT_EQUAL(4, rig.fsm.stats().dropped);
+    TEST_ASSERT_EQUAL(SM_QUEUE_SIZE, rig.fsm.process(10));
+    TEST_ASSERT_EQUAL(SM_QUEUE_SIZE, rig.robot.log.size());
+    for (int i = 0; i < SM_QUEUE_SIZE; i++) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "act motion_done %d", i);
+        TEST_ASSERT_EQUAL_STRING(buf, rig.robot.log[i].c_str());
+    }
+    TEST_ASSERT_FALSE(rig.fsm.pending());
+
+    // 动作再入队：同一次 process() 中处理，直到上限
+    rig.robot.repost = 100;
+    rig.fsm.post(E_MOTION_DONE, 0);
+    TEST_ASSERT_EQUAL(SM_QUEUE_SIZE * 2, rig.fsm.process(20));
+    TEST_ASSERT_TRUE(rig.fsm.pending());
+    rig.robot.repost = 0;
+    TEST_ASSERT_EQUAL(1, rig.fsm.process(30));
+    TEST_ASSERT_FALSE(rig.fsm.pending());
+}
+
+// 单元测试4: 单次/周期定时器、状态切换时取消、已入队的过期定时器事件丢弃、落后时只补一次、millis() 回绕
+void test_unit_timers() {
+    const uint32_t starts[2] = {0, 0xFFFFF000u};
+    for (uint32_t t0 : starts) {
+        Rig rig;
+        rig.fsm.begin(S_LISTEN, t0);
+        TEST_ASSERT_EQUAL(500, rig.fsm.msUntilNextTimer(t0));
+        TEST_ASSERT_EQUAL(200, rig.fsm.msUntilNextTimer(t0 + 300));
+
+        // 周期 500ms：1 秒两次
+        rig.robot.actions = 0;
+        for (uint32_t t = t0 + 10; t != t0 + 1010; t += 10) {
+            rig.fsm.process(t);
+        }
+        TEST_ASSERT_EQUAL(2, rig.robot.actions);
+
+        // 处理被阻塞 1.75 秒：只补一次，之后从现在重新计
+        rig.fsm.process(t0 + 2760);
+        TEST_ASSERT_EQUAL(3, rig.robot.actions);
+        TEST_ASSERT_EQUAL(500, rig.fsm.msUntilNextTimer(t0 + 2760));
+
+        // 进入 ACTIVE：LISTEN 的周期定时器被取消，静音定时器 3 秒后回到 LISTEN
+        rig.fsm.post(E_SOUND);
+        rig.fsm.process(t0 + 3000);
+        TEST_ASSERT_EQUAL(S_ACTIVE, rig.fsm.state());
+        TEST_ASSERT_FALSE(rig.fsm.timerActive(T_TICK));
+        TEST_ASSERT_TRUE(rig.fsm.timerActive(T_SILENCE));
+        rig.fsm.process(t0 + 5999);
+        TEST_ASSERT_EQUAL(S_ACTIVE, rig.fsm.state());
+        rig.fsm.process(t0 + 6000);
+        TEST_ASSERT_EQUAL(S_LISTEN, rig.fsm.state());
+        TEST_ASSERT_EQUAL(2, rig.fsm.stats().transitions);
+
+        // 定时器事件的时间戳是到期时刻
+        const SmTraceEntry* last = rig.fsm.trace(rig.fsm.traceCount() - 1);
+        TEST_ASSERT_EQUAL(E_SILENCE, last->event);
+        TEST_ASSERT_EQUAL(t0 + 6000, last->timeMs);
+
+        // 声音持续：静音定时器被停止，结束后重新计 3 秒
+        rig.fsm.post(E_SOUND);
+        rig.fsm.process(t0 + 6100);
+        rig.fsm.post(E_SOUND);
+        rig.fsm.process(t0 + 6200);
+        TEST_ASSERT_EQUAL(S_ACTIVE, rig.fsm.state());
+        rig.fsm.process(t0 + 9500);
+        TEST_ASSERT_EQUAL(S_ACTIVE, rig.fsm.state());
+        rig.fsm.post(E_QUIET);
+        rig.fsm.process(t0 + 9600);
+        rig.fsm.process(t0 + 12599);
+        TEST_ASSERT_EQUAL(S_ACTIVE, rig.fsm.state());
+        rig.fsm.process(t0 + 12600);
+        TEST_ASSERT_EQUAL(S_LISTEN, rig.fsm.state());
+
+        // 静音定时器到期的同一次处理中声音恢复：声音事件先入队并停止定时器，已入队的超时事件过期丢弃
+        rig.fsm.post(E_SOUND);
+        rig.fsm.process(t0 + 12650);
+        rig.fsm.post(E_QUIET);
+        rig.fsm.process(t0 + 12700);
+        rig.fsm.post(E_SOUND);
+        TEST_ASSERT_EQUAL(1, rig.fsm.process(t0 + 15700));
+        TEST_ASSERT_EQUAL(S_ACTIVE, rig.fsm.state());
+        TEST_ASSERT_EQUAL(1, rig.fsm.stats().cancelled);
+        TEST_ASSERT_EQUAL(0, rig.fsm.stats().unhandled);
+
+        // 无效参数
+        TEST_ASSERT_FALSE(rig.fsm.startTimer(SM_MAX_TIMERS, 10, E_TICK));
+        TEST_ASSERT_FALSE(rig.fsm.startTimer(0, 0, E_TICK, true));
+        rig.fsm.post(E_CMD_SPEAK);
+        rig.fsm.process(t0 + 15800);
+        TEST_ASSERT_EQUAL(UINT32_MAX, rig.fsm.msUntilNextTimer(t0 + 15800));
+    }
+}
+
+// 单元测试5: 轨迹只保留最近 SM_TRACE_SIZE 条，从早到晚，时间戳与状态链连续
+void test_unit_trace() {
+    Rig rig;
+    rig.fsm.begin(S_IDLE, 0);
+    TEST_ASSERT_EQUAL(0, rig.fsm.traceCount());
+    TEST_ASSERT_NULL(rig.fsm.trace(0));
+
+    for (int i = 0; i < 20; i++) {
+        rig.fsm.post(i % 2 == 0 ? E_CMD_LISTEN : E_CMD_IDLE);
+        rig.fsm.process((uint32_t)(100 * (i + 1)));
+    }
+    TEST_ASSERT_EQUAL(SM_TRACE_SIZE, rig.fsm.traceCount());
+    TEST_ASSERT_EQUAL(100 * (20 - SM_TRACE_SIZE + 1), rig.fsm.trace(0)->timeMs);
+    for (uint8_t i = 1; i < rig.fsm.traceCount(); i++) {
+        const SmTraceEntry* prev = rig.fsm.trace(i - 1);
+        const SmTraceEntry* cur = rig.fsm.trace(i);
+        TEST_ASSERT_EQUAL(prev->to, cur->from);
+        TEST_ASSERT_EQUAL(prev->timeMs + 100, cur->timeMs);
+    }
+    const SmTraceEntry* last = rig.fsm.trace(SM_TRACE_SIZE - 1);
+    TEST_ASSERT_EQUAL(S_LISTEN, last->from);
+    TEST_ASSERT_EQUAL(S_IDLE, last->to);
+    TEST_ASSERT_EQUAL_STRING("cmd_idle", rig.fsm.eventName(last->event));
+    TEST_ASSERT_EQUAL_STRING("LISTENING", rig.fsm.stateName(last->from));
+    TEST_ASSERT_EQUAL_STRING("begin", rig.fsm.eventName(SM_NO_EVENT));
+    TEST_ASSERT_EQUAL_STRING("?", rig.fsm.stateName(9));
+
+    // 内部转换也记录，from == to
+    rig.fsm.post(E_CMD_TRIGGER, 7);
+    rig.fsm.process(4000);   // IDLE 的周期定时器 5000 才到期
+    last = rig.fsm.trace(SM_TRACE_SIZE - 1);
+    TEST_ASSERT_EQUAL(S_IDLE, last->from);
+    TEST_ASSERT_EQUAL(S_IDLE, last->to);
+    TEST_ASSERT_EQUAL(7, last->arg);
+}
+
+// ========== 属性测试 ==========
+
+// 转换表的独立描述：返回目标状态，-1 为内部转换，-2 为没有匹配
+static int expectedTarget(int from, int ev, bool speakerReady) {
+    switch (ev) {
+        case E_CMD_SPEAK:
+            return speakerReady ? S_SPEAK : (-2);
+        case E_CMD_LISTEN:
+            return S_LISTEN;
+        case E_CMD_IDLE:
+            return S_IDLE;
+        case E_CMD_TRIGGER:
+            return from == S_LISTEN ? S_ACTIVE : -1;
+        case E_SOUND:
+            return from == S_LISTEN ? S_ACTIVE : (from == S_ACTIVE ? -1 : -2);
+        case E_QUIET:
+        case E_MOTION_DONE:
+            return from == S_ACTIVE ? -1 : -2;
+        case E_SILENCE:
+            return from == S_ACTIVE ? S_LISTEN : -2;
+        case E_TICK:
+            return (from == S_IDLE || from == S_LISTEN) ? -1 : -2;
+        case E_PLAY_DONE:
+            return from == S_SPEAK ? S_LISTEN : -2;
+    }
+    return -2;
+}
+
+// 属性测试1: 随机事件与时间推进：每个处理的事件按转换表转换，进入/退出成对，轨迹连续，计数守恒
+void test_property_random_events() {
+    printf("\n[Property Test] 随机事件序列与转换表一致 - 100次迭代\n");
+
+    for (int i = 0; i < 100; i++) {
+        Rig rig;
+        rig.robot.speakerReady = testRandomInt(0, 1) == 1;
+        uint32_t now = (uint32_t)testRandomInt(0, 1000) * 4294967u;   // 覆盖回绕附近
+        int state = testRandomInt(0, S_COUNT - 1);
+        rig.fsm.begin((uint8_t)state, now);
+        uint32_t posted = 0;
+        char msg[96];
+
+        int steps = testRandomInt(50, 200);
+        for (int k = 0; k < steps; k++) {
+            int posts = testRandomInt(0, 3);
+            for (int p = 0; p < posts; p++) {
+                int ev = testRandomInt(0, E_COUNT - 1);
+                if (ev == E_SILENCE || ev == E_TICK) ev = E_CMD_TRIGGER;   // 定时器事件只由定时器产生
+                rig.fsm.post((uint8_t)ev, testRandomInt(-90, 90));
+                posted++;
+            }
+            now += (uint32_t)testRandomInt(0, 1500);
+
+            SmStats before = rig.fsm.stats();
+            uint8_t handled = rig.fsm.process(now);
+            const SmStats& after = rig.fsm.stats();
+
+            // 按轨迹逐条核对本次记录的转换（轨迹被覆盖时只核对仍保留的部分）
+            uint32_t recorded = (after.transitions + after.internal) - (before.transitions + before.internal);
+            uint8_t count = rig.fsm.traceCount();
+            uint8_t first = recorded < count ? (uint8_t)(count - recorded) : 0;
+            for (uint8_t t = first; t < count; t++) {
+                const SmTraceEntry* e = rig.fsm.trace(t);
+                int expect = expectedTarget(e->from, e->event, rig.robot.speakerReady);
+                snprintf(msg, sizeof(msg), "Iter %d 步 %d: %s --%s--> %s", i, k,
+                         rig.fsm.stateName(e->from), rig.fsm.eventName(e->event), rig.fsm.stateName(e->to));
+                TEST_ASSERT_TRUE_MESSAGE(expect != -2, msg);
+                TEST_ASSERT_EQUAL_MESSAGE(expect == -1 ? e->from : expect, e->to, msg);
+                TEST_ASSERT_EQUAL_MESSAGE(now, e->timeMs, msg);
+                if (t > 0) {
+                    TEST_ASSERT_EQUAL_MESSAGE(rig.fsm.trace(t - 1)->to, e->from, msg);
+                }
+            }
+
+            snprintf(msg, sizeof(msg), "Iter %d 步 %d: 计数不守恒", i, k);
+            TEST_ASSERT_EQUAL_MESSAGE(handled, after.events - before.events, msg);
+            TEST_ASSERT_EQUAL_MESSAGE(after.events, after.transitions + after.internal + after.unhandled, msg);
+            TEST_ASSERT_EQUAL_MESSAGE(rig.robot.entries - 1, rig.robot.exits, msg);   // begin 的进入没有对应的退出
+            TEST_ASSERT_EQUAL_MESSAGE(after.transitions, (uint32_t)rig.robot.exits, msg);
+            TEST_ASSERT_TRUE_MESSAGE(rig.fsm.state() < S_COUNT, msg);
+
+            // 定时器属于状态：IDLE/LISTEN 只有周期定时器，SPEAKING 没有定时器
+            uint8_t s = rig.fsm.state();
+            TEST_ASSERT_EQUAL_MESSAGE(s == S_IDLE || s == S_LISTEN, rig.fsm.timerActive(T_TICK), msg);
+            if (s != S_ACTIVE) {
+                TEST_ASSERT_FALSE_MESSAGE(rig.fsm.timerActive(T_SILENCE), msg);
+            }
+        }
+
+        // 入队的事件（外部 + 定时器，减去丢弃的）全部被处理或作为过期定时器事件丢弃
+        while (rig.fsm.pending()) {
+            rig.fsm.process(now);
+        }
+        const SmStats& st = rig.fsm.stats();
+        snprintf(msg, sizeof(msg), "Iter %d: 事件守恒", i);
+        TEST_ASSERT_EQUAL_MESSAGE(posted + st.timerFires - st.dropped, st.events + st.cancelled, msg);
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+}
+
+// ========== 性能测试 ==========
+
+// 原做法：状态处理函数每 10ms 运行一次（自己判断音量和时间）；
+// 事件驱动：只有事件或定时器到期时才运行动作。模拟 60 秒：每 10 秒一次 1.5 秒的说话
+void test_benchmark_state_machine() {
+    printf("\n[Benchmark] 60 秒模拟：轮询处理函数 与 事件驱动状态机\n");
+
+    Rig rig;
+    rig.fsm.begin(S_LISTEN, 0);
+    uint32_t passes = 0;
+    uint32_t busyPasses = 0;
+    bool loud = false;
+    for (uint32_t t = 0; t < 60000; t += 10) {
+        bool nowLoud = (t % 10000) >= 2000 && (t % 10000) < 3500;
+        if (nowLoud != loud) {
+            rig.fsm.post(nowLoud ? E_SOUND : E_QUIET, 15);
+            loud = nowLoud;
+        }
+        passes++;
+        busyPasses += rig.fsm.process(t) > 0 ? 1 : 0;
+    }
+    const SmStats& st = rig.fsm.stats();
+    printf("  轮询：处理函数运行 %lu 次\n", (unsigned long)passes);
+    printf("  事件驱动：%lu 个事件（定时器 %lu，过期 %lu），有事件的轮次 %lu，外部转换 %lu，内部转换 %lu\n",
+           (unsigned long)st.events, (unsigned long)st.timerFires, (unsigned long)st.cancelled,
+           (unsigned long)busyPasses, (unsigned long)st.transitions, (unsigned long)st.internal);
+    TEST_ASSERT_LESS_THAN(passes / 10, busyPasses);
+    TEST_ASSERT_EQUAL(12, st.transitions);   // 每次说话：LISTEN → ACTIVE → LISTEN
+    TEST_ASSERT_EQUAL(0, st.unhandled);      // 与声音同一轮到期的调试定时器事件随状态取消，不会落到 ACTIVE
+
+    // 分发开销：没有匹配的事件要扫描整个转换表（13 条），是最坏情况
+    Rig fast;
+    fast.fsm.begin(S_SPEAK, 0);
+    const int rounds = 200000;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        fast.fsm.post(E_QUIET, r);
+        fast.fsm.process((uint32_t)r);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / rounds;
+    printf("  分发开销（主机）：%.1f ns/事件（post + process，含定时器检查）\n", ns);
+    TEST_ASSERT_EQUAL(rounds, fast.fsm.stats().unhandled);
+
+    auto t2 = std::chrono::high_resolution_clock::now();
+    uint32_t idleHandled = 0;
+    for (int r = 0; r < rounds; r++) {
+        idleHandled += fast.fsm.process((uint32_t)r);
+    }
+    auto t3 = std::chrono::high_resolution_clock::now();
+    double idleNs = std::chrono::duration<double, std::nano>(t3 - t2).count() / rounds;
+    printf("  没有事件时 process()：%.1f ns/次\n", idleNs);
+    TEST_ASSERT_EQUAL(0, idleHandled);
+}
+
+// ========================================
+// 主函数
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("StateMachine 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_entry_exit_order);
+    RUN_TEST(test_unit_guards_and_internal);
+    RUN_TEST(test_unit_event_queue);
+    RUN_TEST(test_unit_timers);
+    RUN_TEST(test_unit_trace);
+
+    printf("\n========================================\n");
+    printf("StateMachine 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_random_events);
+
+    printf("\n========================================\n");
+    printf("StateMachine 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_state_machine);
+
+    return UNITY_END();
+}
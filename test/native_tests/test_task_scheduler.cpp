@@ -0,0 +1,407 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "TaskScheduler.h"
+#include "VirtualClock.h"
+
+// ========================================
+// TaskScheduler 测试（主机端，native 环境）
+// 协作式截止时间调度：周期/单次任务、优先级、超时与跳过计数、虚拟时钟
+// 运行：python tools/run_native_tests.py test_task_scheduler
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 28284;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+// 测试任务：记录每次开始的时刻，并让虚拟时钟前进 costUs 模拟运行时间
+struct Probe {
+    VirtualClock* clock;
+    uint32_t costUs;
+    std::vector<uint32_t> starts;
+    std::vector<int>* order;   // 多个任务共享的运行顺序
+    int tag;
+};
+
+static void probeTask(void* arg, uint32_t nowUs) {
+    Probe* p = (Probe*)arg;
+    p->starts.push_back(nowUs);
+    if (p->order) p->order->push_back(p->tag);
+    p->clock->advance(p->costUs);
+}
+
+static Probe makeProbe(VirtualClock& clock, uint32_t costUs, std::vector<int>* order = nullptr, int tag = 0) {
+    Probe p;
+    p.clock = &clock;
+    p.costUs = costUs;
+    p.order = order;
+    p.tag = tag;
+    return p;
+}
+
+// ========== 单元测试 ==========
+
+// 测试1：各任务按自己的周期运行（舵机 200Hz、灯效 60Hz、显示 10Hz）
+void test_unit_periodic_rates() {
+    VirtualClock clock;
+    TaskScheduler sched(clock);
+    Probe servo = makeProbe(clock, 100), led = makeProbe(clock, 300), disp = makeProbe(clock, 2000);
+    int8_t a = sched.addPeriodic("servo", probeTask, &servo, 5000, 3);
+    int8_t b = sched.addPeriodic("led", probeTask, &led, 16667, 2);
+    int8_t c = sched.addPeriodic("display", probeTask, &disp, 100000, 1);
+    TEST_ASSERT_TRUE(a >= 0 && b >= 0 && c >= 0);
+    TEST_ASSERT_EQUAL(3, sched.count());
+    TEST_ASSERT_EQUAL_STRING("led", sched.taskName(b));
+
+    clock.runFor(sched, 1000000);
+    TEST_ASSERT_EQUAL(200, servo.starts.size());
+    TEST_ASSERT_EQUAL(60, led.starts.size());
+    TEST_ASSERT_EQUAL(10, disp.starts.size());
+
+    // 同时到期时优先级高的先运行，低优先级最多被推迟前面任务的运行时间
+    TEST_ASSERT_EQUAL(0, servo.starts[0]);
+    TEST_ASSERT_EQUAL(100, led.starts[0]);
+    TEST_ASSERT_EQUAL(400, disp.starts[0]);
+    TEST_ASSERT_EQUAL(0, sched.totals().overruns);
+    TEST_ASSERT_EQUAL(0, sched.totals().skipped);
+    TEST_ASSERT_EQUAL(400, sched.stats(c)->maxLatencyUs);
+    TEST_ASSERT_EQUAL(2000, sched.stats(c)->maxRunUs);
+    TEST_ASSERT_EQUAL(270, sched.totals().runs);
+}
+
+// 测试2：同优先级按截止时间先后，优先级高的总是先于截止时间早的
+void test_unit_priority_and_deadline_order() {
+    VirtualClock clock;
+    TaskScheduler sched(clock);
+    std::vector<int> order;
+    Probe p0 = makeProbe(clock, 10, &order, 0), p1 = makeProbe(clock, 10, &order, 1);
+    Probe p2 = makeProbe(clock, 10, &order, 2), p3 = makeProbe(clock, 10, &order, 3);
+    sched.addPeriodic("late", probeTask, &p0, 10000, 1, 9000);
+    sched.addPeriodic("early", probeTask, &p1, 10000, 1, 2000);
+    sched.addPeriodic("urgent", probeTask, &p2, 10000, 5, 9500);
+    sched.addOneShot("nodeadline", probeTask, &p3, 0, 1);
+
+    while (sched.runOnce()) {
+    }
+    TEST_ASSERT_EQUAL(4, order.size());
+    TEST_ASSERT_EQUAL(2, order[0]);   // 优先级 5
+    TEST_ASSERT_EQUAL(1, order[1]);   // 截止 2ms
+    TEST_ASSERT_EQUAL(0, order[2]);   // 截止 9ms
+    TEST_ASSERT_EQUAL(3, order[3]);   // 没有截止时间的排最后
+}
+
+// 测试3：超过截止时间计为超时；错过的释放跳过并计数，相位不变
+void test_unit_overrun_and_skip() {
+    VirtualClock clock;
+    TaskScheduler sched(clock);
+    Probe fast = makeProbe(clock, 100), slow = makeProbe(clock, 12000);
+    int8_t f = sched.addPeriodic("servo", probeTask, &fast, 5000, 3);
+    int8_t s = sched.addPeriodic("slow", probeTask, &slow, 50000, 1, 10000, 1000);
+
+    clock.runFor(sched, 100000);
+    // slow 每次运行 12ms > 截止 10ms
+    TEST_ASSERT_EQUAL(2, sched.stats(s)->runs);
+    TEST_ASSERT_EQUAL(2, sched.stats(s)->overruns);
+    // slow 运行的 12ms 内 servo 有两次释放：第一次等 slow 结束后迟到运行，第二次跳过
+    TEST_ASSERT_EQUAL(2, sched.stats(f)->skipped);
+    TEST_ASSERT_EQUAL(20 - 2, sched.stats(f)->runs);
+    TEST_ASSERT_EQUAL(1000 + 12000 - 5000, sched.stats(f)->maxLatencyUs);
+    // 迟到运行的那次也超过了自己的截止时间
+    TEST_ASSERT_EQUAL(2, sched.stats(f)->overruns);
+    // servo 的每次开始都落在不同的 5ms 周期内
+    for (size_t i = 1; i < fast.starts.size(); i++) {
+        TEST_ASSERT_TRUE(fast.starts[i] / 5000 > fast.starts[i - 1] / 5000);
+    }
+    TEST_ASSERT_EQUAL(4, sched.totals().overruns);
+    TEST_ASSERT_EQUAL(2, sched.totals().skipped);
+}
+
+static int8_t chainedId = SCHED_NO_TASK;
+static TaskScheduler* chainedSched = nullptr;
+
+static void chainTask(void* arg, uint32_t nowUs) {
+    (void)nowUs;
+    // 单次任务里再添加一个单次任务（例如播放完成后延迟熄灯）
+    chainedId = chainedSched->addOneShot("chained", probeTask, arg, 3000, 1);
+}
+
+// 测试4：单次任务运行一次后移除，槽位可重用；任务中可以添加任务
+void test_unit_one_shot() {
+    VirtualClock clock;
+    TaskScheduler sched(clock);
+    Probe p = makeProbe(clock, 50);
+    int8_t id = sched.addOneShot("once", probeTask, &p, 2000, 1, 500);
+    TEST_ASSERT_EQUAL(2000, sched.runReady());
+    TEST_ASSERT_FALSE(sched.runOnce());
+
+    clock.advance(2200);
+    TEST_ASSERT_TRUE(sched.runOnce());
+    TEST_ASSERT_EQUAL(1, p.starts.size());
+    TEST_ASSERT_EQUAL(2200, p.starts[0]);
+    TEST_ASSERT_EQUAL(0, sched.count());
+    TEST_ASSERT_NULL(sched.stats(id));
+    TEST_ASSERT_EQUAL(1, sched.totals().runs);
+    TEST_ASSERT_EQUAL(0, sched.totals().overruns);   // 2250 < 2000 + 500
+
+    chainedSched = &sched;
+    TEST_ASSERT_EQUAL(id, sched.addOneShot("chain", chainTask, &p, 0, 1));
+    TEST_ASSERT_TRUE(sched.runOnce());
+    TEST_ASSERT_TRUE(chainedId >= 0);
+    TEST_ASSERT_EQUAL(1, sched.count());
+    clock.runFor(sched, 5000);
+    TEST_ASSERT_EQUAL(2, p.starts.size());
+    TEST_ASSERT_EQUAL(2250 + 3000, p.starts[1]);
+    TEST_ASSERT_EQUAL(0, sched.count());
+}
+
+static void selfRemoveTask(void* arg, uint32_t nowUs) {
+    (void)nowUs;
+    TaskScheduler* s = (TaskScheduler*)arg;
+    s->remove(0);
+}
+
+// 测试5：启用/停用、改周期、移除，无效参数
+void test_unit_control() {
+    VirtualClock clock;
+    TaskScheduler sched(clock);
+    Probe p = makeProbe(clock, 0);
+    int8_t id = sched.addPeriodic("t", probeTask, &p, 10000, 1);
+    clock.runFor(sched, 30000);
+    TEST_ASSERT_EQUAL(3, p.starts.size());
+
+    TEST_ASSERT_TRUE(sched.setEnabled(id, false));
+    clock.runFor(sched, 30000);
+    TEST_ASSERT_EQUAL(3, p.starts.size());
+    TEST_ASSERT_EQUAL(SCHED_IDLE_MAX_US, sched.runReady());
+
+    // 重新启用立即运行，之后按新周期
+    TEST_ASSERT_TRUE(sched.setEnabled(id, true));
+    TEST_ASSERT_TRUE(sched.setPeriod(id, 5000));
+    TEST_ASSERT_TRUE(sched.runOnce());
+    TEST_ASSERT_EQUAL(60000, p.starts.back());
+    TEST_ASSERT_EQUAL(5000, sched.runReady());
+    clock.runFor(sched, 20000);
+    TEST_ASSERT_EQUAL(4 + 3, p.starts.size());
+
+    // 无效参数
+    TEST_ASSERT_EQUAL(SCHED_NO_TASK, sched.addPeriodic("zero", probeTask, &p, 0, 1));
+    TEST_ASSERT_EQUAL(SCHED_NO_TASK, sched.addPeriodic("null", nullptr, &p, 1000, 1));
+    TEST_ASSERT_FALSE(sched.setEnabled(SCHED_NO_TASK, true));
+    TEST_ASSERT_FALSE(sched.setPeriod(SCHED_MAX_TASKS, 1000));
+    TEST_ASSERT_NULL(sched.taskName(7));
+    TEST_ASSERT_TRUE(sched.remove(id));
+    TEST_ASSERT_FALSE(sched.remove(id));
+
+    // 任务表满
+    for (int i = 0; i < SCHED_MAX_TASKS; i++) {
+        TEST_ASSERT_TRUE(sched.addPeriodic("fill", probeTask, &p, 1000, 1) >= 0);
+    }
+    TEST_ASSERT_EQUAL(SCHED_NO_TASK, sched.addOneShot("full", probeTask, &p, 0, 1));
+    for (int i = 0; i < SCHED_MAX_TASKS; i++) {
+        sched.remove((int8_t)i);
+    }
+
+    // 任务运行中移除自己
+    TEST_ASSERT_EQUAL(0, sched.addPeriodic("self", selfRemoveTask, &sched, 1000, 1));
+    TEST_ASSERT_TRUE(sched.runOnce());
+    TEST_ASSERT_EQUAL(0, sched.count());
+}
+
+// 测试6：micros() 回绕前后周期不变
+void test_unit_clock_wraparound() {
+    VirtualClock clock(0xFFFFFFFFu - 12000);
+    TaskScheduler sched(clock);
+    Probe p = makeProbe(clock, 200);
+    int8_t id = sched.addPeriodic("wrap", probeTask, &p, 5000, 1);
+    clock.runFor(sched, 50000);
+    TEST_ASSERT_EQUAL(10, p.starts.size());
+    for (size_t i = 1; i < p.starts.size(); i++) {
+        TEST_ASSERT_EQUAL(5000, p.starts[i] - p.starts[i - 1]);
+    }
+    TEST_ASSERT_EQUAL(0, sched.stats(id)->skipped);
+    TEST_ASSERT_EQUAL(0, sched.stats(id)->maxLatencyUs);
+}
+
+// ========== 属性测试 ==========
+
+// 属性：所有任务的运行时间之和小于最短周期时，不会超时或跳过，延迟不超过其他任务运行时间之和；
+// 任意负载下每次运行都不早于释放，且每个周期最多运行一次，运行次数 + 跳过次数 = 释放次数
+void test_property_schedule_invariants() {
+    printf("\n[Property Test] 随机任务集的调度不变量 - 100次迭代\n");
+    for (int i = 0; i < 100; i++) {
+        VirtualClock clock((uint32_t)testRandomInt(0, 0x7FFFFFFF) * 2u);
+        uint32_t origin = clock.now;
+        TaskScheduler sched(clock);
+        int n = testRandomInt(1, 8);
+        bool light = (i % 2) == 0;
+        std::vector<Probe> probes(n);
+        std::vector<uint32_t> periods(n), phases(n);
+        uint32_t minPeriod = 0xFFFFFFFF;
+        for (int k = 0; k < n; k++) {
+            periods[k] = (uint32_t)testRandomInt(1000, 100000);
+            phases[k] = (uint32_t)testRandomInt(0, 20000);
+            minPeriod = periods[k] < minPeriod ? periods[k] : minPeriod;
+        }
+        uint32_t costSum = 0;
+        for (int k = 0; k < n; k++) {
+            uint32_t cost = light ? (uint32_t)testRandomInt(0, (int)(minPeriod / n) - 1)
+                                  : (uint32_t)testRandomInt(0, (int)periods[k] * 2);
+            probes[k] = makeProbe(clock, cost);
+            costSum += cost;
+            TEST_ASSERT_TRUE(sched.addPeriodic("p", probeTask, &probes[k], periods[k],
+                                               (uint8_t)testRandomInt(0, 3), 0, phases[k]) >= 0);
+        }
+        const uint32_t duration = 1000000;
+        clock.runFor(sched, duration);
+
+        char msg[96];
+        for (int k = 0; k < n; k++) {
+            snprintf(msg, sizeof(msg), "Iter %d 任务 %d: 周期 %lu", i, k, (unsigned long)periods[k]);
+            const SchedTaskStats* st = sched.stats((int8_t)k);
+            const std::vector<uint32_t>& s = probes[k].starts;
+            TEST_ASSERT_EQUAL_MESSAGE(s.size(), st->runs, msg);
+            uint32_t lastSlot = 0, inWindow = 0;
+            for (size_t r = 0; r < s.size(); r++) {
+                uint32_t rel = s[r] - origin - phases[k];
+                TEST_ASSERT_TRUE_MESSAGE((int32_t)rel >= 0, msg);
+                uint32_t slot = rel / periods[k];
+                TEST_ASSERT_TRUE_MESSAGE(r == 0 || slot > lastSlot, msg);
+                lastSlot = slot;
+                // runFor() 可能因最后一个任务的运行时间越过结束时刻，只数窗口内释放的
+                inWindow += phases[k] + slot * periods[k] < duration ? 1 : 0;
+            }
+            // 下一次释放之前的释放都已运行或跳过
+            if (!s.empty()) {
+                uint32_t releases = lastSlot + 1;
+                TEST_ASSERT_TRUE_MESSAGE(st->runs + st->skipped >= releases, msg);
+                TEST_ASSERT_TRUE_MESSAGE(st->runs + st->skipped <= releases + (clock.now - origin) / periods[k] + 1, msg);
+            }
+            if (light) {
+                TEST_ASSERT_EQUAL_MESSAGE(0, st->overruns, msg);
+                TEST_ASSERT_EQUAL_MESSAGE(0, st->skipped, msg);
+                TEST_ASSERT_TRUE_MESSAGE(st->maxLatencyUs <= costSum, msg);
+                uint32_t expected = phases[k] < duration ? (duration - phases[k] - 1) / periods[k] + 1 : 0;
+                TEST_ASSERT_EQUAL_MESSAGE(expected, inWindow, msg);
+            }
+        }
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+}
+
+// ========== 性能测试 ==========
+
+// 综合联动程序的负载：原 loop()+delay(10) 与调度器的实际服务频率和延迟对比；调度开销
+struct LoadTask {
+    const char* name;
+    uint32_t periodUs;
+    uint32_t costUs;
+    uint8_t priority;
+};
+
+static const LoadTask LOAD[] = {
+    {"servo", 5000, 150, 4},
+    {"audio", 16000, 2500, 3},
+    {"state", 10000, 300, 2},
+    {"led", 16667, 400, 2},
+    {"display", 100000, 3000, 1},
+    {"serial", 20000, 50, 0},
+};
+static const int LOAD_COUNT = sizeof(LOAD) / sizeof(LOAD[0]);
+
+void test_benchmark_scheduler() {
+    printf("\n[Benchmark] 综合联动负载（虚拟时钟 10 秒）：原 loop()+delay(10) 与调度器\n");
+    const uint32_t duration = 10000000;
+
+    // 原做法：每轮依次运行全部子系统，再 delay(10)
+    uint32_t loopCost = 0;
+    for (int k = 0; k < LOAD_COUNT; k++) loopCost += LOAD[k].costUs;
+    uint32_t loopPeriod = loopCost + 10000;
+    uint32_t loops = duration / loopPeriod;
+
+    VirtualClock clock;
+    TaskScheduler sched(clock);
+    std::vector<Probe> probes(LOAD_COUNT);
+    for (int k = 0; k < LOAD_COUNT; k++) {
+        probes[k] = makeProbe(clock, LOAD[k].costUs);
+        sched.addPeriodic(LOAD[k].name, probeTask, &probes[k], LOAD[k].periodUs, LOAD[k].priority);
+    }
+    clock.runFor(sched, duration);
+
+    printf("  %-8s %8s %10s %10s %10s %8s\n", "任务", "目标Hz", "原loop Hz", "调度 Hz", "最大延迟us", "超时");
+    for (int k = 0; k < LOAD_COUNT; k++) {
+        const SchedTaskStats* st = sched.stats((int8_t)k);
+        float target = 1e6f / LOAD[k].periodUs;
+        float oldRate = loops / (duration / 1e6f);
+        if (oldRate > target) oldRate = target;   // 原代码各自用 millis() 判断，不会超过目标频率
+        printf("  %-8s %8.1f %10.1f %10.1f %10lu %8lu\n", LOAD[k].name, target, oldRate,
+               st->runs / (duration / 1e6f), (unsigned long)st->maxLatencyUs, (unsigned long)st->overruns);
+        TEST_ASSERT_TRUE(st->runs >= (uint32_t)(target * 10 * 0.99f));
+    }
+    printf("  原 loop 每轮 %.1f ms（工作 %.1f ms + delay 10 ms），每个子系统最多 %.1f Hz\n",
+           loopPeriod / 1000.0f, loopCost / 1000.0f, 1e6f / loopPeriod);
+    uint32_t busy = (uint32_t)sched.totals().totalRunUs;
+    printf("  调度器 CPU 占用 %.1f%%，空闲 %.1f%% 可让给其他 FreeRTOS 任务\n",
+           busy * 100.0f / duration, 100.0f - busy * 100.0f / duration);
+
+    // 调度开销（主机实际耗时）：8 个任务，每次 runOnce() 选出并运行一个空任务
+    VirtualClock fast;
+    TaskScheduler overhead(fast);
+    Probe idle = makeProbe(fast, 0);
+    for (int k = 0; k < 8; k++) {
+        overhead.addPeriodic("x", probeTask, &idle, 1000 + k * 100, (uint8_t)k);
+    }
+    idle.starts.reserve(200000);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    const int rounds = 20000;
+    for (int r = 0; r < rounds; r++) {
+        fast.advance(1000);
+        overhead.runReady();
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    printf("  调度开销（主机）：%.3f us/次任务切换（%lu 次）\n",
+           us / overhead.totals().runs, (unsigned long)overhead.totals().runs);
+    TEST_ASSERT_TRUE(overhead.totals().runs > (uint32_t)rounds);
+}
+
+// ========================================
+// 主函数
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("TaskScheduler 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_periodic_rates);
+    RUN_TEST(test_unit_priority_and_deadline_order);
+    RUN_TEST(test_unit_overrun_and_skip);
+    RUN_TEST(test_unit_one_shot);
+    RUN_TEST(test_unit_control);
+    RUN_TEST(test_unit_clock_wraparound);
+
+    printf("\n========================================\n");
+    printf("TaskScheduler 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_schedule_invariants);
+
+    printf("\n========================================\n");
+    printf("TaskScheduler 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_scheduler);
+
+    return UNITY_END();
+}
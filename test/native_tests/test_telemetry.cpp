@@ -0,0 +1,517 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Telemetry.h"
+
+// ========================================
+// Telemetry 测试（主机端，native 环境）
+// COBS 编解码、字段描述、帧格式与校验、队列满丢弃、与文本交错、跨线程发送
+// 运行：python tools/run_native_tests.py test_telemetry
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 42499;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+// 与集成测试相同形状的记录
+struct LevelsRecord {
+    float left;
+    float right;
+    float volume;
+    int16_t direction;
+    uint8_t state;
+    uint8_t flags;
+};
+
+struct AnglesRecord {
+    int16_t h;
+    int16_t v;
+};
+
+// 解码后的一帧
+struct Frame {
+    uint8_t type;
+    uint8_t seq;
+    uint32_t timeMs;
+    std::vector<uint8_t> payload;
+};
+
+/**
+ * 按 0x00 切分字节流并解码（与 tools/telemetry_decode.py 相同的步骤）
+ * @param bad 输出：COBS 或校验失败的段数
+ */
+static std::vector<Frame> decodeStream(const std::vector<uint8_t>& stream, int* bad) {
+    std::vector<Frame> frames;
+    *bad = 0;
+    std::vector<uint8_t> chunk;
+    for (uint8_t byte : stream) {
+        if (byte != 0) {
+            chunk.push_back(byte);
+            continue;
+        }
+        if (chunk.empty()) {
+            continue;
+        }
+        uint8_t raw[512];
+        size_t n = chunk.size() < sizeof(raw) ? TelemetryChannel::cobsDecode(chunk.data(), chunk.size(), raw) : 0;
+        chunk.clear();
+        if (n < TELEMETRY_FRAME_HEADER + 2) {
+            (*bad)++;
+            continue;
+        }
+        uint16_t sum = (uint16_t)(raw[n - 2] | (raw[n - 1] << 8));
+        if (TelemetryChannel::fletcher16(raw, n - 2) != sum) {
+            (*bad)++;
+            continue;
+        }
+        Frame f;
+        f.type = raw[0];
+        f.seq = raw[1];
+        f.timeMs = (uint32_t)raw[2] | ((uint32_t)raw[3] << 8) | ((uint32_t)raw[4] << 16) | ((uint32_t)raw[5] << 24);
+        f.payload.assign(raw + TELEMETRY_FRAME_HEADER, raw + n - 2);
+        frames.push_back(f);
+    }
+    return frames;
+}
+
+static void pumpAll(TelemetryChannel& channel, std::vector<uint8_t>& stream, size_t capacity = 256) {
+    uint8_t buffer[512];
+    size_t n;
+    while ((n = channel.pump(buffer, capacity)) > 0) {
+        stream.insert(stream.end(), buffer, buffer + n);
+    }
+}
+
+// ========== 单元测试 ==========
+
+// 单元测试1: COBS 编解码：空输入、全 0、254/255 字节的非 0 段，编码结果不含 0
+void test_unit_cobs() {
+    uint8_t enc[600];
+    uint8_t dec[600];
+
+    TEST_ASSERT_EQUAL(1, TelemetryChannel::cobsEncode(nullptr, 0, enc));
+    TEST_ASSERT_EQUAL(1, enc[0]);
+
+    const uint8_t zeros[3] = {0, 0, 0};
+    TEST_ASSERT_EQUAL(4, TelemetryChannel::cobsEncode(zeros, 3, enc));
+    TEST_ASSERT_EQUAL(3, TelemetryChannel::cobsDecode(enc, 4, dec));
+    TEST_ASSERT_EQUAL_MEMORY(zeros, dec, 3);
+
+    const uint8_t sample[5] = {0x11, 0x22, 0x00, 0x33, 0x00};
+    const uint8_t expected[6] = {0x03, 0x11, 0x22, 0x02, 0x33, 0x01};
+    TEST_ASSERT_EQUAL(6, TelemetryChannel::cobsEncode(sample, 5, enc));
+    TEST_ASSERT_EQUAL_MEMORY(expected, enc, 6);
+
+    const size_t lengths[] = {253, 254, 255, 508, 509};
+    for (size_t length : lengths) {
+        uint8_t in[509];
+        for (size_t i = 0; i < length; i++) in[i] = (uint8_t)(i % 255 + 1);
+        size_t n = TelemetryChannel::cobsEncode(in, length, enc);
+        TEST_ASSERT_TRUE(n <= length + length / 254 + 1);
+        TEST_ASSERT_NULL(memchr(enc, 0, n));
+        TEST_ASSERT_EQUAL(length, TelemetryChannel::cobsDecode(enc, n, dec));
+        TEST_ASSERT_EQUAL_MEMORY(in, dec, length);
+    }
+
+    // 无效输入：块长度越界、块内有 0
+    const uint8_t overrun[2] = {0x05, 0x11};
+    TEST_ASSERT_EQUAL(0, TelemetryChannel::cobsDecode(overrun, 2, dec));
+    const uint8_t inner[3] = {0x03, 0x00, 0x11};
+    TEST_ASSERT_EQUAL(0, TelemetryChannel::cobsDecode(inner, 3, dec));
+}
+
+// 单元测试2: 字段描述与类型登记：大小必须与结构体一致，编号和名称有范围
+void test_unit_define() {
+    TEST_ASSERT_EQUAL(16, TelemetryChannel::fieldsSize("left:f,right:f,volume:f,direction:h,state:B,flags:B"));
+    TEST_ASSERT_EQUAL(4, TelemetryChannel::fieldsSize("h:h,v:h"));
+    TEST_ASSERT_EQUAL(0, TelemetryChannel::fieldsSize(""));
+    TEST_ASSERT_EQUAL(0, TelemetryChannel::fieldsSize("a:q"));
+    TEST_ASSERT_EQUAL(0, TelemetryChannel::fieldsSize("a:f,"));
+    TEST_ASSERT_EQUAL(0, TelemetryChannel::fieldsSize(":f"));
+    TEST_ASSERT_EQUAL(0, TelemetryChannel::fieldsSize("a:ff"));
+    TEST_ASSERT_EQUAL(0, TelemetryChannel::fieldsSize("a"));
+
+    static TelemetryChannel channel;
+    TEST_ASSERT_TRUE(channel.define<LevelsRecord>(1, "levels", "left:f,right:f,volume:f,direction:h,state:B,flags:B"));
+    TEST_ASSERT_TRUE(channel.define<AnglesRecord>(2, "angles", "h:h,v:h"));
+    TEST_ASSERT_FALSE(channel.define<AnglesRecord>(3, "angles", "h:h,v:h,extra:B"));   // 大小不一致
+    TEST_ASSERT_FALSE(channel.define<AnglesRecord>(TELEMETRY_TYPE_SCHEMA, "zero", "h:h,v:h"));
+    TEST_ASSERT_FALSE(channel.define<AnglesRecord>(TELEMETRY_MAX_TYPES, "big", "h:h,v:h"));
+    TEST_ASSERT_FALSE(channel.define<AnglesRecord>(4, "a_name_that_is_too_long", "h:h,v:h"));
+
+    static TelemetrySource sources[TELEMETRY_MAX_SOURCES + 1];
+    for (int i = 0; i < TELEMETRY_MAX_SOURCES; i++) {
+        TEST_ASSERT_TRUE(channel.addSource(sources[i]));
+    }
+    TEST_ASSERT_FALSE(channel.addSource(sources[TELEMETRY_MAX_SOURCES]));
+    TEST_ASSERT_FALSE(channel.addSource(sources[0]));
+}
+
+// 单元测试3: 帧格式：先发 schema，再按来源轮流发记录；序号连续、载荷与发送的结构体逐字节相同
+void test_unit_frame_format() {
+    static TelemetryChannel channel;
+    static TelemetrySource audio;
+    static TelemetrySource motion;
+    channel.define<LevelsRecord>(1, "levels", "left:f,right:f,volume:f,direction:h,state:B,flags:B");
+    channel.define<AnglesRecord>(2, "angles", "h:h,v:h");
+    channel.addSource(audio);
+    channel.addSource(motion);
+
+    uint8_t buffer[256];
+    std::vector<uint8_t> stream;
+    size_t n = channel.pump(buffer, sizeof(buffer));   // 只有 schema
+    TEST_ASSERT_TRUE(n > 0);
+    TEST_ASSERT_EQUAL(0, buffer[0]);   // 每批前的分隔符
+    TEST_ASSERT_EQUAL(0, buffer[n - 1]);
+    stream.insert(stream.end(), buffer, buffer + n);
+    TEST_ASSERT_EQUAL(0, channel.pump(buffer, sizeof(buffer)));   // 没有新内容
+
+    LevelsRecord levels = {1.5f, -2.25f, 3000.0f, -45, 2, 0};
+    AnglesRecord angles = {90, 30};
+    TEST_ASSERT_TRUE(audio.send(1, levels, 1000));
+    TEST_ASSERT_TRUE(audio.send(1, levels, 1001));
+    TEST_ASSERT_TRUE(motion.send(2, angles, 1002));
+    pumpAll(channel, stream);
+
+    int bad;
+    std::vector<Frame> frames = decodeStream(stream, &bad);
+    TEST_ASSERT_EQUAL(0, bad);
+    TEST_ASSERT_EQUAL(5, frames.size());
+
+    // schema：编号、名称、0、字段描述
+    TEST_ASSERT_EQUAL(TELEMETRY_TYPE_SCHEMA, frames[0].type);
+    TEST_ASSERT_EQUAL(1, frames[0].payload[0]);
+    TEST_ASSERT_EQUAL_STRING("levels", (const char*)&frames[0].payload[1]);
+    std::string fields(frames[0].payload.begin() + 8, frames[0].payload.end());
+    TEST_ASSERT_EQUAL_STRING("left:f,right:f,volume:f,direction:h,state:B,flags:B", fields.c_str());
+    TEST_ASSERT_EQUAL(2, frames[1].payload[0]);
+
+    // 轮流取：audio, motion, audio
+    TEST_ASSERT_EQUAL(1, frames[2].type);
+    TEST_ASSERT_EQUAL(2, frames[3].type);
+    TEST_ASSERT_EQUAL(1, frames[4].type);
+    TEST_ASSERT_EQUAL(1000, frames[2].timeMs);
+    TEST_ASSERT_EQUAL(1001, frames[4].timeMs);
+    TEST_ASSERT_EQUAL(sizeof(LevelsRecord), frames[2].payload.size());
+    TEST_ASSERT_EQUAL_MEMORY(&levels, frames[2].payload.data(), sizeof(LevelsRecord));
+    TEST_ASSERT_EQUAL_MEMORY(&angles, frames[3].payload.data(), sizeof(AnglesRecord));
+    for (size_t i = 1; i < frames.size(); i++) {
+        TEST_ASSERT_EQUAL((uint8_t)(frames[i - 1].seq + 1), frames[i].seq);
+    }
+
+    TelemetryStats st = channel.stats();
+    TEST_ASSERT_EQUAL(5, st.frames);
+    TEST_ASSERT_EQUAL(stream.size(), st.bytes);
+
+    // resendSchema：下一批重新带上两个 schema
+    channel.resendSchema();
+    stream.clear();
+    pumpAll(channel, stream);
+    frames = decodeStream(stream, &bad);
+    TEST_ASSERT_EQUAL(2, frames.size());
+    TEST_ASSERT_EQUAL(TELEMETRY_TYPE_SCHEMA, frames[1].type);
+}
+
+// 单元测试4: 队列满时 send 返回 false 并计数，下一批先发丢弃帧；discard 清空队列且不补发丢弃帧
+void test_unit_drops_and_discard() {
+    static TelemetryChannel channel;
+    static TelemetrySource source;
+    channel.define<AnglesRecord>(2, "angles", "h:h,v:h");
+    channel.addSource(source);
+    std::vector<uint8_t> stream;
+    pumpAll(channel, stream);
+
+    AnglesRecord angles = {10, 20};
+    int accepted = 0;
+    for (int i = 0; i < TELEMETRY_QUEUE_DEPTH + 5; i++) {
+        if (source.send(2, angles, (uint32_t)i)) accepted++;
+    }
+    TEST_ASSERT_EQUAL(TELEMETRY_QUEUE_DEPTH, accepted);
+    TEST_ASSERT_EQUAL(5, source.dropped());
+
+    stream.clear();
+    pumpAll(channel, stream);
+    int bad;
+    std::vector<Frame> frames = decodeStream(stream, &bad);
+    TEST_ASSERT_EQUAL(TELEMETRY_QUEUE_DEPTH + 1, frames.size());
+    TEST_ASSERT_EQUAL(TELEMETRY_TYPE_DROPS, frames[0].type);
+    TEST_ASSERT_EQUAL(0, frames[0].payload[0]);   // 来源编号
+    TEST_ASSERT_EQUAL(5, frames[0].payload[1]);
+    TEST_ASSERT_EQUAL(TELEMETRY_QUEUE_DEPTH - 1, frames.back().timeMs);
+
+    // 未开启发送：丢掉记录，期间的丢弃不再单独通知
+    for (int i = 0; i < TELEMETRY_QUEUE_DEPTH + 3; i++) source.send(2, angles, 0);
+    channel.discard();
+    TEST_ASSERT_EQUAL(0, channel.pump(stream.data(), stream.size()));
+    TelemetryStats st = channel.stats();
+    TEST_ASSERT_EQUAL(TELEMETRY_QUEUE_DEPTH, st.discarded);
+    TEST_ASSERT_EQUAL(8, st.dropped);
+
+    // 缓冲只够一帧时每次 pump 只发一帧，剩下的留在队列中
+    source.send(2, angles, 1);
+    source.send(2, angles, 2);
+    uint8_t small[20];
+    size_t n1 = channel.pump(small, sizeof(small));
+    TEST_ASSERT_TRUE(n1 > 0);
+    TEST_ASSERT_TRUE(channel.pump(small, sizeof(small)) > 0);
+    TEST_ASSERT_EQUAL(0, channel.pump(small, sizeof(small)));
+    source.send(2, angles, 3);
+    TEST_ASSERT_EQUAL(0, channel.pump(small, 8));   // 一帧都放不下，记录留在队列中
+    TEST_ASSERT_TRUE(channel.pump(small, sizeof(small)) > 0);
+}
+
+// 单元测试5: 帧与串口文本交错：被文本打断的帧校验失败，后面的帧不受影响
+void test_unit_interleaved_text() {
+    static TelemetryChannel channel;
+    static TelemetrySource source;
+    channel.define<AnglesRecord>(2, "angles", "h:h,v:h");
+    channel.addSource(source);
+
+    std::vector<uint8_t> stream;
+    pumpAll(channel, stream);
+    AnglesRecord angles = {45, -10};
+    source.send(2, angles, 100);
+    uint8_t buffer[256];
+    size_t n = channel.pump(buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(n > 4);
+
+    // 文本插在一帧中间
+    const char* text = "[STATE] 监听 -> 定位\r\n";
+    stream.insert(stream.end(), buffer, buffer + n / 2);
+    stream.insert(stream.end(), text, text + strlen(text));
+    stream.insert(stream.end(), buffer + n / 2, buffer + n);
+
+    source.send(2, angles, 200);
+    source.send(2, angles, 300);
+    pumpAll(channel, stream);
+    stream.insert(stream.end(), text, text + strlen(text));   // 帧之间的文本（末尾没有 0）
+
+    int bad;
+    std::vector<Frame> frames = decodeStream(stream, &bad);
+    TEST_ASSERT_EQUAL(1, bad);
+    TEST_ASSERT_EQUAL(3, frames.size());   // schema + 200 + 300
+    TEST_ASSERT_EQUAL(200, frames[1].timeMs);
+    TEST_ASSERT_EQUAL(300, frames[2].timeMs);
+    TEST_ASSERT_EQUAL((uint8_t)(frames[0].seq + 2), frames[1].seq);   // 序号跳过被破坏的帧
+}
+
+// 单元测试6: 生产者线程 send、发送线程 pump：收到的记录加丢弃数等于发送总数，同一来源按顺序
+void test_unit_concurrent_sources() {
+    static TelemetryChannel channel;
+    static TelemetrySource sources[2];
+    channel.define<AnglesRecord>(2, "angles", "h:h,v:h");
+    channel.addSource(sources[0]);
+    channel.addSource(sources[1]);
+    const int total = 50000;
+    std::atomic<int> running(2);
+
+    auto producer = [&](int id) {
+        for (int i = 0; i < total; i++) {
+            AnglesRecord r = {(int16_t)id, (int16_t)(i & 0x7FFF)};
+            sources[id].send(2, r, (uint32_t)i);
+            if ((i & 31) == 0) {
+                std::this_thread::yield();
+            }
+        }
+        running--;
+    };
+    std::thread a(producer, 0);
+    std::thread b(producer, 1);
+
+    std::vector<uint8_t> stream;
+    uint8_t buffer[512];
+    while (running > 0) {
+        size_t n = channel.pump(buffer, sizeof(buffer));
+        stream.insert(stream.end(), buffer, buffer + n);
+    }
+    a.join();
+    b.join();
+    pumpAll(channel, stream, sizeof(buffer));
+
+    int bad;
+    std::vector<Frame> frames = decodeStream(stream, &bad);
+    TEST_ASSERT_EQUAL(0, bad);
+    int received[2] = {0, 0};
+    long lastTime[2] = {-1, -1};
+    bool ordered = true;
+    for (const Frame& f : frames) {
+        if (f.type != 2) continue;
+        AnglesRecord r;
+        memcpy(&r, f.payload.data(), sizeof(r));
+        if ((long)f.timeMs <= lastTime[r.h]) ordered = false;
+        lastTime[r.h] = (long)f.timeMs;
+        received[r.h]++;
+    }
+    printf("  来源0 收到 %d 丢弃 %lu；来源1 收到 %d 丢弃 %lu\n", received[0],
+           (unsigned long)sources[0].dropped(), received[1], (unsigned long)sources[1].dropped());
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_EQUAL(total, received[0] + (int)sources[0].dropped());
+    TEST_ASSERT_EQUAL(total, received[1] + (int)sources[1].dropped());
+}
+
+// ========== 属性测试 ==========
+
+// 属性测试1: 随机字节（含大量 0）COBS 往返一致；随机记录经 pump 后逐字节还原，丢弃帧与计数一致
+void test_property_roundtrip() {
+    printf("\n[Property Test] 编解码往返 - 100次迭代\n");
+    static TelemetryChannel channel;
+    static TelemetrySource source;
+    channel.define<LevelsRecord>(1, "levels", "left:f,right:f,volume:f,direction:h,state:B,flags:B");
+    channel.addSource(source);
+    std::vector<uint8_t> stream;
+    pumpAll(channel, stream);
+
+    for (int iter = 0; iter < 100; iter++) {
+        uint8_t in[700];
+        uint8_t enc[720];
+        uint8_t dec[720];
+        size_t length = (size_t)testRandomInt(0, 700);
+        int zeroChance = testRandomInt(0, 100);
+        for (size_t i = 0; i < length; i++) {
+            in[i] = testRandomInt(0, 99) < zeroChance ? 0 : (uint8_t)testRandomInt(1, 255);
+        }
+        size_t n = TelemetryChannel::cobsEncode(in, length, enc);
+        TEST_ASSERT_TRUE(n <= length + length / 254 + 1);
+        TEST_ASSERT_NULL(memchr(enc, 0, n));
+        if (length > 0) {
+            TEST_ASSERT_EQUAL(length, TelemetryChannel::cobsDecode(enc, n, dec));
+            TEST_ASSERT_EQUAL_MEMORY(in, dec, length);
+        }
+
+        // 随机记录，随机的 pump 缓冲大小
+        std::vector<LevelsRecord> sent;
+        uint32_t droppedBefore = source.dropped();
+        int count = testRandomInt(0, TELEMETRY_QUEUE_DEPTH + 8);
+        for (int i = 0; i < count; i++) {
+            LevelsRecord r;
+            uint8_t* bytes = (uint8_t*)&r;
+            for (size_t k = 0; k < sizeof(r); k++) {
+                bytes[k] = (uint8_t)(testRandomInt(0, 3) == 0 ? 0 : testRandomInt(0, 255));
+            }
+            if (source.send(1, r, (uint32_t)i)) {
+                sent.push_back(r);
+            }
+        }
+        stream.clear();
+        pumpAll(channel, stream, (size_t)testRandomInt(40, 512));
+
+        int bad;
+        std::vector<Frame> frames = decodeStream(stream, &bad);
+        TEST_ASSERT_EQUAL(0, bad);
+        size_t k = 0;
+        for (const Frame& f : frames) {
+            if (f.type == TELEMETRY_TYPE_DROPS) {
+                uint32_t total = (uint32_t)f.payload[1] | ((uint32_t)f.payload[2] << 8);
+                TEST_ASSERT_EQUAL(source.dropped(), total);
+                continue;
+            }
+            TEST_ASSERT_TRUE(k < sent.size());
+            TEST_ASSERT_EQUAL_MEMORY(&sent[k], f.payload.data(), sizeof(LevelsRecord));
+            k++;
+        }
+        TEST_ASSERT_EQUAL(sent.size(), k);
+        TEST_ASSERT_EQUAL((uint32_t)(count - (int)sent.size()), source.dropped() - droppedBefore);
+
+        if ((iter + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", iter + 1);
+        }
+    }
+}
+
+// ========== 性能测试 ==========
+
+// 热路径开销：send（复制一条记录）对比 snprintf 一行原来的调试文本；编码开销与字节数
+void test_benchmark_send_vs_printf() {
+    printf("\n[Benchmark] send 与 snprintf 对比\n");
+    static TelemetryChannel channel;
+    static TelemetrySource source;
+    channel.define<LevelsRecord>(1, "levels", "left:f,right:f,volume:f,direction:h,state:B,flags:B");
+    channel.addSource(source);
+    uint8_t buffer[512];
+    channel.pump(buffer, sizeof(buffer));
+
+    const int rounds = 200000;
+    LevelsRecord r = {1234.5f, 987.25f, 2221.75f, -30, 1, 0};
+
+    // 每 16 条取走一次，让 send 不会因为队列满提前返回
+    double sendNs = 0;
+    double pumpNs = 0;
+    size_t bytes = 0;
+    for (int i = 0; i < rounds; i += 16) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (int k = 0; k < 16; k++) {
+            r.volume += 1.0f;
+            source.send(1, r, (uint32_t)(i + k));
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        size_t n = channel.pump(buffer, sizeof(buffer));
+        auto t2 = std::chrono::high_resolution_clock::now();
+        sendNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        pumpNs += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        bytes += n;
+    }
+    sendNs /= rounds;
+    pumpNs /= rounds;
+
+    char line[128];
+    volatile size_t sink = 0;
+    auto t3 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        r.volume += 1.0f;
+        sink = sink + (size_t)snprintf(line, sizeof(line), "[DEBUG] 音量: %.1f (左:%.1f 右:%.1f) 方向:%d 阈值:%d\n",
+                                       r.volume, r.left, r.right, r.direction, 2000);
+    }
+    auto t4 = std::chrono::high_resolution_clock::now();
+    double printfNs = std::chrono::duration<double, std::nano>(t4 - t3).count() / rounds;
+    size_t textBytes = strlen(line);
+
+    printf("  send：%.1f ns/条；snprintf：%.1f ns/行（%.1fx）\n", sendNs, printfNs, printfNs / sendNs);
+    printf("  发送任务编码：%.1f ns/条，平均 %.1f 字节/条（文本 %lu 字节/行）\n", pumpNs,
+           (double)bytes / rounds, (unsigned long)textBytes);
+    printf("  115200 波特下每条占串口 %.2f ms（文本 %.2f ms）\n", (double)bytes / rounds * 10 / 115.2,
+           (double)textBytes * 10 / 115.2);
+    TEST_ASSERT_EQUAL(0, source.dropped());
+    TEST_ASSERT_TRUE(bytes < (size_t)rounds * textBytes);
+}
+
+// ========================================
+// 主函数
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("Telemetry 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_cobs);
+    RUN_TEST(test_unit_define);
+    RUN_TEST(test_unit_frame_format);
+    RUN_TEST(test_unit_drops_and_discard);
+    RUN_TEST(test_unit_interleaved_text);
+    RUN_TEST(test_unit_concurrent_sources);
+
+    printf("\n========================================\n");
+    printf("Telemetry 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_roundtrip);
+
+    printf("\n========================================\n");
+    printf("Telemetry 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_send_vs_printf);
+
+    return UNITY_END();
+}
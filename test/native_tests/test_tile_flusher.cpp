@@ -0,0 +1,309 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include "TileFlusher.h"
+#include "RecordingTileTransport.h"
+
+// ========================================
+// TileFlusher 测试（主机端，native 环境）
+// SSD1306 按 8×8 块增量刷新 + I2C 总线字节统计
+// 运行：python tools/run_native_tests.py test_tile_flusher
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 31415;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+// ========== U8g2 缓冲格式的绘制辅助 ==========
+
+static void setPixel(uint8_t* buf, int x, int y) {
+    if (x < 0 || x >= DISPLAY_WIDTH || y < 0 || y >= DISPLAY_HEIGHT) return;
+    buf[(y / 8) * DISPLAY_WIDTH + x] |= (uint8_t)(1 << (y % 8));
+}
+
+static void drawBox(uint8_t* buf, int x, int y, int w, int h) {
+    for (int yy = y; yy < y + h; yy++) {
+        for (int xx = x; xx < x + w; xx++) {
+            setPixel(buf, xx, yy);
+        }
+    }
+}
+
+// 3×5 点阵数字（代替 U8g2 字体，只用于产生与真实界面相近的变化范围）
+static const uint16_t DIGITS[10] = {
+    0x7B6F, 0x2492, 0x73E7, 0x73CF, 0x5BC9, 0x79CF, 0x79EF, 0x7249, 0x7BEF, 0x7BCF
+};
+
+static void drawNumber(uint8_t* buf, int x, int y, int value) {
+    char text[8];
+    snprintf(text, sizeof(text), "%d", value);
+    for (int i = 0; text[i]; i++) {
+        uint16_t g = DIGITS[text[i] - '0'];
+        for (int r = 0; r < 5; r++) {
+            for (int c = 0; c < 3; c++) {
+                if (g & (1 << (14 - r * 3 - c))) {
+                    drawBox(buf, x + i * 8 + c * 2, y + r * 2, 2, 2);
+                }
+            }
+        }
+    }
+}
+
+// 与综合测试 updateDisplay() 相同的布局：标题、状态、音量数字、音量条
+static void renderStatus(uint8_t* buf, int state, int volume) {
+    memset(buf, 0, DISPLAY_BUFFER_SIZE);
+    drawBox(buf, 30, 6, 64, 14);                 // "MOSS"
+    drawBox(buf, 0, 26, 40, 9);                  // "State: "
+    drawBox(buf, 44, 26, 12 + state * 8, 9);     // 状态文字
+    drawBox(buf, 0, 42, 24, 9);                  // "Vol: "
+    drawNumber(buf, 30, 41, volume);
+    int barWidth = volume / 2;
+    if (barWidth > 128) barWidth = 128;
+    drawBox(buf, 0, 54, barWidth, 10);
+}
+
+// ========================================
+// 单元测试（具体示例）
+// ========================================
+
+// 单元测试1: 第一次刷新发送整帧，字节数与 sendBuffer() 相同
+void test_unit_first_flush_is_full_frame() {
+    RecordingTileTransport bus;
+    TileFlusher flusher(bus);
+    static uint8_t buf[DISPLAY_BUFFER_SIZE];
+    renderStatus(buf, 0, 0);
+
+    TEST_ASSERT_EQUAL(128, flusher.flush(buf));
+    TEST_ASSERT_EQUAL(8, bus.calls);
+    TEST_ASSERT_EQUAL(1160, bus.bytes);
+    TEST_ASSERT_EQUAL(RecordingTileTransport::fullFrameBytes(), bus.bytes);
+    TEST_ASSERT_EQUAL_MEMORY(buf, bus.screen, DISPLAY_BUFFER_SIZE);
+}
+
+// 单元测试2: 内容不变时不访问总线
+void test_unit_unchanged_frame_sends_nothing() {
+    RecordingTileTransport bus;
+    TileFlusher flusher(bus);
+    static uint8_t buf[DISPLAY_BUFFER_SIZE];
+    renderStatus(buf, 1, 50);
+    flusher.flush(buf);
+    bus.reset();
+
+    renderStatus(buf, 1, 50);    // 重画（clearBuffer + 绘制）但结果相同
+    TEST_ASSERT_EQUAL(0, flusher.flush(buf));
+    TEST_ASSERT_EQUAL(0, bus.calls);
+    TEST_ASSERT_EQUAL(0, bus.bytes);
+    TEST_ASSERT_EQUAL(1, flusher.stats().unchanged);
+}
+
+// 单元测试3: 单个像素变化只发一个块（5 + 2 + 8 = 15 字节）
+void test_unit_single_pixel() {
+    RecordingTileTransport bus;
+    TileFlusher flusher(bus);
+    static uint8_t buf[DISPLAY_BUFFER_SIZE];
+    memset(buf, 0, sizeof(buf));
+    flusher.flush(buf);
+    bus.reset();
+
+    setPixel(buf, 77, 35);
+    TEST_ASSERT_EQUAL(1, flusher.flush(buf));
+    TEST_ASSERT_EQUAL(15, bus.bytes);
+    TEST_ASSERT_EQUAL_HEX8(1 << 3, bus.screen[4 * DISPLAY_WIDTH + 77]);
+}
+
+// 单元测试4: 同一页中不相邻的变化分段发送，相邻的合成一段
+void test_unit_runs_per_page() {
+    RecordingTileTransport bus;
+    TileFlusher flusher(bus);
+    static uint8_t buf[DISPLAY_BUFFER_SIZE];
+    memset(buf, 0, sizeof(buf));
+    flusher.flush(buf);
+    bus.reset();
+
+    drawBox(buf, 0, 0, 24, 1);       // 块 0~2
+    drawBox(buf, 64, 0, 8, 1);       // 块 8
+    drawBox(buf, 120, 0, 8, 1);      // 块 15
+    uint16_t masks[DISPLAY_TILE_ROWS];
+    TEST_ASSERT_EQUAL(5, flusher.diff(buf, masks));
+    TEST_ASSERT_EQUAL_HEX32(0x8107, masks[0]);
+
+    TEST_ASSERT_EQUAL(5, flusher.flush(buf));
+    TEST_ASSERT_EQUAL(3, bus.calls);
+    TEST_ASSERT_EQUAL(RecordingTileTransport::busBytes(3) + 2 * RecordingTileTransport::busBytes(1), bus.bytes);
+    TEST_ASSERT_EQUAL_MEMORY(buf, bus.screen, DISPLAY_BUFFER_SIZE);
+}
+
+// 单元测试5: 音量条/数字变化只发几十字节
+void test_unit_volume_change_is_small() {
+    RecordingTileTransport bus;
+    TileFlusher flusher(bus);
+    static uint8_t buf[DISPLAY_BUFFER_SIZE];
+    renderStatus(buf, 1, 40);
+    flusher.flush(buf);
+    bus.reset();
+
+    renderStatus(buf, 1, 52);        // 数字两位都变，音量条加长 6 像素
+    flusher.flush(buf);
+    printf("  音量 40 -> 52: %u 字节（整帧 %u 字节）\n", bus.bytes, RecordingTileTransport::fullFrameBytes());
+    TEST_ASSERT_TRUE(bus.bytes < 100);
+    TEST_ASSERT_EQUAL_MEMORY(buf, bus.screen, DISPLAY_BUFFER_SIZE);
+}
+
+// 单元测试6: invalidate() 后重新发送整帧
+void test_unit_invalidate() {
+    RecordingTileTransport bus;
+    TileFlusher flusher(bus);
+    static uint8_t buf[DISPLAY_BUFFER_SIZE];
+    renderStatus(buf, 2, 10);
+    flusher.flush(buf);
+    flusher.invalidate();
+    bus.reset();
+
+    TEST_ASSERT_EQUAL(128, flusher.flush(buf));
+    TEST_ASSERT_EQUAL(RecordingTileTransport::fullFrameBytes(), bus.bytes);
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 随机修改任意像素/矩形后刷新：
+// - 模拟显存与缓冲完全一致
+// - 发出的块数等于与上一帧不同的块数，每个块最多发一次
+// - 总线字节不超过整帧
+void test_property_screen_matches_buffer() {
+    printf("\n[Property Test] 随机修改后显存与缓冲一致且只发变化块 - 100次迭代\n");
+
+    for (int i = 0; i < 100; i++) {
+        RecordingTileTransport bus;
+        TileFlusher flusher(bus);
+        static uint8_t buf[DISPLAY_BUFFER_SIZE];
+        static uint8_t prev[DISPLAY_BUFFER_SIZE];
+        for (int k = 0; k < DISPLAY_BUFFER_SIZE; k++) buf[k] = (uint8_t)testRandomInt(0, 255);
+        flusher.flush(buf);
+
+        for (int step = 0; step < 20; step++) {
+            memcpy(prev, buf, sizeof(buf));
+            int edits = testRandomInt(0, 4);
+            for (int e = 0; e < edits; e++) {
+                if (testRandomInt(0, 1)) {
+                    buf[testRandomInt(0, DISPLAY_BUFFER_SIZE - 1)] ^= (uint8_t)testRandomInt(1, 255);
+                } else {
+                    drawBox(buf, testRandomInt(-8, 127), testRandomInt(-8, 63), testRandomInt(1, 40), testRandomInt(1, 20));
+                }
+            }
+
+            int expected = 0;
+            for (int t = 0; t < DISPLAY_TILE_COLS * DISPLAY_TILE_ROWS; t++) {
+                int off = (t / DISPLAY_TILE_COLS) * DISPLAY_WIDTH + (t % DISPLAY_TILE_COLS) * 8;
+                if (memcmp(buf + off, prev + off, 8) != 0) expected++;
+            }
+
+            uint32_t bytesBefore = bus.bytes;
+            uint32_t tilesBefore = bus.tilesDrawn;
+            uint16_t sent = flusher.flush(buf);
+
+            if (sent != expected || bus.tilesDrawn - tilesBefore != (uint32_t)expected) {
+                char msg[96];
+                snprintf(msg, sizeof(msg), "Iter %d step %d: 发出 %u 块，应为 %d", i, step, sent, expected);
+                TEST_FAIL_MESSAGE(msg);
+            }
+            if (memcmp(bus.screen, buf, DISPLAY_BUFFER_SIZE) != 0) {
+                TEST_FAIL_MESSAGE("模拟显存与缓冲不一致");
+            }
+            if (bus.bytes - bytesBefore > RecordingTileTransport::fullFrameBytes()) {
+                TEST_FAIL_MESSAGE("增量刷新字节数超过整帧");
+            }
+        }
+        TEST_ASSERT_EQUAL(0, bus.outOfRange);
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+
+    TEST_PASS();
+}
+
+// ========================================
+// 性能测试
+// ========================================
+
+// 性能1: 模拟监听状态下音量随机变化的 updateDisplay()，对比整帧与增量刷新的总线字节/时间
+void test_benchmark_status_screen() {
+    printf("\n[Benchmark] 状态界面：整帧 sendBuffer() vs 按块增量刷新\n");
+
+    RecordingTileTransport bus;
+    TileFlusher flusher(bus);
+    static uint8_t buf[DISPLAY_BUFFER_SIZE];
+
+    const int FRAMES = 1000;
+    int volume = 30;
+    int state = 1;
+    renderStatus(buf, state, volume);
+    flusher.flush(buf);
+    bus.reset();
+    flusher.resetStats();
+
+    double diffNs = 0;
+    for (int f = 0; f < FRAMES; f++) {
+        volume += testRandomInt(-15, 15);
+        if (volume < 0) volume = 0;
+        if (volume > 250) volume = 250;
+        if (f % 200 == 199) state = (state + 1) % 4;
+        renderStatus(buf, state, volume);
+
+        auto start = std::chrono::steady_clock::now();
+        flusher.flush(buf);
+        auto end = std::chrono::steady_clock::now();
+        diffNs += std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    float fullBytes = (float)RecordingTileTransport::fullFrameBytes();
+    float avgBytes = (float)bus.bytes / FRAMES;
+    printf("  整帧: %.0f 字节/帧，400kHz 约 %.1f ms\n", fullBytes, RecordingTileTransport::busTimeMs((uint32_t)fullBytes));
+    printf("  增量: %.1f 字节/帧，约 %.2f ms（%.1f%%），平均 %.1f 段/帧，%u 帧无变化\n",
+           avgBytes, RecordingTileTransport::busTimeMs((uint32_t)(avgBytes + 0.5f)),
+           avgBytes * 100.0f / fullBytes, (float)flusher.stats().runs / FRAMES, flusher.stats().unchanged);
+    printf("  比较耗时（主机）: %.0f ns/帧\n", diffNs / FRAMES);
+
+    TEST_ASSERT_TRUE(avgBytes < fullBytes / 5);
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("TileFlusher 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_first_flush_is_full_frame);
+    RUN_TEST(test_unit_unchanged_frame_sends_nothing);
+    RUN_TEST(test_unit_single_pixel);
+    RUN_TEST(test_unit_runs_per_page);
+    RUN_TEST(test_unit_volume_change_is_small);
+    RUN_TEST(test_unit_invalidate);
+
+    printf("\n========================================\n");
+    printf("TileFlusher 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_screen_matches_buffer);
+
+    printf("\n========================================\n");
+    printf("TileFlusher 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_status_screen);
+
+    return UNITY_END();
+}
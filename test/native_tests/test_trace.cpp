@@ -0,0 +1,436 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define TRACE_ENABLED 1
+#include "Trace.h"
+
+// ========================================
+// Trace 测试（主机端，native 环境）
+// 周期计数追踪：作用域/计数器宏、多写入方无锁环形记录、覆盖计数、二进制导出块
+// 运行：python tools/run_native_tests.py test_trace
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 36277;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+// ========== 导出块解析（与 tools/trace_to_chrome.py 相同的格式） ==========
+
+static uint16_t getU16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t getU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+struct ParsedExport {
+    std::vector<std::string> names;        // 按编号
+    std::vector<TraceRecord> records;
+    uint32_t lost;
+    uint16_t cyclesPerUs;
+    int blocks;
+    bool ok;
+};
+
+// 解析一段字节流中的所有块（块之间可以夹杂其他文本）
+static void parseBlocks(const uint8_t* data, size_t length, ParsedExport& out) {
+    size_t pos = 0;
+    while (pos + TRACE_BLOCK_OVERHEAD <= length) {
+        if (memcmp(data + pos, TRACE_BLOCK_MAGIC, 4) != 0) {
+            pos++;
+            continue;
+        }
+        uint8_t type = data[pos + 4];
+        uint16_t len = getU16(data + pos + 5);
+        if (pos + TRACE_BLOCK_OVERHEAD + len > length ||
+            TraceRing::fletcher16(data + pos + 4, 3 + (size_t)len) != getU16(data + pos + TRACE_BLOCK_HEADER + len)) {
+            out.ok = false;
+            pos++;
+            continue;
+        }
+        const uint8_t* p = data + pos + TRACE_BLOCK_HEADER;
+        if (type == TRACE_BLOCK_NAMES) {
+            size_t i = 0;
+            while (i + 3 <= len) {
+                uint16_t id = getU16(p + i);
+                uint8_t n = p[i + 2];
+                if (out.names.size() <= id) out.names.resize(id + 1);
+                out.names[id] = std::string((const char*)p + i + 3, n);
+                i += 3 + n;
+            }
+        } else if (type == TRACE_BLOCK_RECORDS) {
+            out.cyclesPerUs = getU16(p + 8);
+            out.lost = getU32(p + 10);
+            uint16_t count = getU16(p + 14);
+            for (uint16_t k = 0; k < count; k++) {
+                const uint8_t* r = p + TRACE_RECORDS_HEADER + k * TRACE_RECORD_BYTES;
+                TraceRecord rec = {getU32(r), (int32_t)getU32(r + 4), getU16(r + 8), r[10], r[11]};
+                out.records.push_back(rec);
+            }
+        }
+        out.blocks++;
+        pos += TRACE_BLOCK_OVERHEAD + len;
+    }
+}
+
+static size_t drainAll(TraceRing& ring, std::vector<TraceRecord>& out) {
+    TraceRecord batch[64];
+    size_t total = 0;
+    size_t n;
+    while ((n = ring.drain(batch, 64)) > 0) {
+        out.insert(out.end(), batch, batch + n);
+        total += n;
+    }
+    return total;
+}
+
+static void busyWaitNs(uint32_t ns) {
+    uint32_t start = traceCycles();
+    while (traceCycles() - start < ns) {
+    }
+}
+
+// ========== 单元测试 ==========
+
+static void tracedWork() {
+    TRACE_SCOPE("work");
+    busyWaitNs(50000);
+    TRACE_COUNTER("depth", 5);
+}
+
+// 单元测试1: 宏写入作用域/计数器/瞬时记录，名称只登记一次，任务名写入每条记录
+void test_unit_macros() {
+    traceRing.clear();
+    TRACE_THREAD("main");
+
+    uint32_t before = traceCycles();
+    tracedWork();
+    tracedWork();
+    TRACE_INSTANT("mark", 7);
+    uint32_t after = traceCycles();
+
+    std::vector<TraceRecord> recs;
+    TEST_ASSERT_EQUAL(5, drainAll(traceRing, recs));
+
+    uint16_t work = traceRing.nameId("work");
+    char depthName[] = "depth";   // 不同指针、相同内容
+    uint16_t depth = traceRing.nameId(depthName);
+    uint16_t mainId = traceRing.nameId("main");
+    TEST_ASSERT_EQUAL_STRING("work", traceRing.name(work));
+    TEST_ASSERT_EQUAL(4, traceRing.stats().names);   // main、work、depth、mark
+
+    // 作用域在结束时写入：计数器在前
+    TEST_ASSERT_EQUAL(depth, recs[0].name);
+    TEST_ASSERT_EQUAL(TRACE_TYPE_COUNTER, recs[0].type);
+    TEST_ASSERT_EQUAL(5, recs[0].value);
+    TEST_ASSERT_EQUAL(work, recs[1].name);
+    TEST_ASSERT_EQUAL(TRACE_TYPE_SPAN, recs[1].type);
+    TEST_ASSERT_TRUE(recs[1].value >= 50000);
+    TEST_ASSERT_TRUE((int32_t)(recs[1].start - before) >= 0);
+    TEST_ASSERT_TRUE((int32_t)(recs[3].start - (recs[1].start + recs[1].value)) >= 0);   // 第二次在第一次之后
+    TEST_ASSERT_EQUAL(TRACE_TYPE_INSTANT, recs[4].type);
+    TEST_ASSERT_EQUAL(7, recs[4].value);
+    TEST_ASSERT_TRUE((int32_t)(after - recs[4].start) >= 0);
+    for (const TraceRecord& r : recs) {
+        TEST_ASSERT_EQUAL(mainId, r.thread);
+    }
+
+    // 没有命名的线程记为 0xFF
+    std::thread t([]() { TRACE_INSTANT("mark", 1); });
+    t.join();
+    recs.clear();
+    TEST_ASSERT_EQUAL(1, drainAll(traceRing, recs));
+    TEST_ASSERT_EQUAL(0xFF, recs[0].thread);
+}
+
+// 单元测试2: 写满后覆盖最旧的记录，读取方计入丢失；名称表满时不记录
+void test_unit_overwrite_and_lost() {
+    static TraceRing ring;
+    uint16_t id = ring.nameId("n");
+    const int total = TRACE_RING_SIZE + 100;
+    for (int i = 0; i < total; i++) {
+        ring.record(id, TRACE_TYPE_INSTANT, (uint32_t)i, i);
+    }
+    std::vector<TraceRecord> recs;
+    TEST_ASSERT_EQUAL(TRACE_RING_SIZE, drainAll(ring, recs));
+    TEST_ASSERT_EQUAL(100, recs[0].value);
+    TEST_ASSERT_EQUAL(total - 1, recs.back().value);
+    TraceStats st = ring.stats();
+    TEST_ASSERT_EQUAL(total, st.written);
+    TEST_ASSERT_EQUAL(100, st.lost);
+
+    // 取出后再写：只取新的
+    ring.record(id, TRACE_TYPE_INSTANT, 0, -1);
+    recs.clear();
+    TEST_ASSERT_EQUAL(1, drainAll(ring, recs));
+    TEST_ASSERT_EQUAL(-1, recs[0].value);
+
+    // clear() 丢弃未取出的记录
+    ring.record(id, TRACE_TYPE_INSTANT, 0, 1);
+    ring.clear();
+    recs.clear();
+    TEST_ASSERT_EQUAL(0, drainAll(ring, recs));
+
+    static TraceRing small;
+    static char names[TRACE_MAX_NAMES + 1][8];
+    for (int i = 0; i <= TRACE_MAX_NAMES; i++) {
+        snprintf(names[i], sizeof(names[i]), "n%d", i);
+        uint16_t got = small.nameId(names[i]);
+        TEST_ASSERT_EQUAL(i < TRACE_MAX_NAMES ? i : TRACE_NO_NAME, got);
+    }
+    small.record(TRACE_NO_NAME, TRACE_TYPE_INSTANT, 0, 0);
+    TEST_ASSERT_EQUAL(0, small.stats().written);
+    TEST_ASSERT_EQUAL(TRACE_MAX_NAMES, small.stats().names);
+}
+
+// 单元测试3: 导出块：名称块在前、校验正确、按容量拆分、夹杂文本时仍能找到块
+void test_unit_export_blocks() {
+    static TraceRing ring;
+    uint16_t a = ring.nameId("i2s_read");
+    uint16_t b = ring.nameId("led_show");
+    for (int i = 0; i < 100; i++) {
+        ring.record(i % 2 ? b : a, TRACE_TYPE_SPAN, (uint32_t)(1000 * i), 10 + i);
+    }
+
+    // 每块最多 20 条记录
+    const size_t cap = TRACE_BLOCK_OVERHEAD + TRACE_RECORDS_HEADER + 20 * TRACE_RECORD_BYTES;
+    std::vector<uint8_t> stream;
+    const char* text = "[INFO] 串口文本与二进制块交错\n";
+    uint8_t buf[cap];
+    size_t n;
+    int calls = 0;
+    while ((n = ring.exportBinary(buf, cap, 5000000)) > 0) {
+        stream.insert(stream.end(), (const uint8_t*)text, (const uint8_t*)text + strlen(text));
+        stream.insert(stream.end(), buf, buf + n);
+        calls++;
+    }
+    TEST_ASSERT_EQUAL(1 + 5, calls);   // 名称块 + 5 个记录块
+
+    ParsedExport parsed = {};
+    parsed.ok = true;
+    parseBlocks(stream.data(), stream.size(), parsed);
+    TEST_ASSERT_TRUE(parsed.ok);
+    TEST_ASSERT_EQUAL(6, parsed.blocks);
+    TEST_ASSERT_EQUAL_STRING("i2s_read", parsed.names[a].c_str());
+    TEST_ASSERT_EQUAL_STRING("led_show", parsed.names[b].c_str());
+    TEST_ASSERT_EQUAL(1000, parsed.cyclesPerUs);
+    TEST_ASSERT_EQUAL(100, parsed.records.size());
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(1000 * i, parsed.records[i].start);
+        TEST_ASSERT_EQUAL(10 + i, parsed.records[i].value);
+        TEST_ASSERT_EQUAL(i % 2 ? b : a, parsed.records[i].name);
+    }
+    TEST_ASSERT_EQUAL(100, ring.stats().exported);
+
+    // 损坏一个字节：该块被丢弃
+    stream[strlen(text) * 2 + 40] ^= 0x55;
+    ParsedExport broken = {};
+    broken.ok = true;
+    parseBlocks(stream.data(), stream.size(), broken);
+    TEST_ASSERT_FALSE(broken.ok);
+    TEST_ASSERT_EQUAL(5, broken.blocks);
+
+    // 容量不够一个记录块：不取出任何记录
+    ring.record(a, TRACE_TYPE_SPAN, 0, 1);
+    TEST_ASSERT_EQUAL(0, ring.exportBinary(buf, TRACE_BLOCK_OVERHEAD + TRACE_RECORDS_HEADER, 0));
+    TEST_ASSERT_EQUAL(TRACE_BLOCK_OVERHEAD + TRACE_RECORDS_HEADER + TRACE_RECORD_BYTES,
+                      ring.exportBinary(buf, cap, 0));
+
+    // clear() 后重新开始抓包：先重发全部名称
+    ring.record(b, TRACE_TYPE_SPAN, 0, 1);
+    ring.clear();
+    n = ring.exportBinary(buf, cap, 0);
+    TEST_ASSERT_TRUE(n > 0);
+    TEST_ASSERT_EQUAL(TRACE_BLOCK_NAMES, buf[4]);
+    TEST_ASSERT_EQUAL(0, ring.exportBinary(buf, cap, 0));
+}
+
+// 单元测试4: 4 个线程同时写、1 个线程同时取：没有半写的记录，每个线程的记录按顺序，取出 + 丢失 = 写入
+void test_unit_concurrent_writers() {
+    static TraceRing ring;
+    const int threads = 4;
+    const int perThread = 50000;
+    uint16_t id = ring.nameId("w");
+    std::atomic<bool> done(false);
+
+    std::vector<TraceRecord> got;
+    std::thread reader([&]() {
+        TraceRecord batch[128];
+        while (true) {
+            bool finished = done.load();
+            size_t n = ring.drain(batch, 128);
+            got.insert(got.end(), batch, batch + n);
+            if (finished && n == 0) break;
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threads; t++) {
+        writers.emplace_back([id, t]() {
+            for (int i = 0; i < perThread; i++) {
+                int32_t value = (t << 24) | i;
+                ring.record(id, TRACE_TYPE_INSTANT, (uint32_t)value * 2654435761u, value);
+                if ((i & 63) == 0) {
+                    std::this_thread::yield();   // 让读取线程在单核主机上也能跟上一部分
+                }
+            }
+        });
+    }
+    for (std::thread& w : writers) w.join();
+    done = true;
+    reader.join();
+
+    int last[threads];
+    for (int t = 0; t < threads; t++) last[t] = -1;
+    for (const TraceRecord& r : got) {
+        TEST_ASSERT_EQUAL((uint32_t)r.value * 2654435761u, r.start);
+        TEST_ASSERT_EQUAL(id, r.name);
+        int t = r.value >> 24;
+        int i = r.value & 0xFFFFFF;
+        TEST_ASSERT_TRUE(t >= 0 && t < threads);
+        TEST_ASSERT_TRUE(i > last[t]);
+        last[t] = i;
+    }
+    TraceStats st = ring.stats();
+    printf("  写入 %lu，取出 %lu，丢失 %lu\n", (unsigned long)st.written, (unsigned long)got.size(),
+           (unsigned long)st.lost);
+    TEST_ASSERT_EQUAL(threads * perThread, st.written);
+    TEST_ASSERT_EQUAL(st.written, got.size() + st.lost);
+}
+
+// ========== 属性测试 ==========
+
+// 属性测试1: 随机写入/取出序列：取出的记录与参考模型（只保留最近 TRACE_RING_SIZE 条）一致
+void test_property_ring_model() {
+    printf("\n[Property Test] 随机写入/取出与参考模型一致 - 100次迭代\n");
+
+    static TraceRing ring;
+    uint16_t id = ring.nameId("p");
+    for (int iter = 0; iter < 100; iter++) {
+        ring.clear();
+        uint32_t lostBase = ring.stats().lost;
+        std::deque<int32_t> model;   // 尚未取出、仍在环中的记录
+        uint32_t modelLost = 0;
+        int32_t nextValue = iter * 1000000;
+        char msg[64];
+
+        int steps = testRandomInt(10, 60);
+        for (int k = 0; k < steps; k++) {
+            int writes = testRandomInt(0, 3) == 0 ? testRandomInt(0, TRACE_RING_SIZE * 2) : testRandomInt(0, 50);
+            for (int w = 0; w < writes; w++) {
+                ring.record(id, TRACE_TYPE_COUNTER, (uint32_t)nextValue, nextValue);
+                model.push_back(nextValue++);
+                if (model.size() > TRACE_RING_SIZE) {
+                    model.pop_front();
+                    modelLost++;
+                }
+            }
+
+            TraceRecord batch[256];
+            size_t want = (size_t)testRandomInt(0, 256);
+            size_t n = ring.drain(batch, want);
+            snprintf(msg, sizeof(msg), "Iter %d 步 %d", iter, k);
+            TEST_ASSERT_EQUAL_MESSAGE(model.size() < want ? model.size() : want, n, msg);
+            for (size_t i = 0; i < n; i++) {
+                TEST_ASSERT_EQUAL_MESSAGE(model.front(), batch[i].value, msg);
+                TEST_ASSERT_EQUAL_MESSAGE((uint32_t)model.front(), batch[i].start, msg);
+                model.pop_front();
+            }
+            TEST_ASSERT_EQUAL_MESSAGE(modelLost, ring.stats().lost - lostBase, msg);
+        }
+
+        if ((iter + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", iter + 1);
+        }
+    }
+}
+
+// ========== 性能测试 ==========
+
+static volatile uint32_t sink;
+
+static void plainWork(int i) {
+    sink = sink + (uint32_t)i;
+}
+
+static void tracedWorkLoop(int i) {
+    TRACE_SCOPE("bench");
+    sink = sink + (uint32_t)i;
+}
+
+// 每条记录的写入开销、导出的字节数和串口发送时间
+void test_benchmark_trace() {
+    printf("\n[Benchmark] 追踪开销与导出带宽\n");
+    const int rounds = 1000000;
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; i++) plainWork(i);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; i++) tracedWorkLoop(i);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    double plainNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / rounds;
+    double tracedNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / rounds;
+    printf("  空函数：%.1f ns/次；带 TRACE_SCOPE：%.1f ns/次（含两次读计数器和一次写环）\n", plainNs, tracedNs);
+    printf("  TRACE_ENABLED=0 时宏展开为空，开销与空函数相同\n");
+
+    // 导出：一整圈记录
+    traceRing.clear();
+    uint32_t lostBefore = traceRing.stats().lost;
+    for (int i = 0; i < TRACE_RING_SIZE; i++) tracedWorkLoop(i);
+    static uint8_t buf[4096];
+    size_t bytes = 0;
+    size_t n;
+    auto t3 = std::chrono::high_resolution_clock::now();
+    while ((n = traceRing.exportBinary(buf, sizeof(buf), 0)) > 0) bytes += n;
+    auto t4 = std::chrono::high_resolution_clock::now();
+    double exportUs = std::chrono::duration<double, std::micro>(t4 - t3).count();
+    printf("  导出 %d 条记录：%lu 字节（%.1f 字节/条），%.1f us\n", TRACE_RING_SIZE, (unsigned long)bytes,
+           (double)bytes / TRACE_RING_SIZE, exportUs);
+    printf("  串口发送时间：115200 波特 %.0f ms，921600 波特 %.1f ms\n",
+           bytes * 10 / 115200.0 * 1000, bytes * 10 / 921600.0 * 1000);
+    TEST_ASSERT_TRUE(bytes < (size_t)TRACE_RING_SIZE * (TRACE_RECORD_BYTES + 1));
+    TEST_ASSERT_EQUAL(lostBefore, traceRing.stats().lost);
+}
+
+// ========================================
+// 主函数
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("Trace 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_macros);
+    RUN_TEST(test_unit_overwrite_and_lost);
+    RUN_TEST(test_unit_export_blocks);
+    RUN_TEST(test_unit_concurrent_writers);
+
+    printf("\n========================================\n");
+    printf("Trace 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_ring_model);
+
+    printf("\n========================================\n");
+    printf("Trace 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_trace);
+
+    return UNITY_END();
+}
@@ -0,0 +1,380 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include "UiWidgets.h"
+#include "RecordingUiCanvas.h"
+
+// ========================================
+// UiWidgets 测试（主机端，native 环境）
+// 保留模式界面：控件失效标记、只重画变化控件、重叠控件、包围盒
+// 运行：python tools/run_native_tests.py test_ui_widgets
+// ========================================
+
+// 简单的伪随机数生成器（用于属性测试）
+static int testRandomInt(int min, int max) {
+    static unsigned long seed = 14142;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return min + (int)(seed % (unsigned long)(max - min + 1));
+}
+
+static bool rectEqual(const UiRect& a, const UiRect& b) {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+// 整屏重画的结果（清空缓冲，全部控件重画）
+static void fullRender(UiScreen& screen, RecordingUiCanvas& canvas) {
+    canvas.clearBuffer();
+    screen.invalidateAll();
+    screen.render(canvas);
+}
+
+// 与 test_integrated_system.cpp updateDisplay() 相同的布局
+struct StatusScreen {
+    UiLabel title{UiRect{30, 3, 64, 20}, nullptr, 17, "MOSS"};
+    UiLabel state{UiRect{0, 26, 128, 12}, nullptr, 9, "State: IDLE"};
+    UiValue volume{UiRect{0, 41, 64, 12}, nullptr, 9, "Vol: "};
+    UiBar bar{UiRect{0, 54, 128, 10}, 256};
+    UiScreen screen;
+
+    StatusScreen() {
+        screen.add(title);
+        screen.add(state);
+        screen.add(volume);
+        screen.add(bar);
+    }
+};
+
+// ========================================
+// 单元测试
+// ========================================
+
+// 单元测试1: 首次全部绘制并返回各控件矩形，之后没有变化不绘制
+void test_unit_first_render_draws_all() {
+    StatusScreen s;
+    RecordingUiCanvas canvas;
+    UiRect boxes[UI_MAX_WIDGETS];
+
+    TEST_ASSERT_EQUAL(4, s.screen.render(canvas, boxes, UI_MAX_WIDGETS));
+    TEST_ASSERT_TRUE(rectEqual(s.title.rect(), boxes[0]));
+    TEST_ASSERT_TRUE(rectEqual(s.bar.rect(), boxes[3]));
+    TEST_ASSERT_TRUE(rectEqual(UiRect{0, 3, 128, 61}, s.screen.lastBounds()));
+
+    canvas.reset();
+    TEST_ASSERT_EQUAL(0, s.screen.render(canvas, boxes, UI_MAX_WIDGETS));
+    TEST_ASSERT_EQUAL(0, canvas.fills + canvas.texts + canvas.pixelsWritten);
+    TEST_ASSERT_EQUAL(0, s.screen.lastBounds().w);
+    TEST_ASSERT_EQUAL(4, s.screen.stats().skipped);
+}
+
+// 单元测试2: 设置相同的值不失效；改变一个数值只重画这一个控件
+void test_unit_only_changed_widget() {
+    StatusScreen s;
+    RecordingUiCanvas canvas;
+    UiRect boxes[UI_MAX_WIDGETS];
+    s.screen.render(canvas);
+
+    s.state.setText("State: IDLE");
+    s.volume.setValue(0);
+    s.bar.setValue(0);
+    TEST_ASSERT_FALSE(s.state.dirty() || s.volume.dirty() || s.bar.dirty());
+    TEST_ASSERT_EQUAL(0, s.screen.render(canvas));
+
+    s.volume.setValue(42);
+    canvas.reset();
+    TEST_ASSERT_EQUAL(1, s.screen.render(canvas, boxes, UI_MAX_WIDGETS));
+    TEST_ASSERT_TRUE(rectEqual(s.volume.rect(), boxes[0]));
+    TEST_ASSERT_EQUAL(1, canvas.texts);
+    // 只写了这个控件矩形内的像素
+    TEST_ASSERT_TRUE(canvas.pixelsWritten <= (uint32_t)(64 * 12 * 2));
+
+    RecordingUiCanvas ref;
+    fullRender(s.screen, ref);
+    TEST_ASSERT_EQUAL_MEMORY(ref.buffer, canvas.buffer, DISPLAY_BUFFER_SIZE);
+}
+
+// 单元测试3: 进度条填充像素数不变时不重画；带框、竖直方向
+void test_unit_bar_quantized() {
+    UiBar bar(UiRect{0, 0, 52, 10}, 1000, UI_BAR_FRAME);   // 框内 50 像素，每像素 20
+    UiBar vbar(UiRect{100, 0, 8, 42}, 40, UI_BAR_VERTICAL);
+    UiScreen screen;
+    screen.add(bar);
+    screen.add(vbar);
+    RecordingUiCanvas canvas;
+    screen.render(canvas);
+
+    bar.setValue(19);
+    TEST_ASSERT_FALSE(bar.dirty());
+    bar.setValue(20);
+    TEST_ASSERT_TRUE(bar.dirty());
+    TEST_ASSERT_EQUAL(1, bar.fillPixels());
+    bar.setValue(5000);   // 超出范围按最大值
+    TEST_ASSERT_EQUAL(50, bar.fillPixels());
+    vbar.setValue(10);
+    TEST_ASSERT_EQUAL(2, screen.render(canvas));
+
+    // 框在，填充从框内左边开始；竖条从下往上
+    uint8_t* b = canvas.buffer;
+    TEST_ASSERT_EQUAL_HEX8(0xFF, b[0]);                                   // 左边框
+    TEST_ASSERT_EQUAL_HEX8(0xFF, b[1] | 0x01);                             // 填充（bit0 为上边框）
+    TEST_ASSERT_EQUAL_HEX8(0x03, b[DISPLAY_WIDTH + 1]);                    // 第 8、9 行：填充 + 下边框
+    TEST_ASSERT_EQUAL_HEX8(0x00, b[3 * DISPLAY_WIDTH + 100]);              // 竖条 42 行填充 10 行：第 24~31 行空
+    TEST_ASSERT_EQUAL_HEX8(0xFF, b[4 * DISPLAY_WIDTH + 100]);              // 第 32~39 行
+    TEST_ASSERT_EQUAL_HEX8(0x03, b[5 * DISPLAY_WIDTH + 100]);              // 第 40~41 行
+}
+
+// 单元测试4: 文字裁剪在控件矩形内；内容变短时旧像素被清掉
+void test_unit_clip_and_clear() {
+    UiLabel label(UiRect{10, 10, 30, 12}, nullptr, 10, "ABCDEFGHIJ");   // 60 像素宽，裁到 30
+    UiScreen screen;
+    screen.add(label);
+    RecordingUiCanvas canvas;
+    memset(canvas.buffer, 0xFF, DISPLAY_BUFFER_SIZE);   // 背景有其他内容
+    screen.render(canvas);
+
+    for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+        for (int x = 0; x < DISPLAY_WIDTH; x++) {
+            bool inside = x >= 10 && x < 40 && y >= 10 && y < 22;
+            bool on = (canvas.buffer[(y / 8) * DISPLAY_WIDTH + x] >> (y % 8)) & 1;
+            if (!inside && !on) TEST_FAIL_MESSAGE("控件矩形外的像素被改动");
+        }
+    }
+
+    label.setText("A");
+    screen.render(canvas);
+    RecordingUiCanvas ref;
+    memset(ref.buffer, 0xFF, DISPLAY_BUFFER_SIZE);
+    screen.invalidateAll();
+    screen.render(ref);
+    TEST_ASSERT_EQUAL_MEMORY(ref.buffer, canvas.buffer, DISPLAY_BUFFER_SIZE);
+}
+
+// 单元测试5: 重叠控件：下层变化时上层一起重画，上层仍在上面
+void test_unit_overlap_redraws_neighbours() {
+    static const uint8_t ICON[8] = {0x3C, 0x42, 0x81, 0xA5, 0x81, 0x99, 0x42, 0x3C};
+    UiBar bar(UiRect{0, 20, 128, 12}, 100);
+    UiIcon icon(UiRect{60, 22, 8, 8}, ICON);
+    UiValue other(UiRect{0, 40, 40, 10}, nullptr, 8, "", "%");
+    UiScreen screen;
+    screen.add(bar);
+    screen.add(icon);
+    screen.add(other);
+    RecordingUiCanvas canvas;
+    screen.render(canvas);
+
+    UiRect boxes[UI_MAX_WIDGETS];
+    bar.setValue(80);
+    TEST_ASSERT_EQUAL(2, screen.render(canvas, boxes, UI_MAX_WIDGETS));
+    TEST_ASSERT_TRUE(rectEqual(bar.rect(), boxes[0]));
+    TEST_ASSERT_TRUE(rectEqual(icon.rect(), boxes[1]));
+    TEST_ASSERT_EQUAL(1, screen.stats().overlaps);
+
+    RecordingUiCanvas ref;
+    fullRender(screen, ref);
+    TEST_ASSERT_EQUAL_MEMORY(ref.buffer, canvas.buffer, DISPLAY_BUFFER_SIZE);
+}
+
+// 单元测试6: 图标切换图片、显隐；相同图片不重画；超过容量不能加入
+void test_unit_icon_and_capacity() {
+    static const uint8_t A[2] = {0x0F, 0xF0};
+    static const uint8_t B[2] = {0xF0, 0x0F};
+    UiIcon icon(UiRect{0, 0, 8, 2}, A);
+    UiScreen screen;
+    screen.add(icon);
+    RecordingUiCanvas canvas;
+    screen.render(canvas);
+    TEST_ASSERT_EQUAL_HEX8(0x01, canvas.buffer[0]);   // A 第 0 列：第 0 行亮
+
+    icon.setImage(A);
+    TEST_ASSERT_EQUAL(0, screen.render(canvas));
+    icon.setImage(B);
+    TEST_ASSERT_EQUAL(1, screen.render(canvas));
+    TEST_ASSERT_EQUAL_HEX8(0x02, canvas.buffer[0]);
+    icon.setVisible(false);
+    TEST_ASSERT_EQUAL(1, screen.render(canvas));
+    TEST_ASSERT_EQUAL_HEX8(0x00, canvas.buffer[0] | canvas.buffer[7]);
+
+    UiScreen full;
+    for (int i = 0; i < UI_MAX_WIDGETS; i++) TEST_ASSERT_TRUE(full.add(icon));
+    TEST_ASSERT_FALSE(full.add(icon));
+    TEST_ASSERT_EQUAL(UI_MAX_WIDGETS, full.count());
+}
+
+// ========================================
+// 属性测试（100次随机迭代）
+// ========================================
+
+// 属性1: 仪表盘（含重叠控件）随机更新若干控件后增量重画：
+// - 结果与整屏重画逐像素相同
+// - 重画的控件都在返回的包围盒并集内，没有变化的帧不绘制
+void test_property_incremental_matches_full() {
+    printf("\n[Property Test] 随机更新后增量重画与整屏重画一致 - 100次迭代\n");
+
+    static const uint8_t ICON_A[8] = {0x18, 0x3C, 0x7E, 0xFF, 0xFF, 0x7E, 0x3C, 0x18};
+    static const uint8_t ICON_B[8] = {0x81, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x81};
+    UiLabel title(UiRect{30, 0, 70, 15}, nullptr, 13, "Dashboard");
+    UiBar line(UiRect{0, 15, 128, 1}, 1);
+    UiValue cpu(UiRect{5, 20, 55, 12}, nullptr, 10, "CPU:", "%");
+    UiBar cpuBar(UiRect{60, 22, 60, 8}, 100, UI_BAR_FRAME);
+    UiValue mem(UiRect{5, 36, 55, 12}, nullptr, 10, "MEM:", "%");
+    UiBar memBar(UiRect{60, 38, 60, 8}, 100, UI_BAR_FRAME);
+    UiIcon alarm(UiRect{112, 36, 8, 8}, ICON_A);           // 与 memBar 重叠
+    UiLabel temp(UiRect{5, 50, 90, 14}, nullptr, 11, "T:42C");
+    UiBar vol(UiRect{100, 48, 8, 16}, 16, UI_BAR_VERTICAL);
+    UiLabel overlay(UiRect{80, 44, 30, 12}, nullptr, 10, ""); // 与 memBar、alarm、vol 重叠
+    UiWidget* all[] = {&title, &line, &cpu, &cpuBar, &mem, &memBar, &alarm, &temp, &vol, &overlay};
+    UiScreen screen;
+    for (UiWidget* w : all) screen.add(*w);
+    line.setValue(1);
+
+    RecordingUiCanvas canvas, ref;
+    screen.render(canvas);
+    const char* texts[] = {"", "!", "OK", "Hot", "T:42C", "T:99C"};
+
+    for (int i = 0; i < 100; i++) {
+        int updates = testRandomInt(0, 4);
+        for (int u = 0; u < updates; u++) {
+            switch (testRandomInt(0, 6)) {
+                case 0: cpu.setValue(testRandomInt(0, 100)); break;
+                case 1: cpuBar.setValue(testRandomInt(0, 100)); break;
+                case 2: mem.setValue(testRandomInt(0, 3)); break;
+                case 3: memBar.setValue(testRandomInt(0, 100)); break;
+                case 4: alarm.setImage(testRandomInt(0, 1) ? ICON_A : ICON_B); alarm.setVisible(testRandomInt(0, 3) != 0); break;
+                case 5: temp.setText(texts[testRandomInt(0, 5)]); overlay.setText(texts[testRandomInt(0, 3)]); break;
+                default: vol.setValue(testRandomInt(0, 16)); break;
+            }
+        }
+
+        bool anyDirty = false;
+        for (UiWidget* w : all) anyDirty = anyDirty || w->dirty();
+        UiRect boxes[UI_MAX_WIDGETS];
+        uint8_t before[DISPLAY_BUFFER_SIZE];
+        memcpy(before, canvas.buffer, DISPLAY_BUFFER_SIZE);
+        uint8_t drawn = screen.render(canvas, boxes, UI_MAX_WIDGETS);
+        if ((drawn > 0) != anyDirty) TEST_FAIL_MESSAGE("没有变化却重画，或有变化未重画");
+
+        // 包围盒外的像素不变
+        const UiRect& bounds = screen.lastBounds();
+        for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+            for (int x = 0; x < DISPLAY_WIDTH; x++) {
+                bool inside = drawn > 0 && x >= bounds.x && x < bounds.x + bounds.w && y >= bounds.y && y < bounds.y + bounds.h;
+                int idx = (y / 8) * DISPLAY_WIDTH + x;
+                if (!inside && ((before[idx] ^ canvas.buffer[idx]) & (1 << (y % 8)))) {
+                    TEST_FAIL_MESSAGE("包围盒外的像素被改动");
+                }
+            }
+        }
+
+        fullRender(screen, ref);
+        if (memcmp(ref.buffer, canvas.buffer, DISPLAY_BUFFER_SIZE) != 0) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "Iter %d: 增量重画与整屏重画不一致", i);
+            TEST_FAIL_MESSAGE(msg);
+        }
+
+        if ((i + 1) % 10 == 0) {
+            printf("  完成 %d/100 次迭代\n", i + 1);
+        }
+    }
+    const UiRenderStats& st = screen.stats();
+    printf("  重画 %u 个控件（其中因重叠 %u 个），跳过 %u 个\n", st.drawn, st.overlaps, st.skipped);
+
+    TEST_PASS();
+}
+
+// ========================================
+// 性能测试
+// ========================================
+
+// 保留模式下每帧更新音量，返回 us/帧，并累计像素/文字/控件数
+static double retainedRun(StatusScreen& s, RecordingUiCanvas& canvas, int frames, bool withBar) {
+    canvas.reset();
+    s.screen.resetStats();
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        s.volume.setValue(f % 100);
+        if (withBar) s.bar.setValue(f % 100);
+        s.screen.render(canvas);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / frames;
+}
+
+// 性能1: 状态界面每帧更新音量：整屏重画（原 updateDisplay）vs 保留模式（只改数值 / 数值 + 进度条）
+void test_benchmark_volume_update() {
+    printf("\n[Benchmark] 状态界面每帧更新音量：整屏重画 vs 只重画变化的控件\n");
+
+    const int FRAMES = 20000;
+    StatusScreen s;
+    RecordingUiCanvas canvas;
+    s.screen.render(canvas);
+
+    // 整屏重画
+    canvas.reset();
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < FRAMES; f++) {
+        s.volume.setValue(f % 100);
+        s.bar.setValue(f % 100);
+        canvas.clearBuffer();
+        s.screen.invalidateAll();
+        s.screen.render(canvas);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double fullUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / FRAMES;
+    double fullPixels = (double)canvas.pixelsWritten / FRAMES;
+    printf("  整屏重画:          %6.2f us/帧，写 %5.0f 像素，%.1f 次文字绘制\n",
+           fullUs, fullPixels, (double)canvas.texts / FRAMES);
+
+    const char* names[] = {"保留模式（数值）:  ", "保留模式（数值+条）:"};
+    double widgets[2], pixels[2];
+    for (int k = 0; k < 2; k++) {
+        double us = retainedRun(s, canvas, FRAMES, k == 1);
+        widgets[k] = (double)s.screen.stats().drawn / FRAMES;
+        pixels[k] = (double)canvas.pixelsWritten / FRAMES;
+        printf("  %s %6.2f us/帧，写 %5.0f 像素，%.1f 次文字绘制，重画 %.2f 个控件（%.1fx）\n",
+               names[k], us, pixels[k], (double)canvas.texts / FRAMES, widgets[k], fullUs / us);
+    }
+
+    RecordingUiCanvas ref;
+    fullRender(s.screen, ref);
+    TEST_ASSERT_EQUAL_MEMORY(ref.buffer, canvas.buffer, DISPLAY_BUFFER_SIZE);
+
+    TEST_ASSERT_TRUE(widgets[0] < 1.01);
+    TEST_ASSERT_TRUE(pixels[0] * 5 < fullPixels);
+    TEST_ASSERT_TRUE(widgets[1] < 2.01);
+    TEST_ASSERT_TRUE(pixels[1] < fullPixels);
+}
+
+// ========================================
+// 测试运行器
+// ========================================
+
+int main() {
+    UNITY_BEGIN();
+
+    printf("\n========================================\n");
+    printf("UiWidgets 单元测试 (Unit Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_unit_first_render_draws_all);
+    RUN_TEST(test_unit_only_changed_widget);
+    RUN_TEST(test_unit_bar_quantized);
+    RUN_TEST(test_unit_clip_and_clear);
+    RUN_TEST(test_unit_overlap_redraws_neighbours);
+    RUN_TEST(test_unit_icon_and_capacity);
+
+    printf("\n========================================\n");
+    printf("UiWidgets 属性测试 (Property Tests)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_property_incremental_matches_full);
+
+    printf("\n========================================\n");
+    printf("UiWidgets 性能测试 (Benchmarks)\n");
+    printf("========================================\n");
+
+    RUN_TEST(test_benchmark_volume_update);
+
+    return UNITY_END();
+}
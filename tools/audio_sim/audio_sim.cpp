@@ -0,0 +1,199 @@
+/**
+ * audio_sim - 主机端音频链路仿真命令行工具
+ *
+ * 用 WAV 文件代替 SPH0645 麦克风，按与固件相同的分帧（默认每 256 个采样分析最近 512 个采样）
+ * 和分析器配置运行 AudioAnalyzer，输出方向误差、检测延迟、误触发、舵机自噪声触发和每帧 CPU 耗时。
+ *
+ * 编译（仓库根目录）：
+ *   g++ -std=gnu++17 -O2 -Ilib/AudioAnalysis -Ilib/AudioSim -Ilib/WavFile -Ilib/MotionState \
+ *       tools/audio_sim/audio_sim.cpp lib/AudioAnalysis/AudioAnalyzer.cpp \
+ *       lib/AudioAnalysis/SelfNoiseGate.cpp lib/AudioAnalysis/SpectralFeatures.cpp \
+ *       lib/AudioSim/AudioSim.cpp lib/WavFile/WavFile.cpp -o audio_sim
+ *
+ * 示例：
+ *   ./audio_sim --onset 1.0 --offset 2.0 --angle 30 rec_right30.wav
+ *   ./audio_sim --synth 45 --noise 0.003 scene.wav        # 先合成再仿真
+ *   ./audio_sim --sweep 50:400:25 --onset 1 scene.wav     # 扫描触发阈值
+ *   ./audio_sim --motion 0.3:1.3:100 --calib servo100.wav mix.wav   # 舵机自噪声门控
+ *   ./audio_sim --hop 512 --onset 1 scene.wav             # 不重叠分帧（滑动窗口之前的固件）
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "AudioSim.h"
+
+static void usage() {
+    printf("用法: audio_sim [选项] <file.wav>\n");
+    printf("  --threshold N        触发阈值（默认 100，对应 TRIGGER_THRESHOLD）\n");
+    printf("  --onset S            声源开始时间（秒）\n");
+    printf("  --offset S           声源结束时间（秒）\n");
+    printf("  --angle DEG          声源真实方向（-90 左 ~ +90 右）\n");
+    printf("  --vad-ratio R        VAD 噪声底倍数（默认 3.0）\n");
+    printf("  --window N           分析窗口采样数（默认 %d，与固件相同）\n", CAPTURE_FRAME_SAMPLES);
+    printf("  --hop N              每次读取并滑动的采样数（默认 %d，与固件相同；等于窗口时不重叠）\n",
+           CAPTURE_HOP_SAMPLES);
+    printf("  --sweep MIN:MAX:STEP 扫描触发阈值，输出对比表\n");
+    printf("  --synth DEG          先生成合成声场（onset=1s, 时长1s, 总长3s）写入 file.wav\n");
+    printf("  --level L            合成声源峰值（0~1，默认 0.1）\n");
+    printf("  --noise N            合成背景噪声 RMS（0~1，默认 0.001）\n");
+    printf("  --motion S:E:V       舵机在 S~E 秒以 V°/s 运动（--synth 时同时合成舵机噪声）\n");
+    printf("  --calib FILE         用纯舵机噪声录音（速度同 --motion）学习噪声谱并启用门控\n");
+    printf("  -v                   逐帧输出\n");
+}
+
+// 用纯舵机噪声录音学习噪声谱
+static bool calibrate(SelfNoiseGate& gate, const char* path, float velocityDps) {
+    WavAudioSource source;
+    if (!source.open(path)) {
+        printf("[ERROR] 无法打开校准 WAV: %s\n", path);
+        return false;
+    }
+    static int32_t frame[CAPTURE_FRAME_SAMPLES * CAPTURE_CHANNELS];
+    size_t n;
+    while ((n = source.readFrame(frame, CAPTURE_FRAME_SAMPLES)) == CAPTURE_FRAME_SAMPLES) {
+        gate.learn(frame, n, velocityDps);
+    }
+    if (!gate.hasProfile(gate.velocityClass(velocityDps))) {
+        printf("[ERROR] 校准录音太短: %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+static bool runOnce(const char* path, const AudioAnalyzerConfig& config,
+                    size_t windowSamples, size_t hopSamples,
+                    const SimGroundTruth& truth, bool verbose, SimReport& report,
+                    const SimMotion& motion, SelfNoiseGate* gate) {
+    WavAudioSource source;
+    if (!source.open(path)) {
+        printf("[ERROR] 无法打开 WAV: %s\n", path);
+        return false;
+    }
+    if (source.sampleRate() != 16000) {
+        printf("[WARN] 采样率 %u Hz，固件为 16000 Hz，时间类指标按文件采样率计算\n",
+               (unsigned)source.sampleRate());
+    }
+
+    AudioPipelineSim sim(config);
+    sim.setVerbose(verbose);
+    sim.setFraming(windowSamples, hopSamples);
+    sim.setMotion(motion, gate);
+    report = sim.run(source, truth);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    AudioAnalyzerConfig config;
+    SimGroundTruth truth;
+    SceneSpec scene;
+    bool synth = false;
+    bool verbose = false;
+    bool sweep = false;
+    float sweepMin = 0, sweepMax = 0, sweepStep = 0;
+    const char* path = nullptr;
+    const char* calibPath = nullptr;
+    SimMotion motion;
+    long windowSamples = CAPTURE_FRAME_SAMPLES;
+    long hopSamples = CAPTURE_HOP_SAMPLES;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (strcmp(arg, "--threshold") == 0 && hasValue) {
+            config.triggerThreshold = atof(argv[++i]);
+        } else if (strcmp(arg, "--onset") == 0 && hasValue) {
+            truth.onsetSec = atof(argv[++i]);
+        } else if (strcmp(arg, "--offset") == 0 && hasValue) {
+            truth.offsetSec = atof(argv[++i]);
+        } else if (strcmp(arg, "--angle") == 0 && hasValue) {
+            truth.angleDeg = atof(argv[++i]);
+        } else if (strcmp(arg, "--vad-ratio") == 0 && hasValue) {
+            config.vadRatio = atof(argv[++i]);
+        } else if (strcmp(arg, "--window") == 0 && hasValue) {
+            windowSamples = atol(argv[++i]);
+        } else if (strcmp(arg, "--hop") == 0 && hasValue) {
+            hopSamples = atol(argv[++i]);
+        } else if (strcmp(arg, "--sweep") == 0 && hasValue) {
+            if (sscanf(argv[++i], "%f:%f:%f", &sweepMin, &sweepMax, &sweepStep) != 3 || sweepStep <= 0) {
+                usage();
+                return 1;
+            }
+            sweep = true;
+        } else if (strcmp(arg, "--synth") == 0 && hasValue) {
+            scene.angleDeg = atof(argv[++i]);
+            synth = true;
+        } else if (strcmp(arg, "--level") == 0 && hasValue) {
+            scene.sourceLevel = atof(argv[++i]);
+        } else if (strcmp(arg, "--noise") == 0 && hasValue) {
+            scene.noiseLevel = atof(argv[++i]);
+        } else if (strcmp(arg, "--motion") == 0 && hasValue) {
+            if (sscanf(argv[++i], "%f:%f:%f", &motion.startSec, &motion.endSec, &motion.velocityDps) != 3 ||
+                motion.endSec <= motion.startSec) {
+                usage();
+                return 1;
+            }
+        } else if (strcmp(arg, "--calib") == 0 && hasValue) {
+            calibPath = argv[++i];
+        } else if (strcmp(arg, "-v") == 0) {
+            verbose = true;
+        } else if (arg[0] != '-') {
+            path = arg;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (path == nullptr || windowSamples <= 0 || hopSamples <= 0 || hopSamples > windowSamples) {
+        usage();
+        return 1;
+    }
+
+    static SelfNoiseGate gate;
+    SelfNoiseGate* gatePtr = nullptr;
+    if (calibPath != nullptr) {
+        if (motion.endSec <= motion.startSec) {
+            printf("[ERROR] --calib 需要同时指定 --motion\n");
+            return 1;
+        }
+        if (!calibrate(gate, calibPath, motion.velocityDps)) return 1;
+        gatePtr = &gate;
+    }
+
+    if (synth) {
+        if (motion.endSec > motion.startSec) {
+            scene.servoLevel = 0.02f;
+            scene.servoVelocityDps = motion.velocityDps;
+            scene.servoOnsetSec = motion.startSec;
+            scene.servoDurationSec = motion.endSec - motion.startSec;
+        }
+        if (!synthesizeScene(scene, path)) {
+            printf("[ERROR] 无法写入 %s\n", path);
+            return 1;
+        }
+        truth.onsetSec = scene.onsetSec;
+        truth.offsetSec = scene.onsetSec + scene.durationSec;
+        truth.angleDeg = scene.angleDeg;
+        printf("[SIM] 已合成声场: %s（方向 %.1f°）\n", path, scene.angleDeg);
+    }
+
+    SimReport report;
+    if (!sweep) {
+        if (!runOnce(path, config, windowSamples, hopSamples, truth, verbose, report, motion, gatePtr)) return 1;
+        AudioPipelineSim::printReport(path, report);
+        return 0;
+    }
+
+    printf("[SIM] 阈值扫描: %s\n", path);
+    printf("  阈值   触发延迟(ms)  误触发帧  触发帧  方向误差(°)\n");
+    for (float t = sweepMin; t <= sweepMax + 1e-3f; t += sweepStep) {
+        config.triggerThreshold = t;
+        if (!runOnce(path, config, windowSamples, hopSamples, truth, false, report, motion, gatePtr)) return 1;
+        printf("  %5.0f  %12.1f  %8u  %6u  %10.1f\n", t, report.detectionLatencyMs,
+               (unsigned)report.falseTriggers, (unsigned)report.triggeredFrames,
+               report.meanDirectionError);
+    }
+    return 0;
+}
@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+"""
+make_glyph_labels.py - 把静态中文标签按 U8g2 字体预先渲染成位图（放进闪存）
+
+用法：
+    python tools/make_glyph_labels.py \\
+        --font-source .pio/libdeps/esp32-s3-devkitc-1/U8g2/src/clib/u8g2_fonts.c \\
+        --font u8g2_font_wqy14_t_gb2312 \\
+        --scan test/hardware_function_tests/test_oled_display.cpp \\
+        -o lib/GlyphCache/GlyphLabelsData.h \\
+        "系统状态" "音量"
+
+- 字体直接从 U8g2 的 u8g2_fonts.c 中读取（也可以用 --font-bin 指定字体数据的二进制文件）
+- --scan：收集源文件中 drawUTF8(x, y, "...") 的字符串常量作为标签
+- 输出为 GlyphLabel 表（格式见 lib/GlyphCache/GlyphCache.h），程序中用 glyphLabelFind() 查找，
+  绘制结果与 GlyphCache::drawUTF8 / U8g2 drawUTF8 逐像素相同
+
+字体格式与解码过程见 lib/GlyphCache/U8g2Font.h。
+"""
+
+import argparse
+import re
+import sys
+
+HEADER_SIZE = 23
+COLUMN_BITS = 16   # 与 GLYPH_COLUMN_BITS 相同
+
+
+# ========== 读取字体 ==========
+
+def parse_c_string(body):
+    """把 C 源码中相邻的字符串常量拼接并转义为字节"""
+    out = bytearray()
+    for literal in re.findall(r'"((?:[^"\\]|\\.)*)"', body, re.S):
+        i = 0
+        while i < len(literal):
+            c = literal[i]
+            if c != "\\":
+                out += c.encode("latin-1")
+                i += 1
+                continue
+            n = literal[i + 1]
+            if n in "01234567":
+                m = re.match(r"[0-7]{1,3}", literal[i + 1:])
+                out.append(int(m.group(0), 8) & 0xFF)
+                i += 1 + len(m.group(0))
+            elif n == "x":
+                m = re.match(r"[0-9a-fA-F]+", literal[i + 2:])
+                out.append(int(m.group(0), 16) & 0xFF)
+                i += 2 + len(m.group(0))
+            else:
+                out += {"n": b"\n", "t": b"\t", "r": b"\r", "a": b"\a", "b": b"\b",
+                        "f": b"\f", "v": b"\v"}.get(n, n.encode("latin-1"))
+                i += 2
+    return bytes(out)
+
+
+def load_font_from_source(path, name):
+    with open(path, "r", encoding="latin-1") as f:
+        src = f.read()
+    m = re.search(r"\b%s\s*\[\s*\d*\s*\][^=]*=(.*?);" % re.escape(name), src, re.S)
+    if not m:
+        sys.exit("%s: 没有找到字体 %s" % (path, name))
+    return parse_c_string(m.group(1))
+
+
+def word(font, pos):
+    return (font[pos] << 8) | font[pos + 1]
+
+
+class Font:
+    def __init__(self, data):
+        self.data = data
+        (self.glyph_cnt, self.bbx_mode, self.bits_per_0, self.bits_per_1,
+         self.bits_per_w, self.bits_per_h, self.bits_per_x, self.bits_per_y,
+         self.bits_per_dx) = data[0:9]
+        self.start_upper_a = word(data, 17)
+        self.start_lower_a = word(data, 19)
+        self.start_unicode = word(data, 21)
+
+    def find(self, encoding):
+        """与 u8g2_font_get_glyph_data 相同的查找，返回字形位流的起始位置"""
+        font = self.data
+        pos = HEADER_SIZE
+        if encoding <= 255:
+            if encoding >= ord("a"):
+                pos += self.start_lower_a
+            elif encoding >= ord("A"):
+                pos += self.start_upper_a
+            while font[pos + 1] != 0:
+                if font[pos] == encoding:
+                    return pos + 2
+                pos += font[pos + 1]
+            return None
+
+        pos += self.start_unicode
+        table = pos
+        while True:
+            pos += word(font, table)
+            last = word(font, table + 2)
+            table += 4
+            if last >= encoding:
+                break
+        while True:
+            e = word(font, pos)
+            if e == 0:
+                return None
+            if e == encoding:
+                return pos + 3
+            pos += font[pos + 2]
+
+    def decode(self, pos):
+        """解码字形，返回 (宽, 高, x, y, dx, 按行像素列表)"""
+        state = {"pos": pos, "bit": 0}
+
+        def get(cnt):
+            val = self.data[state["pos"]] >> state["bit"]
+            end = state["bit"] + cnt
+            if end >= 8:
+                state["pos"] += 1
+                val |= self.data[state["pos"]] << (8 - state["bit"])
+                end -= 8
+            state["bit"] = end
+            return val & ((1 << cnt) - 1)
+
+        def get_signed(cnt):
+            return get(cnt) - (1 << (cnt - 1))
+
+        w = get(self.bits_per_w)
+        h = get(self.bits_per_h)
+        x = get_signed(self.bits_per_x)
+        y = get_signed(self.bits_per_y)
+        dx = get_signed(self.bits_per_dx)
+        pixels = [[0] * w for _ in range(h)]
+        if w == 0:
+            return w, h, x, y, dx, pixels
+
+        cx, cy = 0, 0
+
+        def run(n, on):
+            nonlocal cx, cy
+            while n > 0 and cy < h:
+                k = min(n, w - cx)
+                if on:
+                    for i in range(k):
+                        pixels[cy][cx + i] = 1
+                n -= k
+                cx += k
+                if cx >= w:
+                    cx = 0
+                    cy += 1
+
+        while True:
+            a = get(self.bits_per_0)
+            b = get(self.bits_per_1)
+            while True:
+                run(a, False)
+                run(b, True)
+                if get(1) == 0:
+                    break
+            if cy >= h:
+                break
+        return w, h, x, y, dx, pixels
+
+
+# ========== 渲染标签 ==========
+
+def render_label(font, text):
+    """与 drawUTF8 相同的排版（基线为 0），返回 (advance, left, top, 各列位图)，每列 bit0 为最上一行"""
+    points = {}
+    pen = 0
+    for ch in text:
+        pos = font.find(ord(ch))
+        if pos is None:
+            print("[WARN] 字体中没有 %r（%s）" % (ch, text), file=sys.stderr)
+            continue
+        w, h, gx, gy, dx, pixels = font.decode(pos)
+        left = pen + gx
+        top = -(h + gy)          # 屏幕坐标：基线为 0，向下为正
+        for r in range(h):
+            for c in range(w):
+                if pixels[r][c]:
+                    points[(left + c, top + r)] = 1
+        pen += dx
+
+    if not points:
+        return pen, 0, 0, []
+    xs = [p[0] for p in points]
+    ys = [p[1] for p in points]
+    x0, x1, y0, y1 = min(xs), max(xs), min(ys), max(ys)
+    width, height = x1 - x0 + 1, y1 - y0 + 1
+    if width > 255 or height > COLUMN_BITS or not -128 <= x0 <= 127 or not -128 <= y0 <= 127:
+        sys.exit("标签 %r 太大（%dx%d，高度不能超过 %d）" % (text, width, height, COLUMN_BITS))
+
+    columns = [0] * width
+    for (px, py) in points:
+        columns[px - x0] |= 1 << (py - y0)
+    return pen, x0, -y0, columns
+
+
+def scan_labels(path):
+    with open(path, "r", encoding="utf-8") as f:
+        src = f.read()
+    return re.findall(r'drawUTF8\s*\([^,]+,[^,]+,\s*"((?:[^"\\]|\\.)*)"\s*\)', src)
+
+
+def c_escape(text):
+    return text.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def write_header(path, labels, font_name):
+    lines = [
+        "// 由 tools/make_glyph_labels.py 生成，请勿手工修改",
+        "// 字体：%s" % font_name,
+        "#ifndef GLYPH_LABELS_DATA_H",
+        "#define GLYPH_LABELS_DATA_H",
+        "",
+        '#include "GlyphCache.h"',
+        "",
+    ]
+    for i, (text, (advance, left, top, columns)) in enumerate(labels):
+        lines.append("// %s" % text)
+        body = ", ".join("0x%04x" % c for c in columns) if columns else "0"
+        lines.append("static const uint16_t GLYPH_LABEL_COLUMNS_%d[] = {%s};" % (i, body))
+    lines.append("")
+    lines.append("static const GlyphLabel GLYPH_LABELS[] = {")
+    for i, (text, (advance, left, top, columns)) in enumerate(labels):
+        lines.append('    {"%s", %d, %d, %d, %d, GLYPH_LABEL_COLUMNS_%d},'
+                     % (c_escape(text), advance, left, top, len(columns), i))
+    lines.append("};")
+    lines.append("")
+    lines.append("#define GLYPH_LABEL_COUNT (sizeof(GLYPH_LABELS) / sizeof(GLYPH_LABELS[0]))")
+    lines.append("")
+    lines.append("#endif // GLYPH_LABELS_DATA_H")
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="预渲染 U8g2 字体标签")
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--font-source", help="U8g2 的 u8g2_fonts.c")
+    src.add_argument("--font-bin", help="字体数据二进制文件")
+    ap.add_argument("--font", default="u8g2_font_wqy14_t_gb2312", help="字体名")
+    ap.add_argument("--scan", action="append", default=[], help="收集源文件中的 drawUTF8 字符串常量")
+    ap.add_argument("-o", "--output", required=True)
+    ap.add_argument("labels", nargs="*")
+    args = ap.parse_args()
+
+    if args.font_source:
+        data = load_font_from_source(args.font_source, args.font)
+    else:
+        with open(args.font_bin, "rb") as f:
+            data = f.read()
+    font = Font(data)
+
+    texts = []
+    for path in args.scan:
+        texts += scan_labels(path)
+    texts += args.labels
+    unique = []
+    for t in texts:
+        if t not in unique:
+            unique.append(t)
+    if not unique:
+        sys.exit("没有标签")
+
+    labels = [(t, render_label(font, t)) for t in unique]
+    write_header(args.output, labels, args.font)
+
+    total = sum(len(r[3]) * 2 for _, r in labels)
+    print("%d 个标签，位图共 %d 字节 -> %s" % (len(labels), total, args.output))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""
+make_soundbank.py - 把 WAV 文件打包成闪存音效库（SoundBank 格式）
+
+用法：
+    python tools/make_soundbank.py -o data/sounds.bin boot.wav hello.wav:adpcm
+    esptool.py write_flash <sounds分区偏移> data/sounds.bin
+
+- 输入为任意采样率的 16 位 WAV，自动混成单声道并线性重采样到 --rate
+- 文件名后加 ":adpcm" 以 IMA ADPCM 存储（体积约为 PCM 的 1/4）
+- 音效名取文件名（不含扩展名），最长 15 个字符
+
+格式定义见 lib/AudioPlayback/SoundBank.h。
+"""
+
+import argparse
+import os
+import struct
+import sys
+import wave
+
+SOUND_BANK_MAGIC = 0x42535249  # "IRSB"
+SOUND_BANK_VERSION = 1
+CLIP_PCM16 = 0
+CLIP_IMA_ADPCM = 1
+NAME_LEN = 16
+
+IMA_STEP_TABLE = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+    157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+    724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+    3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+]
+IMA_INDEX_TABLE = [-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8]
+
+
+def read_wav_mono(path):
+    """读取 16 位 WAV，返回 (单声道采样列表, 采样率)"""
+    with wave.open(path, "rb") as w:
+        if w.getsampwidth() != 2:
+            sys.exit("%s: 只支持 16 位 WAV" % path)
+        channels = w.getnchannels()
+        rate = w.getframerate()
+        raw = w.readframes(w.getnframes())
+
+    samples = struct.unpack("<%dh" % (len(raw) // 2), raw)
+    if channels == 1:
+        return list(samples), rate
+    mono = []
+    for i in range(0, len(samples), channels):
+        mono.append(sum(samples[i:i + channels]) // channels)
+    return mono, rate
+
+
+def resample(samples, src_rate, dst_rate):
+    """线性插值重采样（音效足够用，不追求高保真）"""
+    if src_rate == dst_rate or not samples:
+        return samples
+    out_len = len(samples) * dst_rate // src_rate
+    out = []
+    for i in range(out_len):
+        pos = i * src_rate / dst_rate
+        j = int(pos)
+        frac = pos - j
+        a = samples[j]
+        b = samples[j + 1] if j + 1 < len(samples) else a
+        out.append(int(round(a + (b - a) * frac)))
+    return out
+
+
+def ima_encode(samples):
+    """IMA ADPCM 编码，与 AudioMixer.cpp 中的 imaAdpcmEncodeSample 一致"""
+    predictor = 0
+    index = 0
+    nibbles = []
+    for s in samples:
+        step = IMA_STEP_TABLE[index]
+        diff = s - predictor
+        nibble = 0
+        if diff < 0:
+            nibble = 8
+            diff = -diff
+        if diff >= step:
+            nibble |= 4
+            diff -= step
+        step >>= 1
+        if diff >= step:
+            nibble |= 2
+            diff -= step
+        step >>= 1
+        if diff >= step:
+            nibble |= 1
+
+        # 用解码公式更新预测值
+        step = IMA_STEP_TABLE[index]
+        d = step >> 3
+        if nibble & 4:
+            d += step
+        if nibble & 2:
+            d += step >> 1
+        if nibble & 1:
+            d += step >> 2
+        predictor += -d if nibble & 8 else d
+        predictor = max(-32768, min(32767, predictor))
+        index = max(0, min(88, index + IMA_INDEX_TABLE[nibble]))
+        nibbles.append(nibble)
+
+    if len(nibbles) % 2:
+        nibbles.append(0)
+    return bytes(nibbles[i] | (nibbles[i + 1] << 4) for i in range(0, len(nibbles), 2))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="打包 WAV 为 SoundBank 闪存镜像")
+    parser.add_argument("inputs", nargs="+", help="WAV 文件，可加 :adpcm 后缀")
+    parser.add_argument("-o", "--output", required=True)
+    parser.add_argument("--rate", type=int, default=16000, help="输出采样率（与 AudioMixer 一致）")
+    args = parser.parse_args()
+
+    clips = []
+    for spec in args.inputs:
+        path, _, fmt = spec.partition(":")
+        name = os.path.splitext(os.path.basename(path))[0]
+        if len(name.encode()) >= NAME_LEN:
+            sys.exit("%s: 音效名超过 %d 个字符" % (name, NAME_LEN - 1))
+
+        samples, rate = read_wav_mono(path)
+        samples = resample(samples, rate, args.rate)
+        if fmt == "adpcm":
+            data = ima_encode(samples)
+            clip_format = CLIP_IMA_ADPCM
+        else:
+            data = struct.pack("<%dh" % len(samples), *samples)
+            clip_format = CLIP_PCM16
+        clips.append((name, clip_format, len(samples), data))
+
+    # 头 + 目录，数据段 4 字节对齐
+    offset = 8 + 32 * len(clips)
+    table = b""
+    blob = b""
+    for name, clip_format, count, data in clips:
+        pad = (-offset) % 4
+        blob += b"\0" * pad
+        offset += pad
+        table += struct.pack("<16sBBHIII", name.encode(), clip_format, 0,
+                             args.rate, offset, len(data), count)
+        blob += data
+        offset += len(data)
+
+    header = struct.pack("<IHH", SOUND_BANK_MAGIC, SOUND_BANK_VERSION, len(clips))
+    with open(args.output, "wb") as f:
+        f.write(header + table + blob)
+
+    for name, clip_format, count, data in clips:
+        print("  %-15s %-6s %6d 采样 %7d 字节" % (
+            name, "ADPCM" if clip_format == CLIP_IMA_ADPCM else "PCM", count, len(data)))
+    print("音效库: %s (%d 字节)" % (args.output, offset))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+"""
+make_sprite_anim.py - 把 PNG 序列打包成闪存表情动画库（SpriteAnim 格式）
+
+用法：
+    python tools/make_sprite_anim.py -o data/sprites.bin assets/sprites/blink assets/sprites/look:100
+    esptool.py write_flash <sprites分区偏移> data/sprites.bin
+
+    python tools/make_sprite_anim.py -o lib/SpriteAnim/FaceSpritesData.h --name FACE_SPRITES \\
+        assets/sprites/blink:80 assets/sprites/look:100 assets/sprites/happy:90:once
+
+- 每个输入是一个目录，其中的 PNG 按文件名排序为帧；动画名取目录名，最长 15 个字符
+- 目录后加 ":毫秒" 指定每帧时长（默认 --frame-ms），加 ":once" 表示默认不循环
+- PNG 亮度 >= --threshold 的像素点亮（--invert 反转）；同一动画的帧尺寸必须相同，
+  宽度最大 128，高度最大 64，高度向上补齐到 8 的倍数
+- 第一帧为关键帧；之后每帧取关键帧和差分帧中较小的一种，--key-every N 强制每 N 帧一个关键帧
+- 输出扩展名为 .h 时生成常量数组（编译进程序），否则生成分区镜像
+
+只依赖 Python 标准库（PNG 用 zlib 解码，支持非隔行的灰度/RGB/调色板/带透明度，位深 1~16）。
+格式定义见 lib/SpriteAnim/SpriteAnim.h。
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+SPRITE_BANK_MAGIC = 0x41535249  # "IRSA"
+SPRITE_BANK_VERSION = 1
+SPRITE_FRAME_KEY = 0
+SPRITE_FRAME_DELTA = 1
+SPRITE_ANIM_LOOP = 0x01
+NAME_LEN = 16
+DISPLAY_WIDTH = 128
+DISPLAY_HEIGHT = 64
+
+
+# ========== 读取 PNG ==========
+
+def read_png(path):
+    """读取 PNG，返回 (宽, 高, 亮度行列表)，亮度 0~255，透明像素按黑色处理"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        sys.exit("%s: 不是 PNG 文件" % path)
+
+    pos = 8
+    idat = b""
+    palette = None
+    trns = None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [body[i:i + 3] for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+    if interlace:
+        sys.exit("%s: 不支持隔行 PNG" % path)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    bits_per_pixel = channels * depth
+    stride = (width * bits_per_pixel + 7) // 8
+    bpp = max(1, bits_per_pixel // 8)
+    raw = zlib.decompress(idat)
+
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        filt = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if filt == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif filt == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif filt == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif filt == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xFF
+        prev = line
+        rows.append(unpack_row(line, width, depth, color, channels, palette, trns))
+    return width, height, rows
+
+
+def unpack_row(line, width, depth, color, channels, palette, trns):
+    """把一行解成亮度值"""
+    if depth < 8:
+        samples = []
+        per_byte = 8 // depth
+        mask = (1 << depth) - 1
+        for x in range(width):
+            byte = line[x // per_byte]
+            shift = 8 - depth * (x % per_byte + 1)
+            samples.append((byte >> shift) & mask)
+        if color == 3:
+            return [palette_luma(palette, trns, s) for s in samples]
+        return [s * 255 // mask for s in samples]
+
+    step = depth // 8
+    values = [line[i] for i in range(0, len(line), step)]   # 16 位只取高字节
+    out = []
+    for x in range(width):
+        px = values[x * channels:(x + 1) * channels]
+        if color == 3:
+            out.append(palette_luma(palette, trns, px[0]))
+            continue
+        if color in (0, 4):
+            luma = px[0]
+        else:
+            luma = (px[0] * 299 + px[1] * 587 + px[2] * 114) // 1000
+        if color in (4, 6):
+            luma = luma * px[-1] // 255
+        out.append(luma)
+    return out
+
+
+def palette_luma(palette, trns, index):
+    r, g, b = palette[index]
+    luma = (r * 299 + g * 587 + b * 114) // 1000
+    if trns is not None and index < len(trns):
+        luma = luma * trns[index] // 255
+    return luma
+
+
+def to_pages(width, height, rows, threshold, invert):
+    """转成 U8g2 缓冲格式：按页，每页 width 字节，bit0 在上"""
+    pages = (height + 7) // 8
+    out = bytearray(width * pages)
+    for y in range(height):
+        for x in range(width):
+            on = rows[y][x] >= threshold
+            if on != invert:
+                out[(y // 8) * width + x] |= 1 << (y % 8)
+    return bytes(out), pages
+
+
+# ========== 编码 ==========
+
+def rle_encode(data):
+    """行程编码：0x00~0x7F 后跟 n+1 个原样字节；0x80~0xFF 后 1 个字节重复 (n & 0x7F) + 2 次"""
+    out = bytearray()
+    literal = bytearray()
+
+    def flush():
+        if literal:
+            out.append(len(literal) - 1)
+            out.extend(literal)
+            literal.clear()
+
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < 129:
+            run += 1
+        # 原样段中间只有 3 个以上相同字节才值得断开
+        if run >= 3 or (run == 2 and not literal):
+            flush()
+            out.append(0x80 | (run - 2))
+            out.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+            if len(literal) == 128:
+                flush()
+    flush()
+    return bytes(out)
+
+
+def encode_frames(frames, key_every):
+    """返回 (帧数据, 关键帧数)"""
+    blob = b""
+    keys = 0
+    prev = None
+    for i, frame in enumerate(frames):
+        key = rle_encode(frame)
+        kind, payload = SPRITE_FRAME_KEY, key
+        if prev is not None and not (key_every and i % key_every == 0):
+            delta = rle_encode(bytes(a ^ b for a, b in zip(frame, prev)))
+            if len(delta) < len(key):
+                kind, payload = SPRITE_FRAME_DELTA, delta
+        if len(payload) > 0xFFFF:
+            sys.exit("帧数据超过 65535 字节")
+        keys += kind == SPRITE_FRAME_KEY
+        blob += struct.pack("<BBH", kind, 0, len(payload)) + payload
+        prev = frame
+    return blob, keys
+
+
+def load_anim(spec, args):
+    parts = spec.split(":")
+    path = parts[0]
+    frame_ms = args.frame_ms
+    loop = True
+    for p in parts[1:]:
+        if p == "once":
+            loop = False
+        elif p.isdigit() and 0 < int(p) <= 0xFFFF:
+            frame_ms = int(p)
+        else:
+            sys.exit("%s: 无法识别的选项 %s" % (spec, p))
+
+    name = os.path.basename(os.path.normpath(path))
+    if len(name.encode()) >= NAME_LEN:
+        sys.exit("%s: 动画名超过 %d 个字符" % (name, NAME_LEN - 1))
+    files = sorted(f for f in os.listdir(path) if f.lower().endswith(".png"))
+    if not files:
+        sys.exit("%s: 没有 PNG 文件" % path)
+
+    frames = []
+    size = None
+    for f in files:
+        width, height, rows = read_png(os.path.join(path, f))
+        if size is not None and size != (width, height):
+            sys.exit("%s: 尺寸 %dx%d 与第一帧 %dx%d 不同" % (f, width, height, size[0], size[1]))
+        if width > DISPLAY_WIDTH or height > DISPLAY_HEIGHT:
+            sys.exit("%s: 尺寸 %dx%d 超过 %dx%d" % (f, width, height, DISPLAY_WIDTH, DISPLAY_HEIGHT))
+        size = (width, height)
+        page_bytes, pages = to_pages(width, height, rows, args.threshold, args.invert)
+        frames.append(page_bytes)
+    if len(frames) > 0xFFFF:
+        sys.exit("%s: 帧数过多" % path)
+
+    blob, keys = encode_frames(frames, args.key_every)
+    return {
+        "name": name, "width": size[0], "pages": (size[1] + 7) // 8, "frames": len(frames),
+        "frame_ms": frame_ms, "flags": SPRITE_ANIM_LOOP if loop else 0, "data": blob,
+        "keys": keys, "raw": sum(len(f) for f in frames),
+    }
+
+
+# ========== 输出 ==========
+
+def build_bank(anims):
+    """头 + 目录，每个动画的数据 4 字节对齐"""
+    offset = 8 + 32 * len(anims)
+    table = b""
+    blob = b""
+    for a in anims:
+        pad = (-offset) % 4
+        blob += b"\0" * pad
+        offset += pad
+        table += struct.pack("<16sBBHHBBII", a["name"].encode(), a["width"], a["pages"],
+                             a["frames"], a["frame_ms"], a["flags"], 0, offset, len(a["data"]))
+        blob += a["data"]
+        offset += len(a["data"])
+    header = struct.pack("<IHH", SPRITE_BANK_MAGIC, SPRITE_BANK_VERSION, len(anims))
+    return header + table + blob
+
+
+def write_header(path, name, bank, anims):
+    guard = "%s_H" % os.path.splitext(os.path.basename(path))[0].upper()
+    guard = "".join(c if c.isalnum() else "_" for c in guard)
+    lines = [
+        "// 由 tools/make_sprite_anim.py 生成，请勿手工修改",
+        "// 动画：%s" % ", ".join("%s（%d 帧，%d ms）" % (a["name"], a["frames"], a["frame_ms"]) for a in anims),
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        "#include <stdint.h>",
+        "",
+        "// 用 SpriteBank::attach(%s, sizeof(%s)) 解析" % (name, name),
+        "alignas(4) static const uint8_t %s[] = {" % name,
+    ]
+    for i in range(0, len(bank), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in bank[i:i + 16]) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append("#endif // %s" % guard)
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="打包 PNG 序列为 SpriteAnim 动画库")
+    parser.add_argument("inputs", nargs="+", help="PNG 帧目录，可加 :毫秒 和 :once 后缀")
+    parser.add_argument("-o", "--output", required=True, help=".h 生成常量数组，其他为分区镜像")
+    parser.add_argument("--name", default="SPRITE_BANK_DATA", help=".h 中的数组名")
+    parser.add_argument("--frame-ms", type=int, default=100, help="默认每帧时长")
+    parser.add_argument("--threshold", type=int, default=128, help="点亮的最低亮度")
+    parser.add_argument("--invert", action="store_true", help="暗像素点亮")
+    parser.add_argument("--key-every", type=int, default=0, help="每 N 帧强制一个关键帧（0 为不强制）")
+    args = parser.parse_args()
+
+    anims = [load_anim(spec, args) for spec in args.inputs]
+    bank = build_bank(anims)
+    if args.output.endswith(".h"):
+        write_header(args.output, args.name, bank, anims)
+    else:
+        with open(args.output, "wb") as f:
+            f.write(bank)
+
+    for a in anims:
+        print("  %-15s %3dx%-2d %3d 帧 %4d ms  关键帧 %2d  原始 %6d 字节  压缩 %5d 字节" % (
+            a["name"], a["width"], a["pages"] * 8, a["frames"], a["frame_ms"], a["keys"],
+            a["raw"], len(a["data"])))
+    print("动画库: %s (%d 字节)" % (args.output, len(bank)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""
+merge_histograms.py - 汇总多台设备的 LatencyHistogram 日志，并与基线固件比较
+
+用法：
+    # 每台设备串口输入 j，把输出（含 HIST 行）存成一个日志文件
+    python tools/merge_histograms.py logs/v1.4/*.log
+    python tools/merge_histograms.py logs/v1.5/*.log --baseline logs/v1.4/*.log --threshold 10
+
+- 每个文件中同名直方图只取最后一行（设备端的计数从启动开始累计），不同文件（设备）的同名直方图按桶相加
+- 输出每个直方图的设备数、次数、p50 / p90 / p99 / p99.9、最大值和超时比例
+- 给出 --baseline 时对比两组：p99 或超时比例比基线增加超过 --threshold 百分比记为回归，
+  有回归时退出码为 1（可以放在发布检查中）
+
+只依赖 Python 标准库。格式定义见 lib/LatencyHistogram/LatencyHistogram.h。
+"""
+
+import argparse
+import math
+import sys
+
+PERCENTS = [50, 90, 99, 99.9]
+
+
+# ========== 分桶（与 LatencyHistogram 相同） ==========
+
+def bucket_low(index, sub_bits):
+    sub_count = 1 << sub_bits
+    if index < sub_count:
+        return index
+    shift = index // sub_count - 1
+    return (sub_count + index % sub_count) << shift
+
+
+def bucket_high(index, sub_bits):
+    sub_count = 1 << sub_bits
+    if index < sub_count:
+        return index
+    shift = index // sub_count - 1
+    return bucket_low(index, sub_bits) + (1 << shift) - 1
+
+
+# ========== 解析 ==========
+
+def parse_line(line):
+    """解析一行 HIST 文本，返回 (名称, 字典)；不是 HIST 行时返回 None"""
+    pos = line.find("HIST ")
+    if pos < 0:
+        return None
+    parts = line[pos + 5:].split()
+    if len(parts) < 2:
+        return None
+    name = parts[0]
+    hist = {"buckets": {}}
+    try:
+        for part in parts[1:]:
+            key, _, value = part.partition("=")
+            if key == "b":
+                for item in value.split(","):
+                    if item:
+                        index, _, count = item.partition(":")
+                        hist["buckets"][int(index)] = int(count)
+            else:
+                hist[key] = int(value)
+    except ValueError:
+        return None   # 串口丢字节造成的残行
+    for key in ("s", "n", "miss", "max"):
+        if key not in hist:
+            return None
+    hist.setdefault("over", 0)
+    hist.setdefault("dl", 0)
+    return name, hist
+
+
+def load_files(paths):
+    """返回 {名称: [每个设备的直方图]}"""
+    merged = {}
+    for path in paths:
+        latest = {}
+        with open(path, "r", encoding="utf-8", errors="replace") as f:
+            for line in f:
+                parsed = parse_line(line)
+                if parsed is not None:
+                    latest[parsed[0]] = parsed[1]
+        if not latest:
+            print("警告：%s 中没有 HIST 行" % path, file=sys.stderr)
+        for name, hist in latest.items():
+            merged.setdefault(name, []).append(hist)
+    return merged
+
+
+def merge(hists):
+    total = {"buckets": {}, "n": 0, "miss": 0, "over": 0, "max": 0, "s": hists[0]["s"],
+             "dl": hists[0]["dl"], "devices": len(hists)}
+    for h in hists:
+        if h["s"] != total["s"]:
+            sys.exit("分桶位数不同（s=%d 与 s=%d），不能合并" % (h["s"], total["s"]))
+        for index, count in h["buckets"].items():
+            total["buckets"][index] = total["buckets"].get(index, 0) + count
+        total["n"] += h["n"]
+        total["miss"] += h["miss"]
+        total["over"] += h["over"]
+        total["max"] = max(total["max"], h["max"])
+    return total
+
+
+# ========== 统计 ==========
+
+def percentile(hist, percent):
+    """与 LatencyHistogram::percentile 相同：第 ceil(n × p / 100) 个值所在桶的上界，不超过最大值"""
+    total = sum(hist["buckets"].values())
+    if total == 0:
+        return 0
+    rank = min(max(int(math.ceil(total * percent / 100.0)), 1), total)
+    seen = 0
+    indices = sorted(hist["buckets"])
+    for index in indices:
+        seen += hist["buckets"][index]
+        if seen >= rank:
+            if index == indices[-1] and hist["over"] > 0:
+                return hist["max"]   # 溢出的值都在最后一个桶，没有上界
+            return min(bucket_high(index, hist["s"]), hist["max"])
+    return hist["max"]
+
+
+def summarize(hist):
+    row = {"devices": hist["devices"], "n": hist["n"], "max": hist["max"], "miss": hist["miss"]}
+    for p in PERCENTS:
+        row[p] = percentile(hist, p)
+    row["miss_pct"] = hist["miss"] * 100.0 / hist["n"] if hist["n"] else 0.0
+    return row
+
+
+def print_table(title, rows):
+    print(title)
+    print("  %-16s %4s %10s %8s %8s %8s %8s %9s %8s" % (
+        "名称", "设备", "次数", "p50", "p90", "p99", "p99.9", "最大", "超时%"))
+    for name in sorted(rows):
+        r = rows[name]
+        print("  %-16s %4d %10d %8d %8d %8d %8d %9d %8.3f" % (
+            name, r["devices"], r["n"], r[50], r[90], r[99], r[99.9], r["max"], r["miss_pct"]))
+
+
+def grew(new, old, threshold):
+    if old == 0:
+        return new > 0
+    return (new - old) * 100.0 / old > threshold
+
+
+def main():
+    parser = argparse.ArgumentParser(description="汇总 LatencyHistogram 日志并与基线比较")
+    parser.add_argument("logs", nargs="+", help="设备日志（每台设备一个文件）")
+    parser.add_argument("--baseline", nargs="+", default=[], help="基线固件的设备日志")
+    parser.add_argument("--threshold", type=float, default=10.0, help="p99 / 超时比例增加多少百分比算回归")
+    args = parser.parse_args()
+
+    current = {name: summarize(merge(h)) for name, h in load_files(args.logs).items()}
+    if not current:
+        sys.exit("没有找到 HIST 行（设备端输入 j 打印直方图）")
+    print_table("当前（%d 个文件）：" % len(args.logs), current)
+
+    if not args.baseline:
+        return
+    baseline = {name: summarize(merge(h)) for name, h in load_files(args.baseline).items()}
+    print_table("基线（%d 个文件）：" % len(args.baseline), baseline)
+
+    regressions = 0
+    print("对比（阈值 %.1f%%）：" % args.threshold)
+    for name in sorted(current):
+        if name not in baseline:
+            print("  %-16s 基线中没有" % name)
+            continue
+        c = current[name]
+        b = baseline[name]
+        bad = []
+        if grew(c[99], b[99], args.threshold):
+            bad.append("p99 %d → %d us" % (b[99], c[99]))
+        if grew(c["miss_pct"], b["miss_pct"], args.threshold):
+            bad.append("超时 %.3f%% → %.3f%%" % (b["miss_pct"], c["miss_pct"]))
+        if bad:
+            regressions += 1
+            print("  %-16s 回归：%s" % (name, "，".join(bad)))
+        else:
+            print("  %-16s 正常（p99 %d → %d us）" % (name, b[99], c[99]))
+    if regressions:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""
+run_native_tests.py - 在主机上编译并运行 test/native_tests 中的测试（不需要硬件）
+
+用法：
+    # Unity 源码：https://github.com/ThrowTheSwitch/Unity（与 PlatformIO 使用的测试框架相同）
+    export UNITY_DIR=~/src/Unity
+    python tools/run_native_tests.py                      # 全部主机端测试
+    python tools/run_native_tests.py test_spsc_ring test_log
+    python tools/run_native_tests.py --sanitize address,undefined test_audio_mixer
+    python tools/run_native_tests.py --sanitize thread test_pipeline
+
+- 每个测试单独编译：g++ -std=gnu++17 -pthread，lib/ 下每个库目录都加入头文件路径，
+  链接 lib/*/*.cpp（设备端代码在 #ifdef ARDUINO 中，主机上不参与编译）和 Unity
+- 可执行文件放在 --build-dir（默认 .pio/native，已在 .gitignore 中），并在该目录中运行，
+  测试写出的 WAV/CSV 等文件不会落在仓库里
+- 有测试编译失败或运行失败时退出码为 1
+
+只依赖 Python 标准库，需要 gcc/g++（或用 --cc/--cxx 指定）。
+"""
+
+import argparse
+import glob
+import os
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+TEST_DIR = os.path.join(ROOT, "test", "native_tests")
+
+
+# ========== 编译 ==========
+
+def find_tests(names):
+    available = sorted(os.path.splitext(os.path.basename(p))[0]
+                       for p in glob.glob(os.path.join(TEST_DIR, "test_*.cpp")))
+    if not names:
+        return available
+    tests = []
+    for name in names:
+        name = os.path.splitext(os.path.basename(name))[0]
+        if name not in available:
+            sys.exit("没有这个主机端测试: %s（可选: %s）" % (name, " ".join(available)))
+        tests.append(name)
+    return tests
+
+
+def run(cmd, cwd=None):
+    result = subprocess.run(cmd, cwd=cwd)
+    return result.returncode == 0
+
+
+def build_unity(args, build_dir, flags):
+    unity_src = os.path.join(args.unity, "src")
+    if not os.path.isfile(os.path.join(unity_src, "unity.c")):
+        sys.exit("找不到 Unity 源码: %s/unity.c（用 --unity 或 UNITY_DIR 指定 Unity 目录）" % unity_src)
+    obj = os.path.join(build_dir, "unity.o")
+    if not run([args.cc, "-O2", "-c", os.path.join(unity_src, "unity.c"), "-I", unity_src, "-o", obj] + flags):
+        sys.exit("Unity 编译失败")
+    return unity_src, obj
+
+
+def build_test(args, name, build_dir, unity_src, unity_obj, flags):
+    includes = []
+    for d in sorted(glob.glob(os.path.join(ROOT, "lib", "*", ""))):
+        includes += ["-I", d]
+    sources = sorted(glob.glob(os.path.join(ROOT, "lib", "*", "*.cpp")))
+    exe = os.path.join(build_dir, name)
+    cmd = ([args.cxx, "-std=gnu++17", "-O2", "-pthread", "-I", unity_src] + includes + flags +
+           [os.path.join(TEST_DIR, name + ".cpp")] + sources + [unity_obj, "-o", exe])
+    return exe if run(cmd) else None
+
+
+# ========== 主程序 ==========
+
+def main():
+    parser = argparse.ArgumentParser(description="编译并运行主机端测试（test/native_tests）")
+    parser.add_argument("tests", nargs="*", help="测试名（如 test_spsc_ring），省略时运行全部")
+    parser.add_argument("--unity", default=os.environ.get("UNITY_DIR"),
+                        help="Unity 源码目录（含 src/unity.c），默认取环境变量 UNITY_DIR")
+    parser.add_argument("--sanitize", help="传给 -fsanitize=，如 address,undefined 或 thread")
+    parser.add_argument("--build-dir", default=os.path.join(ROOT, ".pio", "native"), help="输出目录")
+    parser.add_argument("--cc", default="gcc")
+    parser.add_argument("--cxx", default="g++")
+    args = parser.parse_args()
+
+    if not args.unity:
+        sys.exit("需要 Unity 源码目录：--unity DIR 或环境变量 UNITY_DIR")
+
+    tests = find_tests(args.tests)
+    build_dir = os.path.abspath(args.build_dir)
+    os.makedirs(build_dir, exist_ok=True)
+    flags = ["-g", "-fsanitize=" + args.sanitize] if args.sanitize else []
+    unity_src, unity_obj = build_unity(args, build_dir, flags)
+
+    failed = []
+    for name in tests:
+        print("[BUILD] %s" % name, flush=True)
+        exe = build_test(args, name, build_dir, unity_src, unity_obj, flags)
+        if exe is None:
+            failed.append(name + "（编译失败）")
+            continue
+        print("[RUN] %s" % name, flush=True)
+        if not run([exe], cwd=build_dir):
+            failed.append(name)
+
+    print()
+    print("%d 个测试，%d 个失败" % (len(tests), len(failed)))
+    for name in failed:
+        print("  失败: %s" % name)
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,404 @@
+#!/usr/bin/env python3
+"""
+telemetry_decode.py - 把串口抓到的 Telemetry 二进制帧转成 CSV 或实时曲线
+
+用法：
+    # 设备端串口输入 b 开始发送遥测帧，再输入 b 停止；期间把串口原始字节存成文件，例如 Linux 下：
+    stty -F /dev/ttyACM0 115200 raw -echo && cat /dev/ttyACM0 > capture.bin
+    python tools/telemetry_decode.py capture.bin -o csv/          # 每种记录一个 CSV：csv/levels.csv ...
+    python tools/telemetry_decode.py capture.bin --type levels    # 只输出一种记录到标准输出
+    python tools/telemetry_decode.py capture.bin --text           # 同时打印夹在帧之间的串口文本
+    python tools/telemetry_decode.py capture.bin --log log.txt    # 日志行写入文件（默认标准错误）
+    # 实时曲线（需要 matplotlib），字段写成 记录名.字段名：
+    python tools/telemetry_decode.py /dev/ttyACM0 --plot levels.volume,levels.noise,angles.h
+
+- 按 0x00 切分字节流，COBS 解码后检查 Fletcher-16；失败的段（串口文本、被文本打断的帧）跳过并计数
+- 记录类型由设备发来的 schema 帧（类型 0）定义，字段类型与 Python struct 相同；收到 schema 之前的记录跳过
+- 丢弃帧（类型 0xFF）报告设备端队列满时丢掉的记录数；帧序号不连续说明串口上丢了帧
+- 日志（lib/Log）：格式串帧（类型 0xFD）建立 编号 → 格式串 的表，日志帧（类型 0xFE）只带编号和原始参数，
+  在这里按 printf 规则格式化成 "秒.毫秒 级别 消息"；日志帧有自己的序号
+- 结束时在标准错误输出各类型的记录数、坏帧、序号缺口和设备端丢弃数
+
+只依赖 Python 标准库（--plot 另需 matplotlib）。格式定义见 lib/Telemetry/Telemetry.h。
+"""
+
+import argparse
+import csv
+import os
+import re
+import struct
+import sys
+import time
+
+TYPE_SCHEMA = 0x00
+TYPE_LOG_FORMAT = 0xFD
+TYPE_LOG = 0xFE
+TYPE_DROPS = 0xFF
+FRAME_HEADER = 6
+FIELD_TYPES = "bBhHiIf"
+
+LOG_LEVELS = "-EWIDV"
+LOG_ARG_INT, LOG_ARG_UINT, LOG_ARG_FLOAT, LOG_ARG_STR, LOG_ARG_PTR = range(5)
+# printf 转换说明：标志、宽度、精度、长度修饰（Python 不需要，去掉）、转换字符
+C_SPEC = re.compile(r"%([-+ #0]*)(\d*)((?:\.\d*)?)(?:hh|h|ll|l|z|j|t|L)?([diuxXofFeEgGcsp%])")
+
+
+def fletcher16(data):
+    a = 0
+    b = 0
+    for byte in data:
+        a = (a + byte) % 255
+        b = (b + a) % 255
+    return (b << 8) | a
+
+
+def cobs_decode(data):
+    """COBS 解码（输入不含 0x00），数据无效时返回 None"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def format_c(fmt, args):
+    """按 printf 规则格式化（与 LogRing::formatRecord 相同：参数不够时原样输出转换说明）"""
+    out = []
+    pos = 0
+    index = 0
+    for m in C_SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, precision, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        if index >= len(args):
+            out.append(m.group(0))
+            continue
+        kind, value = args[index]
+        index += 1
+        if conv in "diuxXo":
+            if kind == LOG_ARG_STR:
+                out.append(m.group(0))
+                continue
+            value = int(value)
+        if conv in "uxXo" and value < 0:
+            value &= 0xFFFFFFFF       # 与设备端相同：负数按 32 位无符号
+        if conv in "iu":
+            conv = "d"
+        elif conv == "c":
+            value = chr(value & 0xFF) if isinstance(value, int) else "?"
+            conv = "s"
+        elif conv == "p":
+            out.append(("%" + flags + width + "s") % ("0x%x" % value))
+            continue
+        elif conv == "s" and not isinstance(value, str):
+            value = "(null)" if value == 0 else "0x%x" % value
+        elif conv in "fFeEgG" and not isinstance(value, float):
+            value = float(value)
+        out.append(("%" + flags + width + precision + conv) % value)
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+# ========== 解码 ==========
+
+class Decoder:
+    def __init__(self):
+        self.schemas = {}          # 编号 → (名称, [字段名], struct 格式)
+        self.counts = {}
+        self.bad = 0
+        self.unknown = 0
+        self.seq_gaps = 0
+        self.drops = {}            # 来源 → 累计丢弃
+        self.log_formats = {}      # 编号 → 格式串
+        self.log_lines = 0
+        self.log_unknown = 0       # 收到格式串之前的日志帧
+        self._last_seq = None
+        self._last_log_seq = None  # 日志帧有自己的序号
+        self._pending = bytearray()
+
+    def feed(self, data):
+        """
+        输入任意长度的字节，返回事件列表：
+        ("record", 名称, 时间, 值元组) / ("log", 时间, 级别字符, 消息) / ("text", 字符串)
+        """
+        events = []
+        self._pending += data
+        while True:
+            end = self._pending.find(b"\x00")
+            if end < 0:
+                break
+            chunk = bytes(self._pending[:end])
+            del self._pending[:end + 1]
+            if chunk:
+                self._chunk(chunk, events)
+        return events
+
+    def _chunk(self, chunk, events):
+        raw = cobs_decode(chunk)
+        if raw is None or len(raw) < FRAME_HEADER + 2 or \
+                fletcher16(raw[:-2]) != struct.unpack_from("<H", raw, len(raw) - 2)[0]:
+            self.bad += 1
+            events.append(("text", chunk.decode("utf-8", errors="replace")))
+            return
+
+        ftype, seq, time_ms = struct.unpack_from("<BBI", raw, 0)
+        payload = raw[FRAME_HEADER:-2]
+        if ftype in (TYPE_LOG_FORMAT, TYPE_LOG):
+            if self._last_log_seq is not None:
+                self.seq_gaps += (seq - self._last_log_seq - 1) & 0xFF
+            self._last_log_seq = seq
+            self._log(ftype, time_ms, payload, events)
+            return
+        if self._last_seq is not None:
+            self.seq_gaps += (seq - self._last_seq - 1) & 0xFF
+        self._last_seq = seq
+
+        if ftype == TYPE_SCHEMA:
+            self._schema(payload)
+        elif ftype == TYPE_DROPS:
+            if len(payload) == 5:
+                source, total = struct.unpack("<BI", payload)
+                self.drops[source] = total
+        elif ftype in self.schemas:
+            name, fields, fmt = self.schemas[ftype]
+            if len(payload) != struct.calcsize(fmt):
+                self.unknown += 1
+                return
+            self.counts[name] = self.counts.get(name, 0) + 1
+            events.append(("record", name, time_ms, struct.unpack(fmt, payload)))
+        else:
+            self.unknown += 1
+
+    def _schema(self, payload):
+        if len(payload) < 3:
+            return
+        type_id = payload[0]
+        name, _, desc = payload[1:].partition(b"\x00")
+        fields = []
+        fmt = "<"
+        for item in desc.decode("ascii", errors="replace").split(","):
+            field, _, kind = item.partition(":")
+            if not field or kind not in FIELD_TYPES or len(kind) != 1:
+                print("警告：无效的 schema %r" % desc, file=sys.stderr)
+                return
+            fields.append(field)
+            fmt += kind
+        self.schemas[type_id] = (name.decode("ascii", errors="replace"), fields, fmt)
+
+    def _log(self, ftype, time_ms, payload, events):
+        if len(payload) < 2:
+            self.unknown += 1
+            return
+        format_id = struct.unpack_from("<H", payload, 0)[0]
+        if ftype == TYPE_LOG_FORMAT:
+            self.log_formats[format_id] = payload[2:].decode("utf-8", errors="replace")
+            return
+        fmt = self.log_formats.get(format_id)
+        if fmt is None or len(payload) < 4:
+            self.log_unknown += 1
+            return
+        level, argc = payload[2], payload[3]
+        args = []
+        k = 4
+        try:
+            for _ in range(argc):
+                kind = payload[k]
+                k += 1
+                if kind == LOG_ARG_STR:
+                    length = payload[k]
+                    args.append((kind, payload[k + 1:k + 1 + length].decode("utf-8", errors="replace")))
+                    k += 1 + length
+                else:
+                    code = {LOG_ARG_INT: "<i", LOG_ARG_FLOAT: "<f"}.get(kind, "<I")
+                    args.append((kind, struct.unpack_from(code, payload, k)[0]))
+                    k += 4
+        except (IndexError, struct.error):
+            self.unknown += 1
+            return
+        self.log_lines += 1
+        level_char = LOG_LEVELS[level] if level < len(LOG_LEVELS) else "?"
+        events.append(("log", time_ms, level_char, format_c(fmt, args)))
+
+    def fields(self, name):
+        for schema in self.schemas.values():
+            if schema[0] == name:
+                return schema[1]
+        return None
+
+    def report(self):
+        parts = ["%s %d 条" % (name, n) for name, n in sorted(self.counts.items())]
+        print("记录：%s" % ("，".join(parts) if parts else "无"), file=sys.stderr)
+        print("坏帧/文本段 %d，未知类型 %d，序号缺口 %d 帧" % (self.bad, self.unknown, self.seq_gaps),
+              file=sys.stderr)
+        if self.drops:
+            total = sum(self.drops.values())
+            print("设备端队列满丢弃 %d 条（%s）" % (total, "，".join(
+                "来源%d: %d" % item for item in sorted(self.drops.items()))), file=sys.stderr)
+        if self.log_lines or self.log_unknown:
+            print("日志 %d 行（缺格式串跳过 %d 行）" % (self.log_lines, self.log_unknown), file=sys.stderr)
+
+
+def log_line(event):
+    _, time_ms, level_char, message = event
+    return "%d.%03d %s %s" % (time_ms // 1000, time_ms % 1000, level_char, message)
+
+
+def read_chunks(path, size=4096):
+    if path == "-":
+        stream = sys.stdin.buffer
+    else:
+        stream = open(path, "rb", buffering=0)
+    try:
+        while True:
+            data = stream.read1(size) if hasattr(stream, "read1") else stream.read(size)
+            if not data:
+                break
+            yield data
+    finally:
+        if stream is not sys.stdin.buffer:
+            stream.close()
+
+
+# ========== CSV ==========
+
+class CsvOutput:
+    """--type 时写标准输出，否则每种记录一个文件"""
+
+    def __init__(self, decoder, out_dir, only_type):
+        self.decoder = decoder
+        self.out_dir = out_dir
+        self.only_type = only_type
+        self.writers = {}
+        self.files = []
+
+    def write(self, name, time_ms, values):
+        if self.only_type is not None and name != self.only_type:
+            return
+        writer = self.writers.get(name)
+        if writer is None:
+            if self.only_type is not None:
+                f = sys.stdout
+            else:
+                f = open(os.path.join(self.out_dir, name + ".csv"), "w", newline="", encoding="utf-8")
+                self.files.append(f)
+            writer = csv.writer(f)
+            writer.writerow(["time_ms"] + self.decoder.fields(name))
+            self.writers[name] = writer
+        writer.writerow([time_ms] + [round(v, 6) if isinstance(v, float) else v for v in values])
+
+    def close(self):
+        for f in self.files:
+            f.close()
+
+
+# ========== 实时曲线 ==========
+
+def run_plot(args, decoder, log_file):
+    try:
+        import matplotlib.pyplot as plt
+    except ImportError:
+        sys.exit("--plot 需要 matplotlib（pip install matplotlib）")
+
+    wanted = []
+    for item in args.plot.split(","):
+        name, _, field = item.strip().partition(".")
+        if not name or not field:
+            sys.exit("--plot 的字段写成 记录名.字段名：%s" % item)
+        wanted.append((name, field))
+
+    series = {key: ([], []) for key in wanted}
+    plt.ion()
+    fig, ax = plt.subplots()
+    lines = {key: ax.plot([], [], label="%s.%s" % key)[0] for key in wanted}
+    ax.set_xlabel("时间 (s)")
+    ax.legend(loc="upper left")
+    last_draw = 0.0
+
+    for data in read_chunks(args.input, 512):
+        for event in decoder.feed(data):
+            if event[0] == "text":
+                if args.text:
+                    print(event[1].strip(), file=sys.stderr)
+                continue
+            if event[0] == "log":
+                print(log_line(event), file=log_file)
+                continue
+            _, name, time_ms, values = event
+            fields = decoder.fields(name)
+            for key in wanted:
+                if key[0] == name and key[1] in fields:
+                    xs, ys = series[key]
+                    xs.append(time_ms / 1000.0)
+                    ys.append(values[fields.index(key[1])])
+                    if len(xs) > args.window:
+                        del xs[0], ys[0]
+        now = time.monotonic()
+        if now - last_draw > 0.1:
+            for key, line in lines.items():
+                line.set_data(*series[key])
+            ax.relim()
+            ax.autoscale_view()
+            plt.pause(0.001)
+            last_draw = now
+            if not plt.fignum_exists(fig.number):
+                break
+
+
+def main():
+    parser = argparse.ArgumentParser(description="把 Telemetry 二进制帧转成 CSV 或实时曲线")
+    parser.add_argument("input", help="抓到的串口字节（文件、串口设备或 - 表示标准输入）")
+    parser.add_argument("-o", "--out-dir", default=".", help="CSV 输出目录（每种记录一个文件）")
+    parser.add_argument("--type", dest="only_type", help="只把这一种记录输出到标准输出")
+    parser.add_argument("--text", action="store_true", help="打印夹在帧之间的串口文本（到标准错误）")
+    parser.add_argument("--log", help="日志行写入这个文件（默认标准错误）")
+    parser.add_argument("--plot", help="实时曲线：记录名.字段名，逗号分隔")
+    parser.add_argument("--window", type=int, default=2000, help="曲线保留的点数")
+    args = parser.parse_args()
+
+    decoder = Decoder()
+    log_file = open(args.log, "w", encoding="utf-8") if args.log else sys.stderr
+    if args.plot:
+        try:
+            run_plot(args, decoder, log_file)
+        finally:
+            if log_file is not sys.stderr:
+                log_file.close()
+        decoder.report()
+        return
+
+    if args.only_type is None:
+        os.makedirs(args.out_dir, exist_ok=True)
+    output = CsvOutput(decoder, args.out_dir, args.only_type)
+    try:
+        for data in read_chunks(args.input):
+            for event in decoder.feed(data):
+                if event[0] == "text":
+                    if args.text:
+                        print(event[1].strip(), file=sys.stderr)
+                elif event[0] == "log":
+                    print(log_line(event), file=log_file)
+                else:
+                    output.write(event[1], event[2], event[3])
+    except KeyboardInterrupt:
+        pass
+    finally:
+        output.close()
+        if log_file is not sys.stderr:
+            log_file.close()
+    decoder.report()
+    if not decoder.schemas and not decoder.log_formats:
+        sys.exit("没有找到 schema 帧（设备端输入 b 开始发送；开始抓包后再开启，schema 会重新发送）")
+
+
+if __name__ == "__main__":
+    main()
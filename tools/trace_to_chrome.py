@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+trace_to_chrome.py - 把串口抓到的 Trace 二进制块转成 Chrome trace JSON
+
+用法：
+    # 设备端用 -DTRACE_ENABLED=1 编译，串口输入 x 开始发送追踪块，再输入 x 停止；
+    # 期间把串口原始字节存成文件，例如 Linux 下：
+    stty -F /dev/ttyACM0 115200 raw -echo && cat /dev/ttyACM0 > capture.bin
+    python tools/trace_to_chrome.py capture.bin -o trace.json
+    cat capture.bin | python tools/trace_to_chrome.py - -o trace.json
+
+- 输入可以混有普通串口文本：只识别 "TRC1" 开头且校验正确的块，其余字节跳过
+- 名称块给出编号 → 名称；记录块带锚点（周期计数 + 微秒），时间戳 = 锚点微秒 + (开始周期 - 锚点周期) / 每微秒周期数
+- 作用域 → "X"（完整事件），瞬时 → "i"，计数器 → "C"；每个 TRACE_THREAD 名称一行，未命名的任务显示为 main
+- 记录块中的累计丢失数增加时插入一个 "trace_lost" 瞬时事件，并在结束时报告总数
+- 输出在 chrome://tracing 或 https://ui.perfetto.dev 中打开
+
+只依赖 Python 标准库。格式定义见 lib/Trace/Trace.h。
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"TRC1"
+BLOCK_NAMES = 1
+BLOCK_RECORDS = 2
+BLOCK_HEADER = 7
+BLOCK_OVERHEAD = 9
+RECORDS_HEADER = 16
+RECORD_BYTES = 12
+NO_THREAD = 0xFF
+
+TYPE_SPAN = 0
+TYPE_INSTANT = 1
+TYPE_COUNTER = 2
+
+
+def fletcher16(data):
+    a = 0
+    b = 0
+    for byte in data:
+        a = (a + byte) % 255
+        b = (b + a) % 255
+    return (b << 8) | a
+
+
+def signed32(v):
+    v &= 0xFFFFFFFF
+    return v - 0x100000000 if v & 0x80000000 else v
+
+
+# ========== 解析块 ==========
+
+def iter_blocks(data):
+    """依次返回 (类型, 载荷)，跳过文本和校验失败的块；另返回跳过的坏块数"""
+    pos = 0
+    bad = 0
+    blocks = []
+    while True:
+        pos = data.find(MAGIC, pos)
+        if pos < 0 or pos + BLOCK_OVERHEAD > len(data):
+            break
+        kind = data[pos + 4]
+        length = struct.unpack_from("<H", data, pos + 5)[0]
+        end = pos + BLOCK_HEADER + length
+        if end + 2 > len(data):
+            bad += 1
+            pos += 1
+            continue
+        checksum = struct.unpack_from("<H", data, end)[0]
+        if fletcher16(data[pos + 4:end]) != checksum:
+            # 可能是文本中恰好出现了魔数，或者串口丢了字节：从下一个字节重新找
+            bad += 1
+            pos += 1
+            continue
+        blocks.append((kind, data[pos + BLOCK_HEADER:end]))
+        pos = end + 2
+    return blocks, bad
+
+
+def parse_names(payload, names):
+    pos = 0
+    while pos + 3 <= len(payload):
+        ident, length = struct.unpack_from("<HB", payload, pos)
+        names[ident] = payload[pos + 3:pos + 3 + length].decode("utf-8", "replace")
+        pos += 3 + length
+
+
+# ========== 转换 ==========
+
+def convert(data):
+    blocks, bad = iter_blocks(data)
+    names = {}
+    events = []
+    threads = set()
+    last_lost = 0
+    anchor_base = None   # 第一个记录块的锚点微秒（已展开回绕），输出时间从 0 开始
+    anchor_wraps = 0
+    prev_anchor = None
+    records = 0
+
+    for kind, payload in blocks:
+        if kind == BLOCK_NAMES:
+            parse_names(payload, names)
+            continue
+        if kind != BLOCK_RECORDS or len(payload) < RECORDS_HEADER:
+            continue
+
+        anchor_cycles, anchor_us, cycles_per_us, lost, count = struct.unpack_from("<IIHIH", payload, 0)
+        if cycles_per_us == 0:
+            continue
+        # micros() 约 71.6 分钟回绕一次
+        if prev_anchor is not None and anchor_us < prev_anchor:
+            anchor_wraps += 1
+        prev_anchor = anchor_us
+        anchor = anchor_us + anchor_wraps * 0x100000000
+        if anchor_base is None:
+            anchor_base = anchor
+
+        if lost > last_lost:
+            events.append({"name": "trace_lost", "ph": "i", "s": "g", "pid": 0, "tid": 0,
+                           "ts": anchor - anchor_base, "args": {"lost": lost - last_lost}})
+            last_lost = lost
+
+        for i in range(count):
+            off = RECORDS_HEADER + i * RECORD_BYTES
+            if off + RECORD_BYTES > len(payload):
+                break
+            start, value, name, rtype, thread = struct.unpack_from("<IiHBB", payload, off)
+            ts = anchor - anchor_base + signed32(start - anchor_cycles) / cycles_per_us
+            tid = 0 if thread == NO_THREAD else thread + 1
+            threads.add(thread)
+            label = names.get(name, "#%d" % name)
+            event = {"name": label, "pid": 0, "tid": tid, "ts": round(ts, 3)}
+            if rtype == TYPE_SPAN:
+                event["ph"] = "X"
+                event["dur"] = round(value / cycles_per_us, 3)
+            elif rtype == TYPE_COUNTER:
+                event["ph"] = "C"
+                event["args"] = {"value": value}
+            else:
+                event["ph"] = "i"
+                event["s"] = "t"
+                event["args"] = {"arg": value}
+            events.append(event)
+            records += 1
+
+    for thread in sorted(threads):
+        tid = 0 if thread == NO_THREAD else thread + 1
+        label = "main" if thread == NO_THREAD else names.get(thread, "task %d" % thread)
+        events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": tid, "args": {"name": label}})
+    events.sort(key=lambda e: e.get("ts", -1))
+
+    summary = {"blocks": len(blocks), "bad": bad, "records": records, "lost": last_lost, "names": len(names)}
+    return {"traceEvents": events, "displayTimeUnit": "ms"}, summary
+
+
+def main():
+    parser = argparse.ArgumentParser(description="把 Trace 二进制块转成 Chrome trace JSON")
+    parser.add_argument("input", help="串口抓包文件，- 为标准输入")
+    parser.add_argument("-o", "--output", default="trace.json", help="输出的 JSON 文件")
+    args = parser.parse_args()
+
+    if args.input == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.input, "rb") as f:
+            data = f.read()
+
+    trace, summary = convert(data)
+    if summary["records"] == 0:
+        sys.exit("%s: 没有找到追踪记录（设备端是否用 -DTRACE_ENABLED=1 编译并输入了 x？）" % args.input)
+    with open(args.output, "w", encoding="utf-8") as f:
+        json.dump(trace, f)
+
+    print("块 %d（校验失败 %d），记录 %d，名称 %d，丢失 %d" % (
+        summary["blocks"], summary["bad"], summary["records"], summary["names"], summary["lost"]))
+    if summary["lost"] > 0:
+        print("警告：%d 条记录在导出前被覆盖，可增大 TRACE_RING_SIZE 或提高导出频率" % summary["lost"],
+              file=sys.stderr)
+    print("输出: %s" % args.output)
+
+
+if __name__ == "__main__":
+    main()